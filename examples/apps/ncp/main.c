@@ -34,7 +34,6 @@
 
 #include <openthread-core-config.h>
 #include <openthread.h>
-#include <openthread-diag.h>
 #include <common/debug.hpp>
 #include <ncp/ncp.h>
 #include <platform/platform.h>
@@ -44,6 +43,11 @@ void otSignalTaskletPending(otInstance *aInstance)
     (void)aInstance;
 }
 
+void otSignalApiCommandPending(otInstance *aInstance)
+{
+    (void)aInstance;
+}
+
 int main(int argc, char *argv[])
 {
     otInstance *sInstance;
@@ -72,10 +76,6 @@ int main(int argc, char *argv[])
 
     otNcpInit(sInstance);
 
-#if OPENTHREAD_ENABLE_DIAG
-    diagInit(sInstance);
-#endif
-
     while (1)
     {
         otProcessNextTasklet(sInstance);
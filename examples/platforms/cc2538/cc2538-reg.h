@@ -177,6 +177,16 @@
 #define UART_IM_RXIM                          0x00000010  // UART receive interrupt mask
 #define UART_IM_RTIM                          0x00000040  // UART receive time-out interrupt 
 
+#define FLASH_CTRL_FCTL                       0x400D3008  // Flash control
+#define FLASH_CTRL_FADDR                      0x400D300C  // Flash address
+#define FLASH_CTRL_FWDATA                     0x400D3010  // Flash data
+#define FLASH_CTRL_DIECFG0                    0x400D3014  // Flash size configuration
+
+#define FLASH_CTRL_FCTL_ERASE                 0x00000001  // Erase one page
+#define FLASH_CTRL_FCTL_WRITE                 0x00000002  // Write one word
+#define FLASH_CTRL_FCTL_FULL                  0x00000040  // Write buffer full
+#define FLASH_CTRL_FCTL_BUSY                  0x00000080  // Erase or write ongoing
+
 #define SOC_ADC_ADCCON1                       0x400D7000  // ADC Control
 #define SOC_ADC_RNDL                          0x400D7014  // RNG low data
 #define SOC_ADC_RNDH                          0x400D7018  // RNG high data
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the flash platform abstraction for the internal CC2538 flash.
+ *
+ *   The driver exposes the two main-flash pages directly below the CCA/lock
+ *   page; address 0 maps to the start of the lower of the two pages.
+ */
+
+#include <string.h>
+
+#include <openthread-types.h>
+#include <platform/alarm.h>
+#include <platform/flash.h>
+#include "platform-cc2538.h"
+
+enum
+{
+    kFlashPageSize    = 0x800,
+    kFlashNumPages    = 2,
+    kFlashSize        = kFlashPageSize * kFlashNumPages,
+
+    // two pages directly below the CCA/lock page at the top of the 512 KB part
+    kFlashBaseAddress = 0x0027e800,
+};
+
+ThreadError otPlatFlashInit(void)
+{
+    return kThreadError_None;
+}
+
+uint32_t otPlatFlashGetSize(void)
+{
+    return kFlashSize;
+}
+
+ThreadError otPlatFlashErasePage(uint32_t aAddress)
+{
+    if (aAddress >= kFlashSize || (aAddress & (kFlashPageSize - 1)) != 0)
+    {
+        return kThreadError_InvalidArgs;
+    }
+
+    while (HWREG(FLASH_CTRL_FCTL) & FLASH_CTRL_FCTL_BUSY);
+
+    HWREG(FLASH_CTRL_FADDR) = (kFlashBaseAddress + aAddress) >> 2;
+    HWREG(FLASH_CTRL_FCTL) |= FLASH_CTRL_FCTL_ERASE;
+
+    return kThreadError_None;
+}
+
+ThreadError otPlatFlashStatusWait(uint32_t aTimeout)
+{
+    uint32_t start = otPlatAlarmGetNow();
+
+    do
+    {
+        if ((HWREG(FLASH_CTRL_FCTL) & FLASH_CTRL_FCTL_BUSY) == 0)
+        {
+            return kThreadError_None;
+        }
+    }
+    while (aTimeout != 0 && (otPlatAlarmGetNow() - start) < aTimeout);
+
+    return kThreadError_Busy;
+}
+
+uint32_t otPlatFlashWrite(uint32_t aAddress, uint8_t *aData, uint32_t aSize)
+{
+    uint32_t written = 0;
+    uint32_t word;
+
+    if (aData == NULL || aAddress + aSize > kFlashSize ||
+        (aAddress & 3) != 0 || (aSize & 3) != 0)
+    {
+        return 0;
+    }
+
+    while (written < aSize)
+    {
+        memcpy(&word, aData + written, sizeof(word));
+
+        while (HWREG(FLASH_CTRL_FCTL) & FLASH_CTRL_FCTL_BUSY);
+
+        HWREG(FLASH_CTRL_FADDR) = (kFlashBaseAddress + aAddress + written) >> 2;
+        HWREG(FLASH_CTRL_FCTL) |= FLASH_CTRL_FCTL_WRITE;
+        HWREG(FLASH_CTRL_FWDATA) = word;
+
+        while (HWREG(FLASH_CTRL_FCTL) & FLASH_CTRL_FCTL_FULL);
+
+        written += sizeof(word);
+    }
+
+    while (HWREG(FLASH_CTRL_FCTL) & FLASH_CTRL_FCTL_BUSY);
+
+    return written;
+}
+
+uint32_t otPlatFlashRead(uint32_t aAddress, uint8_t *aData, uint32_t aSize)
+{
+    if (aData == NULL || aAddress + aSize > kFlashSize)
+    {
+        return 0;
+    }
+
+    // the settings region is memory mapped for reading
+    memcpy(aData, (const void *)(kFlashBaseAddress + aAddress), aSize);
+
+    return aSize;
+}
@@ -32,6 +32,7 @@
  *   This file includes the platform-specific initializers.
  */
 
+#include <platform/settings.h>
 #include <platform/uart.h>
 #include "platform-cc2538.h"
 
@@ -42,6 +43,7 @@ void PlatformInit(int argc, char *argv[])
     cc2538AlarmInit();
     cc2538RandomInit();
     cc2538RadioInit();
+    otPlatSettingsInit();
     otPlatUartEnable();
 
     (void)argc;
@@ -37,6 +37,7 @@
 #include <openthread-config.h>
 
 #include <common/code_utils.hpp>
+#include <platform/alarm.h>
 #include <platform/platform.h>
 #include <platform/radio.h>
 #include <platform/diag.h>
@@ -62,12 +63,15 @@ enum
 };
 
 static RadioPacket sTransmitFrame;
-static RadioPacket sReceiveFrame;
+static RadioPacket sReceiveRing[kPhyRxRingSize];
 static ThreadError sTransmitError;
 static ThreadError sReceiveError;
 
 static uint8_t sTransmitPsdu[IEEE802154_MAX_LENGTH];
-static uint8_t sReceivePsdu[IEEE802154_MAX_LENGTH];
+static uint8_t sReceivePsdu[kPhyRxRingSize][IEEE802154_MAX_LENGTH];
+static uint8_t sReceiveHead = 0;
+static uint8_t sReceiveCount = 0;
+static uint8_t sChannel = 0;
 
 static PhyState sState = kStateDisabled;
 static bool sIsReceiverEnabled = false;
@@ -174,10 +178,16 @@ ThreadError otPlatRadioSetShortAddress(otInstance *aInstance, uint16_t address)
 
 void cc2538RadioInit(void)
 {
+    int i;
+
     sTransmitFrame.mLength = 0;
     sTransmitFrame.mPsdu = sTransmitPsdu;
-    sReceiveFrame.mLength = 0;
-    sReceiveFrame.mPsdu = sReceivePsdu;
+
+    for (i = 0; i < kPhyRxRingSize; i++)
+    {
+        sReceiveRing[i].mLength = 0;
+        sReceiveRing[i].mPsdu = sReceivePsdu[i];
+    }
 
     // enable clock
     HWREG(SYS_CTRL_RCGCRFC) = SYS_CTRL_RCGCRFC_RFC0;
@@ -258,7 +268,7 @@ ThreadError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel)
         error = kThreadError_None;
         sState = kStateReceive;
         setChannel(aChannel);
-        sReceiveFrame.mChannel = aChannel;
+        sChannel = aChannel;
         enableReceiver();
     }
 
@@ -353,30 +363,43 @@ void otPlatRadioSetPromiscuous(otInstance *aInstance, bool aEnable)
 
 void readFrame(void)
 {
+    RadioPacket *frame;
     uint8_t length;
     uint8_t crcCorr;
     int i;
 
     VerifyOrExit(sState == kStateReceive || sState == kStateTransmit, ;);
-    VerifyOrExit((HWREG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP) != 0, ;);
-
-    // read length
-    length = HWREG(RFCORE_SFR_RFDATA);
-    VerifyOrExit(IEEE802154_MIN_LENGTH <= length && length <= IEEE802154_MAX_LENGTH, ;);
 
-    // read psdu
-    for (i = 0; i < length - 2; i++)
+    // drain complete frames from the rxfifo into the receive ring
+    while (sReceiveCount < kPhyRxRingSize &&
+           (HWREG(RFCORE_XREG_FSMSTAT1) & RFCORE_XREG_FSMSTAT1_FIFOP) != 0)
     {
-        sReceiveFrame.mPsdu[i] = HWREG(RFCORE_SFR_RFDATA);
-    }
+        frame = &sReceiveRing[(sReceiveHead + sReceiveCount) % kPhyRxRingSize];
 
-    sReceiveFrame.mPower = (int8_t)HWREG(RFCORE_SFR_RFDATA) - CC2538_RSSI_OFFSET;
-    crcCorr = HWREG(RFCORE_SFR_RFDATA);
+        // read length
+        length = HWREG(RFCORE_SFR_RFDATA);
+        VerifyOrExit(IEEE802154_MIN_LENGTH <= length && length <= IEEE802154_MAX_LENGTH, ;);
 
-    if (crcCorr & CC2538_CRC_BIT_MASK)
-    {
-        sReceiveFrame.mLength = length;
-        sReceiveFrame.mLqi = crcCorr & CC2538_LQI_BIT_MASK;
+        // read psdu
+        for (i = 0; i < length - 2; i++)
+        {
+            frame->mPsdu[i] = HWREG(RFCORE_SFR_RFDATA);
+        }
+
+        frame->mPower = (int8_t)HWREG(RFCORE_SFR_RFDATA) - CC2538_RSSI_OFFSET;
+        crcCorr = HWREG(RFCORE_SFR_RFDATA);
+
+        if (crcCorr & CC2538_CRC_BIT_MASK)
+        {
+            frame->mLength = length;
+            frame->mLqi = crcCorr & CC2538_LQI_BIT_MASK;
+            frame->mChannel = sChannel;
+
+            // the frame is timestamped when it is pulled from the rxfifo; SFD capture via
+            // the MAC timer is not wired up on this driver
+            frame->mTimestamp = otPlatAlarmGetNow();
+            sReceiveCount++;
+        }
     }
 
     // check for rxfifo overflow
@@ -393,62 +416,91 @@ exit:
 
 void cc2538RadioProcess(otInstance *aInstance)
 {
+    RadioFrameEvent events[kPhyRxRingSize];
+    uint8_t numEvents = 0;
+    RadioPacket *receiveFrame;
+
     readFrame();
 
-    if ((sState == kStateReceive) && (sReceiveFrame.mLength > 0))
+    // drain the receive ring in a batch so short bursts are absorbed
+    while (sReceiveCount > 0)
     {
-#if OPENTHREAD_ENABLE_DIAG
-
-        if (otPlatDiagModeGet())
-        {
-            otPlatDiagRadioReceiveDone(aInstance, &sReceiveFrame, sReceiveError);
-        }
-        else
-#endif
-        {
-            otPlatRadioReceiveDone(aInstance, &sReceiveFrame, sReceiveError);
-        }
-    }
+        receiveFrame = &sReceiveRing[sReceiveHead];
 
-    if (sState == kStateTransmit)
-    {
-        if (sTransmitError != kThreadError_None || (sTransmitFrame.mPsdu[0] & IEEE802154_ACK_REQUEST) == 0)
+        if (sState == kStateReceive && receiveFrame->mLength > 0)
         {
-            sState = kStateReceive;
-
 #if OPENTHREAD_ENABLE_DIAG
 
             if (otPlatDiagModeGet())
             {
-                otPlatDiagRadioTransmitDone(aInstance, false, sTransmitError);
+                otPlatDiagRadioReceiveDone(aInstance, receiveFrame, sReceiveError);
             }
             else
 #endif
             {
-                otPlatRadioTransmitDone(aInstance, false, sTransmitError);
+                // queue the completion; ring slots are not rewritten until the
+                // next readFrame(), so the batch can cross the boundary at once
+                events[numEvents].mPacket = receiveFrame;
+                events[numEvents].mError = sReceiveError;
+                numEvents++;
             }
         }
-        else if (sReceiveFrame.mLength == IEEE802154_ACK_LENGTH &&
-                 (sReceiveFrame.mPsdu[0] & IEEE802154_FRAME_TYPE_MASK) == IEEE802154_FRAME_TYPE_ACK &&
-                 (sReceiveFrame.mPsdu[IEEE802154_DSN_OFFSET] == sTransmitFrame.mPsdu[IEEE802154_DSN_OFFSET]))
+        else if (sState == kStateTransmit &&
+                 sTransmitError == kThreadError_None &&
+                 (sTransmitFrame.mPsdu[0] & IEEE802154_ACK_REQUEST) != 0 &&
+                 receiveFrame->mLength == IEEE802154_ACK_LENGTH &&
+                 (receiveFrame->mPsdu[0] & IEEE802154_FRAME_TYPE_MASK) == IEEE802154_FRAME_TYPE_ACK &&
+                 (receiveFrame->mPsdu[IEEE802154_DSN_OFFSET] == sTransmitFrame.mPsdu[IEEE802154_DSN_OFFSET]))
         {
             sState = kStateReceive;
 
+            // preserve ordering: frames received before the ack reach the core
+            // before its transmit-done processing runs
+            if (numEvents > 0)
+            {
+                otPlatRadioReceiveDoneBatch(aInstance, events, numEvents);
+                numEvents = 0;
+            }
+
 #if OPENTHREAD_ENABLE_DIAG
 
             if (otPlatDiagModeGet())
             {
-                otPlatDiagRadioTransmitDone(aInstance, (sReceiveFrame.mPsdu[0] & IEEE802154_FRAME_PENDING) != 0, sTransmitError);
+                otPlatDiagRadioTransmitDone(aInstance, (receiveFrame->mPsdu[0] & IEEE802154_FRAME_PENDING) != 0, sTransmitError);
             }
             else
 #endif
             {
-                otPlatRadioTransmitDone(aInstance, (sReceiveFrame.mPsdu[0] & IEEE802154_FRAME_PENDING) != 0, sTransmitError);
+                otPlatRadioTransmitDone(aInstance, (receiveFrame->mPsdu[0] & IEEE802154_FRAME_PENDING) != 0, sTransmitError);
             }
         }
+
+        sReceiveHead = (uint8_t)((sReceiveHead + 1) % kPhyRxRingSize);
+        sReceiveCount--;
+    }
+
+    if (numEvents > 0)
+    {
+        otPlatRadioReceiveDoneBatch(aInstance, events, numEvents);
     }
 
-    sReceiveFrame.mLength = 0;
+    if (sState == kStateTransmit &&
+        (sTransmitError != kThreadError_None || (sTransmitFrame.mPsdu[0] & IEEE802154_ACK_REQUEST) == 0))
+    {
+        sState = kStateReceive;
+
+#if OPENTHREAD_ENABLE_DIAG
+
+        if (otPlatDiagModeGet())
+        {
+            otPlatDiagRadioTransmitDone(aInstance, false, sTransmitError);
+        }
+        else
+#endif
+        {
+            otPlatRadioTransmitDone(aInstance, false, sTransmitError);
+        }
+    }
 }
 
 void RFCoreRxTxIntHandler(void)
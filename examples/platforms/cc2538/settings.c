@@ -0,0 +1,396 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a log-structured version of the settings platform abstraction.
+ *
+ *   One flash page is active at a time. Updates append a new record and mark
+ *   the old one deleted in place, so frequent checkpoints (frame counters) cost
+ *   one word write rather than a page erase. When the active page fills, live
+ *   records are compacted into the spare page and the old page is erased, which
+ *   spreads erase cycles over both pages.
+ */
+
+#include <string.h>
+
+#include <openthread-types.h>
+#include <platform/flash.h>
+#include <platform/settings.h>
+#include "platform-cc2538.h"
+
+enum
+{
+    kPageSize      = 0x800,
+    kNumPages      = 2,
+
+    kPageMagic     = 0x4f544e56,  // 'OTNV'
+    kPageHeaderSize = 8,          // magic word plus sequence word
+
+    kBlankWord     = 0xffffffff,
+
+    kFlagsInUse    = 0xff,        // record header flags value while the record is live
+    kFlagsDeleted  = 0x00,        // record header flags value once superseded
+
+    kMaxValueSize  = 255,
+};
+
+// One-word record header; the value follows, padded to a word boundary.
+typedef struct RecordHeader
+{
+    uint16_t mKey;
+    uint8_t mLength;
+    uint8_t mFlags;
+} RecordHeader;
+
+static uint32_t sActiveBase;   // base offset of the active page
+static uint32_t sNextOffset;   // append offset relative to the active page base
+
+static uint32_t recordSize(uint8_t aLength)
+{
+    return sizeof(RecordHeader) + (((uint32_t)aLength + 3) & ~(uint32_t)3);
+}
+
+static uint32_t readWord(uint32_t aOffset)
+{
+    uint32_t word = kBlankWord;
+
+    otPlatFlashRead(aOffset, (uint8_t *)&word, sizeof(word));
+
+    return word;
+}
+
+static void initPage(uint32_t aBase, uint32_t aSequence)
+{
+    uint32_t header[2];
+
+    header[0] = kPageMagic;
+    header[1] = aSequence;
+
+    otPlatFlashWrite(aBase, (uint8_t *)header, sizeof(header));
+}
+
+// Scans the active page for the next record at or after aOffset, optionally
+// matching a key. Returns the record offset, or 0 when no record matches.
+static uint32_t findRecord(uint32_t aOffset, uint16_t aKey, bool aMatchKey, RecordHeader *aHeader)
+{
+    RecordHeader header;
+
+    while (aOffset + sizeof(header) <= kPageSize)
+    {
+        otPlatFlashRead(sActiveBase + aOffset, (uint8_t *)&header, sizeof(header));
+
+        if (header.mKey == 0xffff && header.mLength == 0xff && header.mFlags == 0xff)
+        {
+            break;  // blank; end of the log
+        }
+
+        if (header.mFlags == kFlagsInUse && (!aMatchKey || header.mKey == aKey))
+        {
+            *aHeader = header;
+            return aOffset;
+        }
+
+        aOffset += recordSize(header.mLength);
+    }
+
+    return 0;
+}
+
+static void markDeleted(uint32_t aOffset)
+{
+    RecordHeader header;
+
+    otPlatFlashRead(sActiveBase + aOffset, (uint8_t *)&header, sizeof(header));
+    header.mFlags = kFlagsDeleted;
+
+    // second write to the same word only clears bits, which flash allows
+    otPlatFlashWrite(sActiveBase + aOffset, (uint8_t *)&header, sizeof(header));
+}
+
+static void compact(void)
+{
+    uint32_t otherBase = (sActiveBase == 0) ? kPageSize : 0;
+    uint32_t sequence = readWord(sActiveBase + 4) + 1;
+    uint32_t outOffset = kPageHeaderSize;
+    uint32_t inOffset = kPageHeaderSize;
+    RecordHeader header;
+    uint8_t buffer[sizeof(RecordHeader) + kMaxValueSize + 3];
+
+    otPlatFlashErasePage(otherBase);
+    otPlatFlashStatusWait(100);
+    initPage(otherBase, sequence);
+
+    while ((inOffset = findRecord(inOffset, 0, false, &header)) != 0)
+    {
+        uint32_t size = recordSize(header.mLength);
+
+        otPlatFlashRead(sActiveBase + inOffset, buffer, size);
+        otPlatFlashWrite(otherBase + outOffset, buffer, size);
+
+        outOffset += size;
+        inOffset += size;
+    }
+
+    // the new page carries the higher sequence, so a power failure from here
+    // on resolves in its favor; erasing the old page completes the swap
+    otPlatFlashErasePage(sActiveBase);
+    otPlatFlashStatusWait(100);
+
+    sActiveBase = otherBase;
+    sNextOffset = outOffset;
+}
+
+void otPlatSettingsInit(void)
+{
+    uint32_t magic[kNumPages];
+    uint32_t sequence[kNumPages];
+    RecordHeader header;
+    uint32_t offset;
+    uint32_t scan;
+    uint32_t last;
+    uint8_t i;
+
+    otPlatFlashInit();
+
+    for (i = 0; i < kNumPages; i++)
+    {
+        magic[i] = readWord(i * kPageSize);
+        sequence[i] = readWord(i * kPageSize + 4);
+    }
+
+    if (magic[0] != kPageMagic && magic[1] != kPageMagic)
+    {
+        otPlatSettingsWipe();
+        return;
+    }
+
+    if (magic[0] == kPageMagic && magic[1] == kPageMagic)
+    {
+        // both valid: a compaction was interrupted before the erase;
+        // keep the newer page and finish erasing the older one
+        sActiveBase = (sequence[1] - sequence[0] < 0x80000000) ? kPageSize : 0;
+        otPlatFlashErasePage((sActiveBase == 0) ? kPageSize : 0);
+        otPlatFlashStatusWait(100);
+    }
+    else
+    {
+        sActiveBase = (magic[0] == kPageMagic) ? 0 : kPageSize;
+    }
+
+    // find the end of the log
+    offset = kPageHeaderSize;
+
+    while (offset + sizeof(header) <= kPageSize)
+    {
+        otPlatFlashRead(sActiveBase + offset, (uint8_t *)&header, sizeof(header));
+
+        if (header.mKey == 0xffff && header.mLength == 0xff && header.mFlags == 0xff)
+        {
+            break;
+        }
+
+        offset += recordSize(header.mLength);
+    }
+
+    // an append interrupted between the value and header writes leaves dirty
+    // (partially programmed) value words after the blank header; programming a
+    // new record over them would silently corrupt it, since flash writes only
+    // clear bits. Seal any dirty span under deleted-record headers so the
+    // append point is backed by fully blank flash.
+    last = offset;
+
+    for (scan = offset; scan + sizeof(uint32_t) <= kPageSize; scan += sizeof(uint32_t))
+    {
+        if (readWord(sActiveBase + scan) != kBlankWord)
+        {
+            last = scan + sizeof(uint32_t);
+        }
+    }
+
+    while (last > offset)
+    {
+        uint32_t span = last - offset - sizeof(header);
+
+        if (span > kMaxValueSize)
+        {
+            span = kMaxValueSize;
+        }
+
+        header.mKey = 0;
+        header.mLength = (uint8_t)span;
+        header.mFlags = kFlagsDeleted;
+
+        otPlatFlashWrite(sActiveBase + offset, (uint8_t *)&header, sizeof(header));
+        offset += recordSize(header.mLength);
+    }
+
+    sNextOffset = offset;
+}
+
+ThreadError otPlatSettingsBeginChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsCommitChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsAbandonChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsGet(uint16_t aKey, int aIndex, uint8_t *aValue, int *aValueLength)
+{
+    RecordHeader header;
+    uint32_t offset = kPageHeaderSize;
+
+    while ((offset = findRecord(offset, aKey, true, &header)) != 0)
+    {
+        if (aIndex-- > 0)
+        {
+            offset += recordSize(header.mLength);
+            continue;
+        }
+
+        if (aValue != NULL && aValueLength != NULL)
+        {
+            int length = *aValueLength;
+
+            if (length > header.mLength)
+            {
+                length = header.mLength;
+            }
+
+            otPlatFlashRead(sActiveBase + offset + sizeof(header), aValue, (uint32_t)length);
+        }
+
+        if (aValueLength != NULL)
+        {
+            *aValueLength = header.mLength;
+        }
+
+        return kThreadError_None;
+    }
+
+    return kThreadError_NotFound;
+}
+
+ThreadError otPlatSettingsAdd(uint16_t aKey, const uint8_t *aValue, int aValueLength)
+{
+    uint8_t buffer[sizeof(RecordHeader) + kMaxValueSize + 3];
+    RecordHeader *header = (RecordHeader *)buffer;
+    uint32_t size;
+
+    if (aValueLength < 0 || aValueLength > kMaxValueSize || aKey == 0xffff)
+    {
+        return kThreadError_InvalidArgs;
+    }
+
+    size = recordSize((uint8_t)aValueLength);
+
+    if (sNextOffset + size > kPageSize)
+    {
+        compact();
+
+        if (sNextOffset + size > kPageSize)
+        {
+            return kThreadError_NoBufs;
+        }
+    }
+
+    header->mKey = aKey;
+    header->mLength = (uint8_t)aValueLength;
+    header->mFlags = kFlagsInUse;
+
+    memset(buffer + sizeof(RecordHeader), 0xff, size - sizeof(RecordHeader));
+    memcpy(buffer + sizeof(RecordHeader), aValue, (size_t)aValueLength);
+
+    // write the value before the header so an interrupted append leaves a
+    // blank header and the record is simply never seen
+    otPlatFlashWrite(sActiveBase + sNextOffset + sizeof(RecordHeader),
+                     buffer + sizeof(RecordHeader), size - sizeof(RecordHeader));
+    otPlatFlashWrite(sActiveBase + sNextOffset, buffer, sizeof(RecordHeader));
+
+    sNextOffset += size;
+
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsDelete(uint16_t aKey, int aIndex)
+{
+    ThreadError error = kThreadError_NotFound;
+    RecordHeader header;
+    uint32_t offset = kPageHeaderSize;
+
+    while ((offset = findRecord(offset, aKey, true, &header)) != 0)
+    {
+        if (aIndex > 0)
+        {
+            aIndex--;
+        }
+        else
+        {
+            markDeleted(offset);
+            error = kThreadError_None;
+
+            if (aIndex == 0)
+            {
+                break;
+            }
+        }
+
+        offset += recordSize(header.mLength);
+    }
+
+    return error;
+}
+
+ThreadError otPlatSettingsSet(uint16_t aKey, const uint8_t *aValue, int aValueLength)
+{
+    otPlatSettingsDelete(aKey, -1);
+    return otPlatSettingsAdd(aKey, aValue, aValueLength);
+}
+
+void otPlatSettingsWipe(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < kNumPages; i++)
+    {
+        otPlatFlashErasePage(i * kPageSize);
+        otPlatFlashStatusWait(100);
+    }
+
+    initPage(0, 0);
+    sActiveBase = 0;
+    sNextOffset = kPageHeaderSize;
+}
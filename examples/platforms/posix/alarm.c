@@ -51,6 +51,11 @@ uint32_t otPlatAlarmGetNow(void)
 {
     struct timeval tv;
 
+    if (posixReplayIsReplaying())
+    {
+        return posixReplayGetNow();
+    }
+
     gettimeofday(&tv, NULL);
     timersub(&tv, &s_start, &tv);
 
@@ -79,6 +84,14 @@ void posixAlarmUpdateTimeout(struct timeval *aTimeout)
         return;
     }
 
+    if (posixReplayIsReplaying())
+    {
+        // the replay engine drives the virtual clock, so never block in select
+        aTimeout->tv_sec = 0;
+        aTimeout->tv_usec = 0;
+        return;
+    }
+
     if (s_is_running)
     {
         remaining = (int32_t)(s_alarm - otPlatAlarmGetNow());
@@ -101,6 +114,16 @@ void posixAlarmUpdateTimeout(struct timeval *aTimeout)
     }
 }
 
+bool posixAlarmIsPending(uint32_t *aWhen)
+{
+    if (s_is_running && aWhen != NULL)
+    {
+        *aWhen = s_alarm;
+    }
+
+    return s_is_running;
+}
+
 void posixAlarmProcess(otInstance *aInstance)
 {
     int32_t remaining;
@@ -113,6 +136,8 @@ void posixAlarmProcess(otInstance *aInstance)
         {
             s_is_running = false;
 
+            posixReplayRecordAlarm();
+
 #if OPENTHREAD_ENABLE_DIAG
 
             if (otPlatDiagModeGet())
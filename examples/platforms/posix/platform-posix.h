@@ -75,6 +75,27 @@ void posixAlarmUpdateTimeout(struct timeval *tv);
  */
 void posixAlarmProcess(otInstance *aInstance);
 
+/**
+ * This function initializes the platform worker thread.
+ *
+ */
+void posixWorkerInit(void);
+
+/**
+ * This function adds the worker wakeup file descriptor to the read set.
+ *
+ * @param[inout]  aReadFdSet  A pointer to the read file descriptor set.
+ * @param[inout]  aMaxFd      A pointer to the highest file descriptor seen so far.
+ *
+ */
+void posixWorkerUpdateFdSet(fd_set *aReadFdSet, int *aMaxFd);
+
+/**
+ * This function delivers completed worker jobs back to OpenThread.
+ *
+ */
+void posixWorkerProcess(void);
+
 /**
  * This function initializes the radio service used by OpenThread.
  *
@@ -105,6 +126,101 @@ void posixRadioProcess(otInstance *aInstance);
  */
 void posixRandomInit(void);
 
+/**
+ * This function initializes the record/replay service.
+ *
+ * Recording starts when OT_RADIO_RECORD names a trace file in the
+ * environment, and replaying starts when OT_RADIO_REPLAY does.
+ *
+ */
+void posixReplayInit(void);
+
+/**
+ * This function indicates whether a recorded trace is being replayed.
+ *
+ * @returns true if replaying a trace, false otherwise.
+ *
+ */
+bool posixReplayIsReplaying(void);
+
+/**
+ * This function indicates whether recorded events remain to be delivered.
+ *
+ * @returns true if trace events remain, false otherwise.
+ *
+ */
+bool posixReplayIsPlaying(void);
+
+/**
+ * This function returns the current virtual time during replay.
+ *
+ * @returns The virtual time in milliseconds.
+ *
+ */
+uint32_t posixReplayGetNow(void);
+
+/**
+ * This function appends a received radio message to the trace being recorded.
+ *
+ * @param[in]  aBuf     A pointer to the radio message.
+ * @param[in]  aLength  The radio message length.
+ *
+ */
+void posixReplayRecordFrame(const void *aBuf, uint16_t aLength);
+
+/**
+ * This function appends an alarm firing to the trace being recorded.
+ *
+ */
+void posixReplayRecordAlarm(void);
+
+/**
+ * This function appends received UART bytes to the trace being recorded.
+ *
+ * @param[in]  aBuf     A pointer to the received bytes.
+ * @param[in]  aLength  The number of received bytes.
+ *
+ */
+void posixReplayRecordUart(const void *aBuf, uint16_t aLength);
+
+/**
+ * This function advances the virtual clock to the next recorded event and
+ * retrieves it if it is a radio message.
+ *
+ * The clock never advances past a pending alarm, so that alarms fire in
+ * the same order relative to radio messages as they did when recording.
+ *
+ * @param[out]  aBuf        A pointer to where the radio message is copied.
+ * @param[in]   aMaxLength  The maximum number of bytes that can be copied.
+ * @param[out]  aLength     A pointer to where the radio message length is stored.
+ *
+ * @returns true if a radio message was retrieved, false otherwise.
+ *
+ */
+bool posixReplayNextFrame(void *aBuf, uint16_t aMaxLength, uint16_t *aLength);
+
+/**
+ * This function retrieves the next recorded event if it is UART input due now.
+ *
+ * @param[out]  aBuf        A pointer to where the received bytes are copied.
+ * @param[in]   aMaxLength  The maximum number of bytes that can be copied.
+ * @param[out]  aLength     A pointer to where the number of bytes is stored.
+ *
+ * @returns true if UART input was retrieved, false otherwise.
+ *
+ */
+bool posixReplayNextUart(void *aBuf, uint16_t aMaxLength, uint16_t *aLength);
+
+/**
+ * This function indicates whether the alarm is running and when it fires.
+ *
+ * @param[out]  aWhen  A pointer to where the firing time is stored.
+ *
+ * @returns true if the alarm is running, false otherwise.
+ *
+ */
+bool posixAlarmIsPending(uint32_t *aWhen);
+
 /**
  * This function updates the file descriptor sets with file descriptors used by the UART driver.
  *
@@ -68,6 +68,8 @@ void PlatformInit(int argc, char *argv[])
     posixAlarmInit();
     posixRadioInit();
     posixRandomInit();
+    posixReplayInit();
+    posixWorkerInit();
     otPlatUartEnable();
 }
 
@@ -86,6 +88,7 @@ void PlatformProcessDrivers(otInstance *aInstance)
 
     posixUartUpdateFdSet(&read_fds, &write_fds, &error_fds, &max_fd);
     posixRadioUpdateFdSet(&read_fds, &write_fds, &max_fd);
+    posixWorkerUpdateFdSet(&read_fds, &max_fd);
     posixAlarmUpdateTimeout(&timeout);
 
     if (!otAreTaskletsPending(aInstance))
@@ -99,6 +102,7 @@ void PlatformProcessDrivers(otInstance *aInstance)
         }
     }
 
+    posixWorkerProcess();
     posixUartProcess();
     posixRadioProcess(aInstance);
     posixAlarmProcess(aInstance);
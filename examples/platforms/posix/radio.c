@@ -42,6 +42,7 @@
 #include <openthread.h>
 #include <openthread-config.h>
 
+#include <platform/alarm.h>
 #include <platform/radio.h>
 #include <platform/diag.h>
 
@@ -100,15 +101,22 @@ static void radioTransmit(const struct RadioMessage *msg, const struct RadioPack
 static void radioSendMessage(otInstance *aInstance);
 static void radioSendAck(void);
 static void radioProcessFrame(otInstance *aInstance);
+static void radioReceiveMessage(otInstance *aInstance, uint16_t aLength);
+static void radioFlushReceiveEvents(otInstance *aInstance);
 
 static PhyState sState = kStateDisabled;
-static struct RadioMessage sReceiveMessage;
+static struct RadioMessage sReceiveMessages[kPhyRxRingSize];
 static struct RadioMessage sTransmitMessage;
 static struct RadioMessage sAckMessage;
-static RadioPacket sReceiveFrame;
+static RadioPacket sReceiveFrames[kPhyRxRingSize];
 static RadioPacket sTransmitFrame;
 static RadioPacket sAckFrame;
 
+// received frames accumulate here and cross into the core as one batch per
+// process pass; the slot at index sReceiveEventCount is the one being filled
+static RadioFrameEvent sReceiveEvents[kPhyRxRingSize];
+static uint8_t sReceiveEventCount = 0;
+
 static uint8_t sExtendedAddress[OT_EXT_ADDRESS_SIZE];
 static uint16_t sShortAddress;
 static uint16_t sPanid;
@@ -331,6 +339,7 @@ void posixRadioInit(void)
 {
     struct sockaddr_in sockaddr;
     char *offset;
+    uint8_t i;
     memset(&sockaddr, 0, sizeof(sockaddr));
     sockaddr.sin_family = AF_INET;
 
@@ -365,7 +374,11 @@ void posixRadioInit(void)
     sSockFd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     bind(sSockFd, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
 
-    sReceiveFrame.mPsdu = sReceiveMessage.mPsdu;
+    for (i = 0; i < kPhyRxRingSize; i++)
+    {
+        sReceiveFrames[i].mPsdu = sReceiveMessages[i].mPsdu;
+    }
+
     sTransmitFrame.mPsdu = sTransmitMessage.mPsdu;
     sAckFrame.mPsdu = sAckMessage.mPsdu;
 }
@@ -421,6 +434,7 @@ ThreadError otPlatRadioSleep(otInstance *aInstance)
 ThreadError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel)
 {
     ThreadError error = kThreadError_Busy;
+    uint8_t i;
     (void)aInstance;
 
     if (sState != kStateDisabled)
@@ -428,7 +442,11 @@ ThreadError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel)
         error = kThreadError_None;
         sState = kStateReceive;
         sAckWait = false;
-        sReceiveFrame.mChannel = aChannel;
+
+        for (i = 0; i < kPhyRxRingSize; i++)
+        {
+            sReceiveFrames[i].mChannel = aChannel;
+        }
     }
 
     return error;
@@ -474,7 +492,8 @@ bool otPlatRadioGetPromiscuous(otInstance *aInstance)
 
 void radioReceive(otInstance *aInstance)
 {
-    ssize_t rval = recvfrom(sSockFd, &sReceiveMessage, sizeof(sReceiveMessage), 0, NULL, NULL);
+    struct RadioMessage *message = &sReceiveMessages[sReceiveEventCount];
+    ssize_t rval = recvfrom(sSockFd, message, sizeof(*message), 0, NULL, NULL);
 
     if (rval < 0)
     {
@@ -482,30 +501,46 @@ void radioReceive(otInstance *aInstance)
         exit(EXIT_FAILURE);
     }
 
-    sReceiveFrame.mLength = (uint8_t)(rval - 1);
+    // capture the message before any filtering so a replay reproduces the
+    // same drops
+    posixReplayRecordFrame(message, (uint16_t)rval);
+
+    radioReceiveMessage(aInstance, (uint16_t)rval);
+}
+
+void radioReceiveMessage(otInstance *aInstance, uint16_t aLength)
+{
+    struct RadioMessage *message = &sReceiveMessages[sReceiveEventCount];
+    RadioPacket *frame = &sReceiveFrames[sReceiveEventCount];
+
+    frame->mLength = (uint8_t)(aLength - 1);
 
     if (sAckWait &&
-        sTransmitFrame.mChannel == sReceiveMessage.mChannel &&
-        isFrameTypeAck(sReceiveFrame.mPsdu) &&
-        getDsn(sReceiveFrame.mPsdu) == getDsn(sTransmitFrame.mPsdu))
+        sTransmitFrame.mChannel == message->mChannel &&
+        isFrameTypeAck(frame->mPsdu) &&
+        getDsn(frame->mPsdu) == getDsn(sTransmitFrame.mPsdu))
     {
         sState = kStateReceive;
         sAckWait = false;
 
+        // preserve ordering: frames received before the ack are handed to the
+        // core before its transmit-done processing runs
+        radioFlushReceiveEvents(aInstance);
+
 #if OPENTHREAD_ENABLE_DIAG
 
         if (otPlatDiagModeGet())
         {
-            otPlatDiagRadioTransmitDone(aInstance, isFramePending(sReceiveFrame.mPsdu), kThreadError_None);
+            otPlatDiagRadioTransmitDone(aInstance, isFramePending(frame->mPsdu), kThreadError_None);
         }
         else
 #endif
         {
-            otPlatRadioTransmitDone(aInstance, isFramePending(sReceiveFrame.mPsdu), kThreadError_None);
+            otPlatRadioTransmitDone(aInstance, isFramePending(frame->mPsdu), kThreadError_None);
         }
     }
     else if ((sState == kStateReceive || sState == kStateTransmit) &&
-             (sReceiveFrame.mChannel == sReceiveMessage.mChannel))
+             (frame->mChannel == message->mChannel))
     {
         radioProcessFrame(aInstance);
     }
@@ -539,6 +574,12 @@ void radioSendMessage(otInstance *aInstance)
 
 void posixRadioUpdateFdSet(fd_set *aReadFdSet, fd_set *aWriteFdSet, int *aMaxFd)
 {
+    if (posixReplayIsReplaying())
+    {
+        // during replay the socket is ignored and frames come from the trace
+        return;
+    }
+
     if (aReadFdSet != NULL && (sState != kStateTransmit || sAckWait))
     {
         FD_SET(sSockFd, aReadFdSet);
@@ -565,10 +606,36 @@ void posixRadioProcess(otInstance *aInstance)
     const int flags = POLLIN | POLLRDNORM | POLLERR | POLLNVAL | POLLHUP;
     struct pollfd pollfd = { sSockFd, flags, 0 };
 
-    if (poll(&pollfd, 1, 0) > 0 && (pollfd.revents & flags) != 0)
+    uint8_t count;
+
+    if (posixReplayIsReplaying())
     {
-        radioReceive(aInstance);
+        uint16_t length;
+
+        // deliver one recorded event per pass to preserve the original
+        // interleaving with alarm firings
+        if (posixReplayNextFrame(&sReceiveMessages[sReceiveEventCount],
+                                 sizeof(sReceiveMessages[0]), &length))
+        {
+            radioReceiveMessage(aInstance, length);
+        }
     }
+    else
+    {
+        // drain a short burst of frames per pass instead of a single one
+        for (count = 0; count < kPhyRxRingSize; count++)
+        {
+            if (poll(&pollfd, 1, 0) <= 0 || (pollfd.revents & flags) == 0)
+            {
+                break;
+            }
+
+            radioReceive(aInstance);
+        }
+    }
+
+    // hand the drained burst to the core as a single batch
+    radioFlushReceiveEvents(aInstance);
 
     if (sState == kStateTransmit && !sAckWait)
     {
@@ -581,6 +648,12 @@ void radioTransmit(const struct RadioMessage *msg, const struct RadioPacket *pkt
     uint32_t i;
     struct sockaddr_in sockaddr;
 
+    if (posixReplayIsReplaying())
+    {
+        // nothing listens during replay, so transmissions go nowhere
+        return;
+    }
+
     memset(&sockaddr, 0, sizeof(sockaddr));
     sockaddr.sin_family = AF_INET;
     inet_pton(AF_INET, "127.0.0.1", &sockaddr.sin_addr);
@@ -608,18 +681,20 @@ void radioTransmit(const struct RadioMessage *msg, const struct RadioPacket *pkt
 
 void radioSendAck(void)
 {
+    RadioPacket *frame = &sReceiveFrames[sReceiveEventCount];
+
     sAckFrame.mLength = IEEE802154_ACK_LENGTH;
     sAckMessage.mPsdu[0] = IEEE802154_FRAME_TYPE_ACK;
 
-    if (isDataRequest(sReceiveFrame.mPsdu))
+    if (isDataRequest(frame->mPsdu))
     {
         sAckMessage.mPsdu[0] |= IEEE802154_FRAME_PENDING;
     }
 
     sAckMessage.mPsdu[1] = 0;
-    sAckMessage.mPsdu[2] = getDsn(sReceiveFrame.mPsdu);
+    sAckMessage.mPsdu[2] = getDsn(frame->mPsdu);
 
-    sAckMessage.mChannel = sReceiveFrame.mChannel;
+    sAckMessage.mChannel = frame->mChannel;
 
     radioTransmit(&sAckMessage, &sAckFrame);
 }
@@ -627,28 +702,29 @@ void radioSendAck(void)
 void radioProcessFrame(otInstance *aInstance)
 {
     ThreadError error = kThreadError_None;
+    RadioPacket *frame = &sReceiveFrames[sReceiveEventCount];
     otPanId dstpan;
     otShortAddress short_address;
     otExtAddress ext_address;
 
     VerifyOrExit(sPromiscuous == false, error = kThreadError_None);
 
-    switch (sReceiveFrame.mPsdu[1] & IEEE802154_DST_ADDR_MASK)
+    switch (frame->mPsdu[1] & IEEE802154_DST_ADDR_MASK)
     {
     case IEEE802154_DST_ADDR_NONE:
         break;
 
     case IEEE802154_DST_ADDR_SHORT:
-        dstpan = getDstPan(sReceiveFrame.mPsdu);
-        short_address = getShortAddress(sReceiveFrame.mPsdu);
+        dstpan = getDstPan(frame->mPsdu);
+        short_address = getShortAddress(frame->mPsdu);
         VerifyOrExit((dstpan == IEEE802154_BROADCAST || dstpan == sPanid) &&
                      (short_address == IEEE802154_BROADCAST || short_address == sShortAddress),
                      error = kThreadError_Abort);
         break;
 
     case IEEE802154_DST_ADDR_EXT:
-        dstpan = getDstPan(sReceiveFrame.mPsdu);
-        getExtAddress(sReceiveFrame.mPsdu, &ext_address);
+        dstpan = getDstPan(frame->mPsdu);
+        getExtAddress(frame->mPsdu, &ext_address);
         VerifyOrExit((dstpan == IEEE802154_BROADCAST || dstpan == sPanid) &&
                      memcmp(&ext_address, sExtendedAddress, sizeof(ext_address)) == 0,
                      error = kThreadError_Abort);
@@ -658,11 +734,14 @@ void radioProcessFrame(otInstance *aInstance)
         ExitNow(error = kThreadError_Abort);
     }
 
-    sReceiveFrame.mPower = -20;
-    sReceiveFrame.mLqi = kPhyNoLqi;
+    frame->mPower = -20;
+    frame->mLqi = kPhyNoLqi;
+
+    // no SFD capture on the simulated radio; approximate with the receive completion time
+    frame->mTimestamp = otPlatAlarmGetNow();
 
     // generate acknowledgment
-    if (isAckRequested(sReceiveFrame.mPsdu))
+    if (isAckRequested(frame->mPsdu))
     {
         radioSendAck();
     }
@@ -673,12 +752,25 @@ exit:
 
     if (otPlatDiagModeGet())
     {
-        otPlatDiagRadioReceiveDone(aInstance, error == kThreadError_None ? &sReceiveFrame : NULL, error);
+        otPlatDiagRadioReceiveDone(aInstance, error == kThreadError_None ? frame : NULL, error);
     }
     else
 #endif
     {
-        otPlatRadioReceiveDone(aInstance, error == kThreadError_None ? &sReceiveFrame : NULL, error);
+        // queue the completion; the batch crosses into the core at the end of
+        // the process pass
+        sReceiveEvents[sReceiveEventCount].mPacket = (error == kThreadError_None) ? frame : NULL;
+        sReceiveEvents[sReceiveEventCount].mError = error;
+        sReceiveEventCount++;
+    }
+}
+
+void radioFlushReceiveEvents(otInstance *aInstance)
+{
+    if (sReceiveEventCount > 0)
+    {
+        otPlatRadioReceiveDoneBatch(aInstance, sReceiveEvents, sReceiveEventCount);
+        sReceiveEventCount = 0;
     }
 }
 
@@ -0,0 +1,261 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements record and replay of radio and alarm events.
+ *
+ *   With OT_RADIO_RECORD=<file> in the environment, every radio message
+ *   received from the virtual radio and every alarm firing is appended to
+ *   the trace file together with its millisecond timestamp.  With
+ *   OT_RADIO_REPLAY=<file>, the node runs against a virtual clock and the
+ *   recorded events are delivered in the exact order and at the exact
+ *   (virtual) times at which they originally occurred, so that a
+ *   timing-dependent failure captured once can be reproduced on demand,
+ *   including against a rebuilt binary.  UART input is captured as well so
+ *   that commands typed during the recording are re-issued at the same
+ *   point in the event sequence.  The pseudo-random service is already
+ *   seeded from NODE_ID, so no randomness needs to be captured.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <openthread.h>
+#include <openthread-config.h>
+
+#include <platform/alarm.h>
+#include <platform/radio.h>
+
+#include <common/code_utils.hpp>
+#include "platform-posix.h"
+
+enum
+{
+    kEventTypeFrame = 1,   ///< A radio message received from the socket.
+    kEventTypeAlarm = 2,   ///< An alarm firing, recorded as a time marker.
+    kEventTypeUart  = 3,   ///< Bytes received on the UART.
+};
+
+static const char sTraceMagic[8] = "OTTRACE1";
+
+static FILE *sRecordFile = NULL;
+static FILE *sReplayFile = NULL;
+static bool sReplayMode = false;
+static uint32_t sVirtualNow = 0;
+
+// the next event read ahead from the trace
+static bool sEventValid = false;
+static uint8_t sEventType;
+static uint32_t sEventTime;
+static uint16_t sEventLength;
+static uint8_t sEventData[128];  // >= radio message and uart read sizes
+
+static void replayLoadNextEvent(void)
+{
+    sEventValid = false;
+
+    VerifyOrExit(sReplayFile != NULL, ;);
+    VerifyOrExit(fread(&sEventType, sizeof(sEventType), 1, sReplayFile) == 1, ;);
+    VerifyOrExit(fread(&sEventTime, sizeof(sEventTime), 1, sReplayFile) == 1, ;);
+
+    VerifyOrExit(sEventType == kEventTypeFrame || sEventType == kEventTypeAlarm ||
+                 sEventType == kEventTypeUart, ;);
+    VerifyOrExit(fread(&sEventLength, sizeof(sEventLength), 1, sReplayFile) == 1, ;);
+    VerifyOrExit(sEventLength <= sizeof(sEventData), ;);
+    VerifyOrExit(fread(sEventData, 1, sEventLength, sReplayFile) == sEventLength, ;);
+
+    sEventValid = true;
+
+exit:
+
+    if (!sEventValid && sReplayFile != NULL)
+    {
+        fprintf(stderr, "replay: end of trace at %u ms\n", (unsigned int)sVirtualNow);
+        fclose(sReplayFile);
+        sReplayFile = NULL;
+    }
+}
+
+void posixReplayInit(void)
+{
+    const char *path;
+    char magic[sizeof(sTraceMagic)];
+
+    path = getenv("OT_RADIO_RECORD");
+
+    if (path != NULL)
+    {
+        sRecordFile = fopen(path, "wb");
+
+        if (sRecordFile == NULL)
+        {
+            perror("fopen");
+            exit(EXIT_FAILURE);
+        }
+
+        fwrite(sTraceMagic, sizeof(sTraceMagic), 1, sRecordFile);
+        fflush(sRecordFile);
+    }
+
+    path = getenv("OT_RADIO_REPLAY");
+
+    if (path != NULL)
+    {
+        if (sRecordFile != NULL)
+        {
+            fprintf(stderr, "OT_RADIO_RECORD and OT_RADIO_REPLAY are mutually exclusive\n");
+            exit(EXIT_FAILURE);
+        }
+
+        sReplayFile = fopen(path, "rb");
+
+        if (sReplayFile == NULL)
+        {
+            perror("fopen");
+            exit(EXIT_FAILURE);
+        }
+
+        if (fread(magic, sizeof(magic), 1, sReplayFile) != 1 ||
+            memcmp(magic, sTraceMagic, sizeof(magic)) != 0)
+        {
+            fprintf(stderr, "Invalid trace file: %s\n", path);
+            exit(EXIT_FAILURE);
+        }
+
+        sReplayMode = true;
+        replayLoadNextEvent();
+    }
+}
+
+bool posixReplayIsReplaying(void)
+{
+    return sReplayMode;
+}
+
+bool posixReplayIsPlaying(void)
+{
+    return sEventValid;
+}
+
+uint32_t posixReplayGetNow(void)
+{
+    return sVirtualNow;
+}
+
+static void replayRecordEvent(uint8_t aType, const void *aBuf, uint16_t aLength)
+{
+    uint32_t now = otPlatAlarmGetNow();
+
+    VerifyOrExit(sRecordFile != NULL, ;);
+
+    fwrite(&aType, sizeof(aType), 1, sRecordFile);
+    fwrite(&now, sizeof(now), 1, sRecordFile);
+    fwrite(&aLength, sizeof(aLength), 1, sRecordFile);
+    fwrite(aBuf, 1, aLength, sRecordFile);
+    fflush(sRecordFile);
+
+exit:
+    return;
+}
+
+void posixReplayRecordFrame(const void *aBuf, uint16_t aLength)
+{
+    replayRecordEvent(kEventTypeFrame, aBuf, aLength);
+}
+
+void posixReplayRecordUart(const void *aBuf, uint16_t aLength)
+{
+    replayRecordEvent(kEventTypeUart, aBuf, aLength);
+}
+
+void posixReplayRecordAlarm(void)
+{
+    replayRecordEvent(kEventTypeAlarm, "", 0);
+}
+
+static void replayAdvanceClock(void)
+{
+    if ((int32_t)(sEventTime - sVirtualNow) > 0)
+    {
+        sVirtualNow = sEventTime;
+    }
+}
+
+bool posixReplayNextFrame(void *aBuf, uint16_t aMaxLength, uint16_t *aLength)
+{
+    bool rval = false;
+    uint32_t alarmTime;
+
+    if (sEventValid && sEventType != kEventTypeUart)
+    {
+        replayAdvanceClock();
+
+        if (sEventType == kEventTypeFrame && sEventLength <= aMaxLength)
+        {
+            memcpy(aBuf, sEventData, sEventLength);
+            *aLength = sEventLength;
+            rval = true;
+        }
+
+        // an alarm marker only advances the virtual clock, which makes the
+        // alarm driver fire the alarm at the same point in the sequence at
+        // which it fired during recording
+        replayLoadNextEvent();
+    }
+    else if (!sEventValid && posixAlarmIsPending(&alarmTime) && (int32_t)(alarmTime - sVirtualNow) > 0)
+    {
+        // past the end of the trace, keep firing pending alarms so the
+        // node continues to run
+        sVirtualNow = alarmTime;
+    }
+
+    return rval;
+}
+
+bool posixReplayNextUart(void *aBuf, uint16_t aMaxLength, uint16_t *aLength)
+{
+    bool rval = false;
+
+    VerifyOrExit(sEventValid && sEventType == kEventTypeUart, ;);
+
+    replayAdvanceClock();
+
+    if (sEventLength <= aMaxLength)
+    {
+        memcpy(aBuf, sEventData, sEventLength);
+        *aLength = sEventLength;
+        rval = true;
+    }
+
+    replayLoadNextEvent();
+
+exit:
+    return rval;
+}
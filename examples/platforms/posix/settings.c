@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a RAM-backed version of the settings platform abstraction.
+ *
+ *   Settings stored here survive an OpenThread reset but not a process restart.
+ */
+
+#include <string.h>
+
+#include <openthread-types.h>
+#include <platform/settings.h>
+#include "platform-posix.h"
+
+enum
+{
+    kMaxEntries = 16,
+    kMaxValueSize = 32,
+};
+
+typedef struct SettingsEntry
+{
+    uint16_t mKey;
+    uint8_t mLength;
+    uint8_t mValue[kMaxValueSize];
+    bool mInUse;
+} SettingsEntry;
+
+static SettingsEntry sEntries[kMaxEntries];
+
+void otPlatSettingsInit(void)
+{
+}
+
+ThreadError otPlatSettingsBeginChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsCommitChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsAbandonChange(void)
+{
+    return kThreadError_None;
+}
+
+ThreadError otPlatSettingsGet(uint16_t aKey, int aIndex, uint8_t *aValue, int *aValueLength)
+{
+    ThreadError error = kThreadError_NotFound;
+
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        if (!sEntries[i].mInUse || sEntries[i].mKey != aKey)
+        {
+            continue;
+        }
+
+        if (aIndex-- > 0)
+        {
+            continue;
+        }
+
+        if (aValue != NULL && aValueLength != NULL)
+        {
+            if (*aValueLength > sEntries[i].mLength)
+            {
+                *aValueLength = sEntries[i].mLength;
+            }
+
+            memcpy(aValue, sEntries[i].mValue, *aValueLength);
+        }
+
+        if (aValueLength != NULL)
+        {
+            *aValueLength = sEntries[i].mLength;
+        }
+
+        error = kThreadError_None;
+        break;
+    }
+
+    return error;
+}
+
+ThreadError otPlatSettingsSet(uint16_t aKey, const uint8_t *aValue, int aValueLength)
+{
+    otPlatSettingsDelete(aKey, -1);
+    return otPlatSettingsAdd(aKey, aValue, aValueLength);
+}
+
+ThreadError otPlatSettingsAdd(uint16_t aKey, const uint8_t *aValue, int aValueLength)
+{
+    ThreadError error = kThreadError_NoBufs;
+
+    if (aValueLength < 0 || aValueLength > kMaxValueSize)
+    {
+        return kThreadError_InvalidArgs;
+    }
+
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        if (sEntries[i].mInUse)
+        {
+            continue;
+        }
+
+        sEntries[i].mKey = aKey;
+        sEntries[i].mLength = (uint8_t)aValueLength;
+        memcpy(sEntries[i].mValue, aValue, (size_t)aValueLength);
+        sEntries[i].mInUse = true;
+        error = kThreadError_None;
+        break;
+    }
+
+    return error;
+}
+
+ThreadError otPlatSettingsDelete(uint16_t aKey, int aIndex)
+{
+    ThreadError error = kThreadError_NotFound;
+
+    for (int i = 0; i < kMaxEntries; i++)
+    {
+        if (!sEntries[i].mInUse || sEntries[i].mKey != aKey)
+        {
+            continue;
+        }
+
+        if (aIndex > 0)
+        {
+            aIndex--;
+            continue;
+        }
+
+        sEntries[i].mInUse = false;
+        error = kThreadError_None;
+
+        if (aIndex == 0)
+        {
+            break;
+        }
+    }
+
+    return error;
+}
+
+void otPlatSettingsWipe(void)
+{
+    memset(sEntries, 0, sizeof(sEntries));
+}
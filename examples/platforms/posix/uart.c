@@ -229,6 +229,18 @@ void posixUartProcess(void)
         exit(EXIT_FAILURE);
     }
 
+    if (posixReplayIsPlaying())
+    {
+        uint16_t length;
+
+        // live input is held back while a trace is playing so that only
+        // the recorded bytes drive the node
+        if (posixReplayNextUart(s_receive_buffer, sizeof(s_receive_buffer), &length))
+        {
+            otPlatUartReceived(s_receive_buffer, length);
+        }
+    }
+
     if (rval > 0)
     {
         if ((pollfd[0].revents & error_flags) != 0)
@@ -243,7 +255,7 @@ void posixUartProcess(void)
             exit(EXIT_FAILURE);
         }
 
-        if (pollfd[0].revents & POLLIN)
+        if (!posixReplayIsPlaying() && (pollfd[0].revents & POLLIN))
         {
             rval = read(s_in_fd, s_receive_buffer, sizeof(s_receive_buffer));
 
@@ -253,6 +265,8 @@ void posixUartProcess(void)
                 exit(EXIT_FAILURE);
             }
 
+            posixReplayRecordUart(s_receive_buffer, (uint16_t)rval);
+
             otPlatUartReceived(s_receive_buffer, (uint16_t)rval);
         }
 
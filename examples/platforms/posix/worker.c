@@ -0,0 +1,206 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the platform worker using a pthread.
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <platform/worker.h>
+#include "platform-posix.h"
+
+static pthread_t sWorkerThread;
+static pthread_mutex_t sWorkerMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sWorkerCond = PTHREAD_COND_INITIALIZER;
+
+static otPlatWorkerJob *sPendingHead = NULL;
+static otPlatWorkerJob *sPendingTail = NULL;
+static otPlatWorkerJob *sDoneHead = NULL;
+static otPlatWorkerJob *sDoneTail = NULL;
+
+static int sWakePipe[2] = {-1, -1};
+static bool sWorkerRunning = false;
+
+static void *workerThreadMain(void *aArg)
+{
+    otPlatWorkerJob *job;
+    ssize_t rval;
+
+    (void)aArg;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&sWorkerMutex);
+
+        while (sPendingHead == NULL)
+        {
+            pthread_cond_wait(&sWorkerCond, &sWorkerMutex);
+        }
+
+        job = sPendingHead;
+        sPendingHead = job->mNext;
+
+        if (sPendingHead == NULL)
+        {
+            sPendingTail = NULL;
+        }
+
+        pthread_mutex_unlock(&sWorkerMutex);
+
+        job->mNext = NULL;
+        job->mWork(job);
+
+        pthread_mutex_lock(&sWorkerMutex);
+
+        if (sDoneTail == NULL)
+        {
+            sDoneHead = job;
+        }
+        else
+        {
+            sDoneTail->mNext = job;
+        }
+
+        sDoneTail = job;
+        pthread_mutex_unlock(&sWorkerMutex);
+
+        rval = write(sWakePipe[1], "w", 1);
+        (void)rval;
+    }
+
+    return NULL;
+}
+
+void posixWorkerInit(void)
+{
+    if (pipe(sWakePipe) != 0)
+    {
+        return;
+    }
+
+    fcntl(sWakePipe[0], F_SETFL, fcntl(sWakePipe[0], F_GETFL) | O_NONBLOCK);
+
+    if (pthread_create(&sWorkerThread, NULL, workerThreadMain, NULL) != 0)
+    {
+        close(sWakePipe[0]);
+        close(sWakePipe[1]);
+        sWakePipe[0] = -1;
+        sWakePipe[1] = -1;
+        return;
+    }
+
+    sWorkerRunning = true;
+}
+
+bool otPlatWorkerPost(otPlatWorkerJob *aJob)
+{
+    if (!sWorkerRunning)
+    {
+        return false;
+    }
+
+    aJob->mNext = NULL;
+
+    pthread_mutex_lock(&sWorkerMutex);
+
+    if (sPendingTail == NULL)
+    {
+        sPendingHead = aJob;
+    }
+    else
+    {
+        sPendingTail->mNext = aJob;
+    }
+
+    sPendingTail = aJob;
+    pthread_cond_signal(&sWorkerCond);
+    pthread_mutex_unlock(&sWorkerMutex);
+
+    return true;
+}
+
+void posixWorkerUpdateFdSet(fd_set *aReadFdSet, int *aMaxFd)
+{
+    if (!sWorkerRunning)
+    {
+        return;
+    }
+
+    FD_SET(sWakePipe[0], aReadFdSet);
+
+    if (*aMaxFd < sWakePipe[0])
+    {
+        *aMaxFd = sWakePipe[0];
+    }
+}
+
+void posixWorkerProcess(void)
+{
+    char buf[8];
+    otPlatWorkerJob *job;
+
+    if (!sWorkerRunning)
+    {
+        return;
+    }
+
+    while (read(sWakePipe[0], buf, sizeof(buf)) > 0)
+    {
+    }
+
+    for (;;)
+    {
+        pthread_mutex_lock(&sWorkerMutex);
+
+        job = sDoneHead;
+
+        if (job != NULL)
+        {
+            sDoneHead = job->mNext;
+
+            if (sDoneHead == NULL)
+            {
+                sDoneTail = NULL;
+            }
+        }
+
+        pthread_mutex_unlock(&sWorkerMutex);
+
+        if (job == NULL)
+        {
+            break;
+        }
+
+        job->mNext = NULL;
+        job->mDone(job);
+    }
+}
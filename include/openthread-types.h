@@ -132,6 +132,11 @@ typedef enum ThreadError
      */
     kThreadError_BlacklistFiltered = 27,
 
+    /**
+     * Received a duplicated frame.
+     */
+    kThreadError_Duplicated = 28,
+
     kThreadError_Error = 255,
 } ThreadError;
 
@@ -256,6 +261,7 @@ typedef OT_TOOL_PACKED_BEGIN struct otIp6Address
         uint8_t  m8[OT_IP6_ADDRESS_SIZE];                      ///< 8-bit fields
         uint16_t m16[OT_IP6_ADDRESS_SIZE / sizeof(uint16_t)];  ///< 16-bit fields
         uint32_t m32[OT_IP6_ADDRESS_SIZE / sizeof(uint32_t)];  ///< 32-bit fields
+        uint64_t m64[OT_IP6_ADDRESS_SIZE / sizeof(uint64_t)];  ///< 64-bit fields
     } mFields;                                                 ///< IPv6 accessor fields
 } OT_TOOL_PACKED_END otIp6Address;
 
@@ -405,6 +411,7 @@ typedef enum otMeshcopTlvType
     OT_MESHCOP_TLV_PERIOD             = 55,   ///< meshcop Period TLV
     OT_MESHCOP_TLV_SCAN_DURATION      = 56,   ///< meshcop Scan Duration TLV
     OT_MESHCOP_TLV_ENERGY_LIST        = 57,   ///< meshcop Energy List TLV
+    OT_MESHCOP_TLV_COMP_ENERGY_LIST   = 58,   ///< meshcop Compressed Energy List TLV
     OT_MESHCOP_TLV_DISCOVERYREQUEST   = 128,  ///< meshcop Discovery Request TLV
     OT_MESHCOP_TLV_DISCOVERYRESPONSE  = 129,  ///< meshcop Discovery Response TLV
 } otMeshcopTlvType;
@@ -580,6 +587,15 @@ typedef enum otMleAttachFilter
     kMleAttachBetterPartition = 2,  ///< Attach to a better (i.e. higher weight/partition id) Thread partition.
 } otMleAttachFilter;
 
+/**
+ * Represents the timing profile used during the attach process.
+ */
+typedef enum otMleAttachProfile
+{
+    kMleAttachProfileStandard   = 0,  ///< Spec-conservative Parent Request timing.
+    kMleAttachProfileAggressive = 1,  ///< Shortened Parent Request timing for low-latency environments.
+} otMleAttachProfile;
+
 /**
  * This structure represents a whitelist entry.
  *
@@ -592,6 +608,15 @@ typedef struct otMacWhitelistEntry
     bool         mFixedRssi : 1;    ///< Indicates whether or not the RSSI value is fixed.
 } otMacWhitelistEntry;
 
+/**
+ * This enumeration defines the size of the MAC whitelist table.
+ *
+ */
+enum
+{
+    OT_MAC_WHITELIST_MAX_ENTRIES = 32,  ///< Maximum number of MAC whitelist entries.
+};
+
 /**
  * This structure represents a blacklist entry.
  *
@@ -648,12 +673,34 @@ typedef struct
     uint8_t        mNetworkDataVersion;    ///< Network Data Version
     uint8_t        mLinkQualityIn;         ///< Link Quality In
     int8_t         mAverageRssi;           ///< Average RSSI
+    uint8_t        mFrameErrorRate;        ///< MAC frame error rate toward this child (255 = every attempt failed)
+    uint32_t       mTxAirtimeUs;           ///< Microseconds of transmit airtime toward this child
+    uint32_t       mRxAirtimeUs;           ///< Microseconds of receive airtime from this child
     bool           mRxOnWhenIdle : 1;      ///< rx-on-when-idle
     bool           mSecureDataRequest : 1; ///< Secure Data Requests
     bool           mFullFunction : 1;      ///< Full Function Device
     bool           mFullNetworkData : 1;   ///< Full Network Data
 } otChildInfo;
 
+/**
+ * This structure holds the attachment state of a Thread Child for export and import.
+ *
+ * The fields carry the minimum state a standby router needs to accept a Child Update Request
+ * from the child without a full reattach.
+ *
+ */
+typedef struct
+{
+    otExtAddress   mExtAddress;            ///< IEEE 802.15.4 Extended Address
+    uint32_t       mTimeout;               ///< Timeout
+    uint32_t       mLinkFrameCounter;      ///< Link Frame Counter
+    uint32_t       mMleFrameCounter;       ///< MLE Frame Counter
+    uint32_t       mKeySequence;           ///< Key sequence in use with this child
+    uint16_t       mRloc16;                ///< RLOC16
+    uint8_t        mMode;                  ///< MLE Device Mode
+    uint8_t        mNetworkDataVersion;    ///< Network Data Version
+} otChildTableEntry;
+
 /**
  * This structure holds diagnostic information for a Thread Router
  *
@@ -668,6 +715,9 @@ typedef struct
     uint8_t        mLinkQualityIn;         ///< Link Quality In
     uint8_t        mLinkQualityOut;        ///< Link Quality Out
     uint8_t        mAge;                   ///< Time last heard
+    uint8_t        mFrameErrorRate;        ///< MAC frame error rate toward this router (255 = every attempt failed)
+    uint32_t       mTxAirtimeUs;           ///< Microseconds of transmit airtime toward this router
+    uint32_t       mRxAirtimeUs;           ///< Microseconds of receive airtime from this router
     bool           mAllocated : 1;         ///< Router ID allocated or not
     bool           mLinkEstablished : 1;   ///< Link established with Router ID or not
 } otRouterInfo;
@@ -720,14 +770,156 @@ typedef struct otMacCounters
     uint32_t mRxOther;                ///< The number of received other types of frames.
     uint32_t mRxWhitelistFiltered;    ///< The number of received packets filtered by whitelist.
     uint32_t mRxDestAddrFiltered;     ///< The number of received packets filtered by destination check.
+    uint32_t mRxDuplicated;           ///< The number of received duplicated packets.
     uint32_t mRxErrNoFrame;           ///< The number of received packets that do not contain contents.
     uint32_t mRxErrUnknownNeighbor;   ///< The number of received packets from unknown neighbor.
     uint32_t mRxErrInvalidSrcAddr;    ///< The number of received packets whose source address is invalid.
     uint32_t mRxErrSec;               ///< The number of received packets with security error.
     uint32_t mRxErrFcs;               ///< The number of received packets with FCS error.
     uint32_t mRxErrOther;             ///< The number of received packets with other error.
+    uint32_t mTxAirtimeUs;            ///< Microseconds of transmit airtime.
+    uint32_t mRxAirtimeUs;            ///< Microseconds of receive airtime.
+    uint32_t mCcaAirtimeUs;           ///< Microseconds spent in failed clear channel assessments.
 } otMacCounters;
 
+/**
+ * This structure represents the cross-layer performance counters.
+ */
+typedef struct otPerfCounters
+{
+    uint32_t mSendQueueAccepted;      ///< The number of messages accepted into the forwarder send queue.
+    uint32_t mSendQueueDropped;       ///< The number of messages dropped from the forwarder send queue.
+    uint32_t mResolvingQueueDropped;  ///< The number of messages dropped after a failed address resolution.
+    uint32_t mReassemblyTimeouts;     ///< The number of 6LoWPAN reassembly timeouts.
+    uint32_t mMessageAllocFailures;   ///< The number of failed message buffer allocations.
+    uint32_t mAddressQueries;         ///< The number of EID-to-RLOC address queries sent.
+    uint32_t mMleMessagesSent;        ///< The number of MLE messages sent.
+    uint32_t mMleMessagesReceived;    ///< The number of MLE messages received.
+    uint32_t mTimeToFirstParentRequest;  ///< Milliseconds from initialization to the first MLE Parent Request, 0 until one is sent.
+} otPerfCounters;
+
+#define OT_HANDLER_LATENCY_NUM_BUCKETS  8  ///< Number of buckets in the handler latency histogram.
+
+/**
+ * This structure represents a histogram of tasklet and timer handler run times.
+ *
+ * Bucket 0 counts handlers that completed within the timer resolution (0 ms elapsed). Bucket i (i > 0)
+ * counts handlers that ran for [2^(i-1), 2^i) milliseconds; the last bucket also counts all longer runs.
+ */
+typedef struct otHandlerLatencyHistogram
+{
+    uint32_t mBuckets[OT_HANDLER_LATENCY_NUM_BUCKETS];  ///< Handler run time bucket counts.
+} otHandlerLatencyHistogram;
+
+#define OT_HANDLER_PROFILE_NUM_ENTRIES  48  ///< Number of slots in the handler execution profile.
+
+/**
+ * This structure represents the execution profile of one tasklet or timer handler.
+ *
+ */
+typedef struct otHandlerProfileEntry
+{
+    const void *mHandler;    ///< The handler function address, or NULL for an unused slot.
+    uint32_t    mCount;      ///< The number of invocations.
+    uint32_t    mTotalTime;  ///< The total run time in milliseconds.
+    uint32_t    mMaxTime;    ///< The longest single run time in milliseconds.
+} otHandlerProfileEntry;
+
+/**
+ * This enumeration represents the load-shedding levels of the stack CPU budget governor.
+ *
+ * Levels are cumulative: each level also applies the shedding of the levels below it.
+ */
+typedef enum otCpuGovernorLevel
+{
+    kCpuGovernorLevelNone                 = 0,  ///< The stack is within budget; no load shedding.
+    kCpuGovernorLevelDeferDiagnostics     = 1,  ///< Diagnostic scan requests are deferred.
+    kCpuGovernorLevelDampenAdvertisements = 2,  ///< Every other MLE Advertisement is skipped.
+    kCpuGovernorLevelDropForwarding       = 3,  ///< Normal-priority forwarded datagrams are dropped.
+} otCpuGovernorLevel;
+
+/**
+ * This structure represents the state of the stack CPU budget governor.
+ *
+ */
+typedef struct otCpuGovernorState
+{
+    uint32_t mBudget;          ///< The budget in stack milliseconds per one-second window.
+    uint32_t mLastWindowTime;  ///< Stack handler run time in the last completed window (milliseconds).
+    uint32_t mShedWindows;     ///< The number of windows completed above budget.
+    uint8_t  mLevel;           ///< The current load-shedding level (see otCpuGovernorLevel).
+} otCpuGovernorState;
+
+/**
+ * Flight recorder event types.
+ *
+ */
+typedef enum otFlightRecorderEvent
+{
+    kFlightRecorderEventRoleChange        = 0,  ///< Device role changed (mArg8 = new role, mArg16 = RLOC16).
+    kFlightRecorderEventPoolExhausted     = 1,  ///< A buffer allocation failed (mArg8 = owner, mArg16 = free buffers).
+    kFlightRecorderEventQueueWatermark    = 2,  ///< The send queue crossed its watermark (mArg16 = queue depth).
+    kFlightRecorderEventPartitionChange   = 3,  ///< Thread partition changed (mArg16 = low 16 bits of partition id).
+    kFlightRecorderEventReassemblyTimeout = 4,  ///< A partial reassembly timed out (mArg16 = datagram tag).
+} otFlightRecorderEvent;
+
+/**
+ * This structure represents one entry of the flight recorder ring.
+ *
+ */
+typedef struct otFlightRecorderEntry
+{
+    uint32_t mTimestamp;  ///< Time of the event in milliseconds on the platform alarm clock.
+    uint8_t  mEvent;      ///< The event type (see otFlightRecorderEvent).
+    uint8_t  mArg8;       ///< Event-specific argument.
+    uint16_t mArg16;      ///< Event-specific argument.
+} otFlightRecorderEntry;
+
+/**
+ * This structure represents usage telemetry for the mbedTLS memory arena.
+ *
+ * The arena is split into a session region holding long-lived TLS state and a scratch region
+ * recycled between handshakes.
+ */
+typedef struct otMbedTlsMemoryInfo
+{
+    uint16_t mSessionUsed;         ///< Bytes currently allocated in the session region.
+    uint16_t mSessionHighWater;    ///< Peak bytes allocated in the session region.
+    uint16_t mSessionLargestFree;  ///< Largest contiguous free block in the session region.
+    uint16_t mScratchUsed;         ///< Bytes currently reserved in the per-handshake scratch region.
+    uint16_t mScratchHighWater;    ///< Peak bytes reserved in the scratch region.
+    uint16_t mAllocFailures;       ///< The number of allocation requests that could not be satisfied.
+} otMbedTlsMemoryInfo;
+
+/**
+ * This structure represents a command submitted to the stack thread through the API command queue.
+ *
+ * The caller owns the storage and MUST keep it valid until the completion callback runs (or the
+ * handler returns, when no completion callback is set).
+ */
+typedef struct otApiCommand
+{
+    /**
+     * This function pointer is called on the stack thread to execute the command.
+     *
+     * @param[in]  aInstance  A pointer to an OpenThread instance.
+     * @param[in]  aCommand   A pointer to the command being executed.
+     *
+     */
+    void (*mHandler)(otInstance *aInstance, struct otApiCommand *aCommand);
+
+    /**
+     * This function pointer is called on the stack thread after the handler returns, or NULL.
+     *
+     * @param[in]  aCommand   A pointer to the completed command.
+     *
+     */
+    void (*mCompletion)(struct otApiCommand *aCommand);
+
+    void                *mContext;  ///< A pointer to caller-specific context.
+    struct otApiCommand *mNext;     ///< Used internally to chain queued commands. MUST NOT be modified by the caller.
+} otApiCommand;
+
 /**
  * @}
  *
@@ -761,6 +953,60 @@ typedef struct otNetifAddress
  */
 typedef void *otMessage;
 
+/**
+ * This structure describes one segment of scattered payload, following readv()/writev() semantics.
+ */
+typedef struct otMessageIovec
+{
+    const void *mBase;    ///< A pointer to the segment bytes.
+    uint16_t    mLength;  ///< The segment length in bytes.
+} otMessageIovec;
+
+/**
+ * This enumeration identifies the subsystem that owns a message buffer.
+ */
+typedef enum otBufferOwner
+{
+    kBufferOwnerUnknown = 0,  ///< Not claimed by a subsystem.
+    kBufferOwnerMle     = 1,  ///< MLE messages.
+    kBufferOwnerIp6     = 2,  ///< IPv6 datagrams.
+    kBufferOwnerLowpan  = 3,  ///< 6LoWPAN reassembly.
+    kBufferOwnerCoap    = 4,  ///< CoAP messages.
+    kBufferOwnerNcp     = 5,  ///< NCP messages.
+    kNumBufferOwners    = 6,  ///< The number of buffer owners.
+} otBufferOwner;
+
+/**
+ * This structure represents message buffer usage per owning subsystem.
+ */
+typedef struct otBufferInfo
+{
+    uint16_t mTotalBuffers;                       ///< The number of buffers in the pool.
+    uint16_t mFreeBuffers;                        ///< The number of free buffers.
+    uint16_t mNumBuffers[kNumBufferOwners];       ///< The current number of buffers held per owner.
+    uint16_t mMaxNumBuffers[kNumBufferOwners];    ///< The high watermark of buffers held per owner.
+} otBufferInfo;
+
+/**
+ * This structure represents sampled statistics for one forwarded flow.
+ *
+ * Packet and byte counts only cover sampled datagrams; multiply by the sampling
+ * interval to estimate flow totals.
+ */
+typedef struct otFlowStats
+{
+    otIp6Address mSource;           ///< The flow source address.
+    otIp6Address mDestination;      ///< The flow destination address.
+    uint16_t mSourcePort;           ///< The flow source port, or 0 if not UDP or TCP.
+    uint16_t mDestinationPort;      ///< The flow destination port, or 0 if not UDP or TCP.
+    uint8_t mProtocol;              ///< The IPv6 Next Header value of the flow.
+    bool mValid;                    ///< TRUE if this entry tracks a flow.
+    uint32_t mSampledPackets;       ///< The number of sampled datagrams.
+    uint32_t mSampledBytes;         ///< The total length of sampled datagrams.
+    uint32_t mAverageDwellTime;     ///< Smoothed receive-to-transmit dwell of forwarded datagrams in milliseconds.
+    uint32_t mMaxDwellTime;         ///< Largest observed receive-to-transmit dwell in milliseconds.
+} otFlowStats;
+
 /**
  * @}
  *
@@ -137,6 +137,42 @@ bool otAreTaskletsPending(otInstance *aInstance);
  */
 extern void otSignalTaskletPending(otInstance *aInstance);
 
+/**
+ * Submit a command for execution on the stack thread.
+ *
+ * This function may be called from any thread. The command handler and completion callback run
+ * on the stack thread the next time the host calls otApiProcessCommands(). The caller retains
+ * ownership of @p aCommand and MUST keep it valid until the command has executed.
+ *
+ * @param[in] aInstance A pointer to an OpenThread instance.
+ * @param[in] aCommand  A pointer to the command to submit.
+ *
+ * @retval kThreadError_None         Successfully queued the command.
+ * @retval kThreadError_InvalidArgs  @p aCommand was NULL or had no handler.
+ */
+ThreadError otApiPostCommand(otInstance *aInstance, otApiCommand *aCommand);
+
+/**
+ * Run all queued API commands.
+ *
+ * This function MUST only be called from the stack thread, typically once per event loop
+ * iteration alongside otProcessNextTasklet().
+ *
+ * @param[in] aInstance A pointer to an OpenThread instance.
+ */
+void otApiProcessCommands(otInstance *aInstance);
+
+/**
+ * OpenThread calls this function when the API command queue transitions from empty to non-empty.
+ *
+ * Unlike the other functions in this module it may be called from any thread, so the
+ * implementation must be async-safe (e.g. write to a wakeup pipe).
+ *
+ * @param[in] aInstance A pointer to an OpenThread instance.
+ *
+ */
+extern void otSignalApiCommandPending(otInstance *aInstance);
+
 /**
  * @}
  *
@@ -341,6 +377,21 @@ ThreadError otEnergyScan(otInstance *aInstance, uint32_t aScanChannels, uint16_t
  */
 bool otIsEnergyScanInProgress(otInstance *aInstance);
 
+/**
+ * This function returns the tracked channel quality for an IEEE 802.15.4 channel.
+ *
+ * The value is an exponentially-weighted noise floor updated opportunistically from received
+ * frames, energy scan samples, and periodic idle measurements, so it can steer channel
+ * selection without requiring a blocking energy scan.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aChannel   The IEEE 802.15.4 channel of interest.
+ *
+ * @returns The tracked noise floor in dBm, or 127 if no measurement is available yet.
+ *
+ */
+int8_t otGetChannelQuality(otInstance *aInstance, uint8_t aChannel);
+
 /**
  * This function starts a Thread Discovery scan.
  *
@@ -1280,6 +1331,28 @@ void otRemoveMacWhitelist(otInstance *aInstance, const uint8_t *aExtAddr);
  */
 ThreadError otGetMacWhitelistEntry(otInstance *aInstance, uint8_t aIndex, otMacWhitelistEntry *aEntry);
 
+/**
+ * Replace the whole MAC whitelist table in one step.
+ *
+ * The entries are validated before any state is touched, so on failure the previous table remains
+ * in effect, and received frames are never filtered against a partially updated table. This lets
+ * test automation switch many entries, including their fixed RSSI values, in a single call.
+ *
+ * @param[in]  aInstance    A pointer to an OpenThread instance.
+ * @param[in]  aEntries     A pointer to an array of MAC whitelist entries.
+ * @param[in]  aNumEntries  The number of entries in @p aEntries.
+ *
+ * @retval kThreadError_None         Successfully replaced the MAC whitelist table.
+ * @retval kThreadError_InvalidArgs  @p aEntries was NULL.
+ * @retval kThreadError_NoBufs       @p aNumEntries exceeds OT_MAC_WHITELIST_MAX_ENTRIES.
+ *
+ * @sa otAddMacWhitelist
+ * @sa otAddMacWhitelistRssi
+ * @sa otGetMacWhitelistEntry
+ * @sa otClearMacWhitelist
+ */
+ThreadError otSetMacWhitelist(otInstance *aInstance, const otMacWhitelistEntry *aEntries, uint8_t aNumEntries);
+
 /**
  * Remove all entries from the MAC whitelist.
  *
@@ -1361,6 +1434,34 @@ ThreadError otBecomeDetached(otInstance *aInstance);
  */
 ThreadError otBecomeChild(otInstance *aInstance, otMleAttachFilter aFilter);
 
+/**
+ * Select the timing profile used during the attach process.
+ *
+ * The aggressive profile shortens the Parent Request timeouts for environments where responses
+ * arrive quickly, such as dense single-room deployments or wired-backhaul test networks. The
+ * selection takes effect on the next attach attempt.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ * @param[in]  aProfile  The attach timing profile.
+ *
+ * @retval kThreadError_None         Successfully set the attach timing profile.
+ * @retval kThreadError_InvalidArgs  @p aProfile is not a known profile.
+ *
+ * @sa otGetAttachProfile
+ */
+ThreadError otSetAttachProfile(otInstance *aInstance, otMleAttachProfile aProfile);
+
+/**
+ * Get the timing profile used during the attach process.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns The attach timing profile.
+ *
+ * @sa otSetAttachProfile
+ */
+otMleAttachProfile otGetAttachProfile(otInstance *aInstance);
+
 /**
  * Attempt to become a router.
  *
@@ -1516,20 +1617,23 @@ void otPlatformReset(otInstance *aInstance);
 /**
  * Get the ROUTER_DOWNGRADE_THRESHOLD parameter used in the Router role.
  *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
  * @returns The ROUTER_DOWNGRADE_THRESHOLD value.
  *
  * @sa otSetRouterDowngradeThreshold
  */
-uint8_t otGetRouterDowngradeThreshold(void);
+uint8_t otGetRouterDowngradeThreshold(otInstance *aInstance);
 
 /**
  * Set the ROUTER_DOWNGRADE_THRESHOLD parameter used in the Leader role.
  *
+ * @param[in]  aInstance   A pointer to an OpenThread instance.
  * @param[in]  aThreshold  The ROUTER_DOWNGRADE_THRESHOLD value.
  *
  * @sa otGetRouterDowngradeThreshold
  */
-void otSetRouterDowngradeThreshold(uint8_t aThreshold);
+void otSetRouterDowngradeThreshold(otInstance *aInstance, uint8_t aThreshold);
 
 /**
  * @}
@@ -1571,6 +1675,55 @@ ThreadError otGetChildInfoById(otInstance *aInstance, uint16_t aChildId, otChild
  */
 ThreadError otGetChildInfoByIndex(otInstance *aInstance, uint8_t aChildIndex, otChildInfo *aChildInfo);
 
+/**
+ * Get the generation counter for the child table.
+ *
+ * The counter is incremented whenever a child table entry is added, removed, or modified. A poller
+ * that cached the table along with this counter may skip re-reading the table while the counter is
+ * unchanged.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns The child table generation counter.
+ */
+uint32_t otGetChildTableGeneration(otInstance *aInstance);
+
+/**
+ * Export the attachment state of all attached children.
+ *
+ * An operator can feed the exported entries to otImportChildTable() on a standby router ahead of
+ * planned maintenance so that the standby, after taking over the same Router ID, accepts Child
+ * Update Requests from the children without a full reattach.
+ *
+ * @param[in]     aInstance  A pointer to an OpenThread instance.
+ * @param[out]    aEntries   A pointer to an array where child table entries are placed.
+ * @param[inout]  aCount     On entry, the capacity of @p aEntries. On exit, the number of entries placed.
+ *
+ * @retval kThreadError_None         Successfully exported the child table.
+ * @retval kThreadError_InvalidArgs  @p aEntries or @p aCount was NULL.
+ * @retval kThreadError_NoBufs       @p aEntries was too small for the attached children.
+ *
+ */
+ThreadError otExportChildTable(otInstance *aInstance, otChildTableEntry *aEntries, uint8_t *aCount);
+
+/**
+ * Import previously exported child attachment state.
+ *
+ * Entries are only meaningful on a router that takes over the Router ID embedded in their RLOC16s.
+ * Entries whose extended address is already present in the child table are skipped, so live
+ * attachment state is never overwritten.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aEntries   A pointer to an array of child table entries.
+ * @param[in]  aCount     The number of entries in @p aEntries.
+ *
+ * @retval kThreadError_None         Successfully imported the entries.
+ * @retval kThreadError_InvalidArgs  @p aEntries was NULL.
+ * @retval kThreadError_NoBufs       The child table filled up before all entries were imported.
+ *
+ */
+ThreadError otImportChildTable(otInstance *aInstance, const otChildTableEntry *aEntries, uint8_t aCount);
+
 /**
  * Get the device role.
  *
@@ -1595,7 +1748,7 @@ otDeviceRole otGetDeviceRole(otInstance *aInstance);
  * @retval kThreadError_InvalidArgs  @p aIndex was out of bounds or @p aEntry was NULL.
  *
  */
-ThreadError otGetEidCacheEntry(otInstance *aInstance, uint8_t aIndex, otEidCacheEntry *aEntry);
+ThreadError otGetEidCacheEntry(otInstance *aInstance, uint16_t aIndex, otEidCacheEntry *aEntry);
 
 /**
  * This function get the Thread Leader Data.
@@ -1674,6 +1827,19 @@ uint8_t otGetRouterIdSequence(otInstance *aInstance);
  */
 ThreadError otGetRouterInfo(otInstance *aInstance, uint16_t aRouterId, otRouterInfo *aRouterInfo);
 
+/**
+ * Get the generation counter for the router table.
+ *
+ * The counter is incremented whenever a router table entry is added, removed, or changes its link
+ * state, next hop, or route cost. A poller that cached the table along with this counter may skip
+ * re-reading the table while the counter is unchanged.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns The router table generation counter.
+ */
+uint32_t otGetRouterTableGeneration(otInstance *aInstance);
+
 /**
  * The function retains diagnostic information for a Thread Router as parent.
  *
@@ -1751,6 +1917,156 @@ ThreadError otSetLinkPromiscuous(otInstance *aInstance, bool aPromiscuous);
  */
 const otMacCounters *otGetMacCounters(otInstance *aInstance);
 
+/**
+ * Set the transmit airtime budget.
+ *
+ * A non-zero budget limits the transmit airtime consumed per one-second window; low-priority
+ * traffic is deferred while the current window's budget is exhausted. Useful for regulatory
+ * duty-cycle planning.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aBudget    The budget in microseconds per window (0 disables the budget).
+ *
+ */
+void otSetTxAirtimeBudget(otInstance *aInstance, uint32_t aBudget);
+
+/**
+ * Get the transmit airtime budget.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns The budget in microseconds per window (0 when disabled).
+ *
+ */
+uint32_t otGetTxAirtimeBudget(otInstance *aInstance);
+
+/**
+ * Enable or disable jam detection.
+ *
+ * While enabled, the MAC samples the channel during idle periods and applies a hysteresis
+ * filter; sustained energy above the configured threshold marks the channel as jammed.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aEnabled   TRUE to enable jam detection, FALSE otherwise.
+ *
+ */
+void otSetJamDetectionEnabled(otInstance *aInstance, bool aEnabled);
+
+/**
+ * Indicates whether or not jam detection is enabled.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns TRUE if jam detection is enabled, FALSE otherwise.
+ *
+ */
+bool otIsJamDetectionEnabled(otInstance *aInstance);
+
+/**
+ * Indicates whether or not the current channel is considered jammed.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns TRUE if sustained interference has been detected on the current channel, FALSE otherwise.
+ *
+ */
+bool otIsJammed(otInstance *aInstance);
+
+/**
+ * Enable or disable automatic channel migration when a jam is detected.
+ *
+ * On entering the jammed state, an energy scan is run across all channels and a pending
+ * dataset migration to the channel with the lowest tracked noise floor is requested
+ * (falling back to a local channel change when not attached).
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aEnabled   TRUE to enable channel agility, FALSE otherwise.
+ *
+ */
+void otSetChannelAgilityEnabled(otInstance *aInstance, bool aEnabled);
+
+/**
+ * Indicates whether or not channel agility is enabled.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns TRUE if channel agility is enabled, FALSE otherwise.
+ *
+ */
+bool otIsChannelAgilityEnabled(otInstance *aInstance);
+
+/**
+ * Get the cross-layer performance counters.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the performance counters.
+ */
+const otPerfCounters *otGetPerfCounters(otInstance *aInstance);
+
+/**
+ * Get the tasklet and timer handler latency histogram.
+ *
+ * The histogram is only populated when OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR is enabled;
+ * otherwise all buckets remain zero.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the handler latency histogram.
+ */
+const otHandlerLatencyHistogram *otGetHandlerLatencyHistogram(otInstance *aInstance);
+
+/**
+ * Get the flat execution profile of tasklet and timer handlers.
+ *
+ * The returned entries are sorted by descending total run time, so the first entry identifies the
+ * subsystem consuming the most handler time. The profile is only populated when
+ * OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR is enabled; otherwise @p aNumEntries is set to zero.
+ *
+ * @param[in]   aInstance    A pointer to an OpenThread instance.
+ * @param[out]  aNumEntries  A pointer to where the number of populated entries is placed.
+ *
+ * @returns A pointer to the first entry of the handler execution profile.
+ */
+const otHandlerProfileEntry *otGetHandlerProfile(otInstance *aInstance, uint8_t *aNumEntries);
+
+/**
+ * Get the state of the stack CPU budget governor.
+ *
+ * The governor accounts tasklet and timer handler run time against a per-second budget and sheds
+ * load in a defined order when the budget is exceeded (see otCpuGovernorLevel). The state is only
+ * maintained when OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR is enabled; otherwise all fields are zero.
+ *
+ * @param[in]   aInstance  A pointer to an OpenThread instance.
+ * @param[out]  aState     A pointer to where the governor state is placed.
+ */
+void otGetCpuGovernorState(otInstance *aInstance, otCpuGovernorState *aState);
+
+/**
+ * Copy the recorded flight recorder events, oldest first.
+ *
+ * The flight recorder is an always-on fixed-size ring of coarse timestamped events (role changes,
+ * buffer pool exhaustion, send queue watermark crossings, partition changes, reassembly timeouts)
+ * intended for post-incident forensics. Platforms can preserve the ring across a warm reset by
+ * defining OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE to place it in uninitialized RAM.
+ *
+ * @param[in]   aInstance    A pointer to an OpenThread instance.
+ * @param[out]  aEntries     A pointer to the output array.
+ * @param[in]   aMaxEntries  The capacity of @p aEntries.
+ *
+ * @returns The number of entries written to @p aEntries.
+ */
+uint16_t otGetFlightRecorder(otInstance *aInstance, otFlightRecorderEntry *aEntries, uint16_t aMaxEntries);
+
+/**
+ * Get usage telemetry for the mbedTLS memory arena.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the arena usage telemetry.
+ */
+const otMbedTlsMemoryInfo *otGetMbedTlsMemoryInfo(otInstance *aInstance);
+
 /**
  * @}
  *
@@ -1806,6 +2122,103 @@ ThreadError otIp6AddressFromString(const char *aString, otIp6Address *aAddress);
  */
 ThreadError otFreeMessage(otMessage aMessage);
 
+/**
+ * Get the message buffer information.
+ *
+ * @param[in]   aInstance    A pointer to an OpenThread instance.
+ * @param[out]  aBufferInfo  A pointer where the message buffer information is written.
+ *
+ */
+void otGetBufferInfo(otInstance *aInstance, otBufferInfo *aBufferInfo);
+
+/**
+ * This function pointer is called when the free message buffer count crosses the congestion watermark.
+ *
+ * @param[in]  aCongested  TRUE when free buffers dropped below the congestion watermark, FALSE on recovery.
+ * @param[in]  aContext    A pointer to application-specific context.
+ *
+ */
+typedef void (*otBufferCongestionCallback)(bool aCongested, void *aContext);
+
+/**
+ * This function registers a callback to indicate when the message buffer pool enters or leaves congestion.
+ *
+ * The callback fires before allocations start failing, giving the application a chance to pace its
+ * transmissions rather than discover the pressure through dropped messages.
+ *
+ * @param[in]  aInstance         A pointer to an OpenThread instance.
+ * @param[in]  aCallback         A pointer to a function that is called on congestion state changes.
+ * @param[in]  aCallbackContext  A pointer to application-specific context.
+ *
+ */
+void otSetBufferCongestionCallback(otInstance *aInstance, otBufferCongestionCallback aCallback,
+                                   void *aCallbackContext);
+
+/**
+ * This function indicates whether the message buffer pool is currently congested.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns TRUE if free message buffers are below the congestion watermark, FALSE otherwise.
+ *
+ */
+bool otIsBufferCongested(otInstance *aInstance);
+
+/**
+ * This function rebalances the send/receive message buffer partition.
+ *
+ * Buffers held by locally generated (send) messages are capped at @p aSendQuota and buffers held
+ * by received messages at @p aReceiveQuota, so a burst in one direction cannot consume the whole
+ * pool. The quotas may overlap. A small emergency receive reserve is always excluded from the
+ * send side so that acknowledgments and responses can be received while a transmit burst drains.
+ * Routers typically grant the receive side a larger share than sleepy end devices.
+ *
+ * @param[in]  aInstance      A pointer to an OpenThread instance.
+ * @param[in]  aSendQuota     The maximum number of buffers send messages may hold.
+ * @param[in]  aReceiveQuota  The maximum number of buffers received messages may hold.
+ *
+ * @retval kThreadError_None         Successfully updated the partition.
+ * @retval kThreadError_InvalidArgs  A quota was zero, exceeded the pool size, or overlapped the
+ *                                   emergency receive reserve.
+ *
+ */
+ThreadError otSetBufferPartition(otInstance *aInstance, uint16_t aSendQuota, uint16_t aReceiveQuota);
+
+/**
+ * This function enables or disables flow sampling in the mesh forwarder.
+ *
+ * While enabled, one in every N forwarded datagrams is attributed to a small flow table with
+ * per-flow packet and byte counters.  Enabling flow sampling clears the flow table.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ * @param[in]  aEnabled   TRUE to enable flow sampling, FALSE otherwise.
+ *
+ */
+void otSetFlowSamplingEnabled(otInstance *aInstance, bool aEnabled);
+
+/**
+ * This function indicates whether or not flow sampling is enabled.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns TRUE if flow sampling is enabled, FALSE otherwise.
+ *
+ */
+bool otIsFlowSamplingEnabled(otInstance *aInstance);
+
+/**
+ * This function retrieves one entry of the sampled flow table.
+ *
+ * @param[in]   aInstance  A pointer to an OpenThread instance.
+ * @param[in]   aIndex     The index into the flow table.
+ * @param[out]  aStats     A pointer to where the flow statistics are placed.
+ *
+ * @retval kThreadError_None      Successfully retrieved the flow table entry.
+ * @retval kThreadError_NotFound  @p aIndex is beyond the end of the flow table.
+ *
+ */
+ThreadError otGetFlowStats(otInstance *aInstance, uint8_t aIndex, otFlowStats *aStats);
+
 /**
  * Get the message length in bytes.
  *
@@ -1973,6 +2386,25 @@ int otWriteMessage(otMessage aMessage, uint16_t aOffset, const void *aBuf, uint1
  */
 otMessage otNewIp6Message(otInstance *aInstance, bool aLinkSecurityEnabled);
 
+/**
+ * Allocate a new message buffer for an externally supplied IPv6 datagram and fill it from
+ * a set of scattered segments in a single pass.
+ *
+ * The allocation reserves the same headroom as internally generated IPv6 messages, so lower
+ * layers can prepend headers (e.g. for MPL option insertion) without copying the datagram.
+ *
+ * @param[in]  aInstance             A pointer to an OpenThread instance.
+ * @param[in]  aLinkSecurityEnabled  TRUE if the message should be secured at Layer 2
+ * @param[in]  aIovec                A pointer to an array of payload segment descriptors.
+ * @param[in]  aCount                The number of segments in @p aIovec.
+ *
+ * @returns A pointer to the filled message buffer or NULL if no message buffers are available.
+ *
+ * @sa otFreeMessage
+ */
+otMessage otNewIp6MessageIovec(otInstance *aInstance, bool aLinkSecurityEnabled,
+                               const otMessageIovec *aIovec, uint8_t aCount);
+
 /**
  * This function pointer is called when an IPv6 datagram is received.
  *
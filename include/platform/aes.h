@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file includes the platform abstraction for AES hardware acceleration.
+ */
+
+#ifndef AES_H_
+#define AES_H_
+
+#include <stdint.h>
+
+#include <openthread-types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup aes AES
+ * @ingroup platform
+ *
+ * @brief
+ *   This module includes the platform abstraction for AES hardware acceleration. Platforms without
+ *   an AES engine return kThreadError_NotImplemented and the core falls back to software AES.
+ *
+ * @{
+ *
+ */
+
+/**
+ * Load an encryption key into the platform AES engine.
+ *
+ * @param[in]  aKey        A pointer to the key.
+ * @param[in]  aKeyLength  The key length in bytes.
+ *
+ * @retval kThreadError_None            Successfully loaded the key.
+ * @retval kThreadError_InvalidArgs     The engine does not support @p aKeyLength.
+ * @retval kThreadError_NotImplemented  The platform does not provide an AES engine.
+ *
+ */
+ThreadError otPlatAesEcbSetKey(const uint8_t *aKey, uint16_t aKeyLength);
+
+/**
+ * Encrypt one 16-byte block using the key loaded by otPlatAesEcbSetKey().
+ *
+ * @param[in]   aInput   A pointer to the 16-byte input block.
+ * @param[out]  aOutput  A pointer to the 16-byte output block.
+ *
+ * @retval kThreadError_None            Successfully encrypted the block.
+ * @retval kThreadError_NotImplemented  The platform does not provide an AES engine.
+ *
+ */
+ThreadError otPlatAesEcbEncrypt(const uint8_t *aInput, uint8_t *aOutput);
+
+/**
+ * @}
+ *
+ */
+
+#ifdef __cplusplus
+}  // end of extern "C"
+#endif
+
+#endif  // AES_H_
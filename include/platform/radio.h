@@ -78,6 +78,8 @@ enum
     kPhyUsPerSymbol     = ((kPhyBitsPerOctet / kPhySymbolsPerOctet) * 1000000) / kPhyBitRate,
 
     kPhyNoLqi           = 0,       ///< LQI measurement not supported
+
+    kPhyRxRingSize      = 4,       ///< Number of received frames a radio driver should buffer between process passes
 };
 
 /**
@@ -93,6 +95,12 @@ typedef enum otRadioCaps
 
 /**
  * This structure represents an IEEE 802.15.4 radio frame.
+ *
+ * For received frames, @p mPsdu points at driver-owned storage that is loaned to OpenThread for
+ * the duration of the otPlatRadioReceiveDone() callback.  OpenThread parses, decrypts, and
+ * decompresses the frame in place within that storage, so the driver must not modify or reuse
+ * the buffer until the callback returns.
+ *
  */
 typedef struct RadioPacket
 {
@@ -102,6 +110,14 @@ typedef struct RadioPacket
     int8_t  mPower;          ///< Transmit/receive power in dBm.
     uint8_t mLqi;            ///< Link Quality Indicator for received frames.
     bool    mSecurityValid;  ///< Security Enabled flag is set and frame passes security checks.
+
+    /**
+     * The time at which the start-of-frame delimiter of a received frame was detected, in
+     * milliseconds on the otPlatAlarmGetNow() clock.  Drivers without SFD capture hardware
+     * may approximate with the time of receive completion.
+     *
+     */
+    uint32_t mTimestamp;
 } RadioPacket;
 
 /**
@@ -255,6 +271,14 @@ ThreadError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel);
 /**
  * The radio driver calls this method to notify OpenThread of a received packet.
  *
+ * A driver that buffers multiple received packets (up to ::kPhyRxRingSize) may drain them in a
+ * batch by invoking this method once per packet from a single process pass.
+ *
+ * The buffer referenced by @p aPacket is loaned to OpenThread for the duration of this call:
+ * the entire receive path, up to and including 6LoWPAN decompression, reads from (and decrypts
+ * within) the driver's buffer directly and performs a single copy into a message buffer when
+ * the payload is appended.  The driver regains ownership, and may reuse the buffer, as soon as
+ * this method returns.
  *
  * @param[in]  aInstance The OpenThread instance structure.
  * @param[in]  aPacket   A pointer to the received packet or NULL if the receive operation was aborted.
@@ -264,6 +288,35 @@ ThreadError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel);
  */
 extern void otPlatRadioReceiveDone(otInstance *aInstance, RadioPacket *aPacket, ThreadError aError);
 
+/**
+ * This structure represents one receive completion within a batched notification.
+ *
+ */
+typedef struct RadioFrameEvent
+{
+    RadioPacket *mPacket;  ///< A pointer to the received packet or NULL if the receive operation was aborted.
+    ThreadError  mError;   ///< ::kThreadError_None when successfully received a frame.
+} RadioFrameEvent;
+
+/**
+ * The radio driver calls this method to notify OpenThread of a batch of received packets.
+ *
+ * A driver that buffers multiple received packets (up to ::kPhyRxRingSize) should prefer this
+ * method over per-packet otPlatRadioReceiveDone() calls: the whole batch crosses the platform
+ * boundary once and is consumed in a single process pass, amortizing the fixed per-notification
+ * cost that dominates small-frame workloads.
+ *
+ * The buffer loan rules of otPlatRadioReceiveDone() apply to every packet in @p aEvents: the
+ * driver regains ownership of all referenced buffers as soon as this method returns.  Events are
+ * processed in array order.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[in]  aEvents    A pointer to an array of receive completions.
+ * @param[in]  aNumEvents The number of entries in @p aEvents.
+ *
+ */
+extern void otPlatRadioReceiveDoneBatch(otInstance *aInstance, RadioFrameEvent *aEvents, uint8_t aNumEvents);
+
 /**
  * The radio transitions from Transmit to Receive.
  * This method returns a pointer to the transmit buffer.
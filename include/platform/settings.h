@@ -37,6 +37,8 @@
 
 #include <stdint.h>
 
+#include <openthread-types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
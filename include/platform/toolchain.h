@@ -85,6 +85,24 @@ extern "C" {
  *
  */
 
+/**
+ * @def OT_TOOL_HOT_CODE
+ *
+ * Compiler-specific indication that a function is on the per-packet fast
+ * path.  The function is grouped into the `.ot_text_hot` input section so
+ * that a platform linker script can place it in zero wait-state memory.
+ *
+ */
+
+/**
+ * @def OT_TOOL_COLD_CODE
+ *
+ * Compiler-specific indication that a function is rarely executed.  The
+ * function is grouped into the `.ot_text_cold` input section and, where the
+ * compiler supports it, optimized for size rather than speed.
+ *
+ */
+
 // =========== TOOLCHAIN SELECTION : START ===========
 
 #if defined(__GNUC__) || defined(__clang__) || defined(__CC_ARM)
@@ -96,6 +114,15 @@ extern "C" {
 #define OT_TOOL_PACKED_FIELD                __attribute__((packed))
 #define OT_TOOL_PACKED_END                  __attribute__((packed))
 
+#if defined(__CC_ARM)
+// armcc does not support the hot/cold optimization attributes
+#define OT_TOOL_HOT_CODE                    __attribute__((section(".ot_text_hot")))
+#define OT_TOOL_COLD_CODE                   __attribute__((section(".ot_text_cold")))
+#else
+#define OT_TOOL_HOT_CODE                    __attribute__((hot, section(".ot_text_hot")))
+#define OT_TOOL_COLD_CODE                   __attribute__((cold, section(".ot_text_cold")))
+#endif
+
 #elif defined(__ICCARM__) || defined(__ICC8051__)
 
 // http://supp.iar.com/FilesPublic/UPDINFO/004916/arm/doc/EWARM_DevelopmentGuide.ENU.pdf
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * @brief
+ *   This file includes the platform abstraction for offloading work to a background thread.
+ */
+
+#ifndef WORKER_H_
+#define WORKER_H_
+
+#include <stdbool.h>
+
+#include <openthread-types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup worker Worker
+ * @ingroup platform
+ *
+ * @brief
+ *   This module includes the platform abstraction for offloading long-running computations,
+ *   such as DTLS handshake steps, to a background thread. Platforms without threading support
+ *   simply decline jobs and OpenThread runs the computation inline.
+ *
+ * @{
+ *
+ */
+
+typedef struct otPlatWorkerJob otPlatWorkerJob;
+
+/**
+ * This structure represents a job submitted to the platform worker.
+ *
+ * The caller owns the storage and MUST keep it valid until the done callback has run.
+ */
+struct otPlatWorkerJob
+{
+    /**
+     * This function pointer is called on a worker thread to perform the job.
+     *
+     * @param[in]  aJob  A pointer to the job being executed.
+     *
+     */
+    void (*mWork)(otPlatWorkerJob *aJob);
+
+    /**
+     * This function pointer is called on the OpenThread thread after the work function returns.
+     *
+     * @param[in]  aJob  A pointer to the completed job.
+     *
+     */
+    void (*mDone)(otPlatWorkerJob *aJob);
+
+    void            *mContext;  ///< A pointer to job-specific context.
+    otPlatWorkerJob *mNext;     ///< Used internally by the platform. MUST NOT be modified by the caller.
+};
+
+/**
+ * Submit a job to the platform worker.
+ *
+ * On success the platform runs the job's work function on a background thread and later invokes
+ * the job's done callback on the OpenThread thread. The platform MUST NOT run jobs concurrently
+ * with each other.
+ *
+ * @param[in]  aJob  A pointer to the job to submit.
+ *
+ * @retval TRUE   The job was accepted and will run on a worker thread.
+ * @retval FALSE  The platform has no worker support; the caller must run the job inline.
+ */
+bool otPlatWorkerPost(otPlatWorkerJob *aJob);
+
+/**
+ * @}
+ *
+ */
+
+#ifdef __cplusplus
+}  // end of extern "C"
+#endif
+
+#endif  // WORKER_H_
@@ -68,6 +68,7 @@ const struct Command Interpreter::sCommands[] =
 {
     { "help", &Interpreter::ProcessHelp },
     { "blacklist", &Interpreter::ProcessBlacklist },
+    { "bufferinfo", &Interpreter::ProcessBufferInfo },
     { "channel", &Interpreter::ProcessChannel },
     { "child", &Interpreter::ProcessChild },
     { "childmax", &Interpreter::ProcessChildMax },
@@ -89,6 +90,7 @@ const struct Command Interpreter::sCommands[] =
 #endif
     { "extaddr", &Interpreter::ProcessExtAddress },
     { "extpanid", &Interpreter::ProcessExtPanId },
+    { "flows", &Interpreter::ProcessFlows },
     { "hashmacaddr", &Interpreter::ProcessHashMacAddress },
     { "ifconfig", &Interpreter::ProcessIfconfig },
     { "ipaddr", &Interpreter::ProcessIpAddr },
@@ -122,6 +124,7 @@ const struct Command Interpreter::sCommands[] =
     { "scan", &Interpreter::ProcessScan },
     { "singleton", &Interpreter::ProcessSingleton },
     { "state", &Interpreter::ProcessState },
+    { "telemetry", &Interpreter::ProcessTelemetry },
     { "thread", &Interpreter::ProcessThread },
     { "version", &Interpreter::ProcessVersion },
     { "whitelist", &Interpreter::ProcessWhitelist },
@@ -208,6 +211,21 @@ void Interpreter::OutputBytes(const uint8_t *aBytes, uint8_t aLength)
     }
 }
 
+void Interpreter::OutputTlv(uint8_t aType, const void *aValue, uint16_t aLength)
+{
+    uint8_t header[2];
+
+    header[0] = aType;
+    header[1] = static_cast<uint8_t>(aLength);
+
+    sServer->Output(reinterpret_cast<const char *>(header), sizeof(header));
+
+    if (aLength > 0)
+    {
+        sServer->Output(reinterpret_cast<const char *>(aValue), aLength);
+    }
+}
+
 ThreadError Interpreter::ParseLong(char *argv, long &value)
 {
     char *endptr;
@@ -299,6 +317,28 @@ exit:
     AppendResult(error);
 }
 
+void Interpreter::ProcessBufferInfo(int argc, char *argv[])
+{
+    otBufferInfo bufferInfo;
+
+    otGetBufferInfo(mInstance, &bufferInfo);
+
+    sServer->OutputFormat("total: %d\r\n", bufferInfo.mTotalBuffers);
+    sServer->OutputFormat("free: %d\r\n", bufferInfo.mFreeBuffers);
+    sServer->OutputFormat("mle: %d %d\r\n", bufferInfo.mNumBuffers[kBufferOwnerMle],
+                          bufferInfo.mMaxNumBuffers[kBufferOwnerMle]);
+    sServer->OutputFormat("ip6: %d %d\r\n", bufferInfo.mNumBuffers[kBufferOwnerIp6],
+                          bufferInfo.mMaxNumBuffers[kBufferOwnerIp6]);
+    sServer->OutputFormat("6lo: %d %d\r\n", bufferInfo.mNumBuffers[kBufferOwnerLowpan],
+                          bufferInfo.mMaxNumBuffers[kBufferOwnerLowpan]);
+    sServer->OutputFormat("coap: %d %d\r\n", bufferInfo.mNumBuffers[kBufferOwnerCoap],
+                          bufferInfo.mMaxNumBuffers[kBufferOwnerCoap]);
+
+    (void)argc;
+    (void)argv;
+    AppendResult(kThreadError_None);
+}
+
 void Interpreter::ProcessChannel(int argc, char *argv[])
 {
     ThreadError error = kThreadError_None;
@@ -385,6 +425,7 @@ void Interpreter::ProcessChild(int argc, char *argv[])
     sServer->OutputFormat("Age: %d\r\n", childInfo.mAge);
     sServer->OutputFormat("LQI: %d\r\n", childInfo.mLinkQualityIn);
     sServer->OutputFormat("RSSI: %d\r\n", childInfo.mAverageRssi);
+    sServer->OutputFormat("PER: %d\r\n", childInfo.mFrameErrorRate);
 
 exit:
     AppendResult(error);
@@ -478,12 +519,16 @@ void Interpreter::ProcessCounters(int argc, char *argv[])
             sServer->OutputFormat("    RxOther: %d\r\n", counters->mRxOther);
             sServer->OutputFormat("    RxWhitelistFiltered: %d\r\n", counters->mRxWhitelistFiltered);
             sServer->OutputFormat("    RxDestAddrFiltered: %d\r\n", counters->mRxDestAddrFiltered);
+            sServer->OutputFormat("    RxDuplicated: %d\r\n", counters->mRxDuplicated);
             sServer->OutputFormat("    RxErrNoFrame: %d\r\n", counters->mRxErrNoFrame);
             sServer->OutputFormat("    RxErrNoUnknownNeighbor: %d\r\n", counters->mRxErrUnknownNeighbor);
             sServer->OutputFormat("    RxErrInvalidSrcAddr: %d\r\n", counters->mRxErrInvalidSrcAddr);
             sServer->OutputFormat("    RxErrSec: %d\r\n", counters->mRxErrSec);
             sServer->OutputFormat("    RxErrFcs: %d\r\n", counters->mRxErrFcs);
             sServer->OutputFormat("    RxErrOther: %d\r\n", counters->mRxErrOther);
+            sServer->OutputFormat("TxAirtimeUs: %u\r\n", counters->mTxAirtimeUs);
+            sServer->OutputFormat("RxAirtimeUs: %u\r\n", counters->mRxAirtimeUs);
+            sServer->OutputFormat("CcaAirtimeUs: %u\r\n", counters->mCcaAirtimeUs);
         }
     }
 }
@@ -522,7 +567,7 @@ void Interpreter::ProcessEidCache(int argc, char *argv[])
 {
     otEidCacheEntry entry;
 
-    for (uint8_t i = 0; ; i++)
+    for (uint16_t i = 0; ; i++)
     {
         SuccessOrExit(otGetEidCacheEntry(mInstance, i, &entry));
 
@@ -549,6 +594,66 @@ exit:
     AppendResult(kThreadError_None);
 }
 
+void Interpreter::ProcessFlows(int argc, char *argv[])
+{
+    ThreadError error = kThreadError_None;
+    otFlowStats stats;
+
+    if (argc == 0)
+    {
+        for (uint8_t i = 0; ; i++)
+        {
+            if (otGetFlowStats(mInstance, i, &stats) != kThreadError_None)
+            {
+                break;
+            }
+
+            if (stats.mValid == false)
+            {
+                continue;
+            }
+
+            sServer->OutputFormat("%x:%x:%x:%x:%x:%x:%x:%x %d %x:%x:%x:%x:%x:%x:%x:%x %d proto %d pkts %u bytes %u\r\n",
+                                  HostSwap16(stats.mSource.mFields.m16[0]),
+                                  HostSwap16(stats.mSource.mFields.m16[1]),
+                                  HostSwap16(stats.mSource.mFields.m16[2]),
+                                  HostSwap16(stats.mSource.mFields.m16[3]),
+                                  HostSwap16(stats.mSource.mFields.m16[4]),
+                                  HostSwap16(stats.mSource.mFields.m16[5]),
+                                  HostSwap16(stats.mSource.mFields.m16[6]),
+                                  HostSwap16(stats.mSource.mFields.m16[7]),
+                                  stats.mSourcePort,
+                                  HostSwap16(stats.mDestination.mFields.m16[0]),
+                                  HostSwap16(stats.mDestination.mFields.m16[1]),
+                                  HostSwap16(stats.mDestination.mFields.m16[2]),
+                                  HostSwap16(stats.mDestination.mFields.m16[3]),
+                                  HostSwap16(stats.mDestination.mFields.m16[4]),
+                                  HostSwap16(stats.mDestination.mFields.m16[5]),
+                                  HostSwap16(stats.mDestination.mFields.m16[6]),
+                                  HostSwap16(stats.mDestination.mFields.m16[7]),
+                                  stats.mDestinationPort,
+                                  stats.mProtocol,
+                                  stats.mSampledPackets,
+                                  stats.mSampledBytes);
+        }
+    }
+    else if (strcmp(argv[0], "enable") == 0)
+    {
+        otSetFlowSamplingEnabled(mInstance, true);
+    }
+    else if (strcmp(argv[0], "disable") == 0)
+    {
+        otSetFlowSamplingEnabled(mInstance, false);
+    }
+    else
+    {
+        ExitNow(error = kThreadError_Parse);
+    }
+
+exit:
+    AppendResult(error);
+}
+
 void Interpreter::ProcessEui64(int argc, char *argv[])
 {
     ThreadError error = kThreadError_None;
@@ -1681,12 +1786,12 @@ void Interpreter::ProcessRouterDowngradeThreshold(int argc, char *argv[])
 
     if (argc == 0)
     {
-        sServer->OutputFormat("%d\r\n", otGetRouterDowngradeThreshold());
+        sServer->OutputFormat("%d\r\n", otGetRouterDowngradeThreshold(mInstance));
     }
     else
     {
         SuccessOrExit(error = ParseLong(argv[0], value));
-        otSetRouterDowngradeThreshold(static_cast<uint8_t>(value));
+        otSetRouterDowngradeThreshold(mInstance, static_cast<uint8_t>(value));
     }
 
 exit:
@@ -1873,6 +1978,42 @@ exit:
     AppendResult(error);
 }
 
+void Interpreter::ProcessTelemetry(int argc, char *argv[])
+{
+    otBufferInfo bufferInfo;
+    otChildInfo childInfo;
+    otRouterInfo routerInfo;
+
+    OutputTlv(kTelemetryTlvMacCounters, otGetMacCounters(mInstance), sizeof(otMacCounters));
+
+    otGetBufferInfo(mInstance, &bufferInfo);
+    OutputTlv(kTelemetryTlvBufferInfo, &bufferInfo, sizeof(bufferInfo));
+
+    for (uint8_t i = 0; otGetChildInfoByIndex(mInstance, i, &childInfo) == kThreadError_None; i++)
+    {
+        if (childInfo.mTimeout > 0)
+        {
+            OutputTlv(kTelemetryTlvChild, &childInfo, sizeof(childInfo));
+        }
+    }
+
+    for (uint8_t i = 0; otGetRouterInfo(mInstance, i, &routerInfo) == kThreadError_None; i++)
+    {
+        if (routerInfo.mAllocated)
+        {
+            OutputTlv(kTelemetryTlvRouter, &routerInfo, sizeof(routerInfo));
+        }
+    }
+
+    OutputTlv(kTelemetryTlvEnd, NULL, 0);
+
+    sServer->OutputFormat("\r\n");
+
+    (void)argc;
+    (void)argv;
+    AppendResult(kThreadError_None);
+}
+
 void Interpreter::ProcessThread(int argc, char *argv[])
 {
     ThreadError error = kThreadError_Parse;
@@ -2119,12 +2260,15 @@ exit:
 #if OPENTHREAD_ENABLE_DIAG
 void Interpreter::ProcessDiag(int argc, char *argv[])
 {
+    // the diagnostics module initializes lazily on first use
+    diagInit(mInstance);
+
     // all diagnostics related features are processed within diagnostics module
     sServer->OutputFormat("%s\r\n", diagProcessCmd(argc, argv));
 }
 #endif
 
-void Interpreter::ProcessLine(char *aBuf, uint16_t aBufLength, Server &aServer)
+OT_TOOL_COLD_CODE void Interpreter::ProcessLine(char *aBuf, uint16_t aBufLength, Server &aServer)
 {
     char *argv[kMaxArgs];
     int argc = 0;
@@ -133,11 +133,27 @@ private:
         kMaxArgs = 32,
     };
 
+    /**
+     * Telemetry TLV types emitted by the `telemetry` command. Each TLV is a one byte type, a one byte value
+     * length, and the value as the corresponding packed C structure from openthread-types.h.
+     *
+     */
+    enum
+    {
+        kTelemetryTlvEnd         = 0,  ///< Marks the end of a telemetry dump (zero length).
+        kTelemetryTlvMacCounters = 1,  ///< An otMacCounters structure.
+        kTelemetryTlvBufferInfo  = 2,  ///< An otBufferInfo structure.
+        kTelemetryTlvChild       = 3,  ///< An otChildInfo structure, one per attached child.
+        kTelemetryTlvRouter      = 4,  ///< An otRouterInfo structure, one per allocated router id.
+    };
+
     void AppendResult(ThreadError error);
     void OutputBytes(const uint8_t *aBytes, uint8_t aLength);
+    void OutputTlv(uint8_t aType, const void *aValue, uint16_t aLength);
 
     void ProcessHelp(int argc, char *argv[]);
     void ProcessBlacklist(int argc, char *argv[]);
+    void ProcessBufferInfo(int argc, char *argv[]);
     void ProcessChannel(int argc, char *argv[]);
     void ProcessChild(int argc, char *argv[]);
     void ProcessChildTimeout(int argc, char *argv[]);
@@ -159,6 +175,7 @@ private:
 #endif
     void ProcessExtAddress(int argc, char *argv[]);
     void ProcessExtPanId(int argc, char *argv[]);
+    void ProcessFlows(int argc, char *argv[]);
     void ProcessHashMacAddress(int argc, char *argv[]);
     void ProcessIfconfig(int argc, char *argv[]);
     void ProcessIpAddr(int argc, char *argv[]);
@@ -199,6 +216,7 @@ private:
     void ProcessScan(int argc, char *argv[]);
     void ProcessSingleton(int argc, char *argv[]);
     void ProcessState(int argc, char *argv[]);
+    void ProcessTelemetry(int argc, char *argv[]);
     void ProcessThread(int argc, char *argv[]);
     void ProcessVersion(int argc, char *argv[]);
     void ProcessWhitelist(int argc, char *argv[]);
@@ -148,19 +148,26 @@ int Uart::Output(const char *aBuf, uint16_t aBufLength)
 {
     uint16_t remaining = kTxBufferSize - mTxLength;
     uint16_t tail;
+    uint16_t firstSegment;
 
     if (aBufLength > remaining)
     {
         aBufLength = remaining;
     }
 
-    for (int i = 0; i < aBufLength; i++)
+    // Copy in at most two segments, splitting where the ring wraps.
+    tail = (mTxHead + mTxLength) % kTxBufferSize;
+    firstSegment = kTxBufferSize - tail;
+
+    if (firstSegment > aBufLength)
     {
-        tail = (mTxHead + mTxLength) % kTxBufferSize;
-        mTxBuffer[tail] = *aBuf++;
-        mTxLength++;
+        firstSegment = aBufLength;
     }
 
+    memcpy(mTxBuffer + tail, aBuf, firstSegment);
+    memcpy(mTxBuffer, aBuf + firstSegment, aBufLength - firstSegment);
+    mTxLength += aBufLength;
+
     Send();
 
     return aBufLength;
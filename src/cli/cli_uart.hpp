@@ -87,7 +87,7 @@ private:
     enum
     {
         kRxBufferSize = 128,
-        kTxBufferSize = 1024,
+        kTxBufferSize = 2048,  // Large enough to queue a full `router table` dump while the uart drains.
         kMaxLineLength = 128,
     };
 
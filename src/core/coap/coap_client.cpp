@@ -0,0 +1,281 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the CoAP client request/response matching and retransmission.
+ */
+
+#include <coap/coap_client.hpp>
+#include <common/code_utils.hpp>
+#include <net/ip6.hpp>
+
+namespace Thread {
+namespace Coap {
+
+Client::Client(Ip6::Ip6 &aIp6):
+    mSocket(aIp6.mUdp),
+    mRetransmissionTimer(aIp6.mTimerScheduler, &HandleRetransmissionTimer, this)
+{
+    memset(mTransactions, 0, sizeof(mTransactions));
+}
+
+ThreadError Client::Start(void)
+{
+    return mSocket.Open(&HandleUdpReceive, this);
+}
+
+ThreadError Client::Stop(void)
+{
+    mRetransmissionTimer.Stop();
+
+    for (int i = 0; i < kMaxTransactions; i++)
+    {
+        if (mTransactions[i].mInUse)
+        {
+            Finalize(mTransactions[i], NULL, NULL, NULL, kThreadError_Abort);
+        }
+    }
+
+    return mSocket.Close();
+}
+
+Message *Client::NewMessage(uint16_t aReserved)
+{
+    Message *message = mSocket.NewMessage(aReserved);
+
+    if (message != NULL)
+    {
+        message->SetOwner(Message::kOwnerCoap);
+    }
+
+    return message;
+}
+
+ThreadError Client::SendMessage(Message &aMessage, const Header &aHeader, const Ip6::MessageInfo &aMessageInfo,
+                                ResponseHandler aHandler, void *aContext)
+{
+    ThreadError error = kThreadError_None;
+    Transaction *transaction;
+
+    if (aHeader.GetType() != Header::kTypeConfirmable || aHandler == NULL)
+    {
+        ExitNow(error = mSocket.SendTo(aMessage, aMessageInfo));
+    }
+
+    VerifyOrExit((transaction = NewTransaction()) != NULL, error = kThreadError_NoBufs);
+
+    transaction->mMessage = &aMessage;
+    transaction->mMessageInfo = aMessageInfo;
+    transaction->mHandler = aHandler;
+    transaction->mContext = aContext;
+    transaction->mTokenLength = aHeader.GetTokenLength();
+    memcpy(transaction->mToken, aHeader.GetToken(), transaction->mTokenLength);
+    transaction->mTokenHash = HashToken(transaction->mToken, transaction->mTokenLength);
+    transaction->mAttemptsRemaining = kMaxRetransmit;
+    transaction->mRetransmissionTimeout = kAckTimeout;
+    transaction->mInUse = true;
+
+    error = Transmit(*transaction);
+
+    if (error != kThreadError_None)
+    {
+        transaction->mInUse = false;
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Client::Transmit(Transaction &aTransaction)
+{
+    ThreadError error = kThreadError_None;
+    Message *message;
+
+    // the original request is retained for further attempts; a copy goes on the air
+    VerifyOrExit((message = aTransaction.mMessage->Clone()) != NULL, error = kThreadError_NoBufs);
+
+    error = mSocket.SendTo(*message, aTransaction.mMessageInfo);
+
+    if (error != kThreadError_None)
+    {
+        message->Free();
+        ExitNow();
+    }
+
+    aTransaction.mAttemptsRemaining--;
+    aTransaction.mNextAttempt = Timer::GetNow() + aTransaction.mRetransmissionTimeout;
+    aTransaction.mRetransmissionTimeout *= 2;
+
+    if (!mRetransmissionTimer.IsRunning())
+    {
+        mRetransmissionTimer.Start(aTransaction.mRetransmissionTimeout / 2);
+    }
+
+exit:
+    return error;
+}
+
+uint8_t Client::HashToken(const uint8_t *aToken, uint8_t aTokenLength)
+{
+    uint8_t hash = aTokenLength;
+
+    for (uint8_t i = 0; i < aTokenLength; i++)
+    {
+        hash ^= aToken[i];
+    }
+
+    return hash;
+}
+
+Client::Transaction *Client::NewTransaction(void)
+{
+    Transaction *rval = NULL;
+
+    for (int i = 0; i < kMaxTransactions; i++)
+    {
+        if (!mTransactions[i].mInUse)
+        {
+            ExitNow(rval = &mTransactions[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+Client::Transaction *Client::FindTransaction(const Header &aHeader)
+{
+    Transaction *rval = NULL;
+    uint8_t tokenHash = HashToken(aHeader.GetToken(), aHeader.GetTokenLength());
+
+    for (int i = 0; i < kMaxTransactions; i++)
+    {
+        if (mTransactions[i].mInUse &&
+            mTransactions[i].mTokenHash == tokenHash &&
+            mTransactions[i].mTokenLength == aHeader.GetTokenLength() &&
+            memcmp(mTransactions[i].mToken, aHeader.GetToken(), mTransactions[i].mTokenLength) == 0)
+        {
+            ExitNow(rval = &mTransactions[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+void Client::Finalize(Transaction &aTransaction, Header *aHeader, Message *aMessage,
+                      const Ip6::MessageInfo *aMessageInfo, ThreadError aResult)
+{
+    ResponseHandler handler = aTransaction.mHandler;
+    void *context = aTransaction.mContext;
+
+    aTransaction.mMessage->Free();
+    aTransaction.mInUse = false;
+
+    if (handler != NULL)
+    {
+        handler(context, aHeader, aMessage, aMessageInfo, aResult);
+    }
+}
+
+void Client::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+{
+    Client *obj = reinterpret_cast<Client *>(aContext);
+    obj->HandleUdpReceive(*static_cast<Message *>(aMessage), *static_cast<const Ip6::MessageInfo *>(aMessageInfo));
+}
+
+void Client::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+{
+    Header header;
+    Transaction *transaction;
+
+    SuccessOrExit(header.FromMessage(aMessage));
+    VerifyOrExit((transaction = FindTransaction(header)) != NULL, ;);
+
+    aMessage.MoveOffset(header.GetLength());
+    Finalize(*transaction, &header, &aMessage, &aMessageInfo, kThreadError_None);
+
+exit:
+    {}
+}
+
+void Client::HandleRetransmissionTimer(void *aContext)
+{
+    Client *obj = reinterpret_cast<Client *>(aContext);
+    obj->HandleRetransmissionTimer();
+}
+
+void Client::HandleRetransmissionTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t nextDelta = 0xffffffff;
+    uint32_t delta;
+
+    for (int i = 0; i < kMaxTransactions; i++)
+    {
+        Transaction &transaction = mTransactions[i];
+
+        if (!transaction.mInUse)
+        {
+            continue;
+        }
+
+        if (static_cast<int32_t>(transaction.mNextAttempt - now) <= 0)
+        {
+            if (transaction.mAttemptsRemaining == 0)
+            {
+                Finalize(transaction, NULL, NULL, NULL, kThreadError_NoAck);
+                continue;
+            }
+
+            if (Transmit(transaction) != kThreadError_None)
+            {
+                // out of buffers for this attempt; retry shortly instead of leaving
+                // the next attempt in the past, which would wrap the delta below and
+                // park the timer ~49 days out
+                transaction.mNextAttempt = now + kAckTimeout;
+            }
+        }
+
+        delta = transaction.mNextAttempt - now;
+
+        if (delta < nextDelta)
+        {
+            nextDelta = delta;
+        }
+    }
+
+    if (nextDelta != 0xffffffff)
+    {
+        mRetransmissionTimer.Start(nextDelta);
+    }
+}
+
+}  // namespace Coap
+}  // namespace Thread
@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the CoAP client.
+ */
+
+#ifndef COAP_CLIENT_HPP_
+#define COAP_CLIENT_HPP_
+
+#include <coap/coap_header.hpp>
+#include <common/message.hpp>
+#include <common/timer.hpp>
+#include <net/udp6.hpp>
+
+namespace Thread {
+namespace Coap {
+
+/**
+ * @addtogroup core-coap
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements the CoAP client.
+ *
+ * Confirmable requests are retained for retransmission and their responses are matched
+ * back to the caller by token, so that multiple exchanges may be outstanding at once.
+ *
+ */
+class Client
+{
+public:
+    /**
+     * This function pointer is called when a response to an outstanding request arrives,
+     * or when all retransmission attempts have been exhausted.
+     *
+     * @param[in]  aContext      A pointer to arbitrary context information.
+     * @param[in]  aHeader       A pointer to the CoAP header of the response, or NULL on failure.
+     * @param[in]  aMessage      A pointer to the response message, or NULL on failure.
+     * @param[in]  aMessageInfo  A pointer to the message info for @p aMessage, or NULL on failure.
+     * @param[in]  aResult       kThreadError_None when a response was received,
+     *                           kThreadError_NoAck when the request timed out.
+     *
+     */
+    typedef void (*ResponseHandler)(void *aContext, Header *aHeader, Message *aMessage,
+                                    const Ip6::MessageInfo *aMessageInfo, ThreadError aResult);
+
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in]  aIp6  A reference to the IPv6 network object.
+     *
+     */
+    explicit Client(Ip6::Ip6 &aIp6);
+
+    /**
+     * This method starts the CoAP client.
+     *
+     * @retval kThreadError_None  Successfully started the CoAP client.
+     *
+     */
+    ThreadError Start(void);
+
+    /**
+     * This method stops the CoAP client and aborts all outstanding requests.
+     *
+     * @retval kThreadError_None  Successfully stopped the CoAP client.
+     *
+     */
+    ThreadError Stop(void);
+
+    /**
+     * This method returns a new UDP message with sufficient header space reserved.
+     *
+     * @param[in]  aReserved  The number of header bytes to reserve after the UDP header.
+     *
+     * @returns A pointer to the message or NULL if no buffers are available.
+     *
+     */
+    Message *NewMessage(uint16_t aReserved);
+
+    /**
+     * This method sends a CoAP request.
+     *
+     * For Confirmable requests with a non-NULL @p aHandler the message is retained and
+     * retransmitted until a response matching its token arrives or the attempts are exhausted.
+     *
+     * @param[in]  aMessage      The CoAP request to send.
+     * @param[in]  aHeader       The CoAP header already appended to @p aMessage.
+     * @param[in]  aMessageInfo  The message info corresponding to @p aMessage.
+     * @param[in]  aHandler      A function pointer that is called on response or timeout, or NULL.
+     * @param[in]  aContext      A pointer to arbitrary context information.
+     *
+     * @retval kThreadError_None    Successfully enqueued the CoAP request message.
+     * @retval kThreadError_NoBufs  Insufficient buffers available to track the request.
+     *
+     */
+    ThreadError SendMessage(Message &aMessage, const Header &aHeader, const Ip6::MessageInfo &aMessageInfo,
+                            ResponseHandler aHandler, void *aContext);
+
+private:
+    enum
+    {
+        kMaxTransactions = 4,     ///< Maximum number of outstanding requests.
+        kAckTimeout      = 2000,  ///< Initial retransmission timeout (milliseconds).
+        kMaxRetransmit   = 4,     ///< Maximum number of transmission attempts.
+    };
+
+    struct Transaction
+    {
+        Message          *mMessage;                          ///< The request, retained for retransmission.
+        Ip6::MessageInfo  mMessageInfo;                      ///< The destination of the request.
+        ResponseHandler   mHandler;                          ///< The response handler.
+        void             *mContext;                          ///< The response handler context.
+        uint32_t          mNextAttempt;                      ///< Time of the next retransmission.
+        uint32_t          mRetransmissionTimeout;            ///< Current retransmission timeout.
+        uint8_t           mToken[Header::kMaxTokenLength];   ///< The request token.
+        uint8_t           mTokenLength;                      ///< The request token length.
+        uint8_t           mTokenHash;                        ///< One-byte hash of the token.
+        uint8_t           mAttemptsRemaining;                ///< Transmission attempts left.
+        bool              mInUse;                            ///< TRUE if this entry is in use.
+    };
+
+    static uint8_t HashToken(const uint8_t *aToken, uint8_t aTokenLength);
+    Transaction *NewTransaction(void);
+    Transaction *FindTransaction(const Header &aHeader);
+    void Finalize(Transaction &aTransaction, Header *aHeader, Message *aMessage,
+                  const Ip6::MessageInfo *aMessageInfo, ThreadError aResult);
+    ThreadError Transmit(Transaction &aTransaction);
+
+    static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
+    void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    static void HandleRetransmissionTimer(void *aContext);
+    void HandleRetransmissionTimer(void);
+
+    Ip6::UdpSocket mSocket;
+    Timer mRetransmissionTimer;
+    Transaction mTransactions[kMaxTransactions];
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Coap
+}  // namespace Thread
+
+#endif  // COAP_CLIENT_HPP_
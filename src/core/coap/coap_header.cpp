@@ -43,6 +43,8 @@ void Header::Init(void)
     mHeaderLength = kMinHeaderLength;
     mOptionLast = 0;
     mNextOptionOffset = 0;
+    mOptionCount = 0;
+    mDirectoryComplete = true;
     memset(&mOption, 0, sizeof(mOption));
     memset(mHeader, 0, sizeof(mHeader));
 }
@@ -54,9 +56,13 @@ ThreadError Header::FromMessage(const Message &aMessage)
     uint16_t length = aMessage.GetLength() - aMessage.GetOffset();
     uint8_t tokenLength;
     bool firstOption = true;
+    uint16_t optionNumber = 0;
     uint16_t optionDelta;
     uint16_t optionLength;
 
+    mOptionCount = 0;
+    mDirectoryComplete = true;
+
     VerifyOrExit(length >= kTokenOffset, error = kThreadError_Parse);
     aMessage.Read(offset, kTokenOffset, mHeader);
     mHeaderLength = kTokenOffset;
@@ -136,15 +142,30 @@ ThreadError Header::FromMessage(const Message &aMessage)
             ExitNow(error = kThreadError_Parse);
         }
 
+        optionNumber += optionDelta;
+
         if (firstOption)
         {
-            mOption.mNumber = optionDelta;
+            mOption.mNumber = optionNumber;
             mOption.mLength = optionLength;
             mOption.mValue = mHeader + mHeaderLength;
             mNextOptionOffset = mHeaderLength + optionLength;
             firstOption = false;
         }
 
+        // index the option for direct lookup through GetOption()
+        if (mOptionCount < kOptionDirectorySize)
+        {
+            mOptionDirectory[mOptionCount].mNumber = optionNumber;
+            mOptionDirectory[mOptionCount].mLength = optionLength;
+            mOptionDirectory[mOptionCount].mValueOffset = mHeaderLength;
+            mOptionCount++;
+        }
+        else
+        {
+            mDirectoryComplete = false;
+        }
+
         VerifyOrExit(optionLength <= length, error = kThreadError_Parse);
         aMessage.Read(offset, optionLength, mHeader + mHeaderLength);
         mHeaderLength += static_cast<uint8_t>(optionLength);
@@ -156,61 +177,223 @@ exit:
     return error;
 }
 
-ThreadError Header::AppendOption(const Option &aOption)
+uint8_t Header::EncodeOptionHeader(uint16_t aDelta, uint16_t aLength, uint8_t *aBuf) const
 {
-    uint8_t *buf = mHeader + mHeaderLength;
-    uint8_t *cur = buf + 1;
-    uint16_t optionDelta = aOption.mNumber - mOptionLast;
-    uint16_t optionLength;
+    uint8_t *cur = aBuf + 1;
+
+    if (aDelta < kOption1ByteExtensionOffset)
+    {
+        *aBuf = (aDelta << Option::kOptionDeltaOffset) & Option::kOptionDeltaMask;
+    }
+    else if (aDelta < kOption2ByteExtensionOffset)
+    {
+        *aBuf = kOption1ByteExtension << Option::kOptionDeltaOffset;
+        *cur++ = (aDelta - kOption1ByteExtensionOffset) & 0xff;
+    }
+    else
+    {
+        *aBuf = kOption2ByteExtension << Option::kOptionDeltaOffset;
+        aDelta -= kOption2ByteExtensionOffset;
+        *cur++ = aDelta >> 8;
+        *cur++ = aDelta & 0xff;
+    }
+
+    if (aLength < kOption1ByteExtensionOffset)
+    {
+        *aBuf |= aLength;
+    }
+    else if (aLength < kOption2ByteExtensionOffset)
+    {
+        *aBuf |= kOption1ByteExtension;
+        *cur++ = (aLength - kOption1ByteExtensionOffset) & 0xff;
+    }
+    else
+    {
+        *aBuf |= kOption2ByteExtension;
+        aLength -= kOption2ByteExtensionOffset;
+        *cur++ = aLength >> 8;
+        *cur++ = aLength & 0xff;
+    }
+
+    return static_cast<uint8_t>(cur - aBuf);
+}
+
+ThreadError Header::DecodeOptionHeader(uint16_t &aOffset, uint16_t &aDelta, uint16_t &aLength) const
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mHeader[aOffset] != 0xff, error = kThreadError_Parse);
 
-    if (optionDelta < kOption1ByteExtensionOffset)
+    aDelta = mHeader[aOffset] >> 4;
+    aLength = mHeader[aOffset] & 0xf;
+    aOffset += sizeof(uint8_t);
+
+    if (aDelta < kOption1ByteExtension)
+    {
+        // do nothing
+    }
+    else if (aDelta == kOption1ByteExtension)
     {
-        *buf = (optionDelta << Option::kOptionDeltaOffset) & Option::kOptionDeltaMask;
+        aDelta = kOption1ByteExtensionOffset + mHeader[aOffset];
+        aOffset += sizeof(uint8_t);
     }
-    else if (optionDelta < kOption2ByteExtensionOffset)
+    else if (aDelta == kOption2ByteExtension)
     {
-        *buf |= kOption1ByteExtension << Option::kOptionDeltaOffset;
-        *cur++ = (optionDelta - kOption1ByteExtensionOffset) & 0xff;
+        aDelta = kOption2ByteExtensionOffset +
+                 static_cast<uint16_t>((mHeader[aOffset] << 8) | mHeader[aOffset + 1]);
+        aOffset += sizeof(uint16_t);
     }
     else
     {
-        *buf |= kOption2ByteExtension << Option::kOptionDeltaOffset;
-        optionDelta -= kOption2ByteExtensionOffset;
-        *cur++ = optionDelta >> 8;
-        *cur++ = optionDelta & 0xff;
+        ExitNow(error = kThreadError_Parse);
     }
 
-    if (aOption.mLength < kOption1ByteExtensionOffset)
+    if (aLength < kOption1ByteExtension)
     {
-        *buf |= aOption.mLength;
+        // do nothing
+    }
+    else if (aLength == kOption1ByteExtension)
+    {
+        aLength = kOption1ByteExtensionOffset + mHeader[aOffset];
+        aOffset += sizeof(uint8_t);
     }
-    else if (aOption.mLength < kOption2ByteExtensionOffset)
+    else if (aLength == kOption2ByteExtension)
     {
-        *buf |= kOption1ByteExtension;
-        *cur++ = (aOption.mLength - kOption1ByteExtensionOffset) & 0xff;
+        aLength = kOption2ByteExtensionOffset +
+                  static_cast<uint16_t>((mHeader[aOffset] << 8) | mHeader[aOffset + 1]);
+        aOffset += sizeof(uint16_t);
     }
     else
     {
-        *buf |= kOption2ByteExtension;
-        optionLength = aOption.mLength - kOption2ByteExtensionOffset;
-        *cur++ = optionLength >> 8;
-        *cur++ = optionLength & 0xff;
+        ExitNow(error = kThreadError_Parse);
     }
 
-    memcpy(cur, aOption.mValue, aOption.mLength);
-    cur += aOption.mLength;
+exit:
+    return error;
+}
+
+ThreadError Header::AppendOption(const Option &aOption)
+{
+    ThreadError error = kThreadError_None;
+    uint8_t optionHeader[kMaxOptionHeaderSize];
+    uint8_t headerSize;
+
+    if (aOption.mNumber < mOptionLast)
+    {
+        ExitNow(error = InsertOption(aOption));
+    }
 
-    mHeaderLength += static_cast<uint8_t>(cur - buf);
+    headerSize = EncodeOptionHeader(aOption.mNumber - mOptionLast, aOption.mLength, optionHeader);
+    VerifyOrExit(mHeaderLength + headerSize + aOption.mLength <= kMaxHeaderLength, error = kThreadError_NoBufs);
+
+    memcpy(mHeader + mHeaderLength, optionHeader, headerSize);
+    memcpy(mHeader + mHeaderLength + headerSize, aOption.mValue, aOption.mLength);
+    mHeaderLength += headerSize + static_cast<uint8_t>(aOption.mLength);
     mOptionLast = aOption.mNumber;
 
-    return kThreadError_None;
+exit:
+    return error;
+}
+
+ThreadError Header::InsertOption(const Option &aOption)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t offset = kTokenOffset + GetTokenLength();
+    uint16_t headerOffset;
+    uint16_t prevNumber = 0;
+    uint16_t number = 0;
+    uint16_t delta = 0;
+    uint16_t length = 0;
+    uint8_t oldHeaderSize;
+    uint8_t newHeader[kMaxOptionHeaderSize];
+    uint8_t fixHeader[kMaxOptionHeaderSize];
+    uint8_t newHeaderSize;
+    uint8_t fixHeaderSize;
+    int shift;
+
+    // locate the first option numbered above the new option
+    for (;;)
+    {
+        VerifyOrExit(offset < mHeaderLength, error = kThreadError_Parse);
+
+        headerOffset = offset;
+        SuccessOrExit(error = DecodeOptionHeader(offset, delta, length));
+
+        if (number + delta > aOption.mNumber)
+        {
+            break;
+        }
+
+        number += delta;
+        prevNumber = number;
+        offset += length;
+    }
+
+    oldHeaderSize = static_cast<uint8_t>(offset - headerOffset);
+
+    // the new option takes over the delta from its predecessor, and the delta of the
+    // following option is re-encoded relative to the new option
+    newHeaderSize = EncodeOptionHeader(aOption.mNumber - prevNumber, aOption.mLength, newHeader);
+    fixHeaderSize = EncodeOptionHeader((number + delta) - aOption.mNumber, length, fixHeader);
+    shift = newHeaderSize + aOption.mLength + fixHeaderSize - oldHeaderSize;
+
+    VerifyOrExit(mHeaderLength + shift <= kMaxHeaderLength, error = kThreadError_NoBufs);
+
+    memmove(mHeader + headerOffset + oldHeaderSize + shift, mHeader + offset, mHeaderLength - offset);
+    memcpy(mHeader + headerOffset, newHeader, newHeaderSize);
+    memcpy(mHeader + headerOffset + newHeaderSize, aOption.mValue, aOption.mLength);
+    memcpy(mHeader + headerOffset + newHeaderSize + aOption.mLength, fixHeader, fixHeaderSize);
+    mHeaderLength += static_cast<uint8_t>(shift);
+
+exit:
+    return error;
 }
 
+enum
+{
+    kUriPathCacheEntries = 16,  ///< Number of cached rendered Uri-Path option sequences.
+    kUriPathCacheBytes   = 16,  ///< Maximum rendered length eligible for caching.
+};
+
+struct UriPathCache
+{
+    const char *mUriPath;                  ///< The Uri-Path string, or NULL when unused.
+    uint8_t     mLength;                   ///< The rendered length in bytes.
+    uint8_t     mBytes[kUriPathCacheBytes];  ///< The rendered option bytes.
+};
+
+static UriPathCache sUriPathCache[kUriPathCacheEntries];
+
 ThreadError Header::AppendUriPathOptions(const char *aUriPath)
 {
     const char *cur = aUriPath;
     const char *end;
     Header::Option coapOption;
+    UriPathCache *cache = NULL;
+    uint8_t headerLength = mHeaderLength;
+
+    // the rendered option bytes only depend on the preceding option number, so the
+    // internal URIs - always the first option of a fixed set of strings - render to
+    // the same bytes every time and are served from a cache with a single memcpy
+    if (mOptionLast == 0)
+    {
+        for (int i = 0; i < kUriPathCacheEntries; i++)
+        {
+            if (sUriPathCache[i].mUriPath == NULL)
+            {
+                cache = &sUriPathCache[i];
+                break;
+            }
+
+            if (strcmp(sUriPathCache[i].mUriPath, aUriPath) == 0)
+            {
+                memcpy(mHeader + mHeaderLength, sUriPathCache[i].mBytes, sUriPathCache[i].mLength);
+                mHeaderLength += sUriPathCache[i].mLength;
+                mOptionLast = Option::kOptionUriPath;
+                ExitNow();
+            }
+        }
+    }
 
     coapOption.mNumber = Option::kOptionUriPath;
 
@@ -226,6 +409,14 @@ ThreadError Header::AppendUriPathOptions(const char *aUriPath)
     coapOption.mValue = reinterpret_cast<const uint8_t *>(cur);
     AppendOption(coapOption);
 
+    if (cache != NULL && (mHeaderLength - headerLength) <= kUriPathCacheBytes)
+    {
+        cache->mLength = mHeaderLength - headerLength;
+        memcpy(cache->mBytes, mHeader + headerLength, cache->mLength);
+        cache->mUriPath = aUriPath;
+    }
+
+exit:
     return kThreadError_None;
 }
 
@@ -247,58 +438,62 @@ const Header::Option *Header::GetCurrentOption(void) const
     return &mOption;
 }
 
-const Header::Option *Header::GetNextOption(void)
+const Header::Option *Header::GetOption(uint16_t aNumber)
 {
     Option *rval = NULL;
-    uint16_t optionDelta;
-    uint16_t optionLength;
+    const OptionEntry *entry;
+    uint16_t offset;
+    uint16_t number;
+    uint16_t delta;
+    uint16_t length;
 
-    VerifyOrExit(mNextOptionOffset < mHeaderLength, ;);
-
-    optionDelta = mHeader[mNextOptionOffset] >> 4;
-    optionLength = mHeader[mNextOptionOffset] & 0xf;
-    mNextOptionOffset += sizeof(uint8_t);
-
-    if (optionDelta < kOption1ByteExtension)
-    {
-        // do nothing
-    }
-    else if (optionDelta == kOption1ByteExtension)
-    {
-        optionDelta = kOption1ByteExtensionOffset + mHeader[mNextOptionOffset];
-        mNextOptionOffset += sizeof(uint8_t);
-    }
-    else if (optionDelta == kOption2ByteExtension)
+    for (uint8_t i = 0; i < mOptionCount; i++)
     {
-        optionDelta = kOption2ByteExtensionOffset +
-                      static_cast<uint16_t>((mHeader[mNextOptionOffset] << 8) | mHeader[mNextOptionOffset + 1]);
-        mNextOptionOffset += sizeof(uint16_t);
-    }
-    else
-    {
-        ExitNow();
+        if (mOptionDirectory[i].mNumber == aNumber)
+        {
+            mOption.mNumber = aNumber;
+            mOption.mLength = mOptionDirectory[i].mLength;
+            mOption.mValue = mHeader + mOptionDirectory[i].mValueOffset;
+            ExitNow(rval = &mOption);
+        }
     }
 
-    if (optionLength < kOption1ByteExtension)
-    {
-        // do nothing
-    }
-    else if (optionLength == kOption1ByteExtension)
-    {
-        optionLength = kOption1ByteExtensionOffset + mHeader[mNextOptionOffset];
-        mNextOptionOffset += sizeof(uint8_t);
-    }
-    else if (optionLength == kOption2ByteExtension)
-    {
-        optionLength = kOption2ByteExtensionOffset +
-                       static_cast<uint16_t>((mHeader[mNextOptionOffset] << 8) | mHeader[mNextOptionOffset + 1]);
-        mNextOptionOffset += sizeof(uint16_t);
-    }
-    else
+    // the directory overflowed; continue a sequential scan from its last entry
+    VerifyOrExit(!mDirectoryComplete, ;);
+
+    entry = &mOptionDirectory[mOptionCount - 1];
+    number = entry->mNumber;
+    offset = entry->mValueOffset + entry->mLength;
+
+    while (offset < mHeaderLength)
     {
-        ExitNow();
+        SuccessOrExit(DecodeOptionHeader(offset, delta, length));
+        number += delta;
+
+        if (number == aNumber)
+        {
+            mOption.mNumber = number;
+            mOption.mLength = length;
+            mOption.mValue = mHeader + offset;
+            ExitNow(rval = &mOption);
+        }
+
+        offset += length;
     }
 
+exit:
+    return rval;
+}
+
+const Header::Option *Header::GetNextOption(void)
+{
+    Option *rval = NULL;
+    uint16_t optionDelta;
+    uint16_t optionLength;
+
+    VerifyOrExit(mNextOptionOffset < mHeaderLength, ;);
+    SuccessOrExit(DecodeOptionHeader(mNextOptionOffset, optionDelta, optionLength));
+
     mOption.mNumber += optionDelta;
     mOption.mLength = optionLength;
     mOption.mValue = mHeader + mNextOptionOffset;
@@ -237,10 +237,14 @@ public:
     /**
      * This method appends a CoAP option.
      *
+     * Options may be appended in any order: an option numbered below an already appended option
+     * is spliced into its sorted position and the delta of the following option is re-encoded
+     * in place.
+     *
      * @param[in]  aOption  The CoAP Option.
      *
-     * @retval kThreadError_None         Successfully appended the option.
-     * @retval kThreadError_InvalidArgs  The option type is not equal or greater than the last option type.
+     * @retval kThreadError_None    Successfully appended the option.
+     * @retval kThreadError_NoBufs  The option does not fit in the header buffer.
      *
      */
     ThreadError AppendOption(const Option &aOption);
@@ -292,6 +296,20 @@ public:
      */
     const Option *GetNextOption(void);
 
+    /**
+     * This method returns the first option with a given number using the directory built while
+     * parsing, without restarting a sequential walk and without disturbing the option iterator.
+     *
+     * Repeatable options (e.g. Uri-Path) should be iterated with GetNextOption() instead since
+     * only the first instance is returned.
+     *
+     * @param[in]  aNumber  The option number to look up.
+     *
+     * @returns A pointer to the option, or NULL if the header contains no such option.
+     *
+     */
+    const Option *GetOption(uint16_t aNumber);
+
     /**
      * This method terminates the CoAP header.
      *
@@ -314,6 +332,11 @@ public:
      */
     uint8_t GetLength(void) const { return mHeaderLength; }
 
+    enum
+    {
+        kMaxTokenLength = 8,     ///< Max token length as specified (RFC 7252).
+    };
+
 private:
     /**
      * Protocol Constants (RFC 7252).
@@ -327,7 +350,6 @@ private:
         kTokenLengthMask            = 0x0f,  ///< Token Length mask as specified (RFC 7252).
         kTokenLengthOffset          = 0,     ///< Token Length offset as specified (RFC 7252).
         kTokenOffset                = 4,     ///< Token offset as specified (RFC 7252).
-        kMaxTokenLength             = 8,     ///< Max token length as specified (RFC 7252).
 
         kOption1ByteExtension       = 13,    ///< Indicates a 1 byte extension (RFC 7252).
         kOption2ByteExtension       = 14,    ///< Indicates a 1 byte extension (RFC 7252).
@@ -341,7 +363,59 @@ private:
         kTypeMask = 0x30,
         kMinHeaderLength = 4,
         kMaxHeaderLength = 128,
+        kMaxOptionHeaderSize = 5,   ///< Largest encoded delta/length header: 1 + 2 + 2 bytes.
+        kOptionDirectorySize = 8,   ///< Number of parsed options indexed for direct lookup.
+    };
+
+    /**
+     * This structure is a directory entry locating a parsed option within the header bytes.
+     *
+     */
+    struct OptionEntry
+    {
+        uint16_t mNumber;       ///< Option Number.
+        uint16_t mLength;       ///< Option value length.
+        uint8_t  mValueOffset;  ///< Offset of the option value within the header bytes.
     };
+
+    /**
+     * This method decodes the delta/length header of the option at @p aOffset.
+     *
+     * @param[inout]  aOffset  On input, the offset of the option within the header bytes; on
+     *                         successful return, the offset of the option value.
+     * @param[out]    aDelta   The decoded option delta.
+     * @param[out]    aLength  The decoded option value length.
+     *
+     * @retval kThreadError_None   Successfully decoded the option header.
+     * @retval kThreadError_Parse  Found the payload marker or a reserved nibble value.
+     *
+     */
+    ThreadError DecodeOptionHeader(uint16_t &aOffset, uint16_t &aDelta, uint16_t &aLength) const;
+
+    /**
+     * This method encodes an option delta/length header into @p aBuf.
+     *
+     * @param[in]   aDelta   The option delta.
+     * @param[in]   aLength  The option value length.
+     * @param[out]  aBuf     The buffer to encode into, at least kMaxOptionHeaderSize bytes.
+     *
+     * @returns The number of bytes encoded.
+     *
+     */
+    uint8_t EncodeOptionHeader(uint16_t aDelta, uint16_t aLength, uint8_t *aBuf) const;
+
+    /**
+     * This method splices an option into its sorted position among the already appended options
+     * and re-encodes the delta of the following option in place.
+     *
+     * @param[in]  aOption  The CoAP Option.
+     *
+     * @retval kThreadError_None    Successfully inserted the option.
+     * @retval kThreadError_NoBufs  The option does not fit in the header buffer.
+     *
+     */
+    ThreadError InsertOption(const Option &aOption);
+
     union
     {
         struct
@@ -356,6 +430,11 @@ private:
     uint16_t mOptionLast;
     uint16_t mNextOptionOffset;
     Option mOption;
+
+    // directory of parsed options, sorted by option number
+    OptionEntry mOptionDirectory[kOptionDirectorySize];
+    uint8_t mOptionCount;
+    bool mDirectoryComplete;
 };
 
 /**
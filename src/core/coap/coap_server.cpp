@@ -41,7 +41,7 @@ Server::Server(Ip6::Udp &aUdp, uint16_t aPort):
     mSocket(aUdp)
 {
     mPort = aPort;
-    mResources = NULL;
+    memset(mBuckets, 0, sizeof(mBuckets));
 }
 
 ThreadError Server::Start()
@@ -65,14 +65,18 @@ ThreadError Server::Stop()
 ThreadError Server::AddResource(Resource &aResource)
 {
     ThreadError error = kThreadError_None;
+    Resource **bucket;
 
-    for (Resource *cur = mResources; cur; cur = cur->mNext)
+    aResource.mUriPathHash = HashUriPath(aResource.mUriPath);
+    bucket = &mBuckets[aResource.mUriPathHash % kNumBuckets];
+
+    for (Resource *cur = *bucket; cur; cur = cur->mNext)
     {
         VerifyOrExit(cur != &aResource, error = kThreadError_Busy);
     }
 
-    aResource.mNext = mResources;
-    mResources = &aResource;
+    aResource.mNext = *bucket;
+    *bucket = &aResource;
 
 exit:
     return error;
@@ -80,13 +84,15 @@ exit:
 
 void Server::RemoveResource(Resource &aResource)
 {
-    if (mResources == &aResource)
+    Resource **bucket = &mBuckets[HashUriPath(aResource.mUriPath) % kNumBuckets];
+
+    if (*bucket == &aResource)
     {
-        mResources = aResource.mNext;
+        *bucket = aResource.mNext;
     }
     else
     {
-        for (Resource *cur = mResources; cur; cur = cur->mNext)
+        for (Resource *cur = *bucket; cur; cur = cur->mNext)
         {
             if (cur->mNext == &aResource)
             {
@@ -100,6 +106,18 @@ exit:
     aResource.mNext = NULL;
 }
 
+uint8_t Server::HashUriPath(const char *aUriPath)
+{
+    uint8_t hash = 0;
+
+    for (const char *cur = aUriPath; *cur; cur++)
+    {
+        hash = static_cast<uint8_t>((hash << 1) ^ (hash >> 7) ^ *cur);
+    }
+
+    return hash;
+}
+
 void Server::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     Server *obj = reinterpret_cast<Server *>(aContext);
@@ -112,6 +130,7 @@ void Server::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
     char uriPath[kMaxReceivedUriPath];
     char *curUriPath = uriPath;
     const Header::Option *coapOption;
+    uint8_t uriPathHash;
 
     SuccessOrExit(header.FromMessage(aMessage));
     aMessage.MoveOffset(header.GetLength());
@@ -141,9 +160,11 @@ void Server::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
 
     curUriPath[-1] = '\0';
 
-    for (Resource *resource = mResources; resource; resource = resource->mNext)
+    uriPathHash = HashUriPath(uriPath);
+
+    for (Resource *resource = mBuckets[uriPathHash % kNumBuckets]; resource; resource = resource->mNext)
     {
-        if (strcmp(resource->mUriPath, uriPath) == 0)
+        if (resource->mUriPathHash == uriPathHash && strcmp(resource->mUriPath, uriPath) == 0)
         {
             resource->HandleRequest(header, aMessage, aMessageInfo);
             ExitNow();
@@ -156,7 +177,14 @@ exit:
 
 Message *Server::NewMessage(uint16_t aReserved)
 {
-    return mSocket.NewMessage(aReserved);
+    Message *message = mSocket.NewMessage(aReserved);
+
+    if (message != NULL)
+    {
+        message->SetOwner(Message::kOwnerCoap);
+    }
+
+    return message;
 }
 
 ThreadError Server::SendMessage(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
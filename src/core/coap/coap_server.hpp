@@ -92,6 +92,7 @@ private:
     CoapMessageHandler mHandler;
     void *mContext;
     Resource *mNext;
+    uint8_t mUriPathHash;
 };
 
 /**
@@ -171,14 +172,19 @@ private:
     enum
     {
         kMaxReceivedUriPath = 32,   ///< Maximum supported URI path on received messages.
+        kNumBuckets = 16,           ///< Number of Uri-Path hash buckets.
     };
 
+    static uint8_t HashUriPath(const char *aUriPath);
+
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
     Ip6::UdpSocket mSocket;
     uint16_t mPort;
-    Resource *mResources;
+
+    // resources indexed by Uri-Path hash so that dispatch walks a single short bucket
+    Resource *mBuckets[kNumBuckets];
 };
 
 /**
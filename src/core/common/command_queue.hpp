@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a lock-free multi-producer command queue.
+ */
+
+#ifndef COMMAND_QUEUE_HPP_
+#define COMMAND_QUEUE_HPP_
+
+#include <stddef.h>
+
+#include <openthread-types.h>
+
+namespace Thread {
+
+/**
+ * This class implements a lock-free multi-producer single-consumer command queue.
+ *
+ * Host application threads push caller-owned otApiCommand nodes with a compare-and-swap
+ * loop; the stack thread detaches the whole list with a single atomic exchange and runs
+ * the commands in submission order. No mutex is taken on either side.
+ *
+ */
+class CommandQueue
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    CommandQueue(void) : mHead(NULL) { }
+
+    /**
+     * This method pushes a command onto the queue. It may be called from any thread.
+     *
+     * @param[in]  aCommand  A reference to the command to push. The caller retains
+     *                       ownership of the storage until the command has executed.
+     *
+     */
+    void Push(otApiCommand &aCommand) {
+        otApiCommand *head;
+
+        do
+        {
+            head = mHead;
+            aCommand.mNext = head;
+        }
+        while (!__sync_bool_compare_and_swap(&mHead, head, &aCommand));
+    }
+
+    /**
+     * This method detaches all queued commands. It MUST only be called from the stack thread.
+     *
+     * @returns A pointer to the oldest queued command, chained through mNext in submission
+     *          order, or NULL if the queue is empty.
+     *
+     */
+    otApiCommand *Flush(void) {
+        // the atomic exchange leaves the detached list in push (LIFO) order
+        otApiCommand *lifo = __sync_lock_test_and_set(&mHead, static_cast<otApiCommand *>(NULL));
+        otApiCommand *fifo = NULL;
+
+        while (lifo != NULL)
+        {
+            otApiCommand *next = lifo->mNext;
+            lifo->mNext = fifo;
+            fifo = lifo;
+            lifo = next;
+        }
+
+        return fifo;
+    }
+
+    /**
+     * This method indicates whether or not commands are pending.
+     *
+     * @retval TRUE   If there are commands pending.
+     * @retval FALSE  If there are no commands pending.
+     *
+     */
+    bool IsEmpty(void) const { return mHead == NULL; }
+
+private:
+    otApiCommand *mHead;  ///< The most recently pushed command.
+};
+
+}  // namespace Thread
+
+#endif  // COMMAND_QUEUE_HPP_
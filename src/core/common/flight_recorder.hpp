@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the flight recorder event ring.
+ */
+
+#ifndef FLIGHT_RECORDER_HPP_
+#define FLIGHT_RECORDER_HPP_
+
+#include <openthread-types.h>
+
+namespace Thread {
+
+/**
+ * This function appends an event to the flight recorder ring.
+ *
+ * The ring is always on and fixed size; the oldest entry is overwritten once the ring is full.
+ *
+ * @param[in]  aEvent  The event type (see otFlightRecorderEvent).
+ * @param[in]  aArg8   An event-specific argument.
+ * @param[in]  aArg16  An event-specific argument.
+ *
+ */
+void FlightRecorderRecord(uint8_t aEvent, uint8_t aArg8, uint16_t aArg16);
+
+/**
+ * This function copies the recorded events out of the flight recorder ring, oldest first.
+ *
+ * @param[out]  aEntries     A pointer to the output array.
+ * @param[in]   aMaxEntries  The capacity of @p aEntries.
+ *
+ * @returns The number of entries written to @p aEntries.
+ *
+ */
+uint16_t FlightRecorderGet(otFlightRecorderEntry *aEntries, uint16_t aMaxEntries);
+
+}  // namespace Thread
+
+#endif  // FLIGHT_RECORDER_HPP_
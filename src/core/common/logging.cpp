@@ -32,15 +32,164 @@
  */
 
 #include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include <openthread-core-config.h>
 #include <platform/logging.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+#if OPENTHREAD_CONFIG_LOG_BINARY
+
+enum
+{
+    kBinaryLogRingSize   = OPENTHREAD_CONFIG_LOG_BINARY_RING_SIZE,
+    kBinaryLogHeaderSize = 7,    // format id (4), level (1), region (1), argument bytes (1)
+    kBinaryLogMaxArgs    = 48,   // maximum argument bytes recorded per log site
+    kBinaryLogMaxString  = 15,   // maximum bytes recorded for a %s argument
+};
+
+static uint8_t sBinaryLogRing[kBinaryLogRingSize];
+static uint16_t sBinaryLogHead;    // next write index
+static uint16_t sBinaryLogLength;  // number of bytes in the ring
+
+void otLogBinary(otLogLevel aLevel, otLogRegion aRegion, const char *aFormat, ...)
+{
+    uint8_t record[kBinaryLogHeaderSize + kBinaryLogMaxArgs];
+    uint8_t length = kBinaryLogHeaderSize;
+    uint32_t id = (uint32_t)(uintptr_t)aFormat;
+    const char *cur;
+    va_list args;
+
+    memcpy(record, &id, sizeof(id));
+    record[4] = (uint8_t)aLevel;
+    record[5] = (uint8_t)aRegion;
+
+    va_start(args, aFormat);
+
+    // walk the conversions so the raw arguments can be recorded without formatting them
+    for (cur = aFormat; *cur != '\0'; cur++)
+    {
+        uint32_t value;
+        int isLong = 0;
+
+        if (*cur != '%')
+        {
+            continue;
+        }
+
+        cur++;
+
+        // skip flags, width, precision and length modifiers
+        while (*cur != '\0' && strchr("-+ #.0123456789", *cur) != NULL)
+        {
+            cur++;
+        }
+
+        while (*cur == 'l' || *cur == 'h' || *cur == 'z')
+        {
+            isLong |= (*cur == 'l');
+            cur++;
+        }
+
+        switch (*cur)
+        {
+        case '\0':
+        case '%':
+            break;
+
+        case 's':
+        {
+            const char *str = va_arg(args, const char *);
+            uint8_t copyLength = 0;
+
+            while (copyLength < kBinaryLogMaxString && str[copyLength] != '\0')
+            {
+                copyLength++;
+            }
+
+            if (length + 1 + copyLength > sizeof(record))
+            {
+                break;
+            }
+
+            record[length++] = copyLength;
+            memcpy(record + length, str, copyLength);
+            length += copyLength;
+            break;
+        }
+
+        case 'e':
+        case 'f':
+        case 'g':
+            // floating point arguments are consumed but not recorded
+            (void)va_arg(args, double);
+            break;
+
+        case 'p':
+            value = (uint32_t)(uintptr_t)va_arg(args, void *);
+            goto record_word;
+
+        default:
+            value = isLong ? (uint32_t)va_arg(args, unsigned long) : (uint32_t)va_arg(args, unsigned int);
+
+record_word:
+
+            if (length + sizeof(value) > sizeof(record))
+            {
+                break;
+            }
+
+            memcpy(record + length, &value, sizeof(value));
+            length += sizeof(value);
+            break;
+        }
+
+        if (*cur == '\0')
+        {
+            break;
+        }
+    }
+
+    va_end(args);
+
+    record[6] = (uint8_t)(length - kBinaryLogHeaderSize);
+
+    // commit the record to the ring, dropping it whole if it does not fit
+    if ((uint16_t)(kBinaryLogRingSize - sBinaryLogLength) >= length)
+    {
+        for (uint8_t i = 0; i < length; i++)
+        {
+            sBinaryLogRing[sBinaryLogHead] = record[i];
+            sBinaryLogHead = (uint16_t)((sBinaryLogHead + 1) % kBinaryLogRingSize);
+        }
+
+        sBinaryLogLength = (uint16_t)(sBinaryLogLength + length);
+    }
+}
+
+uint16_t otLogBinaryRead(uint8_t *aBuffer, uint16_t aSize)
+{
+    uint16_t bytes = 0;
+    uint16_t tail = (uint16_t)((sBinaryLogHead + kBinaryLogRingSize - sBinaryLogLength) % kBinaryLogRingSize);
+
+    while (sBinaryLogLength > 0 && bytes < aSize)
+    {
+        aBuffer[bytes++] = sBinaryLogRing[tail];
+        tail = (uint16_t)((tail + 1) % kBinaryLogRingSize);
+        sBinaryLogLength--;
+    }
+
+    return bytes;
+}
+
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY
+
 /**
  * This static method outputs a line of the memory dump.
  *
@@ -45,6 +45,19 @@
 extern "C" {
 #endif
 
+/**
+ * @def otLogEmit
+ *
+ * The function that enabled log sites expand to: otPlatLog() for on-device formatted text logging,
+ * or otLogBinary() when OPENTHREAD_CONFIG_LOG_BINARY deferred-formatting mode is enabled.
+ *
+ */
+#if OPENTHREAD_CONFIG_LOG_BINARY
+#define otLogEmit otLogBinary
+#else
+#define otLogEmit otPlatLog
+#endif
+
 /**
  * @def otLogCrit
  *
@@ -56,7 +69,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_CRIT
-#define otLogCrit(aRegion, aFormat, ...)  otPlatLog(kLogLevelCrit, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogCrit(aRegion, aFormat, ...)  otLogEmit(kLogLevelCrit, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogCrit(aRegion, aFormat, ...)
 #endif
@@ -72,7 +85,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_WARN
-#define otLogWarn(aRegion, aFormat, ...)  otPlatLog(kLogLevelWarn, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogWarn(aRegion, aFormat, ...)  otLogEmit(kLogLevelWarn, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogWarn(aRegion, aFormat, ...)
 #endif
@@ -88,7 +101,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_INFO
-#define otLogInfo(aRegion, aFormat, ...)  otPlatLog(kLogLevelInfo, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogInfo(aRegion, aFormat, ...)  otLogEmit(kLogLevelInfo, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogInfo(aRegion, aFormat, ...)
 #endif
@@ -104,7 +117,7 @@ extern "C" {
  *
  */
 #if OPENTHREAD_CONFIG_LOG_LEVEL >= OPENTHREAD_LOG_LEVEL_DEBG
-#define otLogDebg(aRegion, aFormat, ...)  otPlatLog(kLogLevelDebg, aRegion, aFormat, ## __VA_ARGS__)
+#define otLogDebg(aRegion, aFormat, ...)  otLogEmit(kLogLevelDebg, aRegion, aFormat, ## __VA_ARGS__)
 #else
 #define otLogDebg(aRegion, aFormat, ...)
 #endif
@@ -1033,6 +1046,36 @@ extern "C" {
  */
 void otDump(otLogLevel aLevel, otLogRegion aRegion, const char *aId, const void *aBuf, const int aLength);
 
+#if OPENTHREAD_CONFIG_LOG_BINARY
+
+/**
+ * This function records a log site into the binary log ring without formatting it.
+ *
+ * Each record holds the format string address (the off-device format ID), the level and region, and the
+ * raw arguments: integer conversions as 32-bit words, %s conversions as a length byte followed by the
+ * leading string bytes. Records that do not fit in the ring are dropped.
+ *
+ * @param[in]  aLevel   The log level.
+ * @param[in]  aRegion  The log region.
+ * @param[in]  aFormat  A pointer to the format string.
+ * @param[in]  ...      Arguments for the format specification.
+ *
+ */
+void otLogBinary(otLogLevel aLevel, otLogRegion aRegion, const char *aFormat, ...);
+
+/**
+ * This function drains bytes from the binary log ring.
+ *
+ * @param[in]   aBuffer  A pointer to the buffer where the drained bytes are placed.
+ * @param[in]   aSize    The size of @p aBuffer.
+ *
+ * @returns The number of bytes placed in @p aBuffer.
+ *
+ */
+uint16_t otLogBinaryRead(uint8_t *aBuffer, uint16_t aSize);
+
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY
+
 #ifdef __cplusplus
 };
 #endif
@@ -33,34 +33,150 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/flight_recorder.hpp>
 #include <common/message.hpp>
+#include <common/perf_counters.hpp>
 #include <net/ip6.hpp>
+#include <platform/alarm.h>
 
 namespace Thread {
 
+// Defined here so that the counter block links into any image that uses the message pool.
+otPerfCounters sPerfCounters;
+
+// The flight recorder ring lives next to the counter block for the same linkage reason. The
+// magic word lets a warm reset tell preserved noinit contents from power-on garbage.
+static struct FlightRecorderRing
+{
+    uint32_t mMagic;
+    uint16_t mWriteIndex;
+    uint16_t mCount;
+    otFlightRecorderEntry mEntries[OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES];
+} OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE sFlightRecorder;
+
+enum
+{
+    kFlightRecorderMagic = 0x46523031,  // "FR01"
+};
+
+void FlightRecorderRecord(uint8_t aEvent, uint8_t aArg8, uint16_t aArg16)
+{
+    otFlightRecorderEntry *entry;
+
+    if (sFlightRecorder.mMagic != kFlightRecorderMagic ||
+        sFlightRecorder.mWriteIndex >= OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES ||
+        sFlightRecorder.mCount > OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES)
+    {
+        memset(&sFlightRecorder, 0, sizeof(sFlightRecorder));
+        sFlightRecorder.mMagic = kFlightRecorderMagic;
+    }
+
+    entry = &sFlightRecorder.mEntries[sFlightRecorder.mWriteIndex];
+    entry->mTimestamp = otPlatAlarmGetNow();
+    entry->mEvent = aEvent;
+    entry->mArg8 = aArg8;
+    entry->mArg16 = aArg16;
+
+    sFlightRecorder.mWriteIndex =
+        (sFlightRecorder.mWriteIndex + 1) % OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES;
+
+    if (sFlightRecorder.mCount < OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES)
+    {
+        sFlightRecorder.mCount++;
+    }
+}
+
+uint16_t FlightRecorderGet(otFlightRecorderEntry *aEntries, uint16_t aMaxEntries)
+{
+    uint16_t count = 0;
+    uint16_t index;
+
+    VerifyOrExit(sFlightRecorder.mMagic == kFlightRecorderMagic &&
+                 sFlightRecorder.mWriteIndex < OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES &&
+                 sFlightRecorder.mCount <= OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES, ;);
+
+    // the oldest entry sits at the write index once the ring has wrapped
+    index = (sFlightRecorder.mCount < OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES) ?
+            0 : sFlightRecorder.mWriteIndex;
+
+    while (count < sFlightRecorder.mCount && count < aMaxEntries)
+    {
+        aEntries[count++] = sFlightRecorder.mEntries[index];
+        index = (index + 1) % OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES;
+    }
+
+exit:
+    return count;
+}
+
 MessagePool::MessagePool(void)
 {
-    mFreeBuffers = mBuffers;
+    mNumFreeBuffers = 0;
+    mCongested = false;
+    mCongestionCallback = NULL;
+    mCongestionContext = NULL;
+    memset(mOwnerBuffers, 0, sizeof(mOwnerBuffers));
+    memset(mOwnerBuffersMax, 0, sizeof(mOwnerBuffersMax));
+    memset(mDirectionBuffers, 0, sizeof(mDirectionBuffers));
+    mDirectionQuota[Message::kDirectionTx] = kTotalBuffers - kNumReservedReceiveBuffers;
+    mDirectionQuota[Message::kDirectionRx] = kTotalBuffers;
+    InitBufferClass(kClassSmall, mSmallBuffers, kBufferSizeSmall, kNumBuffersSmall);
+    InitBufferClass(kClassNormal, mBuffers, kBufferSize, kNumBuffers);
+    InitBufferClass(kClassLarge, mLargeBuffers, kBufferSizeLarge, kNumBuffersLarge);
+}
 
-    for (int i = 0; i < kNumBuffers - 1; i++)
+void MessagePool::InitBufferClass(uint8_t aClass, void *aStorage, uint16_t aBufferSize, int aNumBuffers)
+{
+    BufferClass &bufferClass = mBufferClasses[aClass];
+    uint8_t *storage = static_cast<uint8_t *>(aStorage);
+    Buffer *buffer;
+
+    bufferClass.mFreeBuffers = NULL;
+    bufferClass.mNumFreeBuffers = aNumBuffers;
+    bufferClass.mDataSize = aBufferSize - sizeof(struct BufferHeader);
+
+    for (int i = aNumBuffers - 1; i >= 0; i--)
     {
-        mBuffers[i].SetNextBuffer(&mBuffers[i + 1]);
+        buffer = reinterpret_cast<Buffer *>(storage + (i * aBufferSize));
+        buffer->SetDataSize(bufferClass.mDataSize);
+        buffer->SetClass(aClass);
+        buffer->SetRefCount(1);
+        buffer->SetNextBuffer(bufferClass.mFreeBuffers);
+        bufferClass.mFreeBuffers = buffer;
     }
 
-    mBuffers[kNumBuffers - 1].SetNextBuffer(NULL);
-    mNumFreeBuffers = kNumBuffers;
+    mNumFreeBuffers += aNumBuffers;
 }
 
-Message *MessagePool::New(uint8_t aType, uint16_t aReserved)
+Message *MessagePool::New(uint8_t aType, uint16_t aReserved, uint8_t aPriority, uint8_t aDirection)
 {
     Message *message = NULL;
+    uint16_t dataSize;
+    uint8_t bufferClass;
+
+    VerifyOrExit((message = static_cast<Message *>(NewBuffer(mBufferClasses[kClassNormal].mDataSize,
+                                                             aPriority,
+                                                             Message::kOwnerUnknown,
+                                                             aDirection))) != NULL, ;);
 
-    VerifyOrExit((message = static_cast<Message *>(NewBuffer())) != NULL, ;);
+    // the first buffer of a message must be able to hold the message metadata
+    if (message->GetDataSize() < sizeof(struct MessageInfo))
+    {
+        FreeBuffers(static_cast<Buffer *>(message), Message::kOwnerUnknown, aDirection);
+        ExitNow(message = NULL);
+    }
 
+    dataSize = message->GetDataSize();
+    bufferClass = message->GetClass();
     memset(message, 0, sizeof(*message));
+    message->SetDataSize(dataSize);
+    message->SetClass(bufferClass);
+    message->SetRefCount(1);
     message->SetMessagePool(this);
     message->SetType(aType);
     message->SetReserved(aReserved);
+    message->SetPriority(aPriority);
+    message->SetDirection(aDirection);
     message->SetLinkSecurityEnabled(true);
 
     if (message->SetLength(0) != kThreadError_None)
@@ -73,47 +189,247 @@ exit:
     return message;
 }
 
+void MessagePool::SetCongestionCallback(CongestionCallback aCallback, void *aContext)
+{
+    mCongestionCallback = aCallback;
+    mCongestionContext = aContext;
+}
+
+void MessagePool::UpdateCongestionState(void)
+{
+    bool congested = mCongested;
+
+    if (mNumFreeBuffers < kCongestionSetThreshold)
+    {
+        congested = true;
+    }
+    else if (mNumFreeBuffers >= kCongestionClearThreshold)
+    {
+        congested = false;
+    }
+
+    VerifyOrExit(congested != mCongested, ;);
+
+    mCongested = congested;
+
+    if (mCongestionCallback != NULL)
+    {
+        mCongestionCallback(mCongested, mCongestionContext);
+    }
+
+exit:
+    return;
+}
+
 ThreadError MessagePool::Free(Message *aMessage)
 {
     assert(aMessage->GetMessageList(MessageInfo::kListAll).mList == NULL &&
            aMessage->GetMessageList(MessageInfo::kListInterface).mList == NULL);
-    return FreeBuffers(static_cast<Buffer *>(aMessage));
+    return FreeBuffers(static_cast<Buffer *>(aMessage), aMessage->GetOwner(), aMessage->GetDirection());
+}
+
+void MessagePool::GetInfo(otBufferInfo &aBufferInfo) const
+{
+    aBufferInfo.mTotalBuffers = kNumBuffers + kNumBuffersSmall + kNumBuffersLarge;
+    aBufferInfo.mFreeBuffers = static_cast<uint16_t>(mNumFreeBuffers);
+
+    for (int i = 0; i < Message::kNumOwners; i++)
+    {
+        aBufferInfo.mNumBuffers[i] = mOwnerBuffers[i];
+        aBufferInfo.mMaxNumBuffers[i] = mOwnerBuffersMax[i];
+    }
+}
+
+void MessagePool::AdjustOwnerBuffers(uint8_t aOwner, int aDelta)
+{
+    mOwnerBuffers[aOwner] = static_cast<uint16_t>(mOwnerBuffers[aOwner] + aDelta);
+
+    if (mOwnerBuffers[aOwner] > mOwnerBuffersMax[aOwner])
+    {
+        mOwnerBuffersMax[aOwner] = mOwnerBuffers[aOwner];
+    }
+}
+
+bool MessagePool::CanAllocate(uint8_t aPriority, uint8_t aDirection) const
+{
+    int reserved = 0;
+    bool rval = false;
+
+    // neither direction may grow past its partition quota
+    VerifyOrExit(mDirectionBuffers[aDirection] < mDirectionQuota[aDirection], ;);
+
+    // send allocations may not dig into the emergency receive reserve
+    if (aDirection == Message::kDirectionTx)
+    {
+        reserved += kNumReservedReceiveBuffers;
+    }
+
+    // normal priority allocations may not use the reserve for high priority (control) messages
+    if (aPriority != Message::kPriorityHigh)
+    {
+        reserved += kNumReservedPriorityBuffers;
+    }
+
+    rval = (mNumFreeBuffers > reserved);
+
+exit:
+    return rval;
+}
+
+void MessagePool::AdjustDirectionBuffers(uint8_t aDirection, int aDelta)
+{
+    mDirectionBuffers[aDirection] = static_cast<uint16_t>(mDirectionBuffers[aDirection] + aDelta);
+}
+
+ThreadError MessagePool::SetBufferPartition(uint16_t aSendQuota, uint16_t aReceiveQuota)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aSendQuota >= 1 && aSendQuota <= kTotalBuffers - kNumReservedReceiveBuffers,
+                 error = kThreadError_InvalidArgs);
+    VerifyOrExit(aReceiveQuota >= 1 && aReceiveQuota <= kTotalBuffers, error = kThreadError_InvalidArgs);
+
+    mDirectionQuota[Message::kDirectionTx] = aSendQuota;
+    mDirectionQuota[Message::kDirectionRx] = aReceiveQuota;
+
+exit:
+    return error;
+}
+
+Buffer *MessagePool::NewBuffer(uint16_t aSizeHint, uint8_t aPriority, uint8_t aOwner, uint8_t aDirection)
+{
+    Buffer *buffer = NULL;
+    BufferClass *bufferClass = NULL;
+
+    // enforce the direction partition and the priority and receive reserves
+    VerifyOrExit(CanAllocate(aPriority, aDirection), ;);
+
+    // pick the tightest class that can hold @p aSizeHint bytes in a single buffer
+    for (int i = 0; i < kNumClasses; i++)
+    {
+        if (mBufferClasses[i].mDataSize >= aSizeHint && mBufferClasses[i].mFreeBuffers != NULL)
+        {
+            bufferClass = &mBufferClasses[i];
+            break;
+        }
+    }
+
+    // otherwise fall back to the largest class with free buffers and chain
+    if (bufferClass == NULL)
+    {
+        for (int i = kNumClasses - 1; i >= 0; i--)
+        {
+            if (mBufferClasses[i].mFreeBuffers != NULL)
+            {
+                bufferClass = &mBufferClasses[i];
+                break;
+            }
+        }
+    }
+
+    VerifyOrExit(bufferClass != NULL, ;);
+
+    buffer = bufferClass->mFreeBuffers;
+    bufferClass->mFreeBuffers = buffer->GetNextBuffer();
+    buffer->SetNextBuffer(NULL);
+    bufferClass->mNumFreeBuffers--;
+    mNumFreeBuffers--;
+    AdjustOwnerBuffers(aOwner, 1);
+    AdjustDirectionBuffers(aDirection, 1);
+    UpdateCongestionState();
+
+exit:
+
+    if (buffer == NULL)
+    {
+        sPerfCounters.mMessageAllocFailures++;
+        FlightRecorderRecord(kFlightRecorderEventPoolExhausted, aOwner, mNumFreeBuffers);
+    }
+
+    return buffer;
 }
 
-Buffer *MessagePool::NewBuffer(void)
+Buffer *MessagePool::NewBufferFromClass(uint8_t aClass, uint8_t aPriority, uint8_t aOwner, uint8_t aDirection)
 {
     Buffer *buffer = NULL;
+    BufferClass *bufferClass = &mBufferClasses[aClass];
 
-    VerifyOrExit(mFreeBuffers != NULL, ;);
+    VerifyOrExit(CanAllocate(aPriority, aDirection) && bufferClass->mFreeBuffers != NULL, ;);
 
-    buffer = mFreeBuffers;
-    mFreeBuffers = mFreeBuffers->GetNextBuffer();
+    buffer = bufferClass->mFreeBuffers;
+    bufferClass->mFreeBuffers = buffer->GetNextBuffer();
     buffer->SetNextBuffer(NULL);
+    bufferClass->mNumFreeBuffers--;
     mNumFreeBuffers--;
+    AdjustOwnerBuffers(aOwner, 1);
+    AdjustDirectionBuffers(aDirection, 1);
+    UpdateCongestionState();
 
 exit:
+
+    if (buffer == NULL)
+    {
+        sPerfCounters.mMessageAllocFailures++;
+        FlightRecorderRecord(kFlightRecorderEventPoolExhausted, aOwner, mNumFreeBuffers);
+    }
+
     return buffer;
 }
 
-ThreadError MessagePool::FreeBuffers(Buffer *aBuffer)
+ThreadError MessagePool::FreeBuffers(Buffer *aBuffer, uint8_t aOwner, uint8_t aDirection)
 {
     Buffer *tmpBuffer;
+    BufferClass *bufferClass;
 
     while (aBuffer != NULL)
     {
         tmpBuffer = aBuffer->GetNextBuffer();
-        aBuffer->SetNextBuffer(mFreeBuffers);
-        mFreeBuffers = aBuffer;
-        mNumFreeBuffers++;
+
+        if (aBuffer->GetRefCount() > 1)
+        {
+            // the buffer is still referenced by another message
+            aBuffer->DecrementRefCount();
+        }
+        else
+        {
+            bufferClass = &mBufferClasses[aBuffer->GetClass()];
+            aBuffer->SetNextBuffer(bufferClass->mFreeBuffers);
+            bufferClass->mFreeBuffers = aBuffer;
+            bufferClass->mNumFreeBuffers++;
+            mNumFreeBuffers++;
+        }
+
+        AdjustOwnerBuffers(aOwner, -1);
+        AdjustDirectionBuffers(aDirection, -1);
+
         aBuffer = tmpBuffer;
     }
 
+    UpdateCongestionState();
+
     return kThreadError_None;
 }
 
-ThreadError MessagePool::ReclaimBuffers(int aNumBuffers)
+ThreadError MessagePool::ReclaimBuffers(int aNumBuffers, uint8_t aPriority, uint8_t aDirection)
 {
-    return (aNumBuffers <= mNumFreeBuffers) ? kThreadError_None : kThreadError_NoBufs;
+    int numAvailable = mNumFreeBuffers;
+
+    if (aDirection == Message::kDirectionTx)
+    {
+        numAvailable -= kNumReservedReceiveBuffers;
+    }
+
+    if (aPriority != Message::kPriorityHigh)
+    {
+        numAvailable -= kNumReservedPriorityBuffers;
+    }
+
+    if (aNumBuffers > 0 && mDirectionBuffers[aDirection] + aNumBuffers > mDirectionQuota[aDirection])
+    {
+        return kThreadError_NoBufs;
+    }
+
+    return (aNumBuffers <= numAvailable) ? kThreadError_None : kThreadError_NoBufs;
 }
 
 ThreadError Message::ResizeMessage(uint16_t aLength)
@@ -123,18 +439,19 @@ ThreadError Message::ResizeMessage(uint16_t aLength)
     // add buffers
     Buffer *curBuffer = this;
     Buffer *lastBuffer;
-    uint16_t curLength = kHeadBufferDataSize;
+    uint16_t curLength = GetHeadDataSize();
 
     while (curLength < aLength)
     {
         if (curBuffer->GetNextBuffer() == NULL)
         {
-            curBuffer->SetNextBuffer(GetMessagePool()->NewBuffer());
+            curBuffer->SetNextBuffer(GetMessagePool()->NewBuffer(aLength - curLength, GetPriority(), GetOwner(),
+                                                                 GetDirection()));
             VerifyOrExit(curBuffer->GetNextBuffer() != NULL, error = kThreadError_NoBufs);
         }
 
         curBuffer = curBuffer->GetNextBuffer();
-        curLength += kBufferDataSize;
+        curLength += curBuffer->GetDataSize();
     }
 
     // remove buffers
@@ -142,309 +459,828 @@ ThreadError Message::ResizeMessage(uint16_t aLength)
     curBuffer = curBuffer->GetNextBuffer();
     lastBuffer->SetNextBuffer(NULL);
 
-    GetMessagePool()->FreeBuffers(curBuffer);
+    GetMessagePool()->FreeBuffers(curBuffer, GetOwner(), GetDirection());
+
+exit:
+    return error;
+}
+
+ThreadError Message::Free(void)
+{
+    return GetMessagePool()->Free(this);
+}
+
+Message *Message::Clone(void) const
+{
+    Message *message = NULL;
+    MessagePool *pool = GetMessagePool();
+
+    if ((message = static_cast<Message *>(pool->NewBufferFromClass(GetClass(), GetPriority(), GetOwner(),
+                                                                   GetDirection()))) != NULL)
+    {
+        // same head buffer class: copy the head contents and share the tail chain
+        memcpy(message->GetData(), GetData(), GetDataSize());
+        message->SetNextBuffer(GetNextBuffer());
+
+        for (Buffer *buffer = message->GetNextBuffer(); buffer != NULL; buffer = buffer->GetNextBuffer())
+        {
+            buffer->IncrementRefCount();
+            pool->AdjustOwnerBuffers(GetOwner(), 1);
+            pool->AdjustDirectionBuffers(GetDirection(), 1);
+        }
+    }
+    else
+    {
+        // no head buffer of the same class is available: fall back to a full copy
+        VerifyOrExit((message = pool->New(GetType(), GetReserved(), GetPriority(), GetDirection())) != NULL, ;);
+
+        if (message->SetLength(GetLength()) != kThreadError_None)
+        {
+            pool->Free(message);
+            ExitNow(message = NULL);
+        }
+
+        CopyTo(0, 0, GetLength(), *message);
+
+        {
+            uint8_t owner = mInfo.mOwner;
+
+            message->mInfo = mInfo;
+            message->mInfo.mOwner = kOwnerUnknown;
+            message->SetOwner(owner);
+        }
+    }
+
+    // the clone starts out unqueued
+    memset(message->mInfo.mList, 0, sizeof(message->mInfo.mList));
+
+exit:
+    return message;
+}
+
+bool Message::HasSharedBuffers(void) const
+{
+    bool rval = false;
+
+    for (const Buffer *buffer = GetNextBuffer(); buffer != NULL; buffer = buffer->GetNextBuffer())
+    {
+        if (buffer->GetRefCount() > 1)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+ThreadError Message::EnsureExclusive(void)
+{
+    ThreadError error = kThreadError_None;
+    Buffer *prevBuffer = this;
+    Buffer *curBuffer = GetNextBuffer();
+    Buffer *newBuffer;
+
+    while (curBuffer != NULL)
+    {
+        if (curBuffer->GetRefCount() > 1)
+        {
+            VerifyOrExit((newBuffer = GetMessagePool()->NewBufferFromClass(curBuffer->GetClass(),
+                                                                           GetPriority(), GetOwner(),
+                                                                           GetDirection())) != NULL,
+                         error = kThreadError_NoBufs);
+
+            memcpy(newBuffer->GetData(), curBuffer->GetData(), curBuffer->GetDataSize());
+            newBuffer->SetNextBuffer(curBuffer->GetNextBuffer());
+            prevBuffer->SetNextBuffer(newBuffer);
+            curBuffer->DecrementRefCount();
+            GetMessagePool()->AdjustOwnerBuffers(GetOwner(), -1);
+            GetMessagePool()->AdjustDirectionBuffers(GetDirection(), -1);
+            curBuffer = newBuffer;
+        }
+
+        prevBuffer = curBuffer;
+        curBuffer = curBuffer->GetNextBuffer();
+    }
+
+exit:
+    return error;
+}
+
+Message *Message::GetNext(void) const
+{
+    return GetMessageList(MessageInfo::kListInterface).mNext;
+}
+
+uint16_t Message::GetLength(void) const
+{
+    return mInfo.mLength;
+}
+
+uint16_t Message::GetBufferCount(void) const
+{
+    uint16_t rval = 1;
+
+    for (const Buffer *buffer = GetNextBuffer(); buffer != NULL; buffer = buffer->GetNextBuffer())
+    {
+        rval++;
+    }
+
+    return rval;
+}
+
+uint16_t Message::EstimateBufferCount(uint16_t aLength)
+{
+    uint16_t rval = 1;
+
+    if (aLength > kHeadBufferDataSize)
+    {
+        rval += (((aLength - kHeadBufferDataSize) - 1) / kBufferDataSize) + 1;
+    }
+
+    return rval;
+}
+
+ThreadError Message::SetLength(uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t totalLengthRequest = GetReserved() + aLength;
+    uint16_t totalLengthCurrent = GetReserved() + GetLength();
+    uint16_t headDataSize = GetHeadDataSize();
+    int bufs = 0;
+
+    // shared buffers must be copied before the buffer chain is restructured
+    if (HasSharedBuffers())
+    {
+        SuccessOrExit(error = EnsureExclusive());
+    }
+
+    // estimate the buffer delta assuming normal-size buffers; the allocator may
+    // chain smaller or larger classes, this only pre-checks overall availability
+    if (totalLengthRequest > headDataSize)
+    {
+        bufs = (((totalLengthRequest - headDataSize) - 1) / kBufferDataSize) + 1;
+    }
+
+    if (totalLengthCurrent > headDataSize)
+    {
+        bufs -= (((totalLengthCurrent - headDataSize) - 1) / kBufferDataSize) + 1;
+    }
+
+    SuccessOrExit(error = GetMessagePool()->ReclaimBuffers(bufs, GetPriority(), GetDirection()));
+
+    SuccessOrExit(error = ResizeMessage(totalLengthRequest));
+    mInfo.mLength = aLength;
+
+exit:
+    return error;
+}
+
+uint16_t Message::GetOffset(void) const
+{
+    return mInfo.mOffset;
+}
+
+ThreadError Message::MoveOffset(int aDelta)
+{
+    ThreadError error = kThreadError_None;
+
+    assert(GetOffset() + aDelta <= GetLength());
+    VerifyOrExit(GetOffset() + aDelta <= GetLength(), error = kThreadError_InvalidArgs);
+
+    mInfo.mOffset += static_cast<uint16_t>(aDelta);
+    assert(mInfo.mOffset <= GetLength());
+
+exit:
+    return error;
+}
+
+ThreadError Message::SetOffset(uint16_t aOffset)
+{
+    ThreadError error = kThreadError_None;
+
+    assert(aOffset <= GetLength());
+    VerifyOrExit(aOffset <= GetLength(), error = kThreadError_InvalidArgs);
+
+    mInfo.mOffset = aOffset;
+
+exit:
+    return error;
+}
+
+uint8_t Message::GetType(void) const
+{
+    return mInfo.mType;
+}
+
+void Message::SetType(uint8_t aType)
+{
+    mInfo.mType = aType;
+}
+
+uint8_t Message::GetPriority(void) const
+{
+    return mInfo.mPriority;
+}
+
+uint8_t Message::GetOwner(void) const
+{
+    return mInfo.mOwner;
+}
+
+void Message::SetOwner(uint8_t aOwner)
+{
+    if (mInfo.mOwner != aOwner)
+    {
+        int numBuffers = 1;
+
+        for (const Buffer *buffer = GetNextBuffer(); buffer != NULL; buffer = buffer->GetNextBuffer())
+        {
+            numBuffers++;
+        }
+
+        GetMessagePool()->AdjustOwnerBuffers(mInfo.mOwner, -numBuffers);
+        GetMessagePool()->AdjustOwnerBuffers(aOwner, numBuffers);
+        mInfo.mOwner = aOwner;
+    }
+}
+
+void Message::SetPriority(uint8_t aPriority)
+{
+    mInfo.mPriority = aPriority;
+}
+
+uint8_t Message::GetDirection(void) const
+{
+    return mInfo.mDirection;
+}
+
+ThreadError Message::Append(const void *aBuf, uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t oldLength = GetLength();
+    int bytesWritten;
+
+    SuccessOrExit(error = SetLength(GetLength() + aLength));
+    bytesWritten = Write(oldLength, aLength, aBuf);
+
+    assert(bytesWritten == (int)aLength);
+    (void)bytesWritten;
+
+exit:
+    return error;
+}
+
+ThreadError Message::AppendIovec(const otMessageIovec *aIovec, uint8_t aCount)
+{
+    ThreadError error = kThreadError_None;
+    uint16_t offset = GetLength();
+    uint32_t totalLength = 0;
+
+    for (uint8_t i = 0; i < aCount; i++)
+    {
+        totalLength += aIovec[i].mLength;
+    }
+
+    VerifyOrExit(totalLength <= static_cast<uint32_t>(0xffff - GetLength()), error = kThreadError_InvalidArgs);
+
+    SuccessOrExit(error = SetLength(GetLength() + static_cast<uint16_t>(totalLength)));
+
+    for (uint8_t i = 0; i < aCount; i++)
+    {
+        Write(offset, aIovec[i].mLength, aIovec[i].mBase);
+        offset += aIovec[i].mLength;
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Message::Prepend(const void *aBuf, uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aLength <= GetReserved(), error = kThreadError_NoBufs);
+
+    SetReserved(GetReserved() - aLength);
+    mInfo.mLength += aLength;
+    SetOffset(GetOffset() + aLength);
+
+    Write(0, aLength, aBuf);
+
+exit:
+    return error;
+}
+
+uint16_t Message::Read(uint16_t aOffset, uint16_t aLength, void *aBuf) const
+{
+    ChunkIterator iterator;
+
+    iterator.Init(*this, aOffset, aLength);
+
+    return iterator.Read(aLength, aBuf);
+}
+
+int Message::Write(uint16_t aOffset, uint16_t aLength, const void *aBuf)
+{
+    Buffer *curBuffer;
+    uint16_t bytesCopied = 0;
+    uint16_t bytesToCopy;
+
+    assert(aOffset + aLength <= GetLength());
+
+    // copy any shared buffers before writing beyond the first buffer (clone-on-write)
+    if (GetReserved() + aOffset + aLength > GetHeadDataSize() && HasSharedBuffers())
+    {
+        if (EnsureExclusive() != kThreadError_None)
+        {
+            return 0;
+        }
+    }
+
+    if (aOffset + aLength >= GetLength())
+    {
+        aLength = GetLength() - aOffset;
+    }
+
+    aOffset += GetReserved();
+
+    // special case first buffer
+    if (aOffset < GetHeadDataSize())
+    {
+        bytesToCopy = GetHeadDataSize() - aOffset;
+
+        if (bytesToCopy > aLength)
+        {
+            bytesToCopy = aLength;
+        }
+
+        memcpy(GetFirstData() + aOffset, aBuf, bytesToCopy);
+
+        aLength -= bytesToCopy;
+        bytesCopied += bytesToCopy;
+        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
+
+        aOffset = 0;
+    }
+    else
+    {
+        aOffset -= GetHeadDataSize();
+    }
+
+    // advance to offset
+    curBuffer = GetNextBuffer();
+
+    while (curBuffer != NULL && aOffset >= curBuffer->GetDataSize())
+    {
+        aOffset -= curBuffer->GetDataSize();
+        curBuffer = curBuffer->GetNextBuffer();
+    }
+
+    // begin copy
+    while (aLength > 0)
+    {
+        assert(curBuffer != NULL);
+
+        bytesToCopy = curBuffer->GetDataSize() - aOffset;
+
+        if (bytesToCopy > aLength)
+        {
+            bytesToCopy = aLength;
+        }
+
+        memcpy(curBuffer->GetData() + aOffset, aBuf, bytesToCopy);
+
+        aLength -= bytesToCopy;
+        bytesCopied += bytesToCopy;
+        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
+
+        curBuffer = curBuffer->GetNextBuffer();
+        aOffset = 0;
+    }
+
+    return bytesCopied;
+}
+
+const uint8_t *Message::GetContiguousData(uint16_t aOffset, uint16_t aLength) const
+{
+    const uint8_t *data = NULL;
+    const Buffer *curBuffer;
+
+    VerifyOrExit(static_cast<uint32_t>(aOffset) + aLength <= GetLength(), ;);
+
+    aOffset += GetReserved();
+
+    // special case first buffer
+    if (aOffset < GetHeadDataSize())
+    {
+        VerifyOrExit(aOffset + aLength <= GetHeadDataSize(), ;);
+        ExitNow(data = GetFirstData() + aOffset);
+    }
+
+    aOffset -= GetHeadDataSize();
+
+    // advance to the buffer containing the start of the range
+    curBuffer = GetNextBuffer();
+
+    while (curBuffer != NULL && aOffset >= curBuffer->GetDataSize())
+    {
+        aOffset -= curBuffer->GetDataSize();
+        curBuffer = curBuffer->GetNextBuffer();
+    }
+
+    VerifyOrExit(curBuffer != NULL && aOffset + aLength <= curBuffer->GetDataSize(), ;);
+    data = curBuffer->GetData() + aOffset;
+
+exit:
+    return data;
+}
+
+uint8_t *Message::GetContiguousData(uint16_t aOffset, uint16_t aLength)
+{
+    uint8_t *data = NULL;
+
+    // writable views into shared buffers must be copied first (clone-on-write)
+    if (GetReserved() + aOffset + aLength > GetHeadDataSize() && HasSharedBuffers())
+    {
+        VerifyOrExit(EnsureExclusive() == kThreadError_None, ;);
+    }
+
+    data = const_cast<uint8_t *>(static_cast<const Message *>(this)->GetContiguousData(aOffset, aLength));
+
+exit:
+    return data;
+}
+
+uint8_t *Message::GetChunk(uint16_t aOffset, uint16_t &aChunkLength)
+{
+    uint8_t *data = NULL;
+    Buffer *curBuffer;
+
+    VerifyOrExit(aOffset < GetLength(), ;);
+
+    aChunkLength = GetLength() - aOffset;
+
+    aOffset += GetReserved();
+
+    // special case first buffer
+    if (aOffset < GetHeadDataSize())
+    {
+        if (aChunkLength > GetHeadDataSize() - aOffset)
+        {
+            aChunkLength = GetHeadDataSize() - aOffset;
+        }
+
+        ExitNow(data = GetFirstData() + aOffset);
+    }
+
+    // writable views into shared buffers must be copied first (clone-on-write)
+    if (HasSharedBuffers())
+    {
+        VerifyOrExit(EnsureExclusive() == kThreadError_None, ;);
+    }
+
+    aOffset -= GetHeadDataSize();
+
+    // advance to the buffer containing the offset
+    curBuffer = GetNextBuffer();
+
+    while (curBuffer != NULL && aOffset >= curBuffer->GetDataSize())
+    {
+        aOffset -= curBuffer->GetDataSize();
+        curBuffer = curBuffer->GetNextBuffer();
+    }
+
+    VerifyOrExit(curBuffer != NULL, ;);
+
+    if (aChunkLength > curBuffer->GetDataSize() - aOffset)
+    {
+        aChunkLength = curBuffer->GetDataSize() - aOffset;
+    }
+
+    data = curBuffer->GetData() + aOffset;
 
 exit:
-    return error;
+    return data;
 }
 
-ThreadError Message::Free(void)
+const uint8_t *Message::GetChunk(uint16_t aOffset, uint16_t &aChunkLength) const
 {
-    return GetMessagePool()->Free(this);
-}
+    const uint8_t *data = NULL;
+    const Buffer *curBuffer;
 
-Message *Message::GetNext(void) const
-{
-    return GetMessageList(MessageInfo::kListInterface).mNext;
-}
+    VerifyOrExit(aOffset < GetLength(), ;);
 
-uint16_t Message::GetLength(void) const
-{
-    return mInfo.mLength;
-}
+    aChunkLength = GetLength() - aOffset;
 
-ThreadError Message::SetLength(uint16_t aLength)
-{
-    ThreadError error = kThreadError_None;
-    uint16_t totalLengthRequest = GetReserved() + aLength;
-    uint16_t totalLengthCurrent = GetReserved() + GetLength();
-    int bufs = 0;
+    aOffset += GetReserved();
 
-    if (totalLengthRequest > kHeadBufferDataSize)
+    // special case first buffer
+    if (aOffset < GetHeadDataSize())
     {
-        bufs = (((totalLengthRequest - kHeadBufferDataSize) - 1) / kBufferDataSize) + 1;
+        if (aChunkLength > GetHeadDataSize() - aOffset)
+        {
+            aChunkLength = GetHeadDataSize() - aOffset;
+        }
+
+        ExitNow(data = GetFirstData() + aOffset);
     }
 
-    if (totalLengthCurrent > kHeadBufferDataSize)
+    aOffset -= GetHeadDataSize();
+
+    // advance to the buffer containing the offset
+    curBuffer = GetNextBuffer();
+
+    while (curBuffer != NULL && aOffset >= curBuffer->GetDataSize())
     {
-        bufs -= (((totalLengthCurrent - kHeadBufferDataSize) - 1) / kBufferDataSize) + 1;
+        aOffset -= curBuffer->GetDataSize();
+        curBuffer = curBuffer->GetNextBuffer();
     }
 
-    SuccessOrExit(error = GetMessagePool()->ReclaimBuffers(bufs));
+    VerifyOrExit(curBuffer != NULL, ;);
 
-    SuccessOrExit(error = ResizeMessage(totalLengthRequest));
-    mInfo.mLength = aLength;
+    if (aChunkLength > curBuffer->GetDataSize() - aOffset)
+    {
+        aChunkLength = curBuffer->GetDataSize() - aOffset;
+    }
 
-exit:
-    return error;
-}
+    data = curBuffer->GetData() + aOffset;
 
-uint16_t Message::GetOffset(void) const
-{
-    return mInfo.mOffset;
+exit:
+    return data;
 }
 
-ThreadError Message::MoveOffset(int aDelta)
+void Message::ChunkIterator::Init(const Message &aMessage, uint16_t aOffset, uint16_t aLength)
 {
-    ThreadError error = kThreadError_None;
-
-    assert(GetOffset() + aDelta <= GetLength());
-    VerifyOrExit(GetOffset() + aDelta <= GetLength(), error = kThreadError_InvalidArgs);
+    const Buffer *curBuffer;
 
-    mInfo.mOffset += static_cast<uint16_t>(aDelta);
-    assert(mInfo.mOffset <= GetLength());
+    mBuffer = NULL;
+    mData = NULL;
+    mChunkLength = 0;
+    mRemaining = 0;
 
-exit:
-    return error;
-}
+    VerifyOrExit(aOffset < aMessage.GetLength(), ;);
 
-ThreadError Message::SetOffset(uint16_t aOffset)
-{
-    ThreadError error = kThreadError_None;
+    if (aLength > aMessage.GetLength() - aOffset)
+    {
+        aLength = aMessage.GetLength() - aOffset;
+    }
 
-    assert(aOffset <= GetLength());
-    VerifyOrExit(aOffset <= GetLength(), error = kThreadError_InvalidArgs);
+    mRemaining = aLength;
 
-    mInfo.mOffset = aOffset;
+    aOffset += aMessage.GetReserved();
 
-exit:
-    return error;
-}
+    // special case first buffer
+    if (aOffset < aMessage.GetHeadDataSize())
+    {
+        mData = aMessage.GetFirstData() + aOffset;
+        mChunkLength = aMessage.GetHeadDataSize() - aOffset;
+        mBuffer = aMessage.GetNextBuffer();
+    }
+    else
+    {
+        aOffset -= aMessage.GetHeadDataSize();
 
-uint8_t Message::GetType(void) const
-{
-    return mInfo.mType;
-}
+        // advance to the buffer containing the offset
+        curBuffer = aMessage.GetNextBuffer();
 
-void Message::SetType(uint8_t aType)
-{
-    mInfo.mType = aType;
-}
+        while (curBuffer != NULL && aOffset >= curBuffer->GetDataSize())
+        {
+            aOffset -= curBuffer->GetDataSize();
+            curBuffer = curBuffer->GetNextBuffer();
+        }
 
-ThreadError Message::Append(const void *aBuf, uint16_t aLength)
-{
-    ThreadError error = kThreadError_None;
-    uint16_t oldLength = GetLength();
-    int bytesWritten;
+        VerifyOrExit(curBuffer != NULL, mRemaining = 0);
 
-    SuccessOrExit(error = SetLength(GetLength() + aLength));
-    bytesWritten = Write(oldLength, aLength, aBuf);
+        mData = curBuffer->GetData() + aOffset;
+        mChunkLength = curBuffer->GetDataSize() - aOffset;
+        mBuffer = curBuffer->GetNextBuffer();
+    }
 
-    assert(bytesWritten == (int)aLength);
-    (void)bytesWritten;
+    if (mChunkLength > mRemaining)
+    {
+        mChunkLength = mRemaining;
+    }
 
 exit:
-    return error;
+    {}
 }
 
-ThreadError Message::Prepend(const void *aBuf, uint16_t aLength)
+ThreadError Message::ChunkIterator::Init(Message &aMessage, uint16_t aOffset, uint16_t aLength)
 {
     ThreadError error = kThreadError_None;
 
-    VerifyOrExit(aLength <= GetReserved(), error = kThreadError_NoBufs);
-
-    SetReserved(GetReserved() - aLength);
-    mInfo.mLength += aLength;
-    SetOffset(GetOffset() + aLength);
+    // writable views into shared buffers must be copied first (clone-on-write)
+    if (aMessage.HasSharedBuffers())
+    {
+        SuccessOrExit(error = aMessage.EnsureExclusive());
+    }
 
-    Write(0, aLength, aBuf);
+    Init(static_cast<const Message &>(aMessage), aOffset, aLength);
 
 exit:
     return error;
 }
 
-uint16_t Message::Read(uint16_t aOffset, uint16_t aLength, void *aBuf) const
+bool Message::ChunkIterator::GetNextChunk(const uint8_t *&aData, uint16_t &aChunkLength)
 {
-    Buffer *curBuffer;
-    uint16_t bytesCopied = 0;
-    uint16_t bytesToCopy;
-
-    if (aOffset >= GetLength())
-    {
-        ExitNow();
-    }
+    bool rval = false;
 
-    if (aOffset + aLength >= GetLength())
-    {
-        aLength = GetLength() - aOffset;
-    }
+    VerifyOrExit(mRemaining > 0, ;);
 
-    aOffset += GetReserved();
+    aData = mData;
+    aChunkLength = mChunkLength;
+    mRemaining -= mChunkLength;
 
-    // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
+    if (mRemaining > 0)
     {
-        bytesToCopy = kHeadBufferDataSize - aOffset;
+        assert(mBuffer != NULL);
 
-        if (bytesToCopy > aLength)
+        mData = mBuffer->GetData();
+        mChunkLength = mBuffer->GetDataSize();
+
+        if (mChunkLength > mRemaining)
         {
-            bytesToCopy = aLength;
+            mChunkLength = mRemaining;
         }
 
-        memcpy(aBuf, GetFirstData() + aOffset, bytesToCopy);
+        mBuffer = mBuffer->GetNextBuffer();
+    }
 
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-        aBuf = static_cast<uint8_t *>(aBuf) + bytesToCopy;
+    rval = true;
 
-        aOffset = 0;
-    }
-    else
-    {
-        aOffset -= kHeadBufferDataSize;
-    }
+exit:
+    return rval;
+}
 
-    // advance to offset
-    curBuffer = GetNextBuffer();
+bool Message::ChunkIterator::GetNextChunk(uint8_t *&aData, uint16_t &aChunkLength)
+{
+    const uint8_t *data = NULL;
+    bool rval;
 
-    while (aOffset >= kBufferDataSize)
-    {
-        assert(curBuffer != NULL);
+    rval = GetNextChunk(data, aChunkLength);
+    aData = const_cast<uint8_t *>(data);
 
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
-    }
+    return rval;
+}
 
-    // begin copy
-    while (aLength > 0)
+uint16_t Message::ChunkIterator::Read(uint16_t aLength, void *aBuf)
+{
+    uint16_t bytesCopied = 0;
+    uint16_t bytesToCopy;
+
+    while (aLength > 0 && mRemaining > 0)
     {
-        assert(curBuffer != NULL);
+        bytesToCopy = (mChunkLength < aLength) ? mChunkLength : aLength;
 
-        bytesToCopy = kBufferDataSize - aOffset;
+        memcpy(static_cast<uint8_t *>(aBuf) + bytesCopied, mData, bytesToCopy);
 
-        if (bytesToCopy > aLength)
+        bytesCopied += bytesToCopy;
+        aLength -= bytesToCopy;
+        mRemaining -= bytesToCopy;
+        mData += bytesToCopy;
+        mChunkLength -= bytesToCopy;
+
+        if (mChunkLength == 0 && mRemaining > 0)
         {
-            bytesToCopy = aLength;
-        }
+            assert(mBuffer != NULL);
 
-        memcpy(aBuf, curBuffer->GetData() + aOffset, bytesToCopy);
+            mData = mBuffer->GetData();
+            mChunkLength = mBuffer->GetDataSize();
 
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-        aBuf = static_cast<uint8_t *>(aBuf) + bytesToCopy;
+            if (mChunkLength > mRemaining)
+            {
+                mChunkLength = mRemaining;
+            }
 
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
+            mBuffer = mBuffer->GetNextBuffer();
+        }
     }
 
-exit:
     return bytesCopied;
 }
 
-int Message::Write(uint16_t aOffset, uint16_t aLength, const void *aBuf)
+int Message::CopyTo(uint16_t aSourceOffset, uint16_t aDestinationOffset, uint16_t aLength, Message &aMessage) const
 {
-    Buffer *curBuffer;
+    const Buffer *curBuffer;
     uint16_t bytesCopied = 0;
     uint16_t bytesToCopy;
 
-    assert(aOffset + aLength <= GetLength());
+    if (aSourceOffset >= GetLength())
+    {
+        ExitNow();
+    }
 
-    if (aOffset + aLength >= GetLength())
+    if (aSourceOffset + aLength >= GetLength())
     {
-        aLength = GetLength() - aOffset;
+        aLength = GetLength() - aSourceOffset;
     }
 
-    aOffset += GetReserved();
+    aSourceOffset += GetReserved();
 
     // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
+    if (aSourceOffset < GetHeadDataSize())
     {
-        bytesToCopy = kHeadBufferDataSize - aOffset;
+        bytesToCopy = GetHeadDataSize() - aSourceOffset;
 
         if (bytesToCopy > aLength)
         {
             bytesToCopy = aLength;
         }
 
-        memcpy(GetFirstData() + aOffset, aBuf, bytesToCopy);
+        aMessage.Write(aDestinationOffset, bytesToCopy, GetFirstData() + aSourceOffset);
 
         aLength -= bytesToCopy;
         bytesCopied += bytesToCopy;
-        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
+        aDestinationOffset += bytesToCopy;
 
-        aOffset = 0;
+        aSourceOffset = 0;
     }
     else
     {
-        aOffset -= kHeadBufferDataSize;
+        aSourceOffset -= GetHeadDataSize();
     }
 
     // advance to offset
     curBuffer = GetNextBuffer();
 
-    while (aOffset >= kBufferDataSize)
+    while (curBuffer != NULL && aSourceOffset >= curBuffer->GetDataSize())
     {
-        assert(curBuffer != NULL);
-
+        aSourceOffset -= curBuffer->GetDataSize();
         curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
     }
 
-    // begin copy
+    // copy a whole source buffer at a time directly into the destination, avoiding the
+    // staging buffer and the repeated source walks of a Read/Write loop
     while (aLength > 0)
     {
         assert(curBuffer != NULL);
 
-        bytesToCopy = kBufferDataSize - aOffset;
+        bytesToCopy = curBuffer->GetDataSize() - aSourceOffset;
 
         if (bytesToCopy > aLength)
         {
             bytesToCopy = aLength;
         }
 
-        memcpy(curBuffer->GetData() + aOffset, aBuf, bytesToCopy);
+        aMessage.Write(aDestinationOffset, bytesToCopy, curBuffer->GetData() + aSourceOffset);
 
         aLength -= bytesToCopy;
         bytesCopied += bytesToCopy;
-        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
+        aDestinationOffset += bytesToCopy;
 
         curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
+        aSourceOffset = 0;
     }
 
+exit:
     return bytesCopied;
 }
 
-int Message::CopyTo(uint16_t aSourceOffset, uint16_t aDestinationOffset, uint16_t aLength, Message &aMessage) const
+uint16_t Message::GetDatagramTag(void) const
 {
-    uint16_t bytesCopied = 0;
-    uint16_t bytesToCopy;
-    uint8_t buf[16];
+    return mInfo.mDatagramTag;
+}
 
-    while (aLength > 0)
-    {
-        bytesToCopy = (aLength < sizeof(buf)) ? aLength : sizeof(buf);
+void Message::SetDatagramTag(uint16_t aTag)
+{
+    mInfo.mDatagramTag = aTag;
+}
 
-        Read(aSourceOffset, bytesToCopy, buf);
-        aMessage.Write(aDestinationOffset, bytesToCopy, buf);
+uint8_t Message::GetReassemblyHash(void) const
+{
+    return mInfo.mReassemblyHash;
+}
 
-        aSourceOffset += bytesToCopy;
-        aDestinationOffset += bytesToCopy;
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-    }
+void Message::SetReassemblyHash(uint8_t aHash)
+{
+    mInfo.mReassemblyHash = aHash;
+}
 
-    return bytesCopied;
+uint8_t Message::GetFragmentGap(void) const
+{
+    return mInfo.mFragmentGap;
 }
 
-uint16_t Message::GetDatagramTag(void) const
+void Message::SetFragmentGap(uint8_t aFragmentGap)
 {
-    return mInfo.mDatagramTag;
+    mInfo.mFragmentGap = aFragmentGap;
 }
 
-void Message::SetDatagramTag(uint16_t aTag)
+uint16_t Message::GetFragmentRunStart(void) const
 {
-    mInfo.mDatagramTag = aTag;
+    return mInfo.mFragmentRunStart;
+}
+
+uint16_t Message::GetFragmentRunEnd(void) const
+{
+    return mInfo.mFragmentRunEnd;
+}
+
+void Message::SetFragmentRun(uint16_t aStart, uint16_t aEnd)
+{
+    mInfo.mFragmentRunStart = aStart;
+    mInfo.mFragmentRunEnd = aEnd;
 }
 
 bool Message::GetChildMask(uint8_t aChildIndex) const
@@ -568,69 +1404,62 @@ void Message::SetJoinerEntrust(bool aJoinerEntrust)
 
 uint16_t Message::UpdateChecksum(uint16_t aChecksum, uint16_t aOffset, uint16_t aLength) const
 {
-    Buffer *curBuffer;
-    uint16_t bytesCovered = 0;
-    uint16_t bytesToCover;
+    ChunkIterator iterator;
+    const uint8_t *chunk;
+    uint16_t chunkLength;
 
     assert(aOffset + aLength <= GetLength());
 
-    aOffset += GetReserved();
+    iterator.Init(*this, aOffset, aLength);
 
-    // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
+    while (iterator.GetNextChunk(chunk, chunkLength))
     {
-        bytesToCover = kHeadBufferDataSize - aOffset;
+        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, chunk, chunkLength);
+    }
 
-        if (bytesToCover > aLength)
-        {
-            bytesToCover = aLength;
-        }
+    return aChecksum;
+}
 
-        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, GetFirstData() + aOffset, bytesToCover);
+ThreadError Message::PatchChecksum(uint16_t aChecksumOffset, uint16_t aFieldOffset, uint16_t aLength, const void *aValue)
+{
+    ThreadError error = kThreadError_None;
+    const uint8_t *newBytes = static_cast<const uint8_t *>(aValue);
+    uint8_t checksumBytes[2];
+    uint8_t oldByte;
+    uint32_t sum;
 
-        aLength -= bytesToCover;
-        bytesCovered += bytesToCover;
+    VerifyOrExit(aChecksumOffset + sizeof(checksumBytes) <= GetLength() &&
+                 aFieldOffset + aLength <= GetLength(), error = kThreadError_InvalidArgs);
 
-        aOffset = 0;
-    }
-    else
-    {
-        aOffset -= kHeadBufferDataSize;
-    }
+    Read(aChecksumOffset, sizeof(checksumBytes), checksumBytes);
 
-    // advance to offset
-    curBuffer = GetNextBuffer();
+    // RFC 1624: HC' = ~(~HC + ~m + m'), folded byte-wise so fields at odd offsets
+    // contribute with the correct ones-complement word weight
+    sum = static_cast<uint16_t>(~((checksumBytes[0] << 8) | checksumBytes[1]));
 
-    while (aOffset >= kBufferDataSize)
+    for (uint16_t i = 0; i < aLength; i++)
     {
-        assert(curBuffer != NULL);
+        uint8_t shift = ((((aFieldOffset + i) ^ aChecksumOffset) & 1) == 0) ? 8 : 0;
 
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
+        Read(aFieldOffset + i, sizeof(oldByte), &oldByte);
+        sum += static_cast<uint16_t>(~(oldByte << shift));
+        sum += static_cast<uint16_t>(newBytes[i] << shift);
     }
 
-    // begin copy
-    while (aLength > 0)
+    while (sum >> 16)
     {
-        assert(curBuffer != NULL);
-
-        bytesToCover = kBufferDataSize - aOffset;
-
-        if (bytesToCover > aLength)
-        {
-            bytesToCover = aLength;
-        }
-
-        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, curBuffer->GetData() + aOffset, bytesToCover);
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
 
-        aLength -= bytesToCover;
-        bytesCovered += bytesToCover;
+    sum = ~sum & 0xffff;
+    checksumBytes[0] = static_cast<uint8_t>(sum >> 8);
+    checksumBytes[1] = static_cast<uint8_t>(sum);
 
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
-    }
+    Write(aChecksumOffset, sizeof(checksumBytes), checksumBytes);
+    Write(aFieldOffset, aLength, aValue);
 
-    return aChecksum;
+exit:
+    return error;
 }
 
 uint16_t Message::GetReserved(void) const
@@ -647,6 +1476,7 @@ MessageQueue::MessageQueue(void)
 {
     mInterface.mHead = NULL;
     mInterface.mTail = NULL;
+    mDepth = 0;
 }
 
 ThreadError MessageQueue::AddToList(uint8_t aList, Message &aMessage)
@@ -664,12 +1494,41 @@ ThreadError MessageQueue::AddToList(uint8_t aList, Message &aMessage)
         list->mHead = &aMessage;
         list->mTail = &aMessage;
     }
-    else
+    else if (list->mTail->GetPriority() >= aMessage.GetPriority())
     {
         list->mTail->GetMessageList(aList).mNext = &aMessage;
         aMessage.GetMessageList(aList).mPrev = list->mTail;
         list->mTail = &aMessage;
     }
+    else
+    {
+        Message *cur;
+        Message *prev;
+
+        // keep the list ordered by priority, preserving FIFO order within each priority level
+        for (cur = list->mHead; cur != NULL; cur = cur->GetMessageList(aList).mNext)
+        {
+            if (cur->GetPriority() < aMessage.GetPriority())
+            {
+                break;
+            }
+        }
+
+        prev = cur->GetMessageList(aList).mPrev;
+
+        aMessage.GetMessageList(aList).mNext = cur;
+        aMessage.GetMessageList(aList).mPrev = prev;
+        cur->GetMessageList(aList).mPrev = &aMessage;
+
+        if (prev != NULL)
+        {
+            prev->GetMessageList(aList).mNext = &aMessage;
+        }
+        else
+        {
+            list->mHead = &aMessage;
+        }
+    }
 
     return kThreadError_None;
 }
@@ -721,6 +1580,7 @@ ThreadError MessageQueue::Enqueue(Message &aMessage)
     aMessage.GetMessageList(MessageInfo::kListInterface).mList = &mInterface;
     AddToList(MessageInfo::kListAll, aMessage);
     AddToList(MessageInfo::kListInterface, aMessage);
+    mDepth++;
     return kThreadError_None;
 }
 
@@ -730,6 +1590,7 @@ ThreadError MessageQueue::Dequeue(Message &aMessage)
     RemoveFromList(MessageInfo::kListInterface, aMessage);
     aMessage.GetMessageList(MessageInfo::kListAll).mList = NULL;
     aMessage.GetMessageList(MessageInfo::kListInterface).mList = NULL;
+    mDepth--;
     return kThreadError_None;
 }
 
@@ -58,10 +58,17 @@ enum
 {
     kNumBuffers = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS,
     kBufferSize = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
+    kNumBuffersSmall = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL,
+    kBufferSizeSmall = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_SMALL,
+    kNumBuffersLarge = OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE,
+    kBufferSizeLarge = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_LARGE,
+    kNumReservedPriorityBuffers = OPENTHREAD_CONFIG_NUM_RESERVED_PRIORITY_BUFFERS,
+    kNumReservedReceiveBuffers = OPENTHREAD_CONFIG_NUM_RESERVED_RECEIVE_BUFFERS,
 };
 
 class Message;
 class MessagePool;
+class Neighbor;
 
 /**
  * This structure contains pointers to the head and tail of a Message list.
@@ -85,12 +92,15 @@ struct MessageListEntry
 };
 
 /**
- * This structure contains a pointer to the next Message buffer.
+ * This structure contains a pointer to the next Message buffer and the data capacity of this buffer.
  *
  */
 struct BufferHeader
 {
-    class Buffer *mNext;  ///< A pointer to the next Message buffer.
+    class Buffer *mNext;      ///< A pointer to the next Message buffer.
+    uint16_t      mDataSize;  ///< The number of data bytes this buffer can hold.
+    uint8_t       mClass;     ///< The buffer size class this buffer belongs to.
+    uint8_t       mRefCount;  ///< The number of messages sharing this buffer.
 };
 
 /**
@@ -110,13 +120,22 @@ struct MessageInfo
     uint16_t         mLength;            ///< Number of bytes within the message.
     uint16_t         mOffset;            ///< A byte offset within the message.
     uint16_t         mDatagramTag;       ///< The datagram tag used for 6LoWPAN fragmentation.
+    uint8_t          mReassemblyHash;    ///< Hash of (source address, datagram tag) used for reassembly matching.
+    uint8_t          mFragmentGap;       ///< Largest observed gap between fragment arrivals (seconds).
+    uint16_t         mFragmentRunStart;  ///< Start of the buffered out-of-order fragment run (byte offset).
+    uint16_t         mFragmentRunEnd;    ///< End of the buffered out-of-order fragment run (0 = no run).
 
     uint8_t          mChildMask[8];      ///< A bit-vector to indicate which sleepy children need to receive this.
     uint16_t         mPanId;             ///< The Destination PAN ID.
     uint8_t          mTimeout;           ///< Seconds remaining before dropping the message.
     int8_t           mInterfaceId;       ///< The interface ID.
+    uint32_t         mRxTimestamp;       ///< Receive timestamp of the frame that carried this message (0 = none).
+    class Neighbor  *mNeighbor;          ///< The resolved next-hop neighbor, cached across fragments (NULL = none).
 
     uint8_t          mType : 2;          ///< Identifies the type of message.
+    uint8_t          mPriority : 2;      ///< Identifies the priority level of the message.
+    uint8_t          mDirection : 1;     ///< Identifies the direction (send or receive) of the message.
+    uint8_t          mOwner : 3;         ///< Identifies the subsystem that owns the message.
     bool             mDirectTx : 1;      ///< Used to indicate whether a direct transmission is required.
     bool             mLinkSecurity : 1;  ///< Indicates whether or not link security is enabled.
     bool             mMleDiscoverRequest : 1;   ///< Identifies MLE Discover Request.
@@ -147,14 +166,85 @@ public:
      */
     void SetNextBuffer(class Buffer *buf) { mHeader.mNext = buf; }
 
+    /**
+     * This method returns the number of data bytes this buffer can hold.
+     *
+     * @returns The data capacity of this buffer in bytes.
+     *
+     */
+    uint16_t GetDataSize(void) const { return mHeader.mDataSize; }
+
+    /**
+     * This method sets the number of data bytes this buffer can hold.
+     *
+     * @param[in]  aDataSize  The data capacity of this buffer in bytes.
+     *
+     */
+    void SetDataSize(uint16_t aDataSize) { mHeader.mDataSize = aDataSize; }
+
+    /**
+     * This method returns the buffer size class this buffer belongs to.
+     *
+     * @returns The buffer size class.
+     *
+     */
+    uint8_t GetClass(void) const { return mHeader.mClass; }
+
+    /**
+     * This method sets the buffer size class this buffer belongs to.
+     *
+     * @param[in]  aClass  The buffer size class.
+     *
+     */
+    void SetClass(uint8_t aClass) { mHeader.mClass = aClass; }
+
+    /**
+     * This method returns the number of messages sharing this buffer.
+     *
+     * @returns The reference count of this buffer.
+     *
+     */
+    uint8_t GetRefCount(void) const { return mHeader.mRefCount; }
+
+    /**
+     * This method sets the number of messages sharing this buffer.
+     *
+     * @param[in]  aRefCount  The reference count of this buffer.
+     *
+     */
+    void SetRefCount(uint8_t aRefCount) { mHeader.mRefCount = aRefCount; }
+
+    /**
+     * This method increments the reference count of this buffer.
+     *
+     */
+    void IncrementRefCount(void) { mHeader.mRefCount++; }
+
+    /**
+     * This method decrements the reference count of this buffer.
+     *
+     */
+    void DecrementRefCount(void) { mHeader.mRefCount--; }
+
 private:
+    /**
+     * This method returns the number of head data bytes this buffer can hold when used as the first buffer
+     * of a message.
+     *
+     * @returns The head data capacity of this buffer in bytes.
+     *
+     */
+    uint16_t GetHeadDataSize(void) const { return GetDataSize() - sizeof(struct MessageInfo); }
+
     /**
      * This method returns a pointer to the first byte of data in the first message buffer.
      *
      * @returns A pointer to the first data byte.
      *
      */
-    uint8_t *GetFirstData(void) { return mHeadData; }
+    uint8_t *GetFirstData(void) {
+        return reinterpret_cast<uint8_t *>(this) + sizeof(mHeader) + sizeof(struct MessageInfo);
+    }
 
     /**
      * This method returns a pointer to the first byte of data in the first message buffer.
@@ -162,7 +252,9 @@ private:
      * @returns A pointer to the first data byte.
      *
      */
-    const uint8_t *GetFirstData(void) const { return mHeadData; }
+    const uint8_t *GetFirstData(void) const {
+        return reinterpret_cast<const uint8_t *>(this) + sizeof(mHeader) + sizeof(struct MessageInfo);
+    }
 
     /**
      * This method returns a pointer to the first data byte of a subsequent message buffer.
@@ -170,7 +262,7 @@ private:
      * @returns A pointer to the first data byte.
      *
      */
-    uint8_t *GetData(void) { return mData; }
+    uint8_t *GetData(void) { return reinterpret_cast<uint8_t *>(this) + sizeof(mHeader); }
 
     /**
      * This method returns a pointer to the first data byte of a subsequent message buffer.
@@ -178,7 +270,7 @@ private:
      * @returns A pointer to the first data byte.
      *
      */
-    const uint8_t *GetData(void) const { return mData; }
+    const uint8_t *GetData(void) const { return reinterpret_cast<const uint8_t *>(this) + sizeof(mHeader); }
 
     enum
     {
@@ -215,12 +307,46 @@ public:
         kTypeMacDataPoll = 2,   ///< A MAC data poll message
     };
 
+    enum
+    {
+        kPriorityNormal  = 0,   ///< Normal priority (application data).
+        kPriorityHigh    = 1,   ///< High priority (network-maintenance control traffic).
+    };
+
+    enum
+    {
+        kDirectionTx     = 0,   ///< The message holds locally generated traffic to transmit.
+        kDirectionRx     = 1,   ///< The message holds received traffic being processed.
+        kNumDirections   = 2,   ///< The number of message directions.
+    };
+
+    enum
+    {
+        kOwnerUnknown    = kBufferOwnerUnknown,  ///< Not claimed by a subsystem.
+        kOwnerMle        = kBufferOwnerMle,      ///< MLE messages.
+        kOwnerIp6        = kBufferOwnerIp6,      ///< IPv6 datagrams.
+        kOwnerLowpan     = kBufferOwnerLowpan,   ///< 6LoWPAN reassembly.
+        kOwnerCoap       = kBufferOwnerCoap,     ///< CoAP messages.
+        kOwnerNcp        = kBufferOwnerNcp,      ///< NCP messages.
+        kNumOwners       = kNumBufferOwners,     ///< The number of buffer owners.
+    };
+
     /**
      * This method frees this message buffer.
      *
      */
     ThreadError Free(void);
 
+    /**
+     * This method creates a copy of this message that shares the payload buffers beyond the first
+     * buffer with this message. Shared buffers are copied lazily when either message writes to or
+     * resizes the shared region (clone-on-write).
+     *
+     * @returns A pointer to the cloned message or NULL if insufficient message buffers are available.
+     *
+     */
+    Message *Clone(void) const;
+
     /**
      * This method returns a pointer to the next message in the same interface list.
      *
@@ -248,6 +374,26 @@ public:
      */
     ThreadError SetLength(uint16_t aLength);
 
+    /**
+     * This method returns the number of buffers in the message chain, including the head buffer.
+     *
+     * @returns The number of buffers in the message.
+     *
+     */
+    uint16_t GetBufferCount(void) const;
+
+    /**
+     * This method estimates the number of buffers a message of a given length would occupy.
+     *
+     * The estimate assumes normal-size buffers; the allocator may chain smaller or larger classes.
+     *
+     * @param[in]  aLength  The number of message bytes.
+     *
+     * @returns The estimated number of buffers, including the head buffer.
+     *
+     */
+    static uint16_t EstimateBufferCount(uint16_t aLength);
+
     /**
      * This method returns the byte offset within the message.
      *
@@ -286,11 +432,97 @@ public:
      */
     uint8_t GetType(void) const;
 
+    /**
+     * This method returns the priority level of the message.
+     *
+     * @returns The priority level of the message.
+     *
+     */
+    uint8_t GetPriority(void) const;
+
+    /**
+     * This method sets the priority level of the message.
+     *
+     * High priority messages are queued ahead of normal priority messages and may allocate from the
+     * buffers reserved for control traffic.
+     *
+     * @param[in]  aPriority  The priority level of the message.
+     *
+     */
+    void SetPriority(uint8_t aPriority);
+
+    /**
+     * This method returns the direction (send or receive) of the message.
+     *
+     * The direction is fixed when the message is allocated; the message buffers it holds are
+     * accounted against the corresponding pool quota.
+     *
+     * @returns The direction of the message.
+     *
+     */
+    uint8_t GetDirection(void) const;
+
+    /**
+     * This method returns the receive timestamp of the frame that carried this message.
+     *
+     * @returns The receive timestamp in milliseconds on the platform alarm clock, or 0 if the
+     *          message was not received over the air.
+     *
+     */
+    uint32_t GetRxTimestamp(void) const { return mInfo.mRxTimestamp; }
+
+    /**
+     * This method sets the receive timestamp of the frame that carried this message.
+     *
+     * @param[in]  aTimestamp  The receive timestamp in milliseconds on the platform alarm clock.
+     *
+     */
+    void SetRxTimestamp(uint32_t aTimestamp) { mInfo.mRxTimestamp = aTimestamp; }
+
+    /**
+     * This method returns the next-hop neighbor resolved for an earlier fragment of this message.
+     *
+     * The caller must verify that the neighbor is still valid before using it.
+     *
+     * @returns A pointer to the cached neighbor, or NULL if no neighbor has been resolved.
+     *
+     */
+    Neighbor *GetNeighbor(void) const { return mInfo.mNeighbor; }
+
+    /**
+     * This method caches the resolved next-hop neighbor on the message.
+     *
+     * @param[in]  aNeighbor  A pointer to the resolved neighbor.
+     *
+     */
+    void SetNeighbor(Neighbor *aNeighbor) { mInfo.mNeighbor = aNeighbor; }
+
+    /**
+     * This method returns the subsystem that owns the message.
+     *
+     * @returns The owner of the message.
+     *
+     */
+    uint8_t GetOwner(void) const;
+
+    /**
+     * This method sets the subsystem that owns the message, moving the buffer accounting for all
+     * buffers held by this message from the previous owner to @p aOwner.
+     *
+     * @param[in]  aOwner  The owner of the message.
+     *
+     */
+    void SetOwner(uint8_t aOwner);
+
     /**
      * This method prepends bytes to the front of the message.
      *
      * On success, this method grows the message by @p aLength bytes.
      *
+     * Prepending only consumes headroom reserved when the message was allocated and never moves
+     * message data, so callers of MessagePool::New() must reserve enough space for every header
+     * that lower layers will prepend.
+     *
      * @param[in]  aBuf     A pointer to a data buffer.
      * @param[in]  aLength  The number of bytes to prepend.
      *
@@ -314,6 +546,22 @@ public:
      */
     ThreadError Append(const void *aBuf, uint16_t aLength);
 
+    /**
+     * This method appends a set of scattered segments to the end of the message.
+     *
+     * The message grows once by the combined segment length, so the buffer reservation is a
+     * single pass regardless of the number of segments.
+     *
+     * @param[in]  aIovec  A pointer to an array of segment descriptors.
+     * @param[in]  aCount  The number of segments in @p aIovec.
+     *
+     * @retval kThreadError_None         Successfully appended the segments.
+     * @retval kThreadError_InvalidArgs  The combined segment length overflows the message length.
+     * @retval kThreadError_NoBufs       Insufficient available buffers to grow the message.
+     *
+     */
+    ThreadError AppendIovec(const otMessageIovec *aIovec, uint8_t aCount);
+
     /**
      * This method reads bytes from the message.
      *
@@ -338,6 +586,147 @@ public:
      */
     int Write(uint16_t aOffset, uint16_t aLength, const void *aBuf);
 
+    /**
+     * This method returns a pointer to the message bytes at @p aOffset when the requested range lies
+     * within a single message buffer, allowing callers to avoid a copy through a stack temporary.
+     *
+     * @param[in]  aOffset  Byte offset within the message of the start of the range.
+     * @param[in]  aLength  Number of bytes in the range.
+     *
+     * @returns A pointer to the first byte of the range, or NULL if the range spans multiple message
+     *          buffers or is not within the message.
+     *
+     */
+    uint8_t *GetContiguousData(uint16_t aOffset, uint16_t aLength);
+
+    /**
+     * This method returns a pointer to the message bytes at @p aOffset when the requested range lies
+     * within a single message buffer, allowing callers to avoid a copy through a stack temporary.
+     *
+     * @param[in]  aOffset  Byte offset within the message of the start of the range.
+     * @param[in]  aLength  Number of bytes in the range.
+     *
+     * @returns A pointer to the first byte of the range, or NULL if the range spans multiple message
+     *          buffers or is not within the message.
+     *
+     */
+    const uint8_t *GetContiguousData(uint16_t aOffset, uint16_t aLength) const;
+
+    /**
+     * This method returns a pointer to the message bytes at @p aOffset and the number of bytes that
+     * follow it within the same message buffer, allowing callers to process the message contents one
+     * buffer at a time without copying through a stack temporary.
+     *
+     * @param[in]   aOffset       Byte offset within the message of the start of the chunk.
+     * @param[out]  aChunkLength  The number of contiguous bytes available at the returned pointer.
+     *
+     * @returns A pointer to the first byte of the chunk, or NULL if @p aOffset is not within the message.
+     *
+     */
+    uint8_t *GetChunk(uint16_t aOffset, uint16_t &aChunkLength);
+
+    /**
+     * This is the read-only variant of `GetChunk()`.  Unlike the non-const variant, shared buffers
+     * are left in place since the caller may not modify the returned bytes.
+     *
+     * @param[in]   aOffset       Byte offset within the message of the start of the chunk.
+     * @param[out]  aChunkLength  The number of contiguous bytes available at the returned pointer.
+     *
+     * @returns A pointer to the first byte of the chunk, or NULL if @p aOffset is not within the message.
+     *
+     */
+    const uint8_t *GetChunk(uint16_t aOffset, uint16_t &aChunkLength) const;
+
+    /**
+     * This class iterates over the contiguous byte runs of a message range.
+     *
+     * Unlike repeated `GetChunk()` or `Read()` calls with an advancing offset, which re-walk the
+     * buffer chain from the head on every call, the iterator holds its position between steps so
+     * consuming a whole message costs one walk of the chain in total.
+     *
+     */
+    class ChunkIterator
+    {
+    public:
+        /**
+         * This constructor initializes the iterator to an empty range.
+         *
+         */
+        ChunkIterator(void): mBuffer(NULL), mData(NULL), mChunkLength(0), mRemaining(0) {}
+
+        /**
+         * This method positions the iterator at the start of a read-only message range.
+         *
+         * The range is clamped to the message length. The iterator remains valid only while the
+         * message contents are not modified.
+         *
+         * @param[in]  aMessage  The message to iterate over.
+         * @param[in]  aOffset   Byte offset within the message of the start of the range.
+         * @param[in]  aLength   Number of bytes in the range.
+         *
+         */
+        void Init(const Message &aMessage, uint16_t aOffset, uint16_t aLength);
+
+        /**
+         * This method positions the iterator at the start of a writable message range.
+         *
+         * Shared buffers are copied first (clone-on-write) so the runs handed out by
+         * `GetNextChunk()` may be modified in place.
+         *
+         * @param[in]  aMessage  The message to iterate over.
+         * @param[in]  aOffset   Byte offset within the message of the start of the range.
+         * @param[in]  aLength   Number of bytes in the range.
+         *
+         * @retval kThreadError_None    Successfully positioned the iterator.
+         * @retval kThreadError_NoBufs  Insufficient buffers to make the message exclusively owned.
+         *
+         */
+        ThreadError Init(Message &aMessage, uint16_t aOffset, uint16_t aLength);
+
+        /**
+         * This method yields the next contiguous run of bytes and advances past it.
+         *
+         * @param[out]  aData         A reference to output the start of the run.
+         * @param[out]  aChunkLength  A reference to output the number of bytes in the run.
+         *
+         * @retval TRUE   A run was output.
+         * @retval FALSE  The range is exhausted.
+         *
+         */
+        bool GetNextChunk(const uint8_t *&aData, uint16_t &aChunkLength);
+
+        /**
+         * This is the writable variant of `GetNextChunk()`. It may only be used after the iterator
+         * was positioned with the writable `Init()` overload.
+         *
+         * @param[out]  aData         A reference to output the start of the run.
+         * @param[out]  aChunkLength  A reference to output the number of bytes in the run.
+         *
+         * @retval TRUE   A run was output.
+         * @retval FALSE  The range is exhausted.
+         *
+         */
+        bool GetNextChunk(uint8_t *&aData, uint16_t &aChunkLength);
+
+        /**
+         * This method copies bytes out of the range and advances, possibly mid-run, so callers
+         * pulling arbitrary lengths do not pay a chain walk per call.
+         *
+         * @param[in]  aLength  Number of bytes to copy.
+         * @param[in]  aBuf     A pointer to a data buffer.
+         *
+         * @returns The number of bytes copied, limited by the bytes left in the range.
+         *
+         */
+        uint16_t Read(uint16_t aLength, void *aBuf);
+
+    private:
+        const Buffer *mBuffer;       ///< The buffer holding the run after the current one.
+        const uint8_t *mData;        ///< The start of the current run.
+        uint16_t mChunkLength;       ///< The number of bytes left in the current run.
+        uint16_t mRemaining;         ///< The number of bytes left in the range, including the current run.
+    };
+
     /**
      * This method copies bytes from one message to another.
      *
@@ -367,6 +756,63 @@ public:
      */
     void SetDatagramTag(uint16_t aTag);
 
+    /**
+     * This method returns the hash of (source address, datagram tag) used for 6LoWPAN reassembly matching.
+     *
+     * @returns The reassembly hash.
+     *
+     */
+    uint8_t GetReassemblyHash(void) const;
+
+    /**
+     * This method sets the hash of (source address, datagram tag) used for 6LoWPAN reassembly matching.
+     *
+     * @param[in]  aHash  The reassembly hash.
+     *
+     */
+    void SetReassemblyHash(uint8_t aHash);
+
+    /**
+     * This method returns the largest observed gap between fragment arrivals during 6LoWPAN reassembly.
+     *
+     * @returns The largest observed inter-fragment gap in seconds.
+     *
+     */
+    uint8_t GetFragmentGap(void) const;
+
+    /**
+     * This method sets the largest observed gap between fragment arrivals during 6LoWPAN reassembly.
+     *
+     * @param[in]  aFragmentGap  The largest observed inter-fragment gap in seconds.
+     *
+     */
+    void SetFragmentGap(uint8_t aFragmentGap);
+
+    /**
+     * This method returns the start offset of the buffered out-of-order fragment run.
+     *
+     * @returns The byte offset where the buffered run begins.
+     *
+     */
+    uint16_t GetFragmentRunStart(void) const;
+
+    /**
+     * This method returns the end offset of the buffered out-of-order fragment run.
+     *
+     * @returns The byte offset just past the buffered run, or 0 when no run is buffered.
+     *
+     */
+    uint16_t GetFragmentRunEnd(void) const;
+
+    /**
+     * This method records the extent of the buffered out-of-order fragment run.
+     *
+     * @param[in]  aStart  The byte offset where the run begins.
+     * @param[in]  aEnd    The byte offset just past the run, or 0 to clear the run.
+     *
+     */
+    void SetFragmentRun(uint16_t aStart, uint16_t aEnd);
+
     /**
      * This method returns whether or not the message forwarding is scheduled for the child.
      *
@@ -552,11 +998,51 @@ public:
      */
     uint16_t UpdateChecksum(uint16_t aChecksum, uint16_t aOffset, uint16_t aLength) const;
 
+    /**
+     * This method rewrites a field covered by an Internet checksum and patches the stored
+     * checksum incrementally (RFC 1624), avoiding a full checksum walk over the message.
+     *
+     * The checksum field is assumed to be 16-bit aligned within the checksum coverage; the
+     * rewritten field may start at any offset.
+     *
+     * @param[in]  aChecksumOffset  Byte offset of the 16-bit checksum field within the message.
+     * @param[in]  aFieldOffset     Byte offset of the field being rewritten.
+     * @param[in]  aLength          Number of bytes being rewritten.
+     * @param[in]  aValue           A pointer to the new field value.
+     *
+     * @retval kThreadError_None         Successfully rewrote the field and patched the checksum.
+     * @retval kThreadError_InvalidArgs  The checksum or field range extends beyond the message.
+     *
+     */
+    ThreadError PatchChecksum(uint16_t aChecksumOffset, uint16_t aFieldOffset, uint16_t aLength, const void *aValue);
+
 private:
     MessagePool *GetMessagePool(void) { return mInfo.mMessagePool; }
 
+    MessagePool *GetMessagePool(void) const { return mInfo.mMessagePool; }
+
     void SetMessagePool(MessagePool *aMessagePool) { mInfo.mMessagePool = aMessagePool; }
 
+    void SetDirection(uint8_t aDirection) { mInfo.mDirection = aDirection; }
+
+    /**
+     * This method indicates whether or not any buffer in this message is shared with another message.
+     *
+     * @retval TRUE   If at least one buffer is shared.
+     * @retval FALSE  If no buffers are shared.
+     *
+     */
+    bool HasSharedBuffers(void) const;
+
+    /**
+     * This method replaces any shared buffers in this message with exclusively owned copies.
+     *
+     * @retval kThreadError_None    Successfully unshared all buffers.
+     * @retval kThreadError_NoBufs  Insufficient available buffers to copy the shared buffers.
+     *
+     */
+    ThreadError EnsureExclusive(void);
+
     /**
      * This method returns a reference to a message list.
      *
@@ -656,6 +1142,14 @@ public:
      */
     ThreadError Dequeue(Message &aMessage);
 
+    /**
+     * This method returns the number of messages currently in the queue.
+     *
+     * @returns The number of enqueued messages.
+     *
+     */
+    uint16_t GetDepth(void) const { return mDepth; }
+
 private:
     /**
      * This static method adds a message to a list.
@@ -682,6 +1176,7 @@ private:
     static ThreadError RemoveFromList(uint8_t aListId, Message &aMessage);
 
     MessageList mInterface;   ///< The instance-specific message list.
+    uint16_t mDepth;          ///< The number of enqueued messages.
 };
 
 class MessagePool
@@ -690,6 +1185,15 @@ class MessagePool
     friend class MessageQueue;
 
 public:
+    /**
+     * This function pointer is called when the pool enters or leaves the congested state.
+     *
+     * @param[in]  aCongested  TRUE when free buffers dropped below the congestion watermark, FALSE on recovery.
+     * @param[in]  aContext    A pointer to application-specific context.
+     *
+     */
+    typedef void (*CongestionCallback)(bool aCongested, void *aContext);
+
     /**
      * This constructor initializes the object.
      *
@@ -701,11 +1205,68 @@ public:
      *
      * @param[in]  aType           The message type.
      * @param[in]  aReserveHeader  The number of header bytes to reserve.
+     * @param[in]  aPriority       The priority level of the message; high priority messages may use
+     *                             the buffer quota held in reserve for control traffic.
+     * @param[in]  aDirection      The direction of the message; receive messages may use the
+     *                             emergency receive reserve that send messages may not.
      *
      * @returns A pointer to the message or NULL if no message buffers are available.
      *
      */
-    Message *New(uint8_t aType, uint16_t aReserveHeader);
+    Message *New(uint8_t aType, uint16_t aReserveHeader, uint8_t aPriority = Message::kPriorityNormal,
+                 uint8_t aDirection = Message::kDirectionTx);
+
+    /**
+     * This method returns the number of free message buffers.
+     *
+     * @returns The number of free message buffers.
+     *
+     */
+    int GetFreeBufferCount(void) const { return mNumFreeBuffers; }
+
+    /**
+     * This method returns current and high-watermark message buffer usage per owning subsystem.
+     *
+     * @param[out]  aBufferInfo  A reference to the structure to fill in.
+     *
+     */
+    void GetInfo(otBufferInfo &aBufferInfo) const;
+
+    /**
+     * This method indicates whether the pool is currently congested.
+     *
+     * @returns TRUE if free buffers are below the congestion watermark, FALSE otherwise.
+     *
+     */
+    bool IsCongested(void) const { return mCongested; }
+
+    /**
+     * This method registers a callback that is invoked when the pool enters or leaves the congested state.
+     *
+     * @param[in]  aCallback  A pointer to a function that is called on congestion state changes.
+     * @param[in]  aContext   A pointer to application-specific context.
+     *
+     */
+    void SetCongestionCallback(CongestionCallback aCallback, void *aContext);
+
+    /**
+     * This method rebalances the send/receive buffer partition.
+     *
+     * Buffers held by send messages are capped at @p aSendQuota and buffers held by receive
+     * messages at @p aReceiveQuota, so neither direction can consume the whole pool. The quotas
+     * may overlap (their sum may exceed the pool size); lowering a quota below current usage
+     * blocks new allocations in that direction until enough buffers drain. Routers typically
+     * grant the receive side a larger share than sleepy end devices.
+     *
+     * @param[in]  aSendQuota     The maximum number of buffers send messages may hold.
+     * @param[in]  aReceiveQuota  The maximum number of buffers receive messages may hold.
+     *
+     * @retval kThreadError_None         Successfully updated the partition.
+     * @retval kThreadError_InvalidArgs  A quota was zero, exceeded the pool size, or left less
+     *                                   than the emergency receive reserve available.
+     *
+     */
+    ThreadError SetBufferPartition(uint16_t aSendQuota, uint16_t aReceiveQuota);
 
     /**
      * This method is used to free a message and return all message buffers to the buffer pool.
@@ -719,13 +1280,80 @@ public:
     ThreadError Free(Message *aMessage);
 
 private:
-    Buffer *NewBuffer(void);
-    ThreadError FreeBuffers(Buffer *aBuffer);
-    ThreadError ReclaimBuffers(int aNumBuffers);
+    enum
+    {
+        kClassSmall  = 0,  ///< Identifies the small buffer class.
+        kClassNormal = 1,  ///< Identifies the normal buffer class.
+        kClassLarge  = 2,  ///< Identifies the large buffer class.
+        kNumClasses  = 3,  ///< The number of buffer classes, ordered by increasing size.
+    };
+
+    enum
+    {
+        kTotalBuffers = kNumBuffersSmall + kNumBuffers + kNumBuffersLarge,
+
+        /**
+         * Free buffers dropping below this watermark signals congestion; recovery requires climbing
+         * back above kCongestionClearThreshold so that the callback does not chatter near the boundary.
+         *
+         */
+        kCongestionSetThreshold   = kTotalBuffers / 8,
+        kCongestionClearThreshold = kTotalBuffers / 4,
+    };
+
+    /**
+     * This structure contains the free list state for one buffer size class.
+     *
+     */
+    struct BufferClass
+    {
+        Buffer  *mFreeBuffers;     ///< A pointer to the first free buffer in this class.
+        int      mNumFreeBuffers;  ///< The number of free buffers in this class.
+        uint16_t mDataSize;        ///< The number of data bytes a buffer of this class can hold.
+    };
+
+    /**
+     * This structure provides storage for a small message buffer.
+     *
+     */
+    struct SmallBuffer
+    {
+        struct BufferHeader mHeader;
+        uint8_t mData[kBufferSizeSmall - sizeof(struct BufferHeader)];
+    };
+
+    /**
+     * This structure provides storage for a large message buffer.
+     *
+     */
+    struct LargeBuffer
+    {
+        struct BufferHeader mHeader;
+        uint8_t mData[kBufferSizeLarge - sizeof(struct BufferHeader)];
+    };
 
+    Buffer *NewBuffer(uint16_t aSizeHint, uint8_t aPriority, uint8_t aOwner, uint8_t aDirection);
+    Buffer *NewBufferFromClass(uint8_t aClass, uint8_t aPriority, uint8_t aOwner, uint8_t aDirection);
+    bool CanAllocate(uint8_t aPriority, uint8_t aDirection) const;
+    ThreadError FreeBuffers(Buffer *aBuffer, uint8_t aOwner, uint8_t aDirection);
+    ThreadError ReclaimBuffers(int aNumBuffers, uint8_t aPriority, uint8_t aDirection);
+    void InitBufferClass(uint8_t aClass, void *aStorage, uint16_t aBufferSize, int aNumBuffers);
+    void AdjustOwnerBuffers(uint8_t aOwner, int aDelta);
+    void AdjustDirectionBuffers(uint8_t aDirection, int aDelta);
+    void UpdateCongestionState(void);
+
+    BufferClass mBufferClasses[kNumClasses];
     int mNumFreeBuffers;
+    bool mCongested;
+    CongestionCallback mCongestionCallback;
+    void *mCongestionContext;
+    uint16_t mOwnerBuffers[Message::kNumOwners];
+    uint16_t mOwnerBuffersMax[Message::kNumOwners];
+    uint16_t mDirectionBuffers[Message::kNumDirections];
+    uint16_t mDirectionQuota[Message::kNumDirections];
+    SmallBuffer mSmallBuffers[kNumBuffersSmall];
     Buffer mBuffers[kNumBuffers];
-    Buffer *mFreeBuffers;
+    LargeBuffer mLargeBuffers[kNumBuffersLarge];
     MessageList mAll;
 };
 
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements random number generation.
+ */
+
+#include <string.h>
+
+#include <common/code_utils.hpp>
+#include <common/random.hpp>
+#include <platform/random.h>
+
+namespace Thread {
+namespace Random {
+
+enum
+{
+    kEntropyPoolSize = 32,  ///< Number of bytes fetched from the platform per refill.
+};
+
+static uint32_t sPrngState = 1;
+static uint8_t sEntropyPool[kEntropyPoolSize];
+static uint16_t sEntropyAvailable = 0;
+
+void Init(void)
+{
+    do
+    {
+        sPrngState = otPlatRandomGet();
+    }
+    while (sPrngState == 0);
+
+    sEntropyAvailable = 0;
+}
+
+uint32_t GetUint32(void)
+{
+    uint32_t state = sPrngState;
+
+    // xorshift: full-period and cheap enough for per-frame backoff decisions
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    sPrngState = state;
+
+    return state;
+}
+
+void FillBuffer(uint8_t *aBuffer, uint16_t aLength)
+{
+    uint16_t count;
+
+    while (aLength > 0)
+    {
+        if (sEntropyAvailable == 0)
+        {
+            if (otPlatRandomSecureGet(sizeof(sEntropyPool), sEntropyPool, &sEntropyAvailable) != kThreadError_None ||
+                sEntropyAvailable == 0)
+            {
+                // the platform entropy source is unavailable; fall back to the single-value call
+                for (; aLength > 0; aLength--)
+                {
+                    *aBuffer++ = static_cast<uint8_t>(otPlatRandomGet());
+                }
+
+                ExitNow();
+            }
+        }
+
+        count = (aLength < sEntropyAvailable) ? aLength : sEntropyAvailable;
+        sEntropyAvailable -= count;
+        memcpy(aBuffer, sEntropyPool + sEntropyAvailable, count);
+        aBuffer += count;
+        aLength -= count;
+    }
+
+exit:
+    return;
+}
+
+}  // namespace Random
+}  // namespace Thread
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for random number generation.
+ */
+
+#ifndef RANDOM_HPP_
+#define RANDOM_HPP_
+
+#include <stdint.h>
+
+#include <openthread-types.h>
+
+namespace Thread {
+
+/**
+ * @namespace Thread::Random
+ *
+ * @brief
+ *   This namespace includes functions for random number generation.
+ *
+ * A fast non-cryptographic generator serves backoff, jitter, and sequence number
+ * selection, while challenges, tokens, and interface identifiers draw true entropy
+ * from a pool that is refilled from the platform in bulk.
+ *
+ */
+namespace Random {
+
+/**
+ * This function seeds the non-cryptographic generator from the platform.
+ *
+ * It must be called once before any other function in this namespace.
+ *
+ */
+void Init(void);
+
+/**
+ * This function returns a 32-bit value from the non-cryptographic generator.
+ *
+ * The output is suitable for backoff, jitter, and sequence number selection, but
+ * MUST NOT be used for key material, challenges, or tokens.
+ *
+ * @returns A 32-bit random value.
+ *
+ */
+uint32_t GetUint32(void);
+
+/**
+ * This function fills a buffer with bytes from the true-entropy pool.
+ *
+ * The pool is refilled from the platform in bulk, amortizing the per-byte cost of
+ * the platform entropy source.
+ *
+ * @param[out]  aBuffer  A pointer to the buffer to fill.
+ * @param[in]   aLength  The number of bytes to fill.
+ *
+ */
+void FillBuffer(uint8_t *aBuffer, uint16_t aLength);
+
+}  // namespace Random
+}  // namespace Thread
+
+#endif  // RANDOM_HPP_
@@ -35,14 +35,16 @@
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
 #include <common/tasklet.hpp>
+#include <platform/alarm.h>
 
 namespace Thread {
 
-Tasklet::Tasklet(TaskletScheduler &aScheduler, Handler aHandler, void *aContext):
+Tasklet::Tasklet(TaskletScheduler &aScheduler, Handler aHandler, void *aContext, uint8_t aPriority):
     mScheduler(aScheduler),
     mHandler(aHandler),
     mContext(aContext),
-    mNext(NULL)
+    mNext(NULL),
+    mPriority(aPriority)
 {
 }
 
@@ -52,44 +54,53 @@ ThreadError Tasklet::Post(void)
 }
 
 TaskletScheduler::TaskletScheduler(void):
-    mHead(NULL),
-    mTail(NULL)
+    mHighRunsRemaining(kHighPriorityBudget)
 {
+    for (int i = 0; i < Tasklet::kNumPriorities; i++)
+    {
+        mHeads[i] = NULL;
+        mTails[i] = NULL;
+    }
 }
 
 ThreadError TaskletScheduler::Post(Tasklet &aTasklet)
 {
     ThreadError error = kThreadError_None;
+    uint8_t priority = aTasklet.mPriority;
 
-    VerifyOrExit(mTail != &aTasklet && aTasklet.mNext == NULL, error = kThreadError_Busy);
+    VerifyOrExit(mTails[priority] != &aTasklet && aTasklet.mNext == NULL, error = kThreadError_Busy);
 
-    if (mTail == NULL)
+    if (mTails[priority] == NULL)
     {
-        mHead = &aTasklet;
-        mTail = &aTasklet;
-        otSignalTaskletPending(NULL);
+        mHeads[priority] = &aTasklet;
+        mTails[priority] = &aTasklet;
+
+        if (mTails[!priority] == NULL)
+        {
+            otSignalTaskletPending(NULL);
+        }
     }
     else
     {
-        mTail->mNext = &aTasklet;
-        mTail = &aTasklet;
+        mTails[priority]->mNext = &aTasklet;
+        mTails[priority] = &aTasklet;
     }
 
 exit:
     return error;
 }
 
-Tasklet *TaskletScheduler::PopTasklet(void)
+Tasklet *TaskletScheduler::PopTasklet(uint8_t aPriority)
 {
-    Tasklet *task = mHead;
+    Tasklet *task = mHeads[aPriority];
 
     if (task != NULL)
     {
-        mHead = mHead->mNext;
+        mHeads[aPriority] = task->mNext;
 
-        if (mHead == NULL)
+        if (mHeads[aPriority] == NULL)
         {
-            mTail = NULL;
+            mTails[aPriority] = NULL;
         }
 
         task->mNext = NULL;
@@ -100,18 +111,49 @@ Tasklet *TaskletScheduler::PopTasklet(void)
 
 bool TaskletScheduler::AreTaskletsPending(void)
 {
-    return mHead != NULL;
+    return mHeads[Tasklet::kPriorityHigh] != NULL || mHeads[Tasklet::kPriorityNormal] != NULL;
 }
 
 void TaskletScheduler::RunNextTasklet(void)
 {
-    Tasklet  *task;
+    Tasklet  *task = NULL;
 
-    task = PopTasklet();
+    // run high priority tasklets first, but yield one slot to the normal
+    // queue after each budget of consecutive high priority runs so a steady
+    // stream of high priority work cannot starve it
+    if (mHeads[Tasklet::kPriorityHigh] != NULL &&
+        (mHighRunsRemaining > 0 || mHeads[Tasklet::kPriorityNormal] == NULL))
+    {
+        task = PopTasklet(Tasklet::kPriorityHigh);
+
+        if (mHighRunsRemaining > 0)
+        {
+            mHighRunsRemaining--;
+        }
+    }
+    else
+    {
+        task = PopTasklet(Tasklet::kPriorityNormal);
+        mHighRunsRemaining = kHighPriorityBudget;
+    }
 
     if (task != NULL)
     {
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR || OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+        uint32_t startTime = otPlatAlarmGetNow();
+        uint32_t endTime;
+
+        task->RunTask();
+        endTime = otPlatAlarmGetNow();
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+        RecordHandlerLatency(startTime, endTime, reinterpret_cast<void *>(task->mHandler));
+#endif
+#if OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+        RecordGovernorRunTime(startTime, endTime);
+#endif
+#else
         task->RunTask();
+#endif
     }
 }
 
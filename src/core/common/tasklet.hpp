@@ -35,6 +35,7 @@
 #define TASKLET_HPP_
 
 #include <openthread-types.h>
+#include <openthread-core-config.h>
 
 namespace Thread {
 
@@ -67,15 +68,27 @@ public:
      */
     typedef void (*Handler)(void *aContext);
 
+    /**
+     * Tasklet priority levels.
+     *
+     */
+    enum
+    {
+        kPriorityNormal = 0,  ///< Normal priority level.
+        kPriorityHigh   = 1,  ///< High priority level, for time-critical work such as radio handling.
+        kNumPriorities  = 2,  ///< Number of priority levels.
+    };
+
     /**
      * This constructor creates a tasklet instance.
      *
      * @param[in]  aScheduler  A reference to the tasklet scheduler.
      * @param[in]  aHandler    A pointer to a function that is called when the tasklet is run.
      * @param[in]  aContext    A pointer to arbitrary context information.
+     * @param[in]  aPriority   The priority level for the tasklet.
      *
      */
-    Tasklet(TaskletScheduler &aScheduler, Handler aHandler, void *aContext);
+    Tasklet(TaskletScheduler &aScheduler, Handler aHandler, void *aContext, uint8_t aPriority = kPriorityNormal);
 
     /**
      * This method puts the tasklet on the run queue.
@@ -90,6 +103,7 @@ private:
     Handler           mHandler;
     void             *mContext;
     Tasklet          *mNext;
+    uint8_t           mPriority;
 };
 
 /**
@@ -131,11 +145,82 @@ public:
     void RunNextTasklet(void);
 
 private:
-    Tasklet *PopTasklet(void);
-    Tasklet *mHead;
-    Tasklet *mTail;
+    enum
+    {
+        ///< Maximum consecutive high priority runs before yielding a normal slot.
+        kHighPriorityBudget = OPENTHREAD_CONFIG_TASKLET_HIGH_PRIORITY_WEIGHT,
+    };
+
+    Tasklet *PopTasklet(uint8_t aPriority);
+
+    Tasklet *mHeads[Tasklet::kNumPriorities];
+    Tasklet *mTails[Tasklet::kNumPriorities];
+    uint8_t  mHighRunsRemaining;
 };
 
+/**
+ * The histogram of tasklet and timer handler run times, exposed through otGetHandlerLatencyHistogram().
+ *
+ */
+extern otHandlerLatencyHistogram sHandlerLatencyHistogram;
+
+/**
+ * The flat per-handler execution profile, exposed (sorted) through otGetHandlerProfile().
+ *
+ */
+extern otHandlerProfileEntry sHandlerProfile[OT_HANDLER_PROFILE_NUM_ENTRIES];
+
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+
+/**
+ * This function records a handler run time into the handler latency histogram, and logs the handler
+ * address when the run time reaches OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD.
+ *
+ * @param[in]  aStartTime  The alarm time (in milliseconds) when the handler was invoked.
+ * @param[in]  aEndTime    The alarm time (in milliseconds) when the handler returned.
+ * @param[in]  aHandler    The handler function address, used for threshold logging.
+ *
+ */
+void RecordHandlerLatency(uint32_t aStartTime, uint32_t aEndTime, void *aHandler);
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+
+#if OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
+/**
+ * This function accounts a handler run time against the stack CPU budget window.
+ *
+ * Completed one-second windows adjust the load-shedding level: a window over budget raises the
+ * level one step, a window under three quarters of the budget lowers it one step.
+ *
+ * @param[in]  aStartTime  The alarm time (in milliseconds) when the handler was invoked.
+ * @param[in]  aEndTime    The alarm time (in milliseconds) when the handler returned.
+ *
+ */
+void RecordGovernorRunTime(uint32_t aStartTime, uint32_t aEndTime);
+
+/**
+ * This function returns the current load-shedding level of the CPU budget governor.
+ *
+ * @returns The current load-shedding level (see otCpuGovernorLevel).
+ *
+ */
+uint8_t GetGovernorLevel(void);
+
+/**
+ * This function retrieves the state of the CPU budget governor.
+ *
+ * @param[out]  aState  A reference to where the governor state is placed.
+ *
+ */
+void GetGovernorState(otCpuGovernorState &aState);
+
+#else  // OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
+inline uint8_t GetGovernorLevel(void) { return kCpuGovernorLevelNone; }
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
 /**
  * @}
  *
@@ -31,186 +31,506 @@
  *   This file implements a multiplexed timer service on top of the alarm abstraction.
  */
 
+#include <string.h>
+
+#include <openthread-instance.h>
 #include <common/code_utils.hpp>
+#include <common/logging.hpp>
 #include <common/timer.hpp>
 #include <net/ip6.hpp>
 #include <platform/alarm.h>
 
 namespace Thread {
 
-// FIXME: the otPlatAlarm callback should provide the context
+// fallback for platforms that do not pass the instance to otPlatAlarmFired,
+// and anchor for the context-free Timer::GetNow64()
 static TimerScheduler *sTimerScheduler;
 
+// Defined here (rather than in tasklet.cpp) so the tasklet scheduler is only linked in when used.
+otHandlerLatencyHistogram sHandlerLatencyHistogram;
+otHandlerProfileEntry sHandlerProfile[OT_HANDLER_PROFILE_NUM_ENTRIES];
+
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+
+void RecordHandlerLatency(uint32_t aStartTime, uint32_t aEndTime, void *aHandler)
+{
+    uint32_t runTime = aEndTime - aStartTime;
+    uint32_t elapsed = runTime;
+    uint8_t bucket = 0;
+
+    while (bucket < OT_HANDLER_LATENCY_NUM_BUCKETS - 1 && elapsed != 0)
+    {
+        elapsed >>= 1;
+        bucket++;
+    }
+
+    sHandlerLatencyHistogram.mBuckets[bucket]++;
+
+    // accumulate the flat per-handler profile; handlers are static functions, so
+    // the function address is a stable descriptor that registers on first run
+    for (uint8_t i = 0; i < OT_HANDLER_PROFILE_NUM_ENTRIES; i++)
+    {
+        if (sHandlerProfile[i].mHandler == aHandler || sHandlerProfile[i].mHandler == NULL)
+        {
+            sHandlerProfile[i].mHandler = aHandler;
+            sHandlerProfile[i].mCount++;
+            sHandlerProfile[i].mTotalTime += runTime;
+
+            if (runTime > sHandlerProfile[i].mMaxTime)
+            {
+                sHandlerProfile[i].mMaxTime = runTime;
+            }
+
+            break;
+        }
+    }
+
+    if (runTime >= OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD)
+    {
+        otLogWarnApi("Handler %p ran for %u ms\n", aHandler, static_cast<unsigned>(runTime));
+    }
+}
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+
+#if OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
+static otCpuGovernorState sGovernorState =
+{
+    OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND, 0, 0, kCpuGovernorLevelNone
+};
+static uint32_t sGovernorWindowStart;
+static uint32_t sGovernorWindowTime;
+
+void RecordGovernorRunTime(uint32_t aStartTime, uint32_t aEndTime)
+{
+    enum
+    {
+        kWindowSize = 1000,                                                 ///< Accounting window (milliseconds).
+        kRecoverThreshold = (OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND * 3) / 4,
+    };
+
+    if (aEndTime - sGovernorWindowStart >= kWindowSize)
+    {
+        sGovernorState.mLastWindowTime = sGovernorWindowTime;
+
+        if (sGovernorWindowTime > sGovernorState.mBudget)
+        {
+            sGovernorState.mShedWindows++;
+
+            if (sGovernorState.mLevel < kCpuGovernorLevelDropForwarding)
+            {
+                sGovernorState.mLevel++;
+                otLogWarnApi("CPU governor: %u ms over %u ms budget, shedding at level %u\n",
+                             static_cast<unsigned>(sGovernorWindowTime),
+                             static_cast<unsigned>(sGovernorState.mBudget),
+                             static_cast<unsigned>(sGovernorState.mLevel));
+            }
+        }
+        else if (sGovernorWindowTime < kRecoverThreshold && sGovernorState.mLevel > kCpuGovernorLevelNone)
+        {
+            // recover one level per well-under-budget window so shedding does not oscillate
+            sGovernorState.mLevel--;
+        }
+
+        sGovernorWindowTime = 0;
+        sGovernorWindowStart = aEndTime;
+    }
+
+    sGovernorWindowTime += aEndTime - aStartTime;
+}
+
+uint8_t GetGovernorLevel(void)
+{
+    return sGovernorState.mLevel;
+}
+
+void GetGovernorState(otCpuGovernorState &aState)
+{
+    aState = sGovernorState;
+}
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
 TimerScheduler::TimerScheduler(void):
-    mHead(NULL)
+    mExpired(NULL),
+    mTicks(0),
+    mLastRead(0),
+    mLastTime(0),
+    mNextEvent(0),
+    mNumTimers(0),
+    mInstance(NULL)
 {
+    memset(mBuckets, 0, sizeof(mBuckets));
     sTimerScheduler = this;
 }
 
 void TimerScheduler::Add(Timer &aTimer)
 {
+    uint32_t candidate;
+
     Remove(aTimer);
+    Synchronize();
+    Insert(aTimer);
+    mNumTimers++;
 
-    if (mHead == NULL)
+    // the new timer fires after its remaining time; an expired timer fires on the next pass
+    candidate = (mExpired != NULL) ? mLastTime : mLastTime + GetRemaining(aTimer);
+
+    if (mNumTimers == 1 || (candidate - mLastTime) < (mNextEvent - mLastTime))
     {
-        mHead = &aTimer;
+        mNextEvent = candidate;
         SetAlarm();
     }
-    else
-    {
-        Timer *prev = NULL;
-        Timer *cur;
+}
 
-        for (cur = mHead; cur; cur = cur->mNext)
-        {
-            if (TimerCompare(aTimer, *cur))
-            {
-                if (prev)
-                {
-                    aTimer.mNext = cur;
-                    prev->mNext = &aTimer;
-                }
-                else
-                {
-                    aTimer.mNext = mHead;
-                    mHead = &aTimer;
-                    SetAlarm();
-                }
+void TimerScheduler::Remove(Timer &aTimer)
+{
+    VerifyOrExit(aTimer.mLevel != kLevelNotAdded, ;);
 
-                break;
-            }
+    Detach(aTimer);
+    mNumTimers--;
 
-            prev = cur;
-        }
+exit:
+    {}
+}
+
+bool TimerScheduler::IsAdded(const Timer &aTimer)
+{
+    return aTimer.mLevel != kLevelNotAdded;
+}
+
+void TimerScheduler::FireTimers(void)
+{
+    Timer *timer;
+    uint32_t next;
 
-        if (cur == NULL)
+    Synchronize();
+
+    // fire at most one timer per alarm callback, as handlers may restart timers
+    if ((timer = mExpired) != NULL)
+    {
+        Remove(*timer);
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR || OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
         {
-            prev->mNext = &aTimer;
+            uint32_t startTime = otPlatAlarmGetNow();
+            uint32_t endTime;
+
+            timer->Fired();
+            endTime = otPlatAlarmGetNow();
+#if OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+            RecordHandlerLatency(startTime, endTime, reinterpret_cast<void *>(timer->mHandler));
+#endif
+#if OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+            RecordGovernorRunTime(startTime, endTime);
+#endif
         }
+#else
+        timer->Fired();
+#endif
+    }
+
+    if (mExpired != NULL)
+    {
+        mNextEvent = mLastTime;
+    }
+    else if (GetNextFire(next))
+    {
+        mNextEvent = next;
     }
+
+    SetAlarm();
 }
 
-void TimerScheduler::Remove(Timer &aTimer)
+extern "C" void otPlatAlarmFired(otInstance *aInstance)
 {
-    if (mHead == &aTimer)
+    if (aInstance != NULL)
     {
-        mHead = aTimer.mNext;
-        aTimer.mNext = NULL;
-        SetAlarm();
+        aInstance->mIp6.mTimerScheduler.FireTimers();
     }
     else
     {
-        for (Timer *cur = mHead; cur; cur = cur->mNext)
-        {
-            if (cur->mNext == &aTimer)
-            {
-                cur->mNext = aTimer.mNext;
-                aTimer.mNext = NULL;
-                break;
-            }
-        }
+        sTimerScheduler->FireTimers();
     }
 }
 
-bool TimerScheduler::IsAdded(const Timer &aTimer)
+uint64_t TimerScheduler::UpdateTicks(uint32_t aNow)
 {
-    bool rval = false;
+    mTicks += aNow - mLastRead;
+    mLastRead = aNow;
 
-    for (Timer *cur = mHead; cur; cur = cur->mNext)
+    return mTicks;
+}
+
+uint64_t TimerScheduler::GetNow64(void)
+{
+    return UpdateTicks(otPlatAlarmGetNow());
+}
+
+uint64_t Timer::GetNow64(void)
+{
+    return sTimerScheduler->GetNow64();
+}
+
+uint32_t TimerScheduler::GetRemaining(const Timer &aTimer) const
+{
+    uint32_t elapsed = mLastTime - aTimer.mT0;
+
+    return (elapsed >= aTimer.mDt) ? 0 : aTimer.mDt - elapsed;
+}
+
+void TimerScheduler::Insert(Timer &aTimer)
+{
+    uint32_t remaining = GetRemaining(aTimer);
+    uint8_t level = 0;
+    uint8_t slot;
+    uint32_t target;
+
+    if (remaining == 0)
+    {
+        // already expired: hold it on the expired list so it fires on the next pass
+        PushExpired(aTimer);
+        ExitNow();
+    }
+
+    target = mLastTime + remaining;
+
+    if (target > mLastTime)
     {
-        if (cur == &aTimer)
+        // place the timer at the level of the most significant digit in which
+        // its expiration time differs from the current wheel position
+        uint32_t diff = target ^ mLastTime;
+
+        while (level < kNumLevels - 1 && (diff >> (kBitsPerLevel * (level + 1))) != 0)
         {
-            ExitNow(rval = true);
+            level++;
         }
     }
+    else
+    {
+        // the expiration time wraps the 32-bit clock: park the timer at the
+        // top level until the wheel turns over
+        level = kNumLevels - 1;
+    }
+
+    slot = (target >> (kBitsPerLevel * level)) & kSlotMask;
+
+    aTimer.mNext = mBuckets[level][slot];
+    aTimer.mPrev = NULL;
+
+    if (aTimer.mNext != NULL)
+    {
+        aTimer.mNext->mPrev = &aTimer;
+    }
+
+    mBuckets[level][slot] = &aTimer;
+    aTimer.mLevel = level;
+    aTimer.mSlot = slot;
 
 exit:
-    return rval;
+    {}
 }
 
-void TimerScheduler::SetAlarm(void)
+void TimerScheduler::Detach(Timer &aTimer)
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsed;
-    uint32_t remaining;
-
-    if (mHead == NULL)
+    if (aTimer.mPrev != NULL)
     {
-        otPlatAlarmStop(NULL);
+        aTimer.mPrev->mNext = aTimer.mNext;
+    }
+    else if (aTimer.mLevel == kLevelExpired)
+    {
+        mExpired = aTimer.mNext;
     }
     else
     {
-        elapsed = now - mHead->mT0;
-        remaining = (mHead->mDt > elapsed) ? mHead->mDt - elapsed : 0;
+        mBuckets[aTimer.mLevel][aTimer.mSlot] = aTimer.mNext;
+    }
 
-        otPlatAlarmStartAt(NULL, now, remaining);
+    if (aTimer.mNext != NULL)
+    {
+        aTimer.mNext->mPrev = aTimer.mPrev;
     }
+
+    aTimer.mNext = NULL;
+    aTimer.mPrev = NULL;
+    aTimer.mLevel = kLevelNotAdded;
 }
 
-extern "C" void otPlatAlarmFired(otInstance *)
+void TimerScheduler::PushExpired(Timer &aTimer)
 {
-    sTimerScheduler->FireTimers();
+    aTimer.mNext = mExpired;
+    aTimer.mPrev = NULL;
+
+    if (mExpired != NULL)
+    {
+        mExpired->mPrev = &aTimer;
+    }
+
+    mExpired = &aTimer;
+    aTimer.mLevel = kLevelExpired;
 }
 
-void TimerScheduler::FireTimers(void)
+void TimerScheduler::Synchronize(void)
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsed;
-    Timer *timer = mHead;
+    uint32_t now = Timer::GetNow();
+    uint32_t next;
+
+    // reuse the single platform clock read of this pass to keep the 64-bit tick count current
+    UpdateTicks(now);
 
-    if (timer)
+    if (mNumTimers == 0)
     {
-        elapsed = now - timer->mT0;
+        mLastTime = now;
+        ExitNow();
+    }
 
-        if (elapsed >= timer->mDt)
+    while (mLastTime != now)
+    {
+        // advance the wheel position directly to the next non-empty slot;
+        // every slot in between holds no timers, so skipping it is a no-op
+        if (!GetNextEvent(next) || (next - mLastTime) > (now - mLastTime))
         {
-            Remove(*timer);
-            timer->Fired();
+            mLastTime = now;
+            break;
         }
-        else
+
+        mLastTime = next;
+        Cascade();
+        MoveSlot(now);
+    }
+
+exit:
+    {}
+}
+
+void TimerScheduler::Cascade(void)
+{
+    uint8_t level = 0;
+
+    // find the highest level whose slot boundary is crossed at the current time
+    while (level < kNumLevels - 1 && (mLastTime & ((1U << (kBitsPerLevel * (level + 1))) - 1)) == 0)
+    {
+        level++;
+    }
+
+    // move timers down one level at a time, highest level first
+    for (; level >= 1; level--)
+    {
+        uint8_t slot = (mLastTime >> (kBitsPerLevel * level)) & kSlotMask;
+        Timer *timer = mBuckets[level][slot];
+
+        mBuckets[level][slot] = NULL;
+
+        while (timer != NULL)
+        {
+            Timer *next = timer->mNext;
+
+            timer->mNext = NULL;
+            timer->mPrev = NULL;
+            Insert(*timer);
+
+            timer = next;
+        }
+    }
+}
+
+void TimerScheduler::MoveSlot(uint32_t aNow)
+{
+    Timer *timer = mBuckets[0][mLastTime & kSlotMask];
+
+    while (timer != NULL)
+    {
+        Timer *next = timer->mNext;
+
+        if (aNow - timer->mT0 >= timer->mDt)
         {
-            SetAlarm();
+            Detach(*timer);
+            PushExpired(*timer);
         }
+
+        timer = next;
+    }
+}
+
+void TimerScheduler::SetAlarm(void)
+{
+    if (mNumTimers == 0)
+    {
+        otPlatAlarmStop(mInstance);
     }
     else
     {
-        SetAlarm();
+        otPlatAlarmStartAt(mInstance, mLastTime, mNextEvent - mLastTime);
     }
 }
 
-bool TimerScheduler::TimerCompare(const Timer &aTimerA, const Timer &aTimerB)
+bool TimerScheduler::GetNextEvent(uint32_t &aTime) const
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsedA = now - aTimerA.mT0;
-    uint32_t elapsedB = now - aTimerB.mT0;
-    bool retval = false;
+    bool rval = false;
 
-    if (aTimerA.mDt >= elapsedA && aTimerB.mDt >= elapsedB)
+    // the next event is the first non-empty slot ahead of the current wheel
+    // position; lower levels always act before higher levels, and the top
+    // level wraps around with the 32-bit clock
+    for (uint8_t level = 0; level < kNumLevels; level++)
     {
-        uint32_t remainingA = aTimerA.mDt - elapsedA;
-        uint32_t remainingB = aTimerB.mDt - elapsedB;
+        uint8_t shift = kBitsPerLevel * level;
+        uint8_t cur = (mLastTime >> shift) & kSlotMask;
+        uint8_t count = (level == kNumLevels - 1) ? kSlotsPerLevel : kSlotMask - cur;
 
-        if (remainingA < remainingB)
+        for (uint8_t i = 1; i <= count; i++)
         {
-            retval = true;
+            uint8_t slot = (cur + i) & kSlotMask;
+
+            if (mBuckets[level][slot] != NULL)
+            {
+                aTime = (mLastTime & ~((1U << shift) - 1) & ~(static_cast<uint32_t>(kSlotMask) << shift)) |
+                        (static_cast<uint32_t>(slot) << shift);
+                ExitNow(rval = true);
+            }
         }
     }
-    else if (aTimerA.mDt < elapsedA && aTimerB.mDt >= elapsedB)
-    {
-        retval = true;
-    }
-    else if (aTimerA.mDt < elapsedA && aTimerB.mDt < elapsedB)
+
+exit:
+    return rval;
+}
+
+bool TimerScheduler::GetNextFire(uint32_t &aTime) const
+{
+    bool rval = false;
+
+    // slots are visited in expiration order, so the first non-empty slot
+    // holds the timer that fires next
+    for (uint8_t level = 0; level < kNumLevels; level++)
     {
-        uint32_t expiredByA = elapsedA - aTimerA.mDt;
-        uint32_t expiredByB = elapsedB - aTimerB.mDt;
+        uint8_t shift = kBitsPerLevel * level;
+        uint8_t cur = (mLastTime >> shift) & kSlotMask;
+        uint8_t count = (level == kNumLevels - 1) ? kSlotsPerLevel : kSlotMask - cur;
 
-        if (expiredByB < expiredByA)
+        for (uint8_t i = 1; i <= count; i++)
         {
-            retval = true;
+            uint8_t slot = (cur + i) & kSlotMask;
+            uint32_t remaining = 0xffffffff;
+
+            for (const Timer *timer = mBuckets[level][slot]; timer != NULL; timer = timer->mNext)
+            {
+                uint32_t timerRemaining = GetRemaining(*timer);
+
+                if (timerRemaining < remaining)
+                {
+                    remaining = timerRemaining;
+                }
+            }
+
+            if (remaining != 0xffffffff)
+            {
+                aTime = mLastTime + remaining;
+                ExitNow(rval = true);
+            }
         }
     }
 
-    return retval;
+exit:
+    return rval;
 }
 
 }  // namespace Thread
@@ -58,6 +58,10 @@ class Timer;
 /**
  * This class implements the timer scheduler.
  *
+ * Running timers are kept on a hierarchical timer wheel indexed by expiration
+ * time, which makes Add() and Remove() O(1) regardless of the number of
+ * running timers.
+ *
  */
 class TimerScheduler
 {
@@ -103,22 +107,57 @@ public:
      */
     void FireTimers(void);
 
-private:
-    void SetAlarm(void);
+    /**
+     * This method returns a monotonic 64-bit millisecond tick count.
+     *
+     * The count is maintained by accumulating the 32-bit platform time and stays monotonic
+     * provided the scheduler observes the clock at least once per 32-bit wrap interval,
+     * which any running timer guarantees.
+     *
+     * @returns The monotonic tick count in milliseconds.
+     *
+     */
+    uint64_t GetNow64(void);
 
     /**
-     * This method compares two timers and returns a value to indicate
-     * which timer will fire earlier.
+     * This method sets the otInstance passed to the platform alarm calls.
      *
-     * @param[in] aTimerA   The first timer for comparison.
-     * @param[in] aTimerB   The second timer for comparison.
+     * @param[in]  aInstance  A pointer to the owning OpenThread instance.
      *
-     * @returns true if aTimerA will fire before aTimerB.
-     * @returns false if aTimerA will fire at the same time or after aTimerB.
      */
-    static bool TimerCompare(const Timer &aTimerA, const Timer &aTimerB);
+    void SetInstance(otInstance *aInstance) { mInstance = aInstance; }
 
-    Timer *mHead;
+private:
+    enum
+    {
+        kBitsPerLevel = 4,                      ///< log2 of the number of slots per wheel level.
+        kNumLevels = 32 / kBitsPerLevel,        ///< Number of wheel levels covering the 32-bit time space.
+        kSlotsPerLevel = 1 << kBitsPerLevel,    ///< Number of slots per wheel level.
+        kSlotMask = kSlotsPerLevel - 1,         ///< Mask to extract a slot index from a time value.
+        kLevelExpired = 0xfe,                   ///< Level value indicating the timer is on the expired list.
+        kLevelNotAdded = 0xff,                  ///< Level value indicating the timer is not on the wheel.
+    };
+
+    void SetAlarm(void);
+    void Synchronize(void);
+    uint64_t UpdateTicks(uint32_t aNow);
+    void Insert(Timer &aTimer);
+    void Detach(Timer &aTimer);
+    void PushExpired(Timer &aTimer);
+    void Cascade(void);
+    void MoveSlot(uint32_t aNow);
+    uint32_t GetRemaining(const Timer &aTimer) const;
+    bool GetNextEvent(uint32_t &aTime) const;
+    bool GetNextFire(uint32_t &aTime) const;
+
+    Timer      *mBuckets[kNumLevels][kSlotsPerLevel];
+    Timer      *mExpired;
+    uint64_t    mTicks;
+    uint32_t    mLastRead;
+    uint32_t    mLastTime;
+    uint32_t    mNextEvent;
+    uint16_t    mNumTimers;
+    otInstance *mInstance;
 };
 
 /**
@@ -151,7 +190,10 @@ public:
         mContext(aContext),
         mT0(0),
         mDt(0),
-        mNext(NULL) {
+        mNext(NULL),
+        mPrev(NULL),
+        mLevel(TimerScheduler::kLevelNotAdded),
+        mSlot(0) {
     }
 
     /**
@@ -207,6 +249,15 @@ public:
      */
     static uint32_t GetNow(void) { return otPlatAlarmGetNow(); }
 
+    /**
+     * This static method returns a monotonic 64-bit millisecond tick count that does not wrap
+     * with the 32-bit platform time.
+     *
+     * @returns The monotonic tick count in milliseconds.
+     *
+     */
+    static uint64_t GetNow64(void);
+
     /**
      * This static method returns the number of milliseconds given seconds.
      *
@@ -232,6 +283,9 @@ private:
     uint32_t        mT0;
     uint32_t        mDt;
     Timer          *mNext;
+    Timer          *mPrev;
+    uint8_t         mLevel;
+    uint8_t         mSlot;
 };
 
 /**
@@ -0,0 +1,280 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a cursor over the TLVs of a message.
+ */
+
+#ifndef TLV_ITERATOR_HPP_
+#define TLV_ITERATOR_HPP_
+
+#include <string.h>
+
+#include <common/message.hpp>
+
+namespace Thread {
+
+/**
+ * @addtogroup core-message
+ *
+ * @{
+ *
+ */
+
+/**
+ * This class implements a cursor over the TLVs of a message.
+ *
+ * The cursor caches the current message buffer chunk so that scanning for a TLV walks the
+ * buffer chain once instead of re-walking it from the head for every candidate, and exposes
+ * in-place pointers when the TLV of interest is contiguous within a single buffer.
+ *
+ * The cursor handles the one-byte type, one-byte length framing shared by the MLE and Thread
+ * Network Layer TLVs, and optionally the MeshCoP extended-length encoding (length byte 0xff
+ * followed by a two-byte big-endian length), so one find kernel serves every TLV family.
+ *
+ */
+class TlvIterator
+{
+public:
+    /**
+     * This constructor initializes the cursor at the message offset.
+     *
+     * @param[in]  aMessage        A reference to the message to iterate over.
+     * @param[in]  aAllowExtended  TRUE to decode the MeshCoP extended-length encoding.
+     *
+     */
+    explicit TlvIterator(const Message &aMessage, bool aAllowExtended = false):
+        mMessage(aMessage),
+        mOffset(aMessage.GetOffset()),
+        mEnd(aMessage.GetLength()),
+        mChunk(NULL),
+        mChunkOffset(0),
+        mChunkLength(0),
+        mLength(0),
+        mHeaderSize(kHeaderSize),
+        mAllowExtended(aAllowExtended) {
+    }
+
+    /**
+     * This method returns the offset of the current TLV within the message.
+     *
+     * @returns The offset of the current TLV.
+     *
+     */
+    uint16_t GetOffset(void) const { return mOffset; }
+
+    /**
+     * This method returns the offset of the current TLV's value within the message.
+     *
+     * @returns The offset of the first value byte of the current TLV.
+     *
+     */
+    uint16_t GetValueOffset(void) const { return mOffset + mHeaderSize; }
+
+    /**
+     * This method returns the value length of the current TLV.
+     *
+     * @returns The length of the current TLV value in bytes.
+     *
+     */
+    uint16_t GetLength(void) const { return mLength; }
+
+    /**
+     * This method advances the cursor to the next well-formed TLV of a given type at or after
+     * the current position.
+     *
+     * @param[in]  aType  The TLV type to seek to.
+     *
+     * @retval kThreadError_None   Successfully positioned the cursor on a TLV of type @p aType.
+     * @retval kThreadError_Parse  No TLV of type @p aType was found within the message bounds.
+     *
+     */
+    ThreadError SeekTo(uint8_t aType) {
+        ThreadError error = kThreadError_Parse;
+        uint8_t type;
+
+        while (mOffset + kHeaderSize <= mEnd)
+        {
+            ReadHeader(type);
+
+            if (type == aType && (mOffset + mHeaderSize + mLength) <= mEnd)
+            {
+                ExitNow(error = kThreadError_None);
+            }
+
+            mOffset += mHeaderSize + mLength;
+        }
+
+    exit:
+        return error;
+    }
+
+    /**
+     * This method returns a pointer to the value of the current TLV when the whole TLV lies
+     * within a single message buffer.
+     *
+     * @param[out]  aLength  The length of the TLV value in bytes.
+     *
+     * @returns A pointer to the first value byte, or NULL if the TLV spans message buffers.
+     *
+     */
+    const uint8_t *GetValue(uint16_t &aLength) {
+        const uint8_t *rval = NULL;
+        uint8_t type;
+
+        ReadHeader(type);
+        aLength = mLength;
+
+        if (EnsureChunk(mHeaderSize + mLength))
+        {
+            rval = mChunk + (mOffset - mChunkOffset) + mHeaderSize;
+        }
+
+        return rval;
+    }
+
+    /**
+     * This method copies the current TLV, header included, capped at a given size.
+     *
+     * @param[in]  aMaxLength  The maximum number of bytes to copy.
+     * @param[in]  aBuf        A pointer to the output buffer.
+     *
+     * @returns The number of bytes copied.
+     *
+     */
+    uint16_t ReadTlv(uint16_t aMaxLength, void *aBuf) {
+        uint8_t type;
+        uint16_t size;
+
+        ReadHeader(type);
+        size = mHeaderSize + mLength;
+
+        if (size > aMaxLength)
+        {
+            size = aMaxLength;
+        }
+
+        if (EnsureChunk(size))
+        {
+            memcpy(aBuf, mChunk + (mOffset - mChunkOffset), size);
+        }
+        else
+        {
+            size = mMessage.Read(mOffset, size, aBuf);
+        }
+
+        return size;
+    }
+
+private:
+    enum
+    {
+        kHeaderSize = 2,           ///< TLV header size: one type byte and one length byte.
+        kExtendedHeaderSize = 4,   ///< Extended header size: type, 0xff, two-byte length.
+        kExtendedLengthByte = 0xff,  ///< Length byte value announcing an extended length.
+    };
+
+    /**
+     * This method reads the header of the TLV at the current position, setting the cached
+     * value length and header size.
+     *
+     * @param[out]  aType  The TLV type.
+     *
+     */
+    void ReadHeader(uint8_t &aType) {
+        uint8_t header[kExtendedHeaderSize] = { 0, 0, 0, 0 };
+
+        if (EnsureChunk(kHeaderSize))
+        {
+            memcpy(header, mChunk + (mOffset - mChunkOffset), kHeaderSize);
+        }
+        else
+        {
+            // rare case: the TLV header straddles a buffer boundary
+            mMessage.Read(mOffset, kHeaderSize, header);
+        }
+
+        aType = header[0];
+        mLength = header[1];
+        mHeaderSize = kHeaderSize;
+
+        if (mAllowExtended && header[1] == kExtendedLengthByte)
+        {
+            if (EnsureChunk(kExtendedHeaderSize))
+            {
+                memcpy(header, mChunk + (mOffset - mChunkOffset), kExtendedHeaderSize);
+            }
+            else
+            {
+                mMessage.Read(mOffset, kExtendedHeaderSize, header);
+            }
+
+            mLength = static_cast<uint16_t>((header[2] << 8) | header[3]);
+            mHeaderSize = kExtendedHeaderSize;
+        }
+    }
+
+    /**
+     * This method ensures the cached chunk covers @p aLength bytes at the current position.
+     *
+     * @param[in]  aLength  The number of contiguous bytes required.
+     *
+     * @retval TRUE   The cached chunk covers the requested range.
+     * @retval FALSE  The requested range spans message buffers.
+     *
+     */
+    bool EnsureChunk(uint16_t aLength) {
+        if (mChunk == NULL || mOffset < mChunkOffset || (mOffset + aLength) > (mChunkOffset + mChunkLength))
+        {
+            mChunk = mMessage.GetChunk(mOffset, mChunkLength);
+            mChunkOffset = mOffset;
+        }
+
+        return (mChunk != NULL) && ((mOffset + aLength) <= (mChunkOffset + mChunkLength));
+    }
+
+    const Message &mMessage;
+    uint16_t mOffset;
+    uint16_t mEnd;
+    const uint8_t *mChunk;
+    uint16_t mChunkOffset;
+    uint16_t mChunkLength;
+    uint16_t mLength;
+    uint16_t mHeaderSize;
+    bool mAllowExtended;
+};
+
+/**
+ * @}
+ *
+ */
+
+}  // namespace Thread
+
+#endif  // TLV_ITERATOR_HPP_
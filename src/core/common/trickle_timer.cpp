@@ -33,8 +33,8 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/random.hpp>
 #include <common/trickle_timer.hpp>
-#include <platform/random.h>
 
 namespace Thread {
 
@@ -50,6 +50,7 @@ TrickleTimer::TrickleTimer(
     k(aRedundancyConstant),
 #endif
     mPhase(kPhaseDormant),
+    mCoalescingSlack(OPENTHREAD_CONFIG_TRICKLE_COALESCING_SLACK),
     mTransmitHandler(aTransmitHandler),
     mIntervalExpiredHandler(aIntervalExpiredHandler),
     mContext(aContext)
@@ -71,7 +72,7 @@ void TrickleTimer::Start(uint32_t aIntervalMin, uint32_t aIntervalMax, Mode aMod
     mMode = aMode;
 
     // Initialize I to [Imin, Imax]
-    I = Imin + otPlatRandomGet() % (Imax - Imin);
+    I = Imin + Random::GetUint32() % (Imax - Imin);
 
     // Start a new interval
     StartNewInterval();
@@ -125,7 +126,7 @@ void TrickleTimer::StartNewInterval(void)
     else if (mMode == kModeMPL)
     {
         // Initialize t to random value between (0, I]
-        t = otPlatRandomGet() % I;
+        t = Random::GetUint32() % I;
     }
     else if (mMode == kModePlainTimer)
     {
@@ -135,11 +136,23 @@ void TrickleTimer::StartNewInterval(void)
     else
     {
         // Initialize t to random value between (I/2, I]
-        t = (I / 2) + otPlatRandomGet() % (I / 2);
+        t = (I / 2) + Random::GetUint32() % (I / 2);
     }
 
     // Start the timer for 't' milliseconds from now
-    mTimer.Start(t);
+    StartSubTimer(t);
+}
+
+void TrickleTimer::StartSubTimer(uint32_t aDuration)
+{
+    if (mCoalescingSlack != 0 && aDuration > mCoalescingSlack)
+    {
+        // Align the absolute fire time down to the slack grid so that trickle timers
+        // sharing a slack value wake the scheduler together
+        aDuration -= (Timer::GetNow() + aDuration) % mCoalescingSlack;
+    }
+
+    mTimer.Start(aDuration);
 }
 
 void TrickleTimer::HandleTimerFired(void *aContext)
@@ -177,7 +190,7 @@ void TrickleTimer::HandleTimerFired(void)
             if (mMode == kModePlainTimer)
             {
                 // Initialize I to [Imin, Imax]
-                I = Imin + otPlatRandomGet() % (Imax - Imin);
+                I = Imin + Random::GetUint32() % (Imax - Imin);
 
                 // Start a new interval
                 StartNewInterval();
@@ -188,7 +201,7 @@ void TrickleTimer::HandleTimerFired(void)
                 mPhase = kPhaseInterval;
 
                 // Start the time for 'I - t' milliseconds
-                mTimer.Start(I - t);
+                StartSubTimer(I - t);
             }
         }
 
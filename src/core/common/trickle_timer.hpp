@@ -34,6 +34,8 @@
 #ifndef TRICKLE_TIMER_HPP_
 #define TRICKLE_TIMER_HPP_
 
+#include <openthread-core-config.h>
+
 #include <common/timer.hpp>
 
 namespace Thread {
@@ -116,6 +118,18 @@ public:
      */
     void Stop(void);
 
+    /**
+     * This method sets the coalescing slack for the timer.
+     *
+     * Firings are aligned down to multiples of the slack, so trickle timers sharing a slack
+     * value wake the scheduler together. A firing may occur up to @p aSlack milliseconds
+     * early; the slack should therefore be small relative to the configured Imin.
+     *
+     * @param[in]  aSlack  The coalescing slack in milliseconds (0 disables coalescing).
+     *
+     */
+    void SetCoalescingSlack(uint32_t aSlack) { mCoalescingSlack = aSlack; }
+
 #ifdef ENABLE_TRICKLE_TIMER_SUPPRESSION_SUPPORT
     /**
      * This method indicates to the trickle timer a 'consistent' state.
@@ -135,6 +149,7 @@ private:
     bool IntervalExpiredFired(void) { return mIntervalExpiredHandler ? mIntervalExpiredHandler(mContext) : true; }
 
     void StartNewInterval(void);
+    void StartSubTimer(uint32_t aDuration);
 
     static void HandleTimerFired(void *aContext);
     void HandleTimerFired(void);
@@ -174,6 +189,9 @@ private:
     // The current trickle phase for the timer
     Phase mPhase;
 
+    // The coalescing slack (in milliseconds, 0 when disabled)
+    uint32_t mCoalescingSlack;
+
     // Callback variables
     Handler mTransmitHandler;
     Handler mIntervalExpiredHandler;
@@ -33,6 +33,7 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/message.hpp>
 #include <crypto/aes_ccm.hpp>
 
 namespace Thread {
@@ -190,48 +191,99 @@ void AesCcm::Header(const void *aHeader, uint32_t aHeaderLength)
     }
 }
 
-void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncrypt)
+void AesCcm::NextCtrBlock(uint8_t *aPad)
+{
+    for (int i = sizeof(mCtr) - 1; i > mNonceLength; i--)
+    {
+        if (++mCtr[i])
+        {
+            break;
+        }
+    }
+
+    mEcb.Encrypt(mCtr, aPad);
+}
+
+OT_TOOL_HOT_CODE void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncrypt)
 {
     uint8_t *plaintextBytes = reinterpret_cast<uint8_t *>(plaintext);
     uint8_t *ciphertextBytes = reinterpret_cast<uint8_t *>(ciphertext);
+    uint32_t cur = 0;
     uint8_t byte;
 
     assert(mPlainTextCur + len <= mPlainTextLength);
 
-    for (unsigned i = 0; i < len; i++)
+    while (cur < len)
     {
-        if (mCtrLength == 16)
+        // multi-block kernel: with no keystream or CBC-MAC bytes carried over, format a run of
+        // counters up front and process kBatchBlocks whole blocks per pass
+        if (mCtrLength == sizeof(mCtrPad) && mBlockLength == 0)
         {
-            for (int j = sizeof(mCtr) - 1; j > mNonceLength; j--)
+            while (len - cur >= kBatchBlocks * sizeof(mBlock))
             {
-                if (++mCtr[j])
+                uint8_t pad[kBatchBlocks * sizeof(mBlock)];
+
+                for (unsigned block = 0; block < kBatchBlocks; block++)
                 {
-                    break;
+                    NextCtrBlock(pad + block * sizeof(mBlock));
+                }
+
+                for (unsigned block = 0; block < kBatchBlocks; block++)
+                {
+                    const uint8_t *padBlock = pad + block * sizeof(mBlock);
+
+                    for (unsigned i = 0; i < sizeof(mBlock); i++, cur++)
+                    {
+                        if (aEncrypt)
+                        {
+                            byte = plaintextBytes[cur];
+                            ciphertextBytes[cur] = byte ^ padBlock[i];
+                        }
+                        else
+                        {
+                            byte = ciphertextBytes[cur] ^ padBlock[i];
+                            plaintextBytes[cur] = byte;
+                        }
+
+                        mBlock[i] ^= byte;
+                    }
+
+                    mEcb.Encrypt(mBlock, mBlock);
                 }
             }
 
-            mEcb.Encrypt(mCtr, mCtrPad);
+            if (cur >= len)
+            {
+                break;
+            }
+        }
+
+        if (mCtrLength == sizeof(mCtrPad))
+        {
+            NextCtrBlock(mCtrPad);
             mCtrLength = 0;
         }
 
         if (aEncrypt)
         {
-            byte = plaintextBytes[i];
-            ciphertextBytes[i] = byte ^ mCtrPad[mCtrLength++];
+            byte = plaintextBytes[cur];
+            ciphertextBytes[cur] = byte ^ mCtrPad[mCtrLength++];
         }
         else
         {
-            byte = ciphertextBytes[i] ^ mCtrPad[mCtrLength++];
-            plaintextBytes[i] = byte;
+            byte = ciphertextBytes[cur] ^ mCtrPad[mCtrLength++];
+            plaintextBytes[cur] = byte;
         }
 
+        mBlock[mBlockLength++] ^= byte;
+
         if (mBlockLength == sizeof(mBlock))
         {
             mEcb.Encrypt(mBlock, mBlock);
             mBlockLength = 0;
         }
 
-        mBlock[mBlockLength++] ^= byte;
+        cur++;
     }
 
     mPlainTextCur += len;
@@ -251,6 +303,23 @@ void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncr
     }
 }
 
+void AesCcm::Payload(Message &aMessage, uint16_t aOffset, uint16_t aLength, bool aEncrypt)
+{
+    Message::ChunkIterator iterator;
+    ThreadError error;
+    uint8_t *chunk;
+    uint16_t chunkLength;
+
+    error = iterator.Init(aMessage, aOffset, aLength);
+    assert(error == kThreadError_None);
+    (void)error;
+
+    while (iterator.GetNextChunk(chunk, chunkLength))
+    {
+        Payload(chunk, chunk, chunkLength, aEncrypt);
+    }
+}
+
 void AesCcm::Finalize(void *tag, uint8_t *aTagLength)
 {
     uint8_t *tagBytes = reinterpret_cast<uint8_t *>(tag);
@@ -40,6 +40,9 @@
 #include <crypto/aes_ecb.hpp>
 
 namespace Thread {
+
+class Message;
+
 namespace Crypto {
 
 /**
@@ -98,6 +101,17 @@ public:
      */
     void Payload(void *aPlainText, void *aCipherText, uint32_t aLength, bool aEncrypt);
 
+    /**
+     * This method processes a payload stored in a message, in place, one message buffer at a time.
+     *
+     * @param[inout]  aMessage  A reference to the message containing the payload.
+     * @param[in]     aOffset   Byte offset within @p aMessage of the start of the payload.
+     * @param[in]     aLength   Payload length in bytes.
+     * @param[in]     aEncrypt  TRUE on encrypt and FALSE on decrypt.
+     *
+     */
+    void Payload(Message &aMessage, uint16_t aOffset, uint16_t aLength, bool aEncrypt);
+
     /**
      * This method generates the tag.
      *
@@ -108,6 +122,13 @@ public:
     void Finalize(void *aTag, uint8_t *aTagLength);
 
 private:
+    enum
+    {
+        kBatchBlocks = 4,  ///< Number of blocks processed per pass of the multi-block payload kernel.
+    };
+
+    void NextCtrBlock(uint8_t *aPad);
+
     AesEcb mEcb;
     uint8_t mBlock[AesEcb::kBlockSize];
     uint8_t mCtr[AesEcb::kBlockSize];
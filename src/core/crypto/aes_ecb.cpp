@@ -31,19 +31,70 @@
  *   This file implements AES-ECB.
  */
 
+#include <string.h>
+
 #include <crypto/aes_ecb.hpp>
+#include <platform/aes.h>
 
 namespace Thread {
 namespace Crypto {
 
+// tracks which instance's key is currently loaded in the platform AES engine
+static AesEcb *sEngineKeyOwner = NULL;
+
+// cleared on the first kThreadError_NotImplemented so the engine is only probed once
+static bool sEngineAvailable = true;
+
 void AesEcb::SetKey(const uint8_t *aKey, uint16_t aKeyLength)
 {
+    mUseHardware = false;
+
+    if (sEngineAvailable && (aKeyLength / 8) <= sizeof(mKey))
+    {
+        switch (otPlatAesEcbSetKey(aKey, aKeyLength / 8))
+        {
+        case kThreadError_None:
+            mKeyLength = static_cast<uint8_t>(aKeyLength / 8);
+            memcpy(mKey, aKey, mKeyLength);
+            mUseHardware = true;
+            sEngineKeyOwner = this;
+            return;
+
+        case kThreadError_NotImplemented:
+            sEngineAvailable = false;
+            break;
+
+        default:
+            break;
+        }
+    }
+
     mbedtls_aes_init(&mContext);
     mbedtls_aes_setkey_enc(&mContext, aKey, aKeyLength);
 }
 
 void AesEcb::Encrypt(const uint8_t aInput[kBlockSize], uint8_t aOutput[kBlockSize])
 {
+    if (mUseHardware)
+    {
+        // another instance may have loaded its key since our last block
+        if (sEngineKeyOwner != this)
+        {
+            otPlatAesEcbSetKey(mKey, mKeyLength);
+            sEngineKeyOwner = this;
+        }
+
+        if (otPlatAesEcbEncrypt(aInput, aOutput) == kThreadError_None)
+        {
+            return;
+        }
+
+        // the engine refused this block; fall back to software for the remainder of this key
+        mbedtls_aes_init(&mContext);
+        mbedtls_aes_setkey_enc(&mContext, mKey, static_cast<uint16_t>(8 * mKeyLength));
+        mUseHardware = false;
+    }
+
     mbedtls_aes_crypt_ecb(&mContext, MBEDTLS_AES_ENCRYPT, aInput, aOutput);
 }
 
@@ -36,6 +36,8 @@
 
 #include <mbedtls/aes.h>
 
+#include <openthread-types.h>
+
 namespace Thread {
 namespace Crypto {
 
@@ -61,8 +63,10 @@ public:
     /**
      * This method sets the key.
      *
+     * The key is handed to the platform AES engine when one is available; otherwise software AES is used.
+     *
      * @param[in]  aKey        A pointer to the key.
-     * @param[in]  aKeyLength  The key length in bytes.
+     * @param[in]  aKeyLength  The key length in bits.
      *
      */
     void SetKey(const uint8_t *aKey, uint16_t aKeyLength);
@@ -78,6 +82,9 @@ public:
 
 private:
     mbedtls_aes_context mContext;
+    uint8_t mKey[kBlockSize];
+    uint8_t mKeyLength;
+    bool mUseHardware;
 };
 
 /**
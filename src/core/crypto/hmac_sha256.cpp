@@ -56,5 +56,11 @@ void HmacSha256::Finish(uint8_t aHash[kHashSize])
     mbedtls_md_free(&mContext);
 }
 
+void HmacSha256::FinishAndReset(uint8_t aHash[kHashSize])
+{
+    mbedtls_md_hmac_finish(&mContext, aHash);
+    mbedtls_md_hmac_reset(&mContext);
+}
+
 }  // namespace Crypto
 }  // namespace Thread
@@ -86,6 +86,19 @@ public:
      */
     void Finish(uint8_t aHash[kHashSize]);
 
+    /**
+     * This method finalizes the hash computation and prepares the object for another message
+     * with the same key.
+     *
+     * Unlike Finish(), the keyed state set up by Start() is retained, so a batch of
+     * computations avoids re-processing the key for every message.  The final message of a
+     * batch must use Finish() to release the context.
+     *
+     * @param[out]  aHash  A pointer to the output buffer.
+     *
+     */
+    void FinishAndReset(uint8_t aHash[kHashSize]);
+
 private:
     mbedtls_md_context_t mContext;
 };
@@ -31,14 +31,258 @@
  *   This file implements the use of mbedTLS.
  */
 
+#include <string.h>
+
+#include <common/code_utils.hpp>
 #include <crypto/mbedtls.hpp>
 
+#include <mbedtls/platform.h>
+
 namespace Thread {
 namespace Crypto {
 
+enum
+{
+    kAlignment = sizeof(void *),
+    kBlockHeaderSize = kAlignment,  // padded so that payloads stay pointer-aligned
+    kBlockNone = 0xffff,
+    kSessionSize = MbedTls::kMemorySize - MbedTls::kScratchSize,
+};
+
+/**
+ * Free blocks in the session region form a singly-linked list ordered by address so that
+ * adjacent blocks can be coalesced when freed.
+ */
+struct Block
+{
+    uint16_t mSize;  // payload size in bytes, always a multiple of kAlignment
+    uint16_t mNext;  // offset of the next free block, or kBlockNone
+};
+
+// the mbedTLS allocation hooks are process-global, as was mbedtls_memory_buffer_alloc
+static unsigned char *sArena;
+static uint16_t sFreeList;
+static uint16_t sScratchOffset;
+static bool sScratchMode;
+#if OPENTHREAD_ENABLE_DTLS
+static uint16_t sScratchLive;
+#endif
+static otMbedTlsMemoryInfo sMemoryInfo;
+
+static Block *BlockAt(uint16_t aOffset)
+{
+    return reinterpret_cast<Block *>(sArena + aOffset);
+}
+
+static void *SessionAlloc(uint16_t aSize)
+{
+    void *rval = NULL;
+    uint16_t prev = kBlockNone;
+    uint16_t cur = sFreeList;
+
+    while (cur != kBlockNone)
+    {
+        Block *block = BlockAt(cur);
+        uint16_t next = block->mNext;
+
+        if (block->mSize >= aSize)
+        {
+            if (block->mSize >= aSize + kBlockHeaderSize + kAlignment)
+            {
+                // split off the tail as a new free block
+                uint16_t tailOffset = cur + kBlockHeaderSize + aSize;
+                Block *tail = BlockAt(tailOffset);
+
+                tail->mSize = block->mSize - aSize - kBlockHeaderSize;
+                tail->mNext = next;
+                block->mSize = aSize;
+                next = tailOffset;
+            }
+
+            if (prev == kBlockNone)
+            {
+                sFreeList = next;
+            }
+            else
+            {
+                BlockAt(prev)->mNext = next;
+            }
+
+            sMemoryInfo.mSessionUsed += kBlockHeaderSize + block->mSize;
+
+            if (sMemoryInfo.mSessionUsed > sMemoryInfo.mSessionHighWater)
+            {
+                sMemoryInfo.mSessionHighWater = sMemoryInfo.mSessionUsed;
+            }
+
+            rval = sArena + cur + kBlockHeaderSize;
+            break;
+        }
+
+        prev = cur;
+        cur = next;
+    }
+
+    return rval;
+}
+
+static void SessionFree(uint16_t aOffset)
+{
+    Block *block = BlockAt(aOffset);
+    uint16_t prev = kBlockNone;
+    uint16_t cur = sFreeList;
+
+    sMemoryInfo.mSessionUsed -= kBlockHeaderSize + block->mSize;
+
+    while (cur != kBlockNone && cur < aOffset)
+    {
+        prev = cur;
+        cur = BlockAt(cur)->mNext;
+    }
+
+    block->mNext = cur;
+
+    if (prev == kBlockNone)
+    {
+        sFreeList = aOffset;
+    }
+    else
+    {
+        Block *prevBlock = BlockAt(prev);
+
+        if (prev + kBlockHeaderSize + prevBlock->mSize == aOffset)
+        {
+            // merge into the preceding free block
+            prevBlock->mSize += kBlockHeaderSize + block->mSize;
+            block = prevBlock;
+            aOffset = prev;
+        }
+        else
+        {
+            prevBlock->mNext = aOffset;
+        }
+    }
+
+    if (cur != kBlockNone && aOffset + kBlockHeaderSize + block->mSize == cur)
+    {
+        // merge the following free block
+        block->mSize += kBlockHeaderSize + BlockAt(cur)->mSize;
+        block->mNext = BlockAt(cur)->mNext;
+    }
+}
+
+static void *Calloc(size_t aCount, size_t aSize)
+{
+    void *rval = NULL;
+    uint32_t totalSize = static_cast<uint32_t>(aCount) * static_cast<uint32_t>(aSize);
+
+    VerifyOrExit(aCount != 0 && aSize != 0 && totalSize < kSessionSize, sMemoryInfo.mAllocFailures++);
+
+    totalSize = (totalSize + kAlignment - 1) & ~static_cast<uint32_t>(kAlignment - 1);
+
+#if OPENTHREAD_ENABLE_DTLS
+
+    if (sScratchMode && (sScratchOffset + totalSize) <= MbedTls::kScratchSize)
+    {
+        rval = sArena + kSessionSize + sScratchOffset;
+        sScratchOffset += static_cast<uint16_t>(totalSize);
+        sScratchLive++;
+
+        if (sScratchOffset > sMemoryInfo.mScratchHighWater)
+        {
+            sMemoryInfo.mScratchHighWater = sScratchOffset;
+        }
+    }
+    else
+#endif
+    {
+        rval = SessionAlloc(static_cast<uint16_t>(totalSize));
+    }
+
+    if (rval != NULL)
+    {
+        memset(rval, 0, totalSize);
+    }
+    else
+    {
+        sMemoryInfo.mAllocFailures++;
+    }
+
+exit:
+    return rval;
+}
+
+static void Free(void *aPointer)
+{
+    unsigned char *pointer = static_cast<unsigned char *>(aPointer);
+
+    VerifyOrExit(pointer != NULL, ;);
+
+#if OPENTHREAD_ENABLE_DTLS
+
+    if (pointer >= sArena + kSessionSize)
+    {
+        // the scratch region recycles as a whole once its last allocation is released
+        if (--sScratchLive == 0)
+        {
+            sScratchOffset = 0;
+        }
+
+        ExitNow();
+    }
+
+#endif
+
+    SessionFree(static_cast<uint16_t>(pointer - sArena) - kBlockHeaderSize);
+
+exit:
+    return;
+}
+
 MbedTls::MbedTls(void)
 {
-    mbedtls_memory_buffer_alloc_init(mMemory, sizeof(mMemory));
+    Block *block;
+
+    sArena = mMemory;
+    sFreeList = 0;
+    sScratchOffset = 0;
+    sScratchMode = false;
+#if OPENTHREAD_ENABLE_DTLS
+    sScratchLive = 0;
+#endif
+    memset(&sMemoryInfo, 0, sizeof(sMemoryInfo));
+
+    block = BlockAt(0);
+    block->mSize = kSessionSize - kBlockHeaderSize;
+    block->mNext = kBlockNone;
+
+    mbedtls_platform_set_calloc_free(&Calloc, &Free);
+}
+
+void MbedTls::SetScratchMode(bool aEnabled)
+{
+    sScratchMode = aEnabled;
+}
+
+const otMbedTlsMemoryInfo *MbedTls::GetMemoryInfo(void)
+{
+    uint16_t largest = 0;
+
+    if (sArena != NULL)
+    {
+        for (uint16_t cur = sFreeList; cur != kBlockNone; cur = BlockAt(cur)->mNext)
+        {
+            if (BlockAt(cur)->mSize > largest)
+            {
+                largest = BlockAt(cur)->mSize;
+            }
+        }
+    }
+
+    sMemoryInfo.mSessionLargestFree = largest;
+    sMemoryInfo.mScratchUsed = sScratchOffset;
+
+    return &sMemoryInfo;
 }
 
 }  // namespace Crypto
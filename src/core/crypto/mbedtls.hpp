@@ -40,7 +40,7 @@
 #include <openthread-config.h>
 #endif
 
-#include <mbedtls/memory_buffer_alloc.h>
+#include <openthread-types.h>
 
 namespace Thread {
 namespace Crypto {
@@ -53,7 +53,12 @@ namespace Crypto {
  */
 
 /**
- * This class implements mbedTLS memory.
+ * This class implements the mbedTLS memory arena.
+ *
+ * The arena is split into two regions.  Long-lived session state (SSL contexts, I/O buffers,
+ * negotiated session material) is served from a free-list region, while per-handshake scratch
+ * allocations are served from a bump region that recycles as a whole once its last allocation
+ * is released, so handshake churn cannot fragment session memory.
  *
  */
 class MbedTls
@@ -62,9 +67,11 @@ public:
     enum
     {
 #if OPENTHREAD_ENABLE_DTLS
-        kMemorySize = 2048 * sizeof(void *), ///< Size of memory buffer (bytes).
+        kMemorySize = 2048 * sizeof(void *), ///< Size of memory arena (bytes).
+        kScratchSize = kMemorySize / 2,      ///< Portion of the arena reserved for per-handshake scratch (bytes).
 #else
-        kMemorySize = 512,                   ///< Size of memory buffer (bytes).
+        kMemorySize = 512,                   ///< Size of memory arena (bytes).
+        kScratchSize = 0,                    ///< No scratch region without DTLS.
 #endif
     };
 
@@ -74,6 +81,24 @@ public:
      */
     MbedTls(void);
 
+    /**
+     * This static method routes subsequent allocations to the per-handshake scratch region.
+     *
+     * Allocations that do not fit in the scratch region fall back to the session region.
+     *
+     * @param[in]  aEnabled  TRUE to serve allocations from the scratch region, FALSE from the session region.
+     *
+     */
+    static void SetScratchMode(bool aEnabled);
+
+    /**
+     * This static method returns usage telemetry for the memory arena.
+     *
+     * @returns A pointer to the arena usage telemetry.
+     *
+     */
+    static const otMbedTlsMemoryInfo *GetMemoryInfo(void);
+
 private:
     unsigned char mMemory[kMemorySize];
 };
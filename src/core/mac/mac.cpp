@@ -39,14 +39,15 @@
 
 #include <string.h>
 
+#include <openthread-instance.h>
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
 #include <common/logging.hpp>
+#include <common/random.hpp>
 #include <crypto/aes_ccm.hpp>
 #include <crypto/sha256.hpp>
 #include <mac/mac.hpp>
 #include <mac/mac_frame.hpp>
-#include <platform/random.h>
 #include <thread/mle_router.hpp>
 #include <thread/thread_netif.hpp>
 
@@ -59,7 +60,12 @@ static Mac *sMac;
 
 void Mac::StartCsmaBackoff(void)
 {
-    uint32_t backoffExponent = kMinBE + mTransmitAttempts + mCsmaAttempts;
+    // priority frames contend with the shortened (but still in-spec) CSMA profile
+    bool priority = (mState == kStateTransmitData && mSendHead != NULL && mSendHead->mPriority);
+
+    // back off more politely toward neighbors with a history of failed transmits
+    uint32_t backoffExponent = (priority ? kPriorityMinBE : kMinBE) +
+                               mTransmitAttempts + mCsmaAttempts + mBackoffBias;
     uint32_t backoff;
 
     if (backoffExponent > kMaxBE)
@@ -67,21 +73,25 @@ void Mac::StartCsmaBackoff(void)
         backoffExponent = kMaxBE;
     }
 
-    backoff = kMinBackoff + (kUnitBackoffPeriod * kPhyUsPerSymbol * (1 << backoffExponent)) / 1000;
-    backoff = (otPlatRandomGet() % backoff);
+    backoff = (priority ? kPriorityMinBackoff : kMinBackoff) +
+              (kUnitBackoffPeriod * kPhyUsPerSymbol * (1 << backoffExponent)) / 1000;
+    backoff = (Random::GetUint32() % backoff);
 
     mBackoffTimer.Start(backoff);
 }
 
 Mac::Mac(ThreadNetif &aThreadNetif):
-    mBeginTransmit(aThreadNetif.GetIp6().mTaskletScheduler, &HandleBeginTransmit, this),
+    mBeginTransmit(aThreadNetif.GetIp6().mTaskletScheduler, &HandleBeginTransmit, this, Tasklet::kPriorityHigh),
     mAckTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleAckTimer, this),
     mBackoffTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleBeginTransmit, this),
     mReceiveTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleReceiveTimer, this),
+    mNoiseSampleTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleNoiseSampleTimer, this),
     mKeyManager(aThreadNetif.GetKeyManager()),
     mMle(aThreadNetif.GetMle()),
     mNetif(aThreadNetif),
-    mEnergyScanSampleRssiTask(aThreadNetif.GetIp6().mTaskletScheduler, &HandleEnergyScanSampleRssi, this),
+    mInstance(NULL),
+    mEnergyScanSampleRssiTask(aThreadNetif.GetIp6().mTaskletScheduler, &HandleEnergyScanSampleRssi, this,
+                              Tasklet::kPriorityHigh),
     mWhitelist(),
     mBlacklist()
 {
@@ -92,8 +102,22 @@ Mac::Mac(ThreadNetif &aThreadNetif):
     mRxOnWhenIdle = false;
     mCsmaAttempts = 0;
     mTransmitAttempts = 0;
+    mBackoffBias = 0;
+    mTxStartTime = 0;
     mTransmitBeacon = false;
 
+    mJamDetectionEnabled = false;
+    mChannelAgilityEnabled = false;
+    mJammed = false;
+    mJamAccumulator = 0;
+
+    for (size_t i = 0; i < sizeof(mChannelQuality); i++)
+    {
+        mChannelQuality[i] = kInvalidRssiValue;
+    }
+
+    mNoiseSampleTimer.Start(kNoiseSamplePeriod);
+
     mPendingScanRequest = kScanTypeNone;
     mScanChannel = kPhyMinChannel;
     mScanChannels = 0xff;
@@ -103,6 +127,9 @@ Mac::Mac(ThreadNetif &aThreadNetif):
     mEnergyScanHandler = NULL;
     mEnergyScanCurrentMaxRssi = kInvalidRssiValue;
 
+    mCcmKeyValid = false;
+    memset(mNonceTemplate, 0, sizeof(mNonceTemplate));
+
     mSendHead = NULL;
     mSendTail = NULL;
     mReceiveHead = NULL;
@@ -112,29 +139,30 @@ Mac::Mac(ThreadNetif &aThreadNetif):
     mPanId = kPanIdBroadcast;
     mShortAddress = kShortAddrInvalid;
 
-    for (size_t i = 0; i < sizeof(mExtAddress); i++)
-    {
-        mExtAddress.m8[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mExtAddress.m8, sizeof(mExtAddress.m8));
 
     mExtAddress.SetGroup(false);
     mExtAddress.SetLocal(true);
 
     memset(&mCounters, 0, sizeof(otMacCounters));
 
+    mTxAirtimeBudget = 0;
+    mBudgetWindowStart = 0;
+    mBudgetWindowAirtime = 0;
+
     SetExtendedPanId(sExtendedPanidInit);
     SetNetworkName(sNetworkNameInit);
     SetPanId(mPanId);
     SetExtAddress(mExtAddress);
     SetShortAddress(kShortAddrInvalid);
 
-    mBeaconSequence = static_cast<uint8_t>(otPlatRandomGet());
-    mDataSequence = static_cast<uint8_t>(otPlatRandomGet());
+    mBeaconSequence = static_cast<uint8_t>(Random::GetUint32());
+    mDataSequence = static_cast<uint8_t>(Random::GetUint32());
 
     mPcapCallback = NULL;
     mPcapCallbackContext = NULL;
 
-    otPlatRadioEnable(NULL);
+    otPlatRadioEnable(mInstance);
 }
 
 ThreadError Mac::ActiveScan(uint32_t aScanChannels, uint16_t aScanDuration, ActiveScanHandler aHandler, void *aContext)
@@ -231,10 +259,12 @@ void Mac::HandleEnergyScanSampleRssi(void)
 
     VerifyOrExit(mState == kStateEnergyScan, ;);
 
-    rssi = otPlatRadioGetRssi(NULL);
+    rssi = otPlatRadioGetRssi(mInstance);
 
     if (rssi != kInvalidRssiValue)
     {
+        UpdateNoiseFloor(mScanChannel, rssi);
+
         if ((mEnergyScanCurrentMaxRssi == kInvalidRssiValue) || (rssi > mEnergyScanCurrentMaxRssi))
         {
             mEnergyScanCurrentMaxRssi = rssi;
@@ -247,6 +277,171 @@ exit:
     return;
 }
 
+void Mac::HandleNoiseSampleTimer(void *aContext)
+{
+    Mac *obj = static_cast<Mac *>(aContext);
+    obj->HandleNoiseSampleTimer();
+}
+
+void Mac::HandleNoiseSampleTimer(void)
+{
+    // opportunistic mini-sample of the current channel while the radio is listening idle
+    if (mState == kStateIdle && mRxOnWhenIdle)
+    {
+        int8_t rssi = otPlatRadioGetRssi(mInstance);
+
+        UpdateNoiseFloor(mChannel, rssi);
+
+        if (mJamDetectionEnabled)
+        {
+            ProcessJamSample(rssi);
+        }
+    }
+
+    mNoiseSampleTimer.Start(mJamDetectionEnabled ? kJamSamplePeriod : kNoiseSamplePeriod);
+}
+
+void Mac::SetJamDetectionEnabled(bool aEnabled)
+{
+    mJamDetectionEnabled = aEnabled;
+    mJammed = false;
+    mJamAccumulator = 0;
+    mNoiseSampleTimer.Start(aEnabled ? kJamSamplePeriod : kNoiseSamplePeriod);
+}
+
+void Mac::ProcessJamSample(int8_t aRssi)
+{
+    // leaky-bucket hysteresis: a single noisy or quiet sample does not flip the state
+    if (aRssi != kInvalidRssiValue && aRssi >= kJamRssiThreshold)
+    {
+        if (mJamAccumulator < kJamDetectionWindow)
+        {
+            mJamAccumulator++;
+        }
+
+        if (mJamAccumulator == kJamDetectionWindow && !mJammed)
+        {
+            mJammed = true;
+            otLogInfoMac("jam detected on channel %d\n", mChannel);
+
+            if (mChannelAgilityEnabled)
+            {
+                EnergyScan(0, 0, &HandleAgilityScanResult, this);
+            }
+        }
+    }
+    else
+    {
+        if (mJamAccumulator > 0)
+        {
+            mJamAccumulator--;
+        }
+
+        if (mJamAccumulator == 0 && mJammed)
+        {
+            mJammed = false;
+            otLogInfoMac("jam cleared on channel %d\n", mChannel);
+        }
+    }
+}
+
+void Mac::HandleAgilityScanResult(void *aContext, otEnergyScanResult *aResult)
+{
+    Mac *obj = static_cast<Mac *>(aContext);
+    obj->HandleAgilityScanResult(aResult);
+}
+
+void Mac::HandleAgilityScanResult(otEnergyScanResult *aResult)
+{
+    uint8_t bestChannel = mChannel;
+    int8_t bestQuality;
+
+    // per-channel samples already fed the noise floor tracker; act on scan completion
+    VerifyOrExit(aResult == NULL, ;);
+
+    bestQuality = GetChannelQuality(mChannel);
+
+    for (uint8_t channel = kPhyMinChannel; channel <= kPhyMaxChannel; channel++)
+    {
+        int8_t quality = GetChannelQuality(channel);
+
+        if (quality != kInvalidRssiValue && (bestQuality == kInvalidRssiValue || quality < bestQuality))
+        {
+            bestChannel = channel;
+            bestQuality = quality;
+        }
+    }
+
+    if (bestChannel != mChannel)
+    {
+        otOperationalDataset dataset;
+        const MeshCoP::Timestamp *activeTimestamp = mNetif.GetActiveDataset().GetNetwork().GetTimestamp();
+
+        otLogInfoMac("migrating from jammed channel %d to channel %d\n", mChannel, bestChannel);
+
+        memset(&dataset, 0, sizeof(dataset));
+        dataset.mChannel = bestChannel;
+        dataset.mIsChannelSet = true;
+        dataset.mDelay = kChannelMigrationDelay;
+        dataset.mIsDelaySet = true;
+        dataset.mActiveTimestamp = 1;
+
+        if (activeTimestamp != NULL)
+        {
+            dataset.mActiveTimestamp = ((activeTimestamp->GetSeconds() + 1) << 16) | activeTimestamp->GetTicks();
+        }
+
+        dataset.mIsActiveTimestampSet = true;
+        dataset.mPendingTimestamp = dataset.mActiveTimestamp;
+        dataset.mIsPendingTimestampSet = true;
+
+        if (mNetif.GetPendingDataset().SendSetRequest(dataset, NULL, 0) != kThreadError_None)
+        {
+            // not attached (or out of buffers); migrate locally rather than staying jammed
+            SetChannel(bestChannel);
+        }
+
+        mJammed = false;
+        mJamAccumulator = 0;
+    }
+
+exit:
+    return;
+}
+
+void Mac::UpdateNoiseFloor(uint8_t aChannel, int8_t aRssi)
+{
+    int8_t *noiseFloor;
+
+    VerifyOrExit(aChannel >= kPhyMinChannel && aChannel <= kPhyMaxChannel, ;);
+    VerifyOrExit(aRssi != kInvalidRssiValue, ;);
+
+    noiseFloor = &mChannelQuality[aChannel - kPhyMinChannel];
+
+    if (*noiseFloor == kInvalidRssiValue)
+    {
+        *noiseFloor = aRssi;
+    }
+    else
+    {
+        *noiseFloor += static_cast<int8_t>((aRssi - *noiseFloor) >> kNoiseFloorWeight);
+    }
+
+exit:
+    {}
+}
+
+int8_t Mac::GetChannelQuality(uint8_t aChannel) const
+{
+    int8_t rval = kInvalidRssiValue;
+
+    VerifyOrExit(aChannel >= kPhyMinChannel && aChannel <= kPhyMaxChannel, ;);
+    rval = mChannelQuality[aChannel - kPhyMinChannel];
+
+exit:
+    return rval;
+}
+
 ThreadError Mac::RegisterReceiver(Receiver &aReceiver)
 {
     assert(mReceiveTail != &aReceiver && aReceiver.mNext == NULL);
@@ -293,8 +488,9 @@ ThreadError Mac::SetExtAddress(const ExtAddress &aExtAddress)
         buf[i] = aExtAddress.m8[7 - i];
     }
 
-    SuccessOrExit(error = otPlatRadioSetExtendedAddress(NULL, buf));
+    SuccessOrExit(error = otPlatRadioSetExtendedAddress(mInstance, buf));
     mExtAddress = aExtAddress;
+    memcpy(mNonceTemplate, mExtAddress.m8, sizeof(mExtAddress));
 
 exit:
     return error;
@@ -305,7 +501,7 @@ void Mac::GetHashMacAddress(ExtAddress *aHashMacAddress)
     Crypto::Sha256 sha256;
     uint8_t buf[Crypto::Sha256::kHashSize];
 
-    otPlatRadioGetIeeeEui64(NULL, buf);
+    otPlatRadioGetIeeeEui64(mInstance, buf);
     sha256.Start();
     sha256.Update(buf, OT_EXT_ADDRESS_SIZE);
     sha256.Finish(buf);
@@ -321,7 +517,7 @@ ShortAddress Mac::GetShortAddress(void) const
 ThreadError Mac::SetShortAddress(ShortAddress aShortAddress)
 {
     mShortAddress = aShortAddress;
-    return otPlatRadioSetShortAddress(NULL, aShortAddress);
+    return otPlatRadioSetShortAddress(mInstance, aShortAddress);
 }
 
 uint8_t Mac::GetChannel(void) const
@@ -371,7 +567,7 @@ PanId Mac::GetPanId(void) const
 ThreadError Mac::SetPanId(PanId aPanId)
 {
     mPanId = aPanId;
-    return otPlatRadioSetPanId(NULL, mPanId);
+    return otPlatRadioSetPanId(mInstance, mPanId);
 }
 
 const uint8_t *Mac::GetExtendedPanId(void) const
@@ -385,17 +581,51 @@ ThreadError Mac::SetExtendedPanId(const uint8_t *aExtPanId)
     return kThreadError_None;
 }
 
-ThreadError Mac::SendFrameRequest(Sender &aSender)
+ThreadError Mac::SendFrameRequest(Sender &aSender, bool aPriority)
 {
     ThreadError error = kThreadError_None;
+    Sender *prev;
+    Sender *cur;
 
     VerifyOrExit(mSendTail != &aSender && aSender.mNext == NULL, error = kThreadError_Busy);
 
+    aSender.mPriority = aPriority;
+
     if (mSendHead == NULL)
     {
         mSendHead = &aSender;
         mSendTail = &aSender;
     }
+    else if (aPriority)
+    {
+        // the head sender owns the staged transmit buffer while transmitting: a
+        // priority sender slots in behind it (and behind earlier priority senders)
+        // but ahead of all best-effort senders
+        prev = (mState == kStateTransmitData) ? mSendHead : NULL;
+        cur = (prev != NULL) ? prev->mNext : mSendHead;
+
+        while (cur != NULL && cur->mPriority)
+        {
+            prev = cur;
+            cur = cur->mNext;
+        }
+
+        aSender.mNext = cur;
+
+        if (prev == NULL)
+        {
+            mSendHead = &aSender;
+        }
+        else
+        {
+            prev->mNext = &aSender;
+        }
+
+        if (cur == NULL)
+        {
+            mSendTail = &aSender;
+        }
+    }
     else
     {
         mSendTail->mNext = &aSender;
@@ -418,17 +648,17 @@ void Mac::NextOperation(void)
     {
     case kStateActiveScan:
     case kStateEnergyScan:
-        otPlatRadioReceive(NULL, mScanChannel);
+        otPlatRadioReceive(mInstance, mScanChannel);
         break;
 
     default:
-        if (mRxOnWhenIdle || mReceiveTimer.IsRunning() || otPlatRadioGetPromiscuous(NULL))
+        if (mRxOnWhenIdle || mReceiveTimer.IsRunning() || otPlatRadioGetPromiscuous(mInstance))
         {
-            otPlatRadioReceive(NULL, mChannel);
+            otPlatRadioReceive(mInstance, mChannel);
         }
         else
         {
-            otPlatRadioSleep(NULL);
+            otPlatRadioSleep(mInstance);
         }
 
         break;
@@ -473,17 +703,33 @@ void Mac::GenerateNonce(const ExtAddress &aAddress, uint32_t aFrameCounter, uint
         aNonce[i] = aAddress.m8[i];
     }
 
-    aNonce += 8;
+    UpdateNonce(aFrameCounter, aSecurityLevel, aNonce);
+}
 
+void Mac::UpdateNonce(uint32_t aFrameCounter, uint8_t aSecurityLevel, uint8_t *aNonce)
+{
     // frame counter
-    aNonce[0] = (aFrameCounter >> 24) & 0xff;
-    aNonce[1] = (aFrameCounter >> 16) & 0xff;
-    aNonce[2] = (aFrameCounter >> 8) & 0xff;
-    aNonce[3] = (aFrameCounter >> 0) & 0xff;
-    aNonce += 4;
+    aNonce[8] = (aFrameCounter >> 24) & 0xff;
+    aNonce[9] = (aFrameCounter >> 16) & 0xff;
+    aNonce[10] = (aFrameCounter >> 8) & 0xff;
+    aNonce[11] = (aFrameCounter >> 0) & 0xff;
 
     // security level
-    aNonce[0] = aSecurityLevel;
+    aNonce[12] = aSecurityLevel;
+}
+
+Crypto::AesCcm &Mac::GetCurrentMacCcm(void)
+{
+    const uint8_t *key = mKeyManager.GetCurrentMacKey();
+
+    if (!mCcmKeyValid || memcmp(mCcmKey, key, sizeof(mCcmKey)) != 0)
+    {
+        memcpy(mCcmKey, key, sizeof(mCcmKey));
+        mCcm.SetKey(mCcmKey, sizeof(mCcmKey));
+        mCcmKeyValid = true;
+    }
+
+    return mCcm;
 }
 
 void Mac::SendBeaconRequest(Frame &aFrame)
@@ -547,8 +793,8 @@ void Mac::ProcessTransmitSecurity(Frame &aFrame)
     uint8_t keyIdMode;
     uint8_t nonce[kNonceSize];
     uint8_t tagLength;
-    Crypto::AesCcm aesCcm;
-    const uint8_t *key;
+    Crypto::AesCcm kekCcm;
+    Crypto::AesCcm *aesCcm;
 
     if (aFrame.GetSecurityEnabled() == false)
     {
@@ -560,12 +806,13 @@ void Mac::ProcessTransmitSecurity(Frame &aFrame)
     switch (keyIdMode)
     {
     case Frame::kKeyIdMode0:
-        key = mKeyManager.GetKek();
+        kekCcm.SetKey(mKeyManager.GetKek(), 16);
+        aesCcm = &kekCcm;
         frameCounter = mKeyManager.GetKekFrameCounter();
         break;
 
     case Frame::kKeyIdMode1:
-        key = mKeyManager.GetCurrentMacKey();
+        aesCcm = &GetCurrentMacCcm();
         frameCounter = mKeyManager.GetMacFrameCounter();
         mKeyManager.IncrementMacFrameCounter();
         aFrame.SetKeyId((mKeyManager.GetCurrentKeySequence() & 0x7f) + 1);
@@ -579,16 +826,16 @@ void Mac::ProcessTransmitSecurity(Frame &aFrame)
     aFrame.GetSecurityLevel(securityLevel);
     aFrame.SetFrameCounter(frameCounter);
 
-    GenerateNonce(mExtAddress, frameCounter, securityLevel, nonce);
+    memcpy(nonce, mNonceTemplate, sizeof(nonce));
+    UpdateNonce(frameCounter, securityLevel, nonce);
 
-    aesCcm.SetKey(key, 16);
     tagLength = aFrame.GetFooterLength() - Frame::kFcsSize;
 
-    aesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
+    aesCcm->Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
 
-    aesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
-    aesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), true);
-    aesCcm.Finalize(aFrame.GetFooter(), &tagLength);
+    aesCcm->Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
+    aesCcm->Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), true);
+    aesCcm->Finalize(aFrame.GetFooter(), &tagLength);
 
 exit:
     {}
@@ -596,10 +843,11 @@ exit:
 
 void Mac::HandleBeginTransmit(void)
 {
-    Frame &sendFrame(*static_cast<Frame *>(otPlatRadioGetTransmitBuffer(NULL)));
+    Frame &sendFrame(*static_cast<Frame *>(otPlatRadioGetTransmitBuffer(mInstance)));
     ThreadError error = kThreadError_None;
+    Address destination;
 
-    if (otPlatRadioReceive(NULL, mChannel) != kThreadError_None)
+    if (otPlatRadioReceive(mInstance, mChannel) != kThreadError_None)
     {
         mBeginTransmit.Post();
         ExitNow();
@@ -640,11 +888,14 @@ void Mac::HandleBeginTransmit(void)
         sendFrame.SetPower(mMaxTransmitPower);
     }
 
-    SuccessOrExit(error = otPlatRadioTransmit(NULL));
+    SuccessOrExit(error = otPlatRadioTransmit(mInstance));
+
+    mTxStartTime = Timer::GetNow();
 
-    if (sendFrame.GetAckRequest() && !(otPlatRadioGetCaps(NULL) & kRadioCapsAckTimeout))
+    if (sendFrame.GetAckRequest() && !(otPlatRadioGetCaps(mInstance) & kRadioCapsAckTimeout))
     {
-        mAckTimer.Start(kAckTimeout);
+        sendFrame.GetDstAddr(destination);
+        mAckTimer.Start(GetAckTimeout(mMle.GetNeighbor(destination)));
         otLogDebgMac("ack timer start\n");
     }
 
@@ -656,17 +907,29 @@ exit:
     }
 }
 
-extern "C" void otPlatRadioTransmitDone(otInstance *, bool aRxPending, ThreadError aError)
+extern "C" void otPlatRadioTransmitDone(otInstance *aInstance, bool aRxPending, ThreadError aError)
 {
-    sMac->TransmitDoneTask(aRxPending, aError);
+    if (aInstance != NULL)
+    {
+        aInstance->mThreadNetif.GetMac().TransmitDoneTask(aRxPending, aError);
+    }
+    else
+    {
+        sMac->TransmitDoneTask(aRxPending, aError);
+    }
 }
 
-void Mac::TransmitDoneTask(bool aRxPending, ThreadError aError)
+OT_TOOL_HOT_CODE void Mac::TransmitDoneTask(bool aRxPending, ThreadError aError)
 {
     mAckTimer.Stop();
 
     mCounters.mTxTotal++;
 
+    if (aError == kThreadError_ChannelAccessFailure)
+    {
+        mCounters.mCcaAirtimeUs += kCcaDurationUs;
+    }
+
     if (aError == kThreadError_ChannelAccessFailure &&
         mCsmaAttempts < kMaxCSMABackoffs)
     {
@@ -708,6 +971,35 @@ exit:
     NextOperation();
 }
 
+#if OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+bool Mac::YieldScan(ScanType aScanType)
+{
+    bool rval = false;
+
+    // yield the radio to queued traffic between scan channels; the pending scan
+    // request resumes on the next channel once the traffic is sent
+    VerifyOrExit(mTransmitBeacon || mSendHead != NULL, ;);
+
+    mPendingScanRequest = aScanType;
+
+    if (mTransmitBeacon)
+    {
+        mTransmitBeacon = false;
+        mState = kStateTransmitBeacon;
+    }
+    else
+    {
+        mState = kStateTransmitData;
+    }
+
+    StartCsmaBackoff();
+    rval = true;
+
+exit:
+    return rval;
+}
+#endif  // OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+
 void Mac::HandleAckTimer(void *aContext)
 {
     Mac *obj = reinterpret_cast<Mac *>(aContext);
@@ -716,7 +1008,7 @@ void Mac::HandleAckTimer(void *aContext)
 
 void Mac::HandleAckTimer(void)
 {
-    otPlatRadioReceive(NULL, mChannel);
+    otPlatRadioReceive(mInstance, mChannel);
 
     switch (mState)
     {
@@ -735,6 +1027,15 @@ void Mac::HandleAckTimer(void)
         }
         while ((mScanChannels & 1) == 0);
 
+#if OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+
+        if (YieldScan(kScanTypeActive))
+        {
+            break;
+        }
+
+#endif
+
         StartCsmaBackoff();
         break;
 
@@ -762,6 +1063,15 @@ void Mac::HandleAckTimer(void)
         }
         while ((mScanChannels & 1) == 0);
 
+#if OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+
+        if (YieldScan(kScanTypeEnergy))
+        {
+            break;
+        }
+
+#endif
+
         mEnergyScanCurrentMaxRssi = kInvalidRssiValue;
         mAckTimer.Start(mScanDuration);
         break;
@@ -793,19 +1103,191 @@ void Mac::HandleReceiveTimer(void)
     NextOperation();
 }
 
+void Mac::UpdateTxHistory(Neighbor *aNeighbor, bool aAcked)
+{
+    VerifyOrExit(aNeighbor != NULL, ;);
+
+    if (aAcked)
+    {
+        aNeighbor->mTxFailRate -= aNeighbor->mTxFailRate >> Neighbor::kTxHistoryWeight;
+    }
+    else
+    {
+        aNeighbor->mTxFailRate +=
+            (Neighbor::kTxFailRateMax - aNeighbor->mTxFailRate) >> Neighbor::kTxHistoryWeight;
+        aNeighbor->mTxFailWindow++;
+    }
+
+    if (++aNeighbor->mTxAttemptWindow >= Neighbor::kPerWindowSize)
+    {
+        aNeighbor->mTxFailLastWindow = aNeighbor->mTxFailWindow;
+        aNeighbor->mPerWindowValid = true;
+        aNeighbor->mTxAttemptWindow = 0;
+        aNeighbor->mTxFailWindow = 0;
+    }
+
+exit:
+    {}
+}
+
+void Mac::UpdateAckRtt(Neighbor &aNeighbor)
+{
+    uint32_t turnaround = Timer::GetNow() - mTxStartTime;
+    uint16_t sample;
+    int16_t delta;
+
+    if (turnaround > kAckTimeoutMax)
+    {
+        turnaround = kAckTimeoutMax;
+    }
+
+    // samples carry 3 fractional bits so the smoothing survives integer truncation
+    sample = static_cast<uint16_t>(turnaround << 3);
+
+    if (sample == 0)
+    {
+        // keep zero reserved for "no samples yet"
+        sample = 1;
+    }
+
+    if (aNeighbor.mAckRtt == 0)
+    {
+        aNeighbor.mAckRtt = sample;
+        aNeighbor.mAckRttVar = sample >> 1;
+    }
+    else
+    {
+        delta = static_cast<int16_t>(sample - aNeighbor.mAckRtt);
+        aNeighbor.mAckRtt = static_cast<uint16_t>(aNeighbor.mAckRtt + (delta >> Neighbor::kAckRttWeight));
+
+        if (delta < 0)
+        {
+            delta = -delta;
+        }
+
+        aNeighbor.mAckRttVar = static_cast<uint16_t>(
+            aNeighbor.mAckRttVar + ((delta - aNeighbor.mAckRttVar) >> Neighbor::kAckRttVarWeight));
+
+        if (aNeighbor.mAckRtt == 0)
+        {
+            aNeighbor.mAckRtt = 1;
+        }
+    }
+}
+
+uint32_t Mac::GetAckTimeout(const Neighbor *aNeighbor) const
+{
+    uint32_t timeout = kAckTimeout;
+
+    // smoothed turnaround plus four deviations, as in the classic retransmission
+    // timer estimator, so fast links retry quickly and marginal links get headroom
+    if (aNeighbor != NULL && aNeighbor->mAckRtt != 0)
+    {
+        timeout = (static_cast<uint32_t>(aNeighbor->mAckRtt) +
+                   (static_cast<uint32_t>(aNeighbor->mAckRttVar) << 2)) >> 3;
+
+        if (timeout < kAckTimeoutMin)
+        {
+            timeout = kAckTimeoutMin;
+        }
+        else if (timeout > kAckTimeoutMax)
+        {
+            timeout = kAckTimeoutMax;
+        }
+    }
+
+    return timeout;
+}
+
+void Mac::UpdateTxBudget(uint32_t aAirtime)
+{
+    uint32_t now = Timer::GetNow();
+
+    if (static_cast<uint32_t>(now - mBudgetWindowStart) >= kAirtimeBudgetWindow)
+    {
+        mBudgetWindowStart = now;
+        mBudgetWindowAirtime = 0;
+    }
+
+    mBudgetWindowAirtime += aAirtime;
+}
+
+bool Mac::IsTxAirtimeBudgetExhausted(void)
+{
+    bool rval = false;
+
+    VerifyOrExit(mTxAirtimeBudget != 0, ;);
+
+    if (static_cast<uint32_t>(Timer::GetNow() - mBudgetWindowStart) >= kAirtimeBudgetWindow)
+    {
+        mBudgetWindowStart = Timer::GetNow();
+        mBudgetWindowAirtime = 0;
+    }
+
+    rval = (mBudgetWindowAirtime >= mTxAirtimeBudget);
+
+exit:
+    return rval;
+}
+
+uint8_t Mac::GetFrameAttempts(const Neighbor *aNeighbor) const
+{
+    uint8_t attempts = kMaxFrameAttempts;
+
+    // scale the retry budget down with the observed failure rate so a lossy
+    // neighbor does not starve transmissions toward healthy links
+    if (aNeighbor != NULL)
+    {
+        attempts -= static_cast<uint8_t>((static_cast<uint16_t>(aNeighbor->mTxFailRate) *
+                                          (kMaxFrameAttempts - kMinFrameAttempts)) >> 8);
+    }
+
+    return attempts;
+}
+
 void Mac::SentFrame(bool aAcked)
 {
-    Frame &sendFrame(*static_cast<Frame *>(otPlatRadioGetTransmitBuffer(NULL)));
+    Frame &sendFrame(*static_cast<Frame *>(otPlatRadioGetTransmitBuffer(mInstance)));
     Address destination;
+    Neighbor *neighbor = NULL;
     Sender *sender;
+    uint32_t airtime;
+
+    if (sendFrame.GetAckRequest())
+    {
+        sendFrame.GetDstAddr(destination);
+        neighbor = mMle.GetNeighbor(destination);
+        UpdateTxHistory(neighbor, aAcked);
+
+        if (neighbor != NULL && aAcked)
+        {
+            neighbor->mLastAcked = Timer::GetNow();
+            UpdateAckRtt(*neighbor);
+        }
+    }
+
+    airtime = GetFrameAirtime(sendFrame.GetLength());
+    mCounters.mTxAirtimeUs += airtime;
+    UpdateTxBudget(airtime);
+
+    if (neighbor != NULL)
+    {
+        neighbor->mTxAirtime += airtime;
+    }
 
     if (sendFrame.GetAckRequest() && !aAcked)
     {
         otDumpDebgMac("NO ACK", sendFrame.GetHeader(), 16);
 
-        if (mTransmitAttempts < kMaxFrameAttempts)
+        if (mTransmitAttempts < GetFrameAttempts(neighbor))
         {
             mTransmitAttempts++;
+
+            if (neighbor != NULL)
+            {
+                mBackoffBias = neighbor->mTxFailRate >> 6;
+            }
+
             StartCsmaBackoff();
 
             mCounters.mTxRetry++;
@@ -813,11 +1295,11 @@ void Mac::SentFrame(bool aAcked)
             ExitNow();
         }
 
-        sendFrame.GetDstAddr(destination);
         mMle.RemoveNeighbor(destination);
     }
 
     mTransmitAttempts = 0;
+    mBackoffBias = 0;
 
     if (sendFrame.GetAckRequest())
     {
@@ -868,7 +1350,19 @@ void Mac::SentFrame(bool aAcked)
         mDataSequence++;
         sender->HandleSentFrame(sendFrame);
 
-        ScheduleNextTransmission();
+        if (mState == kStateTransmitData && mSendHead != NULL &&
+            mPendingScanRequest == kScanTypeNone && !mTransmitBeacon)
+        {
+            // the sent-frame callback queued a follow-up frame: begin it in the same
+            // event-loop pass instead of waiting out a fresh CSMA backoff; a failed
+            // CCA falls back to the normal backoff through TransmitDoneTask
+            mBeginTransmit.Post();
+        }
+        else
+        {
+            ScheduleNextTransmission();
+        }
+
         break;
 
     default:
@@ -892,7 +1386,8 @@ ThreadError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr,
     uint8_t keyid;
     uint32_t keySequence = 0;
     const uint8_t *macKey;
-    Crypto::AesCcm aesCcm;
+    Crypto::AesCcm keyCcm;
+    Crypto::AesCcm *aesCcm;
 
     aFrame.SetSecurityValid(false);
 
@@ -943,7 +1438,7 @@ ThreadError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr,
 
         VerifyOrExit((keySequence > aNeighbor->mKeySequence) ||
                      ((keySequence == aNeighbor->mKeySequence) &&
-                      (frameCounter >= aNeighbor->mValid.mLinkFrameCounter)),
+                      aNeighbor->IsLinkFrameCounterAcceptable(frameCounter)),
                      error = kThreadError_Security);
 
         break;
@@ -956,11 +1451,20 @@ ThreadError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr,
     GenerateNonce(aSrcAddr.mExtAddress, frameCounter, securityLevel, nonce);
     tagLength = aFrame.GetFooterLength() - Frame::kFcsSize;
 
-    aesCcm.SetKey(macKey, 16);
-    aesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
-    aesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
-    aesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), false);
-    aesCcm.Finalize(tag, &tagLength);
+    if (keyIdMode == Frame::kKeyIdMode1 && keySequence == mKeyManager.GetCurrentKeySequence())
+    {
+        aesCcm = &GetCurrentMacCcm();
+    }
+    else
+    {
+        keyCcm.SetKey(macKey, 16);
+        aesCcm = &keyCcm;
+    }
+
+    aesCcm->Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
+    aesCcm->Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
+    aesCcm->Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), false);
+    aesCcm->Finalize(tag, &tagLength);
 
     VerifyOrExit(memcmp(tag, aFrame.GetFooter(), tagLength) == 0, error = kThreadError_Security);
 
@@ -970,9 +1474,10 @@ ThreadError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr,
         {
             aNeighbor->mKeySequence = keySequence;
             aNeighbor->mValid.mMleFrameCounter = 0;
+            aNeighbor->ResetLinkFrameCounter(0);
         }
 
-        aNeighbor->mValid.mLinkFrameCounter = frameCounter + 1;
+        aNeighbor->MarkLinkFrameCounter(frameCounter);
 
         if (keySequence > mKeyManager.GetCurrentKeySequence())
         {
@@ -995,12 +1500,29 @@ exit:
     return error;
 }
 
-extern "C" void otPlatRadioReceiveDone(otInstance *, RadioPacket *aFrame, ThreadError aError)
+extern "C" void otPlatRadioReceiveDone(otInstance *aInstance, RadioPacket *aFrame, ThreadError aError)
+{
+    if (aInstance != NULL)
+    {
+        aInstance->mThreadNetif.GetMac().ReceiveDoneTask(static_cast<Frame *>(aFrame), aError);
+    }
+    else
+    {
+        sMac->ReceiveDoneTask(static_cast<Frame *>(aFrame), aError);
+    }
+}
+
+extern "C" void otPlatRadioReceiveDoneBatch(otInstance *aInstance, RadioFrameEvent *aEvents, uint8_t aNumEvents)
 {
-    sMac->ReceiveDoneTask(static_cast<Frame *>(aFrame), aError);
+    Mac &mac = (aInstance != NULL) ? aInstance->mThreadNetif.GetMac() : *sMac;
+
+    for (uint8_t i = 0; i < aNumEvents; i++)
+    {
+        mac.ReceiveDoneTask(static_cast<Frame *>(aEvents[i].mPacket), aEvents[i].mError);
+    }
 }
 
-void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
+OT_TOOL_HOT_CODE void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
 {
     Address srcaddr;
     Address dstaddr;
@@ -1018,6 +1540,10 @@ void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
 
     aFrame->mSecurityValid = false;
 
+    mCounters.mRxAirtimeUs += GetFrameAirtime(aFrame->GetLength());
+
+    UpdateNoiseFloor(aFrame->mChannel, aFrame->mPower);
+
     if (mPcapCallback)
     {
         mPcapCallback(aFrame, mPcapCallbackContext);
@@ -1049,6 +1575,18 @@ void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
         ExitNow(error = kThreadError_InvalidSourceAddress);
     }
 
+    if (neighbor != NULL)
+    {
+        neighbor->mRxAirtime += GetFrameAirtime(aFrame->GetLength());
+    }
+
+    // Duplicate Detection
+    if (neighbor != NULL && neighbor->mLastRxValid && aFrame->GetSequence() == neighbor->mLastRxSequence)
+    {
+        otLogDebgMac("drop duplicate frame\n");
+        ExitNow(error = kThreadError_Duplicated);
+    }
+
     // Source Whitelist Processing
     if (srcaddr.mLength != 0 && mWhitelist.IsEnabled())
     {
@@ -1094,6 +1632,9 @@ void Mac::ReceiveDoneTask(Frame *aFrame, ThreadError aError)
 
     if (neighbor != NULL)
     {
+        neighbor->mLastRxSequence = aFrame->GetSequence();
+        neighbor->mLastRxValid = true;
+        neighbor->mLastHeard = Timer::GetNow();
         neighbor->mLinkInfo.AddRss(mNoiseFloor, aFrame->mPower);
     }
 
@@ -1175,6 +1716,10 @@ exit:
             mCounters.mRxErrInvalidSrcAddr++;
             break;
 
+        case kThreadError_Duplicated:
+            mCounters.mRxDuplicated++;
+            break;
+
         case kThreadError_WhitelistFiltered:
             mCounters.mRxWhitelistFiltered++;
             break;
@@ -1235,14 +1780,14 @@ void Mac::SetPcapCallback(otLinkPcapCallback aPcapCallback, void *aCallbackConte
 
 bool Mac::IsPromiscuous(void)
 {
-    return otPlatRadioGetPromiscuous(NULL);
+    return otPlatRadioGetPromiscuous(mInstance);
 }
 
 void Mac::SetPromiscuous(bool aPromiscuous)
 {
-    otPlatRadioSetPromiscuous(NULL, aPromiscuous);
+    otPlatRadioSetPromiscuous(mInstance, aPromiscuous);
 
-    SuccessOrExit(otPlatRadioReceive(NULL, mChannel));
+    SuccessOrExit(otPlatRadioReceive(mInstance, mChannel));
     NextOperation();
 
 exit:
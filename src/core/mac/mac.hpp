@@ -37,6 +37,7 @@
 #include <openthread-core-config.h>
 #include <common/tasklet.hpp>
 #include <common/timer.hpp>
+#include <crypto/aes_ccm.hpp>
 #include <mac/mac_frame.hpp>
 #include <mac/mac_whitelist.hpp>
 #include <mac/mac_blacklist.hpp>
@@ -73,14 +74,24 @@ enum
     kUnitBackoffPeriod    = 20,                    ///< Number of symbols (IEEE 802.15.4-2006)
 
     kMinBackoff           = 16,                    ///< Minimum backoff (milliseconds).
+    kPriorityMinBE        = 2,                     ///< macMinBE applied to priority frames (IEEE 802.15.4-2006 allows 0-3).
+    kPriorityMinBackoff   = 4,                     ///< Minimum backoff applied to priority frames (milliseconds).
     kMaxFrameAttempts     = kMaxFrameRetries + 1,  ///< Number of transmission attempts.
+    kMinFrameAttempts     = 4,                     ///< Fewest transmission attempts granted to a lossy neighbor.
 
-    kAckTimeout           = 16,                    ///< Timeout for waiting on an ACK (milliseconds).
+    kAckTimeout           = 16,                    ///< ACK timeout used before any turnaround samples exist (milliseconds).
+    kAckTimeoutMin        = 4,                     ///< Lower bound for the adaptive ACK timeout (milliseconds).
+    kAckTimeoutMax        = 64,                    ///< Upper bound for the adaptive ACK timeout (milliseconds).
     kDataPollTimeout      = 100,                   ///< Timeout for receiving Data Frame (milliseconds).
     kNonceSize            = 13,                    ///< Size of IEEE 802.15.4 Nonce (bytes).
 
     kScanChannelsAll      = OT_CHANNEL_ALL,        ///< All channels.
     kScanDurationDefault  = 200,                   ///< Default interval between channels (milliseconds).
+
+    kPhyUsPerByte         = 32,                    ///< Airtime per PHY byte at 250 kbps (microseconds).
+    kPhyAirtimeOverhead   = 6,                     ///< Preamble, SFD, and PHR bytes preceding the PSDU.
+    kCcaDurationUs        = 128,                   ///< Duration of a single CCA (8 symbols, microseconds).
+    kAirtimeBudgetWindow  = 1000,                  ///< Transmit airtime budget window (milliseconds).
 };
 
 /**
@@ -162,6 +173,7 @@ public:
         mFrameRequestHandler = aFrameRequestHandler;
         mSentFrameHandler = aSentFrameHandler;
         mContext = aContext;
+        mPriority = false;
         mNext = NULL;
     }
 
@@ -172,6 +184,7 @@ private:
     FrameRequestHandler mFrameRequestHandler;
     SentFrameHandler mSentFrameHandler;
     void *mContext;
+    bool mPriority;
     Sender *mNext;
 };
 
@@ -190,6 +203,22 @@ public:
      */
     explicit Mac(ThreadNetif &aThreadNetif);
 
+    /**
+     * This method sets the otInstance passed to the platform radio calls.
+     *
+     * @param[in]  aInstance  A pointer to the owning OpenThread instance.
+     *
+     */
+    void SetInstance(otInstance *aInstance) { mInstance = aInstance; }
+
+    /**
+     * This method returns the otInstance passed to the platform radio calls.
+     *
+     * @returns A pointer to the owning OpenThread instance, or NULL if none was set.
+     *
+     */
+    otInstance *GetInstance(void) const { return mInstance; }
+
     /**
      * This function pointer is called on receiving an IEEE 802.15.4 Beacon during an Active Scan.
      *
@@ -264,13 +293,17 @@ public:
     /**
      * This method registers a new MAC sender client.
      *
-     * @param[in]  aSender  A reference to the MAC sender client.
+     * Priority senders are queued ahead of best-effort senders and transmit with a
+     * shortened CSMA backoff profile, but never displace a frame that is already staged.
+     *
+     * @param[in]  aSender    A reference to the MAC sender client.
+     * @param[in]  aPriority  TRUE to queue the sender in the priority lane, FALSE otherwise.
      *
      * @retval kThreadError_None  Successfully registered the sender.
      * @retval kThreadError_Busy  The sender was already registered.
      *
      */
-    ThreadError SendFrameRequest(Sender &aSender);
+    ThreadError SendFrameRequest(Sender &aSender, bool aPriority = false);
 
     /**
      * This method returns a pointer to the IEEE 802.15.4 Extended Address.
@@ -457,6 +490,19 @@ public:
      */
     bool IsEnergyScanInProgress(void);
 
+    /**
+     * This method returns the tracked channel quality for a channel.
+     *
+     * The value is an exponentially-weighted noise floor updated opportunistically from
+     * received frames, energy scan samples, and periodic idle measurements.
+     *
+     * @param[in]  aChannel  The IEEE 802.15.4 channel of interest.
+     *
+     * @returns The tracked noise floor in dBm, or 127 if no measurement is available yet.
+     *
+     */
+    int8_t GetChannelQuality(uint8_t aChannel) const;
+
     /**
      * This function registers a callback to provide received raw IEEE 802.15.4 frames.
      *
@@ -494,6 +540,48 @@ public:
      */
     otMacCounters &GetCounters(void);
 
+    /**
+     * This static method returns the estimated airtime of a frame in microseconds, including
+     * the PHY preamble, SFD, and PHR.
+     *
+     * @param[in]  aLength  The PSDU length in bytes.
+     *
+     * @returns The frame airtime in microseconds.
+     *
+     */
+    static uint32_t GetFrameAirtime(uint8_t aLength) {
+        return (static_cast<uint32_t>(aLength) + kPhyAirtimeOverhead) * kPhyUsPerByte;
+    }
+
+    /**
+     * This method sets the transmit airtime budget.
+     *
+     * A non-zero budget limits the transmit airtime accumulated per one-second window;
+     * traffic scheduling uses the exhausted indication to defer low-priority transmissions.
+     *
+     * @param[in]  aBudget  The budget in microseconds per window (0 disables the budget).
+     *
+     */
+    void SetTxAirtimeBudget(uint32_t aBudget) { mTxAirtimeBudget = aBudget; }
+
+    /**
+     * This method returns the transmit airtime budget.
+     *
+     * @returns The budget in microseconds per window (0 when disabled).
+     *
+     */
+    uint32_t GetTxAirtimeBudget(void) const { return mTxAirtimeBudget; }
+
+    /**
+     * This method indicates whether or not the transmit airtime budget for the current
+     * window is exhausted.
+     *
+     * @retval TRUE   If a budget is configured and the current window has consumed it.
+     * @retval FALSE  If no budget is configured or budget remains.
+     *
+     */
+    bool IsTxAirtimeBudgetExhausted(void);
+
     /**
      * This method returns the noise floor state.
      *
@@ -502,6 +590,57 @@ public:
      */
     LinkQualityInfo &GetNoiseFloor(void) { return mNoiseFloor; }
 
+    /**
+     * This method enables or disables jam detection.
+     *
+     * While enabled, idle channel samples are taken at a faster cadence and fed through a
+     * hysteresis filter; sustained energy above the configured threshold transitions the
+     * link into the jammed state.
+     *
+     * @param[in]  aEnabled  TRUE to enable jam detection, FALSE otherwise.
+     *
+     */
+    void SetJamDetectionEnabled(bool aEnabled);
+
+    /**
+     * This method indicates whether or not jam detection is enabled.
+     *
+     * @retval TRUE   If jam detection is enabled.
+     * @retval FALSE  If jam detection is not enabled.
+     *
+     */
+    bool IsJamDetectionEnabled(void) const { return mJamDetectionEnabled; }
+
+    /**
+     * This method indicates whether or not the current channel is considered jammed.
+     *
+     * @retval TRUE   If sustained interference has been detected on the current channel.
+     * @retval FALSE  If the current channel is clear, or jam detection is not enabled.
+     *
+     */
+    bool IsJammed(void) const { return mJammed; }
+
+    /**
+     * This method enables or disables automatic channel migration when a jam is detected.
+     *
+     * On entering the jammed state, an energy scan is run across all channels and a
+     * pending dataset migration to the channel with the lowest tracked noise floor is
+     * requested (falling back to a local channel change when not attached).
+     *
+     * @param[in]  aEnabled  TRUE to enable channel agility, FALSE otherwise.
+     *
+     */
+    void SetChannelAgilityEnabled(bool aEnabled) { mChannelAgilityEnabled = aEnabled; }
+
+    /**
+     * This method indicates whether or not channel agility is enabled.
+     *
+     * @retval TRUE   If channel agility is enabled.
+     * @retval FALSE  If channel agility is not enabled.
+     *
+     */
+    bool IsChannelAgilityEnabled(void) const { return mChannelAgilityEnabled; }
+
 private:
     enum ScanType
     {
@@ -515,7 +654,23 @@ private:
         kInvalidRssiValue = 127
     };
 
+    enum
+    {
+        kNoiseFloorWeight = 3,       ///< EWMA weight (1 / 2^n) applied to each noise floor sample.
+        kNoiseSamplePeriod = 10000,  ///< Period between idle channel noise samples (milliseconds).
+        kJamSamplePeriod = 1000,     ///< Idle channel sample period while jam detection is enabled (milliseconds).
+    };
+
+    enum
+    {
+        kJamRssiThreshold = OPENTHREAD_CONFIG_JAM_DETECTION_RSSI_THRESHOLD,
+        kJamDetectionWindow = 5,     ///< Consecutive busy (clear) samples required to enter (leave) the jammed state.
+        kChannelMigrationDelay = 30000,  ///< Pending dataset delay timer used for jam-triggered migration (milliseconds).
+    };
+
     void GenerateNonce(const ExtAddress &aAddress, uint32_t aFrameCounter, uint8_t aSecurityLevel, uint8_t *aNonce);
+    static void UpdateNonce(uint32_t aFrameCounter, uint8_t aSecurityLevel, uint8_t *aNonce);
+    Crypto::AesCcm &GetCurrentMacCcm(void);
     void NextOperation(void);
     void ProcessTransmitSecurity(Frame &aFrame);
     ThreadError ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr, Neighbor *aNeighbor);
@@ -535,18 +690,39 @@ private:
     void HandleReceiveTimer(void);
     static void HandleEnergyScanSampleRssi(void *aContext);
     void HandleEnergyScanSampleRssi(void);
+    static void HandleNoiseSampleTimer(void *aContext);
+    void HandleNoiseSampleTimer(void);
+    void UpdateNoiseFloor(uint8_t aChannel, int8_t aRssi);
+    void ProcessJamSample(int8_t aRssi);
+    static void HandleAgilityScanResult(void *aContext, otEnergyScanResult *aResult);
+    void HandleAgilityScanResult(otEnergyScanResult *aResult);
 
     void StartCsmaBackoff(void);
+#if OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+    bool YieldScan(ScanType aScanType);
+#endif
+    void UpdateTxHistory(Neighbor *aNeighbor, bool aAcked);
+    void UpdateAckRtt(Neighbor &aNeighbor);
+    uint32_t GetAckTimeout(const Neighbor *aNeighbor) const;
+    uint8_t GetFrameAttempts(const Neighbor *aNeighbor) const;
+    void UpdateTxBudget(uint32_t aAirtime);
     ThreadError Scan(ScanType aType, uint32_t aScanChannels, uint16_t aScanDuration, void *aContext);
 
     Tasklet mBeginTransmit;
     Timer mAckTimer;
     Timer mBackoffTimer;
     Timer mReceiveTimer;
+    Timer mNoiseSampleTimer;
 
     KeyManager &mKeyManager;
     Mle::MleRouter &mMle;
     ThreadNetif &mNetif;
+    otInstance *mInstance;
+
+    Crypto::AesCcm mCcm;
+    uint8_t mCcmKey[16];
+    bool mCcmKeyValid;
+    uint8_t mNonceTemplate[kNonceSize];
 
     ExtAddress mExtAddress;
     ShortAddress mShortAddress;
@@ -575,8 +751,20 @@ private:
     bool mRxOnWhenIdle;
     uint8_t mCsmaAttempts;
     uint8_t mTransmitAttempts;
+    uint8_t mBackoffBias;
+    uint32_t mTxStartTime;
+
+    uint32_t mTxAirtimeBudget;
+    uint32_t mBudgetWindowStart;
+    uint32_t mBudgetWindowAirtime;
+    int8_t mChannelQuality[kPhyMaxChannel - kPhyMinChannel + 1];
     bool mTransmitBeacon;
 
+    bool mJamDetectionEnabled;
+    bool mChannelAgilityEnabled;
+    bool mJammed;
+    uint8_t mJamAccumulator;
+
     ScanType mPendingScanRequest;
     uint8_t mScanChannel;
     uint32_t mScanChannels;
@@ -47,6 +47,38 @@ Blacklist::Blacklist(void)
     {
         mBlacklist[i].mValid = false;
     }
+
+    memset(mHashIndex, 0, sizeof(mHashIndex));
+}
+
+uint8_t Blacklist::HashAddress(const uint8_t *aBytes) const
+{
+    return (aBytes[7] ^ (aBytes[6] << 3) ^ (aBytes[5] << 5)) & kHashMask;
+}
+
+void Blacklist::IndexEntry(uint8_t aEntryIndex)
+{
+    uint8_t slot = HashAddress(mBlacklist[aEntryIndex].mExtAddress.m8);
+
+    while (mHashIndex[slot] != 0)
+    {
+        slot = (slot + 1) & kHashMask;
+    }
+
+    mHashIndex[slot] = aEntryIndex + 1;
+}
+
+void Blacklist::RebuildIndex(void)
+{
+    memset(mHashIndex, 0, sizeof(mHashIndex));
+
+    for (uint8_t i = 0; i < kMaxEntries; i++)
+    {
+        if (mBlacklist[i].mValid)
+        {
+            IndexEntry(i);
+        }
+    }
 }
 
 void Blacklist::Enable(void)
@@ -97,6 +129,7 @@ Blacklist::Entry *Blacklist::Add(const ExtAddress &address)
 
         memcpy(&mBlacklist[i].mExtAddress, &address, sizeof(mBlacklist[i].mExtAddress));
         mBlacklist[i].mValid = true;
+        IndexEntry(static_cast<uint8_t>(i));
         ExitNow(rval = &mBlacklist[i]);
     }
 
@@ -104,12 +137,27 @@ exit:
     return rval;
 }
 
+ThreadError Blacklist::Add(const ExtAddress *aAddresses, uint8_t aNumAddresses)
+{
+    ThreadError error = kThreadError_None;
+
+    for (uint8_t i = 0; i < aNumAddresses; i++)
+    {
+        VerifyOrExit(Add(aAddresses[i]) != NULL, error = kThreadError_NoBufs);
+    }
+
+exit:
+    return error;
+}
+
 void Blacklist::Clear(void)
 {
     for (int i = 0; i < kMaxEntries; i++)
     {
         mBlacklist[i].mValid = false;
     }
+
+    memset(mHashIndex, 0, sizeof(mHashIndex));
 }
 
 void Blacklist::Remove(const ExtAddress &address)
@@ -119,6 +167,9 @@ void Blacklist::Remove(const ExtAddress &address)
     VerifyOrExit((entry = Find(address)) != NULL, ;);
     memset(entry, 0, sizeof(*entry));
 
+    // removing an entry can break probe chains that run through it
+    RebuildIndex();
+
 exit:
     {}
 }
@@ -126,18 +177,26 @@ exit:
 Blacklist::Entry *Blacklist::Find(const ExtAddress &address)
 {
     Entry *rval = NULL;
+    uint8_t slot = HashAddress(address.m8);
 
-    for (int i = 0; i < kMaxEntries; i++)
+    for (int i = 0; i < kHashSize; i++)
     {
-        if (!mBlacklist[i].mValid)
+        uint8_t entryIndex = mHashIndex[slot];
+        Entry *entry;
+
+        if (entryIndex == 0)
         {
-            continue;
+            break;
         }
 
-        if (memcmp(&mBlacklist[i].mExtAddress, &address, sizeof(mBlacklist[i].mExtAddress)) == 0)
+        entry = &mBlacklist[entryIndex - 1];
+
+        if (entry->mValid && memcmp(&entry->mExtAddress, &address, sizeof(entry->mExtAddress)) == 0)
         {
-            ExitNow(rval = &mBlacklist[i]);
+            ExitNow(rval = entry);
         }
+
+        slot = (slot + 1) & kHashMask;
     }
 
 exit:
@@ -120,6 +120,18 @@ public:
      */
     Entry *Add(const ExtAddress &aAddress);
 
+    /**
+     * This method adds a set of Extended Addresses to the blacklist filter.
+     *
+     * @param[in]  aAddresses     A pointer to an array of Extended Addresses.
+     * @param[in]  aNumAddresses  The number of addresses in @p aAddresses.
+     *
+     * @retval kThreadError_None    Successfully added all addresses.
+     * @retval kThreadError_NoBufs  The blacklist filter filled up before all addresses were added.
+     *
+     */
+    ThreadError Add(const ExtAddress *aAddresses, uint8_t aNumAddresses);
+
     /**
      * This method removes an Extended Address to the blacklist filter.
      *
@@ -145,7 +157,18 @@ public:
     Entry *Find(const ExtAddress &aAddress);
 
 private:
+    enum
+    {
+        kHashSize = 64,              ///< Hash index size; power of two above kMaxEntries to keep probes short.
+        kHashMask = kHashSize - 1,   ///< Mask to reduce a hash value to an index slot.
+    };
+
+    uint8_t HashAddress(const uint8_t *aBytes) const;
+    void IndexEntry(uint8_t aEntryIndex);
+    void RebuildIndex(void);
+
     Entry mBlacklist[kMaxEntries];
+    uint8_t mHashIndex[kHashSize];   ///< Entry index plus one, or zero when the slot is empty.
 
     bool mEnabled;
 };
@@ -597,6 +597,22 @@ public:
      */
     void SetLqi(uint8_t aLqi) { mLqi = aLqi; }
 
+    /**
+     * This method returns the receive timestamp captured at SFD detection.
+     *
+     * @returns The receive timestamp in milliseconds on the platform alarm clock.
+     *
+     */
+    uint32_t GetTimestamp(void) const { return mTimestamp; }
+
+    /**
+     * This method sets the receive timestamp.
+     *
+     * @param[in]  aTimestamp  The receive timestamp in milliseconds on the platform alarm clock.
+     *
+     */
+    void SetTimestamp(uint32_t aTimestamp) { mTimestamp = aTimestamp; }
+
     /**
      * This method indicates whether or not frame security was enabled and passed security validation.
      *
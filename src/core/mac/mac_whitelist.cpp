@@ -47,6 +47,39 @@ Whitelist::Whitelist(void)
     {
         mWhitelist[i].mValid = false;
     }
+
+    memset(mHashIndex, 0, sizeof(mHashIndex));
+}
+
+uint8_t Whitelist::HashAddress(const uint8_t *aBytes) const
+{
+    // the low bytes of an EUI-64 carry the most entropy
+    return (aBytes[7] ^ (aBytes[6] << 3) ^ (aBytes[5] << 5)) & kHashMask;
+}
+
+void Whitelist::IndexEntry(uint8_t aEntryIndex)
+{
+    uint8_t slot = HashAddress(mWhitelist[aEntryIndex].mExtAddress.m8);
+
+    while (mHashIndex[slot] != 0)
+    {
+        slot = (slot + 1) & kHashMask;
+    }
+
+    mHashIndex[slot] = aEntryIndex + 1;
+}
+
+void Whitelist::RebuildIndex(void)
+{
+    memset(mHashIndex, 0, sizeof(mHashIndex));
+
+    for (uint8_t i = 0; i < kMaxEntries; i++)
+    {
+        if (mWhitelist[i].mValid)
+        {
+            IndexEntry(i);
+        }
+    }
 }
 
 void Whitelist::Enable(void)
@@ -100,6 +133,7 @@ Whitelist::Entry *Whitelist::Add(const ExtAddress &address)
         memcpy(&mWhitelist[i].mExtAddress, &address, sizeof(mWhitelist[i].mExtAddress));
         mWhitelist[i].mValid = true;
         mWhitelist[i].mFixedRssi = false;
+        IndexEntry(static_cast<uint8_t>(i));
         ExitNow(rval = &mWhitelist[i]);
     }
 
@@ -107,12 +141,46 @@ exit:
     return rval;
 }
 
+ThreadError Whitelist::Add(const ExtAddress *aAddresses, uint8_t aNumAddresses)
+{
+    ThreadError error = kThreadError_None;
+
+    for (uint8_t i = 0; i < aNumAddresses; i++)
+    {
+        VerifyOrExit(Add(aAddresses[i]) != NULL, error = kThreadError_NoBufs);
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Whitelist::SetEntries(const Entry *aEntries, uint8_t aNumEntries)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aNumEntries <= kMaxEntries, error = kThreadError_NoBufs);
+
+    memcpy(mWhitelist, aEntries, aNumEntries * sizeof(Entry));
+
+    for (int i = aNumEntries; i < kMaxEntries; i++)
+    {
+        mWhitelist[i].mValid = false;
+    }
+
+    RebuildIndex();
+
+exit:
+    return error;
+}
+
 void Whitelist::Clear(void)
 {
     for (int i = 0; i < kMaxEntries; i++)
     {
         mWhitelist[i].mValid = false;
     }
+
+    memset(mHashIndex, 0, sizeof(mHashIndex));
 }
 
 void Whitelist::Remove(const ExtAddress &address)
@@ -122,6 +190,9 @@ void Whitelist::Remove(const ExtAddress &address)
     VerifyOrExit((entry = Find(address)) != NULL, ;);
     memset(entry, 0, sizeof(*entry));
 
+    // probe chains may pass through the removed entry, so rebuild the index
+    RebuildIndex();
+
 exit:
     {}
 }
@@ -129,18 +200,26 @@ exit:
 Whitelist::Entry *Whitelist::Find(const ExtAddress &address)
 {
     Entry *rval = NULL;
+    uint8_t slot = HashAddress(address.m8);
 
-    for (int i = 0; i < kMaxEntries; i++)
+    for (int i = 0; i < kHashSize; i++)
     {
-        if (!mWhitelist[i].mValid)
+        uint8_t entryIndex = mHashIndex[slot];
+        Entry *entry;
+
+        if (entryIndex == 0)
         {
-            continue;
+            break;
         }
 
-        if (memcmp(&mWhitelist[i].mExtAddress, &address, sizeof(mWhitelist[i].mExtAddress)) == 0)
+        entry = &mWhitelist[entryIndex - 1];
+
+        if (entry->mValid && memcmp(&entry->mExtAddress, &address, sizeof(entry->mExtAddress)) == 0)
         {
-            ExitNow(rval = &mWhitelist[i]);
+            ExitNow(rval = entry);
         }
+
+        slot = (slot + 1) & kHashMask;
     }
 
 exit:
@@ -60,7 +60,7 @@ public:
 
     enum
     {
-        kMaxEntries = 32,
+        kMaxEntries = OT_MAC_WHITELIST_MAX_ENTRIES,
     };
 
     /**
@@ -120,6 +120,33 @@ public:
      */
     Entry *Add(const ExtAddress &aAddress);
 
+    /**
+     * This method adds a set of Extended Addresses to the whitelist filter.
+     *
+     * @param[in]  aAddresses     A pointer to an array of Extended Addresses.
+     * @param[in]  aNumAddresses  The number of addresses in @p aAddresses.
+     *
+     * @retval kThreadError_None    Successfully added all addresses.
+     * @retval kThreadError_NoBufs  The whitelist filter filled up before all addresses were added.
+     *
+     */
+    ThreadError Add(const ExtAddress *aAddresses, uint8_t aNumAddresses);
+
+    /**
+     * This method replaces the whole whitelist table in one step.
+     *
+     * The entries are validated before any state is touched, so on failure the previous table
+     * remains in effect, and frames looked up after the call see only the new table.
+     *
+     * @param[in]  aEntries     A pointer to an array of whitelist entries.
+     * @param[in]  aNumEntries  The number of entries in @p aEntries.
+     *
+     * @retval kThreadError_None    Successfully replaced the whitelist table.
+     * @retval kThreadError_NoBufs  @p aNumEntries exceeds the whitelist capacity.
+     *
+     */
+    ThreadError SetEntries(const Entry *aEntries, uint8_t aNumEntries);
+
     /**
      * This method removes an Extended Address to the whitelist filter.
      *
@@ -174,7 +201,18 @@ public:
     void SetFixedRssi(Entry &aEntry, int8_t aRssi);
 
 private:
+    enum
+    {
+        kHashSize = 64,              ///< Hash index size; power of two above kMaxEntries to keep probes short.
+        kHashMask = kHashSize - 1,   ///< Mask to reduce a hash value to an index slot.
+    };
+
+    uint8_t HashAddress(const uint8_t *aBytes) const;
+    void IndexEntry(uint8_t aEntryIndex);
+    void RebuildIndex(void);
+
     Entry mWhitelist[kMaxEntries];
+    uint8_t mHashIndex[kHashSize];   ///< Entry index plus one, or zero when the slot is empty.
 
     bool mEnabled;
 };
@@ -41,9 +41,9 @@
 
 #include <coap/coap_header.hpp>
 #include <common/logging.hpp>
+#include <common/random.hpp>
 #include <meshcop/commissioner.hpp>
 #include <meshcop/joiner_router.hpp>
-#include <platform/random.h>
 #include <thread/meshcop_tlvs.hpp>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_tlvs.hpp>
@@ -65,7 +65,7 @@ Commissioner::Commissioner(ThreadNetif &aThreadNetif):
     aThreadNetif.GetCoapServer().AddResource(mRelayReceive);
 }
 
-ThreadError Commissioner::Start(const char *aPSKd)
+OT_TOOL_COLD_CODE ThreadError Commissioner::Start(const char *aPSKd)
 {
     ThreadError error = kThreadError_None;
 
@@ -81,7 +81,7 @@ exit:
     return error;
 }
 
-ThreadError Commissioner::Stop(void)
+OT_TOOL_COLD_CODE ThreadError Commissioner::Stop(void)
 {
     mState = kStateDisabled;
     SendKeepAlive();
@@ -94,7 +94,7 @@ uint16_t Commissioner::GetSessionId(void) const
     return mSessionId;
 }
 
-void Commissioner::HandleTimer(void *aContext)
+OT_TOOL_COLD_CODE void Commissioner::HandleTimer(void *aContext)
 {
     static_cast<Commissioner *>(aContext)->HandleTimer();
 }
@@ -126,10 +126,7 @@ ThreadError Commissioner::SendPetition(void)
     Ip6::MessageInfo messageInfo;
     CommissionerIdTlv commissionerId;
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = otPlatRandomGet() & 0xff;
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -175,10 +172,7 @@ ThreadError Commissioner::SendKeepAlive(void)
     StateTlv state;
     CommissionerSessionIdTlv sessionId;
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = otPlatRandomGet() & 0xff;
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -218,7 +212,7 @@ exit:
     return error;
 }
 
-void Commissioner::HandleRelayReceive(void *aContext, Coap::Header &aHeader,
+OT_TOOL_COLD_CODE void Commissioner::HandleRelayReceive(void *aContext, Coap::Header &aHeader,
                                       Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<Commissioner *>(aContext)->HandleRelayReceive(aHeader, aMessage, aMessageInfo);
@@ -256,7 +250,7 @@ exit:
     return;
 }
 
-void Commissioner::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+OT_TOOL_COLD_CODE void Commissioner::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     static_cast<Commissioner *>(aContext)->HandleUdpReceive(*static_cast<Message *>(aMessage),
                                                             *static_cast<const Ip6::MessageInfo *>(aMessageInfo));
@@ -294,7 +288,7 @@ void Commissioner::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &a
         mState = kStateActive;
         mTimer.Start(5000);
 
-        mNetif.GetDtls().Start(false, HandleDtlsReceive, HandleDtlsSend, this);
+        mNetif.GetDtls().Start(false, NULL, HandleDtlsReceive, HandleDtlsSend, this);
 
         otLogInfoMeshCoP("received petition response\r\n");
         break;
@@ -309,7 +303,7 @@ exit:
     return;
 }
 
-ThreadError Commissioner::HandleDtlsSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
+OT_TOOL_COLD_CODE ThreadError Commissioner::HandleDtlsSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
 {
     otLogInfoMeshCoP("Commissioner::HandleDtlsTransmit\r\n");
     return static_cast<Commissioner *>(aContext)->HandleDtlsSend(aBuf, aLength);
@@ -376,7 +370,7 @@ exit:
     return error;
 }
 
-void Commissioner::HandleDtlsReceive(void *aContext, uint8_t *aBuf, uint16_t aLength)
+OT_TOOL_COLD_CODE void Commissioner::HandleDtlsReceive(void *aContext, uint8_t *aBuf, uint16_t aLength)
 {
     otLogInfoMeshCoP("Commissioner::HandleDtlsReceive\r\n");
     static_cast<Commissioner *>(aContext)->HandleDtlsReceive(aBuf, aLength);
@@ -387,7 +381,7 @@ void Commissioner::HandleDtlsReceive(uint8_t *aBuf, uint16_t aLength)
     ReceiveJoinerFinalize(aBuf, aLength);
 }
 
-void Commissioner::HandleUdpTransmit(void *aContext)
+OT_TOOL_COLD_CODE void Commissioner::HandleUdpTransmit(void *aContext)
 {
     otLogInfoMeshCoP("Commissioner::HandleUdpTransmit\r\n");
     static_cast<Commissioner *>(aContext)->HandleUdpTransmit();
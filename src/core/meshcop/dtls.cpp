@@ -38,6 +38,7 @@
 #include <common/encoding.hpp>
 #include <common/logging.hpp>
 #include <common/timer.hpp>
+#include <crypto/mbedtls.hpp>
 #include <crypto/sha256.hpp>
 #include <meshcop/dtls.hpp>
 #include <thread/thread_netif.hpp>
@@ -48,19 +49,42 @@ namespace Thread {
 namespace MeshCoP {
 
 Dtls::Dtls(ThreadNetif &aNetif):
+    mPskLength(0),
     mStarted(false),
     mTimer(aNetif.GetIp6().mTimerScheduler, &HandleTimer, this),
     mTimerIntermediate(0),
     mTimerSet(false),
+    mProcessTask(aNetif.GetIp6().mTaskletScheduler, &HandleProcessTask, this),
+    mReceiveMessage(NULL),
+    mReceiveLength(0),
+    mHandshakeJobPending(false),
+    mStopDeferred(false),
+    mHandshakeResult(0),
+    mTransmitDeferred(false),
+    mDeferredTimerStatus(-1),
+    mDeferredTimerPending(false),
+    mDeferredTransmitLength(0),
+    mConnectedHandler(NULL),
+    mSessionCacheNext(0),
+    mClientSessionSaved(false),
     mNetif(aNetif)
 {
+    memset(mSessionCache, 0, sizeof(mSessionCache));
+    memset(&mClientSession, 0, sizeof(mClientSession));
+
+    mHandshakeJob.mWork = &HandleHandshakeJob;
+    mHandshakeJob.mDone = &HandleHandshakeDone;
+    mHandshakeJob.mContext = this;
+    mHandshakeJob.mNext = NULL;
 }
 
-ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandler aSendHandler, void *aContext)
+OT_TOOL_COLD_CODE ThreadError Dtls::Start(bool aClient, ConnectedHandler aConnectedHandler, ReceiveHandler aReceiveHandler,
+                        SendHandler aSendHandler, void *aContext)
 {
     static const int ciphersuites[2] = {0xC0FF, 0}; // EC-JPAKE cipher suite
     int rval;
 
+    mConnectedHandler = aConnectedHandler;
     mReceiveHandler = aReceiveHandler;
     mSendHandler = aSendHandler;
     mContext = aContext;
@@ -97,6 +121,7 @@ ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandle
         VerifyOrExit(rval == 0, ;);
 
         mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check, &mCookieCtx);
+        mbedtls_ssl_conf_session_cache(&mConf, this, &HandleMbedtlsGetSession, &HandleMbedtlsSetSession);
     }
 
     rval = mbedtls_ssl_setup(&mSsl, &mConf);
@@ -108,6 +133,12 @@ ThreadError Dtls::Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandle
     rval = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPsk, mPskLength);
     VerifyOrExit(rval == 0, ;);
 
+    // offer to resume the previous session so a reconnect completes in one round trip
+    if (mClient && mClientSessionSaved)
+    {
+        mbedtls_ssl_set_session(&mSsl, &mClientSession);
+    }
+
     mStarted = true;
     Process();
 
@@ -117,8 +148,24 @@ exit:
     return MapError(rval);
 }
 
-ThreadError Dtls::Stop(void)
+OT_TOOL_COLD_CODE ThreadError Dtls::Stop(void)
 {
+    Message *message;
+
+    if (mHandshakeJobPending)
+    {
+        // the worker still owns the ssl context; teardown happens when the job completes
+        mStopDeferred = true;
+        mStarted = false;
+        ExitNow();
+    }
+
+    while ((message = mReceiveQueue.GetHead()) != NULL)
+    {
+        mReceiveQueue.Dequeue(*message);
+        message->Free();
+    }
+
     mStarted = false;
     mbedtls_ssl_close_notify(&mSsl);
     mbedtls_ssl_free(&mSsl);
@@ -126,6 +173,8 @@ ThreadError Dtls::Stop(void)
     mbedtls_ctr_drbg_free(&mCtrDrbg);
     mbedtls_entropy_free(&mEntropy);
     mbedtls_ssl_cookie_free(&mCookieCtx);
+
+exit:
     return kThreadError_None;
 }
 
@@ -135,6 +184,12 @@ ThreadError Dtls::SetPsk(const uint8_t *aPsk, uint8_t aPskLength)
 
     VerifyOrExit(aPskLength <= sizeof(mPsk), error = kThreadError_InvalidArgs);
 
+    // sessions established under the old credentials must not be resumable
+    if (aPskLength != mPskLength || memcmp(aPsk, mPsk, aPskLength) != 0)
+    {
+        ClearSessionCache();
+    }
+
     memcpy(mPsk, aPsk, aPskLength);
     mPskLength = aPskLength;
 
@@ -142,6 +197,14 @@ exit:
     return error;
 }
 
+void Dtls::ClearSessionCache(void)
+{
+    memset(mSessionCache, 0, sizeof(mSessionCache));
+    memset(&mClientSession, 0, sizeof(mClientSession));
+    mSessionCacheNext = 0;
+    mClientSessionSaved = false;
+}
+
 ThreadError Dtls::SetClientId(const uint8_t *aClientId, uint8_t aLength)
 {
     int rval = mbedtls_ssl_set_client_transport_id(&mSsl, aClientId, aLength);
@@ -161,13 +224,63 @@ ThreadError Dtls::Send(const uint8_t *aBuf, uint16_t aLength)
 
 ThreadError Dtls::Receive(Message &aMessage, uint16_t aOffset, uint16_t aLength)
 {
-    mReceiveMessage = &aMessage;
-    mReceiveOffset = aOffset;
-    mReceiveLength = aLength;
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
 
-    Process();
+    // queue the record and run the crypto from a tasklet so the receive path is not
+    // stalled for the duration of a handshake flight
+    VerifyOrExit((message = mNetif.GetIp6().NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    SuccessOrExit(error = message->SetLength(aLength));
+    aMessage.CopyTo(aOffset, 0, aLength, *message);
 
-    return kThreadError_None;
+    mReceiveQueue.Enqueue(*message);
+    mProcessTask.Post();
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+OT_TOOL_COLD_CODE void Dtls::HandleProcessTask(void *aContext)
+{
+    static_cast<Dtls *>(aContext)->HandleProcessTask();
+}
+
+void Dtls::HandleProcessTask(void)
+{
+    Message *message;
+
+    VerifyOrExit(!mHandshakeJobPending, ;);
+
+    while ((message = mReceiveQueue.GetHead()) != NULL)
+    {
+        mReceiveQueue.Dequeue(*message);
+
+        mReceiveMessage = message;
+        mReceiveIterator.Init(*static_cast<const Message *>(message), 0, message->GetLength());
+        mReceiveLength = message->GetLength();
+
+        Process();
+
+        if (mHandshakeJobPending)
+        {
+            // the worker still draws record bytes from this message; it is
+            // released when the handshake step completes
+            ExitNow();
+        }
+
+        mReceiveMessage = NULL;
+        mReceiveLength = 0;
+        message->Free();
+    }
+
+exit:
+    return;
 }
 
 int Dtls::HandleMbedtlsTransmit(void *aContext, const unsigned char *aBuf, size_t aLength)
@@ -182,6 +295,21 @@ int Dtls::HandleMbedtlsTransmit(const unsigned char *aBuf, size_t aLength)
 
     otLogInfoMeshCoP("Dtls::HandleMbedtlsTransmit\r\n");
 
+    if (mTransmitDeferred)
+    {
+        // the handshake step runs on a worker thread; buffer the record with a length
+        // prefix and replay it through the send handler on the OpenThread thread
+        VerifyOrExit(mDeferredTransmitLength + sizeof(uint16_t) + aLength <= sizeof(mDeferredTransmit),
+                     rval = MBEDTLS_ERR_SSL_WANT_WRITE);
+
+        mDeferredTransmit[mDeferredTransmitLength++] = (aLength >> 8) & 0xff;
+        mDeferredTransmit[mDeferredTransmitLength++] = aLength & 0xff;
+        memcpy(mDeferredTransmit + mDeferredTransmitLength, aBuf, aLength);
+        mDeferredTransmitLength += static_cast<uint16_t>(aLength);
+
+        ExitNow(rval = static_cast<int>(aLength));
+    }
+
     error = mSendHandler(mContext, aBuf, (uint16_t)aLength);
 
     switch (error)
@@ -199,6 +327,7 @@ int Dtls::HandleMbedtlsTransmit(const unsigned char *aBuf, size_t aLength)
         break;
     }
 
+exit:
     return rval;
 }
 
@@ -220,8 +349,7 @@ int Dtls::HandleMbedtlsReceive(unsigned char *aBuf, size_t aLength)
         aLength = mReceiveLength;
     }
 
-    rval = (int)mReceiveMessage->Read(mReceiveOffset, (uint16_t)aLength, aBuf);
-    mReceiveOffset += static_cast<uint16_t>(rval);
+    rval = (int)mReceiveIterator.Read((uint16_t)aLength, aBuf);
     mReceiveLength -= static_cast<uint16_t>(rval);
 
 exit:
@@ -239,6 +367,13 @@ int Dtls::HandleMbedtlsGetTimer(void)
 
     otLogInfoMeshCoP("Dtls::HandleMbedtlsGetTimer\r\n");
 
+    if (mTransmitDeferred)
+    {
+        // on the worker thread the live timer state may not be read; report the
+        // snapshot taken when the job was posted
+        ExitNow(rval = mDeferredTimerStatus);
+    }
+
     if (!mTimerSet)
     {
         rval = -1;
@@ -256,10 +391,11 @@ int Dtls::HandleMbedtlsGetTimer(void)
         rval = 0;
     }
 
+exit:
     return rval;
 }
 
-void Dtls::HandleMbedtlsSetTimer(void *aContext, uint32_t aIntermediate, uint32_t aFinish)
+OT_TOOL_COLD_CODE void Dtls::HandleMbedtlsSetTimer(void *aContext, uint32_t aIntermediate, uint32_t aFinish)
 {
     static_cast<Dtls *>(aContext)->HandleMbedtlsSetTimer(aIntermediate, aFinish);
 }
@@ -268,6 +404,16 @@ void Dtls::HandleMbedtlsSetTimer(uint32_t aIntermediate, uint32_t aFinish)
 {
     otLogInfoMeshCoP("Dtls::SetTimer\r\n");
 
+    if (mTransmitDeferred)
+    {
+        // the timer scheduler may only be touched from the OpenThread thread;
+        // record the request and apply it when the job completes
+        mDeferredTimerPending = true;
+        mDeferredTimerIntermediate = aIntermediate;
+        mDeferredTimerFinish = aFinish;
+        ExitNow();
+    }
+
     if (aFinish == 0)
     {
         mTimerSet = false;
@@ -279,6 +425,9 @@ void Dtls::HandleMbedtlsSetTimer(uint32_t aIntermediate, uint32_t aFinish)
         mTimer.Start(aFinish);
         mTimerIntermediate = Timer::GetNow() + aIntermediate;
     }
+
+exit:
+    return;
 }
 
 int Dtls::HandleMbedtlsExportKeys(void *aContext, const unsigned char *aMasterSecret, const unsigned char *aKeyBlock,
@@ -306,7 +455,78 @@ int Dtls::HandleMbedtlsExportKeys(const unsigned char *aMasterSecret, const unsi
     return 0;
 }
 
-void Dtls::HandleTimer(void *aContext)
+int Dtls::HandleMbedtlsGetSession(void *aContext, mbedtls_ssl_session *aSession)
+{
+    return static_cast<Dtls *>(aContext)->HandleMbedtlsGetSession(*aSession);
+}
+
+int Dtls::HandleMbedtlsGetSession(mbedtls_ssl_session &aSession)
+{
+    int rval = 1;
+
+    VerifyOrExit(aSession.id_len > 0, ;);
+
+    for (int i = 0; i < kSessionCacheEntries; i++)
+    {
+        if (mSessionCache[i].mValid &&
+            mSessionCache[i].mSession.id_len == aSession.id_len &&
+            memcmp(mSessionCache[i].mSession.id, aSession.id, aSession.id_len) == 0 &&
+            mSessionCache[i].mSession.ciphersuite == aSession.ciphersuite)
+        {
+            aSession = mSessionCache[i].mSession;
+            otLogInfoMeshCoP("DTLS session resumed\r\n");
+            ExitNow(rval = 0);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+int Dtls::HandleMbedtlsSetSession(void *aContext, const mbedtls_ssl_session *aSession)
+{
+    return static_cast<Dtls *>(aContext)->HandleMbedtlsSetSession(*aSession);
+}
+
+int Dtls::HandleMbedtlsSetSession(const mbedtls_ssl_session &aSession)
+{
+    int rval = 1;
+    int slot = -1;
+
+    VerifyOrExit(aSession.id_len > 0, ;);
+
+    for (int i = 0; i < kSessionCacheEntries; i++)
+    {
+        if (mSessionCache[i].mValid &&
+            mSessionCache[i].mSession.id_len == aSession.id_len &&
+            memcmp(mSessionCache[i].mSession.id, aSession.id, aSession.id_len) == 0)
+        {
+            slot = i;
+            break;
+        }
+
+        if (slot < 0 && !mSessionCache[i].mValid)
+        {
+            slot = i;
+        }
+    }
+
+    if (slot < 0)
+    {
+        // evict round-robin when full
+        slot = mSessionCacheNext;
+        mSessionCacheNext = static_cast<uint8_t>((mSessionCacheNext + 1) % kSessionCacheEntries);
+    }
+
+    mSessionCache[slot].mSession = aSession;
+    mSessionCache[slot].mValid = true;
+    rval = 0;
+
+exit:
+    return rval;
+}
+
+OT_TOOL_COLD_CODE void Dtls::HandleTimer(void *aContext)
 {
     static_cast<Dtls *>(aContext)->HandleTimer();
 }
@@ -321,34 +541,158 @@ void Dtls::Process(void)
     uint8_t buf[MBEDTLS_SSL_MAX_CONTENT_LEN];
     int rval;
 
-    while (mStarted)
+    VerifyOrExit(mStarted && !mHandshakeJobPending, ;);
+
+    if (mSsl.state != MBEDTLS_SSL_HANDSHAKE_OVER)
     {
-        if (mSsl.state != MBEDTLS_SSL_HANDSHAKE_OVER)
+        // run the handshake step on a platform worker when one is available so the
+        // crypto does not stall the event loop; output records and timer requests
+        // are buffered and applied when the job completes
+        mDeferredTimerStatus = HandleMbedtlsGetTimer();
+        mDeferredTimerPending = false;
+        mDeferredTransmitLength = 0;
+        mTransmitDeferred = true;
+
+        if (otPlatWorkerPost(&mHandshakeJob))
         {
-            rval = mbedtls_ssl_handshake(&mSsl);
+            mHandshakeJobPending = true;
+            ExitNow();
         }
-        else
+
+        mTransmitDeferred = false;
+        RunHandshake();
+        FinishHandshakeStep();
+    }
+    else
+    {
+        while (mStarted)
         {
             rval = mbedtls_ssl_read(&mSsl, buf, sizeof(buf));
+
+            if (rval > 0)
+            {
+                mReceiveHandler(mContext, buf, static_cast<uint16_t>(rval));
+            }
+            else if (rval == 0 || rval == MBEDTLS_ERR_SSL_WANT_READ || rval == MBEDTLS_ERR_SSL_WANT_WRITE)
+            {
+                break;
+            }
+            else
+            {
+                mbedtls_ssl_session_reset(&mSsl);
+                mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPsk, mPskLength);
+
+                if (mClient && mClientSessionSaved)
+                {
+                    mbedtls_ssl_set_session(&mSsl, &mClientSession);
+                }
+
+                break;
+            }
         }
+    }
+
+exit:
+    return;
+}
+
+void Dtls::RunHandshake(void)
+{
+    // keep per-handshake churn out of the long-lived session region
+    Crypto::MbedTls::SetScratchMode(true);
+    mHandshakeResult = mbedtls_ssl_handshake(&mSsl);
+    Crypto::MbedTls::SetScratchMode(false);
+}
 
-        if (rval > 0)
+void Dtls::FinishHandshakeStep(void)
+{
+    int rval = mHandshakeResult;
+
+    if (mSsl.state == MBEDTLS_SSL_HANDSHAKE_OVER)
+    {
+        // retain the established session so the next connect may resume it
+        if (mClient)
         {
-            mReceiveHandler(mContext, buf, static_cast<uint16_t>(rval));
+            mClientSessionSaved = (mbedtls_ssl_get_session(&mSsl, &mClientSession) == 0);
         }
-        else if (rval == 0 || rval == MBEDTLS_ERR_SSL_WANT_READ || rval == MBEDTLS_ERR_SSL_WANT_WRITE)
+
+        if (mConnectedHandler != NULL)
         {
-            break;
+            mConnectedHandler(mContext);
         }
-        else
+    }
+
+    if (rval != 0 && rval != MBEDTLS_ERR_SSL_WANT_READ && rval != MBEDTLS_ERR_SSL_WANT_WRITE)
+    {
+        mbedtls_ssl_session_reset(&mSsl);
+        mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPsk, mPskLength);
+
+        if (mClient && mClientSessionSaved)
         {
-            mbedtls_ssl_session_reset(&mSsl);
-            mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mPsk, mPskLength);
-            break;
+            mbedtls_ssl_set_session(&mSsl, &mClientSession);
         }
     }
 }
 
+void Dtls::HandleHandshakeJob(otPlatWorkerJob *aJob)
+{
+    static_cast<Dtls *>(aJob->mContext)->RunHandshake();
+}
+
+void Dtls::HandleHandshakeDone(otPlatWorkerJob *aJob)
+{
+    static_cast<Dtls *>(aJob->mContext)->HandleHandshakeDone();
+}
+
+void Dtls::HandleHandshakeDone(void)
+{
+    uint16_t offset = 0;
+    uint16_t length;
+
+    mHandshakeJobPending = false;
+    mTransmitDeferred = false;
+
+    if (mReceiveMessage != NULL)
+    {
+        mReceiveMessage->Free();
+        mReceiveMessage = NULL;
+        mReceiveLength = 0;
+    }
+
+    if (mStopDeferred)
+    {
+        mStopDeferred = false;
+        mDeferredTransmitLength = 0;
+        Stop();
+        ExitNow();
+    }
+
+    // replay the records the worker produced through the real transmit path
+    while (offset < mDeferredTransmitLength)
+    {
+        length = static_cast<uint16_t>((mDeferredTransmit[offset] << 8) | mDeferredTransmit[offset + 1]);
+        offset += sizeof(uint16_t);
+        HandleMbedtlsTransmit(mDeferredTransmit + offset, length);
+        offset += length;
+    }
+
+    mDeferredTransmitLength = 0;
+
+    if (mDeferredTimerPending)
+    {
+        mDeferredTimerPending = false;
+        HandleMbedtlsSetTimer(mDeferredTimerIntermediate, mDeferredTimerFinish);
+    }
+
+    FinishHandshakeStep();
+
+    // continue with any records queued while the job was in flight
+    mProcessTask.Post();
+
+exit:
+    return;
+}
+
 ThreadError Dtls::MapError(int rval)
 {
     ThreadError error = kThreadError_None;
@@ -371,7 +715,7 @@ ThreadError Dtls::MapError(int rval)
     return error;
 }
 
-void Dtls::HandleMbedtlsDebug(void *ctx, int level, const char *file, int line, const char *str)
+OT_TOOL_COLD_CODE void Dtls::HandleMbedtlsDebug(void *ctx, int level, const char *file, int line, const char *str)
 {
     otLogInfoMeshCoP("%s:%04d: %s\r\n", file, line, str);
     (void)ctx;
@@ -36,8 +36,10 @@
 
 #include <openthread-types.h>
 #include <common/message.hpp>
+#include <common/tasklet.hpp>
 #include <common/timer.hpp>
 #include <crypto/sha256.hpp>
+#include <platform/worker.h>
 
 #include <mbedtls/ssl.h>
 #include <mbedtls/entropy.h>
@@ -83,18 +85,28 @@ public:
      */
     typedef ThreadError(*SendHandler)(void *aContext, const uint8_t *aBuf, uint16_t aLength);
 
+    /**
+     * This function pointer is called when the DTLS handshake completes.
+     *
+     * @param[in]  aContext  A pointer to application-specific context.
+     *
+     */
+    typedef void (*ConnectedHandler)(void *aContext);
+
     /**
      * This method starts the DTLS service.
      *
-     * @param[in]  aClient          TRUE if operating as a client, FALSE if operating as a server.
-     * @param[in]  aReceiveHandler  A pointer to the receive handler.
-     * @param[in]  aSendHandler     A pointer to the send handler.
-     * @param[in]  aContext         A pointer to application-specific context.
+     * @param[in]  aClient            TRUE if operating as a client, FALSE if operating as a server.
+     * @param[in]  aConnectedHandler  A pointer to the connected handler, or NULL if not needed.
+     * @param[in]  aReceiveHandler    A pointer to the receive handler.
+     * @param[in]  aSendHandler       A pointer to the send handler.
+     * @param[in]  aContext           A pointer to application-specific context.
      *
      * @retval kThreadError_None  Successfully started the DTLS service.
      *
      */
-    ThreadError Start(bool aClient, ReceiveHandler aReceiveHandler, SendHandler aSendHandler, void *aContext);
+    ThreadError Start(bool aClient, ConnectedHandler aConnectedHandler, ReceiveHandler aReceiveHandler,
+                      SendHandler aSendHandler, void *aContext);
 
     /**
      * This method stops the DTLS service.
@@ -149,11 +161,15 @@ public:
     /**
      * This method provides a received DTLS message to the DTLS object.
      *
+     * The record is queued and the crypto runs from a tasklet, so the caller's receive path
+     * returns without waiting on the record processing.
+     *
      * @param[in]  aMessage  A reference to the message.
      * @param[in]  aOffset   The offset within @p aMessage where the DTLS message starts.
      * @param[in]  aLength   The size of the DTLS message (bytes).
      *
-     * @retval kThreadError_None  Successfully processed the received DTLS message.
+     * @retval kThreadError_None    Successfully queued the received DTLS message.
+     * @retval kThreadError_NoBufs  Insufficient buffers to queue the received DTLS message.
      *
      */
     ThreadError Receive(Message &aMessage, uint16_t aOffset, uint16_t aLength);
@@ -162,6 +178,21 @@ private:
     enum
     {
         kPskMaxLength = 32,
+        kSessionCacheEntries = 2,        ///< Number of server-side sessions retained for resumption.
+        kDeferredTransmitSize = 1024,    ///< Buffer space for records produced during an offloaded handshake step.
+    };
+
+    /**
+     * This structure holds one cached DTLS session for resumption.
+     *
+     * With certificates and tickets disabled mbedtls_ssl_session holds no pointers, so entries
+     * may be copied by assignment and survive Stop()/Start() cycles.
+     *
+     */
+    struct SessionCacheEntry
+    {
+        mbedtls_ssl_session mSession;  ///< The cached session.
+        bool                mValid;    ///< TRUE if this entry holds a session.
     };
 
     static ThreadError MapError(int rval);
@@ -186,10 +217,26 @@ private:
     int HandleMbedtlsExportKeys(const unsigned char *aMasterSecret, const unsigned char *aKeyBlock,
                                 size_t aMacLength, size_t aKeyLength, size_t aIvLength);
 
+    static int HandleMbedtlsGetSession(void *aContext, mbedtls_ssl_session *aSession);
+    int HandleMbedtlsGetSession(mbedtls_ssl_session &aSession);
+
+    static int HandleMbedtlsSetSession(void *aContext, const mbedtls_ssl_session *aSession);
+    int HandleMbedtlsSetSession(const mbedtls_ssl_session &aSession);
+
     static void HandleTimer(void *aContext);
     void HandleTimer(void);
 
+    static void HandleProcessTask(void *aContext);
+    void HandleProcessTask(void);
+
     void Process(void);
+    void ClearSessionCache(void);
+
+    static void HandleHandshakeJob(otPlatWorkerJob *aJob);
+    static void HandleHandshakeDone(otPlatWorkerJob *aJob);
+    void HandleHandshakeDone(void);
+    void RunHandshake(void);
+    void FinishHandshakeStep(void);
 
     uint8_t mPsk[kPskMaxLength];
     uint8_t mPskLength;
@@ -205,15 +252,39 @@ private:
     uint32_t mTimerIntermediate;
     bool mTimerSet;
 
+    Tasklet mProcessTask;
+    MessageQueue mReceiveQueue;
+
     Message *mReceiveMessage;
-    uint16_t mReceiveOffset;
+    Message::ChunkIterator mReceiveIterator;
     uint16_t mReceiveLength;
 
+    // state for running the handshake step on a platform worker; while a job is in
+    // flight the ssl context is owned by the worker thread and records it produces
+    // are buffered for replay on the OpenThread thread
+    otPlatWorkerJob mHandshakeJob;
+    bool mHandshakeJobPending;
+    bool mStopDeferred;
+    int mHandshakeResult;
+    bool mTransmitDeferred;
+    int mDeferredTimerStatus;
+    bool mDeferredTimerPending;
+    uint32_t mDeferredTimerIntermediate;
+    uint32_t mDeferredTimerFinish;
+    uint16_t mDeferredTransmitLength;
+    uint8_t mDeferredTransmit[kDeferredTransmitSize];
+
+    ConnectedHandler mConnectedHandler;
     ReceiveHandler mReceiveHandler;
     SendHandler mSendHandler;
     void *mContext;
     bool mClient;
 
+    SessionCacheEntry mSessionCache[kSessionCacheEntries];
+    uint8_t mSessionCacheNext;
+    mbedtls_ssl_session mClientSession;
+    bool mClientSessionSaved;
+
     ThreadNetif &mNetif;
 };
 
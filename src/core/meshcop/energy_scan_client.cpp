@@ -57,7 +57,7 @@ EnergyScanClient::EnergyScanClient(ThreadNetif &aThreadNetif) :
     mSocket.Open(HandleUdpReceive, this);
 }
 
-ThreadError EnergyScanClient::SendQuery(uint32_t aChannelMask, uint8_t aCount, uint16_t aPeriod,
+OT_TOOL_COLD_CODE ThreadError EnergyScanClient::SendQuery(uint32_t aChannelMask, uint8_t aCount, uint16_t aPeriod,
                                         uint16_t aScanDuration, const Ip6::Address &aAddress,
                                         otCommissionerEnergyReportCallback aCallback, void *aContext)
 {
@@ -140,7 +140,7 @@ exit:
     return error;
 }
 
-void EnergyScanClient::HandleReport(void *aContext, Coap::Header &aHeader, Message &aMessage,
+OT_TOOL_COLD_CODE void EnergyScanClient::HandleReport(void *aContext, Coap::Header &aHeader, Message &aMessage,
                                     const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<EnergyScanClient *>(aContext)->HandleReport(aHeader, aMessage, aMessageInfo);
@@ -219,7 +219,7 @@ exit:
     return error;
 }
 
-void EnergyScanClient::HandleTimer(void *aContext)
+OT_TOOL_COLD_CODE void EnergyScanClient::HandleTimer(void *aContext)
 {
     static_cast<EnergyScanClient *>(aContext)->HandleTimer();
 }
@@ -228,7 +228,7 @@ void EnergyScanClient::HandleTimer(void)
 {
 }
 
-void EnergyScanClient::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+OT_TOOL_COLD_CODE void EnergyScanClient::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     otLogInfoMeshCoP("received energy scan query response\r\n");
     (void)aContext;
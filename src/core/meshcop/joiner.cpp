@@ -43,9 +43,9 @@
 #include <common/code_utils.hpp>
 #include <common/encoding.hpp>
 #include <common/logging.hpp>
+#include <common/random.hpp>
 #include <meshcop/joiner.hpp>
 #include <platform/radio.h>
-#include <platform/random.h>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_uris.hpp>
 
@@ -64,7 +64,7 @@ Joiner::Joiner(ThreadNetif &aNetif):
     mNetif.GetCoapServer().AddResource(mJoinerEntrust);
 }
 
-ThreadError Joiner::Start(const char *aPSKd)
+OT_TOOL_COLD_CODE ThreadError Joiner::Start(const char *aPSKd)
 {
     ThreadError error;
     Mac::ExtAddress extAddress;
@@ -82,7 +82,7 @@ exit:
     return error;
 }
 
-ThreadError Joiner::Stop(void)
+OT_TOOL_COLD_CODE ThreadError Joiner::Stop(void)
 {
     mNetif.GetIp6Filter().RemoveUnsecurePort(mSocket.GetSockName().mPort);
     mSocket.Close();
@@ -90,7 +90,7 @@ ThreadError Joiner::Stop(void)
     return kThreadError_None;
 }
 
-void Joiner::HandleDiscoverResult(otActiveScanResult *aResult, void *aContext)
+OT_TOOL_COLD_CODE void Joiner::HandleDiscoverResult(otActiveScanResult *aResult, void *aContext)
 {
     static_cast<Joiner *>(aContext)->HandleDiscoverResult(aResult);
 }
@@ -113,11 +113,11 @@ void Joiner::HandleDiscoverResult(otActiveScanResult *aResult)
         mNetif.GetMac().SetChannel(mJoinerRouterChannel);
         mNetif.GetIp6Filter().AddUnsecurePort(sockaddr.mPort);
 
-        mNetif.GetDtls().Start(true, HandleDtlsReceive, HandleDtlsSend, this);
+        mNetif.GetDtls().Start(true, HandleDtlsConnected, HandleDtlsReceive, HandleDtlsSend, this);
     }
 }
 
-ThreadError Joiner::HandleDtlsSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
+OT_TOOL_COLD_CODE ThreadError Joiner::HandleDtlsSend(void *aContext, const uint8_t *aBuf, uint16_t aLength)
 {
     otLogInfoMeshCoP("Joiner::HandleDtlsTransmit\r\n");
     return static_cast<Joiner *>(aContext)->HandleDtlsSend(aBuf, aLength);
@@ -147,7 +147,18 @@ exit:
     return error;
 }
 
-void Joiner::HandleDtlsReceive(void *aContext, uint8_t *aBuf, uint16_t aLength)
+OT_TOOL_COLD_CODE void Joiner::HandleDtlsConnected(void *aContext)
+{
+    otLogInfoMeshCoP("Joiner::HandleDtlsConnected\r\n");
+    static_cast<Joiner *>(aContext)->HandleDtlsConnected();
+}
+
+void Joiner::HandleDtlsConnected(void)
+{
+    SendJoinerFinalize();
+}
+
+OT_TOOL_COLD_CODE void Joiner::HandleDtlsReceive(void *aContext, uint8_t *aBuf, uint16_t aLength)
 {
     otLogInfoMeshCoP("Joiner::HandleDtlsReceive\r\n");
     static_cast<Joiner *>(aContext)->HandleDtlsReceive(aBuf, aLength);
@@ -158,7 +169,7 @@ void Joiner::HandleDtlsReceive(uint8_t *aBuf, uint16_t aLength)
     ReceiveJoinerFinalizeResponse(aBuf, aLength);
 }
 
-void Joiner::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+OT_TOOL_COLD_CODE void Joiner::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     otLogInfoMeshCoP("Joiner::HandleUdpReceive\r\n");
     static_cast<Joiner *>(aContext)->HandleUdpReceive(*static_cast<Message *>(aMessage),
@@ -170,14 +181,9 @@ void Joiner::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessag
     (void)aMessageInfo;
 
     mNetif.GetDtls().Receive(aMessage, aMessage.GetOffset(), aMessage.GetLength() - aMessage.GetOffset());
-
-    if (mNetif.GetDtls().IsConnected())
-    {
-        SendJoinerFinalize();
-    }
 }
 
-void Joiner::HandleUdpTransmit(void *aContext)
+OT_TOOL_COLD_CODE void Joiner::HandleUdpTransmit(void *aContext)
 {
     otLogInfoMeshCoP("Joiner::HandleUdpTransmit\r\n");
     static_cast<Joiner *>(aContext)->HandleUdpTransmit();
@@ -261,7 +267,7 @@ exit:
     return;
 }
 
-void Joiner::HandleJoinerEntrust(void *aContext, Coap::Header &aHeader,
+OT_TOOL_COLD_CODE void Joiner::HandleJoinerEntrust(void *aContext, Coap::Header &aHeader,
                                  Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<Joiner *>(aContext)->HandleJoinerEntrust(aHeader, aMessage, aMessageInfo);
@@ -306,10 +312,7 @@ void Joiner::HandleJoinerEntrust(Coap::Header &aHeader, Message &aMessage, const
     otLogInfoMeshCoP("join success!\r\n");
 
     // configure a random Extended Address
-    for (size_t i = 0; i < sizeof(extAddress); i++)
-    {
-        extAddress.m8[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(extAddress.m8, sizeof(extAddress.m8));
 
     mNetif.GetMac().SetExtAddress(extAddress);
     mNetif.GetMle().UpdateLinkLocalAddress();
@@ -43,6 +43,8 @@
 #include <thread/thread_netif.hpp>
 #include <thread/thread_uris.hpp>
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
 using Thread::Encoding::BigEndian::HostSwap16;
 
 namespace Thread {
@@ -51,6 +53,7 @@ namespace MeshCoP {
 JoinerRouter::JoinerRouter(ThreadNetif &aNetif):
     mSocket(aNetif.GetIp6().mUdp),
     mRelayTransmit(OPENTHREAD_URI_RELAY_TX, &HandleRelayTransmit, this),
+    mTimer(aNetif.GetIp6().mTimerScheduler, &HandleTimer, this),
     mNetif(aNetif)
 {
     mSocket.GetSockName().mPort = OPENTHREAD_CONFIG_JOINER_UDP_PORT;
@@ -59,7 +62,7 @@ JoinerRouter::JoinerRouter(ThreadNetif &aNetif):
     mNetif.RegisterCallback(mNetifCallback);
 }
 
-void JoinerRouter::HandleNetifStateChanged(uint32_t aFlags, void *aContext)
+OT_TOOL_COLD_CODE void JoinerRouter::HandleNetifStateChanged(uint32_t aFlags, void *aContext)
 {
     static_cast<JoinerRouter *>(aContext)->HandleNetifStateChanged(aFlags);
 }
@@ -152,7 +155,7 @@ exit:
     return error;
 }
 
-void JoinerRouter::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+OT_TOOL_COLD_CODE void JoinerRouter::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     static_cast<JoinerRouter *>(aContext)->HandleUdpReceive(*static_cast<Message *>(aMessage),
                                                             *static_cast<const Ip6::MessageInfo *>(aMessageInfo));
@@ -163,17 +166,17 @@ void JoinerRouter::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &a
     ThreadError error;
     Message *message = NULL;
     Coap::Header header;
-    Ip6::MessageInfo messageInfo;
     JoinerUdpPortTlv udpPort;
     JoinerIidTlv iid;
     ExtendedTlv tlv;
     uint16_t borderAgentRloc;
+    uint16_t offset;
 
     otLogInfoMeshCoP("JoinerRouter::HandleUdpReceive\r\n");
 
     SuccessOrExit(error = GetBorderAgentRloc(borderAgentRloc));
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityHigh)) != NULL, error = kThreadError_NoBufs);
 
     header.Init();
     header.SetVersion(1);
@@ -198,21 +201,42 @@ void JoinerRouter::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &a
     tlv.SetLength(aMessage.GetLength() - aMessage.GetOffset());
     SuccessOrExit(error = message->Append(&tlv, sizeof(tlv)));
 
-    while (aMessage.GetOffset() < aMessage.GetLength())
+    offset = message->GetLength();
+    SuccessOrExit(error = message->SetLength(offset + tlv.GetLength()));
+    aMessage.CopyTo(aMessage.GetOffset(), offset, tlv.GetLength(), *message);
+
+    if (mDelayedRelays.GetHead() != NULL ||
+        mNetif.GetIp6().mMessagePool.GetFreeBufferCount() < kFreeBufferThreshold)
     {
-        uint16_t length = aMessage.GetLength() - aMessage.GetOffset();
-        uint8_t tmp[16];
+        // pace relay transmissions while the buffer pool is stressed so the joiner's
+        // DTLS retransmission timers see delay rather than silent loss
+        mDelayedRelays.Enqueue(*message);
+        mTimer.Start(kDelayedRelayInterval);
 
-        if (length >= sizeof(tmp))
-        {
-            length = sizeof(tmp);
-        }
+        otLogInfoMeshCoP("Delayed relay rx\r\n");
+    }
+    else
+    {
+        SuccessOrExit(error = SendRelayRx(*message));
 
-        aMessage.Read(aMessage.GetOffset(), length, tmp);
-        aMessage.MoveOffset(length);
+        otLogInfoMeshCoP("Sent relay rx\r\n");
+    }
 
-        SuccessOrExit(error = message->Append(tmp, length));
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
     }
+}
+
+ThreadError JoinerRouter::SendRelayRx(Message &aMessage)
+{
+    ThreadError error;
+    Ip6::MessageInfo messageInfo;
+    uint16_t borderAgentRloc;
+
+    SuccessOrExit(error = GetBorderAgentRloc(borderAgentRloc));
 
     memset(&messageInfo, 0, sizeof(messageInfo));
     memcpy(messageInfo.GetPeerAddr().mFields.m8, mNetif.GetMle().GetMeshLocalPrefix(), 8);
@@ -221,19 +245,44 @@ void JoinerRouter::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &a
     messageInfo.GetPeerAddr().mFields.m16[7] = HostSwap16(borderAgentRloc);
     messageInfo.mPeerPort = kCoapUdpPort;
 
-    SuccessOrExit(error = mSocket.SendTo(*message, messageInfo));
-
-    otLogInfoMeshCoP("Sent relay rx\r\n");
+    SuccessOrExit(error = mSocket.SendTo(aMessage, messageInfo));
 
 exit:
+    return error;
+}
 
-    if (error != kThreadError_None && message != NULL)
+OT_TOOL_COLD_CODE void JoinerRouter::HandleTimer(void *aContext)
+{
+    static_cast<JoinerRouter *>(aContext)->HandleTimer();
+}
+
+void JoinerRouter::HandleTimer(void)
+{
+    Message *message;
+
+    VerifyOrExit((message = mDelayedRelays.GetHead()) != NULL, ;);
+
+    mDelayedRelays.Dequeue(*message);
+
+    if (SendRelayRx(*message) != kThreadError_None)
     {
         message->Free();
     }
+    else
+    {
+        otLogInfoMeshCoP("Sent relay rx\r\n");
+    }
+
+    if (mDelayedRelays.GetHead() != NULL)
+    {
+        mTimer.Start(kDelayedRelayInterval);
+    }
+
+exit:
+    return;
 }
 
-void JoinerRouter::HandleRelayTransmit(void *aContext, Coap::Header &aHeader,
+OT_TOOL_COLD_CODE void JoinerRouter::HandleRelayTransmit(void *aContext, Coap::Header &aHeader,
                                        Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<JoinerRouter *>(aContext)->HandleRelayTransmit(aHeader, aMessage, aMessageInfo);
@@ -263,26 +312,10 @@ void JoinerRouter::HandleRelayTransmit(Coap::Header &aHeader, Message &aMessage,
 
     SuccessOrExit(error = Tlv::GetValueOffset(aMessage, Tlv::kJoinerDtlsEncapsulation, offset, length));
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    VerifyOrExit((message = mSocket.NewMessage(0, Message::kPriorityHigh)) != NULL, error = kThreadError_NoBufs);
     message->SetLinkSecurityEnabled(false);
 
-    while (length)
-    {
-        uint16_t copyLength = length;
-        uint8_t tmp[16];
-
-        if (copyLength >= sizeof(tmp))
-        {
-            copyLength = sizeof(tmp);
-        }
-
-        aMessage.Read(offset, copyLength, tmp);
-        SuccessOrExit(error = message->Append(tmp, copyLength));
-
-        offset += copyLength;
-        length -= copyLength;
-    }
-
+    SuccessOrExit(error = message->SetLength(length));
     aMessage.CopyTo(offset, 0, length, *message);
 
     memset(&messageInfo, 0, sizeof(messageInfo));
@@ -414,3 +447,5 @@ exit:
 
 }  // namespace Dtls
 }  // namespace Thread
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
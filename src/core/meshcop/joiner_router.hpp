@@ -34,11 +34,13 @@
 #ifndef JOINER_ROUTER_HPP_
 #define JOINER_ROUTER_HPP_
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 
 #include <coap/coap_header.hpp>
 #include <coap/coap_server.hpp>
 #include <common/message.hpp>
+#include <common/timer.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/udp6.hpp>
 
@@ -60,9 +62,18 @@ public:
     JoinerRouter(ThreadNetif &aNetif);
 
 private:
+    enum
+    {
+        kDelayedRelayInterval = 10,  ///< Delay between paced relay transmissions (milliseconds).
+        kFreeBufferThreshold  = 8,   ///< Relays are paced while fewer buffers than this are free.
+    };
+
     static void HandleNetifStateChanged(uint32_t aFlags, void *aContext);
     void HandleNetifStateChanged(uint32_t aFlags);
 
+    static void HandleTimer(void *aContext);
+    void HandleTimer(void);
+
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
@@ -71,6 +82,7 @@ private:
     void HandleRelayTransmit(Coap::Header &aHeader, Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
     ThreadError SendJoinerEntrust(const Ip6::MessageInfo &aMessageInfo);
+    ThreadError SendRelayRx(Message &aMessage);
 
     ThreadError GetBorderAgentRloc(uint16_t &aRloc);
     ThreadError GetJoinerPort(uint16_t &aRloc);
@@ -79,6 +91,8 @@ private:
 
     Ip6::UdpSocket mSocket;
     Coap::Resource mRelayTransmit;
+    Timer mTimer;
+    MessageQueue mDelayedRelays;
     ThreadNetif &mNetif;
 };
 
@@ -42,6 +42,8 @@
 #include <thread/thread_tlvs.hpp>
 #include <thread/thread_uris.hpp>
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
 namespace Thread {
 namespace MeshCoP {
 
@@ -56,7 +58,7 @@ Leader::Leader(ThreadNetif &aThreadNetif):
     mCoapServer.AddResource(mKeepAlive);
 }
 
-void Leader::HandlePetition(void *aContext, Coap::Header &aHeader, Message &aMessage,
+OT_TOOL_COLD_CODE void Leader::HandlePetition(void *aContext, Coap::Header &aHeader, Message &aMessage,
                             const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<Leader *>(aContext)->HandlePetition(aHeader, aMessage, aMessageInfo);
@@ -147,7 +149,7 @@ exit:
     return error;
 }
 
-void Leader::HandleKeepAlive(void *aContext, Coap::Header &aHeader, Message &aMessage,
+OT_TOOL_COLD_CODE void Leader::HandleKeepAlive(void *aContext, Coap::Header &aHeader, Message &aMessage,
                              const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<Leader *>(aContext)->HandleKeepAlive(aHeader, aMessage, aMessageInfo);
@@ -224,7 +226,7 @@ exit:
     return error;
 }
 
-void Leader::HandleTimer(void *aContext)
+OT_TOOL_COLD_CODE void Leader::HandleTimer(void *aContext)
 {
     static_cast<Leader *>(aContext)->HandleTimer();
 }
@@ -237,3 +239,5 @@ void Leader::HandleTimer(void)
 
 }  // namespace MeshCoP
 }  // namespace Thread
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
@@ -34,6 +34,7 @@
 #ifndef MESHCOP_LEADER_HPP_
 #define MESHCOP_LEADER_HPP_
 
+#include <openthread-core-config.h>
 #include <coap/coap_server.hpp>
 #include <common/timer.hpp>
 #include <net/udp6.hpp>
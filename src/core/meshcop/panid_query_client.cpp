@@ -53,7 +53,7 @@ PanIdQueryClient::PanIdQueryClient(ThreadNetif &aThreadNetif) :
     mSocket.Open(HandleUdpReceive, this);
 }
 
-ThreadError PanIdQueryClient::SendQuery(uint16_t aPanId, uint32_t aChannelMask, const Ip6::Address &aAddress,
+OT_TOOL_COLD_CODE ThreadError PanIdQueryClient::SendQuery(uint16_t aPanId, uint32_t aChannelMask, const Ip6::Address &aAddress,
                                         otCommissionerPanIdConflictCallback aCallback, void *aContext)
 {
     ThreadError error = kThreadError_None;
@@ -125,7 +125,7 @@ exit:
     return error;
 }
 
-void PanIdQueryClient::HandleConflict(void *aContext, Coap::Header &aHeader, Message &aMessage,
+OT_TOOL_COLD_CODE void PanIdQueryClient::HandleConflict(void *aContext, Coap::Header &aHeader, Message &aMessage,
                                       const Ip6::MessageInfo &aMessageInfo)
 {
     static_cast<PanIdQueryClient *>(aContext)->HandleConflict(aHeader, aMessage, aMessageInfo);
@@ -206,7 +206,7 @@ exit:
     return error;
 }
 
-void PanIdQueryClient::HandleTimer(void *aContext)
+OT_TOOL_COLD_CODE void PanIdQueryClient::HandleTimer(void *aContext)
 {
     static_cast<PanIdQueryClient *>(aContext)->HandleTimer();
 }
@@ -215,7 +215,7 @@ void PanIdQueryClient::HandleTimer(void)
 {
 }
 
-void PanIdQueryClient::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
+OT_TOOL_COLD_CODE void PanIdQueryClient::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     otLogInfoMeshCoP("received panid query response\r\n");
     (void)aContext;
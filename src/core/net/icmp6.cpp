@@ -37,6 +37,7 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/message.hpp>
+#include <common/timer.hpp>
 #include <net/icmp6.hpp>
 #include <net/ip6.hpp>
 
@@ -47,6 +48,8 @@ namespace Ip6 {
 
 Icmp::Icmp(Ip6 &aIp6):
     mHandlers(NULL),
+    mErrorTokens(kErrorBurst),
+    mErrorTokenTime(0),
     mEchoSequence(1),
     mEchoReplyHandler(NULL),
     mEchoReplyContext(NULL),
@@ -116,6 +119,8 @@ ThreadError Icmp::SendError(const Address &aDestination, IcmpHeader::Type aType,
     Message *message = NULL;
     IcmpHeader icmp6Header;
 
+    VerifyOrExit(TakeErrorToken(), error = kThreadError_Drop);
+
     VerifyOrExit((message = mIp6.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
     SuccessOrExit(error = message->SetLength(sizeof(icmp6Header) + sizeof(aHeader)));
 
@@ -143,6 +148,31 @@ exit:
     return error;
 }
 
+bool Icmp::TakeErrorToken(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t elapsed = now - mErrorTokenTime;
+    bool rval = false;
+
+    // refill the bucket lazily so no timer is needed; unspent refill time carries over
+    if (elapsed >= kErrorTokenInterval)
+    {
+        uint32_t tokens = elapsed / kErrorTokenInterval;
+
+        mErrorTokens = (tokens >= static_cast<uint32_t>(kErrorBurst - mErrorTokens)) ?
+                       static_cast<uint8_t>(kErrorBurst) : static_cast<uint8_t>(mErrorTokens + tokens);
+        mErrorTokenTime = now - (elapsed % kErrorTokenInterval);
+    }
+
+    VerifyOrExit(mErrorTokens > 0, otLogInfoIcmp("ICMPv6 Error rate limited\n"));
+
+    mErrorTokens--;
+    rval = true;
+
+exit:
+    return rval;
+}
+
 ThreadError Icmp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
@@ -203,6 +233,11 @@ ThreadError Icmp::HandleEchoRequest(Message &aRequestMessage, const MessageInfo
 
     otLogInfoIcmp("Received Echo Request\n");
 
+    if (SendEchoReplyFast(aRequestMessage, aMessageInfo) == kThreadError_None)
+    {
+        ExitNow();
+    }
+
     icmp6Header.Init();
     icmp6Header.SetType(IcmpHeader::kTypeEchoReply);
 
@@ -238,6 +273,52 @@ exit:
     return error;
 }
 
+ThreadError Icmp::SendEchoReplyFast(Message &aRequestMessage, const MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    Message *replyMessage = NULL;
+    Header *header;
+    Address source;
+    uint8_t replyType = IcmpHeader::kTypeEchoReply;
+
+    // multicast requests require source address selection and requests carrying extension
+    // headers would require the headers to be rebuilt, so both take the regular path
+    VerifyOrExit(!aMessageInfo.GetSockAddr().IsMulticast() &&
+                 aRequestMessage.GetOffset() == sizeof(Header), error = kThreadError_Failed);
+
+    // the datagram's owner frees the request after payload handling, so rewrite a clone
+    // that shares the (unmodified) payload buffers with the request
+    VerifyOrExit((replyMessage = aRequestMessage.Clone()) != NULL, error = kThreadError_NoBufs);
+
+    // the rewritten IPv6 header must be contiguous in the clone
+    header = reinterpret_cast<Header *>(replyMessage->GetContiguousData(0, sizeof(Header)));
+    VerifyOrExit(header != NULL, error = kThreadError_Failed);
+
+    // swap source and destination; the pseudo-header checksum is order-independent
+    source = header->GetSource();
+    header->SetSource(header->GetDestination());
+    header->SetDestination(source);
+    header->SetHopLimit(static_cast<uint8_t>(Ip6::kDefaultHopLimit));
+
+    // flip Echo Request to Echo Reply and patch the checksum incrementally (RFC 1624)
+    SuccessOrExit(error = replyMessage->PatchChecksum(sizeof(Header) + IcmpHeader::GetChecksumOffset(),
+                                                      sizeof(Header), sizeof(replyType), &replyType));
+
+    mIp6.EnqueueDatagram(*replyMessage, aMessageInfo.mInterfaceId);
+    replyMessage = NULL;
+
+    otLogInfoIcmp("Sent Echo Reply\n");
+
+exit:
+
+    if (replyMessage != NULL)
+    {
+        replyMessage->Free();
+    }
+
+    return error;
+}
+
 ThreadError Icmp::HandleEchoReply(Message &aMessage, const MessageInfo &aMessageInfo)
 {
     VerifyOrExit(mIsEchoEnabled && mEchoReplyHandler, ;);
@@ -34,6 +34,7 @@
 #ifndef ICMP6_HPP_
 #define ICMP6_HPP_
 
+#include <openthread-core-config.h>
 #include <common/encoding.hpp>
 #include <net/ip6_headers.hpp>
 
@@ -328,6 +329,7 @@ public:
      *
      * @retval kThreadError_None    Successfully enqueued the ICMPv6 error message.
      * @retval kThreadError_NoBufs  Insufficient buffers available.
+     * @retval kThreadError_Drop    The error message was suppressed by the rate limiter.
      *
      */
     ThreadError SendError(const Address &aDestination, IcmpHeader::Type aType, IcmpHeader::Code aCode,
@@ -376,12 +378,23 @@ public:
     void SetEchoEnabled(bool aEnabled);
 
 private:
+    enum
+    {
+        kErrorBurst = OPENTHREAD_CONFIG_ICMP_ERROR_BURST,
+        kErrorTokenInterval = 1000 / OPENTHREAD_CONFIG_ICMP_ERRORS_PER_SECOND,  ///< milliseconds per token
+    };
+
     ThreadError HandleDstUnreach(Message &aMessage, const MessageInfo &aMessageInfo, const IcmpHeader &aIcmpHeader);
     ThreadError HandleEchoRequest(Message &aMessage, const MessageInfo &aMessageInfo);
+    ThreadError SendEchoReplyFast(Message &aRequestMessage, const MessageInfo &aMessageInfo);
     ThreadError HandleEchoReply(Message &aMessage, const MessageInfo &aMessageInfo);
+    bool TakeErrorToken(void);
 
     IcmpHandler *mHandlers;
 
+    uint8_t mErrorTokens;
+    uint32_t mErrorTokenTime;
+
     uint16_t mEchoSequence;
     EchoReplyHandler mEchoReplyHandler;
     void *mEchoReplyContext;
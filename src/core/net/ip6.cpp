@@ -51,20 +51,37 @@ Ip6::Ip6(void):
     mRoutes(*this),
     mIcmp(*this),
     mUdp(*this),
+    mTcp(*this),
+#if OPENTHREAD_CONFIG_ENABLE_MPL
     mMpl(*this),
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
     mForwardingEnabled(false),
     mSendQueueTask(mTaskletScheduler, HandleSendQueue, this),
     mReceiveIp6DatagramCallback(NULL),
     mReceiveIp6DatagramCallbackContext(NULL),
     mIsReceiveIp6FilterEnabled(false),
     mNetifListHead(NULL),
-    mNextInterfaceId(1)
+    mNextInterfaceId(1),
+    mChecksumCachePartial(0),
+    mChecksumCacheProto(0),
+    mChecksumCacheValid(false)
 {
+    memset(mMulticastCache, 0, sizeof(mMulticastCache));
+    memset(mSourceCache, 0, sizeof(mSourceCache));
 }
 
-Message *Ip6::NewMessage(uint16_t reserved)
+Message *Ip6::NewMessage(uint16_t reserved, uint8_t aPriority)
 {
-    return mMessagePool.New(Message::kTypeIp6, sizeof(Header) + sizeof(HopByHopHeader) + sizeof(OptionMpl) + reserved);
+    Message *message = mMessagePool.New(Message::kTypeIp6,
+                                        sizeof(Header) + sizeof(HopByHopHeader) + sizeof(OptionMpl) + reserved,
+                                        aPriority);
+
+    if (message != NULL)
+    {
+        message->SetOwner(Message::kOwnerIp6);
+    }
+
+    return message;
 }
 
 void Ip6::SetForwardingEnabled(bool aEnable)
@@ -82,9 +99,17 @@ uint16_t Ip6::UpdateChecksum(uint16_t checksum, const void *buf, uint16_t len)
 {
     const uint8_t *bytes = reinterpret_cast<const uint8_t *>(buf);
 
-    for (int i = 0; i < len; i++)
+    // fold 16-bit words, then any trailing byte
+    while (len >= 2)
+    {
+        checksum = Ip6::UpdateChecksum(checksum, static_cast<uint16_t>((bytes[0] << 8) | bytes[1]));
+        bytes += 2;
+        len -= 2;
+    }
+
+    if (len > 0)
     {
-        checksum = Ip6::UpdateChecksum(checksum, (i & 1) ? bytes[i] : static_cast<uint16_t>(bytes[i] << 8));
+        checksum = Ip6::UpdateChecksum(checksum, static_cast<uint16_t>(bytes[0] << 8));
     }
 
     return checksum;
@@ -107,6 +132,29 @@ uint16_t Ip6::ComputePseudoheaderChecksum(const Address &src, const Address &dst
     return checksum;
 }
 
+uint16_t Ip6::GetPseudoheaderChecksum(const Address &src, const Address &dst, uint16_t length, IpProto proto)
+{
+    uint16_t checksum;
+
+    if (!mChecksumCacheValid ||
+        mChecksumCacheProto != static_cast<uint8_t>(proto) ||
+        memcmp(&mChecksumCacheSource, &src, sizeof(src)) != 0 ||
+        memcmp(&mChecksumCacheDest, &dst, sizeof(dst)) != 0)
+    {
+        checksum = Ip6::UpdateChecksum(0, static_cast<uint16_t>(proto));
+        checksum = UpdateChecksum(checksum, src);
+        checksum = UpdateChecksum(checksum, dst);
+
+        mChecksumCacheSource = src;
+        mChecksumCacheDest = dst;
+        mChecksumCacheProto = static_cast<uint8_t>(proto);
+        mChecksumCachePartial = checksum;
+        mChecksumCacheValid = true;
+    }
+
+    return Ip6::UpdateChecksum(mChecksumCachePartial, length);
+}
+
 void Ip6::SetReceiveDatagramCallback(otReceiveIp6DatagramCallback aCallback, void *aCallbackContext)
 {
     mReceiveIp6DatagramCallback = aCallback;
@@ -123,22 +171,29 @@ void Ip6::SetReceiveIp6FilterEnabled(bool aEnabled)
     mIsReceiveIp6FilterEnabled = aEnabled;
 }
 
+#if OPENTHREAD_CONFIG_ENABLE_MPL
 ThreadError Ip6::AddMplOption(Message &message, Header &header, IpProto nextHeader, uint16_t payloadLength)
 {
     ThreadError error = kThreadError_None;
     HopByHopHeader hbhHeader;
     OptionMpl mplOption;
+    uint8_t buf[sizeof(hbhHeader) + sizeof(mplOption)];
 
     hbhHeader.SetNextHeader(nextHeader);
     hbhHeader.SetLength(0);
     mMpl.InitOption(mplOption, HostSwap16(header.GetSource().mFields.m16[7]));
-    SuccessOrExit(error = message.Prepend(&mplOption, sizeof(mplOption)));
-    SuccessOrExit(error = message.Prepend(&hbhHeader, sizeof(hbhHeader)));
+
+    // prepend the hop-by-hop header and MPL option as one block
+    memcpy(buf, &hbhHeader, sizeof(hbhHeader));
+    memcpy(buf + sizeof(hbhHeader), &mplOption, sizeof(mplOption));
+    SuccessOrExit(error = message.Prepend(buf, sizeof(buf)));
+
     header.SetPayloadLength(sizeof(hbhHeader) + sizeof(mplOption) + payloadLength);
     header.SetNextHeader(kProtoHopOpts);
 exit:
     return error;
 }
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
 
 ThreadError Ip6::SendDatagram(Message &message, MessageInfo &messageInfo, IpProto ipproto)
 {
@@ -170,16 +225,20 @@ ThreadError Ip6::SendDatagram(Message &message, MessageInfo &messageInfo, IpProt
         VerifyOrExit(messageInfo.mInterfaceId != 0, error = kThreadError_Drop);
     }
 
+#if OPENTHREAD_CONFIG_ENABLE_MPL
+
     if (messageInfo.GetPeerAddr().IsRealmLocalMulticast())
     {
         SuccessOrExit(error = AddMplOption(message, header, ipproto, payloadLength));
     }
 
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
+
     SuccessOrExit(error = message.Prepend(&header, sizeof(header)));
 
     // compute checksum
-    checksum = ComputePseudoheaderChecksum(header.GetSource(), header.GetDestination(),
-                                           payloadLength, ipproto);
+    checksum = GetPseudoheaderChecksum(header.GetSource(), header.GetDestination(),
+                                       payloadLength, ipproto);
 
     switch (ipproto)
     {
@@ -187,6 +246,10 @@ ThreadError Ip6::SendDatagram(Message &message, MessageInfo &messageInfo, IpProt
         SuccessOrExit(error = mUdp.UpdateChecksum(message, checksum));
         break;
 
+    case kProtoTcp:
+        SuccessOrExit(error = mTcp.UpdateChecksum(message, checksum));
+        break;
+
     case kProtoIcmp6:
         SuccessOrExit(error = mIcmp.UpdateChecksum(message, checksum));
         break;
@@ -199,14 +262,19 @@ exit:
 
     if (error == kThreadError_None)
     {
-        message.SetInterfaceId(messageInfo.mInterfaceId);
-        mSendQueue.Enqueue(message);
-        mSendQueueTask.Post();
+        EnqueueDatagram(message, messageInfo.mInterfaceId);
     }
 
     return error;
 }
 
+void Ip6::EnqueueDatagram(Message &aMessage, int8_t aInterfaceId)
+{
+    aMessage.SetInterfaceId(aInterfaceId);
+    mSendQueue.Enqueue(aMessage);
+    mSendQueueTask.Post();
+}
+
 void Ip6::HandleSendQueue(void *aContext)
 {
     static_cast<Ip6 *>(aContext)->HandleSendQueue();
@@ -240,9 +308,12 @@ ThreadError Ip6::HandleOptions(Message &message)
 
         switch (optionHeader.GetType())
         {
+#if OPENTHREAD_CONFIG_ENABLE_MPL
+
         case OptionMpl::kType:
             SuccessOrExit(error = mMpl.ProcessOption(message));
             break;
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
 
         default:
             switch (optionHeader.GetAction())
@@ -339,6 +410,9 @@ ThreadError Ip6::HandlePayload(Message &message, MessageInfo &messageInfo, uint8
     case kProtoUdp:
         ExitNow(error = mUdp.HandleMessage(message, messageInfo));
 
+    case kProtoTcp:
+        ExitNow(error = mTcp.HandleMessage(message, messageInfo));
+
     case kProtoIcmp6:
         ExitNow(error = mIcmp.HandleMessage(message, messageInfo));
     }
@@ -392,11 +466,9 @@ ThreadError Ip6::ProcessReceiveCallback(const Message &aMessage, const MessageIn
         }
     }
 
-    // make a copy of the datagram to pass to host
-    VerifyOrExit((messageCopy = NewMessage(0)) != NULL, error = kThreadError_NoBufs);
-    SuccessOrExit(error = messageCopy->SetLength(aMessage.GetLength()));
-    aMessage.CopyTo(0, 0, aMessage.GetLength(), *messageCopy);
-    messageCopy->SetLinkSecurityEnabled(aMessage.IsLinkSecurityEnabled());
+    // clone the datagram to pass to host, sharing payload buffers until one side writes
+    VerifyOrExit((messageCopy = aMessage.Clone()) != NULL, error = kThreadError_NoBufs);
+    messageCopy->SetOffset(0);
 
     mReceiveIp6DatagramCallback(messageCopy, mReceiveIp6DatagramCallbackContext);
 
@@ -415,7 +487,8 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
 {
     ThreadError error = kThreadError_None;
     MessageInfo messageInfo;
-    Header header;
+    const Header *header;
+    Header headerBuffer;
     uint16_t payloadLength;
     bool receive = false;
     bool forward = false;
@@ -429,48 +502,43 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
 #endif
 
     // check message length
-    VerifyOrExit(message.GetLength() >= sizeof(header), error = kThreadError_Drop);
-    message.Read(0, sizeof(header), &header);
-    payloadLength = header.GetPayloadLength();
+    VerifyOrExit(message.GetLength() >= sizeof(*header), error = kThreadError_Drop);
+
+    // the IPv6 header normally fits in the first message buffer, so use a direct view when possible
+    if ((header = reinterpret_cast<const Header *>(message.GetContiguousData(0, sizeof(*header)))) == NULL)
+    {
+        message.Read(0, sizeof(headerBuffer), &headerBuffer);
+        header = &headerBuffer;
+    }
+
+    payloadLength = header->GetPayloadLength();
 
     // check Version
-    VerifyOrExit(header.IsVersion6(), error = kThreadError_Drop);
+    VerifyOrExit(header->IsVersion6(), error = kThreadError_Drop);
 
     // check Payload Length
-    VerifyOrExit(sizeof(header) + payloadLength == message.GetLength() &&
-                 sizeof(header) + payloadLength <= Ip6::kMaxDatagramLength, error = kThreadError_Drop);
+    VerifyOrExit(sizeof(*header) + payloadLength == message.GetLength() &&
+                 sizeof(*header) + payloadLength <= Ip6::kMaxDatagramLength, error = kThreadError_Drop);
 
     memset(&messageInfo, 0, sizeof(messageInfo));
-    messageInfo.GetPeerAddr() = header.GetSource();
-    messageInfo.GetSockAddr() = header.GetDestination();
+    messageInfo.GetPeerAddr() = header->GetSource();
+    messageInfo.GetSockAddr() = header->GetDestination();
     messageInfo.mInterfaceId = interfaceId;
-    messageInfo.mHopLimit = header.GetHopLimit();
+    messageInfo.mHopLimit = header->GetHopLimit();
     messageInfo.mLinkInfo = linkMessageInfo;
 
     // determine destination of packet
-    if (header.GetDestination().IsMulticast())
+    if (header->GetDestination().IsMulticast())
     {
-        if (netif != NULL && netif->IsMulticastSubscribed(header.GetDestination()))
-        {
-            receive = true;
-        }
-
-        if (header.GetDestination().GetScope() > Address::kLinkLocalScope)
-        {
-            forward = true;
-        }
-        else if (netif == NULL)
-        {
-            forward = true;
-        }
+        GetMulticastDelivery(header->GetDestination(), netif, receive, forward);
     }
     else
     {
-        if (IsUnicastAddress(header.GetDestination()))
+        if (IsUnicastAddress(header->GetDestination()))
         {
             receive = true;
         }
-        else if (!header.GetDestination().IsLinkLocal())
+        else if (!header->GetDestination().IsLinkLocal())
         {
             forward = true;
         }
@@ -485,10 +553,12 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
         forward = false;
     }
 
-    message.SetOffset(sizeof(header));
+    hopLimit = header->GetHopLimit();
+    nextHeader = static_cast<uint8_t>(header->GetNextHeader());
+
+    message.SetOffset(sizeof(*header));
 
     // process IPv6 Extension Headers
-    nextHeader = static_cast<uint8_t>(header.GetNextHeader());
     SuccessOrExit(error = HandleExtensionHeaders(message, nextHeader, receive));
 
     // process IPv6 Payload
@@ -506,17 +576,16 @@ ThreadError Ip6::HandleDatagram(Message &message, Netif *netif, int8_t interface
     {
         if (netif != NULL)
         {
-            header.SetHopLimit(header.GetHopLimit() - 1);
+            hopLimit--;
         }
 
-        if (header.GetHopLimit() == 0)
+        if (hopLimit == 0)
         {
             // send time exceeded
             ExitNow(error = kThreadError_Drop);
         }
         else
         {
-            hopLimit = header.GetHopLimit();
             message.Write(Header::GetHopLimitOffset(), Header::GetHopLimitSize(), &hopLimit);
             SuccessOrExit(error = ForwardMessage(message, messageInfo, nextHeader));
         }
@@ -532,6 +601,40 @@ exit:
     return error;
 }
 
+void Ip6::GetMulticastDelivery(const Address &aAddress, Netif *aNetif, bool &aReceive, bool &aForward)
+{
+    int8_t interfaceId = (aNetif != NULL) ? aNetif->GetInterfaceId() : -1;
+    MulticastCacheEntry &entry = mMulticastCache[(aAddress.mFields.m8[14] ^ aAddress.mFields.m8[15]) %
+                                                 kMulticastCacheSize];
+
+    if (entry.mValid && entry.mInterfaceId == interfaceId && entry.mAddress == aAddress)
+    {
+        aReceive = entry.mReceive;
+        aForward = entry.mForward;
+        ExitNow();
+    }
+
+    aReceive = (aNetif != NULL) && aNetif->IsMulticastSubscribed(aAddress);
+    aForward = (aAddress.GetScope() > Address::kLinkLocalScope) || (aNetif == NULL);
+
+    entry.mAddress = aAddress;
+    entry.mInterfaceId = interfaceId;
+    entry.mReceive = aReceive;
+    entry.mForward = aForward;
+    entry.mValid = true;
+
+exit:
+    return;
+}
+
+void Ip6::InvalidateMulticastCache(void)
+{
+    for (int i = 0; i < kMulticastCacheSize; i++)
+    {
+        mMulticastCache[i].mValid = false;
+    }
+}
+
 ThreadError Ip6::ForwardMessage(Message &message, MessageInfo &messageInfo, uint8_t ipproto)
 {
     ThreadError error = kThreadError_None;
@@ -621,6 +724,9 @@ ThreadError Ip6::AddNetif(Netif &aNetif)
         aNetif.mInterfaceId = mNextInterfaceId++;
     }
 
+    InvalidateMulticastCache();
+    InvalidateSourceAddressCache();
+
 exit:
     return error;
 }
@@ -650,6 +756,8 @@ ThreadError Ip6::RemoveNetif(Netif &aNetif)
     }
 
     aNetif.mNext = NULL;
+    InvalidateMulticastCache();
+    InvalidateSourceAddressCache();
 
 exit:
     return error;
@@ -718,6 +826,15 @@ const NetifUnicastAddress *Ip6::SelectSourceAddress(MessageInfo &aMessageInfo)
     const Address *candidateAddr;
     int8_t candidateId;
     int8_t rvalIface = 0;
+    SourceCacheEntry &entry = mSourceCache[(destination->mFields.m8[14] ^ destination->mFields.m8[15]) %
+                                           kSourceCacheSize];
+
+    // steady-state flows reuse the previous selection and skip the scoring loop
+    if (entry.mValid && entry.mInterfaceId == interfaceId && entry.mDestination == *destination)
+    {
+        aMessageInfo.mInterfaceId = entry.mSourceInterfaceId;
+        return entry.mSource;
+    }
 
     for (Netif *netif = GetNetifList(); netif; netif = netif->mNext)
     {
@@ -792,9 +909,27 @@ const NetifUnicastAddress *Ip6::SelectSourceAddress(MessageInfo &aMessageInfo)
 
 exit:
     aMessageInfo.mInterfaceId = rvalIface;
+
+    if (rvalAddr != NULL)
+    {
+        entry.mDestination = *destination;
+        entry.mInterfaceId = static_cast<int8_t>(interfaceId);
+        entry.mSource = rvalAddr;
+        entry.mSourceInterfaceId = rvalIface;
+        entry.mValid = true;
+    }
+
     return rvalAddr;
 }
 
+void Ip6::InvalidateSourceAddressCache(void)
+{
+    for (int i = 0; i < kSourceCacheSize; i++)
+    {
+        mSourceCache[i].mValid = false;
+    }
+}
+
 int8_t Ip6::GetOnLinkNetif(const Address &aAddress)
 {
     int8_t rval = -1;
@@ -36,6 +36,7 @@
 
 #include <stddef.h>
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
@@ -46,6 +47,7 @@
 #include <net/ip6_mpl.hpp>
 #include <net/netif.hpp>
 #include <net/socket.hpp>
+#include <net/tcp.hpp>
 #include <net/udp6.hpp>
 
 using Thread::Encoding::BigEndian::HostSwap16;
@@ -106,11 +108,12 @@ public:
      * This method allocates a new message buffer from the buffer pool.
      *
      * @param[in]  aReserved  The number of header bytes to reserve following the IPv6 header.
+     * @param[in]  aPriority  The priority level of the message.
      *
      * @returns A pointer to the message or NULL if insufficient message buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This constructor initializes the object.
@@ -130,6 +133,17 @@ public:
      */
     ThreadError SendDatagram(Message &aMessage, MessageInfo &aMessageInfo, IpProto aIpProto);
 
+    /**
+     * This method enqueues a fully-formed IPv6 datagram for transmission.
+     *
+     * The message must already contain a complete IPv6 header and a valid upper-layer checksum.
+     *
+     * @param[in]  aMessage      A reference to the message.
+     * @param[in]  aInterfaceId  The interface identifier to associate with @p aMessage.
+     *
+     */
+    void EnqueueDatagram(Message &aMessage, int8_t aInterfaceId);
+
     /**
      * This method processes a received IPv6 datagram.
      *
@@ -194,6 +208,23 @@ public:
     static uint16_t ComputePseudoheaderChecksum(const Address &aSource, const Address &aDestination,
                                                 uint16_t aLength, IpProto aProto);
 
+    /**
+     * This method computes the pseudoheader checksum, caching the length-independent partial sum.
+     *
+     * Repeated sends between the same pair of addresses reuse the cached partial sum and only
+     * fold in the payload length.
+     *
+     * @param[in]  aSource       A reference to the IPv6 source address.
+     * @param[in]  aDestination  A reference to the IPv6 destination address.
+     * @param[in]  aLength       The IPv6 Payload Length value.
+     * @param[in]  aProto        The IPv6 Next Header value.
+     *
+     * @returns The pseudoheader checksum.
+     *
+     */
+    uint16_t GetPseudoheaderChecksum(const Address &aSource, const Address &aDestination,
+                                     uint16_t aLength, IpProto aProto);
+
     /**
      * This method registers a callback to provide received raw IPv6 datagrams.
      *
@@ -323,9 +354,36 @@ public:
      */
     int8_t GetOnLinkNetif(const Address &aAddress);
 
+#if OPENTHREAD_CONFIG_ENABLE_MPL
+    /**
+     * This method returns a reference to the MPL message processing object.
+     *
+     * @returns A reference to the MPL message processing object.
+     *
+     */
+    Mpl &GetMpl(void) { return mMpl; }
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
+
+    /**
+     * This method invalidates the multicast delivery cache.
+     *
+     * Network interfaces call this method whenever their multicast subscriptions change.
+     *
+     */
+    void InvalidateMulticastCache(void);
+
+    /**
+     * This method invalidates the source address selection cache.
+     *
+     * Network interfaces call this method whenever their unicast address lists change.
+     *
+     */
+    void InvalidateSourceAddressCache(void);
+
     Routes mRoutes;
     Icmp mIcmp;
     Udp mUdp;
+    Tcp mTcp;
 
     MessagePool mMessagePool;
     TaskletScheduler mTaskletScheduler;
@@ -338,12 +396,51 @@ private:
     ThreadError ProcessReceiveCallback(const Message &aMessage, const MessageInfo &aMessageInfo, uint8_t aIpProto);
     ThreadError HandleExtensionHeaders(Message &message, uint8_t &nextHeader, bool receive);
     ThreadError HandleFragment(Message &message);
+#if OPENTHREAD_CONFIG_ENABLE_MPL
     ThreadError AddMplOption(Message &message, Header &header, IpProto nextHeader, uint16_t payloadLength);
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
     ThreadError HandleOptions(Message &message);
     ThreadError HandlePayload(Message &message, MessageInfo &messageInfo, uint8_t ipproto);
     ThreadError ForwardMessage(Message &message, MessageInfo &messageInfo, uint8_t ipproto);
+    void GetMulticastDelivery(const Address &aAddress, Netif *aNetif, bool &aReceive, bool &aForward);
+
+    enum
+    {
+        kMulticastCacheSize = 8,  ///< Number of entries in the multicast delivery cache.
+        kSourceCacheSize    = 4,  ///< Number of entries in the source address selection cache.
+    };
+
+    /**
+     * This structure caches the delivery verdict (host, forward, or both) for a multicast
+     * destination arriving on a given network interface.
+     *
+     */
+    struct MulticastCacheEntry
+    {
+        Address mAddress;       ///< The multicast destination address.
+        int8_t  mInterfaceId;   ///< The arrival interface identifier (-1 for none).
+        bool    mValid;         ///< TRUE if this entry holds a verdict.
+        bool    mReceive;       ///< TRUE if the datagram is delivered to the host.
+        bool    mForward;       ///< TRUE if the datagram is forwarded (MPL).
+    };
 
+    /**
+     * This structure caches the source address selected for a destination so that
+     * steady-state sends skip the candidate scoring loop.
+     *
+     */
+    struct SourceCacheEntry
+    {
+        Address mDestination;                      ///< The destination address.
+        int8_t  mInterfaceId;                      ///< The requested outgoing interface identifier.
+        const NetifUnicastAddress *mSource;        ///< The selected source address entry.
+        int8_t  mSourceInterfaceId;                ///< The interface identifier of the selected source.
+        bool    mValid;                            ///< TRUE if this entry holds a selection.
+    };
+
+#if OPENTHREAD_CONFIG_ENABLE_MPL
     Mpl mMpl;
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
     bool mForwardingEnabled;
 
     MessageQueue mSendQueue;
@@ -355,6 +452,15 @@ private:
 
     Netif *mNetifListHead;
     int8_t mNextInterfaceId;
+
+    MulticastCacheEntry mMulticastCache[kMulticastCacheSize];
+    SourceCacheEntry mSourceCache[kSourceCacheSize];
+
+    Address mChecksumCacheSource;
+    Address mChecksumCacheDest;
+    uint16_t mChecksumCachePartial;
+    uint8_t mChecksumCacheProto;
+    bool mChecksumCacheValid;
 };
 
 /**
@@ -41,18 +41,19 @@
 
 using Thread::Encoding::BigEndian::HostSwap16;
 using Thread::Encoding::BigEndian::HostSwap32;
+using Thread::Encoding::BigEndian::HostSwap64;
 
 namespace Thread {
 namespace Ip6 {
 
 bool Address::IsUnspecified(void) const
 {
-    return (mFields.m32[0] == 0 && mFields.m32[1] == 0 && mFields.m32[2] == 0 && mFields.m32[3] == 0);
+    return (mFields.m64[0] == 0 && mFields.m64[1] == 0);
 }
 
 bool Address::IsLoopback(void) const
 {
-    return (mFields.m32[0] == 0 && mFields.m32[1] == 0 && mFields.m32[2] == 0 && mFields.m32[3] == HostSwap32(1));
+    return (mFields.m64[0] == 0 && mFields.m64[1] == HostSwap64(1));
 }
 
 bool Address::IsLinkLocal(void) const
@@ -72,14 +73,12 @@ bool Address::IsLinkLocalMulticast(void) const
 
 bool Address::IsLinkLocalAllNodesMulticast(void) const
 {
-    return (mFields.m32[0] == HostSwap32(0xff020000) && mFields.m32[1] == 0 &&
-            mFields.m32[2] == 0 && mFields.m32[3] == HostSwap32(0x01));
+    return (mFields.m64[0] == HostSwap64(0xff02000000000000ULL) && mFields.m64[1] == HostSwap64(0x01));
 }
 
 bool Address::IsLinkLocalAllRoutersMulticast(void) const
 {
-    return (mFields.m32[0] == HostSwap32(0xff020000) && mFields.m32[1] == 0 &&
-            mFields.m32[2] == 0 && mFields.m32[3] == HostSwap32(0x02));
+    return (mFields.m64[0] == HostSwap64(0xff02000000000000ULL) && mFields.m64[1] == HostSwap64(0x02));
 }
 
 bool Address::IsRealmLocalMulticast(void) const
@@ -89,14 +88,12 @@ bool Address::IsRealmLocalMulticast(void) const
 
 bool Address::IsRealmLocalAllNodesMulticast(void) const
 {
-    return (mFields.m32[0] == HostSwap32(0xff030000) && mFields.m32[1] == 0 &&
-            mFields.m32[2] == 0 && mFields.m32[3] == HostSwap32(0x01));
+    return (mFields.m64[0] == HostSwap64(0xff03000000000000ULL) && mFields.m64[1] == HostSwap64(0x01));
 }
 
 bool Address::IsRealmLocalAllRoutersMulticast(void) const
 {
-    return (mFields.m32[0] == HostSwap32(0xff030000) && mFields.m32[1] == 0 &&
-            mFields.m32[2] == 0 && mFields.m32[3] == HostSwap32(0x02));
+    return (mFields.m64[0] == HostSwap64(0xff03000000000000ULL) && mFields.m64[1] == HostSwap64(0x02));
 }
 
 bool Address::IsRoutingLocator(void) const
@@ -115,6 +112,11 @@ uint8_t *Address::GetIid(void)
     return mFields.m8 + kInterfaceIdentifierOffset;
 }
 
+bool Address::IidMatches(const Address &aOther) const
+{
+    return mFields.m64[1] == aOther.mFields.m64[1];
+}
+
 void Address::SetIid(const uint8_t *aIid)
 {
     memcpy(mFields.m8 + kInterfaceIdentifierOffset, aIid, kInterfaceIdentifierSize);
@@ -148,8 +150,21 @@ uint8_t Address::PrefixMatch(const Address &aOther) const
 {
     uint8_t rval = 0;
     uint8_t diff;
+    uint8_t i = 0;
+
+    // compare the 64-bit halves first to skip matching prefixes a word at a time
+    if (mFields.m64[0] == aOther.mFields.m64[0])
+    {
+        if (mFields.m64[1] == aOther.mFields.m64[1])
+        {
+            return sizeof(Address) * 8;
+        }
+
+        rval = 64;
+        i = 8;
+    }
 
-    for (uint8_t i = 0; i < sizeof(Address); i++)
+    for (; i < sizeof(Address); i++)
     {
         diff = mFields.m8[i] ^ aOther.mFields.m8[i];
 
@@ -174,12 +189,12 @@ uint8_t Address::PrefixMatch(const Address &aOther) const
 
 bool Address::operator==(const Address &aOther) const
 {
-    return memcmp(mFields.m8, aOther.mFields.m8, sizeof(mFields.m8)) == 0;
+    return (mFields.m64[0] == aOther.mFields.m64[0]) && (mFields.m64[1] == aOther.mFields.m64[1]);
 }
 
 bool Address::operator!=(const Address &aOther) const
 {
-    return memcmp(mFields.m8, aOther.mFields.m8, sizeof(mFields.m8)) != 0;
+    return (mFields.m64[0] != aOther.mFields.m64[0]) || (mFields.m64[1] != aOther.mFields.m64[1]);
 }
 
 ThreadError Address::FromString(const char *aBuf)
@@ -212,6 +212,17 @@ public:
      */
     void SetIid(const uint8_t *aIid);
 
+    /**
+     * This method indicates whether or not the Interface Identifier matches that of @p aOther.
+     *
+     * @param[in]  aOther  The IPv6 address to compare against.
+     *
+     * @retval TRUE   If the Interface Identifiers match.
+     * @retval FALSE  If the Interface Identifiers differ.
+     *
+     */
+    bool IidMatches(const Address &aOther) const;
+
     /**
      * This method sets the Interface Identifier.
      *
@@ -43,9 +43,13 @@
 namespace Thread {
 namespace Ip6 {
 
-Filter::Filter(void)
+Filter::Filter(void):
+    mNumPortRanges(0),
+    mHasWideRange(false)
 {
     memset(mUnsecurePorts, 0, sizeof(mUnsecurePorts));
+    memset(mPortRanges, 0, sizeof(mPortRanges));
+    memset(mPortBitmap, 0, sizeof(mPortBitmap));
 }
 
 bool Filter::Accept(Message &aMessage) const
@@ -97,10 +101,36 @@ bool Filter::Accept(Message &aMessage) const
         ExitNow();
     }
 
-    // Check against allowed unsecure port list
+    // Check against the compiled unsecure port rules
+    rval = MatchesUnsecurePort(dstport);
+
+exit:
+    return rval;
+}
+
+bool Filter::MatchesUnsecurePort(uint16_t aPort) const
+{
+    bool rval = false;
+
+    // The bitmap covers every installed rule unless a wide range is present, so a
+    // cleared bit rejects the port without scanning the rule tables.
+    if (!mHasWideRange)
+    {
+        VerifyOrExit(mPortBitmap[HashPort(aPort) / 8] & (1 << (HashPort(aPort) % 8)), ;);
+    }
+
+    // Confirm against the rule tables to reject hash collisions
     for (int i = 0; i < kMaxUnsecurePorts; i++)
     {
-        if (mUnsecurePorts[i] != 0 && mUnsecurePorts[i] == dstport)
+        if (mUnsecurePorts[i] != 0 && mUnsecurePorts[i] == aPort)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+    for (int i = 0; i < mNumPortRanges; i++)
+    {
+        if (mPortRanges[i].mStart <= aPort && aPort <= mPortRanges[i].mEnd)
         {
             ExitNow(rval = true);
         }
@@ -110,6 +140,36 @@ exit:
     return rval;
 }
 
+void Filter::CompileMatcher(void)
+{
+    memset(mPortBitmap, 0, sizeof(mPortBitmap));
+    mHasWideRange = false;
+
+    for (int i = 0; i < kMaxUnsecurePorts; i++)
+    {
+        if (mUnsecurePorts[i] != 0)
+        {
+            mPortBitmap[HashPort(mUnsecurePorts[i]) / 8] |= 1 << (HashPort(mUnsecurePorts[i]) % 8);
+        }
+    }
+
+    for (int i = 0; i < mNumPortRanges; i++)
+    {
+        // Ranges wider than the bitmap would set every bit, so fall back to scanning
+        // the rule tables for every port instead.
+        if (mPortRanges[i].mEnd - mPortRanges[i].mStart >= kPortBitmapBits)
+        {
+            mHasWideRange = true;
+            continue;
+        }
+
+        for (uint32_t port = mPortRanges[i].mStart; port <= mPortRanges[i].mEnd; port++)
+        {
+            mPortBitmap[HashPort(static_cast<uint16_t>(port)) / 8] |= 1 << (HashPort(static_cast<uint16_t>(port)) % 8);
+        }
+    }
+}
+
 ThreadError Filter::AddUnsecurePort(uint16_t aPort)
 {
     ThreadError error = kThreadError_None;
@@ -127,6 +187,7 @@ ThreadError Filter::AddUnsecurePort(uint16_t aPort)
         if (mUnsecurePorts[i] == 0)
         {
             mUnsecurePorts[i] = aPort;
+            CompileMatcher();
             ExitNow();
         }
     }
@@ -154,6 +215,58 @@ ThreadError Filter::RemoveUnsecurePort(uint16_t aPort)
 
             // Clear the last port entry.
             mUnsecurePorts[i] = 0;
+            CompileMatcher();
+            ExitNow();
+        }
+    }
+
+    ExitNow(error = kThreadError_NotFound);
+
+exit:
+    return error;
+}
+
+ThreadError Filter::AddUnsecurePortRange(uint16_t aStart, uint16_t aEnd)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(aStart != 0 && aStart <= aEnd, error = kThreadError_InvalidArgs);
+
+    for (int i = 0; i < mNumPortRanges; i++)
+    {
+        if (mPortRanges[i].mStart == aStart && mPortRanges[i].mEnd == aEnd)
+        {
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(mNumPortRanges < kMaxPortRanges, error = kThreadError_NoBufs);
+
+    mPortRanges[mNumPortRanges].mStart = aStart;
+    mPortRanges[mNumPortRanges].mEnd = aEnd;
+    mNumPortRanges++;
+    CompileMatcher();
+
+exit:
+    return error;
+}
+
+ThreadError Filter::RemoveUnsecurePortRange(uint16_t aStart, uint16_t aEnd)
+{
+    ThreadError error = kThreadError_None;
+
+    for (int i = 0; i < mNumPortRanges; i++)
+    {
+        if (mPortRanges[i].mStart == aStart && mPortRanges[i].mEnd == aEnd)
+        {
+            // Shift all of the ranges above this entry down.
+            for (; i < mNumPortRanges - 1; i++)
+            {
+                mPortRanges[i] = mPortRanges[i + 1];
+            }
+
+            mNumPortRanges--;
+            CompileMatcher();
             ExitNow();
         }
     }
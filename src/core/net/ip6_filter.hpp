@@ -107,12 +107,63 @@ public:
      */
     const uint16_t *GetUnsecurePorts(uint8_t &aNumEntries) const;
 
+    /**
+     * This method adds a destination port range to the allowed unsecure rules.
+     *
+     * @param[in]  aStart  The first port value in the range.
+     * @param[in]  aEnd    The last port value in the range.
+     *
+     * @retval kThreadError_None         The port range was successfully added.
+     * @retval kThreadError_InvalidArgs  @p aStart was zero or greater than @p aEnd.
+     * @retval kThreadError_NoBufs       The port range list is full.
+     *
+     */
+    ThreadError AddUnsecurePortRange(uint16_t aStart, uint16_t aEnd);
+
+    /**
+     * This method removes a destination port range from the allowed unsecure rules.
+     *
+     * @param[in]  aStart  The first port value in the range.
+     * @param[in]  aEnd    The last port value in the range.
+     *
+     * @retval kThreadError_None      The port range was successfully removed.
+     * @retval kThreadError_NotFound  The port range was not found.
+     *
+     */
+    ThreadError RemoveUnsecurePortRange(uint16_t aStart, uint16_t aEnd);
+
 private:
     enum
     {
         kMaxUnsecurePorts = 2,
+        kMaxPortRanges    = 4,
+        kPortBitmapBits   = 256,                 ///< Number of bits in the compiled port bitmap.
+        kPortBitmapSize   = kPortBitmapBits / 8,
     };
+
+    /**
+     * This structure represents an allowed destination port range.
+     *
+     */
+    struct PortRange
+    {
+        uint16_t mStart;  ///< First port value in the range.
+        uint16_t mEnd;    ///< Last port value in the range.
+    };
+
+    void CompileMatcher(void);
+    bool MatchesUnsecurePort(uint16_t aPort) const;
+
+    static uint8_t HashPort(uint16_t aPort) { return static_cast<uint8_t>(aPort ^ (aPort >> 8)); }
+
     uint16_t mUnsecurePorts[kMaxUnsecurePorts];
+    PortRange mPortRanges[kMaxPortRanges];
+    uint8_t mNumPortRanges;
+
+    // The bitmap is rebuilt whenever a rule is installed or removed, so the per-datagram
+    // check is a single hash and bit test regardless of how many rules are configured.
+    uint8_t mPortBitmap[kPortBitmapSize];
+    bool mHasWideRange;
 };
 
 }  // namespace Ip6
@@ -153,7 +153,7 @@ public:
      * @returns The IPv6 Payload Length value.
      *
      */
-    uint16_t GetPayloadLength() { return HostSwap16(mPayloadLength); }
+    uint16_t GetPayloadLength() const { return HostSwap16(mPayloadLength); }
 
     /**
      * This method sets the IPv6 Payload Length value.
@@ -203,6 +203,14 @@ public:
      */
     Address &GetSource() { return static_cast<Address &>(mSource); }
 
+    /**
+     * This method returns the IPv6 Source address.
+     *
+     * @returns A reference to the IPv6 Source address.
+     *
+     */
+    const Address &GetSource() const { return static_cast<const Address &>(mSource); }
+
     /**
      * This method sets the IPv6 Source address.
      *
@@ -219,6 +227,14 @@ public:
      */
     Address &GetDestination() { return static_cast<Address &>(mDestination); }
 
+    /**
+     * This method returns the IPv6 Destination address.
+     *
+     * @returns A reference to the IPv6 Destination address.
+     *
+     */
+    const Address &GetDestination() const { return static_cast<const Address &>(mDestination); }
+
     /**
      * This method sets the IPv6 Destination address.
      *
@@ -36,6 +36,8 @@
 #include <net/ip6.hpp>
 #include <net/ip6_mpl.hpp>
 
+#if OPENTHREAD_CONFIG_ENABLE_MPL
+
 namespace Thread {
 namespace Ip6 {
 
@@ -54,26 +56,54 @@ void Mpl::InitOption(OptionMpl &aOption, uint16_t aSeed)
     aOption.SetSeed(aSeed);
 }
 
+uint8_t Mpl::SeedHash(uint16_t aSeed)
+{
+    return static_cast<uint8_t>((aSeed ^ (aSeed >> 8)) % kNumEntries);
+}
+
+const Mpl::MplEntry *Mpl::FindEntry(uint16_t aSeed) const
+{
+    const MplEntry *rval = NULL;
+    uint8_t index = SeedHash(aSeed);
+
+    for (int i = 0; i < kNumProbes; i++, index = (index + 1) % kNumEntries)
+    {
+        if (mEntries[index].mLifetime > 0 && mEntries[index].mSeed == aSeed)
+        {
+            ExitNow(rval = &mEntries[index]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
 ThreadError Mpl::ProcessOption(const Message &aMessage)
 {
     ThreadError error = kThreadError_None;
     OptionMpl option;
     MplEntry *entry = NULL;
+    uint8_t index;
     int8_t diff;
 
     VerifyOrExit(aMessage.Read(aMessage.GetOffset(), sizeof(option), &option) == sizeof(option) &&
                  option.GetLength() == sizeof(OptionMpl) - sizeof(OptionHeader),
                  error = kThreadError_Drop);
 
-    for (int i = 0; i < kNumEntries; i++)
+    index = SeedHash(option.GetSeed());
+
+    for (int i = 0; i < kNumProbes; i++, index = (index + 1) % kNumEntries)
     {
-        if (mEntries[i].mLifetime == 0)
+        if (mEntries[index].mLifetime == 0)
         {
-            entry = &mEntries[i];
+            if (entry == NULL)
+            {
+                entry = &mEntries[index];
+            }
         }
-        else if (mEntries[i].mSeed == option.GetSeed())
+        else if (mEntries[index].mSeed == option.GetSeed())
         {
-            entry = &mEntries[i];
+            entry = &mEntries[index];
             diff = static_cast<int8_t>(option.GetSequence() - entry->mSequence);
 
             if (diff <= 0)
@@ -85,7 +115,24 @@ ThreadError Mpl::ProcessOption(const Message &aMessage)
         }
     }
 
-    VerifyOrExit(entry != NULL, error = kThreadError_Drop);
+    if (entry == NULL)
+    {
+        // all probed slots hold other seeds: evict the entry closest to expiry
+        index = SeedHash(option.GetSeed());
+        entry = &mEntries[index];
+
+        for (int i = 1; i < kNumProbes; i++)
+        {
+            index = (index + 1) % kNumEntries;
+
+            if (mEntries[index].mLifetime < entry->mLifetime)
+            {
+                entry = &mEntries[index];
+            }
+        }
+    }
+
+    SuccessOrExit(error);
 
     entry->mSeed = option.GetSeed();
     entry->mSequence = option.GetSequence();
@@ -96,6 +143,51 @@ exit:
     return error;
 }
 
+bool Mpl::IsDuplicateDatagram(const Message &aMessage)
+{
+    bool rval = false;
+    Header ip6Header;
+    HopByHopHeader hbhHeader;
+    OptionHeader optionHeader;
+    OptionMpl option;
+    const MplEntry *entry;
+    uint16_t offset;
+    uint16_t endOffset;
+
+    VerifyOrExit(aMessage.Read(0, sizeof(ip6Header), &ip6Header) == sizeof(ip6Header) &&
+                 ip6Header.IsVersion6() &&
+                 ip6Header.GetDestination().IsMulticast() &&
+                 ip6Header.GetNextHeader() == kProtoHopOpts, ;);
+
+    offset = sizeof(ip6Header);
+    VerifyOrExit(aMessage.Read(offset, sizeof(hbhHeader), &hbhHeader) == sizeof(hbhHeader), ;);
+    endOffset = offset + (hbhHeader.GetLength() + 1) * 8;
+    offset += sizeof(optionHeader);
+
+    while (offset < endOffset)
+    {
+        VerifyOrExit(aMessage.Read(offset, sizeof(optionHeader), &optionHeader) == sizeof(optionHeader), ;);
+
+        if (optionHeader.GetType() == OptionMpl::kType)
+        {
+            VerifyOrExit(aMessage.Read(offset, sizeof(option), &option) == sizeof(option) &&
+                         option.GetLength() == sizeof(OptionMpl) - sizeof(OptionHeader), ;);
+
+            if ((entry = FindEntry(option.GetSeed())) != NULL)
+            {
+                rval = (static_cast<int8_t>(option.GetSequence() - entry->mSequence) <= 0);
+            }
+
+            ExitNow();
+        }
+
+        offset += sizeof(optionHeader) + optionHeader.GetLength();
+    }
+
+exit:
+    return rval;
+}
+
 void Mpl::HandleTimer(void *aContext)
 {
     Mpl *obj = reinterpret_cast<Mpl *>(aContext);
@@ -123,3 +215,5 @@ void Mpl::HandleTimer()
 
 }  // namespace Ip6
 }  // namespace Thread
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
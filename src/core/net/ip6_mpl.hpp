@@ -34,6 +34,7 @@
  *   This file includes definitions for MPL.
  */
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 #include <common/message.hpp>
 #include <common/timer.hpp>
@@ -198,16 +199,35 @@ public:
      */
     ThreadError ProcessOption(const Message &aMessage);
 
+    /**
+     * This method indicates whether or not an IPv6 datagram carries an MPL option that is already
+     * in the seed set.
+     *
+     * This method performs a lookup only and does not update the seed set, so it may be used to
+     * drop duplicates early (e.g. before reassembly completes); the seed set is updated when the
+     * complete datagram is processed by ProcessOption().
+     *
+     * @param[in]  aMessage  A reference to the message containing the IPv6 datagram.
+     *
+     * @retval TRUE   If the datagram is an MPL duplicate.
+     * @retval FALSE  If the datagram is not an MPL duplicate or carries no MPL option.
+     *
+     */
+    bool IsDuplicateDatagram(const Message &aMessage);
+
 private:
     enum
     {
         kNumEntries = OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES,
         kLifetime = OPENTHREAD_CONFIG_MPL_CACHE_ENTRY_LIFETIME,
+        kNumProbes = 4,  ///< Number of slots probed per seed before evicting.
     };
 
     static void HandleTimer(void *context);
     void HandleTimer();
 
+    static uint8_t SeedHash(uint16_t aSeed);
+
     Timer mTimer;
     uint8_t mSequence;
 
@@ -217,6 +237,9 @@ private:
         uint8_t mSequence;
         uint8_t mLifetime;
     };
+
+    const MplEntry *FindEntry(uint16_t aSeed) const;
+
     MplEntry mEntries[kNumEntries];
 };
 
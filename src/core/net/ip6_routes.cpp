@@ -44,6 +44,16 @@ Routes::Routes(Ip6 &aIp6):
     mRoutes(NULL),
     mIp6(aIp6)
 {
+    memset(mRouteCache, 0, sizeof(mRouteCache));
+    mRouteCacheIndex = 0;
+}
+
+void Routes::ClearRouteCache(void)
+{
+    for (int i = 0; i < kRouteCacheSize; i++)
+    {
+        mRouteCache[i].mValid = false;
+    }
 }
 
 ThreadError Routes::Add(Route &aRoute)
@@ -57,6 +67,7 @@ ThreadError Routes::Add(Route &aRoute)
 
     aRoute.mNext = mRoutes;
     mRoutes = &aRoute;
+    ClearRouteCache();
 
 exit:
     return error;
@@ -81,6 +92,7 @@ ThreadError Routes::Remove(Route &aRoute)
     }
 
     aRoute.mNext = NULL;
+    ClearRouteCache();
 
     return kThreadError_None;
 }
@@ -91,6 +103,16 @@ int8_t Routes::Lookup(const Address &aSource, const Address &aDestination)
     uint8_t prefixMatch;
     int8_t rval = -1;
 
+    for (int i = 0; i < kRouteCacheSize; i++)
+    {
+        if (mRouteCache[i].mValid &&
+            mRouteCache[i].mDestination == aDestination &&
+            mRouteCache[i].mSource == aSource)
+        {
+            ExitNow(rval = mRouteCache[i].mInterfaceId);
+        }
+    }
+
     for (Route *cur = mRoutes; cur; cur = cur->mNext)
     {
         prefixMatch = cur->mPrefix.PrefixMatch(aDestination);
@@ -124,6 +146,18 @@ int8_t Routes::Lookup(const Address &aSource, const Address &aDestination)
         }
     }
 
+    // only successful lookups are cached so that a flow with no route retries
+    // the full lookup once a usable route appears
+    if (rval >= 0)
+    {
+        mRouteCacheIndex = (mRouteCacheIndex + 1) % kRouteCacheSize;
+        mRouteCache[mRouteCacheIndex].mSource = aSource;
+        mRouteCache[mRouteCacheIndex].mDestination = aDestination;
+        mRouteCache[mRouteCacheIndex].mInterfaceId = rval;
+        mRouteCache[mRouteCacheIndex].mValid = true;
+    }
+
+exit:
     return rval;
 }
 
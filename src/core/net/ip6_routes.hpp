@@ -109,8 +109,26 @@ public:
     int8_t Lookup(const Address &aSource, const Address &aDestination);
 
 private:
+    enum
+    {
+        kRouteCacheSize = 4,  ///< Number of cached route lookups.
+    };
+
+    struct RouteCacheEntry
+    {
+        Address mSource;
+        Address mDestination;
+        int8_t  mInterfaceId;
+        bool    mValid;
+    };
+
+    void ClearRouteCache(void);
+
     Route *mRoutes;
     Ip6 &mIp6;
+
+    RouteCacheEntry mRouteCache[kRouteCacheSize];
+    uint8_t mRouteCacheIndex;
 };
 
 /**
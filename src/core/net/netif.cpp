@@ -33,6 +33,7 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/logging.hpp>
 #include <common/message.hpp>
 #include <net/ip6.hpp>
 #include <net/netif.hpp>
@@ -52,9 +53,66 @@ Netif::Netif(Ip6 &aIp6):
     mNext = NULL;
     mMaskExtUnicastAddresses = 0;
 
+    mUnicastIndexCount = 0;
+    mUnicastIndexOverflow = false;
+    mMulticastIndexCount = 0;
+    mMulticastIndexOverflow = false;
+
     mStateChangedFlags = 0;
 }
 
+uint8_t Netif::HashAddress(const Address &aAddress)
+{
+    uint8_t hash = 0;
+
+    for (size_t i = 0; i < sizeof(aAddress.mFields.m8); i++)
+    {
+        hash ^= aAddress.mFields.m8[i];
+    }
+
+    return hash;
+}
+
+void Netif::UpdateUnicastIndex(void)
+{
+    mIp6.InvalidateSourceAddressCache();
+
+    mUnicastIndexCount = 0;
+    mUnicastIndexOverflow = false;
+
+    for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+    {
+        if (mUnicastIndexCount == kUnicastIndexSize)
+        {
+            mUnicastIndexOverflow = true;
+            break;
+        }
+
+        mUnicastIndexHash[mUnicastIndexCount] = HashAddress(cur->GetAddress());
+        mUnicastIndexAddress[mUnicastIndexCount] = cur;
+        mUnicastIndexCount++;
+    }
+}
+
+void Netif::UpdateMulticastIndex(void)
+{
+    mMulticastIndexCount = 0;
+    mMulticastIndexOverflow = false;
+
+    for (const NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+    {
+        if (mMulticastIndexCount == kMulticastIndexSize)
+        {
+            mMulticastIndexOverflow = true;
+            break;
+        }
+
+        mMulticastIndexHash[mMulticastIndexCount] = HashAddress(cur->GetAddress());
+        mMulticastIndexAddress[mMulticastIndexCount] = cur;
+        mMulticastIndexCount++;
+    }
+}
+
 ThreadError Netif::RegisterCallback(NetifCallback &aCallback)
 {
     ThreadError error = kThreadError_None;
@@ -102,11 +160,26 @@ bool Netif::IsMulticastSubscribed(const Address &aAddress) const
         ExitNow(rval = mAllRoutersSubscribed);
     }
 
-    for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+    if (mMulticastIndexOverflow)
+    {
+        for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->mNext)
+        {
+            if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+    else
     {
-        if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+        uint8_t hash = HashAddress(aAddress);
+
+        for (uint8_t i = 0; i < mMulticastIndexCount; i++)
         {
-            ExitNow(rval = true);
+            if (mMulticastIndexHash[i] == hash && mMulticastIndexAddress[i]->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
         }
     }
 
@@ -117,11 +190,13 @@ exit:
 void Netif::SubscribeAllRoutersMulticast()
 {
     mAllRoutersSubscribed = true;
+    mIp6.InvalidateMulticastCache();
 }
 
 void Netif::UnsubscribeAllRoutersMulticast()
 {
     mAllRoutersSubscribed = false;
+    mIp6.InvalidateMulticastCache();
 }
 
 ThreadError Netif::SubscribeMulticast(NetifMulticastAddress &aAddress)
@@ -138,6 +213,8 @@ ThreadError Netif::SubscribeMulticast(NetifMulticastAddress &aAddress)
 
     aAddress.mNext = mMulticastAddresses;
     mMulticastAddresses = &aAddress;
+    UpdateMulticastIndex();
+    mIp6.InvalidateMulticastCache();
 
 exit:
     return error;
@@ -167,6 +244,13 @@ ThreadError Netif::UnsubscribeMulticast(const NetifMulticastAddress &aAddress)
     ExitNow(error = kThreadError_Error);
 
 exit:
+
+    if (error == kThreadError_None)
+    {
+        UpdateMulticastIndex();
+        mIp6.InvalidateMulticastCache();
+    }
+
     return error;
 }
 
@@ -175,6 +259,17 @@ const NetifUnicastAddress *Netif::GetUnicastAddresses() const
     return mUnicastAddresses;
 }
 
+const char *NetifUnicastAddress::GetAddressString(void) const
+{
+    if (!mAddressStringValid)
+    {
+        GetAddress().ToString(mAddressString, sizeof(mAddressString));
+        mAddressStringValid = true;
+    }
+
+    return mAddressString;
+}
+
 ThreadError Netif::AddUnicastAddress(NetifUnicastAddress &aAddress)
 {
     ThreadError error = kThreadError_None;
@@ -189,6 +284,13 @@ ThreadError Netif::AddUnicastAddress(NetifUnicastAddress &aAddress)
 
     aAddress.mNext = mUnicastAddresses;
     mUnicastAddresses = &aAddress;
+    UpdateUnicastIndex();
+
+    // render the log string once at add time so log sites never format it
+    aAddress.GetAddress().ToString(aAddress.mAddressString, sizeof(aAddress.mAddressString));
+    aAddress.mAddressStringValid = true;
+
+    otLogInfoIp6("add addr %s\n", aAddress.GetAddressString());
 
     if (!aAddress.GetAddress().IsRoutingLocator())
     {
@@ -224,6 +326,12 @@ ThreadError Netif::RemoveUnicastAddress(const NetifUnicastAddress &aAddress)
 
 exit:
 
+    if (error == kThreadError_None)
+    {
+        UpdateUnicastIndex();
+        otLogInfoIp6("remove addr %s\n", aAddress.GetAddressString());
+    }
+
     if (!aAddress.GetAddress().IsRoutingLocator())
     {
         SetStateChangedFlags(OT_IP6_ADDRESS_REMOVED);
@@ -270,6 +378,7 @@ ThreadError Netif::AddExternalUnicastAddress(const NetifUnicastAddress &aAddress
     mExtUnicastAddresses[index].mNext = mUnicastAddresses;
 
     mUnicastAddresses = &mExtUnicastAddresses[index];
+    UpdateUnicastIndex();
 
     SetStateChangedFlags(OT_IP6_ADDRESS_ADDED);
 
@@ -308,6 +417,7 @@ ThreadError Netif::RemoveExternalUnicastAddress(const Address &aAddress)
     if (aAddressIndexToRemove != -1)
     {
         mMaskExtUnicastAddresses &= ~(1 << aAddressIndexToRemove);
+        UpdateUnicastIndex();
 
         SetStateChangedFlags(OT_IP6_ADDRESS_REMOVED);
     }
@@ -321,15 +431,41 @@ exit:
     return error;
 }
 
+bool Netif::MatchesSynthesizedAddress(const Address &aAddress) const
+{
+    (void)aAddress;
+    return false;
+}
+
 bool Netif::IsUnicastAddress(const Address &aAddress) const
 {
     bool rval = false;
 
-    for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+    if (MatchesSynthesizedAddress(aAddress))
+    {
+        ExitNow(rval = true);
+    }
+
+    if (mUnicastIndexOverflow)
+    {
+        for (const NetifUnicastAddress *cur = mUnicastAddresses; cur; cur = cur->GetNext())
+        {
+            if (cur->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+    else
     {
-        if (cur->GetAddress() == aAddress)
+        uint8_t hash = HashAddress(aAddress);
+
+        for (uint8_t i = 0; i < mUnicastIndexCount; i++)
         {
-            ExitNow(rval = true);
+            if (mUnicastIndexHash[i] == hash && mUnicastIndexAddress[i]->GetAddress() == aAddress)
+            {
+                ExitNow(rval = true);
+            }
         }
     }
 
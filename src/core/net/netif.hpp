@@ -115,6 +115,26 @@ public:
      *
      */
     NetifUnicastAddress *GetNext(void) { return static_cast<NetifUnicastAddress *>(mNext); }
+
+    /**
+     * This method returns the unicast address rendered as a text string for logging.
+     *
+     * The rendering is cached when the address is added to the interface, so enabled log sites
+     * consume it through a plain %s without paying for formatting.
+     *
+     * @returns A pointer to the NULL-terminated address string.
+     *
+     */
+    const char *GetAddressString(void) const;
+
+private:
+    enum
+    {
+        kAddressStringSize = 40,  ///< "xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx:xxxx" plus terminator
+    };
+
+    mutable char mAddressString[kAddressStringSize];
+    mutable bool mAddressStringValid;
 };
 
 /**
@@ -407,13 +427,37 @@ public:
     virtual ThreadError RouteLookup(const Address &aSource, const Address &aDestination,
                                     uint8_t *aPrefixMatch) = 0;
 
+    /**
+     * This virtual method indicates whether or not @p aAddress is a unicast address the interface
+     * synthesizes from compact state rather than a configured table entry.
+     *
+     * The base implementation recognizes no synthesized addresses.
+     *
+     * @param[in]  aAddress  A reference to the IPv6 address.
+     *
+     * @retval TRUE   If the interface answers to @p aAddress without a table entry.
+     * @retval FALSE  If @p aAddress is not a synthesized address.
+     *
+     */
+    virtual bool MatchesSynthesizedAddress(const Address &aAddress) const;
+
 protected:
     Ip6 &mIp6;
 
 private:
+    enum
+    {
+        kUnicastIndexSize   = 16,  ///< Capacity of the unicast address index.
+        kMulticastIndexSize = 8,   ///< Capacity of the multicast address index.
+    };
+
     static void HandleStateChangedTask(void *aContext);
     void HandleStateChangedTask(void);
 
+    static uint8_t HashAddress(const Address &aAddress);
+    void UpdateUnicastIndex(void);
+    void UpdateMulticastIndex(void);
+
     NetifCallback *mCallbacks;
     NetifUnicastAddress *mUnicastAddresses;
     NetifMulticastAddress *mMulticastAddresses;
@@ -427,6 +471,17 @@ private:
     NetifUnicastAddress mExtUnicastAddresses[OPENTHREAD_CONFIG_MAX_EXT_IP_ADDRS];
     uint8_t mMaskExtUnicastAddresses; // Must have enough bits to hold OPENTHREAD_CONFIG_MAX_EXT_IP_ADDRS
 
+    // compact per-packet lookup indexes, rebuilt on the rare address add/remove; when more
+    // addresses exist than index slots, lookups fall back to walking the list
+    uint8_t mUnicastIndexHash[kUnicastIndexSize];
+    const NetifUnicastAddress *mUnicastIndexAddress[kUnicastIndexSize];
+    uint8_t mUnicastIndexCount;
+    bool mUnicastIndexOverflow;
+    uint8_t mMulticastIndexHash[kMulticastIndexSize];
+    const NetifMulticastAddress *mMulticastIndexAddress[kMulticastIndexSize];
+    uint8_t mMulticastIndexCount;
+    bool mMulticastIndexOverflow;
+
     static Netif *sNetifListHead;
     static int8_t sNextInterfaceId;
 
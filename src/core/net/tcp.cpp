@@ -0,0 +1,882 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements TCP/IPv6 sockets.
+ */
+
+#include <common/code_utils.hpp>
+#include <common/encoding.hpp>
+#include <net/ip6.hpp>
+#include <net/tcp.hpp>
+
+using Thread::Encoding::BigEndian::HostSwap16;
+
+namespace Thread {
+namespace Ip6 {
+
+TcpSocket::TcpSocket(Tcp &aTcp):
+    mTcp(&aTcp),
+    mNext(NULL),
+    mReceiveHandler(NULL),
+    mEventHandler(NULL),
+    mContext(NULL),
+    mTimer(aTcp.mIp6.mTimerScheduler, &HandleTimer, this),
+    mState(kStateClosed),
+    mRetransmitCount(0),
+    mRetransmitTimeout(kRetransmitTimeout),
+    mSndUna(0),
+    mSndNxt(0),
+    mSndWnd(0),
+    mRcvNxt(0),
+    mSendBuffer(NULL),
+    mSendBufferSeq(0),
+    mFinPending(false)
+{
+    mSockName = SockAddr();
+    mPeerName = SockAddr();
+}
+
+Message *TcpSocket::NewMessage(uint16_t aReserved)
+{
+    return mTcp->NewMessage(aReserved);
+}
+
+ThreadError TcpSocket::Open(ReceiveHandler aReceiveHandler, EventHandler aEventHandler, void *aContext)
+{
+    mSockName = SockAddr();
+    mPeerName = SockAddr();
+    mReceiveHandler = aReceiveHandler;
+    mEventHandler = aEventHandler;
+    mContext = aContext;
+    mState = kStateClosed;
+
+    return mTcp->AddSocket(*this);
+}
+
+ThreadError TcpSocket::Bind(const SockAddr &aSockAddr)
+{
+    mSockName = aSockAddr;
+    return kThreadError_None;
+}
+
+ThreadError TcpSocket::Listen(void)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mState == kStateClosed && mSockName.mPort != 0, error = kThreadError_InvalidState);
+    SetState(kStateListen);
+
+exit:
+    return error;
+}
+
+ThreadError TcpSocket::Connect(const SockAddr &aSockAddr)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mState == kStateClosed, error = kThreadError_InvalidState);
+
+    mPeerName = aSockAddr;
+
+    if (mSockName.mPort == 0)
+    {
+        mSockName.mPort = mTcp->GetEphemeralPort();
+    }
+
+    mSndUna = mSndNxt = mTcp->GetInitialSequence();
+    mRetransmitCount = 0;
+    mRetransmitTimeout = kRetransmitTimeout;
+    SetState(kStateSynSent);
+    error = SendControl(TcpHeader::kFlagSyn);
+
+exit:
+    return error;
+}
+
+ThreadError TcpSocket::Send(Message &aMessage)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mState == kStateEstablished || mState == kStateCloseWait, error = kThreadError_InvalidState);
+    VerifyOrExit(mSendBuffer == NULL, error = kThreadError_Busy);
+    VerifyOrExit(aMessage.GetLength() > 0, error = kThreadError_InvalidArgs);
+
+    mSendBuffer = &aMessage;
+    mSendBufferSeq = mSndNxt;
+
+    // start the timer before the first transmission attempt so that a buffer
+    // shortage now still gets retried later
+    mTimer.Start(mRetransmitTimeout);
+    SendData();
+
+exit:
+    return error;
+}
+
+ThreadError TcpSocket::Close(void)
+{
+    switch (mState)
+    {
+    case kStateListen:
+    case kStateSynSent:
+        SetState(kStateClosed);
+        break;
+
+    case kStateSynReceived:
+    case kStateEstablished:
+        SetState(kStateFinWait1);
+
+        if (mSendBuffer != NULL)
+        {
+            mFinPending = true;
+        }
+        else
+        {
+            SendFin();
+        }
+
+        break;
+
+    case kStateCloseWait:
+        SetState(kStateLastAck);
+
+        if (mSendBuffer != NULL)
+        {
+            mFinPending = true;
+        }
+        else
+        {
+            SendFin();
+        }
+
+        break;
+
+    case kStateClosed:
+        mTcp->RemoveSocket(*this);
+        break;
+
+    default:
+        // close is already in progress
+        break;
+    }
+
+    return kThreadError_None;
+}
+
+void TcpSocket::Abort(void)
+{
+    switch (mState)
+    {
+    case kStateSynReceived:
+    case kStateEstablished:
+    case kStateFinWait1:
+    case kStateFinWait2:
+    case kStateCloseWait:
+    case kStateClosing:
+    case kStateLastAck:
+        SendSegment(TcpHeader::kFlagRst | TcpHeader::kFlagAck, mSndNxt, 0, 0);
+        break;
+
+    default:
+        break;
+    }
+
+    SetState(kStateClosed);
+}
+
+void TcpSocket::SetState(State aState)
+{
+    mState = static_cast<uint8_t>(aState);
+
+    if (aState == kStateClosed)
+    {
+        mTimer.Stop();
+        ReleaseSendBuffer();
+        mFinPending = false;
+        mTcp->RemoveSocket(*this);
+    }
+}
+
+void TcpSocket::SignalEvent(uint8_t aEvent)
+{
+    if (mEventHandler != NULL)
+    {
+        mEventHandler(mContext, aEvent);
+    }
+}
+
+void TcpSocket::ReleaseSendBuffer(void)
+{
+    if (mSendBuffer != NULL)
+    {
+        mSendBuffer->Free();
+        mSendBuffer = NULL;
+    }
+}
+
+void TcpSocket::Disconnect(uint8_t aEvent)
+{
+    SetState(kStateClosed);
+    SignalEvent(aEvent);
+}
+
+ThreadError TcpSocket::SendSegment(uint16_t aFlags, uint32_t aSequence, uint16_t aBufferOffset, uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+    MessageInfo messageInfo;
+    TcpHeader tcpHeader;
+
+    // anything that consumes sequence space must be covered by the retransmission
+    // timer, even if building the segment fails below
+    if (aLength > 0 || (aFlags & (TcpHeader::kFlagSyn | TcpHeader::kFlagFin)) != 0)
+    {
+        mTimer.Start(mRetransmitTimeout);
+    }
+
+    VerifyOrExit((message = mTcp->NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+
+    if (aLength > 0)
+    {
+        SuccessOrExit(error = message->SetLength(aLength));
+        mSendBuffer->CopyTo(aBufferOffset, 0, aLength, *message);
+    }
+
+    tcpHeader.SetSourcePort(mSockName.mPort);
+    tcpHeader.SetDestinationPort(mPeerName.mPort);
+    tcpHeader.SetSequenceNumber(aSequence);
+    tcpHeader.SetAcknowledgmentNumber((aFlags & TcpHeader::kFlagAck) ? mRcvNxt : 0);
+    tcpHeader.SetFlags(static_cast<uint16_t>(((sizeof(TcpHeader) / 4) << TcpHeader::kDataOffsetShift) | aFlags));
+    tcpHeader.SetWindow(kReceiveWindow);
+    tcpHeader.SetChecksum(0);
+    tcpHeader.SetUrgentPointer(0);
+
+    SuccessOrExit(error = message->Prepend(&tcpHeader, sizeof(tcpHeader)));
+    message->SetOffset(0);
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetSockAddr() = mSockName.GetAddress();
+    messageInfo.GetPeerAddr() = mPeerName.GetAddress();
+    messageInfo.mPeerPort = mPeerName.mPort;
+    messageInfo.mInterfaceId = mSockName.mScopeId;
+
+    SuccessOrExit(error = mTcp->mIp6.SendDatagram(*message, messageInfo, kProtoTcp));
+    message = NULL;
+
+exit:
+
+    if (message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError TcpSocket::SendControl(uint16_t aFlags)
+{
+    uint32_t sequence = mSndNxt;
+
+    if ((aFlags & (TcpHeader::kFlagSyn | TcpHeader::kFlagFin)) != 0)
+    {
+        mSndNxt++;
+    }
+
+    return SendSegment(aFlags, sequence, 0, 0);
+}
+
+ThreadError TcpSocket::SendData(void)
+{
+    ThreadError error = kThreadError_None;
+    uint32_t inFlight;
+    uint16_t bufferOffset;
+    uint16_t remaining;
+    uint16_t length;
+    uint16_t flags;
+
+    VerifyOrExit(mSendBuffer != NULL, ;);
+
+    while (true)
+    {
+        bufferOffset = static_cast<uint16_t>(mSndNxt - mSendBufferSeq);
+        remaining = mSendBuffer->GetLength() - bufferOffset;
+        inFlight = mSndNxt - mSndUna;
+
+        length = remaining;
+
+        if (length > kMaxSegmentSize)
+        {
+            length = kMaxSegmentSize;
+        }
+
+        if (inFlight + length > mSndWnd)
+        {
+            length = (mSndWnd > inFlight) ? static_cast<uint16_t>(mSndWnd - inFlight) : 0;
+        }
+
+        VerifyOrExit(length > 0, ;);
+
+        flags = TcpHeader::kFlagAck;
+
+        if (length == remaining)
+        {
+            flags |= TcpHeader::kFlagPsh;
+        }
+
+        SuccessOrExit(error = SendSegment(flags, mSndNxt, bufferOffset, length));
+        mSndNxt += length;
+    }
+
+exit:
+    return error;
+}
+
+void TcpSocket::SendFin(void)
+{
+    mFinPending = false;
+    SendControl(TcpHeader::kFlagFin | TcpHeader::kFlagAck);
+}
+
+void TcpSocket::ProcessAck(const TcpHeader &aHeader)
+{
+    uint32_t ack = aHeader.GetAcknowledgmentNumber();
+
+    mSndWnd = aHeader.GetWindow();
+
+    VerifyOrExit(SequenceGreaterThan(ack, mSndUna), ;);
+    VerifyOrExit(!SequenceGreaterThan(ack, mSndNxt), ;);
+
+    mSndUna = ack;
+    mRetransmitCount = 0;
+    mRetransmitTimeout = kRetransmitTimeout;
+
+    if (mSendBuffer != NULL &&
+        !SequenceGreaterThan(mSendBufferSeq + mSendBuffer->GetLength(), mSndUna))
+    {
+        ReleaseSendBuffer();
+        SignalEvent(kEventDataSent);
+
+        if (mFinPending)
+        {
+            SendFin();
+        }
+    }
+
+    if (mSndUna == mSndNxt)
+    {
+        mTimer.Stop();
+    }
+    else
+    {
+        mTimer.Start(mRetransmitTimeout);
+    }
+
+exit:
+    return;
+}
+
+void TcpSocket::ProcessReceive(const TcpHeader &aHeader, Message &aMessage, const MessageInfo &aMessageInfo)
+{
+    uint16_t flags = aHeader.GetFlags();
+    uint32_t seq = aHeader.GetSequenceNumber();
+    uint16_t segmentLength = aMessage.GetLength() - aMessage.GetOffset();
+    bool finAcked;
+
+    switch (mState)
+    {
+    case kStateClosed:
+        ExitNow();
+
+    case kStateListen:
+        VerifyOrExit((flags & (TcpHeader::kFlagRst | TcpHeader::kFlagAck)) == 0 &&
+                     (flags & TcpHeader::kFlagSyn) != 0, ;);
+
+        mPeerName.GetAddress() = aMessageInfo.GetPeerAddr();
+        mPeerName.mPort = aMessageInfo.mPeerPort;
+
+        if (mSockName.GetAddress().IsUnspecified())
+        {
+            // lock the connection to the address the peer used to reach us
+            mSockName.GetAddress() = aMessageInfo.GetSockAddr();
+        }
+
+        mRcvNxt = seq + 1;
+        mSndWnd = aHeader.GetWindow();
+        mSndUna = mSndNxt = mTcp->GetInitialSequence();
+        mRetransmitCount = 0;
+        mRetransmitTimeout = kRetransmitTimeout;
+        SetState(kStateSynReceived);
+        SendControl(TcpHeader::kFlagSyn | TcpHeader::kFlagAck);
+        ExitNow();
+
+    case kStateSynSent:
+        if ((flags & TcpHeader::kFlagRst) != 0)
+        {
+            if ((flags & TcpHeader::kFlagAck) != 0 && aHeader.GetAcknowledgmentNumber() == mSndNxt)
+            {
+                Disconnect(kEventDisconnected);
+            }
+
+            ExitNow();
+        }
+
+        // simultaneous open is not supported; require SYN+ACK of our SYN
+        VerifyOrExit((flags & (TcpHeader::kFlagSyn | TcpHeader::kFlagAck)) ==
+                     (TcpHeader::kFlagSyn | TcpHeader::kFlagAck), ;);
+        VerifyOrExit(aHeader.GetAcknowledgmentNumber() == mSndNxt, ;);
+
+        mSndUna = aHeader.GetAcknowledgmentNumber();
+        mSndWnd = aHeader.GetWindow();
+        mRcvNxt = seq + 1;
+        mTimer.Stop();
+        SetState(kStateEstablished);
+        SendControl(TcpHeader::kFlagAck);
+        SignalEvent(kEventConnected);
+        ExitNow();
+
+    default:
+        break;
+    }
+
+    // synchronized states from here on
+
+    if ((flags & TcpHeader::kFlagRst) != 0)
+    {
+        // only accept a reset that matches our receive expectation
+        VerifyOrExit(seq == mRcvNxt, ;);
+        Disconnect(kEventDisconnected);
+        ExitNow();
+    }
+
+    // a SYN in a synchronized state is stale; drop it
+    VerifyOrExit((flags & TcpHeader::kFlagSyn) == 0, ;);
+    VerifyOrExit((flags & TcpHeader::kFlagAck) != 0, ;);
+
+    if (mState == kStateSynReceived)
+    {
+        // the first ACK must cover our SYN
+        VerifyOrExit(!SequenceGreaterThan(mSndNxt, aHeader.GetAcknowledgmentNumber()), ;);
+        SetState(kStateEstablished);
+        SignalEvent(kEventConnected);
+    }
+
+    ProcessAck(aHeader);
+    SendData();
+
+    finAcked = (mSendBuffer == NULL && !mFinPending && mSndUna == mSndNxt);
+
+    switch (mState)
+    {
+    case kStateFinWait1:
+        if (finAcked)
+        {
+            SetState(kStateFinWait2);
+        }
+
+        break;
+
+    case kStateClosing:
+        if (finAcked)
+        {
+            SetState(kStateTimeWait);
+            mTimer.Start(kTimeWaitTimeout);
+        }
+
+        break;
+
+    case kStateLastAck:
+        if (finAcked)
+        {
+            Disconnect(kEventDisconnected);
+            ExitNow();
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    if (segmentLength > 0)
+    {
+        if (seq != mRcvNxt ||
+            (mState != kStateEstablished && mState != kStateFinWait1 && mState != kStateFinWait2))
+        {
+            // out-of-order data is dropped (no SACK); re-assert our expectation so
+            // the peer retransmits from the hole
+            SendControl(TcpHeader::kFlagAck);
+            ExitNow();
+        }
+
+        mRcvNxt += segmentLength;
+
+        if (mReceiveHandler != NULL)
+        {
+            mReceiveHandler(mContext, aMessage, aMessageInfo);
+        }
+
+        SendControl(TcpHeader::kFlagAck);
+    }
+
+    if ((flags & TcpHeader::kFlagFin) != 0)
+    {
+        // only honor an in-order FIN
+        VerifyOrExit(seq + segmentLength == mRcvNxt, ;);
+
+        mRcvNxt++;
+        SendControl(TcpHeader::kFlagAck);
+
+        switch (mState)
+        {
+        case kStateEstablished:
+            SetState(kStateCloseWait);
+            SignalEvent(kEventPeerClosed);
+            break;
+
+        case kStateFinWait1:
+            // our FIN is still in flight (an acked FIN would have moved us to FIN-WAIT-2)
+            SetState(kStateClosing);
+            break;
+
+        case kStateFinWait2:
+            SetState(kStateTimeWait);
+            mTimer.Start(kTimeWaitTimeout);
+            SignalEvent(kEventPeerClosed);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+exit:
+    return;
+}
+
+void TcpSocket::HandleTimer(void *aContext)
+{
+    static_cast<TcpSocket *>(aContext)->HandleTimer();
+}
+
+void TcpSocket::HandleTimer(void)
+{
+    uint16_t bufferOffset;
+    uint16_t length;
+
+    if (mState == kStateTimeWait)
+    {
+        Disconnect(kEventDisconnected);
+        ExitNow();
+    }
+
+    if (mRetransmitCount >= kMaxRetransmitCount)
+    {
+        Disconnect(kEventDisconnected);
+        ExitNow();
+    }
+
+    mRetransmitCount++;
+    mRetransmitTimeout <<= 1;
+
+    switch (mState)
+    {
+    case kStateSynSent:
+        SendSegment(TcpHeader::kFlagSyn, mSndUna, 0, 0);
+        break;
+
+    case kStateSynReceived:
+        SendSegment(TcpHeader::kFlagSyn | TcpHeader::kFlagAck, mSndUna, 0, 0);
+        break;
+
+    default:
+        if (mSendBuffer != NULL && SequenceGreaterThan(mSendBufferSeq + mSendBuffer->GetLength(), mSndUna))
+        {
+            // resend the oldest unacknowledged data segment
+            bufferOffset = static_cast<uint16_t>(mSndUna - mSendBufferSeq);
+            length = mSendBuffer->GetLength() - bufferOffset;
+
+            if (length > kMaxSegmentSize)
+            {
+                length = kMaxSegmentSize;
+            }
+
+            SendSegment(TcpHeader::kFlagAck, mSndUna, bufferOffset, length);
+        }
+        else if (mSndNxt != mSndUna)
+        {
+            // only the FIN remains outstanding
+            SendSegment(TcpHeader::kFlagFin | TcpHeader::kFlagAck, mSndNxt - 1, 0, 0);
+        }
+
+        break;
+    }
+
+exit:
+    return;
+}
+
+Tcp::Tcp(Ip6 &aIp6):
+    mEphemeralPort(kDynamicPortMin),
+    mInitialSequenceOffset(0),
+    mSockets(NULL),
+    mIp6(aIp6)
+{
+}
+
+ThreadError Tcp::AddSocket(TcpSocket &aSocket)
+{
+    for (TcpSocket *cur = mSockets; cur; cur = cur->GetNext())
+    {
+        if (cur == &aSocket)
+        {
+            ExitNow();
+        }
+    }
+
+    aSocket.SetNext(mSockets);
+    mSockets = &aSocket;
+
+exit:
+    return kThreadError_None;
+}
+
+ThreadError Tcp::RemoveSocket(TcpSocket &aSocket)
+{
+    if (mSockets == &aSocket)
+    {
+        mSockets = aSocket.GetNext();
+    }
+    else
+    {
+        for (TcpSocket *socket = mSockets; socket; socket = socket->GetNext())
+        {
+            if (socket->GetNext() == &aSocket)
+            {
+                socket->SetNext(aSocket.GetNext());
+                break;
+            }
+        }
+    }
+
+    aSocket.SetNext(NULL);
+
+    return kThreadError_None;
+}
+
+uint32_t Tcp::GetInitialSequence(void)
+{
+    // RFC 793 style clock-driven initial sequence numbers; adequate for
+    // management streams and keeps the transport free of platform entropy calls
+    mInitialSequenceOffset += 64;
+    return Timer::GetNow() * 250 + mInitialSequenceOffset;
+}
+
+uint16_t Tcp::GetEphemeralPort(void)
+{
+    uint16_t rval = mEphemeralPort;
+
+    if (mEphemeralPort < kDynamicPortMax)
+    {
+        mEphemeralPort++;
+    }
+    else
+    {
+        mEphemeralPort = kDynamicPortMin;
+    }
+
+    return rval;
+}
+
+Message *Tcp::NewMessage(uint16_t aReserved)
+{
+    return mIp6.NewMessage(sizeof(TcpHeader) + aReserved);
+}
+
+ThreadError Tcp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    TcpHeader tcpHeader;
+    TcpSocket *listener = NULL;
+    uint16_t payloadLength;
+    uint16_t checksum;
+
+    payloadLength = aMessage.GetLength() - aMessage.GetOffset();
+
+    // check length
+    VerifyOrExit(payloadLength >= sizeof(TcpHeader), error = kThreadError_Parse);
+
+    // verify checksum
+    checksum = Ip6::ComputePseudoheaderChecksum(aMessageInfo.GetPeerAddr(), aMessageInfo.GetSockAddr(),
+                                                payloadLength, kProtoTcp);
+    checksum = aMessage.UpdateChecksum(checksum, aMessage.GetOffset(), payloadLength);
+    VerifyOrExit(checksum == 0xffff, error = kThreadError_Drop);
+
+    aMessage.Read(aMessage.GetOffset(), sizeof(tcpHeader), &tcpHeader);
+    VerifyOrExit(tcpHeader.GetHeaderLength() >= sizeof(TcpHeader) &&
+                 tcpHeader.GetHeaderLength() <= payloadLength, error = kThreadError_Parse);
+
+    // options are not processed, but the data offset must still be honored
+    aMessage.MoveOffset(tcpHeader.GetHeaderLength());
+    aMessageInfo.mPeerPort = tcpHeader.GetSourcePort();
+    aMessageInfo.mSockPort = tcpHeader.GetDestinationPort();
+
+    // an exact four-tuple match wins over a listener on the local port
+    for (TcpSocket *socket = mSockets; socket; socket = socket->GetNext())
+    {
+        if (socket->GetSockName().mPort != tcpHeader.GetDestinationPort())
+        {
+            continue;
+        }
+
+        if (!socket->GetSockName().GetAddress().IsUnspecified() &&
+            socket->GetSockName().GetAddress() != aMessageInfo.GetSockAddr())
+        {
+            continue;
+        }
+
+        if (socket->mState == TcpSocket::kStateListen)
+        {
+            if (listener == NULL)
+            {
+                listener = socket;
+            }
+
+            continue;
+        }
+
+        if (socket->GetPeerName().mPort != tcpHeader.GetSourcePort() ||
+            socket->GetPeerName().GetAddress() != aMessageInfo.GetPeerAddr())
+        {
+            continue;
+        }
+
+        socket->ProcessReceive(tcpHeader, aMessage, aMessageInfo);
+        ExitNow();
+    }
+
+    if (listener != NULL)
+    {
+        listener->ProcessReceive(tcpHeader, aMessage, aMessageInfo);
+        ExitNow();
+    }
+
+    // no matching connection: answer with a reset, unless this is one
+    if ((tcpHeader.GetFlags() & TcpHeader::kFlagRst) == 0)
+    {
+        SendReset(tcpHeader, payloadLength - tcpHeader.GetHeaderLength(), aMessageInfo);
+    }
+
+exit:
+    return error;
+}
+
+ThreadError Tcp::SendReset(const TcpHeader &aHeader, uint16_t aSegmentLength, const MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    Message *message = NULL;
+    MessageInfo messageInfo;
+    TcpHeader tcpHeader;
+    uint32_t sequence;
+    uint32_t ack;
+    uint16_t flags;
+
+    if ((aHeader.GetFlags() & TcpHeader::kFlagAck) != 0)
+    {
+        sequence = aHeader.GetAcknowledgmentNumber();
+        ack = 0;
+        flags = TcpHeader::kFlagRst;
+    }
+    else
+    {
+        sequence = 0;
+        ack = aHeader.GetSequenceNumber() + aSegmentLength;
+
+        if ((aHeader.GetFlags() & TcpHeader::kFlagSyn) != 0)
+        {
+            ack++;
+        }
+
+        if ((aHeader.GetFlags() & TcpHeader::kFlagFin) != 0)
+        {
+            ack++;
+        }
+
+        flags = TcpHeader::kFlagRst | TcpHeader::kFlagAck;
+    }
+
+    VerifyOrExit((message = NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+
+    tcpHeader.SetSourcePort(aHeader.GetDestinationPort());
+    tcpHeader.SetDestinationPort(aHeader.GetSourcePort());
+    tcpHeader.SetSequenceNumber(sequence);
+    tcpHeader.SetAcknowledgmentNumber(ack);
+    tcpHeader.SetFlags(static_cast<uint16_t>(((sizeof(TcpHeader) / 4) << TcpHeader::kDataOffsetShift) | flags));
+    tcpHeader.SetWindow(0);
+    tcpHeader.SetChecksum(0);
+    tcpHeader.SetUrgentPointer(0);
+
+    SuccessOrExit(error = message->Prepend(&tcpHeader, sizeof(tcpHeader)));
+    message->SetOffset(0);
+
+    memset(&messageInfo, 0, sizeof(messageInfo));
+    messageInfo.GetSockAddr() = aMessageInfo.GetSockAddr();
+    messageInfo.GetPeerAddr() = aMessageInfo.GetPeerAddr();
+    messageInfo.mPeerPort = aHeader.GetSourcePort();
+    messageInfo.mInterfaceId = aMessageInfo.mInterfaceId;
+
+    SuccessOrExit(error = mIp6.SendDatagram(*message, messageInfo, kProtoTcp));
+    message = NULL;
+
+exit:
+
+    if (message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError Tcp::UpdateChecksum(Message &aMessage, uint16_t aChecksum)
+{
+    aChecksum = aMessage.UpdateChecksum(aChecksum, aMessage.GetOffset(), aMessage.GetLength() - aMessage.GetOffset());
+
+    if (aChecksum != 0xffff)
+    {
+        aChecksum = ~aChecksum;
+    }
+
+    aChecksum = HostSwap16(aChecksum);
+    aMessage.Write(aMessage.GetOffset() + TcpHeader::GetChecksumOffset(), sizeof(aChecksum), &aChecksum);
+    return kThreadError_None;
+}
+
+}  // namespace Ip6
+}  // namespace Thread
@@ -28,23 +28,30 @@
 
 /**
  * @file
- *   This file includes definitions for parsing TCP header.
+ *   This file includes definitions for TCP/IPv6 sockets.
  */
 
 #ifndef TCP_HPP_
 #define TCP_HPP_
 
 #include <openthread.h>
+#include <common/message.hpp>
+#include <common/timer.hpp>
 #include <net/ip6_headers.hpp>
+#include <net/socket.hpp>
+
+using Thread::Encoding::BigEndian::HostSwap32;
 
 namespace Thread {
 namespace Ip6 {
 
+class Tcp;
+
 /**
  * @addtogroup core-tcp
  *
  * @brief
- *   This module includes definitions for parsing TCP header
+ *   This module includes definitions for TCP/IPv6 sockets.
  *
  * @{
  *
@@ -71,6 +78,17 @@ OT_TOOL_PACKED_BEGIN
 class TcpHeader: private TcpHeaderPoD
 {
 public:
+    enum
+    {
+        kFlagFin = 1 << 0,  ///< Sender has finished sending data.
+        kFlagSyn = 1 << 1,  ///< Synchronize sequence numbers.
+        kFlagRst = 1 << 2,  ///< Reset the connection.
+        kFlagPsh = 1 << 3,  ///< Push received data to the application.
+        kFlagAck = 1 << 4,  ///< The Acknowledgment Number field is significant.
+
+        kDataOffsetShift = 12,  ///< Bit offset of the Data Offset field within the Flags word.
+    };
+
     /**
      * This method returns the TCP Source Port.
      *
@@ -135,8 +153,419 @@ public:
      */
     uint16_t GetUrgentPointer(void) const { return HostSwap16(mUrgentPointer); }
 
+    /**
+     * This method returns the TCP header length in bytes, as encoded in the Data Offset field.
+     *
+     * @returns The TCP header length in bytes.
+     *
+     */
+    uint8_t GetHeaderLength(void) const { return static_cast<uint8_t>((GetFlags() >> kDataOffsetShift) * 4); }
+
+    /**
+     * This method sets the TCP Source Port.
+     *
+     * @param[in]  aPort  The TCP Source Port.
+     *
+     */
+    void SetSourcePort(uint16_t aPort) { mSource = HostSwap16(aPort); }
+
+    /**
+     * This method sets the TCP Destination Port.
+     *
+     * @param[in]  aPort  The TCP Destination Port.
+     *
+     */
+    void SetDestinationPort(uint16_t aPort) { mDestination = HostSwap16(aPort); }
+
+    /**
+     * This method sets the TCP Sequence Number.
+     *
+     * @param[in]  aSequenceNumber  The TCP Sequence Number.
+     *
+     */
+    void SetSequenceNumber(uint32_t aSequenceNumber) { mSequenceNumber = HostSwap32(aSequenceNumber); }
+
+    /**
+     * This method sets the TCP Acknowledgment Sequence Number.
+     *
+     * @param[in]  aAckNumber  The TCP Acknowledgment Sequence Number.
+     *
+     */
+    void SetAcknowledgmentNumber(uint32_t aAckNumber) { mAckNumber = HostSwap32(aAckNumber); }
+
+    /**
+     * This method sets the TCP Flags, including the Data Offset field.
+     *
+     * @param[in]  aFlags  The TCP Flags.
+     *
+     */
+    void SetFlags(uint16_t aFlags) { mFlags = HostSwap16(aFlags); }
+
+    /**
+     * This method sets the TCP Window.
+     *
+     * @param[in]  aWindow  The TCP Window.
+     *
+     */
+    void SetWindow(uint16_t aWindow) { mWindow = HostSwap16(aWindow); }
+
+    /**
+     * This method sets the TCP Checksum.
+     *
+     * @param[in]  aChecksum  The TCP Checksum.
+     *
+     */
+    void SetChecksum(uint16_t aChecksum) { mChecksum = HostSwap16(aChecksum); }
+
+    /**
+     * This method sets the TCP Urgent Pointer.
+     *
+     * @param[in]  aUrgentPointer  The TCP Urgent Pointer.
+     *
+     */
+    void SetUrgentPointer(uint16_t aUrgentPointer) { mUrgentPointer = HostSwap16(aUrgentPointer); }
+
+    /**
+     * This static method returns the byte offset for the TCP Checksum.
+     *
+     * @returns The byte offset for the TCP Checksum.
+     *
+     */
+    static uint8_t GetChecksumOffset(void) { return offsetof(TcpHeaderPoD, mChecksum); }
+
 } OT_TOOL_PACKED_END;
 
+/**
+ * This class implements a TCP/IPv6 socket.
+ *
+ * The implementation is intentionally lean: one send buffer per connection, no selective
+ * acknowledgments, and in-order receive only, which is sufficient for on-device management
+ * streams without hairpinning them through the host processor.
+ *
+ */
+class TcpSocket
+{
+    friend class Tcp;
+
+public:
+    enum
+    {
+        kEventConnected    = 0,  ///< The connection was established.
+        kEventDataSent     = 1,  ///< The send buffer was fully acknowledged and released.
+        kEventPeerClosed   = 2,  ///< The peer finished sending data.
+        kEventDisconnected = 3,  ///< The connection was fully closed, reset, or timed out.
+    };
+
+    /**
+     * This function pointer is called when a connection-level event occurs on the socket.
+     *
+     * @param[in]  aContext  A pointer to arbitrary context information.
+     * @param[in]  aEvent    The event that occurred.
+     *
+     */
+    typedef void (*EventHandler)(void *aContext, uint8_t aEvent);
+
+    /**
+     * This function pointer is called when in-order TCP payload data is received.
+     *
+     * @param[in]  aContext      A pointer to arbitrary context information.
+     * @param[in]  aMessage      A reference to the message, with the offset at the first payload byte.
+     * @param[in]  aMessageInfo  A reference to the message info associated with @p aMessage.
+     *
+     */
+    typedef void (*ReceiveHandler)(void *aContext, Message &aMessage, const MessageInfo &aMessageInfo);
+
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in]  aTcp  A reference to the TCP transport object.
+     *
+     */
+    TcpSocket(Tcp &aTcp);
+
+    /**
+     * This method returns a new TCP message with sufficient header space reserved.
+     *
+     * @param[in]  aReserved  The number of header bytes to reserve after the TCP header.
+     *
+     * @returns A pointer to the message or NULL if no buffers are available.
+     *
+     */
+    Message *NewMessage(uint16_t aReserved);
+
+    /**
+     * This method opens the TCP socket.
+     *
+     * @param[in]  aReceiveHandler  A pointer to a function that is called when payload data is received.
+     * @param[in]  aEventHandler    A pointer to a function that is called on connection-level events.
+     * @param[in]  aContext         A pointer to arbitrary context information.
+     *
+     * @retval kThreadError_None  Successfully opened the socket.
+     *
+     */
+    ThreadError Open(ReceiveHandler aReceiveHandler, EventHandler aEventHandler, void *aContext);
+
+    /**
+     * This method binds the TCP socket to a local address and port.
+     *
+     * @param[in]  aSockAddr  A reference to the socket address.
+     *
+     * @retval kThreadError_None  Successfully bound the socket.
+     *
+     */
+    ThreadError Bind(const SockAddr &aSockAddr);
+
+    /**
+     * This method starts listening for an inbound connection.
+     *
+     * A listening socket accepts one connection at a time; it transitions into the new
+     * connection itself rather than spawning a separate socket.
+     *
+     * @retval kThreadError_None          Successfully started listening.
+     * @retval kThreadError_InvalidState  The socket is not closed or is not bound to a port.
+     *
+     */
+    ThreadError Listen(void);
+
+    /**
+     * This method initiates a connection to a peer.
+     *
+     * @param[in]  aSockAddr  A reference to the peer's socket address.
+     *
+     * @retval kThreadError_None          Successfully initiated the connection.
+     * @retval kThreadError_InvalidState  The socket is not closed.
+     * @retval kThreadError_NoBufs        Insufficient message buffers to send the initial segment.
+     *
+     */
+    ThreadError Connect(const SockAddr &aSockAddr);
+
+    /**
+     * This method sends a message over the connection.
+     *
+     * On success the socket takes ownership of @p aMessage and frees it once the peer has
+     * acknowledged all of its bytes, signaling kEventDataSent.
+     *
+     * @param[in]  aMessage  The message to send.
+     *
+     * @retval kThreadError_None          Successfully queued the message for transmission.
+     * @retval kThreadError_InvalidState  The connection is not established.
+     * @retval kThreadError_Busy          A previous send buffer is still unacknowledged.
+     *
+     */
+    ThreadError Send(Message &aMessage);
+
+    /**
+     * This method gracefully closes the connection.
+     *
+     * Any queued send data is delivered before the FIN; kEventDisconnected signals completion.
+     *
+     * @retval kThreadError_None  Successfully initiated the close.
+     *
+     */
+    ThreadError Close(void);
+
+    /**
+     * This method aborts the connection, sending a reset to the peer if one is established.
+     *
+     */
+    void Abort(void);
+
+    /**
+     * This method indicates whether the connection is established.
+     *
+     * @returns TRUE if the connection is established, FALSE otherwise.
+     *
+     */
+    bool IsConnected(void) const { return mState == kStateEstablished; }
+
+    /**
+     * This method returns the local socket address.
+     *
+     * @returns A reference to the local socket address.
+     *
+     */
+    SockAddr &GetSockName(void) { return mSockName; }
+
+    /**
+     * This method returns the peer's socket address.
+     *
+     * @returns A reference to the peer's socket address.
+     *
+     */
+    SockAddr &GetPeerName(void) { return mPeerName; }
+
+private:
+    enum State
+    {
+        kStateClosed      = 0,
+        kStateListen      = 1,
+        kStateSynSent     = 2,
+        kStateSynReceived = 3,
+        kStateEstablished = 4,
+        kStateFinWait1    = 5,
+        kStateFinWait2    = 6,
+        kStateClosing     = 7,
+        kStateCloseWait   = 8,
+        kStateLastAck     = 9,
+        kStateTimeWait    = 10,
+    };
+
+    enum
+    {
+        kMaxSegmentSize     = 512,    ///< Largest payload sent in one segment.
+        kReceiveWindow      = 1024,   ///< Window advertised to the peer.
+        kRetransmitTimeout  = 1000,   ///< Initial retransmission timeout (milliseconds).
+        kMaxRetransmitCount = 5,      ///< Number of retransmissions before the connection is dropped.
+        kTimeWaitTimeout    = 5000,   ///< Linger time before releasing a closed connection (milliseconds).
+    };
+
+    static bool SequenceGreaterThan(uint32_t aLhs, uint32_t aRhs) {
+        return static_cast<int32_t>(aLhs - aRhs) > 0;
+    }
+
+    TcpSocket *GetNext(void) { return mNext; }
+    void SetNext(TcpSocket *aSocket) { mNext = aSocket; }
+
+    void ProcessReceive(const TcpHeader &aHeader, Message &aMessage, const MessageInfo &aMessageInfo);
+    void ProcessAck(const TcpHeader &aHeader);
+    ThreadError SendSegment(uint16_t aFlags, uint32_t aSequence, uint16_t aBufferOffset, uint16_t aLength);
+    ThreadError SendControl(uint16_t aFlags);
+    ThreadError SendData(void);
+    void SendFin(void);
+    void SetState(State aState);
+    void SignalEvent(uint8_t aEvent);
+    void ReleaseSendBuffer(void);
+    void Disconnect(uint8_t aEvent);
+
+    static void HandleTimer(void *aContext);
+    void HandleTimer(void);
+
+    Tcp *mTcp;
+    TcpSocket *mNext;
+    SockAddr mSockName;
+    SockAddr mPeerName;
+    ReceiveHandler mReceiveHandler;
+    EventHandler mEventHandler;
+    void *mContext;
+
+    Timer mTimer;
+    uint8_t mState;
+    uint8_t mRetransmitCount;
+    uint32_t mRetransmitTimeout;
+
+    uint32_t mSndUna;       ///< Oldest unacknowledged sequence number.
+    uint32_t mSndNxt;       ///< Next sequence number to send.
+    uint16_t mSndWnd;       ///< Send window advertised by the peer.
+    uint32_t mRcvNxt;       ///< Next sequence number expected from the peer.
+
+    Message *mSendBuffer;   ///< The single outstanding send buffer, NULL when idle.
+    uint32_t mSendBufferSeq;  ///< Sequence number of the first byte in the send buffer.
+    bool mFinPending;       ///< TRUE when a FIN awaits the send buffer draining.
+};
+
+/**
+ * This class implements core TCP message handling.
+ *
+ */
+class Tcp
+{
+    friend class TcpSocket;
+
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in]  aIp6  A reference to the IPv6 network object.
+     *
+     */
+    Tcp(Ip6 &aIp6);
+
+    /**
+     * This method adds a TCP socket.
+     *
+     * @param[in]  aSocket  A reference to the TCP socket.
+     *
+     * @retval kThreadError_None  Successfully added the TCP socket.
+     *
+     */
+    ThreadError AddSocket(TcpSocket &aSocket);
+
+    /**
+     * This method removes a TCP socket.
+     *
+     * @param[in]  aSocket  A reference to the TCP socket.
+     *
+     * @retval kThreadError_None  Successfully removed the TCP socket.
+     *
+     */
+    ThreadError RemoveSocket(TcpSocket &aSocket);
+
+    /**
+     * This method returns a new ephemeral port.
+     *
+     * @returns A new ephemeral port.
+     *
+     */
+    uint16_t GetEphemeralPort(void);
+
+    /**
+     * This method returns an initial sequence number for a new connection.
+     *
+     * @returns An initial sequence number.
+     *
+     */
+    uint32_t GetInitialSequence(void);
+
+    /**
+     * This method returns a new TCP message with sufficient header space reserved.
+     *
+     * @param[in]  aReserved  The number of header bytes to reserve after the TCP header.
+     *
+     * @returns A pointer to the message or NULL if no buffers are available.
+     *
+     */
+    Message *NewMessage(uint16_t aReserved);
+
+    /**
+     * This method handles a received TCP segment.
+     *
+     * @param[in]  aMessage      A reference to the TCP segment to process.
+     * @param[in]  aMessageInfo  A reference to the message info associated with @p aMessage.
+     *
+     * @retval kThreadError_None  Successfully processed the TCP segment.
+     * @retval kThreadError_Drop  Could not fully process the TCP segment.
+     *
+     */
+    ThreadError HandleMessage(Message &aMessage, MessageInfo &aMessageInfo);
+
+    /**
+     * This method updates the TCP checksum.
+     *
+     * @param[in]  aMessage               A reference to the TCP segment.
+     * @param[in]  aPseudoHeaderChecksum  The pseudo-header checksum value.
+     *
+     * @retval kThreadError_None  Successfully updated the TCP checksum.
+     *
+     */
+    ThreadError UpdateChecksum(Message &aMessage, uint16_t aPseudoHeaderChecksum);
+
+private:
+    enum
+    {
+        kDynamicPortMin = 49152,  ///< Service Name and Transport Protocol Port Number Registry
+        kDynamicPortMax = 65535,  ///< Service Name and Transport Protocol Port Number Registry
+    };
+
+    ThreadError SendReset(const TcpHeader &aHeader, uint16_t aSegmentLength, const MessageInfo &aMessageInfo);
+
+    uint16_t mEphemeralPort;
+    uint32_t mInitialSequenceOffset;
+    // a handful of management connections at most, so a plain list suffices here
+    TcpSocket *mSockets;
+
+    Ip6 &mIp6;
+};
+
 /**
  * @}
  *
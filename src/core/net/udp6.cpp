@@ -46,11 +46,12 @@ namespace Ip6 {
 UdpSocket::UdpSocket(Udp &aUdp)
 {
     mTransport = &aUdp;
+    mDrainEnabled = false;
 }
 
-Message *UdpSocket::NewMessage(uint16_t aReserved)
+Message *UdpSocket::NewMessage(uint16_t aReserved, uint8_t aPriority)
 {
-    return static_cast<Udp *>(mTransport)->NewMessage(aReserved);
+    return static_cast<Udp *>(mTransport)->NewMessage(aReserved, aPriority);
 }
 
 ThreadError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
@@ -66,21 +67,103 @@ ThreadError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
 ThreadError UdpSocket::Bind(const SockAddr &aSockAddr)
 {
     mSockName = aSockAddr;
+    static_cast<Udp *>(mTransport)->UpdateSocket(*this);
     return kThreadError_None;
 }
 
 ThreadError UdpSocket::Close(void)
 {
     ThreadError error = kThreadError_None;
+    Message *message;
 
     SuccessOrExit(error = static_cast<Udp *>(mTransport)->RemoveSocket(*this));
     memset(&mSockName, 0, sizeof(mSockName));
     memset(&mPeerName, 0, sizeof(mPeerName));
 
+    while ((message = mReceiveQueue.GetHead()) != NULL)
+    {
+        mReceiveQueue.Dequeue(*message);
+        message->Free();
+    }
+
 exit:
     return error;
 }
 
+void UdpSocket::SetDrainEnabled(bool aEnabled)
+{
+    Message *message;
+
+    mDrainEnabled = aEnabled;
+
+    if (!aEnabled)
+    {
+        while ((message = mReceiveQueue.GetHead()) != NULL)
+        {
+            mReceiveQueue.Dequeue(*message);
+            message->Free();
+        }
+    }
+}
+
+Message *UdpSocket::Drain(MessageInfo &aMessageInfo)
+{
+    Message *message = mReceiveQueue.GetHead();
+    Header ip6Header;
+    UdpHeader udpHeader;
+
+    VerifyOrExit(message != NULL, ;);
+
+    mReceiveQueue.Dequeue(*message);
+
+    // the queued datagram still carries its IPv6 and UDP headers ahead of the
+    // offset, so the message info is rebuilt from them rather than stored
+    message->Read(0, sizeof(ip6Header), &ip6Header);
+    message->Read(message->GetOffset() - sizeof(udpHeader), sizeof(udpHeader), &udpHeader);
+
+    memset(&aMessageInfo, 0, sizeof(aMessageInfo));
+    aMessageInfo.GetPeerAddr() = ip6Header.GetSource();
+    aMessageInfo.GetSockAddr() = ip6Header.GetDestination();
+    aMessageInfo.mPeerPort = udpHeader.GetSourcePort();
+    aMessageInfo.mSockPort = udpHeader.GetDestinationPort();
+    aMessageInfo.mInterfaceId = message->GetInterfaceId();
+    aMessageInfo.mHopLimit = ip6Header.GetHopLimit();
+
+exit:
+    return message;
+}
+
+void UdpSocket::HandleUdpReceive(Message &aMessage, const MessageInfo &aMessageInfo)
+{
+    Message *clone;
+    bool wasEmpty;
+
+    if (!mDrainEnabled)
+    {
+        mHandler(mContext, &aMessage, &aMessageInfo);
+        ExitNow();
+    }
+
+    wasEmpty = (mReceiveQueue.GetHead() == NULL);
+
+    // the stack reclaims @p aMessage when delivery completes, so queue a clone;
+    // on allocation failure the datagram is dropped, as UDP permits
+    VerifyOrExit((clone = aMessage.Clone()) != NULL, ;);
+
+    clone->SetInterfaceId(aMessageInfo.mInterfaceId);
+    mReceiveQueue.Enqueue(*clone);
+
+    // one readiness notification per burst: the handler sees a NULL message
+    // when the queue becomes non-empty and drains from its own context
+    if (wasEmpty)
+    {
+        mHandler(mContext, NULL, &aMessageInfo);
+    }
+
+exit:
+    {}
+}
+
 ThreadError UdpSocket::SendTo(Message &aMessage, const MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
@@ -97,6 +180,7 @@ ThreadError UdpSocket::SendTo(Message &aMessage, const MessageInfo &aMessageInfo
     if (GetSockName().mPort == 0)
     {
         GetSockName().mPort = static_cast<Udp *>(mTransport)->GetEphemeralPort();
+        static_cast<Udp *>(mTransport)->UpdateSocket(*this);
     }
 
     udpHeader.SetSourcePort(GetSockName().mPort);
@@ -117,43 +201,81 @@ Udp::Udp(Ip6 &aIp6):
     mSockets(NULL),
     mIp6(aIp6)
 {
+    for (int i = 0; i < kSocketHashSize; i++)
+    {
+        mSocketBuckets[i] = NULL;
+    }
 }
 
-ThreadError Udp::AddSocket(UdpSocket &aSocket)
+uint8_t Udp::SocketHash(uint16_t aPort)
+{
+    return static_cast<uint8_t>((aPort ^ (aPort >> 8)) & (kSocketHashSize - 1));
+}
+
+bool Udp::UnlinkFrom(UdpSocket *&aHead, UdpSocket &aSocket)
 {
-    for (UdpSocket *cur = mSockets; cur; cur = cur->GetNext())
+    bool found = false;
+
+    if (aHead == &aSocket)
     {
-        if (cur == &aSocket)
+        aHead = aSocket.GetNext();
+        ExitNow(found = true);
+    }
+
+    for (UdpSocket *socket = aHead; socket; socket = socket->GetNext())
+    {
+        if (socket->GetNext() == &aSocket)
         {
-            ExitNow();
+            socket->SetNext(aSocket.GetNext());
+            ExitNow(found = true);
         }
     }
 
-    aSocket.SetNext(mSockets);
-    mSockets = &aSocket;
-
 exit:
-    return kThreadError_None;
+    return found;
 }
 
-ThreadError Udp::RemoveSocket(UdpSocket &aSocket)
+bool Udp::UnlinkSocket(UdpSocket &aSocket)
 {
-    if (mSockets == &aSocket)
+    bool found = UnlinkFrom(mSockets, aSocket);
+
+    for (int i = 0; !found && i < kSocketHashSize; i++)
     {
-        mSockets = mSockets->GetNext();
+        found = UnlinkFrom(mSocketBuckets[i], aSocket);
     }
-    else
+
+    return found;
+}
+
+void Udp::LinkSocket(UdpSocket &aSocket)
+{
+    UdpSocket **head = (aSocket.GetSockName().mPort == 0) ?
+                       &mSockets : &mSocketBuckets[SocketHash(aSocket.GetSockName().mPort)];
+
+    aSocket.SetNext(*head);
+    *head = &aSocket;
+}
+
+void Udp::UpdateSocket(UdpSocket &aSocket)
+{
+    // relink into the bucket matching the socket's current port, but only if it was added
+    if (UnlinkSocket(aSocket))
     {
-        for (UdpSocket *socket = mSockets; socket; socket = socket->GetNext())
-        {
-            if (socket->GetNext() == &aSocket)
-            {
-                socket->SetNext(socket->GetNext());
-                break;
-            }
-        }
+        LinkSocket(aSocket);
     }
+}
 
+ThreadError Udp::AddSocket(UdpSocket &aSocket)
+{
+    UnlinkSocket(aSocket);
+    LinkSocket(aSocket);
+
+    return kThreadError_None;
+}
+
+ThreadError Udp::RemoveSocket(UdpSocket &aSocket)
+{
+    UnlinkSocket(aSocket);
     aSocket.SetNext(NULL);
 
     return kThreadError_None;
@@ -175,9 +297,9 @@ uint16_t Udp::GetEphemeralPort(void)
     return rval;
 }
 
-Message *Udp::NewMessage(uint16_t aReserved)
+Message *Udp::NewMessage(uint16_t aReserved, uint8_t aPriority)
 {
-    return mIp6.NewMessage(sizeof(UdpHeader) + aReserved);
+    return mIp6.NewMessage(sizeof(UdpHeader) + aReserved, aPriority);
 }
 
 ThreadError Udp::SendDatagram(Message &aMessage, MessageInfo &aMessageInfo, IpProto aIpProto)
@@ -208,8 +330,9 @@ ThreadError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
     aMessageInfo.mPeerPort = udpHeader.GetSourcePort();
     aMessageInfo.mSockPort = udpHeader.GetDestinationPort();
 
-    // find socket
-    for (UdpSocket *socket = mSockets; socket; socket = socket->GetNext())
+    // find socket: bound sockets live in the bucket hashed by their port
+    for (UdpSocket *socket = mSocketBuckets[SocketHash(udpHeader.GetDestinationPort())];
+         socket; socket = socket->GetNext())
     {
         if (socket->GetSockName().mPort != udpHeader.GetDestinationPort())
         {
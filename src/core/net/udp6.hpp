@@ -73,11 +73,12 @@ public:
      * This method returns a new UDP message with sufficient header space reserved.
      *
      * @param[in]  aReserved  The number of header bytes to reserve after the UDP header.
+     * @param[in]  aPriority  The priority level of the message.
      *
      * @returns A pointer to the message or NULL if no buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This method opens the UDP socket.
@@ -138,13 +139,41 @@ public:
      */
     SockAddr &GetPeerName(void) { return *static_cast<SockAddr *>(&mPeerName); }
 
+    /**
+     * This method enables or disables drain mode.
+     *
+     * In drain mode, received datagrams queue on the socket instead of being delivered
+     * through the receive handler one at a time, and the owner retrieves them in a batch
+     * with Drain().  The receive handler is called once with a NULL message when the
+     * queue transitions from empty to non-empty, serving as a per-burst readiness
+     * notification.  Disabling drain mode frees any queued datagrams.
+     *
+     * @param[in]  aEnabled  TRUE to enable drain mode, FALSE to disable.
+     *
+     */
+    void SetDrainEnabled(bool aEnabled);
+
+    /**
+     * This method dequeues the next received datagram in drain mode.
+     *
+     * Ownership of the returned message passes to the caller, who must free it.  The
+     * message offset points at the UDP payload.
+     *
+     * @param[out]  aMessageInfo  The message info associated with the returned datagram.
+     *
+     * @returns A pointer to the next queued datagram or NULL if the queue is empty.
+     *
+     */
+    Message *Drain(MessageInfo &aMessageInfo);
+
 private:
     UdpSocket *GetNext(void) { return static_cast<UdpSocket *>(mNext); }
     void SetNext(UdpSocket *socket) { mNext = static_cast<otUdpSocket *>(socket); }
 
-    void HandleUdpReceive(Message &aMessage, const MessageInfo &aMessageInfo) {
-        mHandler(mContext, &aMessage, &aMessageInfo);
-    }
+    void HandleUdpReceive(Message &aMessage, const MessageInfo &aMessageInfo);
+
+    MessageQueue mReceiveQueue;
+    bool mDrainEnabled;
 };
 
 /**
@@ -196,11 +225,12 @@ public:
      * This method returns a new UDP message with sufficient header space reserved.
      *
      * @param[in]  aReserved  The number of header bytes to reserve after the UDP header.
+     * @param[in]  aPriority  The priority level of the message.
      *
      * @returns A pointer to the message or NULL if no buffers are available.
      *
      */
-    Message *NewMessage(uint16_t aReserved);
+    Message *NewMessage(uint16_t aReserved, uint8_t aPriority = Message::kPriorityNormal);
 
     /**
      * This method sends an IPv6 datagram.
@@ -245,8 +275,21 @@ private:
         kDynamicPortMin = 49152,  ///< Service Name and Transport Protocol Port Number Registry
         kDynamicPortMax = 65535,  ///< Service Name and Transport Protocol Port Number Registry
     };
+
+    enum
+    {
+        kSocketHashSize = 8,  ///< Number of bound socket hash buckets (power of two).
+    };
+
+    static uint8_t SocketHash(uint16_t aPort);
+    static bool UnlinkFrom(UdpSocket *&aHead, UdpSocket &aSocket);
+    bool UnlinkSocket(UdpSocket &aSocket);
+    void LinkSocket(UdpSocket &aSocket);
+    void UpdateSocket(UdpSocket &aSocket);
+
     uint16_t mEphemeralPort;
-    UdpSocket *mSockets;
+    UdpSocket *mSockets;                         ///< Unbound (port 0) sockets.
+    UdpSocket *mSocketBuckets[kSocketHashSize];  ///< Bound sockets hashed by port.
 
     Ip6 &mIp6;
 };
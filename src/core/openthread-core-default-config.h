@@ -55,6 +55,212 @@
 #define OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE               128
 #endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE
 
+/**
+ * @def OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL
+ *
+ * The number of small message buffers in the buffer pool.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL
+#define OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL         16
+#endif  // OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL
+
+/**
+ * @def OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_SMALL
+ *
+ * The size of a small message buffer in bytes.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_SMALL
+#define OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_SMALL         32
+#endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_SMALL
+
+/**
+ * @def OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE
+ *
+ * The number of large message buffers in the buffer pool.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE
+#define OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE         4
+#endif  // OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE
+
+/**
+ * @def OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_LARGE
+ *
+ * The size of a large message buffer in bytes.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_LARGE
+#define OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_LARGE         256
+#endif  // OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE_LARGE
+
+/**
+ * @def OPENTHREAD_CONFIG_NUM_RESERVED_PRIORITY_BUFFERS
+ *
+ * The number of message buffers reserved for high priority (control) messages.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_RESERVED_PRIORITY_BUFFERS
+#define OPENTHREAD_CONFIG_NUM_RESERVED_PRIORITY_BUFFERS     4
+#endif  // OPENTHREAD_CONFIG_NUM_RESERVED_PRIORITY_BUFFERS
+
+/**
+ * @def OPENTHREAD_CONFIG_NUM_RESERVED_RECEIVE_BUFFERS
+ *
+ * The number of message buffers held in reserve for received frames. Transmit allocations may
+ * not use these buffers, so a transmit burst cannot starve the acknowledgments and responses
+ * needed to drain it.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_RESERVED_RECEIVE_BUFFERS
+#define OPENTHREAD_CONFIG_NUM_RESERVED_RECEIVE_BUFFERS      2
+#endif  // OPENTHREAD_CONFIG_NUM_RESERVED_RECEIVE_BUFFERS
+
+/**
+ * @def OPENTHREAD_CONFIG_ICMP_ERRORS_PER_SECOND
+ *
+ * The maximum sustained rate of ICMPv6 error message generation, in messages per second.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ICMP_ERRORS_PER_SECOND
+#define OPENTHREAD_CONFIG_ICMP_ERRORS_PER_SECOND            4
+#endif  // OPENTHREAD_CONFIG_ICMP_ERRORS_PER_SECOND
+
+/**
+ * @def OPENTHREAD_CONFIG_ICMP_ERROR_BURST
+ *
+ * The number of ICMPv6 error messages that may be generated in a burst after an idle period.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ICMP_ERROR_BURST
+#define OPENTHREAD_CONFIG_ICMP_ERROR_BURST                  8
+#endif  // OPENTHREAD_CONFIG_ICMP_ERROR_BURST
+
+/**
+ * @def OPENTHREAD_CONFIG_TASKLET_HIGH_PRIORITY_WEIGHT
+ *
+ * The number of consecutive high priority tasklets run before one normal priority slot is yielded.
+ *
+ */
+/**
+ * @def OPENTHREAD_CONFIG_TRICKLE_COALESCING_SLACK
+ *
+ * The default coalescing slack for trickle timers in milliseconds.
+ *
+ * Trickle firings are aligned down to multiples of the slack so that timers sharing a
+ * slack value wake the scheduler together. Zero disables coalescing.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_TRICKLE_COALESCING_SLACK
+#define OPENTHREAD_CONFIG_TRICKLE_COALESCING_SLACK          0
+#endif  // OPENTHREAD_CONFIG_TRICKLE_COALESCING_SLACK
+
+#ifndef OPENTHREAD_CONFIG_TASKLET_HIGH_PRIORITY_WEIGHT
+#define OPENTHREAD_CONFIG_TASKLET_HIGH_PRIORITY_WEIGHT      8
+#endif  // OPENTHREAD_CONFIG_TASKLET_HIGH_PRIORITY_WEIGHT
+
+/**
+ * @def OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+ *
+ * Enable time stamping around tasklet and timer handler invocations, feeding the handler latency
+ * histogram returned by otGetHandlerLatencyHistogram().
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+#define OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR    0
+#endif  // OPENTHREAD_CONFIG_ENABLE_HANDLER_LATENCY_MONITOR
+
+/**
+ * @def OPENTHREAD_CONFIG_LOG_BINARY
+ *
+ * Enable deferred-formatting binary logging. Log sites record the format string address and raw
+ * arguments into a ring readable via otLogBinaryRead(), instead of formatting on-device through
+ * otPlatLog(). The records are formatted off-device using the format strings from the image.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_BINARY
+#define OPENTHREAD_CONFIG_LOG_BINARY                        0
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY
+
+/**
+ * @def OPENTHREAD_CONFIG_LOG_BINARY_RING_SIZE
+ *
+ * The size (in bytes) of the binary log ring. Records that do not fit are dropped.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_LOG_BINARY_RING_SIZE
+#define OPENTHREAD_CONFIG_LOG_BINARY_RING_SIZE              512
+#endif  // OPENTHREAD_CONFIG_LOG_BINARY_RING_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD
+ *
+ * The handler run time (in milliseconds) at or above which the handler latency monitor logs the
+ * offending handler address.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD
+#define OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD     10
+#endif  // OPENTHREAD_CONFIG_HANDLER_LATENCY_LOG_THRESHOLD
+
+/**
+ * @def OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+ *
+ * Enable the stack CPU budget governor. Handler run time is accounted against a per-second budget
+ * and, when the budget is exceeded, load is shed in a defined order (defer diagnostic scans,
+ * dampen MLE Advertisements, drop normal-priority forwarded datagrams).
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+#define OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR               0
+#endif  // OPENTHREAD_CONFIG_ENABLE_CPU_GOVERNOR
+
+/**
+ * @def OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND
+ *
+ * The stack CPU budget in handler milliseconds per one-second window.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND
+#define OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND          300
+#endif  // OPENTHREAD_CONFIG_CPU_BUDGET_MS_PER_SECOND
+
+/**
+ * @def OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES
+ *
+ * The number of entries in the flight recorder event ring. Each entry is 8 bytes, so the
+ * default of 256 entries keeps the always-on ring at 2 KB.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES
+#define OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES       256
+#endif  // OPENTHREAD_CONFIG_FLIGHT_RECORDER_NUM_ENTRIES
+
+/**
+ * @def OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE
+ *
+ * Storage attribute applied to the flight recorder ring. Platforms that want the ring to
+ * survive a warm reset can place it in an uninitialized RAM section, for example
+ * __attribute__((section(".noinit"))). The ring carries a magic word and is re-initialized
+ * automatically when the section contents are not valid.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE
+#define OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE
+#endif  // OPENTHREAD_CONFIG_FLIGHT_RECORDER_NOINIT_ATTRIBUTE
+
+/**
+ * @def OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+ *
+ * Enable interleaving of channel scans with data transmissions, yielding the radio
+ * to queued traffic between scan channels instead of holding it for the full scan.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+#define OPENTHREAD_CONFIG_INTERLEAVED_SCAN                  1
+#endif  // OPENTHREAD_CONFIG_INTERLEAVED_SCAN
+
 /**
  * @def OPENTHREAD_CONFIG_DEFAULT_CHANNEL
  *
@@ -85,11 +291,37 @@
 #define OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD           100
 #endif  // OPENTHREAD_CONFIG_ATTACH_DATA_POLL_PERIOD
 
+/**
+ * @def OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_ROUTER_TIMEOUT
+ *
+ * The Parent Request timeout toward routers in milliseconds for the aggressive attach profile.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_ROUTER_TIMEOUT
+#define OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_ROUTER_TIMEOUT  250
+#endif  // OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_ROUTER_TIMEOUT
+
+/**
+ * @def OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_CHILD_TIMEOUT
+ *
+ * The Parent Request timeout toward routers and REEDs in milliseconds for the aggressive attach profile.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_CHILD_TIMEOUT
+#define OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_CHILD_TIMEOUT   750
+#endif  // OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_CHILD_TIMEOUT
+
 /**
  * @def OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
  *
  * The number of EID-to-RLOC cache entries.
  *
+ * A border router that answers off-mesh queries for mesh devices may raise this to several
+ * thousand (e.g. on posix builds) to hold a full mapping table learned from address
+ * notifications and snooped traffic, eliminating the address-query round trip for
+ * inbound-initiated traffic.  Cache maintenance costs do not grow with the table size:
+ * the recently-used stamp is O(1) and lookups are guarded by a one-byte hash.
+ *
  */
 #ifndef OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
 #define OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES             10
@@ -135,6 +367,79 @@
 #define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT        5
 #endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
 
+/**
+ * @def OPENTHREAD_CONFIG_6LOWPAN_MAX_REASSEMBLIES
+ *
+ * The maximum number of simultaneous 6LoWPAN fragment reassemblies.  When the limit is reached,
+ * the least recently updated reassembly is evicted to make room for a new datagram.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_6LOWPAN_MAX_REASSEMBLIES
+#define OPENTHREAD_CONFIG_6LOWPAN_MAX_REASSEMBLIES          8
+#endif  // OPENTHREAD_CONFIG_6LOWPAN_MAX_REASSEMBLIES
+
+/**
+ * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_BUFFER_QUOTA
+ *
+ * The maximum number of message buffers that may be committed to 6LoWPAN fragment reassembly at
+ * any one time.  A new datagram whose full buffer requirement does not fit within the quota is
+ * rejected at its first fragment rather than failing partway through reassembly.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_BUFFER_QUOTA
+#define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_BUFFER_QUOTA \
+    ((OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_SMALL + OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS + \
+      OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS_LARGE) / 2)
+#endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_BUFFER_QUOTA
+
+/**
+ * @def OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+ *
+ * Define to 1 to compile in the server-side commissioning machinery: the joiner router,
+ * the MeshCoP leader service, the PAN ID query server, and the energy scan server.
+ * Builds that never relay joiners or service commissioner queries may define this to 0
+ * to remove the modules, their RAM, and their dispatch branches entirely.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+#define OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE      1
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
+/**
+ * @def OPENTHREAD_CONFIG_ENABLE_MPL
+ *
+ * Define to 1 to compile in MPL multicast forwarding and duplicate suppression.
+ * Defining this to 0 removes the module; received realm-local multicast datagrams
+ * carrying an MPL option are then discarded, so only disable it on devices that do
+ * not participate in multi-hop multicast.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ENABLE_MPL
+#define OPENTHREAD_CONFIG_ENABLE_MPL                        1
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
+
+/**
+ * @def OPENTHREAD_CONFIG_SCAN_RESULT_RING_SIZE
+ *
+ * The number of active scan results that may be buffered between the receive context and
+ * tasklet-context delivery to the application.  Results arriving while the ring is full are
+ * dropped, so dense-beacon environments may warrant a larger ring.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_SCAN_RESULT_RING_SIZE
+#define OPENTHREAD_CONFIG_SCAN_RESULT_RING_SIZE             8
+#endif  // OPENTHREAD_CONFIG_SCAN_RESULT_RING_SIZE
+
+/**
+ * @def OPENTHREAD_CONFIG_JAM_DETECTION_RSSI_THRESHOLD
+ *
+ * The RSSI threshold in dBm above which an idle channel sample counts toward jam detection.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_JAM_DETECTION_RSSI_THRESHOLD
+#define OPENTHREAD_CONFIG_JAM_DETECTION_RSSI_THRESHOLD      -45
+#endif  // OPENTHREAD_CONFIG_JAM_DETECTION_RSSI_THRESHOLD
+
 /**
  * @def OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES
  *
@@ -142,7 +447,7 @@
  *
  */
 #ifndef OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES
-#define OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES                 32
+#define OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES                 64
 #endif  // OPENTHREAD_CONFIG_MPL_CACHE_ENTRIES
 
 /**
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file defines the otInstance context structure holding all per-node state.
+ */
+
+#ifndef OPENTHREAD_INSTANCE_H_
+#define OPENTHREAD_INSTANCE_H_
+
+#include <openthread-types.h>
+#include <openthread-core-config.h>
+#include <common/command_queue.hpp>
+#include <common/tasklet.hpp>
+#include <net/ip6.hpp>
+#include <thread/thread_netif.hpp>
+
+/**
+ * This structure holds all state belonging to one OpenThread node.
+ *
+ * Every instance of this structure is an independent node, so a single process
+ * can host many nodes (e.g. for in-process network simulation).  The per-node
+ * dynamic state lives in the member objects; the only state shared between
+ * instances is process-wide by nature (the PRNG, the mbedTLS allocator hooks).
+ */
+typedef struct otInstance
+{
+    otInstance(void);
+
+    // scan results are buffered in a ring and delivered in batches from a
+    // tasklet; see HandleScanResultTask() in openthread.cpp
+    otHandleActiveScanResult mActiveScanCallback;
+    void                    *mActiveScanCallbackContext;
+    otActiveScanResult       mScanResultRing[OPENTHREAD_CONFIG_SCAN_RESULT_RING_SIZE];
+    uint8_t                  mScanResultHead;
+    uint8_t                  mScanResultCount;
+    bool                     mScanCompletePending;
+
+    otHandleEnergyScanResult mEnergyScanCallback;
+    void                    *mEnergyScanCallbackContext;
+
+    otHandleActiveScanResult mDiscoverCallback;
+    void                    *mDiscoverCallbackContext;
+
+    Thread::Ip6::NetifCallback mNetifCallback;
+    Thread::CommandQueue       mCommandQueue;
+
+    Thread::Ip6::Ip6    mIp6;
+    Thread::Tasklet     mScanResultTask;
+    Thread::ThreadNetif mThreadNetif;
+} otInstance;
+
+#endif  // OPENTHREAD_INSTANCE_H_
@@ -36,8 +36,9 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/perf_counters.hpp>
+#include <common/random.hpp>
 #include <mac/mac_frame.hpp>
-#include <platform/random.h>
 #include <thread/address_resolver.hpp>
 #include <thread/mesh_forwarder.hpp>
 #include <thread/mle_router.hpp>
@@ -62,11 +63,12 @@ AddressResolver::AddressResolver(ThreadNetif &aThreadNetif) :
     mNetif(aThreadNetif)
 {
     memset(&mCache, 0, sizeof(mCache));
+    mAgeClock = 0;
 
     mCoapServer.AddResource(mAddressError);
     mCoapServer.AddResource(mAddressQuery);
     mCoapServer.AddResource(mAddressNotification);
-    mCoapMessageId = static_cast<uint8_t>(otPlatRandomGet());
+    mCoapMessageId = static_cast<uint8_t>(Random::GetUint32());
 
     mNetif.GetIp6().mIcmp.RegisterCallbacks(mIcmpHandler);
 }
@@ -74,9 +76,10 @@ AddressResolver::AddressResolver(ThreadNetif &aThreadNetif) :
 void AddressResolver::Clear()
 {
     memset(&mCache, 0, sizeof(mCache));
+    mAgeClock = 0;
 }
 
-ThreadError AddressResolver::GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry) const
+ThreadError AddressResolver::GetEntry(uint16_t aIndex, otEidCacheEntry &aEntry) const
 {
     ThreadError error = kThreadError_None;
 
@@ -100,33 +103,101 @@ void AddressResolver::Remove(uint8_t routerId)
     }
 }
 
-ThreadError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16)
+bool AddressResolver::IsMeshLocalIidKnown(const Cache &aEntry)
 {
-    ThreadError error = kThreadError_None;
-    Cache *entry = NULL;
+    bool rval = false;
+
+    for (size_t i = 0; i < sizeof(aEntry.mMeshLocalIid); i++)
+    {
+        if (aEntry.mMeshLocalIid[i] != 0)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+uint8_t AddressResolver::HashAddress(const Ip6::Address &aAddress)
+{
+    uint8_t hash = 0;
+
+    for (size_t i = 0; i < sizeof(aAddress.mFields.m8); i++)
+    {
+        hash ^= aAddress.mFields.m8[i];
+    }
+
+    return hash;
+}
+
+AddressResolver::Cache *AddressResolver::FindCacheEntry(const Ip6::Address &aEid)
+{
+    Cache *rval = NULL;
+    uint8_t hash = HashAddress(aEid);
 
     for (int i = 0; i < kCacheEntries; i++)
     {
-        if (mCache[i].mState != Cache::kStateInvalid)
+        if (mCache[i].mState != Cache::kStateInvalid &&
+            mCache[i].mHash == hash &&
+            memcmp(&mCache[i].mTarget, &aEid, sizeof(mCache[i].mTarget)) == 0)
         {
-            if (memcmp(&mCache[i].mTarget, &aEid, sizeof(mCache[i].mTarget)) == 0)
-            {
-                entry = &mCache[i];
-                break;
-            }
+            ExitNow(rval = &mCache[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+AddressResolver::Cache *AddressResolver::NewCacheEntry(void)
+{
+    Cache *rval = NULL;
+
+    // prefer an unused entry; otherwise evict the least recently used entry
+    for (int i = 0; i < kCacheEntries; i++)
+    {
+        if (mCache[i].mState == Cache::kStateInvalid)
+        {
+            ExitNow(rval = &mCache[i]);
         }
-        else if (entry == NULL)
+
+        if (rval == NULL || mCache[i].mAge < rval->mAge)
         {
-            entry = &mCache[i];
+            rval = &mCache[i];
         }
     }
 
-    VerifyOrExit(entry != NULL, error = kThreadError_NoBufs);
+exit:
+    return rval;
+}
+
+void AddressResolver::MarkCacheEntryAsUsed(Cache &aEntry)
+{
+    // stamping from a monotonic clock keeps the touch O(1), so the table can be
+    // sized for thousands of proxied hosts on a border router without adding a
+    // per-packet scan; eviction (the rare path) finds the smallest stamp
+    aEntry.mAge = ++mAgeClock;
+}
+
+ThreadError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16)
+{
+    ThreadError error = kThreadError_None;
+    Cache *entry;
+
+    if ((entry = FindCacheEntry(aEid)) == NULL)
+    {
+        VerifyOrExit((entry = NewCacheEntry()) != NULL, error = kThreadError_NoBufs);
+        entry->mState = Cache::kStateInvalid;
+    }
+
+    MarkCacheEntryAsUsed(*entry);
 
     switch (entry->mState)
     {
     case Cache::kStateInvalid:
         entry->mTarget = aEid;
+        entry->mHash = HashAddress(aEid);
         entry->mRloc16 = Mac::kShortAddrInvalid;
         entry->mTimeout = kAddressQueryTimeout;
         entry->mFailures = 0;
@@ -163,6 +234,42 @@ exit:
     return error;
 }
 
+void AddressResolver::UpdateSnoopedCacheEntry(const Ip6::Address &aEid, Mac::ShortAddress aRloc16)
+{
+    Cache *entry;
+    bool wasQuery;
+
+    if ((entry = FindCacheEntry(aEid)) == NULL)
+    {
+        // a freshly snooped entry keeps its age so that passive learning cannot
+        // evict entries that are actively used for resolution
+        VerifyOrExit((entry = NewCacheEntry()) != NULL, ;);
+        entry->mTarget = aEid;
+        entry->mHash = HashAddress(aEid);
+        memset(entry->mMeshLocalIid, 0, sizeof(entry->mMeshLocalIid));
+        entry->mLastTransactionTime = 0;
+        entry->mState = Cache::kStateInvalid;
+    }
+
+    wasQuery = entry->mState == Cache::kStateQuery;
+
+    entry->mRloc16 = aRloc16;
+    entry->mRetryTimeout = 0;
+    entry->mTimeout = 0;
+    entry->mFailures = 0;
+    entry->mState = Cache::kStateCached;
+
+    if (wasQuery)
+    {
+        // the snooped mapping answers an outstanding query
+        MarkCacheEntryAsUsed(*entry);
+        mMeshForwarder.HandleResolved(aEid, kThreadError_None);
+    }
+
+exit:
+    return;
+}
+
 ThreadError AddressResolver::SendAddressQuery(const Ip6::Address &aEid)
 {
     ThreadError error;
@@ -202,6 +309,8 @@ ThreadError AddressResolver::SendAddressQuery(const Ip6::Address &aEid)
 
     SuccessOrExit(error = mSocket.SendTo(*message, messageInfo));
 
+    sPerfCounters.mAddressQueries++;
+
     otLogInfoArp("Sent address query\n");
 
 exit:
@@ -278,15 +387,19 @@ void AddressResolver::HandleAddressNotification(Coap::Header &aHeader, Message &
             break;
 
         case Cache::kStateCached:
-            if (memcmp(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid)) != 0)
+            // a snooped entry does not know the Mesh Local IID and is simply overwritten
+            if (IsMeshLocalIidKnown(mCache[i]))
             {
-                SendAddressError(targetTlv, mlIidTlv, NULL);
-                ExitNow();
-            }
+                if (memcmp(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid)) != 0)
+                {
+                    SendAddressError(targetTlv, mlIidTlv, NULL);
+                    ExitNow();
+                }
 
-            if (lastTransactionTime >= mCache[i].mLastTransactionTime)
-            {
-                ExitNow();
+                if (lastTransactionTime >= mCache[i].mLastTransactionTime)
+                {
+                    ExitNow();
+                }
             }
 
         // fall through
@@ -88,7 +88,7 @@ public:
      * @retval kThreadError_InvalidArgs  @p aIndex was out of bounds or @p aEntry was NULL.
      *
      */
-    ThreadError GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry) const;
+    ThreadError GetEntry(uint16_t aIndex, otEidCacheEntry &aEntry) const;
 
     /**
      * This method removes a Router ID from the EID-to-RLOC cache.
@@ -110,6 +110,15 @@ public:
      */
     ThreadError Resolve(const Ip6::Address &aEid, Mac::ShortAddress &aRloc16);
 
+    /**
+     * This method updates the EID-to-RLOC cache with a mapping snooped from forwarded traffic.
+     *
+     * @param[in]  aEid     A reference to the EID.
+     * @param[in]  aRloc16  The RLOC16 corresponding to @p aEid.
+     *
+     */
+    void UpdateSnoopedCacheEntry(const Ip6::Address &aEid, Mac::ShortAddress aRloc16);
+
 private:
     enum
     {
@@ -137,6 +146,8 @@ private:
         uint16_t          mRetryTimeout;
         uint8_t           mTimeout;
         uint8_t           mFailures;
+        uint8_t           mHash;
+        uint32_t          mAge;
 
         enum State
         {
@@ -147,6 +158,12 @@ private:
         State             mState;
     };
 
+    static uint8_t HashAddress(const Ip6::Address &aAddress);
+    static bool IsMeshLocalIidKnown(const Cache &aEntry);
+    Cache *FindCacheEntry(const Ip6::Address &aEid);
+    Cache *NewCacheEntry(void);
+    void MarkCacheEntryAsUsed(Cache &aEntry);
+
     ThreadError SendAddressQuery(const Ip6::Address &aEid);
     ThreadError SendAddressError(const ThreadTargetTlv &aTarget, const ThreadMeshLocalEidTlv &aEid,
                                  const Ip6::Address *aDestination);
@@ -181,6 +198,7 @@ private:
     Coap::Resource mAddressQuery;
     Coap::Resource mAddressNotification;
     Cache mCache[kCacheEntries];
+    uint32_t mAgeClock;
     uint16_t mCoapMessageId;
     Ip6::IcmpHandler mIcmpHandler;
     Ip6::UdpSocket mSocket;
@@ -35,16 +35,22 @@
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
 #include <common/logging.hpp>
+#include <common/tasklet.hpp>
 #include <thread/meshcop_tlvs.hpp>
 #include <thread/energy_scan_server.hpp>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_uris.hpp>
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
 namespace Thread {
 
 EnergyScanServer::EnergyScanServer(ThreadNetif &aThreadNetif) :
     mActive(false),
+    mHistoryHead(0),
+    mHistoryCount(0),
     mEnergyScan(OPENTHREAD_URI_ENERGY_SCAN, &HandleRequest, this),
+    mEnergyHistory(OPENTHREAD_URI_ENERGY_HISTORY, &HandleHistoryQuery, this),
     mSocket(aThreadNetif.GetIp6().mUdp),
     mTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleTimer, this),
     mCoapServer(aThreadNetif.GetCoapServer()),
@@ -54,6 +60,7 @@ EnergyScanServer::EnergyScanServer(ThreadNetif &aThreadNetif) :
     mNetif.RegisterCallback(mNetifCallback);
 
     mCoapServer.AddResource(mEnergyScan);
+    mCoapServer.AddResource(mEnergyHistory);
     mSocket.Open(HandleUdpReceive, this);
 }
 
@@ -78,6 +85,9 @@ void EnergyScanServer::HandleRequest(Coap::Header &aHeader, Message &aMessage, c
 
     VerifyOrExit(aHeader.GetCode() == Coap::Header::kCodePost, ;);
 
+    // scans are deferred while the CPU governor is shedding load; the requester retries
+    VerifyOrExit(GetGovernorLevel() < kCpuGovernorLevelDeferDiagnostics, ;);
+
     SuccessOrExit(MeshCoP::Tlv::GetTlv(aMessage, MeshCoP::Tlv::kCount, sizeof(count), count));
     VerifyOrExit(count.IsValid(), ;);
 
@@ -228,6 +238,19 @@ ThreadError EnergyScanServer::SendReport(void)
     MeshCoP::EnergyListTlv energyList;
     Ip6::MessageInfo messageInfo;
     Message *message;
+    ScanRecord *record;
+
+    // retain the completed scan for later history queries
+    record = &mScanHistory[mHistoryHead];
+    record->mChannelMask = mChannelMask;
+    record->mLength = mScanResultsLength;
+    memcpy(record->mResults, mScanResults, mScanResultsLength);
+    mHistoryHead = (mHistoryHead + 1) % kScanHistorySize;
+
+    if (mHistoryCount < kScanHistorySize)
+    {
+        mHistoryCount++;
+    }
 
     header.Init();
     header.SetVersion(1);
@@ -273,6 +296,139 @@ exit:
     return error;
 }
 
+void EnergyScanServer::HandleHistoryQuery(void *aContext, Coap::Header &aHeader, Message &aMessage,
+                                          const Ip6::MessageInfo &aMessageInfo)
+{
+    static_cast<EnergyScanServer *>(aContext)->HandleHistoryQuery(aHeader, aMessage, aMessageInfo);
+}
+
+void EnergyScanServer::HandleHistoryQuery(Coap::Header &aHeader, Message &aMessage,
+                                          const Ip6::MessageInfo &aMessageInfo)
+{
+    VerifyOrExit(aHeader.GetCode() == Coap::Header::kCodePost, ;);
+
+    SendHistoryResponse(aHeader, aMessageInfo);
+
+exit:
+    (void)aMessage;
+    return;
+}
+
+ThreadError EnergyScanServer::SendHistoryResponse(const Coap::Header &aRequestHeader,
+                                                  const Ip6::MessageInfo &aRequestInfo)
+{
+    ThreadError error = kThreadError_None;
+    Message *message;
+    Coap::Header responseHeader;
+    Ip6::MessageInfo responseInfo;
+    const ScanRecord *reference = NULL;
+    uint8_t buf[2 * OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS];
+    uint8_t length;
+
+    OT_TOOL_PACKED_BEGIN
+    struct
+    {
+        MeshCoP::ChannelMaskTlv tlv;
+        MeshCoP::ChannelMaskEntry entry;
+        uint32_t mask;
+    } OT_TOOL_PACKED_END channelMask;
+
+    VerifyOrExit(aRequestHeader.GetType() == Coap::Header::kTypeConfirmable, ;);
+
+    VerifyOrExit((message = mCoapServer.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+
+    responseHeader.Init();
+    responseHeader.SetVersion(1);
+    responseHeader.SetType(Coap::Header::kTypeAcknowledgment);
+    responseHeader.SetCode(Coap::Header::kCodeChanged);
+    responseHeader.SetMessageId(aRequestHeader.GetMessageId());
+    responseHeader.SetToken(aRequestHeader.GetToken(), aRequestHeader.GetTokenLength());
+    responseHeader.AppendContentFormatOption(Coap::Header::kApplicationOctetStream);
+    responseHeader.Finalize();
+    SuccessOrExit(error = message->Append(responseHeader.GetBytes(), responseHeader.GetLength()));
+
+    // append the buffered scans oldest first, each delta-encoded against the one before it
+    for (uint8_t i = 0; i < mHistoryCount; i++)
+    {
+        const ScanRecord &record =
+            mScanHistory[(mHistoryHead + kScanHistorySize - mHistoryCount + i) % kScanHistorySize];
+        MeshCoP::CompressedEnergyListTlv compressedList;
+
+        channelMask.tlv.Init();
+        channelMask.tlv.SetLength(sizeof(channelMask) - sizeof(channelMask.tlv));
+        channelMask.entry.SetChannelPage(0);
+        channelMask.entry.SetMaskLength(sizeof(channelMask.mask));
+        channelMask.mask = HostSwap32(record.mChannelMask);
+        SuccessOrExit(error = message->Append(&channelMask, sizeof(channelMask)));
+
+        length = CompressEnergyList(record, reference, buf);
+        compressedList.Init();
+        compressedList.SetLength(length);
+        SuccessOrExit(error = message->Append(&compressedList, sizeof(compressedList)));
+        SuccessOrExit(error = message->Append(buf, length));
+
+        reference = &record;
+    }
+
+    memcpy(&responseInfo, &aRequestInfo, sizeof(responseInfo));
+    memset(&responseInfo.mSockAddr, 0, sizeof(responseInfo.mSockAddr));
+    SuccessOrExit(error = mCoapServer.SendMessage(*message, responseInfo));
+
+    otLogInfoMeshCoP("sent energy scan history\r\n");
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+uint8_t EnergyScanServer::CompressEnergyList(const ScanRecord &aRecord, const ScanRecord *aReference,
+                                             uint8_t *aBuf)
+{
+    uint8_t out = 0;
+    uint8_t i = 0;
+
+    // run-length encode (count, delta) pairs; deltas are relative to the sample at the same
+    // index in @p aReference, or absolute when no reference record is given
+    while (i < aRecord.mLength)
+    {
+        int8_t delta = aRecord.mResults[i];
+        uint8_t run = 1;
+
+        if (aReference != NULL && i < aReference->mLength)
+        {
+            delta -= aReference->mResults[i];
+        }
+
+        while (i + run < aRecord.mLength)
+        {
+            int8_t next = aRecord.mResults[i + run];
+
+            if (aReference != NULL && (i + run) < aReference->mLength)
+            {
+                next -= aReference->mResults[i + run];
+            }
+
+            if (next != delta || run == 255)
+            {
+                break;
+            }
+
+            run++;
+        }
+
+        aBuf[out++] = run;
+        aBuf[out++] = static_cast<uint8_t>(delta);
+        i += run;
+    }
+
+    return out;
+}
+
 void EnergyScanServer::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     (void)aContext;
@@ -299,3 +455,5 @@ void EnergyScanServer::HandleNetifStateChanged(uint32_t aFlags)
 }
 
 }  // namespace Thread
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
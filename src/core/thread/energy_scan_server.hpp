@@ -67,12 +67,28 @@ private:
     {
         kScanDelay   = 1000,  ///< SCAN_DELAY (milliseconds)
         kReportDelay = 500,   ///< Delay before sending a report (milliseconds)
+        kScanHistorySize = 4, ///< Number of completed scans retained for history queries.
+    };
+
+    /**
+     * This structure holds the results of one completed energy scan.
+     *
+     */
+    struct ScanRecord
+    {
+        uint32_t mChannelMask;                                    ///< The scanned channel mask.
+        uint8_t  mLength;                                         ///< The number of valid samples.
+        int8_t   mResults[OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS];  ///< The RSSI samples.
     };
 
     static void HandleRequest(void *aContext, Coap::Header &aHeader, Message &aMessage,
                               const Ip6::MessageInfo &aMessageInfo);
     void HandleRequest(Coap::Header &aHeader, Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
 
+    static void HandleHistoryQuery(void *aContext, Coap::Header &aHeader, Message &aMessage,
+                                   const Ip6::MessageInfo &aMessageInfo);
+    void HandleHistoryQuery(Coap::Header &aHeader, Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+
     static void HandleScanResult(void *aContext, otEnergyScanResult *aResult);
     void HandleScanResult(otEnergyScanResult *aResult);
 
@@ -86,6 +102,8 @@ private:
 
     ThreadError SendReport();
     ThreadError SendResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aRequestMessageInfo);
+    ThreadError SendHistoryResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aRequestMessageInfo);
+    static uint8_t CompressEnergyList(const ScanRecord &aRecord, const ScanRecord *aReference, uint8_t *aBuf);
 
     Ip6::Address mCommissioner;
     uint32_t mChannelMask;
@@ -98,7 +116,12 @@ private:
     int8_t mScanResults[OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS];
     uint8_t mScanResultsLength;
 
+    ScanRecord mScanHistory[kScanHistorySize];
+    uint8_t mHistoryHead;
+    uint8_t mHistoryCount;
+
     Coap::Resource mEnergyScan;
+    Coap::Resource mEnergyHistory;
     Ip6::UdpSocket mSocket;
     Timer mTimer;
 
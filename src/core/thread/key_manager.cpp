@@ -32,6 +32,7 @@
  */
 
 #include <common/code_utils.hpp>
+#include <platform/settings.h>
 #include <crypto/hmac_sha256.hpp>
 #include <thread/key_manager.hpp>
 #include <thread/mle_router.hpp>
@@ -51,6 +52,9 @@ KeyManager::KeyManager(ThreadNetif &aThreadNetif):
     mKeySequence = 0;
     mMacFrameCounter = 0;
     mMleFrameCounter = 0;
+    mStoredMacFrameCounter = 0;
+    mStoredMleFrameCounter = 0;
+    UpdateNextKey();
 }
 
 const uint8_t *KeyManager::GetMasterKey(uint8_t *aKeyLength) const
@@ -66,6 +70,7 @@ const uint8_t *KeyManager::GetMasterKey(uint8_t *aKeyLength) const
 ThreadError KeyManager::SetMasterKey(const void *aKey, uint8_t aKeyLength)
 {
     ThreadError error = kThreadError_None;
+    uint8_t keys[2 * Crypto::HmacSha256::kHashSize];
 
     VerifyOrExit(aKeyLength <= sizeof(mMasterKey), error = kThreadError_InvalidArgs);
     VerifyOrExit((mMasterKeyLength != aKeyLength) || (memcmp(mMasterKey, aKey, aKeyLength) != 0), ;);
@@ -73,7 +78,10 @@ ThreadError KeyManager::SetMasterKey(const void *aKey, uint8_t aKeyLength)
     memcpy(mMasterKey, aKey, aKeyLength);
     mMasterKeyLength = aKeyLength;
     mKeySequence = 0;
-    ComputeKey(mKeySequence, mKey);
+    ComputeKeys(mKeySequence, 2, keys);
+    memcpy(mKey, keys, sizeof(mKey));
+    memcpy(mNextKey, keys + sizeof(mKey), sizeof(mNextKey));
+    mNextKeySequence = mKeySequence + 1;
 
     mNetif.SetStateChangedFlags(OT_NET_KEY_SEQUENCE);
 
@@ -100,6 +108,39 @@ ThreadError KeyManager::ComputeKey(uint32_t aKeySequence, uint8_t *aKey)
     return kThreadError_None;
 }
 
+ThreadError KeyManager::ComputeKeys(uint32_t aFirstKeySequence, uint8_t aCount, uint8_t *aKeys)
+{
+    Crypto::HmacSha256 hmac;
+    uint8_t keySequenceBytes[4];
+    uint32_t keySequence;
+
+    // the HMAC key is the same for every sequence, so key the context once and reuse the
+    // keyed state across the batch
+    hmac.Start(mMasterKey, mMasterKeyLength);
+
+    for (uint8_t i = 0; i < aCount; i++)
+    {
+        keySequence = aFirstKeySequence + i;
+        keySequenceBytes[0] = (keySequence >> 24) & 0xff;
+        keySequenceBytes[1] = (keySequence >> 16) & 0xff;
+        keySequenceBytes[2] = (keySequence >> 8) & 0xff;
+        keySequenceBytes[3] = keySequence & 0xff;
+        hmac.Update(keySequenceBytes, sizeof(keySequenceBytes));
+        hmac.Update(kThreadString, sizeof(kThreadString));
+
+        if ((i + 1) < aCount)
+        {
+            hmac.FinishAndReset(aKeys + i * Crypto::HmacSha256::kHashSize);
+        }
+        else
+        {
+            hmac.Finish(aKeys + i * Crypto::HmacSha256::kHashSize);
+        }
+    }
+
+    return kThreadError_None;
+}
+
 uint32_t KeyManager::GetCurrentKeySequence(void) const
 {
     return mKeySequence;
@@ -110,10 +151,27 @@ void KeyManager::SetCurrentKeySequence(uint32_t aKeySequence)
     if (aKeySequence != mKeySequence)
     {
         mKeySequence = aKeySequence;
-        ComputeKey(mKeySequence, mKey);
+
+        if (mKeySequence == mNextKeySequence)
+        {
+            // the key for this sequence was derived ahead of the switch
+            memcpy(mKey, mNextKey, sizeof(mKey));
+            UpdateNextKey();
+        }
+        else
+        {
+            // derive the current and next keys in one keyed HMAC session
+            uint8_t keys[2 * Crypto::HmacSha256::kHashSize];
+
+            ComputeKeys(mKeySequence, 2, keys);
+            memcpy(mKey, keys, sizeof(mKey));
+            memcpy(mNextKey, keys + sizeof(mKey), sizeof(mNextKey));
+            mNextKeySequence = mKeySequence + 1;
+        }
 
         mMacFrameCounter = 0;
         mMleFrameCounter = 0;
+        StoreFrameCounters();
 
         mNetif.SetStateChangedFlags(OT_NET_KEY_SEQUENCE);
     }
@@ -131,14 +189,44 @@ const uint8_t *KeyManager::GetCurrentMleKey(void) const
 
 const uint8_t *KeyManager::GetTemporaryMacKey(uint32_t aKeySequence)
 {
-    ComputeKey(aKeySequence, mTemporaryKey);
-    return mTemporaryKey + 16;
+    const uint8_t *key;
+
+    if (aKeySequence == mNextKeySequence)
+    {
+        // serve the precomputed next-sequence key without a derivation on the receive path
+        key = mNextKey + 16;
+    }
+    else
+    {
+        ComputeKey(aKeySequence, mTemporaryKey);
+        key = mTemporaryKey + 16;
+    }
+
+    return key;
 }
 
 const uint8_t *KeyManager::GetTemporaryMleKey(uint32_t aKeySequence)
 {
-    ComputeKey(aKeySequence, mTemporaryKey);
-    return mTemporaryKey;
+    const uint8_t *key;
+
+    if (aKeySequence == mNextKeySequence)
+    {
+        // serve the precomputed next-sequence key without a derivation on the receive path
+        key = mNextKey;
+    }
+    else
+    {
+        ComputeKey(aKeySequence, mTemporaryKey);
+        key = mTemporaryKey;
+    }
+
+    return key;
+}
+
+void KeyManager::UpdateNextKey(void)
+{
+    mNextKeySequence = mKeySequence + 1;
+    ComputeKey(mNextKeySequence, mNextKey);
 }
 
 uint32_t KeyManager::GetMacFrameCounter(void) const
@@ -149,6 +237,11 @@ uint32_t KeyManager::GetMacFrameCounter(void) const
 void KeyManager::IncrementMacFrameCounter(void)
 {
     mMacFrameCounter++;
+
+    if (mMacFrameCounter >= mStoredMacFrameCounter)
+    {
+        StoreFrameCounters();
+    }
 }
 
 uint32_t KeyManager::GetMleFrameCounter(void) const
@@ -159,6 +252,44 @@ uint32_t KeyManager::GetMleFrameCounter(void) const
 void KeyManager::IncrementMleFrameCounter(void)
 {
     mMleFrameCounter++;
+
+    if (mMleFrameCounter >= mStoredMleFrameCounter)
+    {
+        StoreFrameCounters();
+    }
+}
+
+ThreadError KeyManager::RestoreFrameCounters(void)
+{
+    ThreadError error = kThreadError_None;
+    uint32_t counters[2];
+    int length = sizeof(counters);
+
+    SuccessOrExit(error = otPlatSettingsGet(kPlatSettingsKeyFrameCounters, 0,
+                                            reinterpret_cast<uint8_t *>(counters), &length));
+    VerifyOrExit(length == sizeof(counters), error = kThreadError_NotFound);
+
+    mMacFrameCounter = counters[0];
+    mMleFrameCounter = counters[1];
+    StoreFrameCounters();
+
+exit:
+    return error;
+}
+
+void KeyManager::StoreFrameCounters(void)
+{
+    uint32_t counters[2];
+
+    // store the counters ahead of their live values so that a value read back after an
+    // unexpected reboot is never behind one that was already used on the air
+    mStoredMacFrameCounter = mMacFrameCounter + kFrameCounterStoreAhead;
+    mStoredMleFrameCounter = mMleFrameCounter + kFrameCounterStoreAhead;
+
+    counters[0] = mStoredMacFrameCounter;
+    counters[1] = mStoredMleFrameCounter;
+    otPlatSettingsSet(kPlatSettingsKeyFrameCounters,
+                      reinterpret_cast<const uint8_t *>(counters), sizeof(counters));
 }
 
 const uint8_t *KeyManager::GetKek(void) const
@@ -165,6 +165,18 @@ public:
      */
     void IncrementMleFrameCounter(void);
 
+    /**
+     * This method restores the MAC and MLE Frame Counter values from persistent storage.
+     *
+     * The restored values are stored ahead of the live counters so that values used before an
+     * unexpected reboot are never reused on the air.
+     *
+     * @retval kThreadError_None      Successfully restored the Frame Counter values.
+     * @retval kThreadError_NotFound  No Frame Counter values were found in persistent storage.
+     *
+     */
+    ThreadError RestoreFrameCounters(void);
+
     /**
      * This method returns the KEK.
      *
@@ -199,9 +211,14 @@ private:
     enum
     {
         kMaxKeyLength = 16,
+        kFrameCounterStoreAhead = 1000,
+        kPlatSettingsKeyFrameCounters = 0x0001,
     };
 
     ThreadError ComputeKey(uint32_t aKeySequence, uint8_t *aKey);
+    ThreadError ComputeKeys(uint32_t aFirstKeySequence, uint8_t aCount, uint8_t *aKeys);
+    void StoreFrameCounters(void);
+    void UpdateNextKey(void);
 
     uint8_t mMasterKey[kMaxKeyLength];
     uint8_t mMasterKeyLength;
@@ -211,8 +228,14 @@ private:
 
     uint8_t mTemporaryKey[Crypto::HmacSha256::kHashSize];
 
+    // key for sequence (mKeySequence + 1), derived ahead of the rotation
+    uint32_t mNextKeySequence;
+    uint8_t mNextKey[Crypto::HmacSha256::kHashSize];
+
     uint32_t mMacFrameCounter;
     uint32_t mMleFrameCounter;
+    uint32_t mStoredMacFrameCounter;
+    uint32_t mStoredMleFrameCounter;
 
     uint8_t mKek[kMaxKeyLength];
     uint32_t mKekFrameCounter;
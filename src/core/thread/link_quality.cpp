@@ -66,12 +66,18 @@ void LinkQualityInfo::Clear(void)
     mRssAverage = 0;
     mCount = 0;
     mLinkQuality = 0;
+    mRssDeviation = 0;
+    mWindowCount = 0;
+    mRssWindowMin = 0;
+    mRssWindowMax = 0;
 }
 
 void LinkQualityInfo::AddRss(LinkQualityInfo &aNoiseFloor, int8_t anRss)
 {
     uint16_t    newValue;
     uint16_t    oldAverage;
+    uint16_t    deviation;
+    uint8_t     rss;
 
     // Restrict/Cap the RSS value to the closed range [0, -128] so the value can fit in 8 bits.
 
@@ -112,9 +118,46 @@ void LinkQualityInfo::AddRss(LinkQualityInfo &aNoiseFloor, int8_t anRss)
         mCount++;
     }
 
+    // Update the windowed min/max values; a new window starts from the current sample.
+
+    rss = static_cast<uint8_t>(newValue >> kRssAveragePrecisionMultipleBitShift);
+
+    if (mWindowCount == 0 || rss > mRssWindowMin)
+    {
+        mRssWindowMin = rss;
+    }
+
+    if (mWindowCount == 0 || rss < mRssWindowMax)
+    {
+        mRssWindowMax = rss;
+    }
+
+    mWindowCount = (mWindowCount + 1) & (kRssWindowSize - 1);
+
+    // Update the deviation estimate: new deviation = old deviation * 3/4 + |new value - average| * 1/4.
+    // Comparing against the updated average keeps the very first sample from registering as deviation.
+
+    deviation = (newValue > mRssAverage) ? (newValue - mRssAverage) : (mRssAverage - newValue);
+    mRssDeviation = static_cast<uint16_t>(((static_cast<uint16_t>(mRssDeviation) << 2) - mRssDeviation + deviation) >> 2);
+
     UpdateLinkQuality(aNoiseFloor);
 }
 
+int8_t LinkQualityInfo::GetMinRss(void) const
+{
+    return (mCount != 0) ? -static_cast<int8_t>(mRssWindowMin) : static_cast<int8_t>(kUnknownRss);
+}
+
+int8_t LinkQualityInfo::GetMaxRss(void) const
+{
+    return (mCount != 0) ? -static_cast<int8_t>(mRssWindowMax) : static_cast<int8_t>(kUnknownRss);
+}
+
+uint8_t LinkQualityInfo::GetRssDeviation(void) const
+{
+    return static_cast<uint8_t>(mRssDeviation >> kRssAveragePrecisionMultipleBitShift);
+}
+
 int8_t LinkQualityInfo::GetAverageRss(void) const
 {
     int8_t average = kUnknownRss;
@@ -179,14 +222,32 @@ uint8_t LinkQualityInfo::GetLinkQuality(LinkQualityInfo &aNoiseFloor)
 
 void LinkQualityInfo::UpdateLinkQuality(LinkQualityInfo &aNoiseFloor)
 {
+    uint8_t linkQuality;
+
     if (mCount != 0)
     {
-        mLinkQuality = CalculateLinkQuality(GetLinkMargin(aNoiseFloor), mLinkQuality);
+        linkQuality = CalculateLinkQuality(GetLinkMargin(aNoiseFloor), mLinkQuality);
+
+        // Fast path: when recent samples deviate strongly from the average, derive the link
+        // quality from the weakest sample in the current window instead of the slow-moving
+        // average, so route costs react within a few frames of interference onset.
+
+        if (mRssDeviation >= kRssDeviationFastPathThreshold)
+        {
+            uint8_t worstQuality = CalculateLinkQuality(ConvertRssToLinkMargin(aNoiseFloor, GetMinRss()), mLinkQuality);
+
+            if (worstQuality < linkQuality)
+            {
+                linkQuality = worstQuality;
+            }
+        }
     }
     else
     {
-        mLinkQuality = CalculateLinkQuality(GetLinkMargin(aNoiseFloor), kNoLastLinkQualityValue);
+        linkQuality = CalculateLinkQuality(GetLinkMargin(aNoiseFloor), kNoLastLinkQualityValue);
     }
+
+    mLinkQuality = linkQuality;
 }
 
 uint8_t LinkQualityInfo::ConvertRssToLinkMargin(LinkQualityInfo &aNoiseFloor, int8_t anRss)
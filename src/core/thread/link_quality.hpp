@@ -50,7 +50,9 @@ namespace Thread {
 /**
  * This class encapsulates/stores all relevant information about quality of a link, including average received signal
  * strength (RSS), link margin and link quality value (value in 0-3). The average is obtained using an adaptive
- * exponential moving average filter.
+ * exponential moving average filter. Alongside the average, compact windowed statistics (min/max over the last few
+ * samples and a fixed-point deviation estimate) are kept so that a sudden degradation lowers the link quality within
+ * a few frames instead of waiting out the averaging tail.
  *
   */
 class LinkQualityInfo
@@ -90,6 +92,30 @@ public:
      */
     int8_t GetAverageRss(void) const;
 
+    /**
+     * This method returns the weakest signal strength value observed in the current sampling window.
+     *
+     * @returns The weakest recent value (in dBm) or @c kUnknownRss if no value is available.
+     *
+     */
+    int8_t GetMinRss(void) const;
+
+    /**
+     * This method returns the strongest signal strength value observed in the current sampling window.
+     *
+     * @returns The strongest recent value (in dBm) or @c kUnknownRss if no value is available.
+     *
+     */
+    int8_t GetMaxRss(void) const;
+
+    /**
+     * This method returns the mean absolute deviation of the signal strength from its average.
+     *
+     * @returns The current deviation estimate (in dB).
+     *
+     */
+    uint8_t GetRssDeviation(void) const;
+
     /**
      * This method returns an encoded version of current average signal strength value. The encoded value is the
      * average multiplied by a precision factor (currently -8).
@@ -195,6 +221,12 @@ private:
         kRssCountForWeightCoefficientOneEighth = 5,    // mCount threshold to use average weight coefficient of 1/8.
         kRssCountForWeightCoefficientOneFourth = 2,    // mCount threshold to use average weight coefficient of 1/4.
         kRssCountForWeightCoefficientOneHalf   = 1,    // mCount threshold to use average weight coefficient of 1/2.
+
+        // Constants related to the windowed min/max/deviation statistics:
+
+        kRssWindowSize                         = 8,    // Number of samples per min/max window (fits mWindowCount).
+        kRssDeviationFastPathThreshold         = (6 << kRssAveragePrecisionMultipleBitShift),
+                                                       // Encoded deviation (6 dB) above which the fast path engages.
     };
 
     /* Private method to update the mLinkQuality value. This is called when a new RSS value is added to average
@@ -211,11 +243,15 @@ private:
 
     static const char kUnknownRssString[];           // Constant string used when RSS average is unknown.
 
-    // All data should fit into a 16-bit (uint16_t) value.
+    // The average/count/quality fields fit into a 16-bit value; the windowed statistics add another 32 bits.
 
-    uint16_t mRssAverage  : 11;  // The encoded average signal strength value (stored as rss times precision multiple).
-    uint8_t  mCount       : 3;   // Number of RSS values added to average so far (limited to kRssCountMax).
-    uint8_t  mLinkQuality : 2;   // Current link quality value (0-3).
+    uint16_t mRssAverage   : 11; // The encoded average signal strength value (stored as rss times precision multiple).
+    uint8_t  mCount        : 3;  // Number of RSS values added to average so far (limited to kRssCountMax).
+    uint8_t  mLinkQuality  : 2;  // Current link quality value (0-3).
+    uint16_t mRssDeviation : 11; // Encoded mean absolute deviation of the RSS from its average.
+    uint8_t  mWindowCount  : 3;  // Samples added since the window min/max were last reset (wraps at kRssWindowSize).
+    uint8_t  mRssWindowMin;      // Weakest RSS in the current window (stored as -rss).
+    uint8_t  mRssWindowMax;      // Strongest RSS in the current window (stored as -rss).
 };
 
 /**
@@ -48,6 +48,65 @@ namespace Lowpan {
 Lowpan::Lowpan(ThreadNetif &aThreadNetif):
     mNetworkData(aThreadNetif.GetNetworkDataLeader())
 {
+    memset(mContextCache, 0, sizeof(mContextCache));
+    mContextCacheVersion = 0;
+    mContextCacheIndex = 0;
+    memset(&mMeshLocalContext, 0, sizeof(mMeshLocalContext));
+    mMeshLocalContextVersion = 0;
+    mMeshLocalContextValid = false;
+}
+
+const Context &Lowpan::GetMeshLocalContext(void)
+{
+    // Context 0 is pinned to the mesh-local prefix for the life of the partition;
+    // rebind it only when the network data version moves so the per-packet cost of
+    // the all-mesh-local case is a version compare and a struct copy
+    if (!mMeshLocalContextValid || mMeshLocalContextVersion != mNetworkData.GetVersion())
+    {
+        mNetworkData.GetContext(0, mMeshLocalContext);
+        mMeshLocalContextVersion = mNetworkData.GetVersion();
+        mMeshLocalContextValid = true;
+    }
+
+    return mMeshLocalContext;
+}
+
+ThreadError Lowpan::LookupContext(const Ip6::Address &aAddress, Context &aContext)
+{
+    ContextCacheEntry *entry;
+
+    // invalidate all cached lookups when the network data changes
+    if (mContextCacheVersion != mNetworkData.GetVersion())
+    {
+        for (int i = 0; i < kContextCacheSize; i++)
+        {
+            mContextCache[i].mValid = false;
+        }
+
+        mContextCacheVersion = mNetworkData.GetVersion();
+    }
+
+    for (int i = 0; i < kContextCacheSize; i++)
+    {
+        entry = &mContextCache[i];
+
+        if (entry->mValid && memcmp(&entry->mAddress, &aAddress, sizeof(aAddress)) == 0)
+        {
+            aContext = entry->mContext;
+            return entry->mError;
+        }
+    }
+
+    entry = &mContextCache[mContextCacheIndex];
+    mContextCacheIndex = (mContextCacheIndex + 1) % kContextCacheSize;
+
+    entry->mAddress = aAddress;
+    entry->mError = mNetworkData.GetContext(aAddress, entry->mContext);
+    entry->mValid = true;
+
+    aContext = entry->mContext;
+
+    return entry->mError;
 }
 
 ThreadError Lowpan::CopyContext(const Context &aContext, Ip6::Address &aAddress)
@@ -103,7 +162,7 @@ int Lowpan::CompressSourceIid(const Mac::Address &aMacAddr, const Ip6::Address &
 
     ComputeIid(aMacAddr, aContext, ipaddr);
 
-    if (memcmp(ipaddr.GetIid(), aIpAddr.GetIid(), Ip6::Address::kInterfaceIdentifierSize) == 0)
+    if (ipaddr.IidMatches(aIpAddr))
     {
         aHcCtl |= kHcSrcAddrMode3;
     }
@@ -113,7 +172,7 @@ int Lowpan::CompressSourceIid(const Mac::Address &aMacAddr, const Ip6::Address &
         tmp.mShortAddress = HostSwap16(aIpAddr.mFields.m16[7]);
         ComputeIid(tmp, aContext, ipaddr);
 
-        if (memcmp(ipaddr.GetIid(), aIpAddr.GetIid(), Ip6::Address::kInterfaceIdentifierSize) == 0)
+        if (ipaddr.IidMatches(aIpAddr))
         {
             aHcCtl |= kHcSrcAddrMode2;
             cur[0] = aIpAddr.mFields.m8[14];
@@ -140,7 +199,7 @@ int Lowpan::CompressDestinationIid(const Mac::Address &aMacAddr, const Ip6::Addr
 
     ComputeIid(aMacAddr, aContext, ipaddr);
 
-    if (memcmp(ipaddr.GetIid(), aIpAddr.GetIid(), Ip6::Address::kInterfaceIdentifierSize) == 0)
+    if (ipaddr.IidMatches(aIpAddr))
     {
         aHcCtl |= kHcDstAddrMode3;
     }
@@ -150,7 +209,7 @@ int Lowpan::CompressDestinationIid(const Mac::Address &aMacAddr, const Ip6::Addr
         tmp.mShortAddress = HostSwap16(aIpAddr.mFields.m16[7]);
         ComputeIid(tmp, aContext, ipaddr);
 
-        if (memcmp(ipaddr.GetIid(), aIpAddr.GetIid(), Ip6::Address::kInterfaceIdentifierSize) == 0)
+        if (ipaddr.IidMatches(aIpAddr))
         {
             aHcCtl |= kHcDstAddrMode2;
             cur[0] = aIpAddr.mFields.m8[14];
@@ -211,7 +270,7 @@ int Lowpan::CompressMulticast(const Ip6::Address &aIpAddr, uint16_t &aHcCtl, uin
     return static_cast<int>(cur - aBuf);
 }
 
-int Lowpan::Compress(Message &aMessage, const Mac::Address &aMacSource, const Mac::Address &aMacDest, uint8_t *aBuf)
+OT_TOOL_HOT_CODE int Lowpan::Compress(Message &aMessage, const Mac::Address &aMacSource, const Mac::Address &aMacDest, uint8_t *aBuf)
 {
     uint8_t *cur = aBuf;
     uint16_t hcCtl = 0;
@@ -223,15 +282,15 @@ int Lowpan::Compress(Message &aMessage, const Mac::Address &aMacSource, const Ma
 
     aMessage.Read(0, sizeof(ip6Header), &ip6Header);
 
-    if (mNetworkData.GetContext(ip6Header.GetSource(), srcContext) != kThreadError_None)
+    if (LookupContext(ip6Header.GetSource(), srcContext) != kThreadError_None)
     {
-        mNetworkData.GetContext(0, srcContext);
+        srcContext = GetMeshLocalContext();
         srcContextValid = false;
     }
 
-    if (mNetworkData.GetContext(ip6Header.GetDestination(), dstContext) != kThreadError_None)
+    if (LookupContext(ip6Header.GetDestination(), dstContext) != kThreadError_None)
     {
-        mNetworkData.GetContext(0, dstContext);
+        dstContext = GetMeshLocalContext();
         dstContextValid = false;
     }
 
@@ -507,7 +566,7 @@ exit:
     return error;
 }
 
-int Lowpan::DecompressBaseHeader(Ip6::Header &ip6Header, const Mac::Address &aMacSource, const Mac::Address &aMacDest,
+OT_TOOL_HOT_CODE int Lowpan::DecompressBaseHeader(Ip6::Header &ip6Header, const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                                  const uint8_t *aBuf)
 {
     ThreadError error = kThreadError_None;
@@ -544,8 +603,8 @@ int Lowpan::DecompressBaseHeader(Ip6::Header &ip6Header, const Mac::Address &aMa
     }
     else
     {
-        mNetworkData.GetContext(0, srcContext);
-        mNetworkData.GetContext(0, dstContext);
+        srcContext = GetMeshLocalContext();
+        dstContext = GetMeshLocalContext();
     }
 
     memset(&ip6Header, 0, sizeof(ip6Header));
@@ -780,11 +839,14 @@ int Lowpan::DecompressExtensionHeader(Message &aMessage, const uint8_t *aBuf, ui
     // length
     hdr[1] = BitVectorBytes(sizeof(hdr) + len) - 1;
 
-    SuccessOrExit(aMessage.Append(hdr, sizeof(hdr)));
+    // the message is pre-sized by the caller, write in place
+    VerifyOrExit(aMessage.GetOffset() + sizeof(hdr) + len <= aMessage.GetLength(), ;);
+
+    aMessage.Write(aMessage.GetOffset(), sizeof(hdr), hdr);
     aMessage.MoveOffset(sizeof(hdr));
 
     // payload
-    SuccessOrExit(aMessage.Append(cur, len));
+    aMessage.Write(aMessage.GetOffset(), len, cur);
     aMessage.MoveOffset(len);
     cur += len;
 
@@ -855,7 +917,10 @@ int Lowpan::DecompressUdpHeader(Message &aMessage, const uint8_t *aBuf, uint16_t
         udpHeader.SetLength(aDatagramLength - aMessage.GetOffset());
     }
 
-    aMessage.Append(&udpHeader, sizeof(udpHeader));
+    // the message is pre-sized by the caller, write in place
+    VerifyOrExit(aMessage.GetOffset() + sizeof(udpHeader) <= aMessage.GetLength(), error = kThreadError_Parse);
+
+    aMessage.Write(aMessage.GetOffset(), sizeof(udpHeader), &udpHeader);
     aMessage.MoveOffset(sizeof(udpHeader));
 
 exit:
@@ -868,7 +933,7 @@ exit:
     return static_cast<int>(cur - aBuf);
 }
 
-int Lowpan::Decompress(Message &aMessage, const Mac::Address &aMacSource, const Mac::Address &aMacDest,
+OT_TOOL_HOT_CODE int Lowpan::Decompress(Message &aMessage, const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                        const uint8_t *aBuf, uint16_t aBufLen, uint16_t aDatagramLength)
 {
     ThreadError error = kThreadError_None;
@@ -883,7 +948,10 @@ int Lowpan::Decompress(Message &aMessage, const Mac::Address &aMacSource, const
     VerifyOrExit((rval = DecompressBaseHeader(ip6Header, aMacSource, aMacDest, aBuf)) >= 0, ;);
     cur += rval;
 
-    SuccessOrExit(error = aMessage.Append(&ip6Header, sizeof(ip6Header)));
+    // the message is pre-sized by the caller, write in place
+    VerifyOrExit(sizeof(ip6Header) <= aMessage.GetLength(), error = kThreadError_Parse);
+
+    aMessage.Write(0, sizeof(ip6Header), &ip6Header);
     SuccessOrExit(error = aMessage.SetOffset(sizeof(ip6Header)));
 
     while (compressed)
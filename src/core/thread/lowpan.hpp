@@ -122,6 +122,9 @@ public:
     /**
      * This method decompresses a LOWPAN_IPHC header.
      *
+     * The decompressed headers are written in place at the front of @p aMessage, which must be
+     * pre-sized by the caller to cover the decompressed headers.
+     *
      * @param[out]  aMessage      A reference where the IPv6 header will be placed.
      * @param[in]   aMacSource    The MAC source address.
      * @param[in]   aMacDest      The MAC destination address.
@@ -198,6 +201,22 @@ private:
         kUdpPortMask        = 3 << 0,
     };
 
+    enum
+    {
+        kContextCacheSize = 4,  ///< Number of cached per-address context lookups.
+    };
+
+    struct ContextCacheEntry
+    {
+        Ip6::Address mAddress;  ///< The looked-up IPv6 address.
+        Context      mContext;  ///< The matching context, valid when mError is kThreadError_None.
+        ThreadError  mError;    ///< The result of the lookup.
+        bool         mValid;    ///< Indicates whether or not this entry is in use.
+    };
+
+    ThreadError LookupContext(const Ip6::Address &aAddress, Context &aContext);
+    const Context &GetMeshLocalContext(void);
+
     int CompressExtensionHeader(Message &message, uint8_t *aBuf, uint8_t &nextHeader);
     int CompressSourceIid(const Mac::Address &macaddr, const Ip6::Address &ipaddr, const Context &aContext,
                           uint16_t &hcCtl, uint8_t *aBuf);
@@ -214,6 +233,14 @@ private:
     static ThreadError ComputeIid(const Mac::Address &aMacAddr, const Context &aContext, Ip6::Address &aIpAddress);
 
     NetworkData::Leader &mNetworkData;
+
+    ContextCacheEntry mContextCache[kContextCacheSize];
+    uint8_t mContextCacheVersion;
+    uint8_t mContextCacheIndex;
+
+    Context mMeshLocalContext;
+    uint8_t mMeshLocalContextVersion;
+    bool mMeshLocalContextValid;
 };
 
 /**
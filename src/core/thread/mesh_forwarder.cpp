@@ -33,15 +33,17 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/flight_recorder.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/perf_counters.hpp>
+#include <common/random.hpp>
 #include <net/ip6.hpp>
 #include <net/ip6_filter.hpp>
 #include <net/udp6.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
-#include <platform/random.h>
 #include <thread/mesh_forwarder.hpp>
 #include <thread/mle_router.hpp>
 #include <thread/thread_netif.hpp>
@@ -56,7 +58,9 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mDiscoverTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleDiscoverTimer, this),
     mPollTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandlePollTimer, this),
     mReassemblyTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleReassemblyTimer, this),
-    mScheduleTransmissionTask(aThreadNetif.GetIp6().mTaskletScheduler, ScheduleTransmissionTask, this),
+    mTxBudgetTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleTxBudgetTimer, this),
+    mScheduleTransmissionTask(aThreadNetif.GetIp6().mTaskletScheduler, ScheduleTransmissionTask, this,
+                              Tasklet::kPriorityHigh),
     mNetif(aThreadNetif),
     mAddressResolver(aThreadNetif.GetAddressResolver()),
     mLowpan(aThreadNetif.GetLowpan()),
@@ -64,11 +68,25 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mMle(aThreadNetif.GetMle()),
     mNetworkData(aThreadNetif.GetNetworkDataLeader())
 {
-    mFragTag = static_cast<uint16_t>(otPlatRandomGet());
+    mFragTag = static_cast<uint16_t>(Random::GetUint32());
     mPollPeriod = 0;
+    mFastPollsRemaining = 0;
     mAssignPollPeriod = 0;
     mSendMessage = NULL;
+    mTxFlowCount = 0;
+    mTxFlowLastServed = Mac::kShortAddrInvalid;
+    mHeaderTemplateMessage = NULL;
+    mHeaderTemplateLength = 0;
+    mHeaderTemplatePsduLength = 0;
+    mHeaderTemplateDstPan = 0;
+    mHcCacheLength = 0;
+    mHcCacheConsumed = 0;
+    mHcCacheValid = false;
+    memset(mFlowTable, 0, sizeof(mFlowTable));
+    mFlowSampleCounter = 0;
+    mFlowSamplingEnabled = false;
     mSendBusy = false;
+    mTxPaused = false;
     mEnabled = false;
 
     mMessageNextOffset = 0;
@@ -97,6 +115,8 @@ ThreadError MeshForwarder::Stop()
 {
     ThreadError error = kThreadError_None;
     Message *message;
+    uint8_t numChildren;
+    Child *children;
 
     VerifyOrExit(mEnabled == true, error = kThreadError_Busy);
 
@@ -122,6 +142,14 @@ ThreadError MeshForwarder::Stop()
         message->Free();
     }
 
+    children = mMle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        children[i].mIndirectMessage = NULL;
+        children[i].mIndirectMessageCount = 0;
+    }
+
     mEnabled = false;
     mMac.SetRxOnWhenIdle(false);
 
@@ -153,11 +181,13 @@ void MeshForwarder::HandleResolved(const Ip6::Address &aEid, ThreadError aError)
             if (aError == kThreadError_None)
             {
                 mSendQueue.Enqueue(*cur);
+                AddIndirectMessage(*cur);
                 enqueuedMessage = true;
             }
             else
             {
                 cur->Free();
+                sPerfCounters.mResolvingQueueDropped++;
             }
         }
     }
@@ -191,14 +221,14 @@ void MeshForwarder::ScheduleTransmissionTask()
             (mSendMessage = GetIndirectTransmission(children[i])) != NULL)
         {
             mSendMessage->SetOffset(children[i].mFragmentOffset);
-            mMac.SendFrameRequest(mMacSender);
+            mMac.SendFrameRequest(mMacSender, mSendMessage->GetPriority() == Message::kPriorityHigh);
             ExitNow();
         }
     }
 
     if ((mSendMessage = GetDirectTransmission()) != NULL)
     {
-        mMac.SendFrameRequest(mMacSender);
+        mMac.SendFrameRequest(mMacSender, mSendMessage->GetPriority() == Message::kPriorityHigh);
         ExitNow();
     }
 
@@ -215,6 +245,18 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
     Child *children;
     Lowpan::MeshHeader meshHeader;
 
+    // at its highest level the CPU governor sheds forwarded normal-priority traffic;
+    // locally originated and control traffic is still queued
+    VerifyOrExit(GetGovernorLevel() < kCpuGovernorLevelDropForwarding ||
+                 aMessage.GetDirection() != Message::kDirectionRx ||
+                 aMessage.GetPriority() == Message::kPriorityHigh,
+                 error = kThreadError_Drop);
+
+    if (mFlowSamplingEnabled)
+    {
+        SampleFlow(aMessage);
+    }
+
     switch (aMessage.GetType())
     {
     case Message::kTypeIp6:
@@ -276,6 +318,15 @@ ThreadError MeshForwarder::SendMessage(Message &aMessage)
 
     aMessage.SetOffset(0);
     SuccessOrExit(error = mSendQueue.Enqueue(aMessage));
+    sPerfCounters.mSendQueueAccepted++;
+
+    if (mSendQueue.GetDepth() == kSendQueueWatermark)
+    {
+        // edge-triggered: one record per excursion above the watermark
+        FlightRecorderRecord(kFlightRecorderEventQueueWatermark, 0, mSendQueue.GetDepth());
+    }
+
+    AddIndirectMessage(aMessage);
     mScheduleTransmissionTask.Post();
 
 exit:
@@ -301,6 +352,7 @@ void MeshForwarder::MoveToResolving(const Ip6::Address &aDestination)
         if (memcmp(&ip6Dst, &aDestination, sizeof(ip6Dst)) == 0)
         {
             mSendQueue.Dequeue(*cur);
+            RemoveIndirectMessage(*cur);
             mResolvingQueue.Enqueue(*cur);
         }
     }
@@ -311,6 +363,13 @@ Message *MeshForwarder::GetDirectTransmission()
     Message *curMessage, *nextMessage;
     ThreadError error = kThreadError_None;
     Ip6::Address ip6Dst;
+    bool budgetExhausted = mMac.IsTxAirtimeBudgetExhausted();
+    bool deferred = false;
+
+    for (uint8_t i = 0; i < mTxFlowCount; i++)
+    {
+        mTxFlows[i].mCandidate = NULL;
+    }
 
     for (curMessage = mSendQueue.GetHead(); curMessage; curMessage = nextMessage)
     {
@@ -321,6 +380,13 @@ Message *MeshForwarder::GetDirectTransmission()
             continue;
         }
 
+        if (mTxPaused && curMessage->GetOffset() == 0 && curMessage->GetType() != Message::kTypeMacDataPoll)
+        {
+            // a channel-switch rehearsal is draining in-flight transfers; hold back
+            // datagrams that have not started transmitting yet
+            continue;
+        }
+
         switch (curMessage->GetType())
         {
         case Message::kTypeIp6:
@@ -332,13 +398,23 @@ Message *MeshForwarder::GetDirectTransmission()
             break;
 
         case Message::kTypeMacDataPoll:
+            // data polls bypass fair queuing
             ExitNow();
         }
 
         switch (error)
         {
         case kThreadError_None:
-            ExitNow();
+            if (budgetExhausted && curMessage->GetPriority() == Message::kPriorityNormal)
+            {
+                // over the transmit airtime budget: leave low-priority traffic
+                // queued and retry once the budget window rolls over
+                deferred = true;
+                continue;
+            }
+
+            AddTxFlowCandidate(*curMessage);
+            continue;
 
         case kThreadError_AddressQuery:
             curMessage->Read(Ip6::Header::GetDestinationOffset(), sizeof(ip6Dst), &ip6Dst);
@@ -348,7 +424,9 @@ Message *MeshForwarder::GetDirectTransmission()
         case kThreadError_Drop:
         case kThreadError_NoBufs:
             mSendQueue.Dequeue(*curMessage);
+            RemoveIndirectMessage(*curMessage);
             curMessage->Free();
+            sPerfCounters.mSendQueueDropped++;
             continue;
 
         default:
@@ -357,25 +435,222 @@ Message *MeshForwarder::GetDirectTransmission()
         }
     }
 
+    curMessage = SelectTxFlowCandidate();
+
+    if (curMessage == NULL && deferred && !mTxBudgetTimer.IsRunning())
+    {
+        mTxBudgetTimer.Start(kTxBudgetRetryDelay);
+    }
+
+    if (curMessage != NULL)
+    {
+        // rerun the route update so the cached MAC addresses match the
+        // selected message rather than the last one examined
+        if (curMessage->GetType() == Message::kTypeIp6)
+        {
+            UpdateIp6Route(*curMessage);
+        }
+        else
+        {
+            UpdateMeshRoute(*curMessage);
+        }
+    }
+
 exit:
     return curMessage;
 }
 
-Message *MeshForwarder::GetIndirectTransmission(const Child &aChild)
+void MeshForwarder::AddTxFlowCandidate(Message &aMessage)
+{
+    uint16_t key = GetTxFlowKey();
+    uint8_t i;
+
+    for (i = 0; i < mTxFlowCount; i++)
+    {
+        if (mTxFlows[i].mNextHop == key)
+        {
+            break;
+        }
+    }
+
+    if (i == mTxFlowCount)
+    {
+        if (mTxFlowCount < kMaxTxFlows)
+        {
+            mTxFlows[i].mNextHop = key;
+            mTxFlows[i].mDeficit = kTxFlowQuantum;
+            mTxFlowCount++;
+        }
+        else
+        {
+            // table full: fold additional destinations into the last flow
+            i = kMaxTxFlows - 1;
+        }
+    }
+
+    // per-flow order is queue order, so only the first message counts
+    if (mTxFlows[i].mCandidate == NULL)
+    {
+        mTxFlows[i].mCandidate = &aMessage;
+    }
+}
+
+Message *MeshForwarder::SelectTxFlowCandidate(void)
 {
     Message *message = NULL;
-    uint8_t childIndex = mMle.GetChildIndex(aChild);
-    Ip6::Header ip6Header;
-    Lowpan::MeshHeader meshHeader;
+    uint8_t start = 0;
 
-    for (message = mSendQueue.GetHead(); message; message = message->GetNext())
+    // retire flows with no traffic this pass so that credit cannot accumulate
+    for (uint8_t i = 0; i < mTxFlowCount;)
     {
-        if (message->GetChildMask(childIndex))
+        if (mTxFlows[i].mCandidate == NULL)
+        {
+            mTxFlows[i] = mTxFlows[mTxFlowCount - 1];
+            mTxFlowCount--;
+        }
+        else
         {
+            i++;
+        }
+    }
+
+    VerifyOrExit(mTxFlowCount > 0, ;);
+
+    for (uint8_t i = 0; i < mTxFlowCount; i++)
+    {
+        if (mTxFlows[i].mNextHop == mTxFlowLastServed)
+        {
+            start = static_cast<uint8_t>((i + 1) % mTxFlowCount);
             break;
         }
     }
 
+    // two rounds always suffice because each skipped flow earns a quantum
+    // per round and 2 * kTxFlowQuantum covers the largest frame
+    for (uint8_t round = 0; round < 2 && message == NULL; round++)
+    {
+        for (uint8_t i = 0; i < mTxFlowCount; i++)
+        {
+            TxFlow &flow = mTxFlows[(start + i) % mTxFlowCount];
+            uint16_t cost = GetTxFlowCost(*flow.mCandidate);
+
+            if (flow.mDeficit < cost)
+            {
+                flow.mDeficit += kTxFlowQuantum;
+            }
+
+            if (flow.mDeficit >= cost)
+            {
+                flow.mDeficit -= cost;
+                mTxFlowLastServed = flow.mNextHop;
+                message = flow.mCandidate;
+                break;
+            }
+        }
+    }
+
+exit:
+    return message;
+}
+
+uint16_t MeshForwarder::GetTxFlowKey(void) const
+{
+    uint16_t key;
+
+    if (mMacDest.mLength == sizeof(Mac::ShortAddress))
+    {
+        key = mMacDest.mShortAddress;
+    }
+    else
+    {
+        // fold an extended address into the 16-bit key space
+        key = 0;
+
+        for (size_t i = 0; i < sizeof(mMacDest.mExtAddress.m8); i += 2)
+        {
+            key ^= static_cast<uint16_t>((mMacDest.mExtAddress.m8[i] << 8) | mMacDest.mExtAddress.m8[i + 1]);
+        }
+    }
+
+    return key;
+}
+
+uint16_t MeshForwarder::GetTxFlowCost(const Message &aMessage)
+{
+    uint16_t cost = aMessage.GetLength() - aMessage.GetOffset();
+
+    if (cost > Mac::Frame::kMTU)
+    {
+        cost = Mac::Frame::kMTU;
+    }
+
+    return cost;
+}
+
+void MeshForwarder::AddIndirectMessage(Message &aMessage)
+{
+    uint8_t numChildren;
+    Child *children = mMle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        if (aMessage.GetChildMask(i))
+        {
+            children[i].mIndirectMessageCount++;
+
+            // messages are enqueued at the tail, so an existing head stays first
+            if (children[i].mIndirectMessage == NULL)
+            {
+                children[i].mIndirectMessage = &aMessage;
+            }
+        }
+    }
+}
+
+void MeshForwarder::RemoveIndirectMessage(Child &aChild, uint8_t aChildIndex, Message &aMessage)
+{
+    if (aChild.mIndirectMessageCount > 0)
+    {
+        aChild.mIndirectMessageCount--;
+    }
+
+    if (aChild.mIndirectMessage == &aMessage)
+    {
+        Message *next;
+
+        for (next = aMessage.GetNext(); next; next = next->GetNext())
+        {
+            if (next->GetChildMask(aChildIndex))
+            {
+                break;
+            }
+        }
+
+        aChild.mIndirectMessage = next;
+    }
+}
+
+void MeshForwarder::RemoveIndirectMessage(Message &aMessage)
+{
+    uint8_t numChildren;
+    Child *children = mMle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        if (aMessage.GetChildMask(i))
+        {
+            RemoveIndirectMessage(children[i], i, aMessage);
+        }
+    }
+}
+
+Message *MeshForwarder::GetIndirectTransmission(const Child &aChild)
+{
+    // the per-child cache tracks the first matching message, avoiding a send queue scan
+    Message *message = aChild.mIndirectMessage;
+    Ip6::Header ip6Header;
+    Lowpan::MeshHeader meshHeader;
+
     VerifyOrExit(message != NULL, ;);
 
     switch (message->GetType())
@@ -428,20 +703,29 @@ ThreadError MeshForwarder::UpdateMeshRoute(Message &aMessage)
 
     aMessage.Read(0, meshHeader.GetHeaderLength(), &meshHeader);
 
-    nextHop = mMle.GetNextHop(meshHeader.GetDestination());
+    // the next hop resolved for the first fragment is cached on the message so the
+    // remaining fragments skip the route and neighbor table lookups
+    neighbor = aMessage.GetNeighbor();
 
-    if (nextHop != Mac::kShortAddrInvalid)
+    if (neighbor == NULL || neighbor->mState != Neighbor::kStateValid)
     {
-        neighbor = mMle.GetNeighbor(nextHop);
-    }
-    else
-    {
-        neighbor = mMle.GetNeighbor(meshHeader.GetDestination());
-    }
+        nextHop = mMle.GetNextHop(meshHeader.GetDestination());
 
-    if (neighbor == NULL)
-    {
-        ExitNow(error = kThreadError_Drop);
+        if (nextHop != Mac::kShortAddrInvalid)
+        {
+            neighbor = mMle.GetNeighbor(nextHop);
+        }
+        else
+        {
+            neighbor = mMle.GetNeighbor(meshHeader.GetDestination());
+        }
+
+        if (neighbor == NULL)
+        {
+            ExitNow(error = kThreadError_Drop);
+        }
+
+        aMessage.SetNeighbor(neighbor);
     }
 
     mMacDest.mLength = sizeof(mMacDest.mShortAddress);
@@ -512,7 +796,12 @@ ThreadError MeshForwarder::UpdateIp6Route(Message &aMessage)
         }
         else
         {
-            if (mMle.IsRoutingLocator(ip6Header.GetDestination()))
+            if ((neighbor = aMessage.GetNeighbor()) != NULL && neighbor->mState == Neighbor::kStateValid)
+            {
+                // a neighbor resolved for an earlier fragment short-circuits the route lookups
+                mMeshDest = neighbor->mValid.mRloc16;
+            }
+            else if (mMle.IsRoutingLocator(ip6Header.GetDestination()))
             {
                 rloc16 = HostSwap16(ip6Header.GetDestination().mFields.m16[7]);
                 VerifyOrExit(mMle.GetRouterId(rloc16) < Mle::kMaxRouterId, error = kThreadError_Drop);
@@ -533,12 +822,13 @@ ThreadError MeshForwarder::UpdateIp6Route(Message &aMessage)
 
             VerifyOrExit(mMeshDest != Mac::kShortAddrInvalid, error = kThreadError_Drop);
 
-            if (mMle.GetNeighbor(mMeshDest) != NULL)
+            if ((neighbor = mMle.GetNeighbor(mMeshDest)) != NULL)
             {
                 // destination is neighbor
                 mMacDest.mLength = sizeof(mMacDest.mShortAddress);
                 mMacDest.mShortAddress = mMeshDest;
                 GetMacSourceAddress(ip6Header.GetSource(), mMacSource);
+                aMessage.SetNeighbor(neighbor);
             }
             else
             {
@@ -581,6 +871,35 @@ void MeshForwarder::SetRxOnWhenIdle(bool aRxOnWhenIdle)
     }
 }
 
+void MeshForwarder::PauseNewTransmissions(void)
+{
+    mTxPaused = true;
+}
+
+void MeshForwarder::ResumeTransmissions(void)
+{
+    mTxPaused = false;
+    mScheduleTransmissionTask.Post();
+}
+
+bool MeshForwarder::IsQuiesced(void) const
+{
+    bool rval = false;
+
+    VerifyOrExit(!mSendBusy, ;);
+    VerifyOrExit(mReassemblyList.GetHead() == NULL, ;);
+
+    for (Message *message = mSendQueue.GetHead(); message; message = message->GetNext())
+    {
+        VerifyOrExit(message->GetOffset() == 0, ;);
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
 void MeshForwarder::SetAssignPollPeriod(uint32_t aPeriod)
 {
     mAssignPollPeriod = aPeriod;
@@ -611,6 +930,17 @@ uint32_t MeshForwarder::GetPollPeriod()
     return mPollPeriod;
 }
 
+void MeshForwarder::HandleTxBudgetTimer(void *aContext)
+{
+    MeshForwarder *obj = reinterpret_cast<MeshForwarder *>(aContext);
+    obj->HandleTxBudgetTimer();
+}
+
+void MeshForwarder::HandleTxBudgetTimer(void)
+{
+    mScheduleTransmissionTask.Post();
+}
+
 void MeshForwarder::HandlePollTimer(void *aContext)
 {
     MeshForwarder *obj = reinterpret_cast<MeshForwarder *>(aContext);
@@ -627,7 +957,28 @@ void MeshForwarder::HandlePollTimer()
         otLogInfoMac("Sent poll\n");
     }
 
-    mPollTimer.Start(mPollPeriod);
+    if (mFastPollsRemaining > 0)
+    {
+        mFastPollsRemaining--;
+        mPollTimer.Start(kFastPollPeriod);
+    }
+    else
+    {
+        mPollTimer.Start(mPollPeriod);
+    }
+}
+
+void MeshForwarder::StartFastPolls(void)
+{
+    // burst fast polls right after transmitting so the likely response is picked up
+    // within a few RTTs instead of waiting out the configured poll period
+    VerifyOrExit(mPollTimer.IsRunning(), ;);
+
+    mFastPollsRemaining = kMaxFastPolls;
+    mPollTimer.Start(kFastPollPeriod);
+
+exit:
+    return;
 }
 
 ThreadError MeshForwarder::GetMacSourceAddress(const Ip6::Address &aIp6Addr, Mac::Address &aMacAddr)
@@ -682,7 +1033,7 @@ ThreadError MeshForwarder::HandleFrameRequest(void *aContext, Mac::Frame &aFrame
     return obj->HandleFrameRequest(aFrame);
 }
 
-ThreadError MeshForwarder::HandleFrameRequest(Mac::Frame &aFrame)
+OT_TOOL_HOT_CODE ThreadError MeshForwarder::HandleFrameRequest(Mac::Frame &aFrame)
 {
     mSendBusy = true;
     assert(mSendMessage != NULL);
@@ -822,6 +1173,7 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
     uint16_t fragmentLength;
     uint16_t dstpan;
     uint8_t secCtl = Mac::Frame::kSecNone;
+    bool fragPredicted = false;
 
     if (mAddMeshHeader)
     {
@@ -836,24 +1188,6 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
         meshSource = mMacSource;
     }
 
-    // initialize MAC header
-    fcf = Mac::Frame::kFcfFrameData | Mac::Frame::kFcfFrameVersion2006;
-    fcf |= (mMacDest.mLength == 2) ? Mac::Frame::kFcfDstAddrShort : Mac::Frame::kFcfDstAddrExt;
-    fcf |= (mMacSource.mLength == 2) ? Mac::Frame::kFcfSrcAddrShort : Mac::Frame::kFcfSrcAddrExt;
-
-    // all unicast frames request ACK
-    if (mMacDest.mLength == 8 || mMacDest.mShortAddress != Mac::kShortAddrBroadcast)
-    {
-        fcf |= Mac::Frame::kFcfAckRequest;
-    }
-
-    if (aMessage.IsLinkSecurityEnabled())
-    {
-        fcf |= Mac::Frame::kFcfSecurityEnabled;
-        secCtl = static_cast<uint8_t>(aMessage.IsJoinerEntrust() ? Mac::Frame::kKeyIdMode0 : Mac::Frame::kKeyIdMode1);
-        secCtl |= Mac::Frame::kSecEncMic32;
-    }
-
     if (aMessage.IsMleDiscoverRequest() || aMessage.IsMleDiscoverResponse())
     {
         dstpan = aMessage.GetPanId();
@@ -863,31 +1197,62 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
         dstpan = mMac.GetPanId();
     }
 
-    if (dstpan == mMac.GetPanId())
+    if (CanReuseHeaderTemplate(aMessage, dstpan))
     {
-        fcf |= Mac::Frame::kFcfPanidCompression;
-    }
-
-    aFrame.InitMacHeader(fcf, secCtl);
-    aFrame.SetDstPanId(dstpan);
-    aFrame.SetSrcPanId(mMac.GetPanId());
-
-    if (mMacDest.mLength == 2)
-    {
-        aFrame.SetDstAddr(mMacDest.mShortAddress);
+        // later fragments of a datagram reuse the MAC header built for the first fragment;
+        // sequence number and security fields are stamped per transmit by the MAC layer
+        memcpy(aFrame.GetPsdu(), mHeaderTemplate, mHeaderTemplateLength);
+        aFrame.SetPsduLength(mHeaderTemplatePsduLength);
     }
     else
     {
-        aFrame.SetDstAddr(mMacDest.mExtAddress);
-    }
+        // initialize MAC header
+        fcf = Mac::Frame::kFcfFrameData | Mac::Frame::kFcfFrameVersion2006;
+        fcf |= (mMacDest.mLength == 2) ? Mac::Frame::kFcfDstAddrShort : Mac::Frame::kFcfDstAddrExt;
+        fcf |= (mMacSource.mLength == 2) ? Mac::Frame::kFcfSrcAddrShort : Mac::Frame::kFcfSrcAddrExt;
 
-    if (mMacSource.mLength == 2)
-    {
-        aFrame.SetSrcAddr(mMacSource.mShortAddress);
-    }
-    else
-    {
-        aFrame.SetSrcAddr(mMacSource.mExtAddress);
+        // all unicast frames request ACK
+        if (mMacDest.mLength == 8 || mMacDest.mShortAddress != Mac::kShortAddrBroadcast)
+        {
+            fcf |= Mac::Frame::kFcfAckRequest;
+        }
+
+        if (aMessage.IsLinkSecurityEnabled())
+        {
+            fcf |= Mac::Frame::kFcfSecurityEnabled;
+            secCtl = static_cast<uint8_t>(aMessage.IsJoinerEntrust() ? Mac::Frame::kKeyIdMode0 :
+                                          Mac::Frame::kKeyIdMode1);
+            secCtl |= Mac::Frame::kSecEncMic32;
+        }
+
+        if (dstpan == mMac.GetPanId())
+        {
+            fcf |= Mac::Frame::kFcfPanidCompression;
+        }
+
+        aFrame.InitMacHeader(fcf, secCtl);
+        aFrame.SetDstPanId(dstpan);
+        aFrame.SetSrcPanId(mMac.GetPanId());
+
+        if (mMacDest.mLength == 2)
+        {
+            aFrame.SetDstAddr(mMacDest.mShortAddress);
+        }
+        else
+        {
+            aFrame.SetDstAddr(mMacDest.mExtAddress);
+        }
+
+        if (mMacSource.mLength == 2)
+        {
+            aFrame.SetSrcAddr(mMacSource.mShortAddress);
+        }
+        else
+        {
+            aFrame.SetSrcAddr(mMacSource.mExtAddress);
+        }
+
+        SaveHeaderTemplate(aMessage, aFrame, dstpan);
     }
 
     payload = aFrame.GetPayload();
@@ -909,10 +1274,25 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
     // copy IPv6 Header
     if (aMessage.GetOffset() == 0)
     {
-        hcLength = mLowpan.Compress(aMessage, meshSource, meshDest, payload);
+        // use the compression result of the last datagram to this destination to predict
+        // whether a fragment header is needed, so the compressed header can be written at
+        // its final position; mispredictions are corrected below
+        if (mHcCacheValid && MacAddressesMatch(mHcCacheDest, meshDest) &&
+            aMessage.GetLength() - mHcCacheConsumed + mHcCacheLength + headerLength > aFrame.GetMaxPayloadLength())
+        {
+            fragPredicted = true;
+        }
+
+        hcLength = mLowpan.Compress(aMessage, meshSource, meshDest,
+                                    fragPredicted ? payload + 4 : payload);
         assert(hcLength > 0);
         headerLength += static_cast<uint8_t>(hcLength);
 
+        mHcCacheDest = meshDest;
+        mHcCacheLength = static_cast<uint8_t>(hcLength);
+        mHcCacheConsumed = aMessage.GetOffset();
+        mHcCacheValid = true;
+
         payloadLength = aMessage.GetLength() - aMessage.GetOffset();
 
         fragmentLength = aFrame.GetMaxPayloadLength() - headerLength;
@@ -921,7 +1301,11 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
         {
             // write Fragment header
             aMessage.SetDatagramTag(mFragTag++);
-            memmove(payload + 4, payload, headerLength);
+
+            if (!fragPredicted)
+            {
+                memmove(payload + 4, payload, headerLength);
+            }
 
             payloadLength = (aFrame.GetMaxPayloadLength() - headerLength - 4) & ~0x7;
 
@@ -934,6 +1318,11 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
             payload += fragmentHeader->GetHeaderLength();
             headerLength += fragmentHeader->GetHeaderLength();
         }
+        else if (fragPredicted)
+        {
+            // predicted a fragment header but the datagram fits in one frame after all
+            memmove(payload, payload + 4, static_cast<uint8_t>(hcLength));
+        }
 
         payload += hcLength;
 
@@ -980,6 +1369,67 @@ ThreadError MeshForwarder::SendFragment(Message &aMessage, Mac::Frame &aFrame)
     return kThreadError_None;
 }
 
+bool MeshForwarder::MacAddressesMatch(const Mac::Address &aFirst, const Mac::Address &aSecond)
+{
+    bool rval = false;
+
+    VerifyOrExit(aFirst.mLength == aSecond.mLength, ;);
+
+    if (aFirst.mLength == 2)
+    {
+        rval = (aFirst.mShortAddress == aSecond.mShortAddress);
+    }
+    else
+    {
+        rval = (memcmp(aFirst.mExtAddress.m8, aSecond.mExtAddress.m8, sizeof(aFirst.mExtAddress.m8)) == 0);
+    }
+
+exit:
+    return rval;
+}
+
+bool MeshForwarder::CanReuseHeaderTemplate(const Message &aMessage, uint16_t aDstPan) const
+{
+    bool rval = false;
+
+    // the template matches only later fragments of the datagram it was built for
+    VerifyOrExit(&aMessage == mHeaderTemplateMessage && aMessage.GetOffset() > 0, ;);
+    VerifyOrExit(aDstPan == mHeaderTemplateDstPan, ;);
+    VerifyOrExit(mMacDest.mLength == mHeaderTemplateDest.mLength, ;);
+
+    if (mMacDest.mLength == 2)
+    {
+        VerifyOrExit(mMacDest.mShortAddress == mHeaderTemplateDest.mShortAddress, ;);
+    }
+    else
+    {
+        VerifyOrExit(memcmp(mMacDest.mExtAddress.m8, mHeaderTemplateDest.mExtAddress.m8,
+                            sizeof(mMacDest.mExtAddress.m8)) == 0, ;);
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
+void MeshForwarder::SaveHeaderTemplate(const Message &aMessage, Mac::Frame &aFrame, uint16_t aDstPan)
+{
+    uint8_t headerLength = aFrame.GetHeaderLength();
+
+    VerifyOrExit(headerLength <= kHeaderTemplateSize, mHeaderTemplateMessage = NULL);
+
+    mHeaderTemplateMessage = &aMessage;
+    mHeaderTemplateDest = mMacDest;
+    mHeaderTemplateDstPan = aDstPan;
+    mHeaderTemplateLength = headerLength;
+    mHeaderTemplatePsduLength = aFrame.GetPsduLength();
+    memcpy(mHeaderTemplate, aFrame.GetPsdu(), headerLength);
+
+exit:
+    {}
+}
+
 void MeshForwarder::HandleSentFrame(void *aContext, Mac::Frame &aFrame)
 {
     MeshForwarder *obj = reinterpret_cast<MeshForwarder *>(aContext);
@@ -1014,6 +1464,7 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame)
         else
         {
             child->mFragmentOffset = 0;
+            RemoveIndirectMessage(*child, mMle.GetChildIndex(*child), *mSendMessage);
             mSendMessage->ClearChildMask(mMle.GetChildIndex(*child));
         }
     }
@@ -1028,6 +1479,18 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame)
         {
             mSendMessage->ClearDirectTransmission();
             mSendMessage->SetOffset(0);
+
+            // receive-to-transmit dwell of a forwarded datagram, measured from the SFD
+            // timestamp of the frame that delivered it to the end of its last fragment
+            if (mFlowSamplingEnabled && mSendMessage->GetRxTimestamp() != 0)
+            {
+                SampleFlowDwell(*mSendMessage);
+            }
+
+            if (mSendMessage->GetType() == Message::kTypeIp6)
+            {
+                StartFastPolls();
+            }
         }
 
         if (mSendMessage->IsMleDiscoverRequest())
@@ -1049,6 +1512,17 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame)
         }
     }
 
+    // pipeline follow-up fragments of the same message: re-request the next frame
+    // right away so the MAC can keep the radio occupied instead of waiting for a
+    // full pass through the transmission tasklet
+    if (mSendMessage->GetDirectTransmission() && mMessageNextOffset < mSendMessage->GetLength() &&
+        !ChildDataRequestPending())
+    {
+        mSendBusy = true;
+        mMac.SendFrameRequest(mMacSender, mSendMessage->GetPriority() == Message::kPriorityHigh);
+        ExitNow();
+    }
+
     if (mSendMessage->GetDirectTransmission() == false && mSendMessage->IsChildPending() == false)
     {
         mSendQueue.Dequeue(*mSendMessage);
@@ -1061,6 +1535,25 @@ exit:
     {}
 }
 
+bool MeshForwarder::ChildDataRequestPending(void) const
+{
+    bool rval = false;
+    uint8_t numChildren;
+    Child *children = mMle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        if (children[i].mState == Child::kStateValid && children[i].mDataRequest &&
+            children[i].mIndirectMessageCount > 0)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+exit:
+    return rval;
+}
+
 void MeshForwarder::SetDiscoverParameters(uint32_t aScanChannels, uint16_t aScanDuration)
 {
     mScanChannels = (aScanChannels == 0) ? static_cast<uint32_t>(Mac::kScanChannelsAll) : aScanChannels;
@@ -1105,7 +1598,7 @@ void MeshForwarder::HandleReceivedFrame(void *aContext, Mac::Frame &aFrame, Thre
     obj->HandleReceivedFrame(aFrame, aError);
 }
 
-void MeshForwarder::HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError)
+OT_TOOL_HOT_CODE void MeshForwarder::HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError)
 {
     ThreadMessageInfo messageInfo;
     Mac::Address macDest;
@@ -1157,6 +1650,7 @@ void MeshForwarder::HandleReceivedFrame(Mac::Frame &aFrame, ThreadError aError)
     messageInfo.mRss = aFrame.GetPower();
     messageInfo.mLqi = aFrame.GetLqi();
     messageInfo.mLinkSecurity = aFrame.GetSecurityEnabled();
+    messageInfo.mTimestamp = aFrame.GetTimestamp();
 
     payload = aFrame.GetPayload();
     payloadLength = aFrame.GetPayloadLength();
@@ -1235,16 +1729,24 @@ void MeshForwarder::HandleMesh(uint8_t *aFrame, uint8_t aFrameLength, const Thre
     }
     else if (meshHeader->GetHopsLeft() > 0)
     {
+        // cut-through forwarding: transit fragments are forwarded individually as they
+        // arrive, without reassembling the datagram on this hop
         SuccessOrExit(error = CheckReachability(aFrame, aFrameLength, meshSource, meshDest));
 
+        UpdateRoutes(aFrame, aFrameLength, meshSource, meshDest);
+
         meshHeader->SetHopsLeft(meshHeader->GetHopsLeft() - 1);
 
-        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kType6lowpan, 0)) != NULL,
+        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kType6lowpan, 0,
+                                                                 Message::kPriorityNormal,
+                                                                 Message::kDirectionRx)) != NULL,
                      error = kThreadError_Drop);
+        message->SetOwner(Message::kOwnerLowpan);
         SuccessOrExit(error = message->SetLength(aFrameLength));
         message->Write(0, aFrameLength, aFrame);
         message->SetLinkSecurityEnabled(aMessageInfo.mLinkSecurity);
         message->SetPanId(aMessageInfo.mPanId);
+        message->SetRxTimestamp(aMessageInfo.mTimestamp);
 
         SendMessage(*message);
     }
@@ -1285,6 +1787,109 @@ exit:
     return error;
 }
 
+void MeshForwarder::UpdateRoutes(uint8_t *aFrame, uint8_t aFrameLength,
+                                 const Mac::Address &aMeshSource, const Mac::Address &aMeshDest)
+{
+    Ip6::Header ip6Header;
+
+    // skip mesh header
+    aFrame += Lowpan::MeshHeader::GetHeaderLength();
+
+    // skip fragment header
+    if (reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->IsFragmentHeader())
+    {
+        VerifyOrExit(reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->GetDatagramOffset() == 0, ;);
+        aFrame += reinterpret_cast<Lowpan::FragmentHeader *>(aFrame)->GetHeaderLength();
+    }
+
+    // only process IPv6 packets
+    VerifyOrExit(Lowpan::Lowpan::IsLowpanHc(aFrame), ;);
+
+    VerifyOrExit(mLowpan.DecompressBaseHeader(ip6Header, aMeshSource, aMeshDest, aFrame) > 0, ;);
+
+    // the mesh source is the originator's RLOC, so its IPv6 source maps to it; RLOC-based
+    // and link-local sources carry no EID information worth caching
+    VerifyOrExit(!ip6Header.GetSource().IsMulticast() &&
+                 !ip6Header.GetSource().IsLinkLocal() &&
+                 !ip6Header.GetSource().IsRoutingLocator(), ;);
+
+    mNetif.GetAddressResolver().UpdateSnoopedCacheEntry(ip6Header.GetSource(), aMeshSource.mShortAddress);
+
+exit:
+    (void)aFrameLength;
+}
+
+uint8_t MeshForwarder::ReassemblyHash(const Mac::Address &aMacSource, uint16_t aDatagramTag)
+{
+    uint8_t hash = static_cast<uint8_t>(aDatagramTag ^ (aDatagramTag >> 8));
+
+    switch (aMacSource.mLength)
+    {
+    case sizeof(Mac::ShortAddress):
+        hash ^= static_cast<uint8_t>(aMacSource.mShortAddress ^ (aMacSource.mShortAddress >> 8));
+        break;
+
+    case sizeof(Mac::ExtAddress):
+        for (size_t i = 0; i < sizeof(aMacSource.mExtAddress); i++)
+        {
+            hash ^= aMacSource.mExtAddress.m8[i];
+        }
+
+        break;
+    }
+
+    return hash;
+}
+
+void MeshForwarder::EvictReassembly(void)
+{
+    Message *evict = NULL;
+    uint8_t numReassemblies = 0;
+
+    for (Message *message = mReassemblyList.GetHead(); message; message = message->GetNext())
+    {
+        numReassemblies++;
+
+        // the message with the least remaining timeout was updated least recently
+        if (evict == NULL || message->GetTimeout() < evict->GetTimeout())
+        {
+            evict = message;
+        }
+    }
+
+    if (numReassemblies >= kMaxReassemblies && evict != NULL)
+    {
+        mReassemblyList.Dequeue(*evict);
+        evict->Free();
+    }
+}
+
+uint8_t MeshForwarder::ReassemblyTimeout(uint8_t aFragmentGap)
+{
+    // extend the deadline in proportion to the slowest gap seen so far, so slow
+    // multi-hop transfers that are still making progress are not evicted mid-datagram
+    uint16_t timeout = kReassemblyTimeout + kReassemblyGapFactor * static_cast<uint16_t>(aFragmentGap);
+
+    if (timeout > kReassemblyTimeoutMax)
+    {
+        timeout = kReassemblyTimeoutMax;
+    }
+
+    return static_cast<uint8_t>(timeout);
+}
+
+uint16_t MeshForwarder::ReassemblyBufferCount(void)
+{
+    uint16_t rval = 0;
+
+    for (Message *message = mReassemblyList.GetHead(); message; message = message->GetNext())
+    {
+        rval += message->GetBufferCount();
+    }
+
+    return rval;
+}
+
 void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
                                    const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                                    const ThreadMessageInfo &aMessageInfo)
@@ -1293,34 +1898,61 @@ void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
     Lowpan::FragmentHeader *fragmentHeader = reinterpret_cast<Lowpan::FragmentHeader *>(aFrame);
     uint16_t datagramLength = fragmentHeader->GetDatagramSize();
     uint16_t datagramTag = fragmentHeader->GetDatagramTag();
+    uint8_t reassemblyHash = ReassemblyHash(aMacSource, datagramTag);
     Message *message = NULL;
     int headerLength;
+    uint16_t offset;
+    uint8_t gap;
 
     if (fragmentHeader->GetDatagramOffset() == 0)
     {
         aFrame += fragmentHeader->GetHeaderLength();
         aFrameLength -= fragmentHeader->GetHeaderLength();
 
-        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+        // make room for the new datagram before allocating its reassembly buffer
+        EvictReassembly();
+
+        // admission control: check the whole datagram's buffer requirement against the
+        // reassembly quota up front, so a doomed datagram is rejected on its first
+        // fragment rather than wasting buffers until a later allocation fails
+        VerifyOrExit(ReassemblyBufferCount() + Message::EstimateBufferCount(datagramLength) <=
+                     kReassemblyBufferQuota, error = kThreadError_NoBufs);
+
+        VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0,
+                                                                 Message::kPriorityNormal,
+                                                                 Message::kDirectionRx)) != NULL,
                      error = kThreadError_NoBufs);
+        message->SetOwner(Message::kOwnerLowpan);
         message->SetLinkSecurityEnabled(aMessageInfo.mLinkSecurity);
         message->SetPanId(aMessageInfo.mPanId);
+        message->SetRxTimestamp(aMessageInfo.mTimestamp);
+
+        // size the message once up front so decompression can write in place
+        VerifyOrExit(message->SetLength(datagramLength) == kThreadError_None, error = kThreadError_NoBufs);
+
         headerLength = mLowpan.Decompress(*message, aMacSource, aMacDest, aFrame, aFrameLength, datagramLength);
-        VerifyOrExit(headerLength > 0, error = kThreadError_NoBufs);
+        VerifyOrExit(headerLength > 0, error = kThreadError_Drop);
 
         aFrame += headerLength;
         aFrameLength -= static_cast<uint8_t>(headerLength);
 
-        VerifyOrExit(message->SetLength(datagramLength) == kThreadError_None, error = kThreadError_NoBufs);
         datagramLength = HostSwap16(datagramLength - sizeof(Ip6::Header));
         message->Write(Ip6::Header::GetPayloadLengthOffset(), sizeof(datagramLength), &datagramLength);
         message->SetDatagramTag(datagramTag);
-        message->SetTimeout(kReassemblyTimeout);
+        message->SetReassemblyHash(reassemblyHash);
+        message->SetFragmentGap(0);
+        message->SetFragmentRun(0, 0);
+        message->SetTimeout(ReassemblyTimeout(0));
 
         // copy Fragment
         message->Write(message->GetOffset(), aFrameLength, aFrame);
         message->MoveOffset(aFrameLength);
 
+#if OPENTHREAD_CONFIG_ENABLE_MPL
+        // drop MPL duplicates before committing a reassembly buffer to the datagram
+        VerifyOrExit(!mNetif.GetIp6().GetMpl().IsDuplicateDatagram(*message), error = kThreadError_Drop);
+#endif  // OPENTHREAD_CONFIG_ENABLE_MPL
+
         // Security Check
         VerifyOrExit(mNetif.GetIp6Filter().Accept(*message), error = kThreadError_Drop);
 
@@ -1339,9 +1971,9 @@ void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
         for (message = mReassemblyList.GetHead(); message; message = message->GetNext())
         {
             // Security Check: only consider reassembly buffers that had the same Security Enabled setting.
-            if (message->GetLength() == datagramLength &&
+            if (message->GetReassemblyHash() == reassemblyHash &&
+                message->GetLength() == datagramLength &&
                 message->GetDatagramTag() == datagramTag &&
-                message->GetOffset() == fragmentHeader->GetDatagramOffset() &&
                 message->IsLinkSecurityEnabled() == aMessageInfo.mLinkSecurity)
             {
                 break;
@@ -1350,9 +1982,64 @@ void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
 
         VerifyOrExit(message != NULL, error = kThreadError_Drop);
 
-        // copy Fragment
-        message->Write(message->GetOffset(), aFrameLength, aFrame);
-        message->MoveOffset(aFrameLength);
+        offset = fragmentHeader->GetDatagramOffset();
+
+        // drop fragments that would overrun the buffer or replay already-reassembled bytes;
+        // NULL out @p message first so the reassembly buffer survives the drop
+        if (static_cast<uint32_t>(offset) + aFrameLength > message->GetLength() ||
+            offset < message->GetOffset())
+        {
+            message = NULL;
+            ExitNow(error = kThreadError_Drop);
+        }
+
+        if (offset == message->GetOffset())
+        {
+            // in-sequence fragment: copy and advance the contiguous edge
+            message->Write(offset, aFrameLength, aFrame);
+            message->MoveOffset(aFrameLength);
+
+            // stitch the buffered run once the contiguous edge reaches it
+            if (message->GetFragmentRunEnd() != 0 && message->GetOffset() == message->GetFragmentRunStart())
+            {
+                message->SetOffset(message->GetFragmentRunEnd());
+                message->SetFragmentRun(0, 0);
+            }
+        }
+        else if (message->GetFragmentRunEnd() == 0)
+        {
+            // link-layer retries reorder fragments under load; the buffer is fully sized
+            // up front, so park the fragment in place and remember the run it starts
+            message->Write(offset, aFrameLength, aFrame);
+            message->SetFragmentRun(offset, offset + aFrameLength);
+        }
+        else if (offset == message->GetFragmentRunEnd())
+        {
+            message->Write(offset, aFrameLength, aFrame);
+            message->SetFragmentRun(message->GetFragmentRunStart(), offset + aFrameLength);
+        }
+        else if (offset + aFrameLength == message->GetFragmentRunStart())
+        {
+            message->Write(offset, aFrameLength, aFrame);
+            message->SetFragmentRun(offset, message->GetFragmentRunEnd());
+        }
+        else
+        {
+            // a second disjoint hole is beyond the buffering window
+            message = NULL;
+            ExitNow(error = kThreadError_Drop);
+        }
+
+        // the elapsed share of the previous deadline is the observed inter-fragment gap;
+        // remember the slowest one and rearm the deadline from it
+        gap = ReassemblyTimeout(message->GetFragmentGap()) - message->GetTimeout();
+
+        if (gap > message->GetFragmentGap())
+        {
+            message->SetFragmentGap(gap);
+        }
+
+        message->SetTimeout(ReassemblyTimeout(message->GetFragmentGap()));
     }
 
 exit:
@@ -1394,7 +2081,9 @@ void MeshForwarder::HandleReassemblyTimer()
         else
         {
             mReassemblyList.Dequeue(*message);
+            FlightRecorderRecord(kFlightRecorderEventReassemblyTimeout, 0, message->GetDatagramTag());
             message->Free();
+            sPerfCounters.mReassemblyTimeouts++;
         }
     }
 
@@ -1413,10 +2102,17 @@ void MeshForwarder::HandleLowpanHC(uint8_t *aFrame, uint8_t aFrameLength,
     int headerLength;
     uint16_t ip6PayloadLength;
 
-    VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+    VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0,
+                                                             Message::kPriorityNormal,
+                                                             Message::kDirectionRx)) != NULL,
                  error = kThreadError_NoBufs);
     message->SetLinkSecurityEnabled(aMessageInfo.mLinkSecurity);
     message->SetPanId(aMessageInfo.mPanId);
+    message->SetRxTimestamp(aMessageInfo.mTimestamp);
+
+    // size the message to the worst-case expansion once up front so decompression can write
+    // in place, then trim to the actual datagram length below
+    SuccessOrExit(error = message->SetLength(sizeof(Ip6::Header) + sizeof(Ip6::UdpHeader) + aFrameLength));
 
     headerLength = mLowpan.Decompress(*message, aMacSource, aMacDest, aFrame, aFrameLength, 0);
     VerifyOrExit(headerLength > 0, error = kThreadError_Drop);
@@ -1424,7 +2120,7 @@ void MeshForwarder::HandleLowpanHC(uint8_t *aFrame, uint8_t aFrameLength,
     aFrame += headerLength;
     aFrameLength -= static_cast<uint8_t>(headerLength);
 
-    SuccessOrExit(error = message->SetLength(message->GetLength() + aFrameLength));
+    SuccessOrExit(error = message->SetLength(message->GetOffset() + aFrameLength));
 
     ip6PayloadLength = HostSwap16(message->GetLength() - sizeof(Ip6::Header));
     message->Write(Ip6::Header::GetPayloadLengthOffset(), sizeof(ip6PayloadLength), &ip6PayloadLength);
@@ -1448,9 +2144,157 @@ exit:
 
 ThreadError MeshForwarder::HandleDatagram(Message &aMessage, const ThreadMessageInfo &aMessageInfo)
 {
+    if (mFlowSamplingEnabled)
+    {
+        SampleFlow(aMessage);
+    }
+
     return mNetif.GetIp6().HandleDatagram(aMessage, &mNetif, mNetif.GetInterfaceId(), &aMessageInfo, false);
 }
 
+void MeshForwarder::SetFlowSamplingEnabled(bool aEnabled)
+{
+    if (aEnabled && !mFlowSamplingEnabled)
+    {
+        memset(mFlowTable, 0, sizeof(mFlowTable));
+        mFlowSampleCounter = 0;
+    }
+
+    mFlowSamplingEnabled = aEnabled;
+}
+
+ThreadError MeshForwarder::GetFlowStats(uint8_t aIndex, otFlowStats &aStats) const
+{
+    ThreadError error = kThreadError_None;
+    const FlowEntry *entry;
+
+    VerifyOrExit(aIndex < kFlowTableSize, error = kThreadError_NotFound);
+
+    entry = &mFlowTable[aIndex];
+    memcpy(&aStats.mSource, &entry->mSource, sizeof(aStats.mSource));
+    memcpy(&aStats.mDestination, &entry->mDestination, sizeof(aStats.mDestination));
+    aStats.mSourcePort = entry->mSourcePort;
+    aStats.mDestinationPort = entry->mDestinationPort;
+    aStats.mProtocol = entry->mProto;
+    aStats.mValid = entry->mValid;
+    aStats.mSampledPackets = entry->mPackets;
+    aStats.mSampledBytes = entry->mBytes;
+    aStats.mAverageDwellTime = entry->mDwellAvg;
+    aStats.mMaxDwellTime = entry->mDwellMax;
+
+exit:
+    return error;
+}
+
+void MeshForwarder::SampleFlow(Message &aMessage)
+{
+    Ip6::Header ip6Header;
+    Ip6::UdpHeader udpHeader;
+    FlowEntry *entry;
+    uint16_t sourcePort = 0;
+    uint16_t destinationPort = 0;
+    uint8_t hash;
+
+    VerifyOrExit(aMessage.GetType() == Message::kTypeIp6, ;);
+
+    // sample one datagram in kFlowSampleInterval to bound the accounting overhead
+    VerifyOrExit(++mFlowSampleCounter >= kFlowSampleInterval, ;);
+    mFlowSampleCounter = 0;
+
+    VerifyOrExit(aMessage.Read(0, sizeof(ip6Header), &ip6Header) == sizeof(ip6Header), ;);
+
+    switch (ip6Header.GetNextHeader())
+    {
+    case Ip6::kProtoUdp:
+    case Ip6::kProtoTcp:
+        // both transport headers start with the source and destination ports
+        VerifyOrExit(aMessage.Read(sizeof(ip6Header), sizeof(udpHeader), &udpHeader) == sizeof(udpHeader), ;);
+        sourcePort = udpHeader.GetSourcePort();
+        destinationPort = udpHeader.GetDestinationPort();
+        break;
+
+    default:
+        break;
+    }
+
+    hash = ip6Header.GetSource().mFields.m8[15] ^ ip6Header.GetDestination().mFields.m8[15] ^
+           static_cast<uint8_t>(sourcePort) ^ static_cast<uint8_t>(destinationPort);
+    entry = &mFlowTable[hash % kFlowTableSize];
+
+    if (!entry->mValid ||
+        entry->mSource != ip6Header.GetSource() || entry->mDestination != ip6Header.GetDestination() ||
+        entry->mSourcePort != sourcePort || entry->mDestinationPort != destinationPort ||
+        entry->mProto != static_cast<uint8_t>(ip6Header.GetNextHeader()))
+    {
+        // claim or evict: the table tracks the most recently sampled flow per slot
+        entry->mSource = ip6Header.GetSource();
+        entry->mDestination = ip6Header.GetDestination();
+        entry->mSourcePort = sourcePort;
+        entry->mDestinationPort = destinationPort;
+        entry->mProto = static_cast<uint8_t>(ip6Header.GetNextHeader());
+        entry->mPackets = 0;
+        entry->mBytes = 0;
+        entry->mDwellAvg = 0;
+        entry->mDwellMax = 0;
+        entry->mValid = true;
+    }
+
+    entry->mPackets++;
+    entry->mBytes += aMessage.GetLength();
+
+exit:
+    return;
+}
+
+void MeshForwarder::SampleFlowDwell(Message &aMessage)
+{
+    Ip6::Header ip6Header;
+    Ip6::UdpHeader udpHeader;
+    FlowEntry *entry;
+    uint32_t dwell;
+    uint16_t sourcePort = 0;
+    uint16_t destinationPort = 0;
+    uint8_t hash;
+
+    VerifyOrExit(aMessage.GetType() == Message::kTypeIp6, ;);
+    VerifyOrExit(aMessage.Read(0, sizeof(ip6Header), &ip6Header) == sizeof(ip6Header), ;);
+
+    switch (ip6Header.GetNextHeader())
+    {
+    case Ip6::kProtoUdp:
+    case Ip6::kProtoTcp:
+        VerifyOrExit(aMessage.Read(sizeof(ip6Header), sizeof(udpHeader), &udpHeader) == sizeof(udpHeader), ;);
+        sourcePort = udpHeader.GetSourcePort();
+        destinationPort = udpHeader.GetDestinationPort();
+        break;
+
+    default:
+        break;
+    }
+
+    hash = ip6Header.GetSource().mFields.m8[15] ^ ip6Header.GetDestination().mFields.m8[15] ^
+           static_cast<uint8_t>(sourcePort) ^ static_cast<uint8_t>(destinationPort);
+    entry = &mFlowTable[hash % kFlowTableSize];
+
+    // dwell is only attributed to the entry already tracking this flow; it never claims a slot
+    VerifyOrExit(entry->mValid &&
+                 !(entry->mSource != ip6Header.GetSource()) && !(entry->mDestination != ip6Header.GetDestination()) &&
+                 entry->mSourcePort == sourcePort && entry->mDestinationPort == destinationPort, ;);
+
+    dwell = Timer::GetNow() - aMessage.GetRxTimestamp();
+
+    // smoothed value plus peak hold
+    entry->mDwellAvg = entry->mDwellAvg - (entry->mDwellAvg >> 3) + (dwell >> 3);
+
+    if (dwell > entry->mDwellMax)
+    {
+        entry->mDwellMax = dwell;
+    }
+
+exit:
+    return;
+}
+
 void MeshForwarder::UpdateFramePending()
 {
 }
@@ -1458,7 +2302,6 @@ void MeshForwarder::UpdateFramePending()
 void MeshForwarder::HandleDataRequest(const Mac::Address &aMacSource, const ThreadMessageInfo &aMessageInfo)
 {
     Neighbor *neighbor;
-    uint8_t childIndex;
 
     // Security Check: only process secure Data Poll frames.
     VerifyOrExit(aMessageInfo.mLinkSecurity, ;);
@@ -1469,17 +2312,12 @@ void MeshForwarder::HandleDataRequest(const Mac::Address &aMacSource, const Thre
     neighbor->mLastHeard = Timer::GetNow();
 
     mMle.HandleMacDataRequest(*reinterpret_cast<Child *>(neighbor));
-    childIndex = mMle.GetChildIndex(*reinterpret_cast<Child *>(neighbor));
 
-    for (Message *message = mSendQueue.GetHead(); message; message = message->GetNext())
-    {
-        if (message->GetDirectTransmission() == false && message->GetChildMask(childIndex))
-        {
-            neighbor->mDataRequest = true;
-            break;
-        }
-    }
+    // the per-child pending count makes the empty poll - the common case - constant time,
+    // and an empty poll leaves nothing for the transmission tasklet to do
+    VerifyOrExit(reinterpret_cast<Child *>(neighbor)->mIndirectMessageCount > 0, ;);
 
+    neighbor->mDataRequest = true;
     mScheduleTransmissionTask.Post();
 
 exit:
@@ -48,7 +48,11 @@ namespace Thread {
 
 enum
 {
-    kReassemblyTimeout = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT,
+    kReassemblyTimeout     = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT,
+    kReassemblyTimeoutMax  = 4 * OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT,
+    kReassemblyGapFactor   = 3,
+    kMaxReassemblies       = OPENTHREAD_CONFIG_6LOWPAN_MAX_REASSEMBLIES,
+    kReassemblyBufferQuota = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_BUFFER_QUOTA,
 };
 
 class MleRouter;
@@ -132,6 +136,39 @@ public:
      */
     void SetRxOnWhenIdle(bool aRxOnWhenIdle);
 
+    /**
+     * This method returns the number of messages currently queued for transmission.
+     *
+     * @returns The send queue depth.
+     *
+     */
+    uint16_t GetSendQueueDepth(void) const { return mSendQueue.GetDepth(); }
+
+    /**
+     * This method pauses the start of new direct transmissions.
+     *
+     * Datagrams that already have fragments in flight continue until complete; messages that
+     * have not started transmitting stay queued until ResumeTransmissions() is called. Data
+     * polls and indirect transmissions to sleepy children are not affected.
+     *
+     */
+    void PauseNewTransmissions(void);
+
+    /**
+     * This method resumes the start of new direct transmissions.
+     *
+     */
+    void ResumeTransmissions(void);
+
+    /**
+     * This method indicates whether or not in-flight fragmented transfers have drained.
+     *
+     * @retval TRUE   No partially transmitted datagram, pending reassembly, or busy frame remains.
+     * @retval FALSE  A fragmented transfer is still in flight.
+     *
+     */
+    bool IsQuiesced(void) const;
+
     /**
      * This method sets customized Data Poll period. Only for certification test
      *
@@ -173,19 +210,64 @@ public:
      */
     void SetDiscoverParameters(uint32_t aScanChannels, uint16_t aScanDuration);
 
+    /**
+     * This method indicates whether or not flow sampling is enabled.
+     *
+     * @retval TRUE   Flow sampling is enabled.
+     * @retval FALSE  Flow sampling is disabled.
+     *
+     */
+    bool IsFlowSamplingEnabled(void) const { return mFlowSamplingEnabled; }
+
+    /**
+     * This method enables or disables flow sampling.
+     *
+     * Enabling flow sampling clears the flow table.
+     *
+     * @param[in]  aEnabled  TRUE to enable flow sampling, FALSE otherwise.
+     *
+     */
+    void SetFlowSamplingEnabled(bool aEnabled);
+
+    /**
+     * This method retrieves one entry of the sampled flow table.
+     *
+     * @param[in]   aIndex  The index into the flow table.
+     * @param[out]  aStats  A reference to where the flow statistics are placed.
+     *
+     * @retval kThreadError_None      Successfully retrieved the flow table entry.
+     * @retval kThreadError_NotFound  @p aIndex is beyond the end of the flow table.
+     *
+     */
+    ThreadError GetFlowStats(uint8_t aIndex, otFlowStats &aStats) const;
+
 private:
     enum
     {
         kStateUpdatePeriod = 1000,  ///< State update period in milliseconds.
+        kFastPollPeriod    = 188,   ///< Fast data poll period in milliseconds.
+        kTxBudgetRetryDelay = 128,  ///< Delay before rechecking an exhausted transmit airtime budget (milliseconds).
+        kMaxFastPolls      = 4,     ///< Number of fast polls after transmitting a message.
+        kSendQueueWatermark = 8,    ///< Send queue depth recorded as a flight recorder crossing event.
     };
 
+    void UpdateRoutes(uint8_t *aFrame, uint8_t aFrameLength,
+                      const Mac::Address &aMeshSource, const Mac::Address &aMeshDest);
     ThreadError CheckReachability(uint8_t *aFrame, uint8_t aFrameLength,
                                   const Mac::Address &aMeshSource, const Mac::Address &aMeshDest);
     ThreadError GetMacDestinationAddress(const Ip6::Address &aIp6Addr, Mac::Address &aMacAddr);
     ThreadError GetMacSourceAddress(const Ip6::Address &aIp6Addr, Mac::Address &aMacAddr);
     Message *GetDirectTransmission(void);
     Message *GetIndirectTransmission(const Child &aChild);
+    bool ChildDataRequestPending(void) const;
+    void AddIndirectMessage(Message &aMessage);
+    void RemoveIndirectMessage(Child &aChild, uint8_t aChildIndex, Message &aMessage);
+    void RemoveIndirectMessage(Message &aMessage);
     void HandleMesh(uint8_t *aFrame, uint8_t aPayloadLength, const ThreadMessageInfo &aMessageInfo);
+    static uint8_t ReassemblyHash(const Mac::Address &aMacSource, uint16_t aDatagramTag);
+    static uint8_t ReassemblyTimeout(uint8_t aFragmentGap);
+    void EvictReassembly(void);
+    uint16_t ReassemblyBufferCount(void);
     void HandleFragment(uint8_t *aFrame, uint8_t aPayloadLength,
                         const Mac::Address &aMacSource, const Mac::Address &aMacDest,
                         const ThreadMessageInfo &aMessageInfo);
@@ -195,8 +277,12 @@ private:
     void HandleDataRequest(const Mac::Address &aMacSource, const ThreadMessageInfo &aMessageInfo);
     void MoveToResolving(const Ip6::Address &aDestination);
     ThreadError SendPoll(Message &aMessage, Mac::Frame &aFrame);
+    void StartFastPolls(void);
     ThreadError SendMesh(Message &aMessage, Mac::Frame &aFrame);
     ThreadError SendFragment(Message &aMessage, Mac::Frame &aFrame);
+    bool CanReuseHeaderTemplate(const Message &aMessage, uint16_t aDstPan) const;
+    void SaveHeaderTemplate(const Message &aMessage, Mac::Frame &aFrame, uint16_t aDstPan);
+    static bool MacAddressesMatch(const Mac::Address &aFirst, const Mac::Address &aSecond);
     void UpdateFramePending(void);
     ThreadError UpdateIp6Route(Message &aMessage);
     ThreadError UpdateMeshRoute(Message &aMessage);
@@ -217,15 +303,45 @@ private:
     void HandleReassemblyTimer(void);
     static void HandlePollTimer(void *aContext);
     void HandlePollTimer(void);
+    static void HandleTxBudgetTimer(void *aContext);
+    void HandleTxBudgetTimer(void);
 
     static void ScheduleTransmissionTask(void *aContext);
     void ScheduleTransmissionTask(void);
 
+    void AddTxFlowCandidate(Message &aMessage);
+    Message *SelectTxFlowCandidate(void);
+    uint16_t GetTxFlowKey(void) const;
+    static uint16_t GetTxFlowCost(const Message &aMessage);
+
     Mac::Receiver mMacReceiver;
     Mac::Sender mMacSender;
     Timer mDiscoverTimer;
     Timer mPollTimer;
     Timer mReassemblyTimer;
+    Timer mTxBudgetTimer;
+
+    enum
+    {
+        kMaxTxFlows    = 8,   ///< Maximum number of next-hop flows tracked for fair queuing.
+        kTxFlowQuantum = 64,  ///< Deficit-round-robin credit in bytes added per scheduling turn.
+    };
+
+    /**
+     * A per-next-hop virtual transmit queue used for deficit-round-robin
+     * scheduling of the direct transmission queue.
+     *
+     */
+    struct TxFlow
+    {
+        uint16_t mNextHop;    ///< The MAC destination key identifying the flow.
+        uint16_t mDeficit;    ///< The accumulated transmit credit in bytes.
+        Message *mCandidate;  ///< The first eligible message this pass, or NULL.
+    };
+
+    TxFlow mTxFlows[kMaxTxFlows];
+    uint8_t mTxFlowCount;
+    uint16_t mTxFlowLastServed;
 
     MessageQueue mSendQueue;
     MessageQueue mReassemblyList;
@@ -233,9 +349,60 @@ private:
     uint16_t mFragTag;
     uint16_t mMessageNextOffset;
     uint32_t mPollPeriod;
+    uint8_t mFastPollsRemaining;
     uint32_t mAssignPollPeriod;  ///< only for certification test
     Message *mSendMessage;
 
+    enum
+    {
+        kHeaderTemplateSize = 32,  ///< Maximum length of the cached IEEE 802.15.4 MAC header.
+    };
+
+    const Message *mHeaderTemplateMessage;
+    Mac::Address mHeaderTemplateDest;
+    uint16_t mHeaderTemplateDstPan;
+    uint8_t mHeaderTemplate[kHeaderTemplateSize];
+    uint8_t mHeaderTemplateLength;
+    uint8_t mHeaderTemplatePsduLength;
+
+    // compression result of the last datagram to each destination, used to predict whether
+    // the next datagram fragments so the compressed header lands at its final position
+    Mac::Address mHcCacheDest;
+    uint8_t mHcCacheLength;
+    uint16_t mHcCacheConsumed;
+    bool mHcCacheValid;
+
+    enum
+    {
+        kFlowTableSize      = 8,   ///< Number of flows tracked by the sampler.
+        kFlowSampleInterval = 16,  ///< One datagram in this many is sampled.
+    };
+
+    /**
+     * This structure tracks sampled packet and byte counts for one flow.
+     *
+     */
+    struct FlowEntry
+    {
+        Ip6::Address mSource;       ///< The flow source address.
+        Ip6::Address mDestination;  ///< The flow destination address.
+        uint16_t mSourcePort;       ///< The flow source port, or 0 if not UDP or TCP.
+        uint16_t mDestinationPort;  ///< The flow destination port, or 0 if not UDP or TCP.
+        uint8_t mProto;             ///< The IPv6 Next Header value of the flow.
+        bool mValid;                ///< TRUE if this entry tracks a flow.
+        uint32_t mPackets;          ///< The number of sampled datagrams.
+        uint32_t mBytes;            ///< The total length of sampled datagrams.
+        uint32_t mDwellAvg;         ///< Smoothed receive-to-transmit dwell time in milliseconds.
+        uint32_t mDwellMax;         ///< Largest observed receive-to-transmit dwell time in milliseconds.
+    };
+
+    void SampleFlow(Message &aMessage);
+    void SampleFlowDwell(Message &aMessage);
+
+    FlowEntry mFlowTable[kFlowTableSize];
+    uint16_t mFlowSampleCounter;
+    bool mFlowSamplingEnabled;
+
     Mac::Address mMacSource;
     Mac::Address mMacDest;
     uint16_t mMeshSource;
@@ -243,6 +410,7 @@ private:
     bool mAddMeshHeader;
 
     bool mSendBusy;
+    bool mTxPaused;
 
     Tasklet mScheduleTransmissionTask;
     bool mEnabled;
@@ -426,6 +426,55 @@ ThreadError Dataset::Set(const Message &aMessage, uint16_t aOffset, uint8_t aLen
     return kThreadError_None;
 }
 
+ThreadError Dataset::Merge(const Message &aMessage, uint16_t aOffset, uint8_t aLength)
+{
+    ThreadError error = kThreadError_None;
+    Tlv tlv;
+    Tlv *old;
+    uint16_t offset = aOffset;
+    uint16_t end = aOffset + aLength;
+    uint16_t length = mLength;
+
+    // validation pass: walk the TLVs in place and size the merged result, so a rejected
+    // request costs only header reads and nothing is copied or modified
+    while (offset + sizeof(tlv) <= end)
+    {
+        aMessage.Read(offset, sizeof(tlv), &tlv);
+        VerifyOrExit(offset + sizeof(tlv) + tlv.GetLength() <= end, error = kThreadError_Parse);
+
+        if ((old = Get(tlv.GetType())) != NULL)
+        {
+            length -= sizeof(Tlv) + old->GetLength();
+        }
+
+        length += sizeof(Tlv) + tlv.GetLength();
+        offset += sizeof(tlv) + tlv.GetLength();
+    }
+
+    VerifyOrExit(offset == end, error = kThreadError_Parse);
+    VerifyOrExit(length <= sizeof(mTlvs), error = kThreadError_NoBufs);
+
+    // apply pass: copy each TLV straight from the message into the Dataset
+    offset = aOffset;
+
+    while (offset < end)
+    {
+        aMessage.Read(offset, sizeof(tlv), &tlv);
+
+        if ((old = Get(tlv.GetType())) != NULL)
+        {
+            Remove(reinterpret_cast<uint8_t *>(old), sizeof(Tlv) + old->GetLength());
+        }
+
+        aMessage.Read(offset, sizeof(Tlv) + tlv.GetLength(), mTlvs + mLength);
+        mLength += sizeof(Tlv) + tlv.GetLength();
+        offset += sizeof(tlv) + tlv.GetLength();
+    }
+
+exit:
+    return error;
+}
+
 void Dataset::Remove(Tlv::Type aType)
 {
     Tlv *tlv;
@@ -130,6 +130,24 @@ public:
 
     ThreadError Set(const otOperationalDataset &aDataset);
 
+    /**
+     * This method merges TLVs from a message into the Dataset, leaving TLVs not present in the
+     * message unchanged.
+     *
+     * The TLVs are validated and the merged result is sized by streaming over the message in
+     * place; the Dataset is only written to after the whole request is accepted.
+     *
+     * @param[in]  aMessage  The message to read the TLVs from.
+     * @param[in]  aOffset   The offset within @p aMessage where the TLVs start.
+     * @param[in]  aLength   The number of TLV bytes.
+     *
+     * @retval kThreadError_None    Successfully merged the TLVs.
+     * @retval kThreadError_Parse   The TLVs were not well formed; the Dataset is unchanged.
+     * @retval kThreadError_NoBufs  The merged result would not fit; the Dataset is unchanged.
+     *
+     */
+    ThreadError Merge(const Message &aMessage, uint16_t aOffset, uint8_t aLength);
+
     void Remove(Tlv::Type aType);
 
 private:
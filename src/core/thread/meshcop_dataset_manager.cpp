@@ -38,8 +38,8 @@
 #include <coap/coap_header.hpp>
 #include <common/code_utils.hpp>
 #include <common/logging.hpp>
+#include <common/random.hpp>
 #include <common/timer.hpp>
-#include <platform/random.h>
 #include <thread/meshcop_dataset.hpp>
 #include <thread/meshcop_dataset_manager.hpp>
 #include <thread/thread_netif.hpp>
@@ -173,10 +173,7 @@ ThreadError DatasetManager::Register(void)
 
     mSocket.Open(&HandleUdpReceive, this);
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -190,7 +187,7 @@ ThreadError DatasetManager::Register(void)
 
     VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
     SuccessOrExit(error = message->Append(header.GetBytes(), header.GetLength()));
-    SuccessOrExit(error = message->Append(mLocal.GetBytes(), mLocal.GetSize()));
+    SuccessOrExit(error = AppendDelta(*message));
 
     mMle.GetLeaderAddress(leader);
 
@@ -211,6 +208,61 @@ exit:
     return error;
 }
 
+ThreadError DatasetManager::AppendDelta(Message &aMessage)
+{
+    ThreadError error = kThreadError_None;
+    const Tlv *cur = reinterpret_cast<const Tlv *>(mNetwork.GetBytes());
+    const Tlv *end = reinterpret_cast<const Tlv *>(mNetwork.GetBytes() + mNetwork.GetSize());
+    bool delta = true;
+
+    // a delta cannot express removal, fall back to the full dataset when TLVs were removed
+    while (cur < end)
+    {
+        if (mLocal.Get(cur->GetType()) == NULL)
+        {
+            delta = false;
+            break;
+        }
+
+        cur = cur->GetNext();
+    }
+
+    cur = reinterpret_cast<const Tlv *>(mLocal.GetBytes());
+    end = reinterpret_cast<const Tlv *>(mLocal.GetBytes() + mLocal.GetSize());
+
+    while (cur < end)
+    {
+        if (delta)
+        {
+            SuccessOrExit(error = AppendTlv(aMessage, *cur));
+        }
+        else
+        {
+            SuccessOrExit(error = aMessage.Append(cur, sizeof(Tlv) + cur->GetLength()));
+        }
+
+        cur = cur->GetNext();
+    }
+
+exit:
+    return error;
+}
+
+ThreadError DatasetManager::AppendTlv(Message &aMessage, const Tlv &aTlv)
+{
+    ThreadError error = kThreadError_None;
+    const Tlv *network = mNetwork.Get(aTlv.GetType());
+
+    // skip TLVs the partition already has, the leader merges the delta into its dataset
+    VerifyOrExit(network == NULL || network->GetLength() != aTlv.GetLength() ||
+                 memcmp(network, &aTlv, sizeof(Tlv) + aTlv.GetLength()) != 0, ;);
+
+    error = aMessage.Append(&aTlv, sizeof(Tlv) + aTlv.GetLength());
+
+exit:
+    return error;
+}
+
 void DatasetManager::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
 {
     DatasetManager *obj = static_cast<DatasetManager *>(aContext);
@@ -272,7 +324,10 @@ void DatasetManager::HandleSet(Coap::Header &aHeader, Message &aMessage, const I
     VerifyOrExit(offset < aMessage.GetLength() && (mLocal.GetTimestamp() == NULL ||
                                                    mLocal.GetTimestamp()->Compare(timestamp) > 0), state = StateTlv::kReject);
 
-    mLocal.Set(aMessage, aMessage.GetOffset(), static_cast<uint8_t>(aMessage.GetLength() - aMessage.GetOffset()));
+    // merge the delta so a request carrying only the changed TLVs leaves the rest intact
+    VerifyOrExit(mLocal.Merge(aMessage, aMessage.GetOffset(),
+                              static_cast<uint8_t>(aMessage.GetLength() - aMessage.GetOffset())) == kThreadError_None,
+                 state = StateTlv::kReject);
     mNetwork = mLocal;
     mNetworkDataLeader.IncrementVersion();
     mNetworkDataLeader.IncrementStableVersion();
@@ -327,10 +382,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
 
     mSocket.Open(&HandleUdpReceive, this);
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -351,7 +403,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         timestamp.Init();
         static_cast<Timestamp *>(&timestamp)->SetSeconds((aDataset.mActiveTimestamp) >> 16);
         static_cast<Timestamp *>(&timestamp)->SetTicks((aDataset.mActiveTimestamp) & 0xffff);
-        SuccessOrExit(error = message->Append(&timestamp, sizeof(timestamp)));
+        SuccessOrExit(error = AppendTlv(*message, timestamp));
     }
 
     if (aDataset.mIsPendingTimestampSet)
@@ -360,7 +412,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         timestamp.Init();
         static_cast<Timestamp *>(&timestamp)->SetSeconds((aDataset.mPendingTimestamp) >> 16);
         static_cast<Timestamp *>(&timestamp)->SetTicks((aDataset.mPendingTimestamp) & 0xffff);
-        SuccessOrExit(error = message->Append(&timestamp, sizeof(timestamp)));
+        SuccessOrExit(error = AppendTlv(*message, timestamp));
     }
 
     if (aDataset.mIsMasterKeySet)
@@ -368,7 +420,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         NetworkMasterKeyTlv masterkey;
         masterkey.Init();
         masterkey.SetNetworkMasterKey(aDataset.mMasterKey.m8);
-        SuccessOrExit(error = message->Append(&masterkey, sizeof(masterkey)));
+        SuccessOrExit(error = AppendTlv(*message, masterkey));
     }
 
     if (aDataset.mIsNetworkNameSet)
@@ -376,7 +428,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         NetworkNameTlv networkname;
         networkname.Init();
         networkname.SetNetworkName(aDataset.mNetworkName.m8);
-        SuccessOrExit(error = message->Append(&networkname, sizeof(Tlv) + networkname.GetLength()));
+        SuccessOrExit(error = AppendTlv(*message, networkname));
     }
 
     if (aDataset.mIsExtendedPanIdSet)
@@ -384,7 +436,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         ExtendedPanIdTlv extpanid;
         extpanid.Init();
         extpanid.SetExtendedPanId(aDataset.mExtendedPanId.m8);
-        SuccessOrExit(error = message->Append(&extpanid, sizeof(extpanid)));
+        SuccessOrExit(error = AppendTlv(*message, extpanid));
     }
 
     if (aDataset.mIsMeshLocalPrefixSet)
@@ -392,7 +444,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         MeshLocalPrefixTlv localprefix;
         localprefix.Init();
         localprefix.SetMeshLocalPrefix(aDataset.mMeshLocalPrefix.m8);
-        SuccessOrExit(error = message->Append(&localprefix, sizeof(localprefix)));
+        SuccessOrExit(error = AppendTlv(*message, localprefix));
     }
 
     if (aDataset.mIsDelaySet)
@@ -400,7 +452,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         DelayTimerTlv delaytimer;
         delaytimer.Init();
         delaytimer.SetDelayTimer(aDataset.mDelay);
-        SuccessOrExit(error = message->Append(&delaytimer, sizeof(delaytimer)));
+        SuccessOrExit(error = AppendTlv(*message, delaytimer));
     }
 
     if (aDataset.mIsPanIdSet)
@@ -408,7 +460,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         PanIdTlv panid;
         panid.Init();
         panid.SetPanId(aDataset.mPanId);
-        SuccessOrExit(error = message->Append(&panid, sizeof(panid)));
+        SuccessOrExit(error = AppendTlv(*message, panid));
     }
 
     if (aDataset.mIsChannelSet)
@@ -416,7 +468,7 @@ ThreadError DatasetManager::SendSetRequest(const otOperationalDataset &aDataset,
         ChannelTlv channel;
         channel.Init();
         channel.SetChannel(aDataset.mChannel);
-        SuccessOrExit(error = message->Append(&channel, sizeof(channel)));
+        SuccessOrExit(error = AppendTlv(*message, channel));
     }
 
     if (aLength > 0)
@@ -451,10 +503,7 @@ ThreadError DatasetManager::SendGetRequest(const uint8_t *aTlvTypes, const uint8
 
     mSocket.Open(&HandleUdpReceive, this);
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -695,7 +744,8 @@ ThreadError ActiveDataset::ApplyConfiguration(void)
 
 PendingDataset::PendingDataset(ThreadNetif &aThreadNetif):
     DatasetManager(aThreadNetif, Tlv::kPendingTimestamp, OPENTHREAD_URI_PENDING_SET, OPENTHREAD_URI_PENDING_GET),
-    mTimer(aThreadNetif.GetIp6().mTimerScheduler, HandleTimer, this)
+    mTimer(aThreadNetif.GetIp6().mTimerScheduler, HandleTimer, this),
+    mQuiescing(false)
 {
 }
 
@@ -758,6 +808,10 @@ void PendingDataset::ResetDelayTimer(uint8_t aFlags)
 
         mTimer.Stop();
 
+        // the pending dataset changed under a running rehearsal; let traffic
+        // flow again until the new delay expires
+        CancelQuiesce();
+
         if ((delayTimer = static_cast<DelayTimerTlv *>(mLocal.Get(Tlv::kDelayTimer))) != NULL)
         {
             mTimer.Start(delayTimer->GetDelayTimer());
@@ -816,6 +870,22 @@ exit:
     return;
 }
 
+bool PendingDataset::ChannelChangePending(void)
+{
+    ChannelTlv *channel = static_cast<ChannelTlv *>(mLocal.Get(Tlv::kChannel));
+
+    return channel != NULL && static_cast<uint8_t>(channel->GetChannel()) != mNetif.GetMac().GetChannel();
+}
+
+void PendingDataset::CancelQuiesce(void)
+{
+    if (mQuiescing)
+    {
+        mQuiescing = false;
+        mNetif.GetMeshForwarder().ResumeTransmissions();
+    }
+}
+
 void PendingDataset::HandleTimer(void *aContext)
 {
     PendingDataset *obj = static_cast<PendingDataset *>(aContext);
@@ -836,6 +906,28 @@ void PendingDataset::HandleTimer(void)
     VerifyOrExit((!mMle.IsAttached() || (mNetwork.GetTimestamp() &&
                                          (mNetwork.GetTimestamp()->Compare(*mLocal.GetTimestamp()))) == 0), ;);
 
+    // rehearse channel switches: pause new transmissions and give in-flight
+    // fragmented transfers a bounded window to drain before switching
+    if (ChannelChangePending())
+    {
+        if (!mQuiescing)
+        {
+            mQuiescing = true;
+            mQuiesceStart = Timer::GetNow();
+            mNetif.GetMeshForwarder().PauseNewTransmissions();
+            otLogInfoMeshCoP("channel switch quiesce started\n");
+        }
+
+        if (!mNetif.GetMeshForwarder().IsQuiesced() &&
+            (Timer::GetNow() - mQuiesceStart) < kMaxQuiesceDelay)
+        {
+            mTimer.Start(kQuiesceCheckInterval);
+            ExitNow();
+        }
+    }
+
+    CancelQuiesce();
+
     mLocal.Remove(Tlv::kDelayTimer);
 
     VerifyOrExit((activeTimestamp = static_cast<ActiveTimestampTlv *>(mLocal.Get(Tlv::kActiveTimestamp))) != NULL,
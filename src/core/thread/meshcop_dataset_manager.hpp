@@ -100,6 +100,8 @@ private:
     void HandleTimer(void);
 
     ThreadError Register(void);
+    ThreadError AppendDelta(Message &aMessage);
+    ThreadError AppendTlv(Message &aMessage, const Tlv &aTlv);
     void SendSetResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo, StateTlv::State aState);
     void SendGetResponse(const Coap::Header &aRequestHeader, const Ip6::MessageInfo &aMessageInfo,
                          uint8_t *aTlvs, uint8_t aLength);
@@ -152,15 +154,26 @@ public:
     void UpdateDelayTimer(void);
 
 private:
+    enum
+    {
+        kQuiesceCheckInterval = 250,   ///< Interval between quiesce re-checks in milliseconds.
+        kMaxQuiesceDelay      = 5000,  ///< Maximum time a channel switch is held for draining in milliseconds.
+    };
+
     static void HandleTimer(void *aContext);
     void HandleTimer(void);
 
     void ResetDelayTimer(uint8_t aFlags);
     void UpdateDelayTimer(Dataset &aDataset, uint32_t &aStartTime);
 
+    bool ChannelChangePending(void);
+    void CancelQuiesce(void);
+
     Timer mTimer;
     uint32_t mLocalTime;
     uint32_t mNetworkTime;
+    bool mQuiescing;
+    uint32_t mQuiesceStart;
 };
 
 }  // namespace MeshCoP
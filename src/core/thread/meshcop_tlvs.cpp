@@ -32,6 +32,7 @@
  */
 
 #include <common/code_utils.hpp>
+#include <common/tlv_iterator.hpp>
 #include <thread/meshcop_tlvs.hpp>
 
 namespace Thread {
@@ -69,30 +70,13 @@ int Timestamp::Compare(const Timestamp &aCompare) const
     return rval;
 }
 
-ThreadError Tlv::GetTlv(const Message &message, Type type, uint16_t maxLength, Tlv &tlv)
+ThreadError Tlv::GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, Tlv &aTlv)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = message.GetOffset();
-    uint16_t end = message.GetLength();
+    ThreadError error;
+    TlvIterator iterator(aMessage, true);
 
-    while (offset < end)
-    {
-        message.Read(offset, sizeof(Tlv), &tlv);
-
-        if (tlv.GetType() == type && (offset + sizeof(tlv) + tlv.GetLength()) <= end)
-        {
-            if (maxLength > sizeof(tlv) + tlv.GetLength())
-            {
-                maxLength = sizeof(tlv) + tlv.GetLength();
-            }
-
-            message.Read(offset, maxLength, &tlv);
-
-            ExitNow(error = kThreadError_None);
-        }
-
-        offset += sizeof(tlv) + tlv.GetLength();
-    }
+    SuccessOrExit(error = iterator.SeekTo(static_cast<uint8_t>(aType)));
+    iterator.ReadTlv(aMaxLength, &aTlv);
 
 exit:
     return error;
@@ -100,36 +84,12 @@ exit:
 
 ThreadError Tlv::GetValueOffset(const Message &aMessage, Type aType, uint16_t &aOffset, uint16_t &aLength)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = aMessage.GetOffset();
-    uint16_t end = aMessage.GetLength();
+    ThreadError error;
+    TlvIterator iterator(aMessage, true);
 
-    while (offset < end)
-    {
-        Tlv tlv;
-        uint16_t length;
-
-        aMessage.Read(offset, sizeof(tlv), &tlv);
-        offset += sizeof(tlv);
-
-        length = tlv.GetLength();
-
-        if (length == kExtendedLength)
-        {
-            aMessage.Read(offset, sizeof(length), &length);
-            offset += sizeof(length);
-            length = HostSwap16(length);
-        }
-
-        if (tlv.GetType() == aType)
-        {
-            aOffset = offset;
-            aLength = length;
-            ExitNow(error = kThreadError_None);
-        }
-
-        offset += length;
-    }
+    SuccessOrExit(error = iterator.SeekTo(static_cast<uint8_t>(aType)));
+    aOffset = iterator.GetValueOffset();
+    aLength = iterator.GetLength();
 
 exit:
     return error;
@@ -87,6 +87,7 @@ public:
         kPeriod                  = OT_MESHCOP_TLV_PERIOD,            ///< Period TLV
         kScanDuration            = OT_MESHCOP_TLV_SCAN_DURATION,     ///< Scan Duration TLV
         kEnergyList              = OT_MESHCOP_TLV_ENERGY_LIST,       ///< Energy List TLV
+        kCompressedEnergyList    = OT_MESHCOP_TLV_COMP_ENERGY_LIST,  ///< Compressed Energy List TLV
         kDiscoveryRequest        = OT_MESHCOP_TLV_DISCOVERYREQUEST,  ///< Discovery Request TLV
         kDiscoveryResponse       = OT_MESHCOP_TLV_DISCOVERYRESPONSE, ///< Discovery Response TLV
     };
@@ -1446,6 +1447,34 @@ public:
     bool IsValid(void) const { return true; }
 } OT_TOOL_PACKED_END;
 
+/**
+ * This class implements Compressed Energy List TLV generation and parsing.
+ *
+ * The value is a run-length encoded stream of (count, delta) byte pairs, where each delta is
+ * relative to the sample at the same index in the preceding record of the batch (absolute for
+ * the first record).
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+class CompressedEnergyListTlv: public Tlv
+{
+public:
+    /**
+     * This method initializes the TLV.
+     *
+     */
+    void Init(void) { SetType(kCompressedEnergyList); SetLength(sizeof(*this) - sizeof(Tlv)); }
+
+    /**
+     * This method indicates whether or not the TLV appears to be well-formed.
+     *
+     * @retval TRUE   If the TLV appears to be well-formed.
+     * @retval FALSE  If the TLV does not appear to be well-formed.
+     *
+     */
+    bool IsValid(void) const { return true; }
+} OT_TOOL_PACKED_END;
+
 /**
  * This class implements Discovery Request TLV generation and parsing.
  *
@@ -34,14 +34,17 @@
 #include <thread/mle.hpp>
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/flight_recorder.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/perf_counters.hpp>
+#include <common/random.hpp>
 #include <crypto/aes_ccm.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
 #include <platform/radio.h>
-#include <platform/random.h>
+#include <platform/settings.h>
 #include <thread/address_resolver.hpp>
 #include <thread/meshcop_tlvs.hpp>
 #include <thread/key_manager.hpp>
@@ -70,6 +73,13 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
                   ModeTlv::kModeFullNetworkData;
     mParentRequestState = kParentIdle;
     mParentRequestMode = kMleAttachAnyPartition;
+    mAttachProfile = kMleAttachProfileStandard;
+    mParentRequestRouterTimeout = kParentRequestRouterTimeout;
+    mParentRequestChildTimeout = kParentRequestChildTimeout;
+    mAesCcmKeySequence = 0;
+    mAesCcmKeyValid = false;
+    memset(mTxNonce, 0, sizeof(mTxNonce));
+    memset(mParentCandidates, 0, sizeof(mParentCandidates));
     mParentLinkQuality = 0;
     mParentPriority = 0;
     mParentLinkQuality3 = 0;
@@ -77,8 +87,10 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mParentLinkQuality1 = 0;
     mRetrieveNewNetworkData = false;
     mTimeout = kMleEndDeviceTimeout;
+    mDiscoveryResponseCacheLength = 0;
 
     memset(&mLeaderData, 0, sizeof(mLeaderData));
+    mLeaderDataWord = 0;
     memset(&mParent, 0, sizeof(mParent));
     memset(&mChildIdRequest, 0, sizeof(mChildIdRequest));
     memset(&mLinkLocal64, 0, sizeof(mLinkLocal64));
@@ -106,6 +118,18 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mLinkLocal16.mPreferredLifetime = 0xffffffff;
     mLinkLocal16.mValidLifetime = 0xffffffff;
 
+    // link-local all thread nodes
+    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[0] = HostSwap16(0xff32);
+    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[6] = HostSwap16(0x0000);
+    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[7] = HostSwap16(0x0001);
+    mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
+
+    // realm-local all thread nodes
+    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[0] = HostSwap16(0xff33);
+    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[6] = HostSwap16(0x0000);
+    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[7] = HostSwap16(0x0001);
+    mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
+
     // initialize Mesh Local Prefix
     mMeshLocal64.GetAddress().mFields.m8[0] = 0xfd;
     memcpy(mMeshLocal64.GetAddress().mFields.m8 + 1, mMac.GetExtendedPanId(), 5);
@@ -113,10 +137,7 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mMeshLocal64.GetAddress().mFields.m8[7] = 0x00;
 
     // mesh-local 64
-    for (int i = 8; i < 16; i++)
-    {
-        mMeshLocal64.GetAddress().mFields.m8[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mMeshLocal64.GetAddress().mFields.m8 + 8, 8);
 
     mMeshLocal64.mPrefixLength = 64;
     mMeshLocal64.mPreferredLifetime = 0xffffffff;
@@ -131,18 +152,6 @@ Mle::Mle(ThreadNetif &aThreadNetif) :
     mMeshLocal16.mPreferredLifetime = 0xffffffff;
     mMeshLocal16.mValidLifetime = 0xffffffff;
 
-    // link-local all thread nodes
-    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[0] = HostSwap16(0xff32);
-    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[6] = HostSwap16(0x0000);
-    mLinkLocalAllThreadNodes.GetAddress().mFields.m16[7] = HostSwap16(0x0001);
-    mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
-
-    // realm-local all thread nodes
-    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[0] = HostSwap16(0xff33);
-    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[6] = HostSwap16(0x0000);
-    mRealmLocalAllThreadNodes.GetAddress().mFields.m16[7] = HostSwap16(0x0001);
-    mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
-
     mNetifCallback.Set(&HandleNetifStateChanged, this);
     mNetif.RegisterCallback(mNetifCallback);
 
@@ -184,12 +193,18 @@ ThreadError Mle::Start(void)
     ThreadError error = kThreadError_None;
 
     // cannot bring up the interface if IEEE 802.15.4 promiscuous mode is enabled
-    VerifyOrExit(otPlatRadioGetPromiscuous(NULL) == false, error = kThreadError_Busy);
+    VerifyOrExit(otPlatRadioGetPromiscuous(mNetif.GetMac().GetInstance()) == false, error = kThreadError_Busy);
     VerifyOrExit(mNetif.IsUp(), error = kThreadError_InvalidState);
 
     mDeviceState = kDeviceStateDetached;
     SetStateDetached();
 
+    if (GetRloc16() == Mac::kShortAddrInvalid)
+    {
+        // attempt a fast reattach using session state persisted before the last reset
+        RestoreSessionState();
+    }
+
     if (GetRloc16() == Mac::kShortAddrInvalid)
     {
         BecomeChild(kMleAttachAnyPartition);
@@ -202,7 +217,7 @@ ThreadError Mle::Start(void)
     {
         SendChildUpdateRequest();
         mParentRequestState = kParentSynchronize;
-        mParentRequestTimer.Start(kParentRequestRouterTimeout);
+        mParentRequestTimer.Start(mParentRequestRouterTimeout);
     }
 
 exit:
@@ -213,7 +228,6 @@ ThreadError Mle::Stop(void)
 {
     SetStateDetached();
     mNetif.RemoveUnicastAddress(mLinkLocal16);
-    mNetif.RemoveUnicastAddress(mMeshLocal16);
     mDeviceState = kDeviceStateDisabled;
     return kThreadError_None;
 }
@@ -314,12 +328,43 @@ ThreadError Mle::BecomeChild(otMleAttachFilter aFilter)
         mParent.mState = Neighbor::kStateInvalid;
     }
 
-    mParentRequestTimer.Start(kParentRequestRouterTimeout);
+    mParentRequestTimer.Start(mParentRequestRouterTimeout);
 
 exit:
     return error;
 }
 
+ThreadError Mle::SetAttachProfile(otMleAttachProfile aProfile)
+{
+    ThreadError error = kThreadError_None;
+
+    switch (aProfile)
+    {
+    case kMleAttachProfileStandard:
+        mParentRequestRouterTimeout = kParentRequestRouterTimeout;
+        mParentRequestChildTimeout = kParentRequestChildTimeout;
+        break;
+
+    case kMleAttachProfileAggressive:
+        mParentRequestRouterTimeout = kFastParentRequestRouterTimeout;
+        mParentRequestChildTimeout = kFastParentRequestChildTimeout;
+        break;
+
+    default:
+        ExitNow(error = kThreadError_InvalidArgs);
+    }
+
+    mAttachProfile = aProfile;
+
+exit:
+    return error;
+}
+
+otMleAttachProfile Mle::GetAttachProfile(void) const
+{
+    return mAttachProfile;
+}
+
 bool Mle::IsAttached(void) const
 {
     return (mDeviceState == kDeviceStateChild ||
@@ -337,6 +382,7 @@ ThreadError Mle::SetStateDetached(void)
     if (mDeviceState != kDeviceStateDetached)
     {
         mNetif.SetStateChangedFlags(OT_NET_ROLE);
+        FlightRecorderRecord(kFlightRecorderEventRoleChange, kDeviceStateDetached, GetRloc16());
     }
 
     mAddressResolver.Clear();
@@ -356,11 +402,13 @@ ThreadError Mle::SetStateChild(uint16_t aRloc16)
     if (mDeviceState != kDeviceStateChild)
     {
         mNetif.SetStateChangedFlags(OT_NET_ROLE);
+        FlightRecorderRecord(kFlightRecorderEventRoleChange, kDeviceStateChild, aRloc16);
     }
 
     SetRloc16(aRloc16);
     mDeviceState = kDeviceStateChild;
     mParentRequestState = kParentIdle;
+    ClearParentCandidates();
 
     if ((mDeviceMode & ModeTlv::kModeRxOnWhenIdle) != 0)
     {
@@ -374,11 +422,54 @@ ThreadError Mle::SetStateChild(uint16_t aRloc16)
 
     mNetif.GetNetworkDataLocal().ClearResubmitDelayTimer();
     mNetif.GetIp6().SetForwardingEnabled(false);
+    StoreSessionState();
 
     otLogInfoMle("Mode -> Child\n");
     return kThreadError_None;
 }
 
+void Mle::StoreSessionState(void)
+{
+    SessionState state;
+
+    state.mKeySequence = mKeyManager.GetCurrentKeySequence();
+    state.mRloc16 = GetRloc16();
+    state.mParentRloc16 = mParent.mValid.mRloc16;
+    memcpy(&state.mParentMacAddr, &mParent.mMacAddr, sizeof(state.mParentMacAddr));
+
+    otPlatSettingsSet(kPlatSettingsKeySessionState, reinterpret_cast<const uint8_t *>(&state), sizeof(state));
+}
+
+ThreadError Mle::RestoreSessionState(void)
+{
+    ThreadError error = kThreadError_None;
+    SessionState state;
+    int length = sizeof(state);
+
+    SuccessOrExit(error = otPlatSettingsGet(kPlatSettingsKeySessionState, 0,
+                                            reinterpret_cast<uint8_t *>(&state), &length));
+    VerifyOrExit(length == sizeof(state), error = kThreadError_NotFound);
+    VerifyOrExit(state.mRloc16 != Mac::kShortAddrInvalid && !IsActiveRouter(state.mRloc16),
+                 error = kThreadError_NotFound);
+
+    // restore the key sequence before the frame counters because changing the key sequence resets them
+    mKeyManager.SetCurrentKeySequence(state.mKeySequence);
+    mKeyManager.RestoreFrameCounters();
+
+    memset(&mParent, 0, sizeof(mParent));
+    memcpy(&mParent.mMacAddr, &state.mParentMacAddr, sizeof(mParent.mMacAddr));
+    mParent.mValid.mRloc16 = state.mParentRloc16;
+    mParent.mKeySequence = state.mKeySequence;
+    mParent.mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
+    mParent.mLinkInfo.Clear();
+    mParent.mState = Neighbor::kStateValid;
+
+    SetRloc16(state.mRloc16);
+
+exit:
+    return error;
+}
+
 uint32_t Mle::GetTimeout(void) const
 {
     return mTimeout;
@@ -466,7 +557,8 @@ ThreadError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
 {
     // We must remove the old address before adding the new one.
     mNetif.RemoveUnicastAddress(mMeshLocal64);
-    mNetif.RemoveUnicastAddress(mMeshLocal16);
+    mNetif.UnsubscribeMulticast(mLinkLocalAllThreadNodes);
+    mNetif.UnsubscribeMulticast(mRealmLocalAllThreadNodes);
 
     memcpy(mMeshLocal64.GetAddress().mFields.m8, aMeshLocalPrefix, 8);
     memcpy(mMeshLocal16.GetAddress().mFields.m8, mMeshLocal64.GetAddress().mFields.m8, 8);
@@ -477,8 +569,10 @@ ThreadError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
     mRealmLocalAllThreadNodes.GetAddress().mFields.m8[3] = 64;
     memcpy(mRealmLocalAllThreadNodes.GetAddress().mFields.m8 + 4, mMeshLocal64.GetAddress().mFields.m8, 8);
 
-    // Add the address back into the table.
+    // Add the addresses back into the table.
     mNetif.AddUnicastAddress(mMeshLocal64);
+    mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
+    mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
 
     // Changing the prefix also causes the mesh local address to be different.
     mNetif.SetStateChangedFlags(OT_IP6_ML_ADDR_CHANGED);
@@ -504,7 +598,6 @@ uint16_t Mle::GetRloc16(void) const
 ThreadError Mle::SetRloc16(uint16_t aRloc16)
 {
     mNetif.RemoveUnicastAddress(mLinkLocal16);
-    mNetif.RemoveUnicastAddress(mMeshLocal16);
 
     if (aRloc16 != Mac::kShortAddrInvalid)
     {
@@ -516,9 +609,8 @@ ThreadError Mle::SetRloc16(uint16_t aRloc16)
             mNetif.AddUnicastAddress(mLinkLocal16);
         }
 
-        // mesh-local 16
+        // mesh-local 16 is matched as a synthesized address; only the stored copy is updated
         mMeshLocal16.GetAddress().mFields.m16[7] = HostSwap16(aRloc16);
-        mNetif.AddUnicastAddress(mMeshLocal16);
     }
 
     mMac.SetShortAddress(aRloc16);
@@ -536,11 +628,31 @@ void Mle::SetLeaderData(uint32_t aPartitionId, uint8_t aWeighting, uint8_t aLead
     if (mLeaderData.GetPartitionId() != aPartitionId)
     {
         mNetif.SetStateChangedFlags(OT_NET_PARTITION_ID);
+        FlightRecorderRecord(kFlightRecorderEventPartitionChange, 0, static_cast<uint16_t>(aPartitionId));
     }
 
     mLeaderData.SetPartitionId(aPartitionId);
     mLeaderData.SetWeighting(aWeighting);
     mLeaderData.SetLeaderRouterId(aLeaderRouterId);
+    UpdateLeaderDataWord();
+}
+
+uint64_t Mle::GetLeaderDataWord(void)
+{
+    if (mLeaderData.GetDataVersion() != mNetworkData.GetVersion() ||
+        mLeaderData.GetStableDataVersion() != mNetworkData.GetStableVersion())
+    {
+        mLeaderData.SetDataVersion(mNetworkData.GetVersion());
+        mLeaderData.SetStableDataVersion(mNetworkData.GetStableVersion());
+        UpdateLeaderDataWord();
+    }
+
+    return mLeaderDataWord;
+}
+
+void Mle::UpdateLeaderDataWord(void)
+{
+    memcpy(&mLeaderDataWord, reinterpret_cast<const uint8_t *>(&mLeaderData) + sizeof(Tlv), sizeof(mLeaderDataWord));
 }
 
 const Ip6::Address *Mle::GetMeshLocal16(void) const
@@ -573,6 +685,7 @@ const LeaderDataTlv &Mle::GetLeaderDataTlv(void)
 {
     mLeaderData.SetDataVersion(mNetworkData.GetVersion());
     mLeaderData.SetStableDataVersion(mNetworkData.GetStableVersion());
+    UpdateLeaderDataWord();
     return mLeaderData;
 }
 
@@ -655,11 +768,38 @@ void Mle::GenerateNonce(const Mac::ExtAddress &aMacAddr, uint32_t aFrameCounter,
     aNonce[0] = aSecurityLevel;
 }
 
+Crypto::AesCcm &Mle::GetCurrentAesCcm(void)
+{
+    uint32_t keySequence = mKeyManager.GetCurrentKeySequence();
+
+    // reload the AES key schedule only when the key sequence rotates
+    if (!mAesCcmKeyValid || mAesCcmKeySequence != keySequence)
+    {
+        mAesCcm.SetKey(mKeyManager.GetCurrentMleKey(), 16);
+        mAesCcmKeySequence = keySequence;
+        mAesCcmKeyValid = true;
+    }
+
+    // keep the cached transmit nonce in sync with the interface address; the frame
+    // counter bytes are patched per message
+    if (memcmp(mTxNonce, mMac.GetExtAddress()->m8, sizeof(Mac::ExtAddress)) != 0)
+    {
+        memcpy(mTxNonce, mMac.GetExtAddress()->m8, sizeof(Mac::ExtAddress));
+        mTxNonce[12] = Mac::Frame::kSecEncMic32;
+    }
+
+    return mAesCcm;
+}
+
 ThreadError Mle::AppendHeader(Message &aMessage, Header::Command aCommand)
 {
     ThreadError error = kThreadError_None;
     Header header;
 
+    // MLE messages keep the partition stable and must not be starved by application traffic
+    aMessage.SetPriority(Message::kPriorityHigh);
+    aMessage.SetOwner(Message::kOwnerMle);
+
     header.Init();
 
     if (aCommand == Header::kCommandDiscoveryRequest ||
@@ -784,6 +924,7 @@ ThreadError Mle::AppendLeaderData(Message &aMessage)
     mLeaderData.Init();
     mLeaderData.SetDataVersion(mNetworkData.GetVersion());
     mLeaderData.SetStableDataVersion(mNetworkData.GetStableVersion());
+    UpdateLeaderDataWord();
 
     return aMessage.Append(&mLeaderData, sizeof(mLeaderData));
 }
@@ -938,10 +1079,7 @@ void Mle::HandleNetifStateChanged(uint32_t aFlags)
         if (!mNetif.IsUnicastAddress(mMeshLocal64.GetAddress()))
         {
             // Mesh Local EID was removed, choose a new one and add it back
-            for (int i = 8; i < 16; i++)
-            {
-                mMeshLocal64.GetAddress().mFields.m8[i] = static_cast<uint8_t>(otPlatRandomGet());
-            }
+            Random::FillBuffer(mMeshLocal64.GetAddress().mFields.m8 + 8, 8);
 
             mNetif.AddUnicastAddress(mMeshLocal64);
             mNetif.SetStateChangedFlags(OT_IP6_ML_ADDR_CHANGED);
@@ -983,8 +1121,17 @@ void Mle::HandleParentRequestTimer(void)
         {
             if (mDeviceMode & ModeTlv::kModeRxOnWhenIdle)
             {
-                SendChildUpdateRequest();
-                mParentRequestTimer.Start(Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts));
+                uint32_t interval = Timer::SecToMsec(mTimeout / kMaxChildKeepAliveAttempts);
+
+                // recent secure bidirectional traffic with the parent already proves liveness,
+                // so only fall back to an explicit Child Update exchange when the link was quiet
+                if ((Timer::GetNow() - mParent.mLastHeard) >= interval ||
+                    (Timer::GetNow() - mParent.mLastAcked) >= interval)
+                {
+                    SendChildUpdateRequest();
+                }
+
+                mParentRequestTimer.Start(interval);
             }
         }
         else
@@ -1003,7 +1150,7 @@ void Mle::HandleParentRequestTimer(void)
         mParentRequestState = kParentRequestRouter;
         mParent.mState = Neighbor::kStateInvalid;
         SendParentRequest();
-        mParentRequestTimer.Start(kParentRequestRouterTimeout);
+        mParentRequestTimer.Start(mParentRequestRouterTimeout);
         break;
 
     case kParentRequestRouter:
@@ -1019,7 +1166,7 @@ void Mle::HandleParentRequestTimer(void)
             SendParentRequest();
         }
 
-        mParentRequestTimer.Start(kParentRequestChildTimeout);
+        mParentRequestTimer.Start(mParentRequestChildTimeout);
         break;
 
     case kParentRequestChild:
@@ -1029,7 +1176,7 @@ void Mle::HandleParentRequestTimer(void)
         {
             SendChildIdRequest();
             mParentRequestState = kChildIdRequest;
-            mParentRequestTimer.Start(kParentRequestChildTimeout);
+            mParentRequestTimer.Start(mParentRequestChildTimeout);
         }
         else
         {
@@ -1058,12 +1205,23 @@ void Mle::HandleParentRequestTimer(void)
         break;
 
     case kChildIdRequest:
-        mParentRequestState = kParentIdle;
-
         if (mDeviceState != kDeviceStateRouter && mDeviceState != kDeviceStateLeader)
         {
+            // try the next best parent heard during this cycle before detaching
+            if (NextParentCandidate())
+            {
+                SendChildIdRequest();
+                mParentRequestTimer.Start(mParentRequestChildTimeout);
+                break;
+            }
+
+            mParentRequestState = kParentIdle;
             BecomeDetached();
         }
+        else
+        {
+            mParentRequestState = kParentIdle;
+        }
 
         break;
     }
@@ -1076,10 +1234,7 @@ ThreadError Mle::SendParentRequest(void)
     uint8_t scanMask = 0;
     Ip6::Address destination;
 
-    for (uint8_t i = 0; i < sizeof(mParentRequest.mChallenge); i++)
-    {
-        mParentRequest.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mParentRequest.mChallenge, sizeof(mParentRequest.mChallenge));
 
     VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, ;);
     message->SetLinkSecurityEnabled(false);
@@ -1116,6 +1271,12 @@ ThreadError Mle::SendParentRequest(void)
     destination.mFields.m16[7] = HostSwap16(0x0002);
     SuccessOrExit(error = SendMessage(*message, destination));
 
+    if (sPerfCounters.mTimeToFirstParentRequest == 0)
+    {
+        sPerfCounters.mTimeToFirstParentRequest = Timer::GetNow();
+        otLogInfoMle("First parent request after %u ms\n", sPerfCounters.mTimeToFirstParentRequest);
+    }
+
     switch (mParentRequestState)
     {
     case kParentRequestRouter:
@@ -1201,6 +1362,12 @@ ThreadError Mle::SendDataRequest(const Ip6::Address &aDestination, const uint8_t
     SuccessOrExit(error = AppendActiveTimestamp(*message));
     SuccessOrExit(error = AppendPendingTimestamp(*message));
 
+    // let the responder see our current version set so it can omit TLVs we already have
+    if (mDeviceState == kDeviceStateChild || mDeviceState == kDeviceStateRouter || mDeviceState == kDeviceStateLeader)
+    {
+        SuccessOrExit(error = AppendLeaderData(*message));
+    }
+
     SuccessOrExit(error = SendMessage(*message, aDestination));
 
     otLogInfoMle("Sent Data Request\n");
@@ -1254,10 +1421,7 @@ ThreadError Mle::SendChildUpdateRequest(void)
     switch (mDeviceState)
     {
     case kDeviceStateDetached:
-        for (uint8_t i = 0; i < sizeof(mParentRequest.mChallenge); i++)
-        {
-            mParentRequest.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-        }
+        Random::FillBuffer(mParentRequest.mChallenge, sizeof(mParentRequest.mChallenge));
 
         SuccessOrExit(error = AppendChallenge(*message, mParentRequest.mChallenge,
                                               sizeof(mParentRequest.mChallenge)));
@@ -1304,44 +1468,40 @@ ThreadError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination
     ThreadError error = kThreadError_None;
     Header header;
     uint32_t keySequence;
-    uint8_t nonce[13];
+    uint32_t frameCounter;
     uint8_t tag[4];
     uint8_t tagLength;
-    Crypto::AesCcm aesCcm;
-    uint8_t buf[64];
-    uint16_t length;
     Ip6::MessageInfo messageInfo;
 
     aMessage.Read(0, sizeof(header), &header);
 
     if (header.GetSecuritySuite() == Header::k154Security)
     {
-        header.SetFrameCounter(mKeyManager.GetMleFrameCounter());
+        Crypto::AesCcm &aesCcm = GetCurrentAesCcm();
+
+        frameCounter = mKeyManager.GetMleFrameCounter();
+        header.SetFrameCounter(frameCounter);
 
         keySequence = mKeyManager.GetCurrentKeySequence();
         header.SetKeyId(keySequence);
 
         aMessage.Write(0, header.GetLength(), &header);
 
-        GenerateNonce(*mMac.GetExtAddress(), mKeyManager.GetMleFrameCounter(), Mac::Frame::kSecEncMic32, nonce);
+        // patch the frame counter into the cached nonce
+        mTxNonce[8] = (frameCounter >> 24) & 0xff;
+        mTxNonce[9] = (frameCounter >> 16) & 0xff;
+        mTxNonce[10] = (frameCounter >> 8) & 0xff;
+        mTxNonce[11] = frameCounter & 0xff;
 
-        aesCcm.SetKey(mKeyManager.GetCurrentMleKey(), 16);
         aesCcm.Init(16 + 16 + header.GetHeaderLength(), aMessage.GetLength() - (header.GetLength() - 1),
-                    sizeof(tag), nonce, sizeof(nonce));
+                    sizeof(tag), mTxNonce, sizeof(mTxNonce));
 
         aesCcm.Header(&mLinkLocal64.GetAddress(), sizeof(mLinkLocal64.GetAddress()));
         aesCcm.Header(&aDestination, sizeof(aDestination));
         aesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
 
         aMessage.SetOffset(header.GetLength() - 1);
-
-        while (aMessage.GetOffset() < aMessage.GetLength())
-        {
-            length = aMessage.Read(aMessage.GetOffset(), sizeof(buf), buf);
-            aesCcm.Payload(buf, buf, length, true);
-            aMessage.Write(aMessage.GetOffset(), length, buf);
-            aMessage.MoveOffset(length);
-        }
+        aesCcm.Payload(aMessage, aMessage.GetOffset(), aMessage.GetLength() - aMessage.GetOffset(), true);
 
         tagLength = sizeof(tag);
         aesCcm.Finalize(tag, &tagLength);
@@ -1359,6 +1519,8 @@ ThreadError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination
 
     SuccessOrExit(error = mSocket.SendTo(aMessage, messageInfo));
 
+    sPerfCounters.mMleMessagesSent++;
+
 exit:
     return error;
 }
@@ -1373,16 +1535,13 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
 {
     Header header;
     uint32_t keySequence;
-    const uint8_t *mleKey;
     uint32_t frameCounter;
     uint8_t messageTag[4];
     uint16_t messageTagLength;
     uint8_t nonce[13];
     Mac::ExtAddress macAddr;
-    Crypto::AesCcm aesCcm;
-    uint16_t mleOffset;
-    uint8_t buf[64];
-    uint16_t length;
+    Crypto::AesCcm tempAesCcm;
+    Crypto::AesCcm *aesCcm;
     uint8_t tag[4];
     uint8_t tagLength;
     uint8_t command;
@@ -1391,6 +1550,8 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     aMessage.Read(aMessage.GetOffset(), sizeof(header), &header);
     VerifyOrExit(header.IsValid(),);
 
+    sPerfCounters.mMleMessagesReceived++;
+
     if (header.GetSecuritySuite() == Header::kNoSecurity)
     {
         aMessage.MoveOffset(header.GetLength());
@@ -1418,11 +1579,13 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
 
     if (keySequence == mKeyManager.GetCurrentKeySequence())
     {
-        mleKey = mKeyManager.GetCurrentMleKey();
+        // reuse the cached key schedule for the active key sequence
+        aesCcm = &GetCurrentAesCcm();
     }
     else
     {
-        mleKey = mKeyManager.GetTemporaryMleKey(keySequence);
+        tempAesCcm.SetKey(mKeyManager.GetTemporaryMleKey(keySequence), 16);
+        aesCcm = &tempAesCcm;
     }
 
     aMessage.MoveOffset(header.GetLength() - 1);
@@ -1436,25 +1599,16 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     macAddr.Set(aMessageInfo.GetPeerAddr());
     GenerateNonce(macAddr, frameCounter, Mac::Frame::kSecEncMic32, nonce);
 
-    aesCcm.SetKey(mleKey, 16);
-    aesCcm.Init(sizeof(aMessageInfo.GetPeerAddr()) + sizeof(aMessageInfo.GetSockAddr()) + header.GetHeaderLength(),
-                aMessage.GetLength() - aMessage.GetOffset(), sizeof(messageTag), nonce, sizeof(nonce));
-    aesCcm.Header(&aMessageInfo.GetPeerAddr(), sizeof(aMessageInfo.GetPeerAddr()));
-    aesCcm.Header(&aMessageInfo.GetSockAddr(), sizeof(aMessageInfo.GetSockAddr()));
-    aesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
+    aesCcm->Init(sizeof(aMessageInfo.GetPeerAddr()) + sizeof(aMessageInfo.GetSockAddr()) + header.GetHeaderLength(),
+                 aMessage.GetLength() - aMessage.GetOffset(), sizeof(messageTag), nonce, sizeof(nonce));
+    aesCcm->Header(&aMessageInfo.GetPeerAddr(), sizeof(aMessageInfo.GetPeerAddr()));
+    aesCcm->Header(&aMessageInfo.GetSockAddr(), sizeof(aMessageInfo.GetSockAddr()));
+    aesCcm->Header(header.GetBytes() + 1, header.GetHeaderLength());
 
-    mleOffset = aMessage.GetOffset();
-
-    while (aMessage.GetOffset() < aMessage.GetLength())
-    {
-        length = aMessage.Read(aMessage.GetOffset(), sizeof(buf), buf);
-        aesCcm.Payload(buf, buf, length, false);
-        aMessage.Write(aMessage.GetOffset(), length, buf);
-        aMessage.MoveOffset(length);
-    }
+    aesCcm->Payload(aMessage, aMessage.GetOffset(), aMessage.GetLength() - aMessage.GetOffset(), false);
 
     tagLength = sizeof(tag);
-    aesCcm.Finalize(tag, &tagLength);
+    aesCcm->Finalize(tag, &tagLength);
     VerifyOrExit(messageTagLength == tagLength && memcmp(messageTag, tag, tagLength) == 0, ;);
 
     if (keySequence > mKeyManager.GetCurrentKeySequence())
@@ -1462,8 +1616,6 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
         mKeyManager.SetCurrentKeySequence(keySequence);
     }
 
-    aMessage.SetOffset(mleOffset);
-
     aMessage.Read(aMessage.GetOffset(), sizeof(command), &command);
     aMessage.MoveOffset(sizeof(command));
 
@@ -1502,10 +1654,14 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
         {
             VerifyOrExit(keySequence > neighbor->mKeySequence, otLogDebgMle("mle frame reject 2\n"));
             neighbor->mKeySequence = keySequence;
-            neighbor->mValid.mLinkFrameCounter = 0;
+            neighbor->ResetLinkFrameCounter(0);
         }
 
         neighbor->mValid.mMleFrameCounter = frameCounter + 1;
+
+        // any authenticated MLE message proves liveness; this also lets the reply to a
+        // pre-expiry child probe refresh the child regardless of how it is dispatched
+        neighbor->mLastHeard = Timer::GetNow();
     }
     else
     {
@@ -1573,6 +1729,14 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     case Header::kCommandChildUpdateResponse:
         HandleChildUpdateResponse(aMessage, aMessageInfo);
         break;
+
+    case Header::kCommandLinkProbe:
+        mMleRouter.HandleLinkProbe(aMessage, aMessageInfo);
+        break;
+
+    case Header::kCommandLinkProbeAck:
+        mMleRouter.HandleLinkProbeAck(aMessage, aMessageInfo);
+        break;
     }
 
 exit:
@@ -1587,6 +1751,8 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
     Neighbor *neighbor;
     SourceAddressTlv sourceAddress;
     LeaderDataTlv leaderData;
+    uint64_t leaderDataWord;
+    bool leaderDataUnchanged;
     uint8_t tlvs[] = {Tlv::kNetworkData};
 
     // Source Address
@@ -1597,6 +1763,9 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
     SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData));
     VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
 
+    memcpy(&leaderDataWord, reinterpret_cast<const uint8_t *>(&leaderData) + sizeof(Tlv), sizeof(leaderDataWord));
+    leaderDataUnchanged = (leaderDataWord == GetLeaderDataWord());
+
     otLogInfoMle("Received advertisement from %04x\n", sourceAddress.GetRloc16());
 
     if (mDeviceState != kDeviceStateDetached)
@@ -1620,7 +1789,8 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
             break;
         }
 
-        if ((mParent.mValid.mRloc16 == sourceAddress.GetRloc16()) &&
+        if (!leaderDataUnchanged &&
+            (mParent.mValid.mRloc16 == sourceAddress.GetRloc16()) &&
             (leaderData.GetPartitionId() != mLeaderData.GetPartitionId() ||
              leaderData.GetLeaderRouterId() != GetLeaderId()))
         {
@@ -1646,7 +1816,8 @@ ThreadError Mle::HandleAdvertisement(const Message &aMessage, const Ip6::Message
     if (isNeighbor)
     {
         if (mRetrieveNewNetworkData ||
-            (static_cast<int8_t>(leaderData.GetDataVersion() - mNetworkData.GetVersion()) > 0))
+            (!leaderDataUnchanged &&
+             static_cast<int8_t>(leaderData.GetDataVersion() - mNetworkData.GetVersion()) > 0))
         {
             SendDataRequest(aMessageInfo.GetPeerAddr(), tlvs, sizeof(tlvs));
         }
@@ -1773,6 +1944,158 @@ exit:
     return rval;
 }
 
+bool Mle::IsBetterParentCandidate(const ParentCandidate &aLhs, const ParentCandidate &aRhs)
+{
+    bool rval = false;
+
+    if (aLhs.mLinkQuality != aRhs.mLinkQuality)
+    {
+        ExitNow(rval = (aLhs.mLinkQuality > aRhs.mLinkQuality));
+    }
+
+    if (IsActiveRouter(aLhs.mRloc16) != IsActiveRouter(aRhs.mRloc16))
+    {
+        ExitNow(rval = IsActiveRouter(aLhs.mRloc16));
+    }
+
+    if (aLhs.mPriority != aRhs.mPriority)
+    {
+        ExitNow(rval = (aLhs.mPriority > aRhs.mPriority));
+    }
+
+    if (aLhs.mLinkQuality3 != aRhs.mLinkQuality3)
+    {
+        ExitNow(rval = (aLhs.mLinkQuality3 > aRhs.mLinkQuality3));
+    }
+
+    if (aLhs.mLinkQuality2 != aRhs.mLinkQuality2)
+    {
+        ExitNow(rval = (aLhs.mLinkQuality2 > aRhs.mLinkQuality2));
+    }
+
+    if (aLhs.mLinkQuality1 != aRhs.mLinkQuality1)
+    {
+        ExitNow(rval = (aLhs.mLinkQuality1 > aRhs.mLinkQuality1));
+    }
+
+exit:
+    return rval;
+}
+
+void Mle::ClearParentCandidates(void)
+{
+    for (int i = 0; i < kMaxParentCandidates; i++)
+    {
+        mParentCandidates[i].mValid = false;
+    }
+}
+
+void Mle::AddParentCandidate(const ParentCandidate &aCandidate)
+{
+    ParentCandidate *slot = NULL;
+
+    // refresh an existing entry for the same parent
+    for (int i = 0; i < kMaxParentCandidates; i++)
+    {
+        if (mParentCandidates[i].mValid && mParentCandidates[i].mRloc16 == aCandidate.mRloc16)
+        {
+            ExitNow(slot = &mParentCandidates[i]);
+        }
+    }
+
+    // otherwise take a free or stale entry
+    for (int i = 0; i < kMaxParentCandidates; i++)
+    {
+        if (!mParentCandidates[i].mValid ||
+            (Timer::GetNow() - mParentCandidates[i].mTime) >= kParentCandidateMaxAge)
+        {
+            ExitNow(slot = &mParentCandidates[i]);
+        }
+    }
+
+    // otherwise displace the worst entry if the new candidate ranks above it
+    slot = &mParentCandidates[0];
+
+    for (int i = 1; i < kMaxParentCandidates; i++)
+    {
+        if (IsBetterParentCandidate(*slot, mParentCandidates[i]))
+        {
+            slot = &mParentCandidates[i];
+        }
+    }
+
+    VerifyOrExit(IsBetterParentCandidate(aCandidate, *slot), slot = NULL);
+
+exit:
+
+    if (slot != NULL)
+    {
+        *slot = aCandidate;
+        slot->mValid = true;
+    }
+}
+
+bool Mle::NextParentCandidate(void)
+{
+    ParentCandidate *best = NULL;
+
+    for (int i = 0; i < kMaxParentCandidates; i++)
+    {
+        ParentCandidate &entry = mParentCandidates[i];
+
+        if (!entry.mValid)
+        {
+            continue;
+        }
+
+        if (entry.mRloc16 == mParent.mValid.mRloc16)
+        {
+            // the current candidate did not answer the Child ID Request; do not retry it
+            entry.mValid = false;
+            continue;
+        }
+
+        if ((Timer::GetNow() - entry.mTime) >= kParentCandidateMaxAge)
+        {
+            entry.mValid = false;
+            continue;
+        }
+
+        if (best == NULL || IsBetterParentCandidate(entry, *best))
+        {
+            best = &entry;
+        }
+    }
+
+    if (best != NULL)
+    {
+        memcpy(mChildIdRequest.mChallenge, best->mChallenge, best->mChallengeLength);
+        mChildIdRequest.mChallengeLength = best->mChallengeLength;
+
+        mParent.mMacAddr = best->mMacAddr;
+        mParent.mValid.mRloc16 = best->mRloc16;
+        mParent.ResetLinkFrameCounter(best->mLinkFrameCounter);
+        mParent.mValid.mMleFrameCounter = best->mMleFrameCounter;
+        mParent.mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
+        mParent.mLinkInfo.Clear();
+        mParent.mLinkInfo.AddRss(mMac.GetNoiseFloor(), best->mRss);
+        mParent.mState = Neighbor::kStateValid;
+        mParent.mKeySequence = best->mKeySequence;
+
+        mParentLinkQuality = best->mLinkQuality;
+        mParentPriority = best->mPriority;
+        mParentLinkQuality3 = best->mLinkQuality3;
+        mParentLinkQuality2 = best->mLinkQuality2;
+        mParentLinkQuality1 = best->mLinkQuality1;
+        mParentLeaderData = best->mLeaderData;
+        mParentIsSingleton = best->mIsSingleton;
+
+        otLogInfoMle("Fall back to next parent candidate\n");
+    }
+
+    return best != NULL;
+}
+
 ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
                                       uint32_t aKeySequence)
 {
@@ -1846,6 +2169,49 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
         }
     }
 
+    // Link Frame Counter
+    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter), linkFrameCounter));
+    VerifyOrExit(linkFrameCounter.IsValid(), error = kThreadError_Parse);
+
+    // Mle Frame Counter
+    if (Tlv::GetTlv(aMessage, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) == kThreadError_None)
+    {
+        VerifyOrExit(mleFrameCounter.IsValid(), ;);
+    }
+    else
+    {
+        mleFrameCounter.SetFrameCounter(linkFrameCounter.GetFrameCounter());
+    }
+
+    // Challenge
+    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
+    VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
+
+    // remember this parent even if a better one is selected below, so a failed
+    // attach can fall through to it without another parent request cycle
+    {
+        ParentCandidate candidate;
+
+        memset(&candidate, 0, sizeof(candidate));
+        candidate.mMacAddr.Set(aMessageInfo.GetPeerAddr());
+        candidate.mLeaderData = leaderData;
+        candidate.mLinkFrameCounter = linkFrameCounter.GetFrameCounter();
+        candidate.mMleFrameCounter = mleFrameCounter.GetFrameCounter();
+        candidate.mKeySequence = aKeySequence;
+        candidate.mTime = Timer::GetNow();
+        candidate.mRloc16 = sourceAddress.GetRloc16();
+        candidate.mRss = threadMessageInfo->mRss;
+        memcpy(candidate.mChallenge, challenge.GetChallenge(), challenge.GetLength());
+        candidate.mChallengeLength = challenge.GetLength();
+        candidate.mLinkQuality = linkQuality;
+        candidate.mPriority = connectivity.GetParentPriority();
+        candidate.mLinkQuality3 = connectivity.GetLinkQuality3();
+        candidate.mLinkQuality2 = connectivity.GetLinkQuality2();
+        candidate.mLinkQuality1 = connectivity.GetLinkQuality1();
+        candidate.mIsSingleton = connectivity.GetActiveRouters() <= 1;
+        AddParentCandidate(candidate);
+    }
+
     // if already have a candidate parent, only seek a better parent
     if (mParent.mState == Neighbor::kStateValid)
     {
@@ -1864,29 +2230,12 @@ ThreadError Mle::HandleParentResponse(const Message &aMessage, const Ip6::Messag
         VerifyOrExit(compare != 0 || IsBetterParent(sourceAddress.GetRloc16(), linkQuality, connectivity), ;);
     }
 
-    // Link Frame Counter
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkFrameCounter, sizeof(linkFrameCounter), linkFrameCounter));
-    VerifyOrExit(linkFrameCounter.IsValid(), error = kThreadError_Parse);
-
-    // Mle Frame Counter
-    if (Tlv::GetTlv(aMessage, Tlv::kMleFrameCounter, sizeof(mleFrameCounter), mleFrameCounter) == kThreadError_None)
-    {
-        VerifyOrExit(mleFrameCounter.IsValid(), ;);
-    }
-    else
-    {
-        mleFrameCounter.SetFrameCounter(linkFrameCounter.GetFrameCounter());
-    }
-
-    // Challenge
-    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kChallenge, sizeof(challenge), challenge));
-    VerifyOrExit(challenge.IsValid(), error = kThreadError_Parse);
     memcpy(mChildIdRequest.mChallenge, challenge.GetChallenge(), challenge.GetLength());
     mChildIdRequest.mChallengeLength = challenge.GetLength();
 
     mParent.mMacAddr.Set(aMessageInfo.GetPeerAddr());
     mParent.mValid.mRloc16 = sourceAddress.GetRloc16();
-    mParent.mValid.mLinkFrameCounter = linkFrameCounter.GetFrameCounter();
+    mParent.ResetLinkFrameCounter(linkFrameCounter.GetFrameCounter());
     mParent.mValid.mMleFrameCounter = mleFrameCounter.GetFrameCounter();
     mParent.mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
     mParent.mLinkInfo.Clear();
@@ -2182,31 +2531,57 @@ ThreadError Mle::SendDiscoveryResponse(const Ip6::Address &aDestination, uint16_
     message->SetLinkSecurityEnabled(false);
     message->SetMleDiscoverResponse(true);
     message->SetPanId(aPanId);
-    SuccessOrExit(error = AppendHeader(*message, Header::kCommandDiscoveryResponse));
 
-    // Discovery TLV
-    tlv.SetType(Tlv::kDiscovery);
-    SuccessOrExit(error = message->Append(&tlv, sizeof(tlv)));
+    // the serialized response depends only on the extended PAN ID and network name,
+    // so during mass joining every request after the first is a stamp-and-send
+    if (mDiscoveryResponseCacheLength != 0 &&
+        memcmp(mDiscoveryResponseExtPanId, mMac.GetExtendedPanId(), sizeof(mDiscoveryResponseExtPanId)) == 0 &&
+        strncmp(mDiscoveryResponseNetworkName, mMac.GetNetworkName(), sizeof(mDiscoveryResponseNetworkName)) == 0)
+    {
+        message->SetPriority(Message::kPriorityHigh);
+        message->SetOwner(Message::kOwnerMle);
+        SuccessOrExit(error = message->Append(mDiscoveryResponseCache, mDiscoveryResponseCacheLength));
+    }
+    else
+    {
+        SuccessOrExit(error = AppendHeader(*message, Header::kCommandDiscoveryResponse));
 
-    startOffset = message->GetLength();
+        // Discovery TLV
+        tlv.SetType(Tlv::kDiscovery);
+        SuccessOrExit(error = message->Append(&tlv, sizeof(tlv)));
 
-    // Discovery Response TLV
-    discoveryResponse.Init();
-    discoveryResponse.SetVersion(kVersion);
-    SuccessOrExit(error = message->Append(&discoveryResponse, sizeof(discoveryResponse)));
+        startOffset = message->GetLength();
 
-    // Extended PAN ID TLV
-    extPanId.Init();
-    extPanId.SetExtendedPanId(mMac.GetExtendedPanId());
-    SuccessOrExit(error = message->Append(&extPanId, sizeof(extPanId)));
+        // Discovery Response TLV
+        discoveryResponse.Init();
+        discoveryResponse.SetVersion(kVersion);
+        SuccessOrExit(error = message->Append(&discoveryResponse, sizeof(discoveryResponse)));
 
-    // Network Name TLV
-    networkName.Init();
-    networkName.SetNetworkName(mMac.GetNetworkName());
-    SuccessOrExit(error = message->Append(&networkName, sizeof(tlv) + networkName.GetLength()));
+        // Extended PAN ID TLV
+        extPanId.Init();
+        extPanId.SetExtendedPanId(mMac.GetExtendedPanId());
+        SuccessOrExit(error = message->Append(&extPanId, sizeof(extPanId)));
 
-    tlv.SetLength(static_cast<uint8_t>(message->GetLength() - startOffset));
-    message->Write(startOffset - sizeof(tlv), sizeof(tlv), &tlv);
+        // Network Name TLV
+        networkName.Init();
+        networkName.SetNetworkName(mMac.GetNetworkName());
+        SuccessOrExit(error = message->Append(&networkName, sizeof(tlv) + networkName.GetLength()));
+
+        tlv.SetLength(static_cast<uint8_t>(message->GetLength() - startOffset));
+        message->Write(startOffset - sizeof(tlv), sizeof(tlv), &tlv);
+
+        if (message->GetLength() <= sizeof(mDiscoveryResponseCache))
+        {
+            message->Read(0, message->GetLength(), mDiscoveryResponseCache);
+            mDiscoveryResponseCacheLength = static_cast<uint8_t>(message->GetLength());
+            memcpy(mDiscoveryResponseExtPanId, mMac.GetExtendedPanId(), sizeof(mDiscoveryResponseExtPanId));
+            strncpy(mDiscoveryResponseNetworkName, mMac.GetNetworkName(), sizeof(mDiscoveryResponseNetworkName));
+        }
+        else
+        {
+            mDiscoveryResponseCacheLength = 0;
+        }
+    }
 
     SuccessOrExit(error = SendMessage(*message, aDestination));
 
@@ -2354,6 +2729,14 @@ bool Mle::IsRoutingLocator(const Ip6::Address &aAddress) const
     return memcmp(&mMeshLocal16, &aAddress, kRlocPrefixLength) == 0;
 }
 
+bool Mle::IsAssignedRlocAddress(const Ip6::Address &aAddress) const
+{
+    return mDeviceState != kDeviceStateDisabled &&
+           mMac.GetShortAddress() != Mac::kShortAddrInvalid &&
+           aAddress.mFields.m16[7] == HostSwap16(mMac.GetShortAddress()) &&
+           IsRoutingLocator(aAddress);
+}
+
 Router *Mle::GetParent()
 {
     return &mParent;
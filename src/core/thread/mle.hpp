@@ -37,6 +37,7 @@
 #include <openthread.h>
 #include <common/encoding.hpp>
 #include <common/timer.hpp>
+#include <crypto/aes_ccm.hpp>
 #include <mac/mac.hpp>
 #include <net/udp6.hpp>
 #include <thread/mle_constants.hpp>
@@ -278,6 +279,8 @@ public:
         kCommandChildUpdateResponse  = 14,   ///< Child Update Response
         kCommandDiscoveryRequest     = 16,   ///< Discovery Request
         kCommandDiscoveryResponse    = 17,   ///< Discovery Response
+        kCommandLinkProbe            = 18,   ///< Link Probe
+        kCommandLinkProbeAck         = 19,   ///< Link Probe Acknowledgment
     };
 
     /**
@@ -429,6 +432,29 @@ public:
      */
     ThreadError BecomeChild(otMleAttachFilter aFilter);
 
+    /**
+     * This method selects the timing profile used during the attach process.
+     *
+     * The aggressive profile shortens the Parent Request timeouts for environments where
+     * responses arrive quickly, such as dense single-room deployments or wired-backhaul
+     * test networks. The selection takes effect on the next attach attempt.
+     *
+     * @param[in]  aProfile  The attach timing profile.
+     *
+     * @retval kThreadError_None         Successfully set the attach timing profile.
+     * @retval kThreadError_InvalidArgs  @p aProfile is not a known profile.
+     *
+     */
+    ThreadError SetAttachProfile(otMleAttachProfile aProfile);
+
+    /**
+     * This method returns the timing profile used during the attach process.
+     *
+     * @returns The attach timing profile.
+     *
+     */
+    otMleAttachProfile GetAttachProfile(void) const;
+
     /**
      * This method indicates whether or not the Thread device is attached to a Thread network.
      *
@@ -524,6 +550,19 @@ public:
      */
     bool IsRoutingLocator(const Ip6::Address &aAddress) const;
 
+    /**
+     * This method indicates whether or not an IPv6 address is this device's RLOC-derived
+     * mesh-local address.
+     *
+     * The RLOC address is synthesized from the mesh-local prefix and the assigned RLOC16
+     * rather than kept in the unicast address table.
+     *
+     * @retval TRUE   If @p aAddress is the device's RLOC address.
+     * @retval FALSE  If @p aAddress is not the device's RLOC address.
+     *
+     */
+    bool IsAssignedRlocAddress(const Ip6::Address &aAddress) const;
+
     /**
      * This method returns the MLE Timeout value.
      *
@@ -1030,6 +1069,25 @@ protected:
      */
     void SetLeaderData(uint32_t aPartitionId, uint8_t aWeighting, uint8_t aLeaderRouterId);
 
+    /**
+     * This method returns the local Leader Data packed into a single word, laid out exactly as
+     * the Leader Data TLV value appears on the wire.
+     *
+     * A received Leader Data TLV value that equals the packed word carries no change to the
+     * Partition ID, Weighting, Data Versions, or Leader Router ID, allowing the no-change case
+     * to be detected with a single compare.
+     *
+     * @returns The local Leader Data packed as an on-the-wire TLV value.
+     *
+     */
+    uint64_t GetLeaderDataWord(void);
+
+    /**
+     * This method repacks @c mLeaderDataWord from the current contents of @c mLeaderData.
+     *
+     */
+    void UpdateLeaderDataWord(void);
+
     ThreadNetif         &mNetif;            ///< The Thread Network Interface object.
     AddressResolver     &mAddressResolver;  ///< The Address Resolver object.
     KeyManager          &mKeyManager;       ///< The Key Manager object.
@@ -1039,6 +1097,7 @@ protected:
     NetworkData::Leader &mNetworkData;      ///< The Network Data object.
 
     LeaderDataTlv mLeaderData;              ///< Last received Leader Data TLV.
+    uint64_t mLeaderDataWord;               ///< Wire image of the @c mLeaderData value fields.
     bool mRetrieveNewNetworkData;           ///< Indicating new Network Data is needed if set.
 
     DeviceState mDeviceState;               ///< Current Thread interface state.
@@ -1075,6 +1134,7 @@ private:
 
     void GenerateNonce(const Mac::ExtAddress &aMacAddr, uint32_t aFrameCounter, uint8_t aSecurityLevel,
                        uint8_t *aNonce);
+    Crypto::AesCcm &GetCurrentAesCcm(void);
 
     static void HandleNetifStateChanged(uint32_t aFlags, void *aContext);
     void HandleNetifStateChanged(uint32_t aFlags);
@@ -1100,6 +1160,55 @@ private:
 
     bool IsBetterParent(uint16_t aRloc16, uint8_t aLinkQuality, ConnectivityTlv &aConnectivityTlv) const;
 
+    enum
+    {
+        kMaxParentCandidates = 3,         ///< Number of retained parent candidates.
+        kParentCandidateMaxAge = 10000u,  ///< Parent candidate freshness window in milliseconds.
+    };
+
+    struct ParentCandidate
+    {
+        Mac::ExtAddress mMacAddr;
+        LeaderDataTlv mLeaderData;
+        uint32_t mLinkFrameCounter;
+        uint32_t mMleFrameCounter;
+        uint32_t mKeySequence;
+        uint32_t mTime;
+        uint16_t mRloc16;
+        int8_t mRss;
+        uint8_t mChallenge[ChallengeTlv::kMaxSize];
+        uint8_t mChallengeLength;
+        uint8_t mLinkQuality;
+        int8_t mPriority;
+        uint8_t mLinkQuality3;
+        uint8_t mLinkQuality2;
+        uint8_t mLinkQuality1;
+        bool mIsSingleton;
+        bool mValid;
+    };
+
+    static bool IsBetterParentCandidate(const ParentCandidate &aLhs, const ParentCandidate &aRhs);
+    void AddParentCandidate(const ParentCandidate &aCandidate);
+    bool NextParentCandidate(void);
+    void ClearParentCandidates(void);
+
+    enum
+    {
+        kPlatSettingsKeySessionState = 0x0002,  ///< Persistent storage key for the MLE session state.
+    };
+
+    // all fields are naturally aligned, so the layout is stable without packing
+    struct SessionState
+    {
+        uint32_t mKeySequence;
+        uint16_t mRloc16;
+        uint16_t mParentRloc16;
+        Mac::ExtAddress mParentMacAddr;
+    };
+
+    void StoreSessionState(void);
+    ThreadError RestoreSessionState(void);
+
     struct
     {
         uint8_t mChallenge[ChallengeTlv::kMaxSize];
@@ -1112,6 +1221,9 @@ private:
     } mParentRequest;
 
     otMleAttachFilter mParentRequestMode;
+    otMleAttachProfile mAttachProfile;
+    uint32_t mParentRequestRouterTimeout;  ///< Active Parent Request timeout toward routers (milliseconds)
+    uint32_t mParentRequestChildTimeout;   ///< Active Parent Request timeout toward routers and REEDs (milliseconds)
     uint8_t mParentLinkQuality;
     int8_t mParentPriority;
     uint8_t mParentLinkQuality3;
@@ -1120,15 +1232,35 @@ private:
     LeaderDataTlv mParentLeaderData;
     bool mParentIsSingleton;
 
+    ParentCandidate mParentCandidates[kMaxParentCandidates];
+
     Ip6::UdpSocket mSocket;
     uint32_t mTimeout;
 
+    // AES key schedule and transmit nonce template for the current key sequence; only
+    // the frame counter is rebuilt per message
+    Crypto::AesCcm mAesCcm;
+    uint32_t mAesCcmKeySequence;
+    bool mAesCcmKeyValid;
+    uint8_t mTxNonce[13];
+
     Tasklet mSendChildUpdateRequest;
 
     DiscoverHandler mDiscoverHandler;
     void *mDiscoverContext;
     bool mIsDiscoverInProgress;
 
+    // serialized Discovery Response reused across joiner scans; rebuilt when the
+    // extended PAN ID or network name it was built from changes
+    enum
+    {
+        kDiscoveryResponseCacheSize = 64,
+    };
+    uint8_t mDiscoveryResponseCache[kDiscoveryResponseCacheSize];
+    uint8_t mDiscoveryResponseCacheLength;
+    uint8_t mDiscoveryResponseExtPanId[OT_EXT_PAN_ID_SIZE];
+    char mDiscoveryResponseNetworkName[Mac::Beacon::kNetworkNameSize];
+
     Ip6::NetifUnicastAddress mLinkLocal16;
     Ip6::NetifUnicastAddress mLinkLocal64;
     Ip6::NetifUnicastAddress mMeshLocal64;
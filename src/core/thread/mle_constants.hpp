@@ -34,6 +34,8 @@
 #ifndef MLE_CONSTANTS_HPP_
 #define MLE_CONSTANTS_HPP_
 
+#include <openthread-core-config.h>
+
 namespace Thread {
 namespace Mle {
 
@@ -58,6 +60,10 @@ enum
     kUdpPort                    = 19788, ///< MLE UDP Port
     kParentRequestRouterTimeout = 1000,  ///< Router Request timeout
     kParentRequestChildTimeout  = 2000,  ///< End Device Request timeout
+
+    ///< Shortened Parent Request timeouts used by the aggressive attach profile.
+    kFastParentRequestRouterTimeout = OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_ROUTER_TIMEOUT,
+    kFastParentRequestChildTimeout  = OPENTHREAD_CONFIG_FAST_ATTACH_PARENT_REQUEST_CHILD_TIMEOUT,
 };
 
 enum
@@ -33,11 +33,12 @@
 
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
+#include <common/flight_recorder.hpp>
 #include <common/logging.hpp>
 #include <common/encoding.hpp>
+#include <common/random.hpp>
 #include <mac/mac_frame.hpp>
 #include <net/icmp6.hpp>
-#include <platform/random.h>
 #include <thread/mle_router.hpp>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_tlvs.hpp>
@@ -52,6 +53,7 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     Mle(aThreadNetif),
     mAdvertiseTimer(aThreadNetif.GetIp6().mTimerScheduler, HandleAdvertiseTimer, NULL, this),
     mStateUpdateTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleStateUpdateTimer, this),
+    mParentResponseTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleParentResponseTimer, this),
     mSocket(aThreadNetif.GetIp6().mUdp),
     mAddressSolicit(OPENTHREAD_URI_ADDRESS_SOLICIT, &HandleAddressSolicit, this),
     mAddressRelease(OPENTHREAD_URI_ADDRESS_RELEASE, &HandleAddressRelease, this),
@@ -62,6 +64,29 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     memset(mChildren, 0, sizeof(mChildren));
     memset(mRouters, 0, sizeof(mRouters));
 
+    mAllocatedRouterIds = 0;
+    mReclaimDelayedIds = 0;
+    mAllocatedRouterCount = 0;
+
+    mAdvertiseDeferrals = 0;
+    mProbeRouterId = kMaxRouterId;
+    mProbesSent = 0;
+    mProbeAcks = 0;
+    mProbeTimeout = 0;
+    mLastProbeTime = 0;
+
+    mRouteTlvCacheTime = 0;
+    mRouteTlvCacheSequence = 0;
+    mRouteTlvCacheValid = false;
+    mStateUpdateTick = 0;
+
+    mRouterTableGeneration = 0;
+    mChildTableGeneration = 0;
+
+    memset(mChildIndexRloc16, 0xff, sizeof(mChildIndexRloc16));
+    memset(mChildIndexExtAddr, 0xff, sizeof(mChildIndexExtAddr));
+    mLastNeighbor = NULL;
+
     mNetworkIdTimeout = kNetworkIdTimeout;
     mRouterUpgradeThreshold = kRouterUpgradeThreshold;
     mRouterDowngradeThreshold = kRouterDowngradeThreshold;
@@ -74,7 +99,7 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     mRouterRoleEnabled = true;
     mRouterSelectionJitterTimeout = 0;
 
-    mCoapMessageId = static_cast<uint8_t>(otPlatRandomGet());
+    mCoapMessageId = static_cast<uint8_t>(Random::GetUint32());
 }
 
 bool MleRouter::IsRouterRoleEnabled(void) const
@@ -95,33 +120,19 @@ void MleRouter::SetRouterRoleEnabled(bool aEnabled)
 uint8_t MleRouter::AllocateRouterId(void)
 {
     uint8_t rval = kMaxRouterId;
+    uint64_t freeIds = ~(mAllocatedRouterIds | mReclaimDelayedIds) & ((1ULL << kMaxRouterId) - 1);
+    uint8_t numAvailable = CountRouterIds(freeIds);
+    uint8_t freeBit;
 
-    // count available router ids
-    uint8_t numAvailable = 0;
-    uint8_t numAllocated = 0;
-
-    for (int i = 0; i < kMaxRouterId; i++)
-    {
-        if (mRouters[i].mAllocated)
-        {
-            numAllocated++;
-        }
-        else if (mRouters[i].mReclaimDelay == false)
-        {
-            numAvailable++;
-        }
-    }
-
-    VerifyOrExit(numAllocated < kMaxRouters && numAvailable > 0, rval = kMaxRouterId);
+    VerifyOrExit(mAllocatedRouterCount < kMaxRouters && numAvailable > 0, rval = kMaxRouterId);
 
     // choose available router id at random
-    uint8_t freeBit;
-    freeBit = otPlatRandomGet() % numAvailable;
+    freeBit = Random::GetUint32() % numAvailable;
 
     // allocate router id
     for (uint8_t i = 0; i < kMaxRouterId; i++)
     {
-        if (mRouters[i].mAllocated || mRouters[i].mReclaimDelay)
+        if ((freeIds & (1ULL << i)) == 0)
         {
             continue;
         }
@@ -147,12 +158,15 @@ uint8_t MleRouter::AllocateRouterId(uint8_t aRouterId)
 
     // init router state
     mRouters[aRouterId].mAllocated = true;
+    mAllocatedRouterIds |= (1ULL << aRouterId);
+    mAllocatedRouterCount++;
     mRouters[aRouterId].mLastHeard = Timer::GetNow();
     memset(&mRouters[aRouterId].mMacAddr, 0, sizeof(mRouters[aRouterId].mMacAddr));
 
     // bump sequence number
     mRouterIdSequence++;
     mRouterIdSequenceLastUpdated = Timer::GetNow();
+    mRouterTableGeneration++;
     rval = aRouterId;
 
     otLogInfoMle("add router id %d\n", aRouterId);
@@ -164,18 +178,61 @@ exit:
 ThreadError MleRouter::ReleaseRouterId(uint8_t aRouterId)
 {
     otLogInfoMle("delete router id %d\n", aRouterId);
+
+    if (mRouters[aRouterId].mAllocated)
+    {
+        mAllocatedRouterCount--;
+    }
+
     mRouters[aRouterId].mAllocated = false;
     mRouters[aRouterId].mReclaimDelay = true;
+    mAllocatedRouterIds &= ~(1ULL << aRouterId);
+    mReclaimDelayedIds |= (1ULL << aRouterId);
     mRouters[aRouterId].mState = Neighbor::kStateInvalid;
     mRouters[aRouterId].mNextHop = kMaxRouterId;
     mRouterIdSequence++;
     mRouterIdSequenceLastUpdated = Timer::GetNow();
+    mRouterTableGeneration++;
     mAddressResolver.Remove(aRouterId);
     mNetworkData.RemoveBorderRouter(GetRloc16(aRouterId));
     ResetAdvertiseInterval();
     return kThreadError_None;
 }
 
+void MleRouter::SyncRouterIdMaps(void)
+{
+    mAllocatedRouterIds = 0;
+    mReclaimDelayedIds = 0;
+    mAllocatedRouterCount = 0;
+
+    for (uint8_t i = 0; i < kMaxRouterId; i++)
+    {
+        if (mRouters[i].mAllocated)
+        {
+            mAllocatedRouterIds |= (1ULL << i);
+            mAllocatedRouterCount++;
+        }
+
+        if (mRouters[i].mReclaimDelay)
+        {
+            mReclaimDelayedIds |= (1ULL << i);
+        }
+    }
+}
+
+uint8_t MleRouter::CountRouterIds(uint64_t aMask)
+{
+    uint8_t rval = 0;
+
+    while (aMask != 0)
+    {
+        aMask &= (aMask - 1);
+        rval++;
+    }
+
+    return rval;
+}
+
 uint32_t MleRouter::GetLeaderAge(void) const
 {
     return Timer::MsecToSec(Timer::GetNow() - mRouterIdSequenceLastUpdated);
@@ -195,8 +252,12 @@ ThreadError MleRouter::BecomeRouter(ThreadStatusTlv::Status aStatus)
         mRouters[i].mReclaimDelay = false;
         mRouters[i].mState = Neighbor::kStateInvalid;
         mRouters[i].mNextHop = kMaxRouterId;
+        mRouters[i].mRoutePenalty = 0;
     }
 
+    SyncRouterIdMaps();
+    mRouterTableGeneration++;
+
     mSocket.Open(&HandleUdpReceive, this);
     mAdvertiseTimer.Stop();
     mAddressResolver.Clear();
@@ -205,7 +266,7 @@ ThreadError MleRouter::BecomeRouter(ThreadStatusTlv::Status aStatus)
     {
     case kDeviceStateDetached:
         SuccessOrExit(error = SendLinkRequest(NULL));
-        mStateUpdateTimer.Start(kStateUpdatePeriod);
+        mStateUpdateTimer.Start(kAgingTickPeriod);
         break;
 
     case kDeviceStateChild:
@@ -236,11 +297,15 @@ ThreadError MleRouter::BecomeLeader(void)
         mRouters[i].mReclaimDelay = false;
         mRouters[i].mState = Neighbor::kStateInvalid;
         mRouters[i].mNextHop = kMaxRouterId;
+        mRouters[i].mRoutePenalty = 0;
     }
 
+    SyncRouterIdMaps();
+    mRouterTableGeneration++;
+
     mSocket.Open(&HandleUdpReceive, this);
     mAdvertiseTimer.Stop();
-    mStateUpdateTimer.Start(kStateUpdatePeriod);
+    mStateUpdateTimer.Start(kAgingTickPeriod);
     mAddressResolver.Clear();
 
     routerId = (mPreviousRouterId != kMaxRouterId) ? AllocateRouterId(mPreviousRouterId) : AllocateRouterId();
@@ -256,10 +321,10 @@ ThreadError MleRouter::BecomeLeader(void)
     }
     else
     {
-        SetLeaderData(otPlatRandomGet(), mLeaderWeight, mRouterId);
+        SetLeaderData(Random::GetUint32(), mLeaderWeight, mRouterId);
     }
 
-    mRouterIdSequence = static_cast<uint8_t>(otPlatRandomGet());
+    mRouterIdSequence = static_cast<uint8_t>(Random::GetUint32());
 
     mNetworkData.Reset();
 
@@ -291,6 +356,7 @@ ThreadError MleRouter::HandleDetachStart(void)
         mRouters[i].mState = Neighbor::kStateInvalid;
     }
 
+    mRouterTableGeneration++;
     StopLeader();
     mStateUpdateTimer.Stop();
 
@@ -302,7 +368,7 @@ ThreadError MleRouter::HandleChildStart(otMleAttachFilter aFilter)
     mRouterIdSequenceLastUpdated = Timer::GetNow();
 
     StopLeader();
-    mStateUpdateTimer.Start(kStateUpdatePeriod);
+    mStateUpdateTimer.Start(kAgingTickPeriod);
 
     switch (aFilter)
     {
@@ -335,6 +401,7 @@ ThreadError MleRouter::SetStateRouter(uint16_t aRloc16)
     if (mDeviceState != kDeviceStateRouter)
     {
         mNetif.SetStateChangedFlags(OT_NET_ROLE);
+        FlightRecorderRecord(kFlightRecorderEventRoleChange, kDeviceStateRouter, aRloc16);
     }
 
     SetRloc16(aRloc16);
@@ -345,7 +412,7 @@ ThreadError MleRouter::SetStateRouter(uint16_t aRloc16)
     mNetif.SubscribeAllRoutersMulticast();
     mRouters[mRouterId].mNextHop = mRouterId;
     mNetworkData.Stop();
-    mStateUpdateTimer.Start(kStateUpdatePeriod);
+    mStateUpdateTimer.Start(kAgingTickPeriod);
     mNetif.GetIp6().SetForwardingEnabled(true);
 
     otLogInfoMle("Mode -> Router\n");
@@ -357,6 +424,7 @@ ThreadError MleRouter::SetStateLeader(uint16_t aRloc16)
     if (mDeviceState != kDeviceStateLeader)
     {
         mNetif.SetStateChangedFlags(OT_NET_ROLE);
+        FlightRecorderRecord(kFlightRecorderEventRoleChange, kDeviceStateLeader, aRloc16);
     }
 
     SetRloc16(aRloc16);
@@ -422,6 +490,25 @@ bool MleRouter::HandleAdvertiseTimer(void)
         return false;
     }
 
+    // let queued data drain first: postpone the advertisement while the forwarder send
+    // queue sits above the watermark, but never more than twice in a row so the emission
+    // stays within the interval's allowed jitter
+    if (mMesh.GetSendQueueDepth() >= kAdvertiseDeferQueueDepth &&
+        mAdvertiseDeferrals < kAdvertiseMaxDeferrals)
+    {
+        mAdvertiseDeferrals++;
+        return true;
+    }
+
+    // skip every other advertisement while the CPU governor is dampening
+    if (GetGovernorLevel() >= kCpuGovernorLevelDampenAdvertisements &&
+        mAdvertiseDeferrals == 0)
+    {
+        mAdvertiseDeferrals++;
+        return true;
+    }
+
+    mAdvertiseDeferrals = 0;
     SendAdvertisement();
 
     return true;
@@ -432,6 +519,9 @@ void MleRouter::ResetAdvertiseInterval(void)
     assert(GetDeviceState() == kDeviceStateRouter ||
            GetDeviceState() == kDeviceStateLeader);
 
+    // route information changed; rebuild the Route TLV on the next advertisement
+    mRouteTlvCacheValid = false;
+
     if (!mAdvertiseTimer.IsRunning())
     {
         mAdvertiseTimer.Start(
@@ -528,10 +618,7 @@ ThreadError MleRouter::SendLinkRequest(Neighbor *aNeighbor)
 
     if (aNeighbor == NULL)
     {
-        for (uint8_t i = 0; i < sizeof(mChallenge); i++)
-        {
-            mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-        }
+        Random::FillBuffer(mChallenge, sizeof(mChallenge));
 
         SuccessOrExit(error = AppendChallenge(*message, mChallenge, sizeof(mChallenge)));
         destination.mFields.m8[0] = 0xff;
@@ -540,10 +627,7 @@ ThreadError MleRouter::SendLinkRequest(Neighbor *aNeighbor)
     }
     else
     {
-        for (uint8_t i = 0; i < sizeof(aNeighbor->mPending.mChallenge); i++)
-        {
-            aNeighbor->mPending.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-        }
+        Random::FillBuffer(aNeighbor->mPending.mChallenge, sizeof(aNeighbor->mPending.mChallenge));
 
         SuccessOrExit(error = AppendChallenge(*message, mChallenge, sizeof(mChallenge)));
         destination.mFields.m16[0] = HostSwap16(0xfe80);
@@ -628,6 +712,7 @@ ThreadError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::Mes
                 neighbor->mLinkInfo.Clear();
                 neighbor->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
                 neighbor->mState = Neighbor::kStateLinkRequest;
+                mRouterTableGeneration++;
             }
             else
             {
@@ -724,15 +809,13 @@ ThreadError MleRouter::SendLinkAccept(const Ip6::MessageInfo &aMessageInfo, Neig
 
     if (aNeighbor != NULL && aNeighbor->mState != Neighbor::kStateValid)
     {
-        for (uint8_t i = 0; i < sizeof(aNeighbor->mPending.mChallenge); i++)
-        {
-            aNeighbor->mPending.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-        }
+        Random::FillBuffer(aNeighbor->mPending.mChallenge, sizeof(aNeighbor->mPending.mChallenge));
 
         SuccessOrExit(error = AppendChallenge(*message, aNeighbor->mPending.mChallenge,
                                               sizeof(aNeighbor->mPending.mChallenge)));
         SuccessOrExit(error = AppendTlvRequest(*message, routerTlvs, sizeof(routerTlvs)));
         aNeighbor->mState = Neighbor::kStateLinkRequest;
+        mRouterTableGeneration++;
     }
 
     SuccessOrExit(error = SendMessage(*message, aMessageInfo.GetPeerAddr()));
@@ -901,6 +984,7 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
         if (routerId != mRouterId && mRouters[routerId].mNextHop == kMaxRouterId)
         {
             mRouters[routerId].mNextHop = routerId;
+            mRouterTableGeneration++;
             ResetAdvertiseInterval();
         }
 
@@ -910,7 +994,7 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     // finish link synchronization
     memcpy(&neighbor->mMacAddr, &macAddr, sizeof(neighbor->mMacAddr));
     neighbor->mValid.mRloc16 = sourceAddress.GetRloc16();
-    neighbor->mValid.mLinkFrameCounter = linkFrameCounter.GetFrameCounter();
+    neighbor->ResetLinkFrameCounter(linkFrameCounter.GetFrameCounter());
     neighbor->mValid.mMleFrameCounter = mleFrameCounter.GetFrameCounter();
     neighbor->mLastHeard = Timer::GetNow();
     neighbor->mMode = ModeTlv::kModeFFD | ModeTlv::kModeRxOnWhenIdle | ModeTlv::kModeFullNetworkData;
@@ -918,6 +1002,7 @@ ThreadError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::Mess
     neighbor->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
     neighbor->mState = Neighbor::kStateValid;
     neighbor->mKeySequence = aKeySequence;
+    mRouterTableGeneration++;
 
     if (aRequest)
     {
@@ -979,6 +1064,151 @@ ThreadError MleRouter::HandleLinkReject(const Message &aMessage, const Ip6::Mess
     return kThreadError_None;
 }
 
+ThreadError MleRouter::SendLinkProbes(uint8_t aRouterId, uint8_t aCount)
+{
+    ThreadError error = kThreadError_None;
+    Ip6::Address destination;
+    Message *message = NULL;
+
+    VerifyOrExit(aRouterId < kMaxRouterId && mRouters[aRouterId].mState == Neighbor::kStateValid,
+                 error = kThreadError_InvalidArgs);
+    VerifyOrExit(mProbeRouterId == kMaxRouterId, error = kThreadError_Busy);
+
+    if (aCount == 0)
+    {
+        aCount = kLinkProbeBurst;
+    }
+
+    memset(&destination, 0, sizeof(destination));
+    destination.mFields.m16[0] = HostSwap16(0xfe80);
+    destination.SetIid(mRouters[aRouterId].mMacAddr);
+
+    mProbeRouterId = aRouterId;
+    mProbesSent = 0;
+    mProbeAcks = 0;
+    mProbeTimeout = kLinkProbeTimeoutTicks;
+    mLastProbeTime = Timer::GetNow();
+
+    for (uint8_t i = 0; i < aCount; i++)
+    {
+        VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+        message->SetLinkSecurityEnabled(false);
+        SuccessOrExit(error = AppendHeader(*message, Header::kCommandLinkProbe));
+        SuccessOrExit(error = AppendVersion(*message));
+        SuccessOrExit(error = AppendSourceAddress(*message));
+        SuccessOrExit(error = SendMessage(*message, destination));
+        message = NULL;
+        mProbesSent++;
+    }
+
+    otLogInfoMle("Sent link probes\n");
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError MleRouter::HandleLinkProbe(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    Mac::ExtAddress macAddr;
+    Neighbor *neighbor;
+
+    (void)aMessage;
+
+    otLogInfoMle("Received link probe\n");
+
+    macAddr.Set(aMessageInfo.GetPeerAddr());
+    VerifyOrExit((neighbor = GetNeighbor(macAddr)) != NULL && neighbor->mState == Neighbor::kStateValid,
+                 error = kThreadError_Drop);
+
+    error = SendLinkProbeAck(aMessageInfo);
+
+exit:
+    return error;
+}
+
+ThreadError MleRouter::SendLinkProbeAck(const Ip6::MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    const ThreadMessageInfo *threadMessageInfo = reinterpret_cast<const ThreadMessageInfo *>(aMessageInfo.mLinkInfo);
+    Message *message;
+    uint8_t linkMargin;
+
+    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    message->SetLinkSecurityEnabled(false);
+    SuccessOrExit(error = AppendHeader(*message, Header::kCommandLinkProbeAck));
+    SuccessOrExit(error = AppendVersion(*message));
+    SuccessOrExit(error = AppendSourceAddress(*message));
+
+    // report how this probe was heard, mirroring the Link Accept exchange
+    linkMargin = LinkQualityInfo::ConvertRssToLinkMargin(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
+    SuccessOrExit(error = AppendLinkMargin(*message, linkMargin));
+
+    SuccessOrExit(error = SendMessage(*message, aMessageInfo.GetPeerAddr()));
+
+    otLogInfoMle("Sent link probe ack\n");
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
+ThreadError MleRouter::HandleLinkProbeAck(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+{
+    ThreadError error = kThreadError_None;
+    Mac::ExtAddress macAddr;
+    Neighbor *neighbor;
+    LinkMarginTlv linkMargin;
+    uint8_t routerId;
+
+    otLogInfoMle("Received link probe ack\n");
+
+    macAddr.Set(aMessageInfo.GetPeerAddr());
+    VerifyOrExit((neighbor = GetNeighbor(macAddr)) != NULL && neighbor->mState == Neighbor::kStateValid &&
+                 IsActiveRouter(neighbor->mValid.mRloc16), error = kThreadError_Drop);
+
+    SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kLinkMargin, sizeof(linkMargin), linkMargin));
+    VerifyOrExit(linkMargin.IsValid(), error = kThreadError_Parse);
+
+    routerId = GetRouterId(neighbor->mValid.mRloc16);
+    mRouters[routerId].mLinkQualityOut =
+        LinkQualityInfo::ConvertLinkMarginToLinkQuality(linkMargin.GetLinkMargin());
+
+    if (routerId == mProbeRouterId)
+    {
+        mProbeAcks++;
+    }
+
+exit:
+    return error;
+}
+
+void MleRouter::FinalizeLinkProbe(void)
+{
+    Router &router = mRouters[mProbeRouterId];
+
+    // heavy probe loss degrades the outgoing link quality immediately so route costs
+    // react now rather than after several advertisement intervals
+    if (router.mState == Neighbor::kStateValid && mProbesSent > 0 &&
+        mProbeAcks < static_cast<uint8_t>((mProbesSent + 1) / 2) && router.mLinkQualityOut > 1)
+    {
+        router.mLinkQualityOut--;
+    }
+
+    mProbeRouterId = kMaxRouterId;
+}
+
 Child *MleRouter::NewChild(void)
 {
     for (int i = 0; i < mMaxChildrenAllowed; i++)
@@ -1092,13 +1322,20 @@ ThreadError MleRouter::ProcessRouteTlv(const RouteTlv &aRoute)
             old = mRouters[i].mAllocated;
             mRouters[i].mAllocated = aRoute.IsRouterIdSet(i);
 
-            if (old && !mRouters[i].mAllocated)
+            if (old != mRouters[i].mAllocated)
             {
-                mRouters[i].mNextHop = kMaxRouterId;
-                mAddressResolver.Remove(i);
+                mRouterTableGeneration++;
+
+                if (old)
+                {
+                    mRouters[i].mNextHop = kMaxRouterId;
+                    mAddressResolver.Remove(i);
+                }
             }
         }
 
+        SyncRouterIdMaps();
+
         if (GetDeviceState() == kDeviceStateRouter && !mRouters[mRouterId].mAllocated)
         {
             BecomeDetached();
@@ -1204,11 +1441,13 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
     SourceAddressTlv sourceAddress;
     LeaderDataTlv leaderData;
     RouteTlv route;
+    uint64_t leaderDataWord;
     uint32_t partitionId;
     Router *router;
     Neighbor *neighbor;
     uint8_t routerId;
     uint8_t routerCount;
+    uint8_t nextHop;
 
     macAddr.Set(aMessageInfo.GetPeerAddr());
 
@@ -1231,47 +1470,55 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
     SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kRoute, sizeof(route), route));
     VerifyOrExit(route.IsValid(), error = kThreadError_Parse);
 
-    partitionId = leaderData.GetPartitionId();
+    // fast path: an advertisement whose Leader Data value matches the local packed word carries
+    // no partition, weighting, version, or leader change, so the field compares can be skipped
+    memcpy(&leaderDataWord, reinterpret_cast<const uint8_t *>(&leaderData) + sizeof(Tlv), sizeof(leaderDataWord));
 
-    if (partitionId != mLeaderData.GetPartitionId())
+    if (leaderDataWord != GetLeaderDataWord())
     {
-        otLogDebgMle("different partition! %d %d %d %d\n",
-                     leaderData.GetWeighting(), partitionId,
-                     mLeaderData.GetWeighting(), mLeaderData.GetPartitionId());
+        partitionId = leaderData.GetPartitionId();
 
-        if (GetDeviceState() == kDeviceStateChild &&
-            memcmp(&mParent.mMacAddr, &macAddr, sizeof(mParent.mMacAddr)) == 0)
+        if (partitionId != mLeaderData.GetPartitionId())
         {
-            ExitNow();
-        }
+            otLogDebgMle("different partition! %d %d %d %d\n",
+                         leaderData.GetWeighting(), partitionId,
+                         mLeaderData.GetWeighting(), mLeaderData.GetPartitionId());
 
-        routerCount = 0;
+            if (GetDeviceState() == kDeviceStateChild &&
+                memcmp(&mParent.mMacAddr, &macAddr, sizeof(mParent.mMacAddr)) == 0)
+            {
+                ExitNow();
+            }
 
-        for (uint8_t i = 0; i < kMaxRouterId; i++)
-        {
-            if (route.IsRouterIdSet(i))
+            routerCount = 0;
+
+            for (uint8_t i = 0; i < kMaxRouterId; i++)
             {
-                routerCount++;
+                if (route.IsRouterIdSet(i))
+                {
+                    routerCount++;
+                }
             }
-        }
 
-        if (ComparePartitions(routerCount <= 1, leaderData, IsSingleton(), mLeaderData) > 0)
-        {
-            otLogDebgMle("trying to migrate\n");
-            BecomeChild(kMleAttachBetterPartition);
+            if (ComparePartitions(routerCount <= 1, leaderData, IsSingleton(), mLeaderData) > 0)
+            {
+                otLogDebgMle("trying to migrate\n");
+                BecomeChild(kMleAttachBetterPartition);
+            }
+
+            ExitNow(error = kThreadError_Drop);
         }
 
-        ExitNow(error = kThreadError_Drop);
-    }
-    else if (leaderData.GetLeaderRouterId() != GetLeaderId())
-    {
-        if (GetDeviceState() != kDeviceStateChild)
+        if (leaderData.GetLeaderRouterId() != GetLeaderId())
         {
-            BecomeDetached();
-            error = kThreadError_Drop;
-        }
+            if (GetDeviceState() != kDeviceStateChild)
+            {
+                BecomeDetached();
+                error = kThreadError_Drop;
+            }
 
-        ExitNow();
+            ExitNow();
+        }
     }
 
     VerifyOrExit(IsActiveRouter(sourceAddress.GetRloc16()), ;);
@@ -1323,13 +1570,12 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
                         continue;
                     }
 
-                    if (route.GetRouteCost(routeCount) > 0)
-                    {
-                        mRouters[GetLeaderId()].mNextHop = routerId;
-                    }
-                    else
+                    nextHop = (route.GetRouteCost(routeCount) > 0) ? routerId : static_cast<uint8_t>(kMaxRouterId);
+
+                    if (mRouters[GetLeaderId()].mNextHop != nextHop)
                     {
-                        mRouters[GetLeaderId()].mNextHop = kMaxRouterId;
+                        mRouters[GetLeaderId()].mNextHop = nextHop;
+                        mRouterTableGeneration++;
                     }
 
                     break;
@@ -1346,6 +1592,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
                 router->mLinkInfo.Clear();
                 router->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
                 router->mState = Neighbor::kStateLinkRequest;
+                mRouterTableGeneration++;
                 SendLinkRequest(router);
                 ExitNow(error = kThreadError_NoRoute);
             }
@@ -1373,7 +1620,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
             HasSmallNumberOfChildren() &&
             HasOneNeighborwithComparableConnectivity(route, routerId))
         {
-            mRouterSelectionJitterTimeout = otPlatRandomGet() % kRouterSelectionJitter;
+            mRouterSelectionJitterTimeout = Random::GetUint32() % kRouterSelectionJitter;
         }
 
     // fall through
@@ -1395,6 +1642,7 @@ ThreadError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::M
             router->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
             router->mState = Neighbor::kStateLinkRequest;
             router->mDataRequest = false;
+            mRouterTableGeneration++;
             SendLinkRequest(router);
             ExitNow(error = kThreadError_NoRoute);
         }
@@ -1415,109 +1663,161 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 {
     uint8_t curCost;
     uint8_t newCost;
-    uint8_t oldNextHop;
     uint8_t cost;
     uint8_t lqi;
-    bool update;
+    uint8_t linkCost;
 
-    // update routes
-    do
+    // Settle the link cost to the sender first: the sender's view of our link quality
+    // determines GetLinkCost(aRouterId), which every dependent route cost below uses.
+    // Once it is fixed, each route entry's decision depends only on that entry, so a
+    // single pass replaces the previous walk-until-fixpoint over all kMaxRouterId slots.
+    for (uint8_t i = 0, routeCount = 0; i < kMaxRouterId; i++)
     {
-        update = false;
+        if (aRoute.IsRouterIdSet(i) == false)
+        {
+            continue;
+        }
 
-        for (uint8_t i = 0, routeCount = 0; i < kMaxRouterId; i++)
+        if (i == mRouterId)
         {
-            if (aRoute.IsRouterIdSet(i) == false)
+            if (mRouters[i].mAllocated)
             {
-                continue;
+                lqi = aRoute.GetLinkQualityIn(routeCount);
+
+                if (mRouters[aRouterId].mLinkQualityOut != lqi)
+                {
+                    mRouters[aRouterId].mLinkQualityOut = lqi;
+                    mRouterTableGeneration++;
+
+                    // the advertised Route TLV carries this value
+                    mRouteTlvCacheValid = false;
+                }
             }
 
-            if (mRouters[i].mAllocated == false)
+            break;
+        }
+
+        routeCount++;
+    }
+
+    linkCost = GetLinkCost(aRouterId);
+
+    // update routes
+    for (uint8_t i = 0, routeCount = 0; i < kMaxRouterId; i++)
+    {
+        if (aRoute.IsRouterIdSet(i) == false)
+        {
+            continue;
+        }
+
+        if (mRouters[i].mAllocated == false || i == mRouterId)
+        {
+            routeCount++;
+            continue;
+        }
+
+        if (i == aRouterId)
+        {
+            cost = 0;
+        }
+        else
+        {
+            cost = aRoute.GetRouteCost(routeCount);
+
+            if (cost == 0)
             {
-                routeCount++;
-                continue;
+                cost = kMaxRouteCost;
             }
+        }
 
-            if (i == mRouterId)
-            {
-                lqi = aRoute.GetLinkQualityIn(routeCount);
+        if (mRouters[i].mNextHop == kMaxRouterId || mRouters[i].mNextHop == aRouterId)
+        {
+            // route has no nexthop or nexthop is neighbor
+            newCost = cost + linkCost;
 
-                if (mRouters[aRouterId].mLinkQualityOut != lqi)
+            if (i == aRouterId)
+            {
+                if (mRouters[i].mNextHop == kMaxRouterId && !SuppressRouteChange(i))
                 {
-                    mRouters[aRouterId].mLinkQualityOut = lqi;
-                    update = true;
+                    ResetAdvertiseInterval();
+                    mRouters[i].mNextHop = aRouterId;
+                    mRouters[i].mCost = 0;
+                    mRouterTableGeneration++;
                 }
             }
-            else
+            else if (newCost <= kMaxRouteCost)
             {
-                oldNextHop = mRouters[i].mNextHop;
-
-                if (i == aRouterId)
+                if (mRouters[i].mNextHop == kMaxRouterId)
                 {
-                    cost = 0;
+                    if (!SuppressRouteChange(i))
+                    {
+                        ResetAdvertiseInterval();
+                        mRouters[i].mNextHop = aRouterId;
+                        mRouters[i].mCost = cost;
+                        mRouterTableGeneration++;
+                    }
                 }
                 else
                 {
-                    cost = aRoute.GetRouteCost(routeCount);
-
-                    if (cost == 0)
+                    // same next hop; a cost refresh is not a topology change
+                    if (mRouters[i].mCost != cost)
                     {
-                        cost = kMaxRouteCost;
+                        mRouters[i].mCost = cost;
+                        mRouterTableGeneration++;
                     }
                 }
+            }
+            else if (mRouters[i].mNextHop != kMaxRouterId)
+            {
+                // route loss is applied even when dampened, but still accrues penalty
+                RecordRouteFlap(i);
+                ResetAdvertiseInterval();
+                mRouters[i].mNextHop = kMaxRouterId;
+                mRouters[i].mCost = 0;
+                mRouters[i].mLastHeard = Timer::GetNow();
+                mRouterTableGeneration++;
+            }
+        }
+        else
+        {
+            curCost = mRouters[i].mCost + GetLinkCost(mRouters[i].mNextHop);
+            newCost = cost + linkCost;
 
-                if (mRouters[i].mNextHop == kMaxRouterId || mRouters[i].mNextHop == aRouterId)
+            if (newCost < curCost || (newCost == curCost && i == aRouterId))
+            {
+                if (i == aRouterId)
                 {
-                    // route has no nexthop or nexthop is neighbor
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (i == aRouterId)
+                    if (!SuppressRouteChange(i))
                     {
-                        if (mRouters[i].mNextHop == kMaxRouterId)
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
                         mRouters[i].mNextHop = aRouterId;
                         mRouters[i].mCost = 0;
+                        mRouterTableGeneration++;
                     }
-                    else if (newCost <= kMaxRouteCost)
+                }
+                else if (newCost <= kMaxRouteCost)
+                {
+                    if (!SuppressRouteChange(i))
                     {
-                        if (mRouters[i].mNextHop == kMaxRouterId)
-                        {
-                            ResetAdvertiseInterval();
-                        }
-
                         mRouters[i].mNextHop = aRouterId;
                         mRouters[i].mCost = cost;
-                    }
-                    else if (mRouters[i].mNextHop != kMaxRouterId)
-                    {
-                        ResetAdvertiseInterval();
-                        mRouters[i].mNextHop = kMaxRouterId;
-                        mRouters[i].mCost = 0;
-                        mRouters[i].mLastHeard = Timer::GetNow();
+                        mRouterTableGeneration++;
                     }
                 }
                 else
                 {
-                    curCost = mRouters[i].mCost + GetLinkCost(mRouters[i].mNextHop);
-                    newCost = cost + GetLinkCost(aRouterId);
-
-                    if (newCost < curCost || (newCost == curCost && i == aRouterId))
-                    {
-                        mRouters[i].mNextHop = aRouterId;
-                        mRouters[i].mCost = cost;
-                    }
+                    // better than the current route but still unusable
+                    RecordRouteFlap(i);
+                    ResetAdvertiseInterval();
+                    mRouters[i].mNextHop = kMaxRouterId;
+                    mRouters[i].mCost = 0;
+                    mRouters[i].mLastHeard = Timer::GetNow();
+                    mRouterTableGeneration++;
                 }
-
-                update |= mRouters[i].mNextHop != oldNextHop;
             }
-
-            routeCount++;
         }
+
+        routeCount++;
     }
-    while (update);
 
 #if 1
 
@@ -1536,6 +1836,31 @@ void MleRouter::UpdateRoutes(const RouteTlv &aRoute, uint8_t aRouterId)
 #endif
 }
 
+void MleRouter::RecordRouteFlap(uint8_t aRouterId)
+{
+    uint8_t penalty = mRouters[aRouterId].mRoutePenalty;
+
+    mRouters[aRouterId].mRoutePenalty =
+        (penalty > kRoutePenaltyMax - kRoutePenaltyFlap) ? kRoutePenaltyMax : penalty + kRoutePenaltyFlap;
+}
+
+bool MleRouter::SuppressRouteChange(uint8_t aRouterId)
+{
+    // a suppressed change attempt still accrues penalty, so a destination that keeps
+    // trying to move stays suppressed until its inputs settle
+    bool suppress = mRouters[aRouterId].mRoutePenalty >= kRoutePenaltySuppress;
+
+    RecordRouteFlap(aRouterId);
+
+    if (suppress)
+    {
+        otLogDebgMle("suppressed route change for %x (penalty %d)\n", GetRloc16(aRouterId),
+                     mRouters[aRouterId].mRoutePenalty);
+    }
+
+    return suppress;
+}
+
 ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
 {
     ThreadError error = kThreadError_None;
@@ -1545,6 +1870,7 @@ ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::M
     ScanMaskTlv scanMask;
     ChallengeTlv challenge;
     Child *child;
+    uint32_t delay;
 
     otLogInfoMle("Received parent request\n");
 
@@ -1600,10 +1926,34 @@ ThreadError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::M
     child->mLinkInfo.Clear();
     child->mLinkInfo.AddRss(mMac.GetNoiseFloor(), threadMessageInfo->mRss);
     child->mState = Neighbor::kStateParentRequest;
+    mChildTableGeneration++;
     child->mDataRequest = false;
 
     child->mTimeout = Timer::SecToMsec(2 * kParentRequestChildTimeout);
-    SuccessOrExit(error = SendParentResponse(child, challenge));
+
+    memcpy(child->mRequestChallenge, challenge.GetChallenge(), challenge.GetLength());
+    child->mRequestChallengeLength = challenge.GetLength();
+
+    // spread responses over a load-weighted jitter window so a mass reattach does
+    // not exhaust the message pool with simultaneous child exchanges
+    delay = Random::GetUint32() % GetParentResponseWindow();
+
+    if (delay == 0)
+    {
+        SuccessOrExit(error = SendParentResponse(child));
+    }
+    else
+    {
+        child->mParentResponsePending = true;
+        child->mParentResponseTime = Timer::GetNow() + delay;
+
+        if (!mParentResponseTimer.IsRunning() ||
+            static_cast<int32_t>((mParentResponseTimer.Gett0() + mParentResponseTimer.Getdt()) -
+                                 child->mParentResponseTime) > 0)
+        {
+            mParentResponseTimer.Start(delay);
+        }
+    }
 
 exit:
     return error;
@@ -1617,72 +1967,150 @@ void MleRouter::HandleStateUpdateTimer(void *aContext)
 
 void MleRouter::HandleStateUpdateTimer(void)
 {
-    switch (GetDeviceState())
-    {
-    case kDeviceStateDisabled:
-        assert(false);
-        break;
+    uint8_t start;
+    uint8_t end;
 
-    case kDeviceStateDetached:
-        SetStateDetached();
-        BecomeChild(kMleAttachAnyPartition);
-        ExitNow();
+    // The timer ticks kAgingTicksPerPeriod times per state update period. The per-second
+    // state machine work runs on the period boundary, while neighbor aging below processes
+    // one slice of the child and router tables per tick so that the full sweep no longer
+    // bursts into a single tick.
 
-    case kDeviceStateChild:
-    case kDeviceStateRouter:
-        // verify path to leader
-        otLogDebgMle("network id timeout = %d\n", GetLeaderAge());
+    mStateUpdateTick++;
 
-        if (GetLeaderAge() >= mNetworkIdTimeout)
-        {
-            BecomeChild(kMleAttachSamePartition);
-        }
+    if (mStateUpdateTick >= kAgingTicksPerPeriod)
+    {
+        mStateUpdateTick = 0;
+    }
 
-        if (mRouterSelectionJitterTimeout > 0)
+    if (mStateUpdateTick == 0)
+    {
+        switch (GetDeviceState())
         {
-            mRouterSelectionJitterTimeout--;
+        case kDeviceStateDisabled:
+            assert(false);
+            break;
+
+        case kDeviceStateDetached:
+            SetStateDetached();
+            BecomeChild(kMleAttachAnyPartition);
+            ExitNow();
 
-            if (mRouterSelectionJitterTimeout == 0 &&
-                GetActiveRouterCount() > mRouterDowngradeThreshold)
+        case kDeviceStateChild:
+        case kDeviceStateRouter:
+            // verify path to leader
+            otLogDebgMle("network id timeout = %d\n", GetLeaderAge());
+
+            if (GetLeaderAge() >= mNetworkIdTimeout)
             {
-                // downgrade to REED
                 BecomeChild(kMleAttachSamePartition);
             }
-        }
 
-        break;
+            if (mRouterSelectionJitterTimeout > 0)
+            {
+                mRouterSelectionJitterTimeout--;
 
-    case kDeviceStateLeader:
+                if (mRouterSelectionJitterTimeout == 0 &&
+                    GetActiveRouterCount() > mRouterDowngradeThreshold)
+                {
+                    // downgrade to REED
+                    BecomeChild(kMleAttachSamePartition);
+                }
+            }
 
-        // update router id sequence
-        if (GetLeaderAge() >= kRouterIdSequencePeriod)
-        {
-            mRouterIdSequence++;
-            mRouterIdSequenceLastUpdated = Timer::GetNow();
-        }
+            break;
 
-        break;
+        case kDeviceStateLeader:
+
+            // update router id sequence
+            if (GetLeaderAge() >= kRouterIdSequencePeriod)
+            {
+                mRouterIdSequence++;
+                mRouterIdSequenceLastUpdated = Timer::GetNow();
+            }
+
+            break;
+        }
     }
 
     // update children state
-    for (int i = 0; i < mMaxChildrenAllowed; i++)
+    start = static_cast<uint8_t>((mStateUpdateTick * mMaxChildrenAllowed) / kAgingTicksPerPeriod);
+    end = static_cast<uint8_t>(((mStateUpdateTick + 1) * mMaxChildrenAllowed) / kAgingTicksPerPeriod);
+
+    for (int i = start; i < end; i++)
     {
+        uint32_t age;
+        uint32_t timeout;
+
         if (mChildren[i].mState == Neighbor::kStateInvalid)
         {
-            continue;
+            continue;
+        }
+
+        age = Timer::GetNow() - mChildren[i].mLastHeard;
+        timeout = Timer::SecToMsec(mChildren[i].mTimeout);
+
+        if (age >= timeout)
+        {
+            RemoveNeighbor(mChildren[i]);
+        }
+        else if (mChildren[i].mTimeout > kChildTimeoutProbeGrace &&
+                 age >= timeout - Timer::SecToMsec(kChildTimeoutProbeGrace))
+        {
+            // probe a quiet rx-on child before expiring it; any secured MLE message it
+            // sends back refreshes mLastHeard, so only confirmed silence expires the entry
+            if (mChildren[i].mState == Neighbor::kStateValid &&
+                (mChildren[i].mMode & ModeTlv::kModeRxOnWhenIdle) != 0 &&
+                !mChildren[i].mTimeoutProbeSent)
+            {
+                mChildren[i].mTimeoutProbeSent = true;
+                SendChildUpdateRequest(mChildren[i]);
+            }
+        }
+        else
+        {
+            mChildren[i].mTimeoutProbeSent = false;
         }
+    }
+
+    // finalize any outstanding link probe burst
+    if (mProbeRouterId != kMaxRouterId && mProbeTimeout > 0)
+    {
+        mProbeTimeout--;
 
-        if ((Timer::GetNow() - mChildren[i].mLastHeard) >= Timer::SecToMsec(mChildren[i].mTimeout))
+        if (mProbeTimeout == 0)
         {
-            RemoveNeighbor(mChildren[i]);
+            FinalizeLinkProbe();
         }
     }
 
     // update router state
-    for (uint8_t i = 0; i < kMaxRouterId; i++)
+    start = static_cast<uint8_t>((mStateUpdateTick * kMaxRouterId) / kAgingTicksPerPeriod);
+    end = static_cast<uint8_t>(((mStateUpdateTick + 1) * kMaxRouterId) / kAgingTicksPerPeriod);
+
+    for (uint8_t i = start; i < end; i++)
     {
+        // decay the route dampening penalty
+        if (mRouters[i].mRoutePenalty > kRoutePenaltyDecay)
+        {
+            mRouters[i].mRoutePenalty -= kRoutePenaltyDecay;
+        }
+        else
+        {
+            mRouters[i].mRoutePenalty = 0;
+        }
+
         if (mRouters[i].mState != Neighbor::kStateInvalid)
         {
+            // a spike in transmit failures toward a router suggests its cost input is
+            // stale; probe the link actively rather than waiting for advertisements
+            if ((GetDeviceState() == kDeviceStateRouter || GetDeviceState() == kDeviceStateLeader) &&
+                mRouters[i].mTxFailRate >= kLinkProbeFailRate &&
+                mProbeRouterId == kMaxRouterId &&
+                (Timer::GetNow() - mLastProbeTime) >= Timer::SecToMsec(kLinkProbeCooldown))
+            {
+                SendLinkProbes(i, 0);
+            }
+
             if ((Timer::GetNow() - mRouters[i].mLastHeard) >= Timer::SecToMsec(kMaxNeighborAge))
             {
                 mRouters[i].mState = Neighbor::kStateInvalid;
@@ -1690,6 +2118,7 @@ void MleRouter::HandleStateUpdateTimer(void)
                 mRouters[i].mNextHop = kMaxRouterId;
                 mRouters[i].mLinkQualityOut = 0;
                 mRouters[i].mLastHeard = Timer::GetNow();
+                mRouterTableGeneration++;
             }
         }
 
@@ -1709,18 +2138,19 @@ void MleRouter::HandleStateUpdateTimer(void)
                     Timer::SecToMsec((kMaxLeaderToRouterTimeout + kRouterIdReuseDelay)))
                 {
                     mRouters[i].mReclaimDelay = false;
+                    mReclaimDelayedIds &= ~(1ULL << i);
                 }
             }
         }
     }
 
-    mStateUpdateTimer.Start(kStateUpdatePeriod);
+    mStateUpdateTimer.Start(kAgingTickPeriod);
 
 exit:
     {}
 }
 
-ThreadError MleRouter::SendParentResponse(Child *aChild, const ChallengeTlv &challenge)
+ThreadError MleRouter::SendParentResponse(Child *aChild)
 {
     ThreadError error = kThreadError_None;
     Ip6::Address destination;
@@ -1733,12 +2163,9 @@ ThreadError MleRouter::SendParentResponse(Child *aChild, const ChallengeTlv &cha
     SuccessOrExit(error = AppendLeaderData(*message));
     SuccessOrExit(error = AppendLinkFrameCounter(*message));
     SuccessOrExit(error = AppendMleFrameCounter(*message));
-    SuccessOrExit(error = AppendResponse(*message, challenge.GetChallenge(), challenge.GetLength()));
+    SuccessOrExit(error = AppendResponse(*message, aChild->mRequestChallenge, aChild->mRequestChallengeLength));
 
-    for (uint8_t i = 0; i < sizeof(aChild->mPending.mChallenge); i++)
-    {
-        aChild->mPending.mChallenge[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(aChild->mPending.mChallenge, sizeof(aChild->mPending.mChallenge));
 
     SuccessOrExit(error = AppendChallenge(*message, aChild->mPending.mChallenge, sizeof(aChild->mPending.mChallenge)));
 
@@ -1773,6 +2200,73 @@ exit:
     return kThreadError_None;
 }
 
+uint32_t MleRouter::GetParentResponseWindow(void)
+{
+    uint32_t window = kParentResponseBaseWindow;
+
+    for (int i = 0; i < mMaxChildrenAllowed; i++)
+    {
+        if (mChildren[i].mState == Neighbor::kStateParentRequest ||
+            mChildren[i].mState == Neighbor::kStateChildIdRequest)
+        {
+            window += kParentResponseChildWindow;
+        }
+    }
+
+    if (mNetif.GetIp6().mMessagePool.IsCongested())
+    {
+        window += kParentResponseCongestedWindow;
+    }
+
+    if (window > kParentResponseMaxWindow)
+    {
+        window = kParentResponseMaxWindow;
+    }
+
+    return window;
+}
+
+void MleRouter::HandleParentResponseTimer(void *aContext)
+{
+    MleRouter *obj = reinterpret_cast<MleRouter *>(aContext);
+    obj->HandleParentResponseTimer();
+}
+
+void MleRouter::HandleParentResponseTimer(void)
+{
+    uint32_t now = Timer::GetNow();
+    uint32_t nextDelta = 0;
+
+    for (int i = 0; i < mMaxChildrenAllowed; i++)
+    {
+        if (!mChildren[i].mParentResponsePending)
+        {
+            continue;
+        }
+
+        if (mChildren[i].mState != Neighbor::kStateParentRequest)
+        {
+            mChildren[i].mParentResponsePending = false;
+            continue;
+        }
+
+        if (static_cast<int32_t>(mChildren[i].mParentResponseTime - now) <= 0)
+        {
+            mChildren[i].mParentResponsePending = false;
+            SendParentResponse(&mChildren[i]);
+        }
+        else if (nextDelta == 0 || (mChildren[i].mParentResponseTime - now) < nextDelta)
+        {
+            nextDelta = mChildren[i].mParentResponseTime - now;
+        }
+    }
+
+    if (nextDelta != 0)
+    {
+        mParentResponseTimer.Start(nextDelta);
+    }
+}
+
 ThreadError MleRouter::UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild)
 {
     const AddressRegistrationEntry *entry;
@@ -1899,8 +2393,9 @@ ThreadError MleRouter::HandleChildIdRequest(const Message &aMessage, const Ip6::
     }
 
     child->mState = Neighbor::kStateChildIdRequest;
+    mChildTableGeneration++;
     child->mLastHeard = Timer::GetNow();
-    child->mValid.mLinkFrameCounter = linkFrameCounter.GetFrameCounter();
+    child->ResetLinkFrameCounter(linkFrameCounter.GetFrameCounter());
     child->mValid.mMleFrameCounter = mleFrameCounter.GetFrameCounter();
     child->mKeySequence = aKeySequence;
     child->mMode = mode.GetMode();
@@ -1990,7 +2485,13 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
     // Mode
     SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kMode, sizeof(mode), mode));
     VerifyOrExit(mode.IsValid(), error = kThreadError_Parse);
-    child->mMode = mode.GetMode();
+
+    if (child->mMode != mode.GetMode())
+    {
+        child->mMode = mode.GetMode();
+        mChildTableGeneration++;
+    }
+
     tlvs[tlvslength++] = Tlv::kMode;
 
     // Challenge
@@ -2027,7 +2528,13 @@ ThreadError MleRouter::HandleChildUpdateRequest(const Message &aMessage, const I
     if (Tlv::GetTlv(aMessage, Tlv::kTimeout, sizeof(timeout), timeout) == kThreadError_None)
     {
         VerifyOrExit(timeout.IsValid(), error = kThreadError_Parse);
-        child->mTimeout = timeout.GetTimeout();
+
+        if (child->mTimeout != timeout.GetTimeout())
+        {
+            child->mTimeout = timeout.GetTimeout();
+            mChildTableGeneration++;
+        }
+
         tlvs[tlvslength++] = Tlv::kTimeout;
     }
 
@@ -2045,6 +2552,11 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
     TlvRequestTlv tlvRequest;
     ActiveTimestampTlv activeTimestamp;
     PendingTimestampTlv pendingTimestamp;
+    LeaderDataTlv leaderData;
+    Neighbor *neighbor;
+    bool haveVersion = false;
+    uint8_t version = 0;
+    uint8_t ourVersion;
     uint8_t tlvs[4];
     uint8_t numTlvs;
 
@@ -2054,6 +2566,27 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
     SuccessOrExit(error = Tlv::GetTlv(aMessage, Tlv::kTlvRequest, sizeof(tlvRequest), tlvRequest));
     VerifyOrExit(tlvRequest.IsValid() && tlvRequest.GetLength() <= sizeof(tlvs), error = kThreadError_Parse);
 
+    // determine which network data version the requester is at, preferring the Leader Data
+    // it sent over the version last recorded in the child table
+    neighbor = mMleRouter.GetNeighbor(aMessageInfo.GetPeerAddr());
+
+    if (Tlv::GetTlv(aMessage, Tlv::kLeaderData, sizeof(leaderData), leaderData) == kThreadError_None)
+    {
+        VerifyOrExit(leaderData.IsValid(), error = kThreadError_Parse);
+
+        if (leaderData.GetPartitionId() == mLeaderData.GetPartitionId())
+        {
+            haveVersion = true;
+            version = (neighbor != NULL && (neighbor->mMode & ModeTlv::kModeFullNetworkData) == 0) ?
+                      leaderData.GetStableDataVersion() : leaderData.GetDataVersion();
+        }
+    }
+    else if (neighbor != NULL && IsActiveRouter(neighbor->mValid.mRloc16) == false)
+    {
+        haveVersion = true;
+        version = static_cast<Child *>(neighbor)->mNetworkDataVersion;
+    }
+
     // Active Timestamp
     activeTimestamp.SetLength(0);
 
@@ -2071,8 +2604,27 @@ ThreadError MleRouter::HandleDataRequest(const Message &aMessage, const Ip6::Mes
     }
 
     memset(tlvs, Tlv::kInvalid, sizeof(tlvs));
-    memcpy(tlvs, tlvRequest.GetTlvs(), tlvRequest.GetLength());
-    numTlvs = tlvRequest.GetLength();
+    numTlvs = 0;
+
+    for (uint8_t i = 0; i < tlvRequest.GetLength(); i++)
+    {
+        uint8_t tlvType = tlvRequest.GetTlvs()[i];
+
+        if (tlvType == Tlv::kNetworkData && haveVersion)
+        {
+            ourVersion = (neighbor != NULL && (neighbor->mMode & ModeTlv::kModeFullNetworkData) == 0) ?
+                         mNetworkData.GetStableVersion() : mNetworkData.GetVersion();
+
+            // the requester already has the current network data; a response without the
+            // blob still refreshes its Leader Data and timestamps
+            if (version == ourVersion)
+            {
+                continue;
+            }
+        }
+
+        tlvs[numTlvs++] = tlvType;
+    }
 
     if (activeTimestamp.GetLength() == 0 ||
         mNetif.GetActiveDataset().GetNetwork().GetTimestamp() == NULL ||
@@ -2168,8 +2720,11 @@ ThreadError MleRouter::SendChildIdResponse(Child *aChild)
     }
 
     aChild->mState = Neighbor::kStateValid;
+    mChildTableGeneration++;
     mNetif.SetStateChangedFlags(OT_THREAD_CHILD_ADDED);
 
+    otLogInfoMle("Child %s attached\n", aChild->GetExtAddrString());
+
     memset(&destination, 0, sizeof(destination));
     destination.mFields.m16[0] = HostSwap16(0xfe80);
     destination.SetIid(aChild->mMacAddr);
@@ -2187,6 +2742,35 @@ exit:
     return kThreadError_None;
 }
 
+ThreadError MleRouter::SendChildUpdateRequest(Child &aChild)
+{
+    ThreadError error = kThreadError_None;
+    Ip6::Address destination;
+    Message *message;
+
+    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    message->SetLinkSecurityEnabled(false);
+    SuccessOrExit(error = AppendHeader(*message, Header::kCommandChildUpdateRequest));
+    SuccessOrExit(error = AppendSourceAddress(*message));
+    SuccessOrExit(error = AppendLeaderData(*message));
+
+    memset(&destination, 0, sizeof(destination));
+    destination.mFields.m16[0] = HostSwap16(0xfe80);
+    destination.SetIid(aChild.mMacAddr);
+    SuccessOrExit(error = SendMessage(*message, destination));
+
+    otLogInfoMle("Sent Child Update Request to child\n");
+
+exit:
+
+    if (error != kThreadError_None && message != NULL)
+    {
+        message->Free();
+    }
+
+    return error;
+}
+
 ThreadError MleRouter::SendChildUpdateResponse(Child *aChild, const Ip6::MessageInfo &aMessageInfo,
                                                const uint8_t *aTlvs, uint8_t aTlvslength,
                                                const ChallengeTlv *aChallenge)
@@ -2295,31 +2879,74 @@ exit:
     return error;
 }
 
+uint8_t MleRouter::ChildLookupHash(uint16_t aRloc16)
+{
+    return static_cast<uint8_t>(GetChildId(aRloc16) & (kChildLookupIndexSize - 1));
+}
+
+uint8_t MleRouter::ChildLookupHash(const Mac::ExtAddress &aAddress)
+{
+    uint8_t hash = 0;
+
+    for (size_t i = 0; i < sizeof(aAddress.m8); i++)
+    {
+        hash ^= aAddress.m8[i];
+    }
+
+    return static_cast<uint8_t>(hash & (kChildLookupIndexSize - 1));
+}
+
 Child *MleRouter::GetChild(uint16_t aAddress)
 {
+    Child *rval = NULL;
+    uint8_t hash = ChildLookupHash(aAddress);
+    uint8_t hint = mChildIndexRloc16[hash];
+
+    if (hint < mMaxChildrenAllowed &&
+        mChildren[hint].mState == Neighbor::kStateValid &&
+        mChildren[hint].mValid.mRloc16 == aAddress)
+    {
+        ExitNow(rval = &mChildren[hint]);
+    }
+
     for (int i = 0; i < mMaxChildrenAllowed; i++)
     {
         if (mChildren[i].mState == Neighbor::kStateValid && mChildren[i].mValid.mRloc16 == aAddress)
         {
-            return &mChildren[i];
+            mChildIndexRloc16[hash] = static_cast<uint8_t>(i);
+            ExitNow(rval = &mChildren[i]);
         }
     }
 
-    return NULL;
+exit:
+    return rval;
 }
 
 Child *MleRouter::GetChild(const Mac::ExtAddress &aAddress)
 {
+    Child *rval = NULL;
+    uint8_t hash = ChildLookupHash(aAddress);
+    uint8_t hint = mChildIndexExtAddr[hash];
+
+    if (hint < mMaxChildrenAllowed &&
+        mChildren[hint].mState == Neighbor::kStateValid &&
+        memcmp(&mChildren[hint].mMacAddr, &aAddress, sizeof(mChildren[hint].mMacAddr)) == 0)
+    {
+        ExitNow(rval = &mChildren[hint]);
+    }
+
     for (int i = 0; i < mMaxChildrenAllowed; i++)
     {
         if (mChildren[i].mState == Neighbor::kStateValid &&
             memcmp(&mChildren[i].mMacAddr, &aAddress, sizeof(mChildren[i].mMacAddr)) == 0)
         {
-            return &mChildren[i];
+            mChildIndexExtAddr[hash] = static_cast<uint8_t>(i);
+            ExitNow(rval = &mChildren[i]);
         }
     }
 
-    return NULL;
+exit:
+    return rval;
 }
 
 Child *MleRouter::GetChild(const Mac::Address &aAddress)
@@ -2409,6 +3036,17 @@ ThreadError MleRouter::RemoveNeighbor(Neighbor &aNeighbor)
 
     aNeighbor.mState = Neighbor::kStateInvalid;
 
+    otLogInfoMle("Removed neighbor %s\n", aNeighbor.GetExtAddrString());
+
+    if (&aNeighbor >= &mChildren[0] && &aNeighbor <= &mChildren[kMaxChildren - 1])
+    {
+        mChildTableGeneration++;
+    }
+    else if (&aNeighbor >= &mRouters[0] && &aNeighbor <= &mRouters[kMaxRouterId - 1])
+    {
+        mRouterTableGeneration++;
+    }
+
     return kThreadError_None;
 }
 
@@ -2433,21 +3071,28 @@ Neighbor *MleRouter::GetNeighbor(uint16_t aAddress)
 
     case kDeviceStateRouter:
     case kDeviceStateLeader:
-        for (int i = 0; i < mMaxChildrenAllowed; i++)
+        if (mLastNeighbor != NULL && mLastNeighbor->mState == Neighbor::kStateValid &&
+            mLastNeighbor->mValid.mRloc16 == aAddress)
         {
-            if (mChildren[i].mState == Neighbor::kStateValid && mChildren[i].mValid.mRloc16 == aAddress)
-            {
-                ExitNow(rval = &mChildren[i]);
-            }
+            ExitNow(rval = mLastNeighbor);
         }
 
-        for (int i = 0; i < kMaxRouterId; i++)
+        if (IsActiveRouter(aAddress))
         {
-            if (mRouters[i].mState == Neighbor::kStateValid && mRouters[i].mValid.mRloc16 == aAddress)
+            // valid router entries are indexed by Router ID, so the RLOC16 addresses its slot directly
+            if (GetRouterId(aAddress) < kMaxRouterId &&
+                mRouters[GetRouterId(aAddress)].mState == Neighbor::kStateValid &&
+                mRouters[GetRouterId(aAddress)].mValid.mRloc16 == aAddress)
             {
-                ExitNow(rval = &mRouters[i]);
+                mLastNeighbor = &mRouters[GetRouterId(aAddress)];
+                ExitNow(rval = mLastNeighbor);
             }
         }
+        else if ((rval = GetChild(aAddress)) != NULL)
+        {
+            mLastNeighbor = rval;
+            ExitNow();
+        }
 
         break;
     }
@@ -2472,13 +3117,16 @@ Neighbor *MleRouter::GetNeighbor(const Mac::ExtAddress &aAddress)
 
     case kDeviceStateRouter:
     case kDeviceStateLeader:
-        for (int i = 0; i < mMaxChildrenAllowed; i++)
+        if (mLastNeighbor != NULL && mLastNeighbor->mState == Neighbor::kStateValid &&
+            memcmp(&mLastNeighbor->mMacAddr, &aAddress, sizeof(mLastNeighbor->mMacAddr)) == 0)
         {
-            if (mChildren[i].mState == Neighbor::kStateValid &&
-                memcmp(&mChildren[i].mMacAddr, &aAddress, sizeof(mChildren[i].mMacAddr)) == 0)
-            {
-                ExitNow(rval = &mChildren[i]);
-            }
+            ExitNow(rval = mLastNeighbor);
+        }
+
+        if ((rval = GetChild(aAddress)) != NULL)
+        {
+            mLastNeighbor = rval;
+            ExitNow();
         }
 
         for (int i = 0; i < kMaxRouterId; i++)
@@ -2486,7 +3134,8 @@ Neighbor *MleRouter::GetNeighbor(const Mac::ExtAddress &aAddress)
             if (mRouters[i].mState == Neighbor::kStateValid &&
                 memcmp(&mRouters[i].mMacAddr, &aAddress, sizeof(mRouters[i].mMacAddr)) == 0)
             {
-                ExitNow(rval = &mRouters[i]);
+                mLastNeighbor = &mRouters[i];
+                ExitNow(rval = mLastNeighbor);
             }
         }
 
@@ -2744,6 +3393,9 @@ void MleRouter::GetChildInfo(Child &aChild, otChildInfo &aChildInfo)
         aChildInfo.mAge = Timer::MsecToSec(Timer::GetNow() - aChild.mLastHeard);
         aChildInfo.mLinkQualityIn = aChild.mLinkInfo.GetLinkQuality(mMac.GetNoiseFloor());
         aChildInfo.mAverageRssi = aChild.mLinkInfo.GetAverageRss();
+        aChildInfo.mFrameErrorRate = aChild.GetFrameErrorRate();
+        aChildInfo.mTxAirtimeUs = aChild.mTxAirtime;
+        aChildInfo.mRxAirtimeUs = aChild.mRxAirtime;
 
         aChildInfo.mRxOnWhenIdle = (aChild.mMode & ModeTlv::kModeRxOnWhenIdle) != 0;
         aChildInfo.mSecureDataRequest = (aChild.mMode & ModeTlv::kModeSecureDataRequest) != 0;
@@ -2752,6 +3404,75 @@ void MleRouter::GetChildInfo(Child &aChild, otChildInfo &aChildInfo)
     }
 }
 
+ThreadError MleRouter::ExportChildTable(otChildTableEntry *aEntries, uint8_t &aCount)
+{
+    ThreadError error = kThreadError_None;
+    uint8_t count = 0;
+
+    for (int i = 0; i < mMaxChildrenAllowed; i++)
+    {
+        if (mChildren[i].mState != Neighbor::kStateValid)
+        {
+            continue;
+        }
+
+        VerifyOrExit(count < aCount, error = kThreadError_NoBufs);
+
+        memcpy(&aEntries[count].mExtAddress, &mChildren[i].mMacAddr, sizeof(aEntries[count].mExtAddress));
+        aEntries[count].mTimeout = mChildren[i].mTimeout;
+        aEntries[count].mLinkFrameCounter = mChildren[i].mValid.mLinkFrameCounter;
+        aEntries[count].mMleFrameCounter = mChildren[i].mValid.mMleFrameCounter;
+        aEntries[count].mKeySequence = mChildren[i].mKeySequence;
+        aEntries[count].mRloc16 = mChildren[i].mValid.mRloc16;
+        aEntries[count].mMode = mChildren[i].mMode;
+        aEntries[count].mNetworkDataVersion = mChildren[i].mNetworkDataVersion;
+        count++;
+    }
+
+exit:
+    aCount = count;
+    return error;
+}
+
+ThreadError MleRouter::ImportChildTable(const otChildTableEntry *aEntries, uint8_t aCount)
+{
+    ThreadError error = kThreadError_None;
+    Mac::ExtAddress macAddr;
+    Child *child;
+
+    for (uint8_t i = 0; i < aCount; i++)
+    {
+        memcpy(&macAddr, &aEntries[i].mExtAddress, sizeof(macAddr));
+
+        // live attachment state wins over pre-staged state
+        if (FindChild(macAddr) != NULL)
+        {
+            continue;
+        }
+
+        VerifyOrExit((child = NewChild()) != NULL, error = kThreadError_NoBufs);
+        memset(child, 0, sizeof(*child));
+
+        memcpy(&child->mMacAddr, &macAddr, sizeof(child->mMacAddr));
+        child->mLinkInfo.Clear();
+        child->mTimeout = aEntries[i].mTimeout;
+        child->ResetLinkFrameCounter(aEntries[i].mLinkFrameCounter);
+        child->mValid.mMleFrameCounter = aEntries[i].mMleFrameCounter;
+        child->mKeySequence = aEntries[i].mKeySequence;
+        child->mValid.mRloc16 = aEntries[i].mRloc16;
+        child->mMode = aEntries[i].mMode;
+        child->mNetworkDataVersion = aEntries[i].mNetworkDataVersion;
+        child->mLastHeard = Timer::GetNow();
+        child->mState = Neighbor::kStateValid;
+        mChildTableGeneration++;
+
+        otLogInfoMle("Imported child %s\n", child->GetExtAddrString());
+    }
+
+exit:
+    return error;
+}
+
 ThreadError MleRouter::GetRouterInfo(uint16_t aRouterId, otRouterInfo &aRouterInfo)
 {
     ThreadError error = kThreadError_None;
@@ -2778,6 +3499,9 @@ ThreadError MleRouter::GetRouterInfo(uint16_t aRouterId, otRouterInfo &aRouterIn
     aRouterInfo.mLinkQualityIn = mRouters[routerId].mLinkInfo.GetLinkQuality(mMac.GetNoiseFloor());
     aRouterInfo.mLinkQualityOut = mRouters[routerId].mLinkQualityOut;
     aRouterInfo.mAge = static_cast<uint8_t>(Timer::MsecToSec(Timer::GetNow() - mRouters[routerId].mLastHeard));
+    aRouterInfo.mFrameErrorRate = mRouters[routerId].GetFrameErrorRate();
+    aRouterInfo.mTxAirtimeUs = mRouters[routerId].mTxAirtime;
+    aRouterInfo.mRxAirtimeUs = mRouters[routerId].mRxAirtime;
 
 exit:
     return error;
@@ -2838,10 +3562,7 @@ ThreadError MleRouter::SendAddressSolicit(ThreadStatusTlv::Status aStatus)
     Ip6::MessageInfo messageInfo;
     Message *message;
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -2891,10 +3612,7 @@ ThreadError MleRouter::SendAddressRelease(void)
     Ip6::MessageInfo messageInfo;
     Message *message;
 
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -2991,6 +3709,8 @@ void MleRouter::HandleAddressSolicitResponse(Message &aMessage)
         }
     }
 
+    SyncRouterIdMaps();
+
     // send link request
     SendLinkRequest(NULL);
     ResetAdvertiseInterval();
@@ -3039,6 +3759,9 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
     ThreadExtMacAddressTlv macAddr64Tlv;
     ThreadRloc16Tlv rlocTlv;
     ThreadStatusTlv statusTlv;
+    uint8_t tlvs[kMaxSolicitTlvsLength];
+    uint16_t length;
+    bool haveRloc = false;
     uint8_t routerId = kMaxRouterId;
 
     VerifyOrExit(aHeader.GetType() == Coap::Header::kTypeConfirmable && aHeader.GetCode() == Coap::Header::kCodePost,
@@ -3046,11 +3769,74 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
 
     otLogInfoMle("Received address solicit\n");
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv), macAddr64Tlv));
-    VerifyOrExit(macAddr64Tlv.IsValid(), error = kThreadError_Parse);
+    length = aMessage.GetLength() - aMessage.GetOffset();
+
+    if (length <= sizeof(tlvs))
+    {
+        // the solicit is a tiny fixed-shape message: read it once and locate the TLVs
+        // at direct offsets in the linear copy instead of scanning the message per TLV
+        const ThreadExtMacAddressTlv *macTlv = NULL;
+        const ThreadRloc16Tlv *rlocTlvPtr = NULL;
+        const ThreadStatusTlv *statusTlvPtr = NULL;
+        uint16_t offset = 0;
+
+        VerifyOrExit(aMessage.Read(aMessage.GetOffset(), length, tlvs) == length, error = kThreadError_Parse);
+
+        while (offset + sizeof(ThreadTlv) <= length)
+        {
+            const ThreadTlv *tlv = reinterpret_cast<const ThreadTlv *>(tlvs + offset);
+
+            VerifyOrExit(offset + sizeof(ThreadTlv) + tlv->GetLength() <= length, error = kThreadError_Parse);
+
+            switch (tlv->GetType())
+            {
+            case ThreadTlv::kExtMacAddress:
+                macTlv = static_cast<const ThreadExtMacAddressTlv *>(tlv);
+                break;
+
+            case ThreadTlv::kRloc16:
+                rlocTlvPtr = static_cast<const ThreadRloc16Tlv *>(tlv);
+                break;
+
+            case ThreadTlv::kStatus:
+                statusTlvPtr = static_cast<const ThreadStatusTlv *>(tlv);
+                break;
 
-    SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kStatus, sizeof(statusTlv), statusTlv));
-    VerifyOrExit(statusTlv.IsValid(), error = kThreadError_Parse);
+            default:
+                break;
+            }
+
+            offset += sizeof(ThreadTlv) + tlv->GetLength();
+        }
+
+        VerifyOrExit(macTlv != NULL && macTlv->IsValid(), error = kThreadError_Parse);
+        VerifyOrExit(statusTlvPtr != NULL && statusTlvPtr->IsValid(), error = kThreadError_Parse);
+        macAddr64Tlv = *macTlv;
+        statusTlv = *statusTlvPtr;
+
+        if (rlocTlvPtr != NULL)
+        {
+            VerifyOrExit(rlocTlvPtr->IsValid(), error = kThreadError_Parse);
+            rlocTlv = *rlocTlvPtr;
+            haveRloc = true;
+        }
+    }
+    else
+    {
+        // oversized message: fall back to the generic TLV machinery
+        SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kExtMacAddress, sizeof(macAddr64Tlv),
+                                                macAddr64Tlv));
+        VerifyOrExit(macAddr64Tlv.IsValid(), error = kThreadError_Parse);
+
+        SuccessOrExit(error = ThreadTlv::GetTlv(aMessage, ThreadTlv::kStatus, sizeof(statusTlv), statusTlv));
+        VerifyOrExit(statusTlv.IsValid(), error = kThreadError_Parse);
+
+        if (ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv) == kThreadError_None)
+        {
+            VerifyOrExit(rlocTlv.IsValid(), error = kThreadError_Parse);
+            haveRloc = true;
+        }
+    }
 
     // see if allocation already exists
     for (uint8_t i = 0; i < kMaxRouterId; i++)
@@ -3077,10 +3863,9 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
         break;
     }
 
-    if (ThreadTlv::GetTlv(aMessage, ThreadTlv::kRloc16, sizeof(rlocTlv), rlocTlv) == kThreadError_None)
+    if (haveRloc)
     {
         // specific Router ID requested
-        VerifyOrExit(rlocTlv.IsValid(), error = kThreadError_Parse);
         routerId = GetRouterId(rlocTlv.GetRloc16());
 
         if (routerId >= kMaxRouterId)
@@ -3138,9 +3923,9 @@ void MleRouter::SendAddressSolicitResponse(const Coap::Header &aRequestHeader, u
 {
     ThreadError error = kThreadError_None;
     Coap::Header responseHeader;
-    ThreadStatusTlv statusTlv;
-    ThreadRouterMaskTlv routerMaskTlv;
-    ThreadRloc16Tlv rlocTlv;
+    uint8_t tlvs[sizeof(ThreadStatusTlv) + sizeof(ThreadRloc16Tlv) + sizeof(ThreadRouterMaskTlv)];
+    ThreadStatusTlv *statusTlv = reinterpret_cast<ThreadStatusTlv *>(tlvs);
+    uint8_t tlvsLength;
     Message *message;
 
     VerifyOrExit((message = mCoapServer.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
@@ -3154,31 +3939,44 @@ void MleRouter::SendAddressSolicitResponse(const Coap::Header &aRequestHeader, u
     responseHeader.Finalize();
     SuccessOrExit(error = message->Append(responseHeader.GetBytes(), responseHeader.GetLength()));
 
-    statusTlv.Init();
-    statusTlv.SetStatus((aRouterId >= kMaxRouterId) ? statusTlv.kNoAddressAvailable : statusTlv.kSuccess);
-    SuccessOrExit(error = message->Append(&statusTlv, sizeof(statusTlv)));
+    // the response has a fixed shape: build the TLV block at direct offsets on the
+    // stack and append it to the message in one pass
+    statusTlv->Init();
+    statusTlv->SetStatus((aRouterId >= kMaxRouterId) ? ThreadStatusTlv::kNoAddressAvailable :
+                         ThreadStatusTlv::kSuccess);
+    tlvsLength = sizeof(*statusTlv);
 
     if (aRouterId < kMaxRouterId)
     {
-        rlocTlv.Init();
-        rlocTlv.SetRloc16(GetRloc16(aRouterId));
-        SuccessOrExit(error = message->Append(&rlocTlv, sizeof(rlocTlv)));
+        ThreadRloc16Tlv *rlocTlv = reinterpret_cast<ThreadRloc16Tlv *>(tlvs + tlvsLength);
+        ThreadRouterMaskTlv *routerMaskTlv;
+        uint64_t assignedIds;
 
-        routerMaskTlv.Init();
-        routerMaskTlv.SetIdSequence(mRouterIdSequence);
-        routerMaskTlv.ClearAssignedRouterIdMask();
+        rlocTlv->Init();
+        rlocTlv->SetRloc16(GetRloc16(aRouterId));
+        tlvsLength += sizeof(*rlocTlv);
 
-        for (uint8_t i = 0; i < kMaxRouterId; i++)
+        routerMaskTlv = reinterpret_cast<ThreadRouterMaskTlv *>(tlvs + tlvsLength);
+        routerMaskTlv->Init();
+        routerMaskTlv->SetIdSequence(mRouterIdSequence);
+        routerMaskTlv->ClearAssignedRouterIdMask();
+
+        // fill the mask from the allocation bitmap, visiting assigned ids only
+        assignedIds = mAllocatedRouterIds;
+
+        for (uint8_t i = 0; assignedIds != 0; i++, assignedIds >>= 1)
         {
-            if (mRouters[i].mAllocated)
+            if (assignedIds & 1)
             {
-                routerMaskTlv.SetAssignedRouterId(i);
+                routerMaskTlv->SetAssignedRouterId(i);
             }
         }
 
-        SuccessOrExit(error = message->Append(&routerMaskTlv, sizeof(routerMaskTlv)));
+        tlvsLength += sizeof(*routerMaskTlv);
     }
 
+    SuccessOrExit(error = message->Append(tlvs, tlvsLength));
+
     SuccessOrExit(error = mCoapServer.SendMessage(*message, aMessageInfo));
 
     otLogInfoMle("Sent address reply\n");
@@ -3421,17 +4219,27 @@ exit:
 ThreadError MleRouter::AppendRoute(Message &aMessage)
 {
     ThreadError error;
-    RouteTlv tlv;
+    RouteTlv &tlv = mRouteTlvCache;
     uint8_t routeCount = 0;
     uint8_t cost;
 
+    // most advertisements are identical to the previous one: reuse the cached
+    // serialization unless the router id sequence changed, the route set was
+    // invalidated, or the cached image aged out (bounds link quality staleness)
+    if (mRouteTlvCacheValid &&
+        mRouteTlvCacheSequence == mRouterIdSequence &&
+        (Timer::GetNow() - mRouteTlvCacheTime) < kRouteTlvCacheMaxAge)
+    {
+        ExitNow(error = aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength()));
+    }
+
     tlv.Init();
     tlv.SetRouterIdSequence(mRouterIdSequence);
     tlv.ClearRouterIdMask();
 
     for (uint8_t i = 0; i < kMaxRouterId; i++)
     {
-        if (mRouters[i].mAllocated == false)
+        if ((mAllocatedRouterIds & (1ULL << i)) == 0)
         {
             continue;
         }
@@ -3478,6 +4286,11 @@ ThreadError MleRouter::AppendRoute(Message &aMessage)
     }
 
     tlv.SetRouteDataLength(routeCount);
+
+    mRouteTlvCacheTime = Timer::GetNow();
+    mRouteTlvCacheSequence = mRouterIdSequence;
+    mRouteTlvCacheValid = true;
+
     SuccessOrExit(error = aMessage.Append(&tlv, sizeof(Tlv) + tlv.GetLength()));
 
 exit:
@@ -403,6 +403,43 @@ public:
      */
     ThreadError GetChildInfoByIndex(uint8_t aChildIndex, otChildInfo &aChildInfo);
 
+    /**
+     * This method returns the generation counter for the child table.
+     *
+     * The counter is incremented whenever a child table entry is added, removed, or modified, so a
+     * poller that cached the table may skip re-reading it while the generation is unchanged.
+     *
+     * @returns The child table generation counter.
+     *
+     */
+    uint32_t GetChildTableGeneration(void) const { return mChildTableGeneration; }
+
+    /**
+     * This method exports the attachment state of all attached children.
+     *
+     * @param[in]     aEntries  An array where child table entries are placed.
+     * @param[inout]  aCount    On entry, the capacity of @p aEntries. On exit, the number of entries placed.
+     *
+     * @retval kThreadError_None    Successfully exported the child table.
+     * @retval kThreadError_NoBufs  @p aEntries was too small for the attached children.
+     *
+     */
+    ThreadError ExportChildTable(otChildTableEntry *aEntries, uint8_t &aCount);
+
+    /**
+     * This method imports previously exported child attachment state into free child table slots.
+     *
+     * Entries whose extended address is already present in the child table are skipped.
+     *
+     * @param[in]  aEntries  An array of child table entries.
+     * @param[in]  aCount    The number of entries in @p aEntries.
+     *
+     * @retval kThreadError_None    Successfully imported the entries.
+     * @retval kThreadError_NoBufs  The child table filled up before all entries were imported.
+     *
+     */
+    ThreadError ImportChildTable(const otChildTableEntry *aEntries, uint8_t aCount);
+
     /**
      * This method returns a pointer to a Router array.
      *
@@ -422,6 +459,18 @@ public:
      */
     ThreadError GetRouterInfo(uint16_t aRouterId, otRouterInfo &aRouterInfo);
 
+    /**
+     * This method returns the generation counter for the router table.
+     *
+     * The counter is incremented whenever a router table entry is added, removed, or changes its
+     * link state, next hop, or route cost, so a poller that cached the table may skip re-reading
+     * it while the generation is unchanged.
+     *
+     * @returns The router table generation counter.
+     *
+     */
+    uint32_t GetRouterTableGeneration(void) const { return mRouterTableGeneration; }
+
     /**
      * This method handles MAC Data Poll messages.
      *
@@ -470,10 +519,97 @@ public:
      */
     ThreadError SendLinkReject(const Ip6::Address &aDestination);
 
+    /**
+     * This method starts an active link probe burst toward a router neighbor.
+     *
+     * A burst of small MLE Link Probe messages is sent back-to-back; each probe is
+     * acknowledged with a Link Probe Ack carrying a Link Margin TLV, so one round
+     * refreshes both the received RSS statistics and the outgoing link quality
+     * without waiting for passive advertisement observations.
+     *
+     * @param[in]  aRouterId  The router id of the neighbor to probe.
+     * @param[in]  aCount     The number of probes to send (0 uses the default burst size).
+     *
+     * @retval kThreadError_None         Successfully started the probe burst.
+     * @retval kThreadError_InvalidArgs  The router id does not identify a valid router neighbor.
+     * @retval kThreadError_Busy         A probe burst is already in progress.
+     *
+     */
+    ThreadError SendLinkProbes(uint8_t aRouterId, uint8_t aCount);
+
 private:
     enum
     {
-        kStateUpdatePeriod = 1000u,  ///< State update period in milliseconds.
+        kStateUpdatePeriod = 1000u,        ///< State update period in milliseconds.
+        kAgingTicksPerPeriod = 8,          ///< Number of neighbor aging slices per state update period.
+        kAgingTickPeriod = kStateUpdatePeriod / kAgingTicksPerPeriod,  ///< Aging slice period in milliseconds.
+        kRouteTlvCacheMaxAge = 32 * 1000u, ///< Maximum age of the cached Route TLV in milliseconds.
+        kChildLookupIndexSize = 64,        ///< Number of child lookup hints (power of two).
+        kMaxSolicitTlvsLength = 128,       ///< Linear parse buffer size for address solicit payloads (bytes).
+    };
+
+    /**
+     * Advertisement deferral parameters. When the forwarder send queue is deep, periodic
+     * advertisements yield to the queued data instead of joining the contended egress.
+     *
+     */
+    enum
+    {
+        kAdvertiseDeferQueueDepth = 6,     ///< Send queue depth at which advertisements are postponed.
+        kAdvertiseMaxDeferrals    = 2,     ///< Maximum consecutive postponed trickle firings.
+    };
+
+    /**
+     * Parent Response jitter parameters. Responses are delayed by a random amount drawn
+     * from a window that widens with attach load, spreading a mass reattach over time.
+     *
+     */
+    enum
+    {
+        kParentResponseBaseWindow      = 64,    ///< Minimum jitter window in milliseconds.
+        kParentResponseChildWindow     = 128,   ///< Additional window per child mid-attach in milliseconds.
+        kParentResponseCongestedWindow = 1024,  ///< Additional window while the message pool is congested.
+        kParentResponseMaxWindow       = 4096,  ///< Upper bound on the jitter window in milliseconds.
+    };
+
+    /**
+     * Link probe parameters.
+     *
+     */
+    enum
+    {
+        kLinkProbeBurst        = 8,    ///< Default number of probes per burst.
+        kLinkProbeTimeoutTicks = 16,   ///< Aging ticks before a probe burst is finalized.
+        kLinkProbeFailRate     = 64,   ///< mTxFailRate value that triggers an automatic probe burst.
+        kLinkProbeCooldown     = 30,   ///< Minimum interval between automatic probe bursts in seconds.
+    };
+
+    /**
+     * Child timeout probe parameters. A quiet rx-on-when-idle child is probed with a Child
+     * Update Request shortly before its timeout, so a child that merely missed its periodic
+     * updates can prove liveness instead of being expired into a full re-attach. Sleepy
+     * children are not probed; their data polls already refresh the timeout.
+     *
+     */
+    enum
+    {
+        kChildTimeoutProbeGrace = 10,  ///< Probe lead time before child timeout in seconds.
+    };
+
+    /**
+     * Route dampening parameters. Every next hop change for a destination adds penalty that
+     * decays once per state update period; while the accumulated penalty is at or above the
+     * suppression threshold, further next hop changes for that destination are not adopted,
+     * so a flapping link stops triggering partition-wide route recomputation. Route loss is
+     * always applied so traffic is never forwarded through a next hop known to be unusable.
+     *
+     */
+    enum
+    {
+        kRoutePenaltyFlap     = 60,    ///< Penalty added per next hop change.
+        kRoutePenaltySuppress = 120,   ///< Penalty at or above which route changes are suppressed.
+        kRoutePenaltyDecay    = 30,    ///< Penalty removed per state update period.
+        kRoutePenaltyMax      = 240,   ///< Penalty accumulation ceiling.
     };
 
     ThreadError AppendConnectivity(Message &aMessage);
@@ -492,6 +628,8 @@ private:
     ThreadError HandleLinkAcceptAndRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
                                            uint32_t aKeySequence);
     ThreadError HandleLinkReject(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleLinkProbe(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
+    ThreadError HandleLinkProbeAck(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleAdvertisement(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleParentRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
     ThreadError HandleChildIdRequest(const Message &aMessage, const Ip6::MessageInfo &aMessageInfo,
@@ -511,8 +649,12 @@ private:
     ThreadError SendLinkRequest(Neighbor *aNeighbor);
     ThreadError SendLinkAccept(const Ip6::MessageInfo &aMessageInfo, Neighbor *aNeighbor,
                                const TlvRequestTlv &aTlvRequest, const ChallengeTlv &aChallenge);
-    ThreadError SendParentResponse(Child *aChild, const ChallengeTlv &aChallenge);
+    ThreadError SendLinkProbeAck(const Ip6::MessageInfo &aMessageInfo);
+    void FinalizeLinkProbe(void);
+    ThreadError SendParentResponse(Child *aChild);
+    uint32_t GetParentResponseWindow(void);
     ThreadError SendChildIdResponse(Child *aChild);
+    ThreadError SendChildUpdateRequest(Child &aChild);
     ThreadError SendChildUpdateResponse(Child *aChild, const Ip6::MessageInfo &aMessageInfo,
                                         const uint8_t *aTlvs, uint8_t aTlvsLength,  const ChallengeTlv *challenge);
     ThreadError SendDataResponse(const Ip6::Address &aDestination, const uint8_t *aTlvs, uint8_t aTlvsLength);
@@ -522,6 +664,8 @@ private:
     void StopLeader(void);
     ThreadError UpdateChildAddresses(const AddressRegistrationTlv &aTlv, Child &aChild);
     void UpdateRoutes(const RouteTlv &aTlv, uint8_t aRouterId);
+    void RecordRouteFlap(uint8_t aRouterId);
+    bool SuppressRouteChange(uint8_t aRouterId);
 
     static void HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo);
     void HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo);
@@ -539,6 +683,9 @@ private:
     Child *FindChild(uint16_t aChildId);
     Child *FindChild(const Mac::ExtAddress &aMacAddr);
 
+    static uint8_t ChildLookupHash(uint16_t aRloc16);
+    static uint8_t ChildLookupHash(const Mac::ExtAddress &aAddress);
+
     bool HasMinDowngradeNeighborRouters(void);
     bool HasOneNeighborwithComparableConnectivity(const RouteTlv &aRoute, uint8_t aRouterId);
     bool HasSmallNumberOfChildren(void);
@@ -547,14 +694,21 @@ private:
     uint8_t AllocateRouterId(void);
     uint8_t AllocateRouterId(uint8_t aRouterId);
     bool InRouterIdMask(uint8_t aRouterId);
+    void SyncRouterIdMaps(void);
+    static uint8_t CountRouterIds(uint64_t aMask);
 
     static bool HandleAdvertiseTimer(void *aContext);
     bool HandleAdvertiseTimer(void);
     static void HandleStateUpdateTimer(void *aContext);
     void HandleStateUpdateTimer(void);
+    static void HandleParentResponseTimer(void *aContext);
+    void HandleParentResponseTimer(void);
 
     TrickleTimer mAdvertiseTimer;
+    uint8_t mAdvertiseDeferrals;
     Timer mStateUpdateTimer;
+    Timer mParentResponseTimer;
+    uint8_t mStateUpdateTick;
 
     Ip6::UdpSocket mSocket;
     Coap::Resource mAddressSolicit;
@@ -563,9 +717,43 @@ private:
     uint8_t mRouterIdSequence;
     uint32_t mRouterIdSequenceLastUpdated;
     Router mRouters[kMaxRouterId];
+
+    uint8_t mProbeRouterId;       // router id being probed, or kMaxRouterId when idle
+    uint8_t mProbesSent;
+    uint8_t mProbeAcks;
+    uint8_t mProbeTimeout;        // remaining aging ticks before the burst is finalized
+    uint32_t mLastProbeTime;
+
+    // bitmaps mirroring the mAllocated / mReclaimDelay flags in mRouters, plus the
+    // allocated count, so id allocation and Route TLV construction avoid scanning
+    // the router table; bulk table rewrites resync them via SyncRouterIdMaps()
+    uint64_t mAllocatedRouterIds;
+    uint64_t mReclaimDelayedIds;
+    uint8_t mAllocatedRouterCount;
+
+    RouteTlv mRouteTlvCache;
+    uint32_t mRouteTlvCacheTime;
+    uint8_t mRouteTlvCacheSequence;
+    bool mRouteTlvCacheValid;
     uint8_t mMaxChildrenAllowed;
     Child mChildren[kMaxChildren];
 
+    // snapshot generation counters for the router and child tables; bumped on
+    // every host-visible table mutation so pollers can skip unchanged tables
+    uint32_t mRouterTableGeneration;
+    uint32_t mChildTableGeneration;
+
+    // lookup hints: child table indexes keyed by hashed RLOC16 / extended address;
+    // hints are verified on use and refilled on scan hits, so they never need
+    // explicit invalidation when a child's state or address changes
+    uint8_t mChildIndexRloc16[kChildLookupIndexSize];
+    uint8_t mChildIndexExtAddr[kChildLookupIndexSize];
+
+    // one-entry last-hit cache shared by all GetNeighbor() overloads; like the
+    // child lookup hints, the entry is verified against the queried address on
+    // use and therefore never needs explicit invalidation
+    Neighbor *mLastNeighbor;
+
     uint8_t mChallenge[8];
     uint16_t mNextChildId;
     uint8_t mNetworkIdTimeout;
@@ -33,6 +33,7 @@
 
 #include <common/code_utils.hpp>
 #include <common/message.hpp>
+#include <common/tlv_iterator.hpp>
 #include <thread/mle_tlvs.hpp>
 
 namespace Thread {
@@ -40,18 +41,11 @@ namespace Mle {
 
 ThreadError Tlv::GetTlv(const Message &aMessage, Type aType, uint16_t aMaxLength, Tlv &aTlv)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset;
+    ThreadError error;
+    TlvIterator iterator(aMessage);
 
-    SuccessOrExit(error = GetOffset(aMessage, aType, offset));
-    aMessage.Read(offset, sizeof(Tlv), &aTlv);
-
-    if (aMaxLength > sizeof(aTlv) + aTlv.GetLength())
-    {
-        aMaxLength = sizeof(aTlv) + aTlv.GetLength();
-    }
-
-    aMessage.Read(offset, aMaxLength, &aTlv);
+    SuccessOrExit(error = iterator.SeekTo(static_cast<uint8_t>(aType)));
+    iterator.ReadTlv(aMaxLength, &aTlv);
 
 exit:
     return error;
@@ -59,23 +53,11 @@ exit:
 
 ThreadError Tlv::GetOffset(const Message &aMessage, Type aType, uint16_t &aOffset)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = aMessage.GetOffset();
-    uint16_t end = aMessage.GetLength();
-    Tlv tlv;
-
-    while (offset < end)
-    {
-        aMessage.Read(offset, sizeof(Tlv), &tlv);
-
-        if (tlv.GetType() == aType && (offset + sizeof(tlv) + tlv.GetLength()) <= end)
-        {
-            aOffset = offset;
-            ExitNow(error = kThreadError_None);
-        }
+    ThreadError error;
+    TlvIterator iterator(aMessage);
 
-        offset += sizeof(tlv) + tlv.GetLength();
-    }
+    SuccessOrExit(error = iterator.SeekTo(static_cast<uint8_t>(aType)));
+    aOffset = iterator.GetOffset();
 
 exit:
     return error;
@@ -35,8 +35,8 @@
 #include <common/code_utils.hpp>
 #include <common/debug.hpp>
 #include <common/logging.hpp>
+#include <common/random.hpp>
 #include <mac/mac_frame.hpp>
-#include <platform/random.h>
 #include <thread/network_data.hpp>
 #include <thread/thread_netif.hpp>
 #include <thread/thread_tlvs.hpp>
@@ -50,7 +50,7 @@ NetworkData::NetworkData(ThreadNetif &aThreadNetif, bool aLocal):
     mLocal(aLocal),
     mLastAttemptWait(false),
     mLastAttempt(0),
-    mSocket(aThreadNetif.GetIp6().mUdp)
+    mCoapClient(aThreadNetif.GetCoapClient())
 {
     mLength = 0;
     mCoapMessageId = 0;
@@ -598,12 +598,7 @@ ThreadError NetworkData::SendServerDataNotification(uint16_t aRloc16)
     VerifyOrExit(!mLastAttemptWait || static_cast<int32_t>(Timer::GetNow() - mLastAttempt) < kDataResubmitDelay,
                  error = kThreadError_Already);
 
-    mSocket.Open(&HandleUdpReceive, this);
-
-    for (size_t i = 0; i < sizeof(mCoapToken); i++)
-    {
-        mCoapToken[i] = static_cast<uint8_t>(otPlatRandomGet());
-    }
+    Random::FillBuffer(mCoapToken, sizeof(mCoapToken));
 
     header.Init();
     header.SetVersion(1);
@@ -615,7 +610,7 @@ ThreadError NetworkData::SendServerDataNotification(uint16_t aRloc16)
     header.AppendContentFormatOption(Coap::Header::kApplicationOctetStream);
     header.Finalize();
 
-    VerifyOrExit((message = mSocket.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
+    VerifyOrExit((message = mCoapClient.NewMessage(0)) != NULL, error = kThreadError_NoBufs);
     SuccessOrExit(error = message->Append(header.GetBytes(), header.GetLength()));
 
     if (mLocal)
@@ -638,7 +633,7 @@ ThreadError NetworkData::SendServerDataNotification(uint16_t aRloc16)
     memset(&messageInfo, 0, sizeof(messageInfo));
     mMle.GetLeaderAddress(messageInfo.GetPeerAddr());
     messageInfo.mPeerPort = kCoapUdpPort;
-    SuccessOrExit(error = mSocket.SendTo(*message, messageInfo));
+    SuccessOrExit(error = mCoapClient.SendMessage(*message, header, messageInfo, &HandleServerDataResponse, this));
 
     if (mLocal)
     {
@@ -663,26 +658,18 @@ void NetworkData::ClearResubmitDelayTimer(void)
     mLastAttemptWait = false;
 }
 
-void NetworkData::HandleUdpReceive(void *aContext, otMessage aMessage, const otMessageInfo *aMessageInfo)
-{
-    Local *obj = static_cast<Local *>(aContext);
-    obj->HandleUdpReceive(*static_cast<Message *>(aMessage), *static_cast<const Ip6::MessageInfo *>(aMessageInfo));
-}
-
-void NetworkData::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageInfo)
+void NetworkData::HandleServerDataResponse(void *aContext, Coap::Header *aHeader, Message *aMessage,
+                                           const Ip6::MessageInfo *aMessageInfo, ThreadError aResult)
 {
-    Coap::Header header;
-
-    SuccessOrExit(header.FromMessage(aMessage));
-    VerifyOrExit(header.GetType() == Coap::Header::kTypeAcknowledgment &&
-                 header.GetCode() == Coap::Header::kCodeChanged &&
-                 header.GetMessageId() == mCoapMessageId &&
-                 header.GetTokenLength() == sizeof(mCoapToken) &&
-                 memcmp(mCoapToken, header.GetToken(), sizeof(mCoapToken)) == 0, ;);
+    VerifyOrExit(aResult == kThreadError_None, otLogInfoNetData("Server data notification timed out\n"));
+    VerifyOrExit(aHeader->GetType() == Coap::Header::kTypeAcknowledgment &&
+                 aHeader->GetCode() == Coap::Header::kCodeChanged, ;);
 
     otLogInfoNetData("Server data notification acknowledged\n");
 
 exit:
+    (void)aContext;
+    (void)aMessage;
     (void)aMessageInfo;
 }
 
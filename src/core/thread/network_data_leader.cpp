@@ -37,9 +37,9 @@
 #include <common/code_utils.hpp>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/random.hpp>
 #include <common/timer.hpp>
 #include <mac/mac_frame.hpp>
-#include <platform/random.h>
 #include <thread/mle_router.hpp>
 #include <thread/network_data_leader.hpp>
 #include <thread/thread_netif.hpp>
@@ -64,14 +64,141 @@ Leader::Leader(ThreadNetif &aThreadNetif):
 void Leader::Reset(void)
 {
     memset(mContextLastUsed, 0, sizeof(mContextLastUsed));
-    mVersion = static_cast<uint8_t>(otPlatRandomGet());
-    mStableVersion = static_cast<uint8_t>(otPlatRandomGet());
+    mVersion = static_cast<uint8_t>(Random::GetUint32());
+    mStableVersion = static_cast<uint8_t>(Random::GetUint32());
     mLength = 0;
     mContextUsed = 0;
     mContextIdReuseDelay = kContextIdReuseDelay;
+    ResetIndex();
     mNetif.SetStateChangedFlags(OT_THREAD_NETDATA_UPDATED);
 }
 
+void Leader::ResetIndex(void)
+{
+    mIndexValid = false;
+    mStableImageValid = false;
+}
+
+void Leader::GetNetworkData(bool aStable, uint8_t *aData, uint8_t &aDataLength)
+{
+    assert(aData != NULL);
+
+    if (aStable)
+    {
+        UpdateStableImage();
+        memcpy(aData, mStableTlvs, mStableLength);
+        aDataLength = mStableLength;
+    }
+    else
+    {
+        memcpy(aData, mTlvs, mLength);
+        aDataLength = mLength;
+    }
+}
+
+void Leader::UpdateStableImage(void)
+{
+    VerifyOrExit(!mStableImageValid || mStableImageVersion != mVersion, ;);
+
+    memcpy(mStableTlvs, mTlvs, mLength);
+    mStableLength = mLength;
+    RemoveTemporaryData(mStableTlvs, mStableLength);
+
+    mStableImageVersion = mVersion;
+    mStableImageValid = true;
+
+exit:
+    return;
+}
+
+void Leader::UpdateIndex(void)
+{
+    PrefixTlv *prefix;
+    ContextTlv *context;
+    uint8_t i;
+
+    VerifyOrExit(!mIndexValid || mIndexVersion != mVersion, ;);
+
+    mPrefixIndexCount = 0;
+    mPrefixIndexOverflow = false;
+    mPrefixFilter = 0;
+    mPrefixFilterActive = true;
+    memset(mContextMap, 0, sizeof(mContextMap));
+
+    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
+         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+         cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        {
+            continue;
+        }
+
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        context = FindContext(*prefix);
+
+        if (prefix->GetPrefixLength() >= 8)
+        {
+            mPrefixFilter |= (1 << (prefix->GetPrefix()[0] & 31)) |
+                             (1 << ((prefix->GetPrefix()[0] >> 3) & 31));
+        }
+        else
+        {
+            // the first address byte is not fully covered by the prefix
+            mPrefixFilterActive = false;
+        }
+
+        if (context != NULL &&
+            context->GetContextId() >= kMinContextId &&
+            context->GetContextId() < kMinContextId + kNumContextIds)
+        {
+            mContextMap[context->GetContextId() - kMinContextId] = prefix;
+        }
+
+        if (mPrefixIndexCount >= kMaxIndexedPrefixes)
+        {
+            mPrefixIndexOverflow = true;
+            continue;
+        }
+
+        // insert sorted by descending prefix length so that lookups may stop at the first match
+        for (i = mPrefixIndexCount; i > 0; i--)
+        {
+            if (mPrefixIndex[i - 1].mPrefix->GetPrefixLength() >= prefix->GetPrefixLength())
+            {
+                break;
+            }
+
+            mPrefixIndex[i] = mPrefixIndex[i - 1];
+        }
+
+        mPrefixIndex[i].mPrefix = prefix;
+        mPrefixIndex[i].mContext = context;
+        mPrefixIndex[i].mBorderRouter = FindBorderRouter(*prefix);
+        mPrefixIndexCount++;
+    }
+
+    mIndexVersion = mVersion;
+    mIndexValid = true;
+
+exit:
+    return;
+}
+
+bool Leader::MatchesPrefixFilter(const Ip6::Address &aAddress) const
+{
+    bool rval = true;
+    uint8_t byte = aAddress.mFields.m8[0];
+
+    VerifyOrExit(mPrefixFilterActive, ;);
+
+    rval = (mPrefixFilter & (1 << (byte & 31))) != 0 &&
+           (mPrefixFilter & (1 << ((byte >> 3) & 31))) != 0;
+
+exit:
+    return rval;
+}
+
 void Leader::Start(void)
 {
     mCoapServer.AddResource(mServerData);
@@ -124,6 +251,8 @@ ThreadError Leader::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aC
     PrefixTlv *prefix;
     ContextTlv *contextTlv;
 
+    UpdateIndex();
+
     aContext.mPrefixLength = 0;
 
     if (PrefixMatch(mMle.GetMeshLocalPrefix(), aAddress.mFields.m8, 64) >= 0)
@@ -133,37 +262,68 @@ ThreadError Leader::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aC
         aContext.mContextId = 0;
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
-    {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
+    VerifyOrExit(MatchesPrefixFilter(aAddress), ;);
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
-
-        if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
+    if (!mPrefixIndexOverflow)
+    {
+        // the index is sorted by descending prefix length, so the first match is the longest
+        for (uint8_t i = 0; i < mPrefixIndexCount; i++)
         {
-            continue;
-        }
+            prefix = mPrefixIndex[i].mPrefix;
+            contextTlv = mPrefixIndex[i].mContext;
 
-        contextTlv = FindContext(*prefix);
+            if (prefix->GetPrefixLength() <= aContext.mPrefixLength)
+            {
+                break;
+            }
 
-        if (contextTlv == NULL)
-        {
-            continue;
-        }
+            if (contextTlv == NULL ||
+                PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
+            {
+                continue;
+            }
 
-        if (prefix->GetPrefixLength() > aContext.mPrefixLength)
-        {
             aContext.mPrefix = prefix->GetPrefix();
             aContext.mPrefixLength = prefix->GetPrefixLength();
             aContext.mContextId = contextTlv->GetContextId();
+            break;
         }
     }
+    else
+    {
+        for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
+             cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+             cur = cur->GetNext())
+        {
+            if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+            {
+                continue;
+            }
+
+            prefix = reinterpret_cast<PrefixTlv *>(cur);
+
+            if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
+            {
+                continue;
+            }
 
+            contextTlv = FindContext(*prefix);
+
+            if (contextTlv == NULL)
+            {
+                continue;
+            }
+
+            if (prefix->GetPrefixLength() > aContext.mPrefixLength)
+            {
+                aContext.mPrefix = prefix->GetPrefix();
+                aContext.mPrefixLength = prefix->GetPrefixLength();
+                aContext.mContextId = contextTlv->GetContextId();
+            }
+        }
+    }
+
+exit:
     return (aContext.mPrefixLength > 0) ? kThreadError_None : kThreadError_Error;
 }
 
@@ -171,7 +331,6 @@ ThreadError Leader::GetContext(uint8_t aContextId, Lowpan::Context &aContext)
 {
     ThreadError error = kThreadError_Error;
     PrefixTlv *prefix;
-    ContextTlv *contextTlv;
 
     if (aContextId == 0)
     {
@@ -181,33 +340,17 @@ ThreadError Leader::GetContext(uint8_t aContextId, Lowpan::Context &aContext)
         ExitNow(error = kThreadError_None);
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
-    {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
+    VerifyOrExit(aContextId >= kMinContextId && aContextId < kMinContextId + kNumContextIds, ;);
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
-        contextTlv = FindContext(*prefix);
+    UpdateIndex();
 
-        if (contextTlv == NULL)
-        {
-            continue;
-        }
+    // the direct map covers every allocatable Context ID, even when the prefix index overflows
+    VerifyOrExit((prefix = mContextMap[aContextId - kMinContextId]) != NULL, ;);
 
-        if (contextTlv->GetContextId() != aContextId)
-        {
-            continue;
-        }
-
-        aContext.mPrefix = prefix->GetPrefix();
-        aContext.mPrefixLength = prefix->GetPrefixLength();
-        aContext.mContextId = contextTlv->GetContextId();
-        ExitNow(error = kThreadError_None);
-    }
+    aContext.mPrefix = prefix->GetPrefix();
+    aContext.mPrefixLength = prefix->GetPrefixLength();
+    aContext.mContextId = aContextId;
+    error = kThreadError_None;
 
 exit:
     return error;
@@ -218,33 +361,57 @@ bool Leader::IsOnMesh(const Ip6::Address &aAddress)
     PrefixTlv *prefix;
     bool rval = false;
 
+    UpdateIndex();
+
     if (memcmp(aAddress.mFields.m8, mMle.GetMeshLocalPrefix(), 8) == 0)
     {
         ExitNow(rval = true);
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    VerifyOrExit(MatchesPrefixFilter(aAddress), ;);
+
+    if (!mPrefixIndexOverflow)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        for (uint8_t i = 0; i < mPrefixIndexCount; i++)
         {
-            continue;
-        }
+            prefix = mPrefixIndex[i].mPrefix;
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+            if (mPrefixIndex[i].mBorderRouter == NULL)
+            {
+                continue;
+            }
 
-        if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
-        {
-            continue;
+            if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) >= 0)
+            {
+                ExitNow(rval = true);
+            }
         }
-
-        if (FindBorderRouter(*prefix) == NULL)
+    }
+    else
+    {
+        for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
+             cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+             cur = cur->GetNext())
         {
-            continue;
-        }
+            if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+            {
+                continue;
+            }
 
-        ExitNow(rval = true);
+            prefix = reinterpret_cast<PrefixTlv *>(cur);
+
+            if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
+            {
+                continue;
+            }
+
+            if (FindBorderRouter(*prefix) == NULL)
+            {
+                continue;
+            }
+
+            ExitNow(rval = true);
+        }
     }
 
 exit:
@@ -257,32 +424,64 @@ ThreadError Leader::RouteLookup(const Ip6::Address &aSource, const Ip6::Address
     ThreadError error = kThreadError_NoRoute;
     PrefixTlv *prefix;
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    UpdateIndex();
+
+    if (!mPrefixIndexOverflow)
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        for (uint8_t i = 0; i < mPrefixIndexCount; i++)
         {
-            continue;
-        }
+            prefix = mPrefixIndex[i].mPrefix;
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+            if (PrefixMatch(prefix->GetPrefix(), aSource.mFields.m8, prefix->GetPrefixLength()) >= 0)
+            {
+                if (ExternalRouteLookup(prefix->GetDomainId(), aDestination, aPrefixMatch, aRloc16) ==
+                    kThreadError_None)
+                {
+                    ExitNow(error = kThreadError_None);
+                }
 
-        if (PrefixMatch(prefix->GetPrefix(), aSource.mFields.m8, prefix->GetPrefixLength()) >= 0)
+                if (DefaultRouteLookup(*prefix, aRloc16) == kThreadError_None)
+                {
+                    if (aPrefixMatch)
+                    {
+                        *aPrefixMatch = 0;
+                    }
+
+                    ExitNow(error = kThreadError_None);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
+             cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+             cur = cur->GetNext())
         {
-            if (ExternalRouteLookup(prefix->GetDomainId(), aDestination, aPrefixMatch, aRloc16) == kThreadError_None)
+            if (cur->GetType() != NetworkDataTlv::kTypePrefix)
             {
-                ExitNow(error = kThreadError_None);
+                continue;
             }
 
-            if (DefaultRouteLookup(*prefix, aRloc16) == kThreadError_None)
+            prefix = reinterpret_cast<PrefixTlv *>(cur);
+
+            if (PrefixMatch(prefix->GetPrefix(), aSource.mFields.m8, prefix->GetPrefixLength()) >= 0)
             {
-                if (aPrefixMatch)
+                if (ExternalRouteLookup(prefix->GetDomainId(), aDestination, aPrefixMatch, aRloc16) ==
+                    kThreadError_None)
                 {
-                    *aPrefixMatch = 0;
+                    ExitNow(error = kThreadError_None);
                 }
 
-                ExitNow(error = kThreadError_None);
+                if (DefaultRouteLookup(*prefix, aRloc16) == kThreadError_None)
+                {
+                    if (aPrefixMatch)
+                    {
+                        *aPrefixMatch = 0;
+                    }
+
+                    ExitNow(error = kThreadError_None);
+                }
             }
         }
     }
@@ -296,64 +495,65 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
 {
     ThreadError error = kThreadError_NoRoute;
     PrefixTlv *prefix;
-    HasRouteTlv *hasRoute;
-    HasRouteEntry *entry;
     HasRouteEntry *rvalRoute = NULL;
     uint8_t rval_plen = 0;
     int8_t plen;
     NetworkDataTlv *cur;
-    NetworkDataTlv *subCur;
 
-    for (cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
-    {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
+    UpdateIndex();
 
-        prefix = reinterpret_cast<PrefixTlv *>(cur);
+    // the common miss case - a destination matching no on-mesh prefix and resolving to the
+    // default route - is answered by the filter without walking any prefixes
+    VerifyOrExit(MatchesPrefixFilter(aDestination), ;);
 
-        if (prefix->GetDomainId() != aDomainId)
+    if (!mPrefixIndexOverflow)
+    {
+        for (uint8_t i = 0; i < mPrefixIndexCount; i++)
         {
-            continue;
-        }
+            prefix = mPrefixIndex[i].mPrefix;
 
-        plen = PrefixMatch(prefix->GetPrefix(), aDestination.mFields.m8, prefix->GetPrefixLength());
+            if (prefix->GetDomainId() != aDomainId)
+            {
+                continue;
+            }
+
+            plen = PrefixMatch(prefix->GetPrefix(), aDestination.mFields.m8, prefix->GetPrefixLength());
 
-        if (plen > rval_plen)
+            if (plen > rval_plen)
+            {
+                SelectRoute(*prefix, static_cast<uint8_t>(plen), rvalRoute, rval_plen);
+            }
+        }
+    }
+    else
+    {
+        for (cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
+             cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
+             cur = cur->GetNext())
         {
-            // select border router
-            for (subCur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
-                 subCur < reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
-                 subCur = subCur->GetNext())
+            if (cur->GetType() != NetworkDataTlv::kTypePrefix)
             {
-                if (subCur->GetType() != NetworkDataTlv::kTypeHasRoute)
-                {
-                    continue;
-                }
+                continue;
+            }
 
-                hasRoute = reinterpret_cast<HasRouteTlv *>(subCur);
+            prefix = reinterpret_cast<PrefixTlv *>(cur);
 
-                for (uint8_t i = 0; i < hasRoute->GetNumEntries(); i++)
-                {
-                    entry = hasRoute->GetEntry(i);
+            if (prefix->GetDomainId() != aDomainId)
+            {
+                continue;
+            }
 
-                    if (rvalRoute == NULL ||
-                        entry->GetPreference() > rvalRoute->GetPreference() ||
-                        (entry->GetPreference() == rvalRoute->GetPreference() &&
-                         mMle.GetRouteCost(entry->GetRloc()) < mMle.GetRouteCost(rvalRoute->GetRloc())))
-                    {
-                        rvalRoute = entry;
-                        rval_plen = static_cast<uint8_t>(plen);
-                    }
-                }
+            plen = PrefixMatch(prefix->GetPrefix(), aDestination.mFields.m8, prefix->GetPrefixLength());
 
+            if (plen > rval_plen)
+            {
+                SelectRoute(*prefix, static_cast<uint8_t>(plen), rvalRoute, rval_plen);
             }
         }
     }
 
+exit:
+
     if (rvalRoute != NULL)
     {
         if (aRloc16 != NULL)
@@ -372,6 +572,39 @@ ThreadError Leader::ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &a
     return error;
 }
 
+void Leader::SelectRoute(PrefixTlv &aPrefix, uint8_t aPrefixMatch, HasRouteEntry *&aRoute, uint8_t &aPrefixLength)
+{
+    HasRouteTlv *hasRoute;
+    HasRouteEntry *entry;
+
+    // select border router
+    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs());
+         cur < reinterpret_cast<NetworkDataTlv *>(aPrefix.GetSubTlvs() + aPrefix.GetSubTlvsLength());
+         cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypeHasRoute)
+        {
+            continue;
+        }
+
+        hasRoute = reinterpret_cast<HasRouteTlv *>(cur);
+
+        for (uint8_t i = 0; i < hasRoute->GetNumEntries(); i++)
+        {
+            entry = hasRoute->GetEntry(i);
+
+            if (aRoute == NULL ||
+                entry->GetPreference() > aRoute->GetPreference() ||
+                (entry->GetPreference() == aRoute->GetPreference() &&
+                 mMle.GetRouteCost(entry->GetRloc()) < mMle.GetRouteCost(aRoute->GetRloc())))
+            {
+                aRoute = entry;
+                aPrefixLength = aPrefixMatch;
+            }
+        }
+    }
+}
+
 ThreadError Leader::DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16)
 {
     ThreadError error = kThreadError_NoRoute;
@@ -435,6 +668,9 @@ void Leader::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool aStab
         RemoveTemporaryData(mTlvs, mLength);
     }
 
+    // the supplied version may match the one the index was built against
+    ResetIndex();
+
     otDumpDebgNetData("set network data", mTlvs, mLength);
 
     mNetif.SetStateChangedFlags(OT_THREAD_NETDATA_UPDATED);
@@ -721,6 +957,120 @@ exit:
     return rval;
 }
 
+bool Leader::IsRegistrationUnchanged(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength)
+{
+    return ContainsEntriesFrom(aRloc16, aTlvs, aTlvsLength, mTlvs, mLength) &&
+           ContainsEntriesFrom(aRloc16, mTlvs, mLength, aTlvs, aTlvsLength);
+}
+
+bool Leader::ContainsEntriesFrom(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength, uint8_t *aTlvsBase,
+                                 uint8_t aTlvsBaseLength)
+{
+    bool rval = true;
+    bool found;
+    PrefixTlv *prefix;
+    PrefixTlv *prefixBase;
+    HasRouteTlv *hasRoute;
+    HasRouteTlv *hasRouteBase;
+    HasRouteEntry *hasRouteEntry;
+    BorderRouterTlv *borderRouter;
+    BorderRouterTlv *borderRouterBase;
+    BorderRouterEntry *borderRouterEntry;
+    NetworkDataTlv *subCur;
+
+    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aTlvs);
+         cur < reinterpret_cast<NetworkDataTlv *>(aTlvs + aTlvsLength);
+         cur = cur->GetNext())
+    {
+        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
+        {
+            continue;
+        }
+
+        prefix = reinterpret_cast<PrefixTlv *>(cur);
+        prefixBase = FindPrefix(prefix->GetPrefix(), prefix->GetPrefixLength(), aTlvsBase, aTlvsBaseLength);
+
+        for (subCur = reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs());
+             subCur < reinterpret_cast<NetworkDataTlv *>(prefix->GetSubTlvs() + prefix->GetSubTlvsLength());
+             subCur = subCur->GetNext())
+        {
+            switch (subCur->GetType())
+            {
+            case NetworkDataTlv::kTypeHasRoute:
+                hasRoute = reinterpret_cast<HasRouteTlv *>(subCur);
+
+                for (uint8_t i = 0; i < hasRoute->GetNumEntries(); i++)
+                {
+                    hasRouteEntry = hasRoute->GetEntry(i);
+
+                    if (hasRouteEntry->GetRloc() != aRloc16)
+                    {
+                        continue;
+                    }
+
+                    VerifyOrExit(prefixBase != NULL, rval = false);
+                    VerifyOrExit((hasRouteBase = FindHasRoute(*prefixBase, hasRoute->IsStable())) != NULL,
+                                 rval = false);
+
+                    found = false;
+
+                    for (uint8_t j = 0; j < hasRouteBase->GetNumEntries(); j++)
+                    {
+                        if (memcmp(hasRouteBase->GetEntry(j), hasRouteEntry, sizeof(HasRouteEntry)) == 0)
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
+
+                    VerifyOrExit(found, rval = false);
+                }
+
+                break;
+
+            case NetworkDataTlv::kTypeBorderRouter:
+                borderRouter = reinterpret_cast<BorderRouterTlv *>(subCur);
+
+                for (uint8_t i = 0; i < borderRouter->GetNumEntries(); i++)
+                {
+                    borderRouterEntry = borderRouter->GetEntry(i);
+
+                    if (borderRouterEntry->GetRloc() != aRloc16)
+                    {
+                        continue;
+                    }
+
+                    VerifyOrExit(prefixBase != NULL, rval = false);
+                    VerifyOrExit((borderRouterBase = FindBorderRouter(*prefixBase, borderRouter->IsStable())) != NULL,
+                                 rval = false);
+
+                    found = false;
+
+                    for (uint8_t j = 0; j < borderRouterBase->GetNumEntries(); j++)
+                    {
+                        if (memcmp(borderRouterBase->GetEntry(j), borderRouterEntry,
+                                   sizeof(BorderRouterEntry)) == 0)
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
+
+                    VerifyOrExit(found, rval = false);
+                }
+
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+exit:
+    return rval;
+}
+
 ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength)
 {
     ThreadError error = kThreadError_None;
@@ -732,6 +1082,10 @@ ThreadError Leader::RegisterNetworkData(uint16_t aRloc16, uint8_t *aTlvs, uint8_
 
     if (rlocIn)
     {
+        // an identical re-registration must not bump the version: every bump triggers a
+        // partition-wide MLE Data Response exchange that wakes all sleepy devices
+        VerifyOrExit(!IsRegistrationUnchanged(aRloc16, aTlvs, aTlvsLength), ;);
+
         if (IsStableUpdated(aRloc16, aTlvs, aTlvsLength, mTlvs, mLength) ||
             IsStableUpdated(aRloc16, mTlvs, mLength, aTlvs, aTlvsLength))
         {
@@ -842,8 +1196,10 @@ ThreadError Leader::AddHasRoute(PrefixTlv &aPrefix, HasRouteTlv &aHasRoute)
 
     if ((dstHasRoute = FindHasRoute(*dstPrefix, aHasRoute.IsStable())) == NULL)
     {
+        // measure the Has Route TLV and its entry together so the trailing
+        // network data is shifted once rather than once per insertion
         dstHasRoute = reinterpret_cast<HasRouteTlv *>(dstPrefix->GetNext());
-        Insert(reinterpret_cast<uint8_t *>(dstHasRoute), sizeof(HasRouteTlv));
+        Insert(reinterpret_cast<uint8_t *>(dstHasRoute), sizeof(HasRouteTlv) + sizeof(HasRouteEntry));
         dstPrefix->SetLength(dstPrefix->GetLength() + sizeof(HasRouteTlv));
         dstHasRoute->Init();
 
@@ -852,8 +1208,10 @@ ThreadError Leader::AddHasRoute(PrefixTlv &aPrefix, HasRouteTlv &aHasRoute)
             dstHasRoute->SetStable();
         }
     }
-
-    Insert(reinterpret_cast<uint8_t *>(dstHasRoute->GetNext()), sizeof(HasRouteEntry));
+    else
+    {
+        Insert(reinterpret_cast<uint8_t *>(dstHasRoute->GetNext()), sizeof(HasRouteEntry));
+    }
     dstHasRoute->SetLength(dstHasRoute->GetLength() + sizeof(HasRouteEntry));
     dstPrefix->SetLength(dstPrefix->GetLength() + sizeof(HasRouteEntry));
     memcpy(dstHasRoute->GetEntry(dstHasRoute->GetNumEntries() - 1), aHasRoute.GetEntry(0),
@@ -898,13 +1256,17 @@ ThreadError Leader::AddBorderRouter(PrefixTlv &aPrefix, BorderRouterTlv &aBorder
 
     if ((dstBorderRouter = FindBorderRouter(*dstPrefix, aBorderRouter.IsStable())) == NULL)
     {
+        // measure the Border Router TLV and its entry together so the trailing
+        // network data is shifted once rather than once per insertion
         dstBorderRouter = reinterpret_cast<BorderRouterTlv *>(dstPrefix->GetNext());
-        Insert(reinterpret_cast<uint8_t *>(dstBorderRouter), sizeof(BorderRouterTlv));
+        Insert(reinterpret_cast<uint8_t *>(dstBorderRouter), sizeof(BorderRouterTlv) + sizeof(BorderRouterEntry));
         dstPrefix->SetLength(dstPrefix->GetLength() + sizeof(BorderRouterTlv));
         dstBorderRouter->Init();
     }
-
-    Insert(reinterpret_cast<uint8_t *>(dstBorderRouter->GetNext()), sizeof(BorderRouterEntry));
+    else
+    {
+        Insert(reinterpret_cast<uint8_t *>(dstBorderRouter->GetNext()), sizeof(BorderRouterEntry));
+    }
     dstBorderRouter->SetLength(dstBorderRouter->GetLength() + sizeof(BorderRouterEntry));
     dstPrefix->SetLength(dstPrefix->GetLength() + sizeof(BorderRouterEntry));
     memcpy(dstBorderRouter->GetEntry(dstBorderRouter->GetNumEntries() - 1), aBorderRouter.GetEntry(0),
@@ -91,6 +91,18 @@ public:
      */
     void Stop(void);
 
+    /**
+     * This method provides a full or stable copy of the Thread Network Data.
+     *
+     * The stable copy is served from a pre-filtered image that is regenerated when the version changes.
+     *
+     * @param[in]     aStable      TRUE when copying the stable version, FALSE when copying the full version.
+     * @param[out]    aData        A pointer to the data buffer.
+     * @param[inout]  aDataLength  On entry, size of the data buffer pointed to by @p aData.
+     *                             On exit, number of copied bytes.
+     */
+    void GetNetworkData(bool aStable, uint8_t *aData, uint8_t &aDataLength);
+
     /**
      * This method returns the Thread Network Data version.
      *
@@ -277,9 +289,13 @@ private:
     ThreadError ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &destination,
                                     uint8_t *aPrefixMatch, uint16_t *aRloc16);
     ThreadError DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16);
+    void SelectRoute(PrefixTlv &aPrefix, uint8_t aPrefixMatch, HasRouteEntry *&aRoute, uint8_t &aPrefixLength);
     void RlocLookup(uint16_t aRloc16, bool &aIn, bool &aStable, uint8_t *aTlvs, uint8_t aTlvsLength);
     bool IsStableUpdated(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength, uint8_t *aTlvsBase,
                          uint8_t aTlvsBaseLength);
+    bool IsRegistrationUnchanged(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength);
+    bool ContainsEntriesFrom(uint16_t aRloc16, uint8_t *aTlvs, uint8_t aTlvsLength, uint8_t *aTlvsBase,
+                             uint8_t aTlvsBaseLength);
 
 
     /**
@@ -292,7 +308,43 @@ private:
         kNumContextIds       = 15,            ///< Maximum Context ID
         kContextIdReuseDelay = 48 * 60 * 60,  ///< CONTEXT_ID_REUSE_DELAY (seconds)
         kStateUpdatePeriod   = 1000,          ///< State update period in milliseconds
+        kMaxIndexedPrefixes  = 16,            ///< Number of Prefix TLVs the decoded index can hold
     };
+
+    struct PrefixIndexEntry
+    {
+        PrefixTlv       *mPrefix;        // Prefix TLV within mTlvs.
+        ContextTlv      *mContext;       // 6LoWPAN Context sub-TLV, or NULL.
+        BorderRouterTlv *mBorderRouter;  // Border Router sub-TLV, or NULL.
+    };
+
+    void ResetIndex(void);
+    void UpdateIndex(void);
+    void UpdateStableImage(void);
+    bool MatchesPrefixFilter(const Ip6::Address &aAddress) const;
+
+    // decoded index over the TLV store, rebuilt lazily when the version changes; when more
+    // prefixes exist than the index can hold, lookups fall back to walking the raw TLVs
+    PrefixIndexEntry mPrefixIndex[kMaxIndexedPrefixes];  // Sorted by descending prefix length.
+    PrefixTlv       *mContextMap[kNumContextIds];        // Context ID to Prefix TLV direct map.
+    uint8_t          mPrefixIndexCount;
+    uint8_t          mIndexVersion;
+    bool             mIndexValid;
+    bool             mPrefixIndexOverflow;
+
+    // membership filter over the first byte of all indexed prefixes, so that an address
+    // matching no on-mesh prefix is rejected with two bit tests; disabled when a prefix
+    // shorter than 8 bits exists
+    uint32_t         mPrefixFilter;
+    bool             mPrefixFilterActive;
+
+    // pre-filtered stable-only copy of the network data, regenerated when the version changes,
+    // so that serving a stable data request is a bounded memcpy
+    uint8_t          mStableTlvs[kMaxSize];
+    uint8_t          mStableLength;
+    uint8_t          mStableImageVersion;
+    bool             mStableImageValid;
+
     uint16_t mContextUsed;
     uint32_t mContextLastUsed[kNumContextIds];
     uint32_t mContextIdReuseDelay;
@@ -34,6 +34,7 @@
 #include <common/debug.hpp>
 #include <common/logging.hpp>
 #include <common/code_utils.hpp>
+#include <common/random.hpp>
 #include <mac/mac_frame.hpp>
 #include <thread/network_data_local.hpp>
 #include <thread/thread_netif.hpp>
@@ -44,6 +45,7 @@ namespace NetworkData {
 Local::Local(ThreadNetif &aThreadNetif):
     NetworkData(aThreadNetif, true),
     mOldRloc(Mac::kShortAddrInvalid),
+    mTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleTimer, this),
     mLeader(aThreadNetif.GetNetworkDataLeader())
 {
 }
@@ -217,6 +219,34 @@ bool Local::IsExternalRouteConsistent(void)
 }
 
 ThreadError Local::SendServerDataNotification(void)
+{
+    // a notification is already pending; it carries the latest local data when it fires
+    VerifyOrExit(!mTimer.IsRunning(), ;);
+
+    // spread registrations over a random delay so a site-wide configuration change
+    // does not land on the Leader as a synchronized burst from every device
+    mTimer.Start((Random::GetUint32() % kMaxNotificationDelay) + 1);
+
+exit:
+    return kThreadError_None;
+}
+
+void Local::HandleTimer(void *aContext)
+{
+    Local *obj = reinterpret_cast<Local *>(aContext);
+    obj->HandleTimer();
+}
+
+void Local::HandleTimer(void)
+{
+    // message buffers may free up shortly; retry after another randomized delay
+    if (SendServerDataNotificationNow() == kThreadError_NoBufs)
+    {
+        mTimer.Start((Random::GetUint32() % kMaxNotificationDelay) + 1);
+    }
+}
+
+ThreadError Local::SendServerDataNotificationNow(void)
 {
     ThreadError error = kThreadError_None;
     uint16_t rloc = mMle.GetRloc16();
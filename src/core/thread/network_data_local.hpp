@@ -34,6 +34,7 @@
 #ifndef NETWORK_DATA_LOCAL_HPP_
 #define NETWORK_DATA_LOCAL_HPP_
 
+#include <common/timer.hpp>
 #include <thread/network_data.hpp>
 
 namespace Thread {
@@ -121,15 +122,28 @@ public:
     ThreadError RemoveHasRoutePrefix(const uint8_t *aPrefix, uint8_t aPrefixLength);
 
     /**
-     * This method sends a Server Data Notification message to the Leader.
+     * This method schedules a Server Data Notification message to the Leader.
      *
-     * @retval kThreadError_None    Successfully enqueued the notification message.
-     * @retval kThreadError_NoBufs  Insufficient message buffers to generate the notification message.
+     * The notification is sent after a random delay to flatten bursts when many
+     * devices register at once, and is suppressed entirely if the Leader's Network
+     * Data already covers the local entries by then.
+     *
+     * @retval kThreadError_None    Successfully scheduled the notification message.
      *
      */
     ThreadError SendServerDataNotification(void);
 
 private:
+    enum
+    {
+        kMaxNotificationDelay = 3000,  ///< Maximum random delay before notifying the Leader (milliseconds).
+    };
+
+    static void HandleTimer(void *aContext);
+    void HandleTimer(void);
+
+    ThreadError SendServerDataNotificationNow(void);
+
     ThreadError UpdateRloc(void);
     ThreadError UpdateRloc(PrefixTlv &aPrefix);
     ThreadError UpdateRloc(HasRouteTlv &aHasRoute);
@@ -139,6 +153,7 @@ private:
     bool IsExternalRouteConsistent(void);
 
     uint16_t mOldRloc;
+    Timer mTimer;
 
     Leader &mLeader;
 };
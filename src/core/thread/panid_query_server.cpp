@@ -40,9 +40,12 @@
 #include <thread/thread_netif.hpp>
 #include <thread/thread_uris.hpp>
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
 namespace Thread {
 
 PanIdQueryServer::PanIdQueryServer(ThreadNetif &aThreadNetif) :
+    mCacheValid(false),
     mPanIdQuery(OPENTHREAD_URI_PANID_QUERY, &HandleQuery, this),
     mSocket(aThreadNetif.GetIp6().mUdp),
     mTimer(aThreadNetif.GetIp6().mTimerScheduler, &HandleTimer, this),
@@ -88,6 +91,23 @@ void PanIdQueryServer::HandleQuery(Coap::Header &aHeader, Message &aMessage, con
 
     mCommissioner = aMessageInfo.GetPeerAddr();
     mPanId = panId.GetPanId();
+
+    if (mCacheValid && mPanId == mCachedPanId &&
+        (mChannelMask & ~mCachedScanMask) == 0 &&
+        (Timer::GetNow() - mCacheTime) < kCacheLifetime)
+    {
+        // repeat of a recently answered query: report from the previous scan instead of scanning again
+        mChannelMask &= mCachedConflictMask;
+        SendQueryResponse(aHeader, aMessageInfo);
+
+        if (mChannelMask != 0)
+        {
+            SendConflict();
+        }
+
+        ExitNow();
+    }
+
     mTimer.Start(kScanDelay);
 
     SendQueryResponse(aHeader, aMessageInfo);
@@ -151,9 +171,16 @@ void PanIdQueryServer::HandleScanResult(Mac::Frame *aFrame)
             mChannelMask |= 1 << aFrame->GetChannel();
         }
     }
-    else if (mChannelMask != 0)
+    else
     {
-        SendConflict();
+        mCachedConflictMask = mChannelMask;
+        mCacheTime = Timer::GetNow();
+        mCacheValid = true;
+
+        if (mChannelMask != 0)
+        {
+            SendConflict();
+        }
     }
 }
 
@@ -227,6 +254,9 @@ void PanIdQueryServer::HandleTimer(void *aContext)
 void PanIdQueryServer::HandleTimer(void)
 {
     otLogInfoMeshCoP("%x\r\n", mChannelMask);
+    mCachedPanId = mPanId;
+    mCachedScanMask = mChannelMask;
+    mCacheValid = false;
     mNetif.GetMac().ActiveScan(mChannelMask, 0, HandleScanResult, this);
     mChannelMask = 0;
 }
@@ -239,3 +269,5 @@ void PanIdQueryServer::HandleUdpReceive(void *aContext, otMessage aMessage, cons
 }
 
 }  // namespace Thread
+
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
@@ -65,7 +65,8 @@ public:
 private:
     enum
     {
-        kScanDelay = 1000,  ///< SCAN_DELAY (milliseconds)
+        kScanDelay = 1000,       ///< SCAN_DELAY (milliseconds)
+        kCacheLifetime = 30000,  ///< Freshness window for answering repeat queries from cache (milliseconds)
     };
 
     static void HandleQuery(void *aContext, Coap::Header &aHeader, Message &aMessage,
@@ -87,6 +88,12 @@ private:
     uint32_t mChannelMask;
     uint16_t mPanId;
 
+    uint32_t mCachedScanMask;
+    uint32_t mCachedConflictMask;
+    uint32_t mCacheTime;
+    uint16_t mCachedPanId;
+    bool mCacheValid;
+
     Coap::Resource mPanIdQuery;
     Ip6::UdpSocket mSocket;
     Timer mTimer;
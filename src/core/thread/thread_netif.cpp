@@ -34,6 +34,7 @@
 #include <common/code_utils.hpp>
 #include <common/encoding.hpp>
 #include <common/message.hpp>
+#include <common/new.hpp>
 #include <net/ip6.hpp>
 #include <net/netif.hpp>
 #include <net/udp6.hpp>
@@ -57,6 +58,7 @@ static const char name[] = "thread";
 ThreadNetif::ThreadNetif(Ip6::Ip6 &aIp6):
     Netif(aIp6),
     mCoapServer(aIp6.mUdp, kCoapUdpPort),
+    mCoapClient(aIp6),
     mAddressResolver(*this),
     mActiveDataset(*this),
     mPendingDataset(*this),
@@ -68,18 +70,21 @@ ThreadNetif::ThreadNetif(Ip6::Ip6 &aIp6):
     mNetworkDataLocal(*this),
     mNetworkDataLeader(*this),
 #if OPENTHREAD_ENABLE_COMMISSIONER
-    mCommissioner(*this),
+    mCommissioner(NULL),
 #endif  // OPENTHREAD_ENABLE_COMMISSIONER
 #if OPENTHREAD_ENABLE_DTLS
-    mDtls(*this),
+    mDtls(NULL),
 #endif
 #if OPENTHREAD_ENABLE_JOINER
-    mJoiner(*this),
+    mJoiner(NULL),
 #endif  // OPENTHREAD_ENABLE_JOINER
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
     mJoinerRouter(*this),
     mLeader(*this),
     mPanIdQuery(*this),
-    mEnergyScan(*this)
+    mEnergyScan(*this),
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+    mIsUp(false)
 {
     mKeyManager.SetMasterKey(kThreadMasterKey, sizeof(kThreadMasterKey));
 }
@@ -89,6 +94,42 @@ const char *ThreadNetif::GetName(void) const
     return name;
 }
 
+#if OPENTHREAD_ENABLE_COMMISSIONER
+MeshCoP::Commissioner &ThreadNetif::GetCommissioner(void)
+{
+    if (mCommissioner == NULL)
+    {
+        mCommissioner = new(&mCommissionerRaw) MeshCoP::Commissioner(*this);
+    }
+
+    return *mCommissioner;
+}
+#endif  // OPENTHREAD_ENABLE_COMMISSIONER
+
+#if OPENTHREAD_ENABLE_DTLS
+MeshCoP::Dtls &ThreadNetif::GetDtls(void)
+{
+    if (mDtls == NULL)
+    {
+        mDtls = new(&mDtlsRaw) MeshCoP::Dtls(*this);
+    }
+
+    return *mDtls;
+}
+#endif  // OPENTHREAD_ENABLE_DTLS
+
+#if OPENTHREAD_ENABLE_JOINER
+MeshCoP::Joiner &ThreadNetif::GetJoiner(void)
+{
+    if (mJoiner == NULL)
+    {
+        mJoiner = new(&mJoinerRaw) MeshCoP::Joiner(*this);
+    }
+
+    return *mJoiner;
+}
+#endif  // OPENTHREAD_ENABLE_JOINER
+
 ThreadError ThreadNetif::Up(void)
 {
     ThreadError error = kThreadError_None;
@@ -98,6 +139,7 @@ ThreadError ThreadNetif::Up(void)
     mIp6.AddNetif(*this);
     mMeshForwarder.Start();
     mCoapServer.Start();
+    mCoapClient.Start();
     mMleRouter.Enable();
     mIsUp = true;
 
@@ -107,6 +149,7 @@ exit:
 
 ThreadError ThreadNetif::Down(void)
 {
+    mCoapClient.Stop();
     mCoapServer.Stop();
     mMleRouter.Disable();
     mMeshForwarder.Stop();
@@ -149,4 +192,9 @@ ThreadError ThreadNetif::SendMessage(Message &message)
     return mMeshForwarder.SendMessage(message);
 }
 
+bool ThreadNetif::MatchesSynthesizedAddress(const Ip6::Address &aAddress) const
+{
+    return mMleRouter.IsAssignedRlocAddress(aAddress);
+}
+
 }  // namespace Thread
@@ -40,22 +40,27 @@
 #include <openthread-config.h>
 #endif
 
+#include <openthread-core-config.h>
 #include <openthread-types.h>
 
+#include <coap/coap_client.hpp>
 #include <mac/mac.hpp>
-#include <meshcop/joiner_router.hpp>
-#include <meshcop/leader.hpp>
 #include <net/ip6_filter.hpp>
 #include <net/netif.hpp>
 #include <thread/address_resolver.hpp>
-#include <thread/energy_scan_server.hpp>
 #include <thread/key_manager.hpp>
 #include <thread/meshcop_dataset_manager.hpp>
 #include <thread/mesh_forwarder.hpp>
 #include <thread/mle.hpp>
 #include <thread/mle_router.hpp>
 #include <thread/network_data_local.hpp>
+
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+#include <meshcop/joiner_router.hpp>
+#include <meshcop/leader.hpp>
+#include <thread/energy_scan_server.hpp>
 #include <thread/panid_query_server.hpp>
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
 
 #if OPENTHREAD_ENABLE_COMMISSIONER
 #include <meshcop/commissioner.hpp>
@@ -151,6 +156,19 @@ public:
      */
     ThreadError RouteLookup(const Ip6::Address &aSource, const Ip6::Address &aDestination, uint8_t *aPrefixMatch);
 
+    /**
+     * This method indicates whether or not @p aAddress is the RLOC-derived mesh-local address, which
+     * is synthesized from the mesh-local prefix and the assigned RLOC16 rather than stored in the
+     * unicast address table.
+     *
+     * @param[in]  aAddress  A reference to the IPv6 address.
+     *
+     * @retval TRUE   If @p aAddress is the device's RLOC address.
+     * @retval FALSE  If @p aAddress is not the device's RLOC address.
+     *
+     */
+    bool MatchesSynthesizedAddress(const Ip6::Address &aAddress) const;
+
     /**
      * This method returns a pointer to the address resolver object.
      *
@@ -167,6 +185,14 @@ public:
      */
     Coap::Server &GetCoapServer(void) { return mCoapServer; }
 
+    /**
+     * This method returns a reference to the coap client object.
+     *
+     * @returns A reference to the coap client object.
+     *
+     */
+    Coap::Client &GetCoapClient(void) { return mCoapClient; }
+
     /**
      * This method returns a reference to the IPv6 filter object.
      *
@@ -235,22 +261,43 @@ public:
 
     MeshCoP::PendingDataset &GetPendingDataset(void) { return mPendingDataset; }
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
     MeshCoP::JoinerRouter &GetJoinerRouter(void) { return mJoinerRouter; }
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
 
 #if OPENTHREAD_ENABLE_COMMISSIONER
-    MeshCoP::Commissioner &GetCommissioner(void) { return mCommissioner; }
+    /**
+     * This method returns a reference to the commissioner object, constructing it on first use.
+     *
+     * @returns A reference to the commissioner object.
+     *
+     */
+    MeshCoP::Commissioner &GetCommissioner(void);
 #endif  // OPENTHREAD_ENABLE_COMMISSIONER
 
 #if OPENTHREAD_ENABLE_DTLS
-    MeshCoP::Dtls &GetDtls(void) { return mDtls; }
+    /**
+     * This method returns a reference to the DTLS object, constructing it on first use.
+     *
+     * @returns A reference to the DTLS object.
+     *
+     */
+    MeshCoP::Dtls &GetDtls(void);
 #endif  // OPENTHREAD_ENABLE_DTLS
 
 #if OPENTHREAD_ENABLE_JOINER
-    MeshCoP::Joiner &GetJoiner(void) { return mJoiner; }
+    /**
+     * This method returns a reference to the joiner object, constructing it on first use.
+     *
+     * @returns A reference to the joiner object.
+     *
+     */
+    MeshCoP::Joiner &GetJoiner(void);
 #endif  // OPENTHREAD_ENABLE_JOINER
 
 private:
     Coap::Server mCoapServer;
+    Coap::Client mCoapClient;
     AddressResolver mAddressResolver;
     MeshCoP::ActiveDataset mActiveDataset;
     MeshCoP::PendingDataset mPendingDataset;
@@ -262,24 +309,33 @@ private:
     Mle::MleRouter mMleRouter;
     NetworkData::Local mNetworkDataLocal;
     NetworkData::Leader mNetworkDataLeader;
-    bool mIsUp;
 
+    // the commissioning objects below are off the attach path, so they are
+    // constructed lazily on first use to keep initialization off the wake
+    // -> attach -> report -> sleep cycle of battery-powered devices
 #if OPENTHREAD_ENABLE_COMMISSIONER
-    MeshCoP::Commissioner mCommissioner;
+    MeshCoP::Commissioner *mCommissioner;
+    otDEFINE_ALIGNED_VAR(mCommissionerRaw, sizeof(MeshCoP::Commissioner), uint64_t);
 #endif  // OPENTHREAD_ENABLE_COMMISSIONER
 
 #if OPENTHREAD_ENABLE_DTLS
-    MeshCoP::Dtls mDtls;
+    MeshCoP::Dtls *mDtls;
+    otDEFINE_ALIGNED_VAR(mDtlsRaw, sizeof(MeshCoP::Dtls), uint64_t);
 #endif// OPENTHREAD_ENABLE_DTLS
 
 #if OPENTHREAD_ENABLE_JOINER
-    MeshCoP::Joiner mJoiner;
+    MeshCoP::Joiner *mJoiner;
+    otDEFINE_ALIGNED_VAR(mJoinerRaw, sizeof(MeshCoP::Joiner), uint64_t);
 #endif  // OPENTHREAD_ENABLE_JOINER
 
+#if OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
     MeshCoP::JoinerRouter mJoinerRouter;
     MeshCoP::Leader mLeader;
     PanIdQueryServer mPanIdQuery;
     EnergyScanServer mEnergyScan;
+#endif  // OPENTHREAD_CONFIG_ENABLE_COMMISSIONING_SERVICE
+
+    bool mIsUp;
 };
 
 /**
@@ -293,6 +349,7 @@ struct ThreadMessageInfo
     int8_t   mRss;           ///< Received Signal Strength in dBm.
     uint8_t  mLqi;           ///< Link Quality Indicator for a received message.
     bool     mLinkSecurity;  ///< Indicates whether or not link security is enabled.
+    uint32_t mTimestamp;     ///< Receive timestamp captured at SFD detection (platform alarm milliseconds).
 };
 
 /**
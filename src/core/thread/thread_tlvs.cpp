@@ -33,34 +33,18 @@
 
 #include <common/code_utils.hpp>
 #include <common/message.hpp>
+#include <common/tlv_iterator.hpp>
 #include <thread/thread_tlvs.hpp>
 
 namespace Thread {
 
 ThreadError ThreadTlv::GetTlv(const Message &message, Type type, uint16_t maxLength, ThreadTlv &tlv)
 {
-    ThreadError error = kThreadError_Parse;
-    uint16_t offset = message.GetOffset();
-    uint16_t end = message.GetLength();
+    ThreadError error;
+    TlvIterator iterator(message);
 
-    while (offset < end)
-    {
-        message.Read(offset, sizeof(ThreadTlv), &tlv);
-
-        if (tlv.GetType() == type && (offset + sizeof(tlv) + tlv.GetLength()) <= end)
-        {
-            if (maxLength > sizeof(tlv) + tlv.GetLength())
-            {
-                maxLength = sizeof(tlv) + tlv.GetLength();
-            }
-
-            message.Read(offset, maxLength, &tlv);
-
-            ExitNow(error = kThreadError_None);
-        }
-
-        offset += sizeof(tlv) + tlv.GetLength();
-    }
+    SuccessOrExit(error = iterator.SeekTo(static_cast<uint8_t>(type)));
+    iterator.ReadTlv(maxLength, &tlv);
 
 exit:
     return error;
@@ -106,6 +106,14 @@ namespace Thread {
  */
 #define OPENTHREAD_URI_ENERGY_REPORT    "c/er"
 
+/**
+ * @def OPENTHREAD_URI_ENERGY_HISTORY
+ *
+ * The URI Path for Energy Scan History
+ *
+ */
+#define OPENTHREAD_URI_ENERGY_HISTORY   "c/eh"
+
 /**
  * @def OPENTHREAD_URI_PENDING_GET
  *
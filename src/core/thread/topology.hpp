@@ -49,7 +49,28 @@ namespace Thread {
 class Neighbor
 {
 public:
+    /**
+     * Neighbor link states.
+     *
+     */
+    enum State
+    {
+        kStateInvalid,                   ///< Neighbor link is invalid
+        kStateParentRequest,             ///< Received an MLE Parent Request message
+        kStateChildIdRequest,            ///< Received an MLE Child ID Request message
+        kStateLinkRequest,               ///< Sent a MLE Link Request message
+        kStateValid,                     ///< Link is valid
+    };
+
+    // Fields read by per-frame neighbor lookups, security checks and the aging sweep lead the
+    // class so scanning the topology tables touches only the first cache line of each entry.
     Mac::ExtAddress mMacAddr;            ///< The IEEE 802.15.4 Extended Address
+    State           mState : 3;          ///< The link state
+    uint8_t         mMode : 4;           ///< The MLE device mode
+    bool            mDataRequest : 1;    ///< Indicates whether or not a Data Poll was received
+    bool            mLastRxValid : 1;    ///< Indicates whether or not mLastRxSequence is valid
+    bool            mPerWindowValid : 1; ///< Indicates whether or not a full error rate window completed
+    uint8_t         mLastRxSequence;     ///< The sequence number of the most recently accepted frame
     uint32_t        mLastHeard;          ///< Time when last heard.
     union
     {
@@ -67,24 +88,153 @@ public:
     };
 
     uint32_t mKeySequence;               ///< Current key sequence
+    uint32_t mLinkFrameCounterMask;      ///< Replay bitmap over the window below the next expected counter
 
     /**
-     * Neighbor link states.
+     * Transmit history parameters.
      *
      */
-    enum State
+    enum
     {
-        kStateInvalid,                   ///< Neighbor link is invalid
-        kStateParentRequest,             ///< Received an MLE Parent Request message
-        kStateChildIdRequest,            ///< Received an MLE Child ID Request message
-        kStateLinkRequest,               ///< Sent a MLE Link Request message
-        kStateValid,                     ///< Link is valid
+        kTxFailRateMax   = 255,          ///< mTxFailRate value when every recent attempt failed.
+        kTxHistoryWeight = 3,            ///< EWMA weight (1 / 2^n) applied to each transmit attempt.
+        kAckRttWeight    = 3,            ///< EWMA weight (1 / 2^n) applied to each ack turnaround sample.
+        kAckRttVarWeight = 2,            ///< EWMA weight (1 / 2^n) applied to the ack turnaround deviation.
+        kPerWindowSize   = 64,           ///< MAC transmit attempts per completed frame error rate window.
     };
 
-    State           mState : 3;          ///< The link state
-    uint8_t         mMode : 4;           ///< The MLE device mode
-    bool            mDataRequest : 1;    ///< Indicates whether or not a Data Poll was received
+    /**
+     * Frame counter acceptance parameters.
+     *
+     */
+    enum
+    {
+        kFrameCounterWindow = 32,        ///< Size of the sliding link frame counter acceptance window.
+    };
+
+    /**
+     * This method indicates whether or not a received link frame counter is acceptable.
+     *
+     * Counters at or above the next expected value are always acceptable. Counters within the
+     * sliding window below it are acceptable when not already received, which tolerates minor
+     * reordering without opening a replay hole.
+     *
+     * @param[in]  aFrameCounter  The received link frame counter.
+     *
+     * @retval TRUE   If the frame counter may be accepted.
+     * @retval FALSE  If the frame counter is a replay or falls below the window.
+     *
+     */
+    bool IsLinkFrameCounterAcceptable(uint32_t aFrameCounter) const {
+        bool rval = true;
+
+        if (aFrameCounter < mValid.mLinkFrameCounter)
+        {
+            uint32_t offset = mValid.mLinkFrameCounter - 1 - aFrameCounter;
+            rval = (offset < kFrameCounterWindow) &&
+                   ((mLinkFrameCounterMask & (static_cast<uint32_t>(1) << offset)) == 0);
+        }
+
+        return rval;
+    }
+
+    /**
+     * This method records a link frame counter that passed security verification.
+     *
+     * @param[in]  aFrameCounter  The verified link frame counter.
+     *
+     */
+    void MarkLinkFrameCounter(uint32_t aFrameCounter) {
+        if (aFrameCounter >= mValid.mLinkFrameCounter)
+        {
+            uint32_t shift = aFrameCounter + 1 - mValid.mLinkFrameCounter;
+            mLinkFrameCounterMask = (shift >= kFrameCounterWindow) ? 0 : (mLinkFrameCounterMask << shift);
+            mLinkFrameCounterMask |= 1;
+            mValid.mLinkFrameCounter = aFrameCounter + 1;
+        }
+        else
+        {
+            mLinkFrameCounterMask |= (static_cast<uint32_t>(1) << (mValid.mLinkFrameCounter - 1 - aFrameCounter));
+        }
+    }
+
+    /**
+     * This method resets the link frame counter acceptance window.
+     *
+     * @param[in]  aFrameCounter  The next expected link frame counter.
+     *
+     */
+    void ResetLinkFrameCounter(uint32_t aFrameCounter) {
+        mValid.mLinkFrameCounter = aFrameCounter;
+        mLinkFrameCounterMask = 0;
+    }
+
+    /**
+     * This method returns the measured MAC frame error rate toward this neighbor.
+     *
+     * The rate is computed from windowed counts of per-attempt ack outcomes, blending the last
+     * completed window with the window in progress, and is scaled so that 255 means every
+     * attempt failed. A neighbor with no attempts on record reports zero.
+     *
+     * @returns The frame error rate, scaled to 0-255.
+     *
+     */
+    uint8_t GetFrameErrorRate(void) const {
+        uint16_t attempts = mTxAttemptWindow;
+        uint16_t failures = mTxFailWindow;
+
+        if (mPerWindowValid)
+        {
+            attempts += kPerWindowSize;
+            failures += mTxFailLastWindow;
+        }
+
+        return (attempts != 0) ? static_cast<uint8_t>((failures * 255) / attempts) : 0;
+    }
+
+    /**
+     * This method returns the extended address rendered as a hex string for logging.
+     *
+     * The rendering is cached and refreshed only when the extended address changes, so enabled
+     * log sites consume it through a plain %s without paying for formatting.
+     *
+     * @returns A pointer to the NULL-terminated extended address string.
+     *
+     */
+    const char *GetExtAddrString(void) {
+        static const char kHexChars[] = "0123456789abcdef";
+
+        if (memcmp(&mExtAddrStringSource, &mMacAddr, sizeof(mMacAddr)) != 0)
+        {
+            for (size_t i = 0; i < sizeof(mMacAddr.m8); i++)
+            {
+                mExtAddrString[i * 2] = kHexChars[mMacAddr.m8[i] >> 4];
+                mExtAddrString[i * 2 + 1] = kHexChars[mMacAddr.m8[i] & 0x0f];
+            }
+
+            mExtAddrString[sizeof(mMacAddr.m8) * 2] = '\0';
+            mExtAddrStringSource = mMacAddr;
+        }
+
+        return mExtAddrString;
+    }
+
+    // Transmit history and link statistics are only touched for the single entry a frame
+    // resolves to, so they trail the scan-hot fields above.
+    uint32_t        mLastAcked;          ///< Time when a transmitted frame was last acknowledged.
+    uint8_t         mTxFailRate;         ///< EWMA of unacked MAC transmit attempts (0 = every attempt acked)
+    uint8_t         mTxAttemptWindow;    ///< Transmit attempts counted toward the current error rate window
+    uint8_t         mTxFailWindow;       ///< Failed attempts in the current error rate window
+    uint8_t         mTxFailLastWindow;   ///< Failed attempts in the last completed error rate window
+    uint16_t        mAckRtt;             ///< Smoothed ack turnaround time (1/8 millisecond units, 0 = no samples)
+    uint16_t        mAckRttVar;          ///< Smoothed ack turnaround deviation (1/8 millisecond units)
+    uint32_t        mTxAirtime;          ///< Accumulated transmit airtime toward this neighbor (microseconds)
+    uint32_t        mRxAirtime;          ///< Accumulated receive airtime from this neighbor (microseconds)
     LinkQualityInfo mLinkInfo;           ///< Link quality info (contains average RSS, link margin and link quality)
+
+private:
+    char            mExtAddrString[sizeof(Mac::ExtAddress) * 2 + 1];  ///< Cached hex rendering of mMacAddr
+    Mac::ExtAddress mExtAddrStringSource;                             ///< Address value the cache was rendered from
 };
 
 /**
@@ -98,11 +248,21 @@ public:
     {
         kMaxIp6AddressPerChild = OPENTHREAD_CONFIG_IP_ADDRS_PER_CHILD,
     };
-    Ip6::Address mIp6Address[kMaxIp6AddressPerChild];  ///< Registered IPv6 addresses
+
+    // The aging sweep and indirect transmit queue walk read these leading fields; the registered
+    // address array and attach-time state form the cold tail of each entry.
     uint32_t     mTimeout;                             ///< Child timeout
+    Message     *mIndirectMessage;                     ///< First send-queue message pending for this child
+    uint16_t     mIndirectMessageCount;                ///< Number of send-queue messages pending for this child
     uint16_t     mFragmentOffset;                      ///< 6LoWPAN fragment offset
-    uint8_t      mRequestTlvs[5];                      ///< Requested MLE TLVs
     uint8_t      mNetworkDataVersion;                  ///< Current Network Data version
+    bool         mTimeoutProbeSent;                    ///< Indicates a pre-expiry probe was sent this timeout window
+    uint8_t      mRequestTlvs[5];                      ///< Requested MLE TLVs
+    uint8_t      mRequestChallenge[Mle::ChallengeTlv::kMaxSize];  ///< Challenge from the Parent Request
+    uint8_t      mRequestChallengeLength;              ///< Length of the Parent Request challenge
+    uint32_t     mParentResponseTime;                  ///< Time at which the delayed Parent Response is due
+    bool         mParentResponsePending;               ///< Indicates a Parent Response is waiting on jitter
+    Ip6::Address mIp6Address[kMaxIp6AddressPerChild];  ///< Registered IPv6 addresses
 };
 
 /**
@@ -113,6 +273,7 @@ class Router : public Neighbor
 {
 public:
     uint8_t mNextHop;             ///< The next hop towards this router
+    uint8_t mRoutePenalty;        ///< Route dampening penalty accumulated from next hop changes
     uint8_t mLinkQualityOut : 2;  ///< The link quality out for this router
     uint8_t mCost : 4;            ///< The cost to this router
     bool    mAllocated : 1;       ///< Indicates whether or not this entry is allocated
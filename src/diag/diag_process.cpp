@@ -51,20 +51,38 @@ const struct Command Diag::sCommands[] =
     { "repeat", &ProcessRepeat },
     { "sleep", &ProcessSleep },
     { "stats", &ProcessStats },
+    { "bench", &ProcessBench },
 };
 
 char Diag::sDiagOutput[MAX_DIAG_OUTPUT];
 struct DiagStats Diag::sStats;
+struct DiagBenchStats Diag::sBenchStats;
 
 int8_t Diag::sTxPower;
 uint8_t Diag::sChannel;
 uint8_t Diag::sTxLen;
 uint32_t Diag::sTxPeriod;
 uint32_t Diag::sTxPackets;
+bool Diag::sBenchTxActive;
+bool Diag::sBenchRxActive;
+uint8_t Diag::sBenchTxLen;
+uint32_t Diag::sBenchTxPeriod;
+uint32_t Diag::sBenchTxRemaining;
+uint32_t Diag::sBenchTxSeq;
+uint32_t Diag::sBenchLastSeq;
+uint32_t Diag::sBenchBaseline;
+uint32_t Diag::sBenchLastRxTime;
 otInstance *Diag::sContext;
 
 void Diag::Init(otInstance *aInstance)
 {
+    // initialization is deferred to the first diagnostics command; later
+    // calls must not reset the statistics
+    if (sContext != NULL)
+    {
+        return;
+    }
+
     sContext = aInstance;
     sChannel = 20;
     sTxPower = 0;
@@ -72,9 +90,12 @@ void Diag::Init(otInstance *aInstance)
     sTxLen = 0;
     sTxPackets = 0;
     memset(&sStats, 0, sizeof(struct DiagStats));
+    sBenchTxActive = false;
+    sBenchRxActive = false;
+    BenchReset();
 }
 
-char *Diag::ProcessCmd(int argc, char *argv[])
+OT_TOOL_COLD_CODE char *Diag::ProcessCmd(int argc, char *argv[])
 {
     unsigned int i;
 
@@ -330,6 +351,276 @@ exit:
     AppendErrorResult(error, aOutput, aOutputMaxLen);
 }
 
+void Diag::BenchReset(void)
+{
+    memset(&sBenchStats, 0, sizeof(struct DiagBenchStats));
+    sBenchStats.gap_min = 0xffffffff;
+    sBenchStats.rssi_min = 127;
+    sBenchStats.rssi_max = -128;
+    sBenchLastSeq = 0;
+    sBenchBaseline = 0;
+    sBenchLastRxTime = 0;
+}
+
+void Diag::BenchTxFrame(void)
+{
+    RadioPacket *packet = otPlatRadioGetTransmitBuffer(sContext);
+    uint32_t now = otPlatAlarmGetNow();
+
+    sBenchTxRemaining--;
+    sBenchTxSeq++;
+
+    packet->mLength = sBenchTxLen;
+    packet->mChannel = sChannel;
+    packet->mPower = sTxPower;
+
+    packet->mPsdu[0] = kBenchFrameMagic0;
+    packet->mPsdu[1] = kBenchFrameMagic1;
+    BenchEncodeUint32(&packet->mPsdu[2], sBenchTxSeq);
+    BenchEncodeUint32(&packet->mPsdu[6], now);
+
+    for (uint8_t i = kBenchHeaderLength; i < sBenchTxLen; i++)
+    {
+        packet->mPsdu[i] = i;
+    }
+
+    otPlatRadioTransmit(sContext);
+}
+
+void Diag::BenchReceiveFrame(RadioPacket *aFrame)
+{
+    uint32_t now = otPlatAlarmGetNow();
+    uint32_t seq = (static_cast<uint32_t>(aFrame->mPsdu[2]) << 24) | (static_cast<uint32_t>(aFrame->mPsdu[3]) << 16) |
+                   (static_cast<uint32_t>(aFrame->mPsdu[4]) << 8) | aFrame->mPsdu[5];
+    uint32_t timestamp = (static_cast<uint32_t>(aFrame->mPsdu[6]) << 24) | (static_cast<uint32_t>(aFrame->mPsdu[7]) << 16) |
+                         (static_cast<uint32_t>(aFrame->mPsdu[8]) << 8) | aFrame->mPsdu[9];
+
+    // sender and receiver clocks are not synchronized, but the unknown offset is
+    // constant over a run, so the spread above the fastest observed delivery still
+    // measures latency jitter
+    uint32_t latency = now - timestamp;
+    uint32_t delta;
+    uint32_t gap;
+    uint8_t bucket = 0;
+
+    if (sBenchStats.rx_frames == 0)
+    {
+        sBenchBaseline = latency;
+        sBenchLastSeq = seq;
+    }
+    else
+    {
+        gap = now - sBenchLastRxTime;
+
+        if (gap < sBenchStats.gap_min)
+        {
+            sBenchStats.gap_min = gap;
+        }
+
+        if (gap > sBenchStats.gap_max)
+        {
+            sBenchStats.gap_max = gap;
+        }
+
+        sBenchStats.gap_sum += gap;
+
+        if (seq <= sBenchLastSeq)
+        {
+            sBenchStats.dup_frames++;
+        }
+        else
+        {
+            sBenchStats.lost_frames += seq - sBenchLastSeq - 1;
+            sBenchLastSeq = seq;
+        }
+
+        if (latency < sBenchBaseline)
+        {
+            sBenchBaseline = latency;
+        }
+    }
+
+    delta = latency - sBenchBaseline;
+
+    while (delta != 0 && bucket < kBenchHistogramSize - 1)
+    {
+        delta >>= 1;
+        bucket++;
+    }
+
+    sBenchStats.latency_histogram[bucket]++;
+    sBenchStats.rx_frames++;
+    sBenchStats.rx_bytes += aFrame->mLength;
+
+    if (aFrame->mPower < sBenchStats.rssi_min)
+    {
+        sBenchStats.rssi_min = aFrame->mPower;
+    }
+
+    if (aFrame->mPower > sBenchStats.rssi_max)
+    {
+        sBenchStats.rssi_max = aFrame->mPower;
+    }
+
+    sBenchStats.rssi_sum += aFrame->mPower;
+    sBenchLastRxTime = now;
+}
+
+uint8_t Diag::AppendBenchTlv(uint8_t *aBuffer, uint8_t aOffset, uint8_t aType, const void *aValue, uint8_t aLength)
+{
+    aBuffer[aOffset] = aType;
+    aBuffer[aOffset + 1] = aLength;
+    memcpy(&aBuffer[aOffset + 2], aValue, aLength);
+    return static_cast<uint8_t>(aOffset + 2 + aLength);
+}
+
+void Diag::BenchEncodeUint32(uint8_t *aBuffer, uint32_t aValue)
+{
+    aBuffer[0] = static_cast<uint8_t>(aValue >> 24);
+    aBuffer[1] = static_cast<uint8_t>(aValue >> 16);
+    aBuffer[2] = static_cast<uint8_t>(aValue >> 8);
+    aBuffer[3] = static_cast<uint8_t>(aValue);
+}
+
+void Diag::ProcessBench(int argc, char *argv[], char *aOutput, size_t aOutputMaxLen)
+{
+    ThreadError error = kThreadError_None;
+    long value;
+
+    VerifyOrExit(otPlatDiagModeGet(), error = kThreadError_InvalidState);
+    VerifyOrExit(argc > 0, error = kThreadError_InvalidArgs);
+
+    if (strcmp(argv[0], "tx") == 0)
+    {
+        VerifyOrExit(argc == 4, error = kThreadError_InvalidArgs);
+
+        SuccessOrExit(error = ParseLong(argv[1], value));
+        VerifyOrExit(value > 0, error = kThreadError_InvalidArgs);
+        sBenchTxRemaining = static_cast<uint32_t>(value);
+
+        SuccessOrExit(error = ParseLong(argv[2], value));
+        VerifyOrExit(value >= kBenchHeaderLength && value <= kMaxPHYPacketSize, error = kThreadError_InvalidArgs);
+        sBenchTxLen = static_cast<uint8_t>(value);
+
+        SuccessOrExit(error = ParseLong(argv[3], value));
+        VerifyOrExit(value > 0, error = kThreadError_InvalidArgs);
+        sBenchTxPeriod = static_cast<uint32_t>(value);
+
+        BenchReset();
+        sBenchTxSeq = 0;
+        sBenchTxActive = true;
+        otPlatAlarmStartAt(sContext, otPlatAlarmGetNow(), sBenchTxPeriod);
+
+        snprintf(aOutput, aOutputMaxLen, "benchmark: sending %d frame(s) of length %d every %d ms\r\nstatus 0x%02x\r\n",
+                 static_cast<int>(sBenchTxRemaining), static_cast<int>(sBenchTxLen),
+                 static_cast<int>(sBenchTxPeriod), error);
+    }
+    else if (strcmp(argv[0], "rx") == 0)
+    {
+        BenchReset();
+        sBenchRxActive = true;
+        snprintf(aOutput, aOutputMaxLen, "benchmark receiver armed\r\nstatus 0x%02x\r\n", error);
+    }
+    else if (strcmp(argv[0], "stop") == 0)
+    {
+        if (sBenchTxActive)
+        {
+            otPlatAlarmStop(sContext);
+        }
+
+        sBenchTxActive = false;
+        sBenchRxActive = false;
+        snprintf(aOutput, aOutputMaxLen, "benchmark stopped\r\nstatus 0x%02x\r\n", error);
+    }
+    else if (strcmp(argv[0], "stats") == 0)
+    {
+        uint32_t samples = (sBenchStats.rx_frames > 1) ? sBenchStats.rx_frames - 1 : 0;
+        int written;
+
+        written = snprintf(aOutput, aOutputMaxLen,
+                           "tx frames: %d\r\nrx frames: %d\r\nrx bytes: %d\r\nlost: %d\r\ndup: %d\r\nlatency spread:",
+                           static_cast<int>(sBenchStats.tx_frames), static_cast<int>(sBenchStats.rx_frames),
+                           static_cast<int>(sBenchStats.rx_bytes), static_cast<int>(sBenchStats.lost_frames),
+                           static_cast<int>(sBenchStats.dup_frames));
+
+        for (unsigned i = 0; i < kBenchHistogramSize && written > 0 &&
+             static_cast<size_t>(written) < aOutputMaxLen; i++)
+        {
+            written += snprintf(aOutput + written, aOutputMaxLen - static_cast<size_t>(written), " %d",
+                                static_cast<int>(sBenchStats.latency_histogram[i]));
+        }
+
+        if (written > 0 && static_cast<size_t>(written) < aOutputMaxLen)
+        {
+            snprintf(aOutput + written, aOutputMaxLen - static_cast<size_t>(written),
+                     "\r\ngap min/avg/max: %d/%d/%d ms\r\nrssi min/avg/max: %d/%d/%d dBm\r\n",
+                     static_cast<int>((samples != 0) ? sBenchStats.gap_min : 0),
+                     static_cast<int>((samples != 0) ? sBenchStats.gap_sum / samples : 0),
+                     static_cast<int>(sBenchStats.gap_max),
+                     static_cast<int>((sBenchStats.rx_frames != 0) ? sBenchStats.rssi_min : 0),
+                     static_cast<int>((sBenchStats.rx_frames != 0) ?
+                                      sBenchStats.rssi_sum / static_cast<int32_t>(sBenchStats.rx_frames) : 0),
+                     static_cast<int>((sBenchStats.rx_frames != 0) ? sBenchStats.rssi_max : 0));
+        }
+    }
+    else if (strcmp(argv[0], "dump") == 0)
+    {
+        uint8_t tlvs[2 * 6 + 3 * 6 + (2 + 4 * kBenchHistogramSize) + (2 + 12) + (2 + 3)];
+        uint8_t tlvLength = 0;
+        uint8_t scratch[4 * kBenchHistogramSize];
+        uint32_t samples = (sBenchStats.rx_frames > 1) ? sBenchStats.rx_frames - 1 : 0;
+        int written;
+
+        BenchEncodeUint32(scratch, sBenchStats.tx_frames);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvTxFrames, scratch, sizeof(uint32_t));
+        BenchEncodeUint32(scratch, sBenchStats.rx_frames);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvRxFrames, scratch, sizeof(uint32_t));
+        BenchEncodeUint32(scratch, sBenchStats.rx_bytes);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvRxBytes, scratch, sizeof(uint32_t));
+        BenchEncodeUint32(scratch, sBenchStats.lost_frames);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvLost, scratch, sizeof(uint32_t));
+        BenchEncodeUint32(scratch, sBenchStats.dup_frames);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvDup, scratch, sizeof(uint32_t));
+
+        for (unsigned i = 0; i < kBenchHistogramSize; i++)
+        {
+            BenchEncodeUint32(&scratch[4 * i], sBenchStats.latency_histogram[i]);
+        }
+
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvLatency, scratch, 4 * kBenchHistogramSize);
+
+        BenchEncodeUint32(&scratch[0], (samples != 0) ? sBenchStats.gap_min : 0);
+        BenchEncodeUint32(&scratch[4], (samples != 0) ? sBenchStats.gap_sum / samples : 0);
+        BenchEncodeUint32(&scratch[8], sBenchStats.gap_max);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvGap, scratch, 12);
+
+        scratch[0] = static_cast<uint8_t>((sBenchStats.rx_frames != 0) ? sBenchStats.rssi_min : 0);
+        scratch[1] = static_cast<uint8_t>((sBenchStats.rx_frames != 0) ?
+                                          sBenchStats.rssi_sum / static_cast<int32_t>(sBenchStats.rx_frames) : 0);
+        scratch[2] = static_cast<uint8_t>((sBenchStats.rx_frames != 0) ? sBenchStats.rssi_max : 0);
+        tlvLength = AppendBenchTlv(tlvs, tlvLength, kBenchTlvRssi, scratch, 3);
+
+        written = snprintf(aOutput, aOutputMaxLen, "dump: ");
+
+        for (uint8_t i = 0; i < tlvLength && written > 0 && static_cast<size_t>(written) + 4 < aOutputMaxLen; i++)
+        {
+            written += snprintf(aOutput + written, aOutputMaxLen - static_cast<size_t>(written), "%02x", tlvs[i]);
+        }
+
+        if (written > 0 && static_cast<size_t>(written) + 2 < aOutputMaxLen)
+        {
+            snprintf(aOutput + written, aOutputMaxLen - static_cast<size_t>(written), "\r\n");
+        }
+    }
+    else
+    {
+        ExitNow(error = kThreadError_InvalidArgs);
+    }
+
+exit:
+    AppendErrorResult(error, aOutput, aOutputMaxLen);
+}
+
 void Diag::DiagTransmitDone(otInstance *aInstance, bool aRxPending, ThreadError aError)
 {
     (void)aInstance;
@@ -337,7 +628,16 @@ void Diag::DiagTransmitDone(otInstance *aInstance, bool aRxPending, ThreadError
     {
         sStats.sent_packets++;
 
-        if (sTxPackets > 0)
+        if (sBenchTxActive)
+        {
+            sBenchStats.tx_frames++;
+
+            if (sBenchTxRemaining == 0)
+            {
+                sBenchTxActive = false;
+            }
+        }
+        else if (sTxPackets > 0)
         {
             TxPacket();
         }
@@ -357,6 +657,12 @@ void Diag::DiagReceiveDone(otInstance *aInstance, RadioPacket *aFrame, ThreadErr
         }
 
         sStats.received_packets++;
+
+        if (sBenchRxActive && aFrame->mLength >= kBenchHeaderLength &&
+            aFrame->mPsdu[0] == kBenchFrameMagic0 && aFrame->mPsdu[1] == kBenchFrameMagic1)
+        {
+            BenchReceiveFrame(aFrame);
+        }
     }
 
     otPlatRadioReceive(aInstance, sChannel);
@@ -366,8 +672,20 @@ void Diag::AlarmFired(otInstance *aInstance)
 {
     uint32_t now = otPlatAlarmGetNow();
 
-    TxPacket();
-    otPlatAlarmStartAt(aInstance, now, sTxPeriod);
+    if (sBenchTxActive)
+    {
+        BenchTxFrame();
+
+        if (sBenchTxRemaining > 0)
+        {
+            otPlatAlarmStartAt(aInstance, now, sBenchTxPeriod);
+        }
+    }
+    else
+    {
+        TxPacket();
+        otPlatAlarmStartAt(aInstance, now, sTxPeriod);
+    }
 }
 
 extern "C" void otPlatDiagAlarmFired(otInstance *aInstance)
@@ -60,6 +60,46 @@ struct DiagStats
     uint8_t first_lqi;
 };
 
+enum
+{
+    kBenchFrameMagic0   = 0x42,  ///< First magic byte marking a benchmark frame ('B').
+    kBenchFrameMagic1   = 0x4e,  ///< Second magic byte marking a benchmark frame ('N').
+    kBenchHeaderLength  = 10,    ///< Magic (2), sequence number (4), and timestamp (4) bytes.
+    kBenchHistogramSize = 8,     ///< Number of power-of-two latency spread histogram buckets.
+};
+
+/**
+ * Benchmark results TLV types, as emitted by the `diag bench dump` command.
+ *
+ */
+enum
+{
+    kBenchTlvTxFrames  = 0,  ///< Transmitted frame count (uint32).
+    kBenchTlvRxFrames  = 1,  ///< Received frame count (uint32).
+    kBenchTlvRxBytes   = 2,  ///< Received byte count (uint32).
+    kBenchTlvLost      = 3,  ///< Frames lost according to sequence number gaps (uint32).
+    kBenchTlvDup       = 4,  ///< Duplicate or out-of-order frames (uint32).
+    kBenchTlvLatency   = 5,  ///< Latency spread histogram buckets (kBenchHistogramSize x uint32).
+    kBenchTlvGap       = 6,  ///< Min/avg/max inter-arrival gap in milliseconds (3 x uint32).
+    kBenchTlvRssi      = 7,  ///< Min/avg/max received signal strength in dBm (3 x int8).
+};
+
+struct DiagBenchStats
+{
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+    uint32_t rx_bytes;
+    uint32_t lost_frames;
+    uint32_t dup_frames;
+    uint32_t latency_histogram[kBenchHistogramSize];
+    uint32_t gap_min;
+    uint32_t gap_max;
+    uint32_t gap_sum;
+    int32_t rssi_sum;
+    int8_t rssi_min;
+    int8_t rssi_max;
+};
+
 class Diag
 {
 public:
@@ -81,17 +121,34 @@ private:
     static void ProcessStats(int argc, char *argv[], char *aOutput, size_t aOutputMaxLen);
     static void ProcessChannel(int argc, char *argv[], char *aOutput, size_t aOutputMaxLen);
     static void ProcessPower(int argc, char *argv[], char *aOutput, size_t aOutputMaxLen);
+    static void ProcessBench(int argc, char *argv[], char *aOutput, size_t aOutputMaxLen);
     static void TxPacket();
+    static void BenchReset(void);
+    static void BenchTxFrame(void);
+    static void BenchReceiveFrame(RadioPacket *aFrame);
+    static uint8_t AppendBenchTlv(uint8_t *aBuffer, uint8_t aOffset, uint8_t aType,
+                                  const void *aValue, uint8_t aLength);
+    static void BenchEncodeUint32(uint8_t *aBuffer, uint32_t aValue);
     static ThreadError ParseLong(char *aString, long &aLong);
 
     static char sDiagOutput[];
     static const struct Command sCommands[];
     static struct DiagStats sStats;
+    static struct DiagBenchStats sBenchStats;
     static int8_t sTxPower;
     static uint8_t sChannel;
     static uint8_t sTxLen;
     static uint32_t sTxPeriod;
     static uint32_t sTxPackets;
+    static bool sBenchTxActive;
+    static bool sBenchRxActive;
+    static uint8_t sBenchTxLen;
+    static uint32_t sBenchTxPeriod;
+    static uint32_t sBenchTxRemaining;
+    static uint32_t sBenchTxSeq;
+    static uint32_t sBenchLastSeq;
+    static uint32_t sBenchBaseline;
+    static uint32_t sBenchLastRxTime;
     static otInstance *sContext;
 };
 
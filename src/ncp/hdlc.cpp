@@ -30,6 +30,8 @@
  *   This file implements an HDLC-lite encoder and decoder.
  */
 
+#include <string.h>
+
 #include <common/code_utils.hpp>
 #include <ncp/hdlc.hpp>
 
@@ -47,6 +49,18 @@ namespace Hdlc {
  */
 static uint16_t UpdateFcs(uint16_t aFcs, uint8_t aByte);
 
+/**
+ * This method updates an FCS over a buffer using the lookup table.
+ *
+ * @param[in]  aFcs     The FCS to update.
+ * @param[in]  aBuf     A pointer to the input buffer.
+ * @param[in]  aLength  The number of bytes in @p aBuf.
+ *
+ * @returns The updated FCS.
+ *
+ */
+static uint16_t UpdateFcs(uint16_t aFcs, const uint8_t *aBuf, uint16_t aLength);
+
 enum
 {
     kFlagSequence   = 0x7e,  ///< HDLC Flag value
@@ -63,6 +77,11 @@ enum
     kGoodFcs = 0xf0b8,  ///< Good FCS value.
 };
 
+enum
+{
+    kMinFrameLength = sizeof(uint16_t) + 2,  ///< Minimum plausible frame size: two payload bytes plus the FCS.
+};
+
 uint16_t UpdateFcs(uint16_t aFcs, uint8_t aByte)
 {
     static const uint16_t sFcsTable[256] =
@@ -103,6 +122,16 @@ uint16_t UpdateFcs(uint16_t aFcs, uint8_t aByte)
     return (aFcs >> 8) ^ sFcsTable[(aFcs ^ aByte) & 0xff];
 }
 
+uint16_t UpdateFcs(uint16_t aFcs, const uint8_t *aBuf, uint16_t aLength)
+{
+    while (aLength--)
+    {
+        aFcs = UpdateFcs(aFcs, *aBuf++);
+    }
+
+    return aFcs;
+}
+
 
 Encoder::BufferWriteIterator::BufferWriteIterator(void)
 {
@@ -123,6 +152,20 @@ exit:
     return error;
 }
 
+ThreadError Encoder::BufferWriteIterator::Write(const uint8_t *aBuf, uint16_t aLength)
+{
+    ThreadError error = kThreadError_None;
+
+    VerifyOrExit(mRemainingLength >= aLength, error = kThreadError_NoBufs);
+
+    memcpy(mWritePointer, aBuf, aLength);
+    mWritePointer += aLength;
+    mRemainingLength -= aLength;
+
+exit:
+    return error;
+}
+
 bool Encoder::BufferWriteIterator::CanWrite(uint16_t aWriteLength) const
 {
    return (mRemainingLength >= aWriteLength);
@@ -162,10 +205,36 @@ ThreadError Encoder::Encode(const uint8_t *aInBuf, uint16_t aInLength, BufferWri
     ThreadError error = kThreadError_None;
     BufferWriteIterator oldIterator(aIterator);
     uint16_t oldFcs = mFcs;
+    const uint8_t *cur = aInBuf;
+    const uint8_t *end = aInBuf + aInLength;
+    const uint8_t *spanEnd;
+    uint16_t runLength;
 
-    for (int i = 0; i < aInLength; i++)
+    while (cur < end)
     {
-        SuccessOrExit(error = Encode(aInBuf[i], aIterator));
+        // Scan ahead for the next byte requiring an escape so the run of
+        // plain bytes before it can be copied and checksummed in bulk.
+        spanEnd = cur;
+
+        while (spanEnd < end && *spanEnd != kFlagSequence && *spanEnd != kEscapeSequence)
+        {
+            spanEnd++;
+        }
+
+        if (spanEnd != cur)
+        {
+            runLength = static_cast<uint16_t>(spanEnd - cur);
+
+            SuccessOrExit(error = aIterator.Write(cur, runLength));
+            mFcs = UpdateFcs(mFcs, cur, runLength);
+            cur = spanEnd;
+        }
+
+        if (cur < end)
+        {
+            SuccessOrExit(error = Encode(*cur, aIterator));
+            cur++;
+        }
     }
 
 exit:
@@ -207,6 +276,7 @@ Decoder::Decoder(uint8_t *aOutBuf, uint16_t aOutLength, FrameHandler aFrameHandl
     mState = kStateNoSync;
     mFrameHandler = aFrameHandler;
     mErrorHandler = aErrorHandler;
+    mFrameValidator = NULL;
     mContext = aContext;
     mOutBuf = aOutBuf;
     mOutOffset = 0;
@@ -215,75 +285,124 @@ Decoder::Decoder(uint8_t *aOutBuf, uint16_t aOutLength, FrameHandler aFrameHandl
 
 void Decoder::Decode(const uint8_t *aInBuf, uint16_t aInLength)
 {
+    const uint8_t *cur = aInBuf;
+    const uint8_t *end = aInBuf + aInLength;
+    const uint8_t *spanEnd;
+    uint16_t runLength;
     uint8_t byte;
 
-    for (int i = 0; i < aInLength; i++)
+    while (cur < end)
     {
-        byte = aInBuf[i];
-
         switch (mState)
         {
         case kStateNoSync:
-            if (byte == kFlagSequence)
+            // Skip directly ahead to the next flag sequence.
+            cur = static_cast<const uint8_t *>(memchr(cur, kFlagSequence, static_cast<size_t>(end - cur)));
+
+            if (cur == NULL)
+            {
+                cur = end;
+            }
+            else
             {
                 mState = kStateSync;
                 mOutOffset = 0;
                 mFcs = kInitFcs;
+                cur++;
             }
 
             break;
 
         case kStateSync:
-            switch (byte)
+            // Scan ahead for the next byte requiring special handling so the
+            // run of plain bytes before it can be copied and checksummed in bulk.
+            spanEnd = cur;
+
+            while (spanEnd < end && *spanEnd != kFlagSequence && *spanEnd != kEscapeSequence)
+            {
+                spanEnd++;
+            }
+
+            if (spanEnd != cur)
             {
-            case kEscapeSequence:
-                mState = kStateEscaped;
-                break;
-
-            case kFlagSequence:
-                // We ignore frames which are smaller
-                // than the size of the CRC check.
-                if (mOutOffset > sizeof(uint16_t))
+                // Reject implausible frames on their first byte, so line noise
+                // resynchronizes the decoder immediately instead of being
+                // buffered and checksummed to full frame completion.
+                if (mOutOffset == 0 && mFrameValidator != NULL && !mFrameValidator(mContext, *cur))
                 {
-                    if (mFcs == kGoodFcs)
-                    {
-                        mFrameHandler(mContext, mOutBuf, mOutOffset - sizeof(uint16_t));
-                    }
-                    else if (mErrorHandler != NULL)
-                    {
-                        mErrorHandler(mContext, kThreadError_Parse, mOutBuf, mOutOffset);
-                    }
+                    mState = kStateNoSync;
+                    break;
                 }
 
-                mOutOffset = 0;
-                mFcs = kInitFcs;
-
-                break;
+                runLength = static_cast<uint16_t>(spanEnd - cur);
 
-            default:
-                if (mOutOffset < mOutLength)
+                if (runLength > mOutLength - mOutOffset)
                 {
-                    mFcs = UpdateFcs(mFcs, byte);
-                    mOutBuf[mOutOffset++] = byte;
+                    runLength = mOutLength - mOutOffset;
                 }
-                else
+
+                memcpy(mOutBuf + mOutOffset, cur, runLength);
+                mFcs = UpdateFcs(mFcs, cur, runLength);
+                mOutOffset += runLength;
+                cur += runLength;
+
+                if (cur != spanEnd)
                 {
                     if (mErrorHandler != NULL)
                     {
                         mErrorHandler(mContext, kThreadError_NoBufs, mOutBuf, mOutOffset);
                     }
+
                     mState = kStateNoSync;
+                    cur = spanEnd;
+                    break;
                 }
+            }
+
+            if (cur < end)
+            {
+                if (*cur == kEscapeSequence)
+                {
+                    mState = kStateEscaped;
+                }
+                else
+                {
+                    // We ignore frames which are smaller than the minimum
+                    // plausible frame size; these are noise, not frames.
+                    if (mOutOffset >= kMinFrameLength)
+                    {
+                        if (mFcs == kGoodFcs)
+                        {
+                            mFrameHandler(mContext, mOutBuf, mOutOffset - sizeof(uint16_t));
+                        }
+                        else if (mErrorHandler != NULL)
+                        {
+                            mErrorHandler(mContext, kThreadError_Parse, mOutBuf, mOutOffset);
+                        }
+                    }
 
-                break;
+                    mOutOffset = 0;
+                    mFcs = kInitFcs;
+                }
+
+                cur++;
             }
 
             break;
 
         case kStateEscaped:
+            byte = *cur++;
+
             if (mOutOffset < mOutLength)
             {
                 byte ^= 0x20;
+
+                if (mOutOffset == 0 && mFrameValidator != NULL && !mFrameValidator(mContext, byte))
+                {
+                    mState = kStateNoSync;
+                    break;
+                }
+
                 mFcs = UpdateFcs(mFcs, byte);
                 mOutBuf[mOutOffset++] = byte;
                 mState = kStateSync;
@@ -294,10 +413,10 @@ void Decoder::Decode(const uint8_t *aInBuf, uint16_t aInLength)
                 {
                     mErrorHandler(mContext, kThreadError_NoBufs, mOutBuf, mOutOffset);
                 }
+
                 mState = kStateNoSync;
             }
 
-
             break;
         }
     }
@@ -73,6 +73,20 @@ public:
          */
         ThreadError WriteByte(uint8_t aByte);
 
+        /**
+         * This method writes a buffer of bytes and updates the iterator.
+         *
+         * If there is not enough space for the entire buffer, nothing is written and the iterator remains the same.
+         *
+         * @param[in] aBuf              A pointer to the input buffer.
+         * @param[in] aLength           Number of bytes in @p aBuf to write.
+         *
+         * @retval kThreadError_None    Successfully wrote the buffer and updated the iterator.
+         * @retval kThreadError_NoBufs  Insufficient buffer space.
+         *
+         */
+        ThreadError Write(const uint8_t *aBuf, uint16_t aLength);
+
         /**
          * This method checks if there is buffer space available to write @p aWriteLength bytes.
          *
@@ -176,6 +190,21 @@ public:
      */
     typedef void (*ErrorHandler)(void *aContext, ThreadError aError, uint8_t *aFrame, uint16_t aFrameLength);
 
+    /**
+     * This function pointer is called with the first byte of each frame and may reject the frame.
+     *
+     * Returning false resynchronizes the decoder immediately, so line noise is discarded without
+     * being buffered and checksummed to full frame completion.
+     *
+     * @param[in]  aContext    A pointer to arbitrary context information.
+     * @param[in]  aFirstByte  The first decoded byte of the frame.
+     *
+     * @retval true   The byte is a plausible frame start; continue decoding.
+     * @retval false  The byte cannot start a valid frame; discard and resynchronize.
+     *
+     */
+    typedef bool (*FrameValidator)(void *aContext, uint8_t aFirstByte);
+
     /**
      * This constructor initializes the decoder.
      *
@@ -196,6 +225,14 @@ public:
      */
     void Decode(const uint8_t *aInBuf, uint16_t aInLength);
 
+    /**
+     * This method sets a validator that is called with the first byte of each frame.
+     *
+     * @param[in]  aFrameValidator  A pointer to the validator function, or NULL to disable validation.
+     *
+     */
+    void SetFrameValidator(FrameValidator aFrameValidator) { mFrameValidator = aFrameValidator; }
+
 private:
     enum State
     {
@@ -207,6 +244,7 @@ private:
 
     FrameHandler mFrameHandler;
     ErrorHandler mErrorHandler;
+    FrameValidator mFrameValidator;
     void *mContext;
 
     uint8_t *mOutBuf;
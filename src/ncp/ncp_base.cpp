@@ -74,6 +74,7 @@ const NcpBase::CommandHandlerEntry NcpBase::mCommandHandlerTable[] =
     { SPINEL_CMD_PROP_VALUE_SET, &NcpBase::CommandHandler_PROP_VALUE_SET },
     { SPINEL_CMD_PROP_VALUE_INSERT, &NcpBase::CommandHandler_PROP_VALUE_INSERT },
     { SPINEL_CMD_PROP_VALUE_REMOVE, &NcpBase::CommandHandler_PROP_VALUE_REMOVE },
+    { SPINEL_CMD_PROP_VALUE_MULTI_GET, &NcpBase::CommandHandler_PROP_VALUE_MULTI_GET },
 };
 
 const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
@@ -183,6 +184,12 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_TX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_ERR, &NcpBase::GetPropertyHandler_NCP_CNTR },
+
+    { SPINEL_PROP_NEST_MSG_BUFFER_CONGESTED, &NcpBase::GetPropertyHandler_NEST_MSG_BUFFER_CONGESTED },
+    { SPINEL_PROP_NEST_STREAM_NET_CREDITS, &NcpBase::GetPropertyHandler_NEST_STREAM_NET_CREDITS },
+    { SPINEL_PROP_NEST_HOST_FILTER_NEXT_HEADER, &NcpBase::GetPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER },
+    { SPINEL_PROP_NEST_HOST_FILTER_PORT, &NcpBase::GetPropertyHandler_NEST_HOST_FILTER_PORT },
+    { SPINEL_PROP_NEST_HOST_FILTER_MCAST_SCOPE, &NcpBase::GetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE },
 };
 
 const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
@@ -231,6 +238,8 @@ const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
 #if OPENTHREAD_ENABLE_DIAG
     { SPINEL_PROP_NEST_STREAM_MFG, &NcpBase::SetPropertyHandler_NEST_STREAM_MFG },
 #endif
+
+    { SPINEL_PROP_NEST_HOST_FILTER_MCAST_SCOPE, &NcpBase::SetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE },
 };
 
 const NcpBase::InsertPropertyHandlerEntry NcpBase::mInsertPropertyHandlerTable[] =
@@ -243,6 +252,8 @@ const NcpBase::InsertPropertyHandlerEntry NcpBase::mInsertPropertyHandlerTable[]
     { SPINEL_PROP_CNTR_RESET, &NcpBase::SetPropertyHandler_CNTR_RESET },
 
     { SPINEL_PROP_MAC_WHITELIST, &NcpBase::InsertPropertyHandler_MAC_WHITELIST },
+    { SPINEL_PROP_NEST_HOST_FILTER_NEXT_HEADER, &NcpBase::InsertPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER },
+    { SPINEL_PROP_NEST_HOST_FILTER_PORT, &NcpBase::InsertPropertyHandler_NEST_HOST_FILTER_PORT },
 };
 
 const NcpBase::RemovePropertyHandlerEntry NcpBase::mRemovePropertyHandlerTable[] =
@@ -253,6 +264,8 @@ const NcpBase::RemovePropertyHandlerEntry NcpBase::mRemovePropertyHandlerTable[]
     { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::NcpBase::RemovePropertyHandler_THREAD_ASSISTING_PORTS },
     { SPINEL_PROP_MAC_WHITELIST, &NcpBase::RemovePropertyHandler_MAC_WHITELIST },
     { SPINEL_PROP_THREAD_ACTIVE_ROUTER_IDS, &NcpBase::RemovePropertyHandler_THREAD_ACTIVE_ROUTER_IDS },
+    { SPINEL_PROP_NEST_HOST_FILTER_NEXT_HEADER, &NcpBase::RemovePropertyHandler_NEST_HOST_FILTER_NEXT_HEADER },
+    { SPINEL_PROP_NEST_HOST_FILTER_PORT, &NcpBase::RemovePropertyHandler_NEST_HOST_FILTER_PORT },
 };
 
 // ----------------------------------------------------------------------------
@@ -415,11 +428,23 @@ NcpBase::NcpBase(otInstance *aInstance):
     mChannelMask = mSupportedChannelMask;
     mScanPeriod = 200; // ms
     mShouldSignalEndOfScan = false;
+    mShouldSignalBufferCongestion = false;
+    mStreamNetCredits = kStreamNetWindow;
+    mShouldSignalStreamNetCredits = false;
+    mHostFilterNextHeaderCount = 0;
+    mHostFilterPortCount = 0;
+    mHostFilterMcastScope = 0;
+    mHostFilteredIpFrameCounter = 0;
     sNcpContext = this;
     mChangedFlags = NCP_PLAT_RESET_REASON;
     mAllowLocalNetworkDataChange = false;
     mRequireJoinExistingNetwork = false;
 
+    for (unsigned i = 0; i < kNumConstProperties; i++)
+    {
+        mConstPropertyCache[i].mValueLength = 0;
+    }
+
     mFramingErrorCounter = 0;
     mRxSpinelFrameCounter = 0;
     mTxSpinelFrameCounter = 0;
@@ -432,6 +457,7 @@ NcpBase::NcpBase(otInstance *aInstance):
 
     otSetStateChangedCallback(mInstance, &NcpBase::HandleNetifStateChanged, this);
     otSetReceiveIp6DatagramCallback(mInstance, &NcpBase::HandleDatagramFromStack, this);
+    otSetBufferCongestionCallback(mInstance, &NcpBase::HandleBufferCongestion, this);
     otSetIcmpEchoEnabled(mInstance, false);
 
     mUpdateChangedPropsTask.Post();
@@ -452,6 +478,15 @@ void NcpBase::HandleDatagramFromStack(Message &aMessage)
     Message *message = &aMessage;
     bool isSecure = message->IsLinkSecurityEnabled();
 
+    // drop datagrams the host asked not to see, before spending uart
+    // airtime and a host wakeup on them
+    if (ShouldFilterHostDatagram(aMessage))
+    {
+        mHostFilteredIpFrameCounter++;
+        aMessage.Free();
+        return;
+    }
+
     SuccessOrExit(errorCode = OutboundFrameBegin());
 
     SuccessOrExit(
@@ -501,6 +536,51 @@ exit:
     }
 }
 
+bool NcpBase::ShouldFilterHostDatagram(Message &aMessage)
+{
+    bool rval = false;
+    Ip6::Header ip6Header;
+    uint16_t destPort;
+    uint8_t i;
+
+    VerifyOrExit(aMessage.Read(0, sizeof(ip6Header), &ip6Header) == sizeof(ip6Header), ;);
+
+    if (mHostFilterMcastScope != 0 &&
+        ip6Header.GetDestination().IsMulticast() &&
+        ip6Header.GetDestination().GetScope() <= mHostFilterMcastScope)
+    {
+        ExitNow(rval = true);
+    }
+
+    for (i = 0; i < mHostFilterNextHeaderCount; i++)
+    {
+        if (ip6Header.GetNextHeader() == mHostFilterNextHeaders[i])
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+    // both UDP and TCP carry the destination port in the second 16-bit field;
+    // datagrams with extension headers are not port-filtered
+    if (mHostFilterPortCount > 0 &&
+        (ip6Header.GetNextHeader() == Ip6::kProtoUdp || ip6Header.GetNextHeader() == Ip6::kProtoTcp) &&
+        aMessage.Read(sizeof(ip6Header) + sizeof(uint16_t), sizeof(destPort), &destPort) == sizeof(destPort))
+    {
+        destPort = Encoding::BigEndian::HostSwap16(destPort);
+
+        for (i = 0; i < mHostFilterPortCount; i++)
+        {
+            if (destPort == mHostFilterPorts[i])
+            {
+                ExitNow(rval = true);
+            }
+        }
+    }
+
+exit:
+    return rval;
+}
+
 // ----------------------------------------------------------------------------
 // MARK: Scan Results Glue
 // ----------------------------------------------------------------------------
@@ -623,6 +703,24 @@ void NcpBase::HandleNetifStateChanged(uint32_t flags, void *context)
     obj->mUpdateChangedPropsTask.Post();
 }
 
+void NcpBase::HandleBufferCongestion(bool aCongested, void *context)
+{
+    NcpBase *obj = static_cast<NcpBase *>(context);
+
+    // This callback fires from the allocation path, so defer the property
+    // update to the tasklet rather than building a frame right here.
+    obj->mShouldSignalBufferCongestion = true;
+
+    if (!aCongested)
+    {
+        // buffer capacity freed; reopen the inbound stream window
+        obj->mStreamNetCredits = kStreamNetWindow;
+        obj->mShouldSignalStreamNetCredits = true;
+    }
+
+    obj->mUpdateChangedPropsTask.Post();
+}
+
 void NcpBase::UpdateChangedProps(void *context)
 {
     NcpBase *obj = static_cast<NcpBase *>(context);
@@ -631,6 +729,24 @@ void NcpBase::UpdateChangedProps(void *context)
 
 void NcpBase::UpdateChangedProps(void)
 {
+    if (mShouldSignalBufferCongestion)
+    {
+        SuccessOrExit(HandleCommandPropertyGet(
+                          SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                          SPINEL_PROP_NEST_MSG_BUFFER_CONGESTED
+                      ));
+        mShouldSignalBufferCongestion = false;
+    }
+
+    if (mShouldSignalStreamNetCredits)
+    {
+        SuccessOrExit(HandleCommandPropertyGet(
+                          SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                          SPINEL_PROP_NEST_STREAM_NET_CREDITS
+                      ));
+        mShouldSignalStreamNetCredits = false;
+    }
+
     while (mChangedFlags != 0)
     {
         if ((mChangedFlags & NCP_PLAT_RESET_REASON) != 0)
@@ -1044,6 +1160,71 @@ exit:
     return errorCode;
 }
 
+ThreadError NcpBase::SendConstPropertyUpdate(uint8_t header, spinel_prop_key_t key, const char *pack_format, ...)
+{
+    ThreadError errorCode = kThreadError_None;
+    ConstPropertyCacheEntry *entry = NULL;
+    unsigned i;
+    va_list args;
+
+    va_start(args, pack_format);
+
+    for (i = 0; i < kNumConstProperties; i++)
+    {
+        if (mConstPropertyCache[i].mValueLength != 0 && mConstPropertyCache[i].mPropKey == key)
+        {
+            entry = &mConstPropertyCache[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        // Pack the value into a free cache slot so that later gets of this
+        // constant property can reuse the packed bytes directly.
+        for (i = 0; i < kNumConstProperties; i++)
+        {
+            if (mConstPropertyCache[i].mValueLength == 0)
+            {
+                spinel_ssize_t packed_len;
+                va_list args_copy;
+
+                va_copy(args_copy, args);
+                packed_len = spinel_datatype_vpack(mConstPropertyCache[i].mValueBuffer, kConstPropertyValueSize,
+                                                   pack_format, args_copy);
+                va_end(args_copy);
+
+                if ((packed_len > 0) && (packed_len <= kConstPropertyValueSize))
+                {
+                    mConstPropertyCache[i].mPropKey = key;
+                    mConstPropertyCache[i].mValueLength = static_cast<uint16_t>(packed_len);
+                    entry = &mConstPropertyCache[i];
+                }
+
+                break;
+            }
+        }
+    }
+
+    if (entry != NULL)
+    {
+        errorCode = SendPropertyUpdate(header, SPINEL_CMD_PROP_VALUE_IS, key, entry->mValueBuffer,
+                                       entry->mValueLength);
+    }
+    else
+    {
+        // No slot available or the value did not fit; pack straight into the outbound frame.
+        SuccessOrExit(errorCode = OutboundFrameBegin());
+        SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
+        SuccessOrExit(errorCode = OutboundFrameFeedVPacked(pack_format, args));
+        SuccessOrExit(errorCode = OutboundFrameSend());
+    }
+
+exit:
+    va_end(args);
+    return errorCode;
+}
+
 ThreadError NcpBase::SendPropertyUpdate(uint8_t header, uint8_t command, spinel_prop_key_t key,
                                         const uint8_t *value_ptr, uint16_t value_len)
 {
@@ -1181,6 +1362,36 @@ ThreadError NcpBase::CommandHandler_PROP_VALUE_GET(uint8_t header, unsigned int
     return errorCode;
 }
 
+ThreadError NcpBase::CommandHandler_PROP_VALUE_MULTI_GET(uint8_t header, unsigned int command, const uint8_t *arg_ptr,
+                                                         uint16_t arg_len)
+{
+    unsigned int propKey;
+    spinel_ssize_t parsedLength;
+    ThreadError errorCode = kThreadError_None;
+
+    // The payload is a sequence of packed property keys. Each key produces
+    // its own PROP_VALUE_IS response frame, all generated from this single
+    // inbound command, so the host pays one request round trip for the
+    // entire batch.
+    while (arg_len > 0)
+    {
+        propKey = 0;
+        parsedLength = spinel_datatype_unpack(arg_ptr, arg_len, "i", &propKey);
+
+        VerifyOrExit(parsedLength > 0, errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR));
+
+        SuccessOrExit(errorCode = HandleCommandPropertyGet(header, static_cast<spinel_prop_key_t>(propKey)));
+
+        arg_ptr += parsedLength;
+        arg_len -= static_cast<uint16_t>(parsedLength);
+    }
+
+exit:
+    (void)command;
+
+    return errorCode;
+}
+
 ThreadError NcpBase::CommandHandler_PROP_VALUE_SET(uint8_t header, unsigned int command, const uint8_t *arg_ptr,
                                                    uint16_t arg_len)
 {
@@ -1272,9 +1483,8 @@ ThreadError NcpBase::GetPropertyHandler_LAST_STATUS(uint8_t header, spinel_prop_
 
 ThreadError NcpBase::GetPropertyHandler_PROTOCOL_VERSION(uint8_t header, spinel_prop_key_t key)
 {
-    return SendPropertyUpdate(
+    return SendConstPropertyUpdate(
                header,
-               SPINEL_CMD_PROP_VALUE_IS,
                key,
                SPINEL_DATATYPE_UINT_PACKED_S SPINEL_DATATYPE_UINT_PACKED_S,
                SPINEL_PROTOCOL_VERSION_THREAD_MAJOR,
@@ -1284,9 +1494,8 @@ ThreadError NcpBase::GetPropertyHandler_PROTOCOL_VERSION(uint8_t header, spinel_
 
 ThreadError NcpBase::GetPropertyHandler_INTERFACE_TYPE(uint8_t header, spinel_prop_key_t key)
 {
-    return SendPropertyUpdate(
+    return SendConstPropertyUpdate(
                header,
-               SPINEL_CMD_PROP_VALUE_IS,
                key,
                SPINEL_DATATYPE_UINT_PACKED_S,
                SPINEL_PROTOCOL_TYPE_THREAD
@@ -1295,9 +1504,8 @@ ThreadError NcpBase::GetPropertyHandler_INTERFACE_TYPE(uint8_t header, spinel_pr
 
 ThreadError NcpBase::GetPropertyHandler_VENDOR_ID(uint8_t header, spinel_prop_key_t key)
 {
-    return SendPropertyUpdate(
+    return SendConstPropertyUpdate(
                header,
-               SPINEL_CMD_PROP_VALUE_IS,
                key,
                SPINEL_DATATYPE_UINT_PACKED_S,
                0 // Vendor ID. Zero for unknown.
@@ -1306,41 +1514,32 @@ ThreadError NcpBase::GetPropertyHandler_VENDOR_ID(uint8_t header, spinel_prop_ke
 
 ThreadError NcpBase::GetPropertyHandler_CAPS(uint8_t header, spinel_prop_key_t key)
 {
-    ThreadError errorCode = kThreadError_None;
-
-    SuccessOrExit(errorCode = OutboundFrameBegin());
-
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
-
-    // Begin adding capabilities //////////////////////////////////////////////
-
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_NET_THREAD_1_0));
-
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_COUNTERS));
-
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_MAC_WHITELIST));
-
-    // TODO: Somehow get the following capability from the radio.
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S,
-                                                      SPINEL_CAP_802_15_4_2450MHZ_OQPSK));
-
+    return SendConstPropertyUpdate(
+               header,
+               key,
+               SPINEL_DATATYPE_UINT_PACKED_S
+               SPINEL_DATATYPE_UINT_PACKED_S
+               SPINEL_DATATYPE_UINT_PACKED_S
+               SPINEL_DATATYPE_UINT_PACKED_S
 #if OPENTHREAD_CONFIG_MAX_CHILDREN > 0
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_ROLE_ROUTER));
+               SPINEL_DATATYPE_UINT_PACKED_S
 #endif
-
-    // End adding capabilities /////////////////////////////////////////////////
-
-    SuccessOrExit(errorCode = OutboundFrameSend());
-
-exit:
-    return errorCode;
+               ,
+               SPINEL_CAP_NET_THREAD_1_0,
+               SPINEL_CAP_COUNTERS,
+               SPINEL_CAP_MAC_WHITELIST,
+               // TODO: Somehow get the following capability from the radio.
+               SPINEL_CAP_802_15_4_2450MHZ_OQPSK
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 0
+               , SPINEL_CAP_ROLE_ROUTER
+#endif
+           );
 }
 
 ThreadError NcpBase::GetPropertyHandler_NCP_VERSION(uint8_t header, spinel_prop_key_t key)
 {
-    return SendPropertyUpdate(
+    return SendConstPropertyUpdate(
                header,
-               SPINEL_CMD_PROP_VALUE_IS,
                key,
                SPINEL_DATATYPE_UTF8_S,
                otGetVersionString()
@@ -1874,6 +2073,7 @@ ThreadError NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE(uint8_t header, spine
                         SPINEL_DATATYPE_UINT8_S         // Link Quality In
                         SPINEL_DATATYPE_INT8_S          // Average RSS
                         SPINEL_DATATYPE_UINT8_S         // Mode (flags)
+                        SPINEL_DATATYPE_UINT8_S         // Frame error rate (255 = every attempt failed)
                     ")",
                     childInfo.mExtAddress.m8,
                     childInfo.mRloc16,
@@ -1882,7 +2082,8 @@ ThreadError NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE(uint8_t header, spine
                     childInfo.mNetworkDataVersion,
                     childInfo.mLinkQualityIn,
                     childInfo.mAverageRssi,
-                    modeFlags
+                    modeFlags,
+                    childInfo.mFrameErrorRate
             ));
         }
 
@@ -2348,6 +2549,126 @@ bail:
     return errorCode;
 }
 
+ThreadError NcpBase::GetPropertyHandler_NEST_MSG_BUFFER_CONGESTED(uint8_t header, spinel_prop_key_t key)
+{
+    return SendPropertyUpdate(
+               header,
+               SPINEL_CMD_PROP_VALUE_IS,
+               key,
+               SPINEL_DATATYPE_BOOL_S,
+               otIsBufferCongested(mInstance)
+           );
+}
+
+ThreadError NcpBase::GetPropertyHandler_NEST_STREAM_NET_CREDITS(uint8_t header, spinel_prop_key_t key)
+{
+    return SendPropertyUpdate(
+               header,
+               SPINEL_CMD_PROP_VALUE_IS,
+               key,
+               SPINEL_DATATYPE_UINT8_S,
+               mStreamNetCredits
+           );
+}
+
+void NcpBase::ConsumeStreamNetCredit(void)
+{
+    if (mStreamNetCredits > 0)
+    {
+        mStreamNetCredits--;
+    }
+}
+
+void NcpBase::ReplenishStreamNetCredits(void)
+{
+    // only re-open the window while the message pool has capacity; when it is
+    // congested the credits are granted from the congestion-cleared callback
+    if (!otIsBufferCongested(mInstance) && mStreamNetCredits < kStreamNetWindow)
+    {
+        mStreamNetCredits = kStreamNetWindow;
+        mShouldSignalStreamNetCredits = true;
+        mUpdateChangedPropsTask.Post();
+    }
+}
+
+ThreadError NcpBase::GetPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key)
+{
+    ThreadError errorCode = kThreadError_None;
+    uint8_t i;
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
+
+    for (i = 0; i < mHostFilterNextHeaderCount; i++)
+    {
+        SuccessOrExit(errorCode = OutboundFrameFeedPacked("C", mHostFilterNextHeaders[i]));
+    }
+
+    SuccessOrExit(errorCode = OutboundFrameSend());
+
+exit:
+    return errorCode;
+}
+
+ThreadError NcpBase::GetPropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key)
+{
+    ThreadError errorCode = kThreadError_None;
+    uint8_t i;
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked("Cii", header, SPINEL_CMD_PROP_VALUE_IS, key));
+
+    for (i = 0; i < mHostFilterPortCount; i++)
+    {
+        SuccessOrExit(errorCode = OutboundFrameFeedPacked("S", mHostFilterPorts[i]));
+    }
+
+    SuccessOrExit(errorCode = OutboundFrameSend());
+
+exit:
+    return errorCode;
+}
+
+ThreadError NcpBase::GetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE(uint8_t header, spinel_prop_key_t key)
+{
+    return SendPropertyUpdate(
+               header,
+               SPINEL_CMD_PROP_VALUE_IS,
+               key,
+               SPINEL_DATATYPE_UINT8_S,
+               mHostFilterMcastScope
+           );
+}
+
+ThreadError NcpBase::SetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE(uint8_t header, spinel_prop_key_t key,
+                                                                     const uint8_t *value_ptr, uint16_t value_len)
+{
+    ThreadError errorCode = kThreadError_None;
+    uint8_t scope = 0;
+    spinel_ssize_t parsedLength;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       SPINEL_DATATYPE_UINT8_S,
+                       &scope
+                   );
+
+    if (parsedLength > 0)
+    {
+        mHostFilterMcastScope = scope;
+        errorCode = HandleCommandPropertyGet(header, key);
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
 ThreadError NcpBase::GetPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key)
 {
     otMacWhitelistEntry entry;
@@ -3159,33 +3480,35 @@ ThreadError NcpBase::SetPropertyHandler_STREAM_NET_INSECURE(uint8_t header, spin
     const uint8_t *meta_ptr(NULL);
     unsigned int meta_len(0);
 
+    ConsumeStreamNetCredit();
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       SPINEL_DATATYPE_DATA_S SPINEL_DATATYPE_DATA_S,
+                       &frame_ptr,
+                       &frame_len,
+                       &meta_ptr,
+                       &meta_len
+                   );
+
+    // We ignore metadata for now.
+    // May later include TX power, allow retransmits, etc...
+    (void)meta_ptr;
+    (void)meta_len;
+    (void)parsedLength;
+
+    otMessageIovec iovec;
+    iovec.mBase = frame_ptr;
+    iovec.mLength = static_cast<uint16_t>(frame_len);
+
     // STREAM_NET_INSECURE packets are not secured at layer 2.
-    otMessage message = otNewIp6Message(mInstance, false);
+    otMessage message = otNewIp6MessageIovec(mInstance, false, &iovec, 1);
 
     if (message == NULL)
     {
         errorCode = kThreadError_NoBufs;
     }
-    else
-    {
-        parsedLength = spinel_datatype_unpack(
-                           value_ptr,
-                           value_len,
-                           SPINEL_DATATYPE_DATA_S SPINEL_DATATYPE_DATA_S,
-                           &frame_ptr,
-                           &frame_len,
-                           &meta_ptr,
-                           &meta_len
-                       );
-
-        // We ignore metadata for now.
-        // May later include TX power, allow retransmits, etc...
-        (void)meta_ptr;
-        (void)meta_len;
-        (void)parsedLength;
-
-        errorCode = otAppendMessage(message, frame_ptr, static_cast<uint16_t>(frame_len));
-    }
 
     if (errorCode == kThreadError_None)
     {
@@ -3214,6 +3537,8 @@ ThreadError NcpBase::SetPropertyHandler_STREAM_NET_INSECURE(uint8_t header, spin
         errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
     }
 
+    ReplenishStreamNetCredits();
+
     (void)key;
 
     return errorCode;
@@ -3229,33 +3554,35 @@ ThreadError NcpBase::SetPropertyHandler_STREAM_NET(uint8_t header, spinel_prop_k
     const uint8_t *meta_ptr(NULL);
     unsigned int meta_len(0);
 
+    ConsumeStreamNetCredit();
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       SPINEL_DATATYPE_DATA_S SPINEL_DATATYPE_DATA_S,
+                       &frame_ptr,
+                       &frame_len,
+                       &meta_ptr,
+                       &meta_len
+                   );
+
+    // We ignore metadata for now.
+    // May later include TX power, allow retransmits, etc...
+    (void)meta_ptr;
+    (void)meta_len;
+    (void)parsedLength;
+
+    otMessageIovec iovec;
+    iovec.mBase = frame_ptr;
+    iovec.mLength = static_cast<uint16_t>(frame_len);
+
     // STREAM_NET requires layer 2 security.
-    otMessage message = otNewIp6Message(mInstance, true);
+    otMessage message = otNewIp6MessageIovec(mInstance, true, &iovec, 1);
 
     if (message == NULL)
     {
         errorCode = kThreadError_NoBufs;
     }
-    else
-    {
-        parsedLength = spinel_datatype_unpack(
-                           value_ptr,
-                           value_len,
-                           SPINEL_DATATYPE_DATA_S SPINEL_DATATYPE_DATA_S,
-                           &frame_ptr,
-                           &frame_len,
-                           &meta_ptr,
-                           &meta_len
-                       );
-
-        // We ignore metadata for now.
-        // May later include TX power, allow retransmits, etc...
-        (void)meta_ptr;
-        (void)meta_len;
-        (void)parsedLength;
-
-        errorCode = otAppendMessage(message, frame_ptr, static_cast<uint16_t>(frame_len));
-    }
 
     if (errorCode == kThreadError_None)
     {
@@ -3285,6 +3612,8 @@ ThreadError NcpBase::SetPropertyHandler_STREAM_NET(uint8_t header, spinel_prop_k
 
     }
 
+    ReplenishStreamNetCredits();
+
     (void)key;
 
     return errorCode;
@@ -3563,11 +3892,12 @@ ThreadError NcpBase::SetPropertyHandler_CNTR_RESET(uint8_t header, spinel_prop_k
 ThreadError NcpBase::SetPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr, uint16_t value_len)
 {
     ThreadError errorCode = kThreadError_None;
+    otMacWhitelistEntry entries[OT_MAC_WHITELIST_MAX_ENTRIES];
+    uint8_t numEntries = 0;
     spinel_ssize_t parsedLength = 1;
 
-    // First, clear the whitelist.
-    otClearMacWhitelist(mInstance);
-
+    // Parse the whole array before touching the whitelist so the new table
+    // is applied in a single step or not at all.
     while ((errorCode == kThreadError_None)
            && (parsedLength > 0)
            && (value_len > 0)
@@ -3601,32 +3931,35 @@ ThreadError NcpBase::SetPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_pro
             break;
         }
 
-        if (rssi == RSSI_OVERRIDE_DISABLED)
-        {
-            errorCode = otAddMacWhitelist(mInstance, ext_addr->m8);
-        }
-        else
+        if (numEntries >= OT_MAC_WHITELIST_MAX_ENTRIES)
         {
-            errorCode = otAddMacWhitelistRssi(mInstance, ext_addr->m8, rssi);
+            errorCode = kThreadError_NoBufs;
+            break;
         }
 
+        memcpy(&entries[numEntries].mExtAddress, ext_addr, sizeof(entries[numEntries].mExtAddress));
+        entries[numEntries].mRssi = rssi;
+        entries[numEntries].mValid = true;
+        entries[numEntries].mFixedRssi = (rssi != RSSI_OVERRIDE_DISABLED);
+        numEntries++;
+
         value_ptr += parsedLength;
         value_len -= parsedLength;
     }
 
+    if (errorCode == kThreadError_None)
+    {
+        errorCode = otSetMacWhitelist(mInstance, entries, numEntries);
+    }
+
     if (errorCode == kThreadError_None)
     {
         errorCode = HandleCommandPropertyGet(header, key);
     }
     else
     {
+        // Nothing was applied, so the previous whitelist is still in effect.
         errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
-
-        // We had an error, but we may have actually changed
-        // the state of the whitelist---so we need to report
-        // those incomplete changes via an asynchronous
-        // change event.
-        HandleCommandPropertyGet(SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0, key);
     }
 
     return errorCode;
@@ -3831,6 +4164,9 @@ ThreadError NcpBase::SetPropertyHandler_NEST_STREAM_MFG(uint8_t header, spinel_p
 
     if ((parsedLength > 0) && (string != NULL))
     {
+        // the diagnostics module initializes lazily on first use
+        diagInit(mInstance);
+
         // all diagnostics related features are processed within diagnostics module
         output = diagProcessCmdLine(string);
 
@@ -4088,6 +4424,126 @@ ThreadError NcpBase::InsertPropertyHandler_THREAD_ASSISTING_PORTS(uint8_t header
     return errorCode;
 }
 
+ThreadError NcpBase::InsertPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key,
+                                                                        const uint8_t *value_ptr, uint16_t value_len)
+{
+    spinel_ssize_t parsedLength;
+    ThreadError errorCode = kThreadError_None;
+    uint8_t nextHeader;
+    uint8_t i;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       "C",
+                       &nextHeader
+                   );
+
+    if (parsedLength > 0)
+    {
+        for (i = 0; i < mHostFilterNextHeaderCount; i++)
+        {
+            if (mHostFilterNextHeaders[i] == nextHeader)
+            {
+                break;
+            }
+        }
+
+        if (i == mHostFilterNextHeaderCount)
+        {
+            if (mHostFilterNextHeaderCount < kMaxHostFilterEntries)
+            {
+                mHostFilterNextHeaders[mHostFilterNextHeaderCount++] = nextHeader;
+            }
+            else
+            {
+                errorCode = kThreadError_NoBufs;
+            }
+        }
+
+        if (errorCode == kThreadError_None)
+        {
+            errorCode = SendPropertyUpdate(
+                            header,
+                            SPINEL_CMD_PROP_VALUE_INSERTED,
+                            key,
+                            value_ptr,
+                            value_len
+                        );
+        }
+        else
+        {
+            errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
+        }
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
+ThreadError NcpBase::InsertPropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key,
+                                                                 const uint8_t *value_ptr, uint16_t value_len)
+{
+    spinel_ssize_t parsedLength;
+    ThreadError errorCode = kThreadError_None;
+    uint16_t port;
+    uint8_t i;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       "S",
+                       &port
+                   );
+
+    if (parsedLength > 0)
+    {
+        for (i = 0; i < mHostFilterPortCount; i++)
+        {
+            if (mHostFilterPorts[i] == port)
+            {
+                break;
+            }
+        }
+
+        if (i == mHostFilterPortCount)
+        {
+            if (mHostFilterPortCount < kMaxHostFilterEntries)
+            {
+                mHostFilterPorts[mHostFilterPortCount++] = port;
+            }
+            else
+            {
+                errorCode = kThreadError_NoBufs;
+            }
+        }
+
+        if (errorCode == kThreadError_None)
+        {
+            errorCode = SendPropertyUpdate(
+                            header,
+                            SPINEL_CMD_PROP_VALUE_INSERTED,
+                            key,
+                            value_ptr,
+                            value_len
+                        );
+        }
+        else
+        {
+            errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
+        }
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
 ThreadError NcpBase::InsertPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr, uint16_t value_len)
 {
     ThreadError errorCode = kThreadError_None;
@@ -4344,6 +4800,106 @@ ThreadError NcpBase::RemovePropertyHandler_THREAD_ASSISTING_PORTS(uint8_t header
     return errorCode;
 }
 
+ThreadError NcpBase::RemovePropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key,
+                                                                        const uint8_t *value_ptr, uint16_t value_len)
+{
+    spinel_ssize_t parsedLength;
+    ThreadError errorCode = kThreadError_NotFound;
+    uint8_t nextHeader;
+    uint8_t i;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       "C",
+                       &nextHeader
+                   );
+
+    if (parsedLength > 0)
+    {
+        for (i = 0; i < mHostFilterNextHeaderCount; i++)
+        {
+            if (mHostFilterNextHeaders[i] == nextHeader)
+            {
+                mHostFilterNextHeaders[i] = mHostFilterNextHeaders[--mHostFilterNextHeaderCount];
+                errorCode = kThreadError_None;
+                break;
+            }
+        }
+
+        if (errorCode == kThreadError_None)
+        {
+            errorCode = SendPropertyUpdate(
+                            header,
+                            SPINEL_CMD_PROP_VALUE_REMOVED,
+                            key,
+                            value_ptr,
+                            value_len
+                        );
+        }
+        else
+        {
+            errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
+        }
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
+ThreadError NcpBase::RemovePropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key,
+                                                                 const uint8_t *value_ptr, uint16_t value_len)
+{
+    spinel_ssize_t parsedLength;
+    ThreadError errorCode = kThreadError_NotFound;
+    uint16_t port;
+    uint8_t i;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       "S",
+                       &port
+                   );
+
+    if (parsedLength > 0)
+    {
+        for (i = 0; i < mHostFilterPortCount; i++)
+        {
+            if (mHostFilterPorts[i] == port)
+            {
+                mHostFilterPorts[i] = mHostFilterPorts[--mHostFilterPortCount];
+                errorCode = kThreadError_None;
+                break;
+            }
+        }
+
+        if (errorCode == kThreadError_None)
+        {
+            errorCode = SendPropertyUpdate(
+                            header,
+                            SPINEL_CMD_PROP_VALUE_REMOVED,
+                            key,
+                            value_ptr,
+                            value_len
+                        );
+        }
+        else
+        {
+            errorCode = SendLastStatus(header, ThreadErrorToSpinelStatus(errorCode));
+        }
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
 ThreadError NcpBase::RemovePropertyHandler_THREAD_ACTIVE_ROUTER_IDS(uint8_t header, spinel_prop_key_t key,
                                                                   const uint8_t *value_ptr, uint16_t value_len)
 {
@@ -174,6 +174,8 @@ private:
 
     static void HandleNetifStateChanged(uint32_t flags, void *context);
 
+    static void HandleBufferCongestion(bool aCongested, void *context);
+
 private:
 
     ThreadError OutboundFrameFeedPacked(const char *pack_format, ...);
@@ -197,6 +199,8 @@ private:
 
     ThreadError SendLastStatus(uint8_t header, spinel_status_t lastStatus);
 
+    ThreadError SendConstPropertyUpdate(uint8_t header, spinel_prop_key_t key, const char *pack_format, ...);
+
 public:
 
     ThreadError SendPropertyUpdate(uint8_t header, uint8_t command, spinel_prop_key_t key, const uint8_t *value_ptr,
@@ -262,6 +266,8 @@ private:
                                                  uint16_t arg_len);
     ThreadError CommandHandler_PROP_VALUE_REMOVE(uint8_t header, unsigned int command, const uint8_t *arg_ptr,
                                                  uint16_t arg_len);
+    ThreadError CommandHandler_PROP_VALUE_MULTI_GET(uint8_t header, unsigned int command, const uint8_t *arg_ptr,
+                                                    uint16_t arg_len);
 
     ThreadError GetPropertyHandler_ChannelMaskHelper(uint8_t header, spinel_prop_key_t key, uint32_t channel_mask);
 
@@ -330,6 +336,11 @@ private:
     ThreadError GetPropertyHandler_THREAD_NETWORK_ID_TIMEOUT(uint8_t header, spinel_prop_key_t key);
     ThreadError GetPropertyHandler_THREAD_ON_MESH_NETS(uint8_t header, spinel_prop_key_t key);
     ThreadError GetPropertyHandler_NET_REQUIRE_JOIN_EXISTING(uint8_t header, spinel_prop_key_t key);
+    ThreadError GetPropertyHandler_NEST_MSG_BUFFER_CONGESTED(uint8_t header, spinel_prop_key_t key);
+    ThreadError GetPropertyHandler_NEST_STREAM_NET_CREDITS(uint8_t header, spinel_prop_key_t key);
+    ThreadError GetPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key);
+    ThreadError GetPropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key);
+    ThreadError GetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE(uint8_t header, spinel_prop_key_t key);
 
     ThreadError SetPropertyHandler_POWER_STATE(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                                uint16_t value_len);
@@ -401,6 +412,9 @@ private:
                                                    uint16_t value_len);
 #endif
 
+    ThreadError SetPropertyHandler_NEST_HOST_FILTER_MCAST_SCOPE(uint8_t header, spinel_prop_key_t key,
+                                                                const uint8_t *value_ptr, uint16_t value_len);
+
     ThreadError InsertPropertyHandler_IPV6_ADDRESS_TABLE(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                                          uint16_t value_len);
     ThreadError InsertPropertyHandler_THREAD_LOCAL_ROUTES(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
@@ -411,6 +425,10 @@ private:
                                                              const uint8_t *value_ptr,
                                                              uint16_t value_len);
     ThreadError InsertPropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr, uint16_t value_len);
+    ThreadError InsertPropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key,
+                                                                   const uint8_t *value_ptr, uint16_t value_len);
+    ThreadError InsertPropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key,
+                                                            const uint8_t *value_ptr, uint16_t value_len);
 
     ThreadError RemovePropertyHandler_IPV6_ADDRESS_TABLE(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                                          uint16_t value_len);
@@ -424,9 +442,35 @@ private:
     ThreadError RemovePropertyHandler_MAC_WHITELIST(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr, uint16_t value_len);
     ThreadError RemovePropertyHandler_THREAD_ACTIVE_ROUTER_IDS(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                               uint16_t value_len);
+    ThreadError RemovePropertyHandler_NEST_HOST_FILTER_NEXT_HEADER(uint8_t header, spinel_prop_key_t key,
+                                                                   const uint8_t *value_ptr, uint16_t value_len);
+    ThreadError RemovePropertyHandler_NEST_HOST_FILTER_PORT(uint8_t header, spinel_prop_key_t key,
+                                                            const uint8_t *value_ptr, uint16_t value_len);
 
 private:
 
+    enum
+    {
+        kNumConstProperties = 5,       // Number of cached constant property slots.
+        kConstPropertyValueSize = 80,  // Maximum packed size of a cached constant property value.
+        kStreamNetWindow = 4,          // Inbound network stream flow control window, in frames.
+        kMaxHostFilterEntries = 8,     // Capacity of each host-bound datagram drop filter list.
+    };
+
+    void ConsumeStreamNetCredit(void);
+    void ReplenishStreamNetCredits(void);
+    bool ShouldFilterHostDatagram(Message &aMessage);
+
+    // Packed value of a constant (immutable) property, cached on first get.
+    struct ConstPropertyCacheEntry
+    {
+        spinel_prop_key_t mPropKey;                       // The property key.
+        uint16_t mValueLength;                            // Packed value length (zero when slot is unused).
+        uint8_t mValueBuffer[kConstPropertyValueSize];    // The packed property value.
+    };
+
+    ConstPropertyCacheEntry mConstPropertyCache[kNumConstProperties];
+
     spinel_status_t mLastStatus;
 
     uint32_t mSupportedChannelMask;
@@ -441,6 +485,19 @@ private:
 
     bool mShouldSignalEndOfScan;
 
+    bool mShouldSignalBufferCongestion;
+
+    uint8_t mStreamNetCredits;
+
+    bool mShouldSignalStreamNetCredits;
+
+    uint8_t mHostFilterNextHeaders[kMaxHostFilterEntries];
+    uint8_t mHostFilterNextHeaderCount;
+    uint16_t mHostFilterPorts[kMaxHostFilterEntries];
+    uint8_t mHostFilterPortCount;
+    uint8_t mHostFilterMcastScope;
+    uint32_t mHostFilteredIpFrameCounter;  // Number of host-bound datagrams dropped by the host filters.
+
     spinel_tid_t mDroppedReplyTid;
 
     uint16_t mDroppedReplyTidBitSet;
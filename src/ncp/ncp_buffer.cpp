@@ -70,8 +70,8 @@ void NcpFrameBuffer::Clear(void)
     mReadPointer = mBuffer;
 
     mReadMessage = NULL;
-    mReadMessageOffset = 0;
-    mReadMessageTail = mMessageBuffer;
+    mReadMessageIterator = Message::ChunkIterator();
+    mReadMessageTail = NULL;
 
     // Free all messages in the queues.
 
@@ -406,11 +406,11 @@ ThreadError NcpFrameBuffer::OutFramePrepareMessage(void)
 
     VerifyOrExit(mReadMessage != NULL, error = kThreadError_NotFound);
 
-    // Reset the offset for reading the message.
-    mReadMessageOffset = 0;
+    // Position the chunk iterator at the start of the message.
+    mReadMessageIterator.Init(*static_cast<const Message *>(mReadMessage), 0, mReadMessage->GetLength());
 
-    // Fill the content from current message into the message buffer.
-    SuccessOrExit(error = OutFrameFillMessageBuffer());
+    // Set up the read pointers for the first message buffer chunk.
+    SuccessOrExit(error = OutFramePrepareMessageChunk());
 
     // If all successful, set the state to `InMessage`.
     mReadState = kReadStateInMessage;
@@ -419,29 +419,25 @@ exit:
     return error;
 }
 
-// This method fills content from current message into the message buffer. It returns kThreadError_NotFound if no more
-// content in the current message.
-ThreadError NcpFrameBuffer::OutFrameFillMessageBuffer(void)
+// This method sets up the read pointers for the next contiguous chunk of the current message. The chunk is read
+// directly from the message buffers (no staging copy). It returns kThreadError_NotFound if no more content in the
+// current message.
+ThreadError NcpFrameBuffer::OutFramePrepareMessageChunk(void)
 {
     ThreadError error = kThreadError_None;
-    int readLength;
+    const uint8_t *chunk;
+    uint16_t chunkLength;
 
     VerifyOrExit(mReadMessage != NULL, error = kThreadError_NotFound);
 
-    VerifyOrExit(mReadMessageOffset < mReadMessage->GetLength(), error = kThreadError_NotFound);
+    // Get the next contiguous run of bytes within the message buffers.
+    VerifyOrExit(mReadMessageIterator.GetNextChunk(chunk, chunkLength), error = kThreadError_NotFound);
 
-    // Read portion of current message from the offset into message buffer.
-    readLength = mReadMessage->Read(mReadMessageOffset, sizeof(mMessageBuffer), mMessageBuffer);
+    // Set up the chunk tail and set read pointer to start of the chunk.
 
-    VerifyOrExit(readLength > 0, error = kThreadError_NotFound);
+    mReadMessageTail = chunk + chunkLength;
 
-    // Update the message offset, set up the message tail, and set read pointer to start of message buffer.
-
-    mReadMessageOffset += readLength;
-
-    mReadMessageTail = mMessageBuffer + readLength;
-
-    mReadPointer = mMessageBuffer;
+    mReadPointer = chunk;
 
 exit:
     return error;
@@ -469,22 +465,74 @@ bool NcpFrameBuffer::OutFrameHasEnded(void)
 
 uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 {
-    ThreadError error;
     uint8_t retval = kReadByteAfterFrameHasEnded;
 
+    if (mReadState != kReadStateDone)
+    {
+        // Read a byte from current read pointer and move the read pointer forward.
+        retval = *mReadPointer;
+        OutFrameSkip(1);
+    }
+
+    return retval;
+}
+
+const uint8_t *NcpFrameBuffer::OutFrameGetChunk(uint16_t &aChunkLength)
+{
+    const uint8_t *chunk = NULL;
+
+    aChunkLength = 0;
+
     switch (mReadState)
     {
     case kReadStateDone:
+        break;
+
+    case kReadStateInSegment:
+
+        chunk = mReadPointer;
+
+        // The run is contiguous up to the segment tail or the wrap-around point of the buffer.
+        if (mReadSegmentTail > mReadPointer)
+        {
+            aChunkLength = static_cast<uint16_t>(mReadSegmentTail - mReadPointer);
+        }
+        else
+        {
+            aChunkLength = static_cast<uint16_t>(mBufferEnd - mReadPointer);
+        }
 
-        retval = kReadByteAfterFrameHasEnded;
+        break;
+
+    case kReadStateInMessage:
+
+        chunk = mReadPointer;
+        aChunkLength = static_cast<uint16_t>(mReadMessageTail - mReadPointer);
+
+        break;
+    }
+
+    return chunk;
+}
+
+void NcpFrameBuffer::OutFrameSkip(uint16_t aLength)
+{
+    ThreadError error;
 
+    switch (mReadState)
+    {
+    case kReadStateDone:
         break;
 
     case kReadStateInSegment:
 
-        // Read a byte from current read pointer and move the read pointer forward.
-        retval = *mReadPointer;
-        mReadPointer = Next(mReadPointer);
+        // Move the read pointer forward, addressing the wrap-around at the end of buffer.
+        mReadPointer += aLength;
+
+        if (mReadPointer == mBufferEnd)
+        {
+            mReadPointer = mBuffer;
+        }
 
         // Check if at end of current segment.
         if (mReadPointer == mReadSegmentTail)
@@ -503,15 +551,14 @@ uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 
     case kReadStateInMessage:
 
-        // Read a byte from current read pointer and move the read pointer forward.
-        retval = *mReadPointer;
-        mReadPointer++;
+        // Move the read pointer forward within the current message buffer chunk.
+        mReadPointer += aLength;
 
-        // Check if at the end of content in message buffer.
+        // Check if at the end of the current chunk.
         if (mReadPointer == mReadMessageTail)
         {
-            // Fill more bytes from current message into message buffer.
-            error = OutFrameFillMessageBuffer();
+            // Prepare the next chunk from the current message.
+            error = OutFramePrepareMessageChunk();
 
             // If no more bytes in the message, move to next segment (if any).
             if (error != kThreadError_None)
@@ -522,8 +569,6 @@ uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 
         break;
     }
-
-    return retval;
 }
 
 uint16_t NcpFrameBuffer::OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer)
@@ -203,6 +203,33 @@ public:
      */
     uint16_t OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer);
 
+    /**
+     * This method returns a pointer to a contiguous run of bytes at the current read position of the
+     * current output frame along with the length of the run.
+     *
+     * The returned pointer addresses either the frame buffer itself or the buffers of a message added to
+     * the frame (`InFrameFeedMessage()`), so the frame content can be consumed run by run without copying
+     * it out byte-wise. The run stays valid until the read position moves past it (`OutFrameSkip()`,
+     * `OutFrameReadByte()`, `OutFrameRead()`) or the frame is removed.
+     *
+     * @param[out]  aChunkLength   The number of bytes available at the returned pointer.
+     *
+     * @returns A pointer to the run of bytes, or NULL if the current output frame has ended.
+     *
+     */
+    const uint8_t *OutFrameGetChunk(uint16_t &aChunkLength);
+
+    /**
+     * This method moves the read position of the current output frame forward by the given number of bytes.
+     *
+     * The given length @p aLength must not be larger than the length of the run returned by a previous call
+     * to `OutFrameGetChunk()`.
+     *
+     * @param[in]  aLength        Number of bytes to skip.
+     *
+     */
+    void OutFrameSkip(uint16_t aLength);
+
     /**
      * This method removes the current/front output frame from the buffer.
      *
@@ -286,7 +313,6 @@ private:
     enum
     {
         kReadByteAfterFrameHasEnded        = 0,          // Value returned by ReadByte() when frame has ended.
-        kMessageReadBufferSize             = 16,         // Size of message buffer array.
         kUnknownFrameLength                = 0xffff,     // Value used when frame length is unknown.
         kSegmentHeaderSize                 = 2,          // Length of the segment header.
         kSegmentHeaderLengthMask           = 0x3fff,     // Bit mask to get the length from the segment header
@@ -299,7 +325,7 @@ private:
     enum ReadState
     {
         kReadStateInSegment,        // In middle of a data segment while reading current (out) frame.
-        kReadStateInMessage,        // In middle of a message while reading current (out) frame.
+        kReadStateInMessage,        // In middle of a message buffer while reading current (out) frame.
         kReadStateDone,             // Current (out) frame is read fully.
     };
 
@@ -320,7 +346,7 @@ private:
     ThreadError     OutFramePrepareSegment(void);
     void            OutFrameMoveToNextSegment(void);
     ThreadError     OutFramePrepareMessage(void);
-    ThreadError     OutFrameFillMessageBuffer(void);
+    ThreadError     OutFramePrepareMessageChunk(void);
 
     // Instance variables
 
@@ -345,13 +371,11 @@ private:
     uint8_t *       mReadFrameStart;            // Pointer to start of current frame being read.
     uint8_t *       mReadSegmentHead;           // Pointer to start of current segment in the frame being read.
     uint8_t *       mReadSegmentTail;           // Pointer to end of current segment in the frame being read.
-    uint8_t *       mReadPointer;               // Pointer to next byte to read (either in segment or in msg buffer).
+    const uint8_t * mReadPointer;               // Pointer to next byte to read (in segment or in message buffer).
 
     Message *       mReadMessage;               // Current Message in the frame being read.
-    uint16_t        mReadMessageOffset;         // Offset within current message being read.
-
-    uint8_t         mMessageBuffer[kMessageReadBufferSize];   // Buffer to hold part of current message being read.
-    uint8_t *       mReadMessageTail;           // Pointer to end of current part in mMessageBuffer.
+    Message::ChunkIterator mReadMessageIterator; // Iterator over the buffer chunks of the current message.
+    const uint8_t * mReadMessageTail;           // Pointer to end of current message buffer chunk being read.
 };
 
 }  // namespace Thread
@@ -105,16 +105,18 @@ NcpSpi::NcpSpi(otInstance *aInstance):
     spi_header_set_flag_byte(mSendFrame, SPI_RESET_FLAG|SPI_PATTERN_VALUE);
     spi_header_set_flag_byte(mEmptySendFrame, SPI_RESET_FLAG|SPI_PATTERN_VALUE);
     spi_header_set_accept_len(mSendFrame, sizeof(mReceiveFrame) - kSpiHeaderLength);
+    spi_header_set_accept_len(mEmptySendFrame, sizeof(mReceiveFrame) - kSpiHeaderLength);
     otPlatSpiSlaveEnable(&NcpSpi::SpiTransactionComplete, (void*)this);
 
     // We signal an interrupt on this first transaction to
     // make sure that the host processor knows that our
-    // reset flag was set.
+    // reset flag was set. The host may deliver a frame in this
+    // same transaction.
     otPlatSpiSlavePrepareTransaction(
         mEmptySendFrame,
         kSpiHeaderLength,
-        mEmptyReceiveFrame,
-        kSpiHeaderLength,
+        mReceiveFrame,
+        sizeof(mReceiveFrame),
         true
     );
 }
@@ -154,10 +156,6 @@ NcpSpi::SpiTransactionComplete(
     uint16_t tx_data_len(0);
     uint16_t tx_accept_len(0);
 
-    // TODO: Check `PATTERN` bits of `HDR` and ignore frame if not set.
-    //       Holding off on implementing this so as to not cause immediate
-    //       compatibility problems, even though it is required by the spec.
-
     if (aTransactionLength >= kSpiHeaderLength)
     {
         if (aMISOBufLen >= kSpiHeaderLength)
@@ -169,8 +167,15 @@ NcpSpi::SpiTransactionComplete(
 
         if (aMOSIBufLen >= kSpiHeaderLength)
         {
-            rx_data_len = spi_header_get_data_len(aMOSIBuf);
-            tx_accept_len = spi_header_get_accept_len(aMOSIBuf);
+            // Check the `PATTERN` bits of `HDR` and ignore the frame if
+            // they are not set. The host clocks transactions at maximum
+            // length speculatively and marks the header valid only when it
+            // actually has a frame to deliver.
+            if ((spi_header_get_flag_byte(aMOSIBuf) & SPI_PATTERN_MASK) == SPI_PATTERN_VALUE)
+            {
+                rx_data_len = spi_header_get_data_len(aMOSIBuf);
+                tx_accept_len = spi_header_get_accept_len(aMOSIBuf);
+            }
         }
 
         if ( !mHandlingRxFrame
@@ -273,6 +278,8 @@ ThreadError NcpSpi::PrepareNextSpiSendFrame(void)
     ThreadError errorCode = kThreadError_None;
     uint16_t frameLength;
     uint16_t readLength;
+    uint8_t *receiveFrame;
+    uint16_t receiveFrameLen;
 
     VerifyOrExit(!mTxFrameBuffer.IsEmpty(), ;);
 
@@ -283,8 +290,22 @@ ThreadError NcpSpi::PrepareNextSpiSendFrame(void)
 
     spi_header_set_data_len(mSendFrame, frameLength);
 
-    // Half-duplex to avoid race condition.
-    spi_header_set_accept_len(mSendFrame, 0);
+    // Accept a host frame in the same (full-duplex) transaction, unless the
+    // receive buffer still holds an unprocessed frame. The transaction
+    // prepared from the completion callback always reflects the latest
+    // receive state, so a kThreadError_Busy result below is covered too.
+    if (!mHandlingRxFrame)
+    {
+        spi_header_set_accept_len(mSendFrame, sizeof(mReceiveFrame) - kSpiHeaderLength);
+        receiveFrame = mReceiveFrame;
+        receiveFrameLen = sizeof(mReceiveFrame);
+    }
+    else
+    {
+        spi_header_set_accept_len(mSendFrame, 0);
+        receiveFrame = mEmptyReceiveFrame;
+        receiveFrameLen = sizeof(mEmptyReceiveFrame);
+    }
 
     readLength = mTxFrameBuffer.OutFrameRead(frameLength, mSendFrame + kSpiHeaderLength);
     VerifyOrExit(readLength == frameLength, errorCode = kThreadError_Failed);
@@ -296,8 +317,8 @@ ThreadError NcpSpi::PrepareNextSpiSendFrame(void)
     errorCode = otPlatSpiSlavePrepareTransaction(
         mSendFrame,
         mSendFrameLen,
-        mEmptyReceiveFrame,
-        sizeof(mEmptyReceiveFrame),
+        receiveFrame,
+        receiveFrameLen,
         true
     );
 
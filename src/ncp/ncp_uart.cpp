@@ -82,11 +82,14 @@ const uint8_t *NcpUart::UartTxBuffer::GetBuffer(void) const
 NcpUart::NcpUart(otInstance *aInstance):
     NcpBase(aInstance),
     mFrameDecoder(mRxBuffer, sizeof(mRxBuffer), &NcpUart::HandleFrame, &NcpUart::HandleError, this),
-    mUartBuffer(),
     mTxFrameBuffer(mTxBuffer, sizeof(mTxBuffer)),
     mUartSendTask(sIp6->mTaskletScheduler, EncodeAndSendToUart, this)
 {
     mState = kStartingFrame;
+    mFillBufferIndex = 0;
+    mUartSendActive = false;
+
+    mFrameDecoder.SetFrameValidator(&NcpUart::ValidateFrameStart);
 
     mTxFrameBuffer.SetCallbacks(NULL, TxFrameBufferHasData, this);
 }
@@ -121,7 +124,7 @@ void NcpUart::TxFrameBufferHasData(void *aContext, NcpFrameBuffer *aNcpFrameBuff
 
 void NcpUart::TxFrameBufferHasData(void)
 {
-    if (mUartBuffer.IsEmpty())
+    if (mUartBuffers[mFillBufferIndex].IsEmpty())
     {
         mUartSendTask.Post();
     }
@@ -134,12 +137,15 @@ void NcpUart::EncodeAndSendToUart(void *aContext)
     obj->EncodeAndSendToUart();
 }
 
-// This method encodes a frame from the tx frame buffer (mTxFrameBuffer) into the uart buffer and sends it over uart.
-// If the uart buffer gets full, it sends the current encoded portion. This method remembers current state, so on
-// sub-sequent calls, it restarts encoding the bytes from where it left of in the frame .
+// This method encodes a frame from the tx frame buffer (mTxFrameBuffer) into the current fill buffer and hands it
+// to the uart. If the fill buffer gets full, the encoded portion is sent and encoding continues into the other
+// buffer while the uart drains. This method remembers current state, so on sub-sequent calls, it restarts encoding
+// the bytes from where it left of in the frame .
 void NcpUart::EncodeAndSendToUart(void)
 {
-    uint16_t len;
+    UartTxBuffer &txBuffer = mUartBuffers[mFillBufferIndex];
+    const uint8_t *chunk;
+    uint16_t chunkLength;
 
     while (!mTxFrameBuffer.IsEmpty())
     {
@@ -147,19 +153,33 @@ void NcpUart::EncodeAndSendToUart(void)
         {
         case kStartingFrame:
 
-            SuccessOrExit(mFrameEncoder.Init(mUartBuffer));
+            SuccessOrExit(mFrameEncoder.Init(txBuffer));
 
             mTxFrameBuffer.OutFrameBegin();
 
             mState = kEncodingFrame;
 
-            while (!mTxFrameBuffer.OutFrameHasEnded())
-            {
-                mByte = mTxFrameBuffer.OutFrameReadByte();
+            // Fall through
 
-            case kEncodingFrame:
+        case kEncodingFrame:
 
-                SuccessOrExit(mFrameEncoder.Encode(mByte, mUartBuffer));
+            // Encode the frame run by run from the source buffers, falling back to byte-wise
+            // encoding when a run no longer fits in the remaining uart buffer space.
+            while ((chunk = mTxFrameBuffer.OutFrameGetChunk(chunkLength)) != NULL)
+            {
+                if (mFrameEncoder.Encode(chunk, chunkLength, txBuffer) == kThreadError_None)
+                {
+                    mTxFrameBuffer.OutFrameSkip(chunkLength);
+                    continue;
+                }
+
+                while (chunkLength > 0)
+                {
+                    SuccessOrExit(mFrameEncoder.Encode(*chunk, txBuffer));
+                    mTxFrameBuffer.OutFrameSkip(1);
+                    chunk++;
+                    chunkLength--;
+                }
             }
 
             mTxFrameBuffer.OutFrameRemove();
@@ -169,21 +189,43 @@ void NcpUart::EncodeAndSendToUart(void)
 
             mState = kFinalizingFrame;
 
+            // Fall through
+
         case kFinalizingFrame:
 
-            SuccessOrExit(mFrameEncoder.Finalize(mUartBuffer));
+            SuccessOrExit(mFrameEncoder.Finalize(txBuffer));
 
             mState = kStartingFrame;
         }
     }
 
 exit:
-    len = mUartBuffer.GetLength();
+    SendToUart();
+}
+
+// This method hands the current fill buffer to the uart (unless a send is already in progress) and swaps the fill
+// buffers, so encoding can continue into the other buffer while the uart drains this one.
+void NcpUart::SendToUart(void)
+{
+    UartTxBuffer &txBuffer = mUartBuffers[mFillBufferIndex];
+
+    VerifyOrExit(!mUartSendActive && !txBuffer.IsEmpty(), ;);
+
+    mUartSendActive = true;
+    mFillBufferIndex ^= 1;
+    mUartBuffers[mFillBufferIndex].Clear();
+
+    otPlatUartSend(txBuffer.GetBuffer(), txBuffer.GetLength());
 
-    if (len > 0)
+    // Continue encoding any remaining frame data into the other buffer
+    // while this one drains.
+    if (!mTxFrameBuffer.IsEmpty())
     {
-        otPlatUartSend(mUartBuffer.GetBuffer(), len);
+        mUartSendTask.Post();
     }
+
+exit:
+    return;
 }
 
 extern "C" void otPlatUartSendDone(void)
@@ -193,7 +235,11 @@ extern "C" void otPlatUartSendDone(void)
 
 void NcpUart::HandleUartSendDone(void)
 {
-    mUartBuffer.Clear();
+    mUartSendActive = false;
+
+    // Hand the standby buffer to the uart right away if encoding has
+    // already filled it, then continue encoding into the freed buffer.
+    SendToUart();
 
     mUartSendTask.Post();
 }
@@ -219,6 +265,16 @@ void NcpUart::HandleFrame(uint8_t *aBuf, uint16_t aBufLength)
     super_t::HandleReceive(aBuf, aBufLength);
 }
 
+bool NcpUart::ValidateFrameStart(void *context, uint8_t aFirstByte)
+{
+    (void)context;
+
+    // Every spinel frame starts with a header byte whose two most significant
+    // bits are "10"; anything else is line noise and is dropped here without
+    // an error log, before the decoder buffers and checksums it.
+    return (aFirstByte & 0xc0) == SPINEL_HEADER_FLAG;
+}
+
 void NcpUart::HandleError(void *context, ThreadError aError, uint8_t *aBuf, uint16_t aBufLength)
 {
     sNcpUart->HandleError(aError, aBuf, aBufLength);
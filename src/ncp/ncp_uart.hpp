@@ -145,6 +145,7 @@ private:
     };
 
     void            EncodeAndSendToUart(void);
+    void            SendToUart(void);
     void            HandleFrame(uint8_t *aBuf, uint16_t aBufLength);
     void            HandleError(ThreadError aError, uint8_t *aBuf, uint16_t aBufLength);
     void            TxFrameBufferHasData(void);
@@ -152,14 +153,16 @@ private:
     static void     EncodeAndSendToUart(void *aContext);
     static void     HandleFrame(void *context, uint8_t *aBuf, uint16_t aBufLength);
     static void     HandleError(void *context, ThreadError aError, uint8_t *aBuf, uint16_t aBufLength);
+    static bool     ValidateFrameStart(void *context, uint8_t aFirstByte);
     static void     TxFrameBufferHasData(void *aContext, NcpFrameBuffer *aNcpFrameBuffer);
 
     Hdlc::Encoder   mFrameEncoder;
     Hdlc::Decoder   mFrameDecoder;
-    UartTxBuffer    mUartBuffer;
+    UartTxBuffer    mUartBuffers[2];   // Double buffer: encode into one while the uart drains the other.
+    uint8_t         mFillBufferIndex;  // Index of the buffer currently being filled by the encoder.
+    bool            mUartSendActive;   // TRUE while a platform uart send is in progress.
     NcpFrameBuffer  mTxFrameBuffer;
     UartTxState     mState;
-    uint8_t         mByte;
     uint8_t         mTxBuffer[kTxBufferSize];
     uint8_t         mRxBuffer[kRxBufferSize];
     Tasklet         mUartSendTask;
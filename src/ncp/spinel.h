@@ -274,6 +274,14 @@ enum
     SPINEL_CMD_VENDOR__END          = 16384,
 
     SPINEL_CMD_EXPERIMENTAL__BEGIN  = 2000000,
+
+    /**
+     * Batched property get. The payload is a sequence of packed property
+     * keys; the NCP answers with one `CMD_PROP_VALUE_IS` frame per key,
+     * all generated from the single inbound command.
+     */
+    SPINEL_CMD_PROP_VALUE_MULTI_GET = SPINEL_CMD_EXPERIMENTAL__BEGIN + 0,
+
     SPINEL_CMD_EXPERIMENTAL__END    = 2097152,
 };
 
@@ -425,7 +433,7 @@ typedef enum
     SPINEL_PROP_THREAD__BEGIN          = 0x50,
     SPINEL_PROP_THREAD_LEADER_ADDR     = SPINEL_PROP_THREAD__BEGIN + 0, ///< [6]
     SPINEL_PROP_THREAD_PARENT          = SPINEL_PROP_THREAD__BEGIN + 1, ///< LADDR, SADDR [ES]
-    SPINEL_PROP_THREAD_CHILD_TABLE     = SPINEL_PROP_THREAD__BEGIN + 2, ///< array(EUI64,rloc16,timeout,age,netDataVer,inLqi,aveRSS,mode) [A(T(ESLLCCcC))]
+    SPINEL_PROP_THREAD_CHILD_TABLE     = SPINEL_PROP_THREAD__BEGIN + 2, ///< array(EUI64,rloc16,timeout,age,netDataVer,inLqi,aveRSS,mode,frameErrRate) [A(T(ESLLCCcCC))]
     SPINEL_PROP_THREAD_LEADER_RID      = SPINEL_PROP_THREAD__BEGIN + 3, ///< [C]
     SPINEL_PROP_THREAD_LEADER_WEIGHT   = SPINEL_PROP_THREAD__BEGIN + 4, ///< [C]
     SPINEL_PROP_THREAD_LOCAL_LEADER_WEIGHT
@@ -737,6 +745,53 @@ typedef enum
 
     SPINEL_PROP_NEST__BEGIN         = 15296,
     SPINEL_PROP_NEST_STREAM_MFG     = SPINEL_PROP_NEST__BEGIN + 0,
+
+    /// Message buffer congestion state
+    /** Format: `b` (Read-only)
+     *
+     *  Set to true when the NCP message buffer pool drops below its
+     *  congestion watermark and to false once it recovers. The NCP
+     *  emits an unsolicited value update on each transition so the
+     *  host can pace its outbound traffic before allocations fail.
+     */
+    SPINEL_PROP_NEST_MSG_BUFFER_CONGESTED = SPINEL_PROP_NEST__BEGIN + 1,
+
+    /// Inbound network stream flow control credits
+    /** Format: `C` (Read-only)
+     *
+     *  The number of additional `PROP_STREAM_NET` or
+     *  `PROP_STREAM_NET_INSECURE` frames the host may inject. The
+     *  host replaces its local window with each value update and
+     *  decrements it per injected frame, pausing at zero. The NCP
+     *  emits unsolicited value updates as buffer capacity frees.
+     */
+    SPINEL_PROP_NEST_STREAM_NET_CREDITS = SPINEL_PROP_NEST__BEGIN + 2,
+
+    /// Host-bound datagram next-header drop filter
+    /** Format: `C` (array; insert/remove)
+     *
+     *  IPv6 next-header (protocol) numbers the NCP drops instead of
+     *  forwarding to the host.
+     */
+    SPINEL_PROP_NEST_HOST_FILTER_NEXT_HEADER = SPINEL_PROP_NEST__BEGIN + 3,
+
+    /// Host-bound datagram destination port drop filter
+    /** Format: `S` (array; insert/remove)
+     *
+     *  UDP and TCP destination ports the NCP drops instead of
+     *  forwarding to the host.
+     */
+    SPINEL_PROP_NEST_HOST_FILTER_PORT = SPINEL_PROP_NEST__BEGIN + 4,
+
+    /// Host-bound multicast scope drop filter
+    /** Format: `C`
+     *
+     *  Multicast datagrams whose destination scope is less than or
+     *  equal to this value are dropped instead of forwarded to the
+     *  host. Zero (the default) disables the filter.
+     */
+    SPINEL_PROP_NEST_HOST_FILTER_MCAST_SCOPE = SPINEL_PROP_NEST__BEGIN + 5,
+
     SPINEL_PROP_NEST__END           = 15360,
 
     SPINEL_PROP_VENDOR__BEGIN       = 15360,
@@ -0,0 +1,287 @@
+#!/usr/bin/python
+#
+#  Copyright (c) 2016, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""Simulated-mesh load-generation harness.
+
+Forms a whitelisted chain of N virtual nodes on the posix platform (the
+same UDP-socket radio used by the certification scripts) and drives
+configurable echo flows across it.  Reports a latency distribution per
+hop count, aggregate delivered throughput, and the buffer-pool
+high-watermarks observed on every node, so that scaling cliffs such as
+reassembly exhaustion or address-query storms show up before release.
+
+The latency figures are device-measured round-trip times parsed from the
+CLI ping output; pinging mesh-local EIDs across multiple hops exercises
+the address-query path on first use.
+
+Examples:
+    mesh_perf.py --nodes 6
+    mesh_perf.py --nodes 8 --flows 1:8,2:7 --count 100 --size 128 --json
+"""
+
+import argparse
+import json
+import re
+import sys
+import time
+
+import node
+
+PANID = 0xface
+STATE_TIMEOUT = 60
+RESPONSE_TIMEOUT = 30
+
+
+def percentile(values, fraction):
+    ordered = sorted(values)
+    return ordered[min(int(len(ordered) * fraction), len(ordered) - 1)]
+
+
+class MeshPerf:
+
+    def __init__(self, num_nodes):
+        self.nodes = {}
+
+        for i in range(1, num_nodes + 1):
+            self.nodes[i] = node.Node(i)
+            self.nodes[i].set_panid(PANID)
+            self.nodes[i].set_mode('rsdn')
+
+        # whitelist a chain topology so traffic between distant nodes is multi-hop
+        for i in range(1, num_nodes + 1):
+            if i > 1:
+                self.nodes[i].add_whitelist(self.nodes[i - 1].get_addr64())
+
+            if i < num_nodes:
+                self.nodes[i].add_whitelist(self.nodes[i + 1].get_addr64())
+
+            self.nodes[i].enable_whitelist()
+
+        self.watermarks = {}
+
+    def wait_for_state(self, nodeid, states):
+        deadline = time.time() + STATE_TIMEOUT
+
+        while time.time() < deadline:
+            if self.nodes[nodeid].get_state() in states:
+                return
+
+            time.sleep(1)
+
+        raise RuntimeError('node %d did not reach %s' % (nodeid, states))
+
+    def form_network(self):
+        self.nodes[1].start()
+        self.wait_for_state(1, ['leader'])
+
+        for i in range(2, len(self.nodes) + 1):
+            self.nodes[i].start()
+            self.wait_for_state(i, ['router'])
+
+    def get_mleid(self, nodeid):
+        for addr in self.nodes[nodeid].get_addrs():
+            if not addr.startswith('fe80') and ':ff:fe00:' not in addr:
+                return addr
+
+        raise RuntimeError('node %d has no mesh-local EID' % nodeid)
+
+    def run_flow(self, src, dst, count, size):
+        """ Start an echo flow and return once the command is issued. """
+        self.nodes[src].send_command('ping %s %d %d 0' % (self.get_mleid(dst), size, count))
+
+    def collect_flow(self, src, count):
+        """ Collect up to `count` echo responses and their device-measured RTTs. """
+        latencies = []
+
+        for _ in range(count):
+            try:
+                self.nodes[src].pexpect.expect('time=(\\d+)ms', timeout=RESPONSE_TIMEOUT)
+                latencies.append(int(self.nodes[src].pexpect.match.groups()[0]))
+            except Exception:
+                break
+
+        return latencies
+
+    def sample_buffers(self):
+        """ Poll bufferinfo on every node and fold it into the high-watermarks. """
+        for i, nd in self.nodes.items():
+            nd.send_command('bufferinfo')
+            nd.pexpect.expect('total: (\\d+)')
+            total = int(nd.pexpect.match.groups()[0])
+            nd.pexpect.expect('free: (\\d+)')
+            free = int(nd.pexpect.match.groups()[0])
+
+            owners = {}
+
+            for owner in ('mle', 'ip6', '6lo', 'coap'):
+                nd.pexpect.expect('%s: (\\d+) (\\d+)' % owner)
+                owners[owner] = int(nd.pexpect.match.groups()[1])
+
+            nd.pexpect.expect('Done')
+
+            mark = self.watermarks.setdefault(i, {'total': total, 'min_free': free, 'owners': {}})
+            mark['min_free'] = min(mark['min_free'], free)
+
+            for owner, high in owners.items():
+                mark['owners'][owner] = max(mark['owners'].get(owner, 0), high)
+
+    def measure_hops(self, count, size):
+        """ Ping each chain distance in turn and return per-hop latency stats. """
+        results = []
+
+        for dst in range(2, len(self.nodes) + 1):
+            # a single warm-up echo resolves the EID first, so the probe batch
+            # is not consumed by the initial address query
+            self.run_flow(1, dst, 1, size)
+            self.collect_flow(1, 1)
+
+            self.run_flow(1, dst, count, size)
+            latencies = self.collect_flow(1, count)
+            self.sample_buffers()
+
+            stats = {'hops': dst - 1, 'sent': count, 'received': len(latencies)}
+
+            if latencies:
+                stats['min_ms'] = min(latencies)
+                stats['p50_ms'] = percentile(latencies, 0.50)
+                stats['p90_ms'] = percentile(latencies, 0.90)
+                stats['max_ms'] = max(latencies)
+
+            results.append(stats)
+
+        return results
+
+    def measure_throughput(self, flows, count, size):
+        """ Run all flows concurrently and return per-flow and aggregate results. """
+        start = time.time()
+
+        for src, dst in flows:
+            self.run_flow(src, dst, count, size)
+
+        results = []
+        delivered = 0
+
+        for src, dst in flows:
+            latencies = self.collect_flow(src, count)
+            delivered += len(latencies)
+            results.append({'src': src, 'dst': dst, 'sent': count, 'received': len(latencies)})
+
+        elapsed = time.time() - start
+        self.sample_buffers()
+
+        # each response accounts for the payload crossing the mesh twice
+        throughput = 8.0 * 2 * size * delivered / elapsed / 1000 if elapsed > 0 else 0
+
+        return results, throughput
+
+    def stop(self):
+        for nd in self.nodes.values():
+            nd.stop()
+
+
+def parse_flows(text, num_nodes):
+    flows = []
+
+    for item in text.split(','):
+        src, dst = (int(x) for x in item.split(':'))
+
+        if not (1 <= src <= num_nodes and 1 <= dst <= num_nodes) or src == dst:
+            raise ValueError('bad flow %s' % item)
+
+        flows.append((src, dst))
+
+    return flows
+
+
+def main():
+    parser = argparse.ArgumentParser(description='simulated-mesh load harness')
+    parser.add_argument('--nodes', type=int, default=4, help='number of chain nodes')
+    parser.add_argument('--flows', default=None,
+                        help='comma-separated src:dst pairs (default: 1:N)')
+    parser.add_argument('--count', type=int, default=50, help='echoes per throughput flow')
+    parser.add_argument('--probes', type=int, default=10, help='echoes per latency probe')
+    parser.add_argument('--size', type=int, default=64, help='echo payload bytes')
+    parser.add_argument('--json', action='store_true', help='emit machine-readable output')
+    args = parser.parse_args()
+
+    flows_text = args.flows if args.flows else '1:%d' % args.nodes
+    flows = parse_flows(flows_text, args.nodes)
+
+    mesh = MeshPerf(args.nodes)
+
+    try:
+        mesh.form_network()
+        hops = mesh.measure_hops(args.probes, args.size)
+        flow_results, throughput = mesh.measure_throughput(flows, args.count, args.size)
+    finally:
+        mesh.stop()
+
+    buffers = [{'node': i,
+                'total': mark['total'],
+                'min_free': mark['min_free'],
+                'owners': mark['owners']}
+               for i, mark in sorted(mesh.watermarks.items())]
+
+    if args.json:
+        print(json.dumps({'nodes': args.nodes,
+                          'size': args.size,
+                          'hops': hops,
+                          'flows': flow_results,
+                          'throughput_kbps': round(throughput, 1),
+                          'buffers': buffers}, indent=2, sort_keys=True))
+        return
+
+    print('latency by hop count (%d-byte echoes):' % args.size)
+
+    for stats in hops:
+        if stats['received'] == 0:
+            print('  %d hop(s): no responses (%d sent)' % (stats['hops'], stats['sent']))
+            continue
+
+        print('  %d hop(s): min %d ms, p50 %d ms, p90 %d ms, max %d ms (%d/%d)' %
+              (stats['hops'], stats['min_ms'], stats['p50_ms'], stats['p90_ms'],
+               stats['max_ms'], stats['received'], stats['sent']))
+
+    print('throughput: %.1f kbit/s aggregate over %d flow(s)' % (throughput, len(flows)))
+
+    for result in flow_results:
+        print('  flow %d->%d: %d/%d delivered' %
+              (result['src'], result['dst'], result['received'], result['sent']))
+
+    print('buffer-pool high-watermarks:')
+
+    for mark in buffers:
+        owners = ' '.join('%s=%d' % (owner, high)
+                          for owner, high in sorted(mark['owners'].items()))
+        print('  node %d: min free %d/%d buffers, per-owner max: %s' %
+              (mark['node'], mark['min_free'], mark['total'], owners))
+
+
+if __name__ == '__main__':
+    sys.exit(main())
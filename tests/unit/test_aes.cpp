@@ -39,6 +39,10 @@ extern"C" void otSignalTaskletPending(otInstance *)
 {
 }
 
+extern "C" void otPlatDiagAlarmFired(otInstance *)
+{
+}
+
 /**
  * Verifies test vectors from IEEE 802.15.4-2006 Annex C Section C.2.1
  */
@@ -233,11 +237,87 @@ void TestMacCommandFrame()
                  "TestMacCommandFrame decrypt failed\n");
 }
 
+/**
+ * Verifies that a payload longer than the multi-block kernel batch encrypts and decrypts
+ * consistently regardless of how it is chunked across Payload() calls.
+ */
+void TestMultiBlockPayload()
+{
+    uint8_t key[] =
+    {
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+    };
+
+    uint8_t nonce[] =
+    {
+        0xAC, 0xDE, 0x48, 0x00, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x05, 0x04,
+    };
+
+    uint8_t header[] = { 0x01, 0x02, 0x03, 0x04 };
+    uint8_t plain[100];
+    uint8_t oneShot[sizeof(plain)];
+    uint8_t chunked[sizeof(plain)];
+    uint8_t oneShotTag[8];
+    uint8_t chunkedTag[8];
+    uint8_t tagLength;
+    uint32_t chunkLengths[] = { 7, 64, 29 };
+    uint32_t offset;
+
+    Thread::Crypto::AesCcm aesCcm;
+
+    for (unsigned i = 0; i < sizeof(plain); i++)
+    {
+        plain[i] = static_cast<uint8_t>(i);
+    }
+
+    memcpy(oneShot, plain, sizeof(plain));
+    memcpy(chunked, plain, sizeof(plain));
+
+    aesCcm.SetKey(key, sizeof(key));
+    aesCcm.Init(sizeof(header), sizeof(plain), sizeof(oneShotTag), nonce, sizeof(nonce));
+    aesCcm.Header(header, sizeof(header));
+    aesCcm.Payload(oneShot, oneShot, sizeof(oneShot), true);
+    tagLength = sizeof(oneShotTag);
+    aesCcm.Finalize(oneShotTag, &tagLength);
+
+    aesCcm.Init(sizeof(header), sizeof(plain), sizeof(chunkedTag), nonce, sizeof(nonce));
+    aesCcm.Header(header, sizeof(header));
+    offset = 0;
+
+    for (unsigned i = 0; i < sizeof(chunkLengths) / sizeof(chunkLengths[0]); i++)
+    {
+        aesCcm.Payload(chunked + offset, chunked + offset, chunkLengths[i], true);
+        offset += chunkLengths[i];
+    }
+
+    tagLength = sizeof(chunkedTag);
+    aesCcm.Finalize(chunkedTag, &tagLength);
+
+    VerifyOrQuit(memcmp(oneShot, chunked, sizeof(oneShot)) == 0,
+                 "TestMultiBlockPayload chunked encrypt mismatch\n");
+    VerifyOrQuit(memcmp(oneShotTag, chunkedTag, sizeof(oneShotTag)) == 0,
+                 "TestMultiBlockPayload chunked tag mismatch\n");
+
+    aesCcm.Init(sizeof(header), sizeof(plain), sizeof(oneShotTag), nonce, sizeof(nonce));
+    aesCcm.Header(header, sizeof(header));
+    aesCcm.Payload(oneShot, oneShot, sizeof(oneShot), false);
+    tagLength = sizeof(oneShotTag);
+    aesCcm.Finalize(oneShotTag, &tagLength);
+
+    VerifyOrQuit(memcmp(oneShot, plain, sizeof(plain)) == 0,
+                 "TestMultiBlockPayload decrypt failed\n");
+    VerifyOrQuit(memcmp(oneShotTag, chunkedTag, sizeof(oneShotTag)) == 0,
+                 "TestMultiBlockPayload decrypt tag mismatch\n");
+}
+
 int main(void)
 {
     TestMacBeaconFrame();
     TestMacDataFrame();
     TestMacCommandFrame();
+    TestMultiBlockPayload();
     printf("All tests passed\n");
     return 0;
 }
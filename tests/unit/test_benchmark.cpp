@@ -0,0 +1,407 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_util.hpp"
+#include "test_vector.h"
+#include <common/debug.hpp>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <openthread.h>
+#include <common/message.hpp>
+#include <common/timer.hpp>
+#include <crypto/aes_ccm.hpp>
+#include <mac/mac.hpp>
+#include <ncp/hdlc.hpp>
+#include <thread/thread_netif.hpp>
+#include <thread/lowpan.hpp>
+
+using namespace Thread;
+
+namespace Thread {
+
+// This module implements microbenchmarks for the packet-path primitives.
+// Each benchmark is timed with CLOCK_MONOTONIC and reports ns/op and ops/s;
+// run with --json to emit machine-readable output for trending.  The
+// programs are built but not run by `make check`; use `make benchmark`.
+
+extern "C" void otSignalTaskletPending(otInstance *)
+{
+}
+
+extern "C" bool otAreTaskletsPending(otInstance *)
+{
+    return false;
+}
+
+extern "C" void otPlatUartSendDone(void)
+{
+}
+
+extern "C" void otPlatUartReceived(const uint8_t *aBuf, uint16_t aBufLength)
+{
+    (void)aBuf;
+    (void)aBufLength;
+}
+
+extern "C" void otPlatDiagAlarmFired(otInstance *)
+{
+}
+
+extern "C" void otPlatDiagRadioTransmitDone(otInstance *, bool aRxPending, ThreadError aError)
+{
+    (void)aRxPending;
+    (void)aError;
+}
+
+extern "C" void otPlatDiagRadioReceiveDone(otInstance *, RadioPacket *aFrame, ThreadError aError)
+{
+    (void)aFrame;
+    (void)aError;
+}
+
+Ip6::Ip6 sIp6;
+ThreadNetif sMockThreadNetif(sIp6);
+Lowpan::Lowpan sMockLowpan(sMockThreadNetif);
+
+enum
+{
+    kMinRunNsec      = 100 * 1000 * 1000,  ///< Minimum measured run per benchmark (100 ms).
+    kBatchSize       = 64,                 ///< Body invocations per timed batch.
+    kAesPayloadSize  = 64,                 ///< AES-CCM payload bytes per operation.
+    kMessageDataSize = 128,                ///< Bytes appended/prepended per message operation.
+    kMessageReadSize = 1024,               ///< Bytes read per message read operation.
+    kHdlcContentSize = 64,                 ///< Frame content bytes per HDLC encode operation.
+    kNumBenchTimers  = 32,                 ///< Timers kept pending by the timer benchmark.
+};
+
+static bool sJsonOutput = false;
+static bool sJsonFirst = true;
+
+typedef void (*BenchmarkBody)(void);
+
+static uint64_t GetMonotonicNsec(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000 + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * This function times @p aBody until at least 100 ms have elapsed and reports the result.
+ *
+ * @param[in]  aName        The benchmark name.
+ * @param[in]  aBody        The function to measure.
+ * @param[in]  aOpsPerCall  Number of reported operations performed by one call to @p aBody.
+ *
+ */
+static void RunBenchmark(const char *aName, BenchmarkBody aBody, uint32_t aOpsPerCall)
+{
+    uint64_t start = GetMonotonicNsec();
+    uint64_t elapsed;
+    uint64_t ops = 0;
+    double nsPerOp;
+    double opsPerSec;
+
+    do
+    {
+        for (unsigned i = 0; i < kBatchSize; i++)
+        {
+            aBody();
+        }
+
+        ops += kBatchSize * aOpsPerCall;
+        elapsed = GetMonotonicNsec() - start;
+    }
+    while (elapsed < kMinRunNsec);
+
+    nsPerOp = static_cast<double>(elapsed) / static_cast<double>(ops);
+    opsPerSec = 1e9 * static_cast<double>(ops) / static_cast<double>(elapsed);
+
+    if (sJsonOutput)
+    {
+        printf("%s\n    {\"name\": \"%s\", \"ns_per_op\": %.1f, \"ops_per_sec\": %.0f}",
+               sJsonFirst ? "" : ",", aName, nsPerOp, opsPerSec);
+        sJsonFirst = false;
+    }
+    else
+    {
+        printf("%-24s %12.1f ns/op %16.0f ops/s\n", aName, nsPerOp, opsPerSec);
+    }
+}
+
+// ===> Lowpan::Compress / Lowpan::Decompress
+
+static std::vector<uint8_t> sLowpanFrame;
+static Mac::Address sMacSource;
+static Mac::Address sMacDest;
+static const uint8_t *sLowpanPayload;
+static uint16_t sLowpanPayloadLength;
+static Message *sLowpanMessage;    // holds the decompressed packet for the compress benchmark
+static Message *sScratchMessage;   // decompression target, reset every operation
+static uint8_t sCompressBuffer[1500];
+
+static void SetupLowpanBenchmark(void)
+{
+    test_lowpan_vector_t *test = &sTestVectorLowpan[0];
+    std::string iphcString(test->mCompressed);
+    Mac::Frame frame;
+    uint16_t ip6PayloadLength;
+    int decompressedBytes;
+
+    otTestHexToVector(iphcString, sLowpanFrame);
+
+    frame.mPsdu = sLowpanFrame.data();
+    frame.mLength = static_cast<uint8_t>(sLowpanFrame.size());
+    frame.GetSrcAddr(sMacSource);
+    frame.GetDstAddr(sMacDest);
+    sLowpanPayload = frame.GetPayload();
+    sLowpanPayloadLength = frame.GetPayloadLength();
+
+    VerifyOrQuit((sLowpanMessage = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                 "benchmark: Ip6::NewMessage failed");
+    SuccessOrQuit(sLowpanMessage->SetLength(sizeof(Ip6::Header) + sizeof(Ip6::UdpHeader) + sLowpanPayloadLength),
+                  "benchmark: Message::SetLength failed");
+
+    // decompress the vector once so the message holds the packet used by the compress benchmark
+    decompressedBytes = sMockLowpan.Decompress(*sLowpanMessage, sMacSource, sMacDest,
+                                               sLowpanPayload, sLowpanPayloadLength, 0);
+    VerifyOrQuit(decompressedBytes > 0, "benchmark: Lowpan::Decompress failed");
+
+    ip6PayloadLength = sLowpanPayloadLength - static_cast<uint16_t>(decompressedBytes);
+    SuccessOrQuit(sLowpanMessage->SetLength(sLowpanMessage->GetOffset() + ip6PayloadLength),
+                  "benchmark: Message::SetLength failed");
+    sLowpanMessage->Write(sLowpanMessage->GetOffset(), ip6PayloadLength, sLowpanPayload + decompressedBytes);
+    ip6PayloadLength = HostSwap16(sLowpanMessage->GetLength() - sizeof(Ip6::Header));
+    sLowpanMessage->Write(Ip6::Header::GetPayloadLengthOffset(), sizeof(ip6PayloadLength), &ip6PayloadLength);
+
+    VerifyOrQuit((sScratchMessage = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                 "benchmark: Ip6::NewMessage failed");
+    SuccessOrQuit(sScratchMessage->SetLength(sizeof(Ip6::Header) + sizeof(Ip6::UdpHeader) + sLowpanPayloadLength),
+                  "benchmark: Message::SetLength failed");
+}
+
+static void BenchmarkLowpanCompress(void)
+{
+    sLowpanMessage->SetOffset(0);
+    VerifyOrQuit(sMockLowpan.Compress(*sLowpanMessage, sMacSource, sMacDest, sCompressBuffer) > 0,
+                 "benchmark: Lowpan::Compress failed");
+}
+
+static void BenchmarkLowpanDecompress(void)
+{
+    sScratchMessage->SetOffset(0);
+    VerifyOrQuit(sMockLowpan.Decompress(*sScratchMessage, sMacSource, sMacDest,
+                                        sLowpanPayload, sLowpanPayloadLength, 0) > 0,
+                 "benchmark: Lowpan::Decompress failed");
+}
+
+// ===> AesCcm::Payload
+
+static Crypto::AesCcm sAesCcm;
+static uint8_t sAesPayload[kAesPayloadSize];
+static uint8_t sAesNonce[13];
+
+static void BenchmarkAesCcmPayload(void)
+{
+    uint8_t tag[8];
+    uint8_t tagLength = sizeof(tag);
+
+    sAesCcm.Init(0, sizeof(sAesPayload), tagLength, sAesNonce, sizeof(sAesNonce));
+    sAesCcm.Payload(sAesPayload, sAesPayload, sizeof(sAesPayload), true);
+    sAesCcm.Finalize(tag, &tagLength);
+}
+
+// ===> Message append / read / prepend
+
+static MessagePool sMessagePool;
+static Message *sAppendMessage;
+static Message *sReadMessage;
+static uint8_t sMessageData[kMessageReadSize];
+
+static void SetupMessageBenchmark(void)
+{
+    for (unsigned i = 0; i < sizeof(sMessageData); i++)
+    {
+        sMessageData[i] = static_cast<uint8_t>(i);
+    }
+
+    VerifyOrQuit((sAppendMessage = sMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                 "benchmark: Message::New failed");
+    VerifyOrQuit((sReadMessage = sMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                 "benchmark: Message::New failed");
+    SuccessOrQuit(sReadMessage->SetLength(kMessageReadSize), "benchmark: Message::SetLength failed");
+    sReadMessage->Write(0, kMessageReadSize, sMessageData);
+}
+
+static void BenchmarkMessageAppend(void)
+{
+    SuccessOrQuit(sAppendMessage->SetLength(0), "benchmark: Message::SetLength failed");
+    SuccessOrQuit(sAppendMessage->Append(sMessageData, kMessageDataSize), "benchmark: Message::Append failed");
+}
+
+static void BenchmarkMessageRead(void)
+{
+    uint8_t buffer[kMessageReadSize];
+
+    VerifyOrQuit(sReadMessage->Read(0, sizeof(buffer), buffer) == sizeof(buffer),
+                 "benchmark: Message::Read failed");
+}
+
+// includes Message::New and Message::Free, since prepending requires reserved header space
+static void BenchmarkMessagePrepend(void)
+{
+    Message *message;
+
+    VerifyOrQuit((message = sMessagePool.New(Message::kTypeIp6, kMessageDataSize)) != NULL,
+                 "benchmark: Message::New failed");
+    SuccessOrQuit(message->Prepend(sMessageData, kMessageDataSize), "benchmark: Message::Prepend failed");
+    SuccessOrQuit(message->Free(), "benchmark: Message::Free failed");
+}
+
+// ===> Hdlc::Encoder
+
+class BenchEncoderBuffer : public Hdlc::Encoder::BufferWriteIterator
+{
+public:
+    BenchEncoderBuffer(void) { Clear(); }
+
+    void Clear(void)
+    {
+        mWritePointer = mBuffer;
+        mRemainingLength = sizeof(mBuffer);
+    }
+
+private:
+    uint8_t mBuffer[512];
+};
+
+static Hdlc::Encoder sHdlcEncoder;
+static BenchEncoderBuffer sHdlcBuffer;
+static uint8_t sHdlcContent[kHdlcContentSize];
+
+static void SetupHdlcBenchmark(void)
+{
+    // include bytes that require escaping so the escape path is exercised
+    for (unsigned i = 0; i < sizeof(sHdlcContent); i++)
+    {
+        sHdlcContent[i] = (i % 8 == 0) ? 0x7e : static_cast<uint8_t>(i);
+    }
+}
+
+static void BenchmarkHdlcEncode(void)
+{
+    sHdlcBuffer.Clear();
+    SuccessOrQuit(sHdlcEncoder.Init(sHdlcBuffer), "benchmark: Encoder::Init failed");
+    SuccessOrQuit(sHdlcEncoder.Encode(sHdlcContent, sizeof(sHdlcContent), sHdlcBuffer),
+                  "benchmark: Encoder::Encode failed");
+    SuccessOrQuit(sHdlcEncoder.Finalize(sHdlcBuffer), "benchmark: Encoder::Finalize failed");
+}
+
+// ===> TimerScheduler::Add
+
+static TimerScheduler sTimerScheduler;
+static Timer *sTimers[kNumBenchTimers];
+
+static void BenchTimerHandler(void *aContext)
+{
+    (void)aContext;
+}
+
+static void SetupTimerBenchmark(void)
+{
+    for (unsigned i = 0; i < kNumBenchTimers; i++)
+    {
+        sTimers[i] = new Timer(sTimerScheduler, BenchTimerHandler, NULL);
+    }
+}
+
+// adds all timers with staggered fire times, then removes them again
+static void BenchmarkTimerAdd(void)
+{
+    for (unsigned i = 0; i < kNumBenchTimers; i++)
+    {
+        sTimers[i]->StartAt(0, (i * 97 + 13) * 1000);
+    }
+
+    for (unsigned i = 0; i < kNumBenchTimers; i++)
+    {
+        sTimers[i]->Stop();
+    }
+}
+
+void RunBenchmarks(bool aJsonOutput)
+{
+    sJsonOutput = aJsonOutput;
+
+    SetupLowpanBenchmark();
+    SetupMessageBenchmark();
+    SetupHdlcBenchmark();
+    SetupTimerBenchmark();
+    sAesCcm.SetKey(sMessageData, 16);
+
+    if (sJsonOutput)
+    {
+        printf("{\"benchmarks\": [");
+    }
+
+    RunBenchmark("lowpan-compress", BenchmarkLowpanCompress, 1);
+    RunBenchmark("lowpan-decompress", BenchmarkLowpanDecompress, 1);
+    RunBenchmark("aes-ccm-payload-64", BenchmarkAesCcmPayload, 1);
+    RunBenchmark("message-append-128", BenchmarkMessageAppend, 1);
+    RunBenchmark("message-read-1024", BenchmarkMessageRead, 1);
+    RunBenchmark("message-prepend-128", BenchmarkMessagePrepend, 1);
+    RunBenchmark("hdlc-encode-64", BenchmarkHdlcEncode, 1);
+    RunBenchmark("timer-add", BenchmarkTimerAdd, kNumBenchTimers);
+
+    if (sJsonOutput)
+    {
+        printf("\n]}\n");
+    }
+}
+
+}  // namespace Thread
+
+int main(int argc, char *argv[])
+{
+    bool jsonOutput = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--json") == 0)
+        {
+            jsonOutput = true;
+        }
+    }
+
+    Thread::RunBenchmarks(jsonOutput);
+
+    return 0;
+}
@@ -67,6 +67,12 @@ extern "C" void otPlatRadioReceiveDone(otInstance *, RadioPacket *aFrame, Thread
     (void)aError;
 }
 
+extern "C" void otPlatRadioReceiveDoneBatch(otInstance *, RadioFrameEvent *aEvents, uint8_t aNumEvents)
+{
+    (void)aEvents;
+    (void)aNumEvents;
+}
+
 
 /**
  *  diagnostics module tests
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include "test_util.h"
+#include <openthread.h>
+#include <common/code_utils.hpp>
+#include <ncp/hdlc.hpp>
+
+namespace Thread {
+
+// This module implements unit-test for Hdlc::Encoder and Hdlc::Decoder.
+
+enum
+{
+    kEncodedBufferSize = 1500,   // Size of buffer for encoded frames.
+    kDecodedBufferSize = 1500,   // Size of decoder output buffer.
+};
+
+static const uint8_t sOpenThreadText[] = "OpenThread Rocks";
+static const uint8_t sHelloText[]      = "Hello there!";
+
+// Content that requires escaping (contains the flag and escape byte values).
+static const uint8_t sEscapedText[]    = { 0x7e, 0x7d, 'A', 0x7e, 0x7e, 0x7d, 0x7d, 'B', 0x7e };
+
+// Buffer storing the content of the last decoded frame.
+static uint8_t sDecodedFrame[kDecodedBufferSize];
+static uint16_t sDecodedFrameLength;
+static uint16_t sDecodedFrameCount;
+
+class EncoderBuffer : public Hdlc::Encoder::BufferWriteIterator
+{
+public:
+    EncoderBuffer(void) { Clear(); }
+
+    void Clear(void)
+    {
+        mWritePointer = mBuffer;
+        mRemainingLength = sizeof(mBuffer);
+    }
+
+    uint16_t       GetLength(void) const { return static_cast<uint16_t>(mWritePointer - mBuffer); }
+    const uint8_t *GetBuffer(void) const { return mBuffer; }
+
+private:
+    uint8_t  mBuffer[kEncodedBufferSize];
+};
+
+void HandleDecodedFrame(void *aContext, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    VerifyOrQuit(aFrameLength <= sizeof(sDecodedFrame), "Decoded frame is too long.");
+
+    memcpy(sDecodedFrame, aFrame, aFrameLength);
+    sDecodedFrameLength = aFrameLength;
+    sDecodedFrameCount++;
+
+    (void)aContext;
+}
+
+void HandleDecodeError(void *aContext, ThreadError aError, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    printf("\nDecode error %d (frame length %u)", aError, aFrameLength);
+    VerifyOrQuit(false, "Decoder signaled an unexpected error.");
+
+    (void)aContext;
+    (void)aFrame;
+}
+
+// Encodes the given content as a frame, decodes it back, and verifies the decoder output matches.
+void EncodeDecodeAndVerify(Hdlc::Encoder &aEncoder, Hdlc::Decoder &aDecoder, const uint8_t *aContent,
+                           uint16_t aContentLength)
+{
+    EncoderBuffer encoderBuffer;
+    uint16_t oldFrameCount = sDecodedFrameCount;
+    uint16_t encodedLength;
+    uint16_t offset;
+    uint16_t decodeLength;
+
+    SuccessOrQuit(aEncoder.Init(encoderBuffer), "Encoder::Init() failed.");
+    SuccessOrQuit(aEncoder.Encode(aContent, aContentLength, encoderBuffer), "Encoder::Encode() failed.");
+    SuccessOrQuit(aEncoder.Finalize(encoderBuffer), "Encoder::Finalize() failed.");
+
+    encodedLength = encoderBuffer.GetLength();
+
+    aDecoder.Decode(encoderBuffer.GetBuffer(), encodedLength);
+
+    VerifyOrQuit(sDecodedFrameCount == oldFrameCount + 1, "Decoder did not deliver the frame.");
+    VerifyOrQuit(sDecodedFrameLength == aContentLength, "Decoded frame length does not match.");
+    VerifyOrQuit(memcmp(sDecodedFrame, aContent, aContentLength) == 0, "Decoded frame content does not match.");
+
+    // Feed the same encoded stream to the decoder again in small pieces
+    // to verify the state machine across Decode() calls.
+    oldFrameCount = sDecodedFrameCount;
+
+    for (offset = 0; offset < encodedLength; offset += decodeLength)
+    {
+        decodeLength = (offset % 3) + 1;
+
+        if (decodeLength > encodedLength - offset)
+        {
+            decodeLength = encodedLength - offset;
+        }
+
+        aDecoder.Decode(encoderBuffer.GetBuffer() + offset, decodeLength);
+    }
+
+    VerifyOrQuit(sDecodedFrameCount == oldFrameCount + 1, "Decoder did not deliver the piece-wise frame.");
+    VerifyOrQuit(sDecodedFrameLength == aContentLength, "Piece-wise decoded frame length does not match.");
+    VerifyOrQuit(memcmp(sDecodedFrame, aContent, aContentLength) == 0,
+                 "Piece-wise decoded frame content does not match.");
+}
+
+// This function implements the Hdlc encoder/decoder tests.
+void TestHdlc(void)
+{
+    uint8_t decoderBuffer[kDecodedBufferSize];
+    uint8_t content[kDecodedBufferSize / 2];
+    uint16_t i;
+
+    Hdlc::Encoder encoder;
+    Hdlc::Decoder decoder(decoderBuffer, sizeof(decoderBuffer), HandleDecodedFrame, HandleDecodeError, NULL);
+
+    EncoderBuffer byteWiseBuffer;
+    EncoderBuffer bulkBuffer;
+    Hdlc::Encoder byteWiseEncoder;
+
+    printf("\nTest 1: Encode/decode round-trip");
+
+    EncodeDecodeAndVerify(encoder, decoder, sOpenThreadText, sizeof(sOpenThreadText));
+    EncodeDecodeAndVerify(encoder, decoder, sHelloText, sizeof(sHelloText));
+    EncodeDecodeAndVerify(encoder, decoder, sEscapedText, sizeof(sEscapedText));
+
+    // All byte values, covering every escape position.
+    for (i = 0; i < sizeof(content); i++)
+    {
+        content[i] = static_cast<uint8_t>(i);
+    }
+
+    EncodeDecodeAndVerify(encoder, decoder, content, sizeof(content));
+
+    printf(" -- PASS\n");
+
+    printf("\nTest 2: Buffer encode matches byte-wise encode");
+
+    SuccessOrQuit(encoder.Init(bulkBuffer), "Encoder::Init() failed.");
+    SuccessOrQuit(encoder.Encode(sEscapedText, sizeof(sEscapedText), bulkBuffer), "Encoder::Encode() failed.");
+    SuccessOrQuit(encoder.Encode(content, sizeof(content), bulkBuffer), "Encoder::Encode() failed.");
+    SuccessOrQuit(encoder.Finalize(bulkBuffer), "Encoder::Finalize() failed.");
+
+    SuccessOrQuit(byteWiseEncoder.Init(byteWiseBuffer), "Encoder::Init() failed.");
+
+    for (i = 0; i < sizeof(sEscapedText); i++)
+    {
+        SuccessOrQuit(byteWiseEncoder.Encode(sEscapedText[i], byteWiseBuffer), "Encoder::Encode() failed.");
+    }
+
+    for (i = 0; i < sizeof(content); i++)
+    {
+        SuccessOrQuit(byteWiseEncoder.Encode(content[i], byteWiseBuffer), "Encoder::Encode() failed.");
+    }
+
+    SuccessOrQuit(byteWiseEncoder.Finalize(byteWiseBuffer), "Encoder::Finalize() failed.");
+
+    VerifyOrQuit(bulkBuffer.GetLength() == byteWiseBuffer.GetLength(),
+                 "Buffer encode length does not match byte-wise encode.");
+    VerifyOrQuit(memcmp(bulkBuffer.GetBuffer(), byteWiseBuffer.GetBuffer(), bulkBuffer.GetLength()) == 0,
+                 "Buffer encode output does not match byte-wise encode.");
+
+    printf(" -- PASS\n");
+}
+
+}  // namespace Thread
+
+int main(void)
+{
+    Thread::TestHdlc();
+    printf("\nAll tests passed.\n");
+    return 0;
+}
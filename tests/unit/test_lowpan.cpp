@@ -120,6 +120,11 @@ void TestLowpanIphc(void)
         VerifyOrQuit((message = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
                      "6lo: Ip6::NewMessage failed");
 
+        // pre-size the message to the worst-case expansion so decompression can write in place
+        SuccessOrQuit(message->SetLength(sizeof(Ip6::Header) + sizeof(Ip6::UdpHeader) +
+                                         frame.GetPayloadLength()),
+                      "6lo: Message::SetLength failed");
+
         // ===> Test Lowpan::Decompress
         int decompressedBytes =
             sMockLowpan.Decompress(*message, macSource, macDest,
@@ -128,9 +133,10 @@ void TestLowpanIphc(void)
 
         uint16_t ip6PayloadLength = frame.GetPayloadLength() -
                                     static_cast<uint16_t>(decompressedBytes);
-        SuccessOrQuit(message->Append(frame.GetPayload() + decompressedBytes,
-                                      ip6PayloadLength),
-                      "6lo: Message::Append failed");
+        SuccessOrQuit(message->SetLength(message->GetOffset() + ip6PayloadLength),
+                      "6lo: Message::SetLength failed");
+        message->Write(message->GetOffset(), ip6PayloadLength,
+                       frame.GetPayload() + decompressedBytes);
         ip6PayloadLength = HostSwap16(message->GetLength() -
                                       sizeof(Ip6::Header));
         message->Write(Ip6::Header::GetPayloadLengthOffset(),
@@ -68,9 +68,124 @@ void TestMessage(void)
                   "Message::Free failed\n");
 }
 
+void TestMessageClone(void)
+{
+    Thread::MessagePool messagePool;
+    Thread::Message *message;
+    Thread::Message *messageClone;
+    uint8_t writeBuffer[512];
+    uint8_t readBuffer[512];
+
+    for (unsigned i = 0; i < sizeof(writeBuffer); i++)
+    {
+        writeBuffer[i] = static_cast<uint8_t>(random());
+    }
+
+    VerifyOrQuit((message = messagePool.New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+    SuccessOrQuit(message->SetLength(sizeof(writeBuffer)),
+                  "Message::SetLength failed\n");
+    VerifyOrQuit(message->Write(0, sizeof(writeBuffer), writeBuffer) == sizeof(writeBuffer),
+                 "Message::Write failed\n");
+
+    VerifyOrQuit((messageClone = message->Clone()) != NULL,
+                 "Message::Clone failed\n");
+    VerifyOrQuit(messageClone->GetLength() == sizeof(writeBuffer),
+                 "Message::Clone length mismatch\n");
+    VerifyOrQuit(messageClone->Read(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Read failed\n");
+    VerifyOrQuit(memcmp(writeBuffer, readBuffer, sizeof(writeBuffer)) == 0,
+                 "Message clone compare failed\n");
+
+    // writing to the clone must not modify the original
+    readBuffer[0] ^= 0xff;
+    VerifyOrQuit(messageClone->Write(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Write failed\n");
+    VerifyOrQuit(message->Read(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Read failed\n");
+    VerifyOrQuit(memcmp(writeBuffer, readBuffer, sizeof(writeBuffer)) == 0,
+                 "Message modified by clone write\n");
+
+    SuccessOrQuit(messageClone->Free(),
+                  "Message::Free failed\n");
+    VerifyOrQuit(message->Read(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Read failed\n");
+    VerifyOrQuit(memcmp(writeBuffer, readBuffer, sizeof(writeBuffer)) == 0,
+                 "Message modified by clone free\n");
+    SuccessOrQuit(message->Free(),
+                  "Message::Free failed\n");
+}
+
+void TestMessagePatchChecksum(void)
+{
+    Thread::MessagePool messagePool;
+    Thread::Message *message;
+    uint8_t writeBuffer[128];
+    uint8_t readBuffer[4];
+    uint8_t newField[3] = { 0xde, 0xad, 0xbe };
+    uint16_t checksum;
+    uint8_t checksumBytes[2];
+
+    enum
+    {
+        kChecksumOffset = 2,
+        kEvenFieldOffset = 16,
+        kOddFieldOffset = 33,
+    };
+
+    for (unsigned i = 0; i < sizeof(writeBuffer); i++)
+    {
+        writeBuffer[i] = static_cast<uint8_t>(random());
+    }
+
+    writeBuffer[kChecksumOffset] = 0;
+    writeBuffer[kChecksumOffset + 1] = 0;
+
+    VerifyOrQuit((message = messagePool.New(Thread::Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+    SuccessOrQuit(message->SetLength(sizeof(writeBuffer)),
+                  "Message::SetLength failed\n");
+    VerifyOrQuit(message->Write(0, sizeof(writeBuffer), writeBuffer) == sizeof(writeBuffer),
+                 "Message::Write failed\n");
+
+    // store the checksum so the full ones-complement sum verifies to 0xffff
+    checksum = ~message->UpdateChecksum(0, 0, message->GetLength());
+    checksumBytes[0] = static_cast<uint8_t>(checksum >> 8);
+    checksumBytes[1] = static_cast<uint8_t>(checksum);
+    VerifyOrQuit(message->Write(kChecksumOffset, sizeof(checksumBytes), checksumBytes) == sizeof(checksumBytes),
+                 "Message::Write failed\n");
+    VerifyOrQuit(message->UpdateChecksum(0, 0, message->GetLength()) == 0xffff,
+                 "checksum setup failed\n");
+
+    // a patch at an even (word-aligned) offset must keep the message verifying
+    SuccessOrQuit(message->PatchChecksum(kChecksumOffset, kEvenFieldOffset, sizeof(newField), newField),
+                  "Message::PatchChecksum failed\n");
+    VerifyOrQuit(message->Read(kEvenFieldOffset, sizeof(newField), readBuffer) == sizeof(newField) &&
+                 memcmp(readBuffer, newField, sizeof(newField)) == 0,
+                 "Message::PatchChecksum did not rewrite the field\n");
+    VerifyOrQuit(message->UpdateChecksum(0, 0, message->GetLength()) == 0xffff,
+                 "Message::PatchChecksum broke the checksum (even offset)\n");
+
+    // and so must a patch at an odd offset
+    SuccessOrQuit(message->PatchChecksum(kChecksumOffset, kOddFieldOffset, sizeof(newField), newField),
+                  "Message::PatchChecksum failed\n");
+    VerifyOrQuit(message->UpdateChecksum(0, 0, message->GetLength()) == 0xffff,
+                 "Message::PatchChecksum broke the checksum (odd offset)\n");
+
+    // out-of-range patches must be rejected
+    VerifyOrQuit(message->PatchChecksum(kChecksumOffset, sizeof(writeBuffer) - 1, sizeof(newField), newField) ==
+                 kThreadError_InvalidArgs,
+                 "Message::PatchChecksum accepted an out-of-range field\n");
+
+    SuccessOrQuit(message->Free(),
+                  "Message::Free failed\n");
+}
+
 int main(void)
 {
     TestMessage();
+    TestMessageClone();
+    TestMessagePatchChecksum();
     printf("All tests passed\n");
     return 0;
 }
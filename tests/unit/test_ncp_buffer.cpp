@@ -250,6 +250,8 @@ void TestNcpFrameBuffer(void)
     CallbackContext context;
     CallbackContext oldContext;
     uint8_t readBuffer[16];
+    uint8_t chunkReadBuffer[2 * sizeof(sMottoText) + sizeof(sMysteryText) + sizeof(sHelloText)];
+    const uint8_t *chunkPtr;
     uint16_t readLen, readOffset;
 
     for (i = 0; i < sizeof(buffer); i++)
@@ -464,6 +466,44 @@ void TestNcpFrameBuffer(void)
 
     VerifyOrQuit(readOffset == sizeof(sMottoText), "Read len does not match expected length.");
     printf("\n -- PASS\n");
+
+    printf("\n- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -");
+    printf("\nTest 7: OutFrameGetChunk() and OutFrameSkip()");
+
+    SuccessOrQuit(ncpBuffer.OutFrameRemove(), "Remove() failed.");
+
+    WriteTestFrame1(ncpBuffer);
+
+    SuccessOrQuit(ncpBuffer.OutFrameBegin(), "OutFrameBegin() failed unexpectedly.");
+
+    readOffset = 0;
+
+    while ((chunkPtr = ncpBuffer.OutFrameGetChunk(readLen)) != NULL)
+    {
+        VerifyOrQuit(readLen != 0, "OutFrameGetChunk() returned a zero length chunk.");
+        VerifyOrQuit(readOffset + readLen <= sizeof(chunkReadBuffer), "Chunk read overflows the expected frame length.");
+
+        memcpy(chunkReadBuffer + readOffset, chunkPtr, readLen);
+        readOffset += readLen;
+
+        ncpBuffer.OutFrameSkip(readLen);
+    }
+
+    VerifyOrQuit(ncpBuffer.OutFrameHasEnded() == true, "Frame longer than expected.");
+    VerifyOrQuit(readOffset == ncpBuffer.OutFrameGetLength(), "Chunk read length does not match frame length.");
+
+    VerifyOrQuit(memcmp(chunkReadBuffer, sMottoText, sizeof(sMottoText)) == 0,
+                 "Chunk read does not match expected content.");
+    VerifyOrQuit(memcmp(chunkReadBuffer + sizeof(sMottoText), sMysteryText, sizeof(sMysteryText)) == 0,
+                 "Chunk read does not match expected content.");
+    VerifyOrQuit(memcmp(chunkReadBuffer + sizeof(sMottoText) + sizeof(sMysteryText), sMottoText,
+                        sizeof(sMottoText)) == 0, "Chunk read does not match expected content.");
+    VerifyOrQuit(memcmp(chunkReadBuffer + 2 * sizeof(sMottoText) + sizeof(sMysteryText), sHelloText,
+                        sizeof(sHelloText)) == 0, "Chunk read does not match expected content.");
+
+    SuccessOrQuit(ncpBuffer.OutFrameRemove(), "Remove() failed.");
+
+    printf("\n -- PASS\n");
 }
 
 }  // namespace Thread